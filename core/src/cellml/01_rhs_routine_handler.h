@@ -36,6 +36,9 @@ public:
   //! get the optimization type as it was specified in the settings
   std::string optimizationType();
 
+  //! get the scheme for the gating variables as specified in the settings, "heun" or "rushLarsen", this is used by the FastMonodomainSolver
+  std::string gatingVariablesScheme();
+
   //! load a given shared object library (<file>.so) and return the handle
   static void *loadRhsLibraryGetHandle(std::string libraryFilename);
 
@@ -55,10 +58,36 @@ protected:
   //! create the source filename using the CellmlSourceCodeGenerator, then compile to library
   void createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nInstancesRanks);
 
+  //! create the source file using the CellmlSourceCodeGenerator and compile it to the library, this is called on a single rank, returns false if the compilation failed
+  bool compileLibrary(std::string libraryFilename);
+
+  //! compute the key of the library cache, i.e. a hash of the model, the generated source code, the code generation options, the compiler flags and the compiler version
+  std::string computeLibraryCacheKey();
+
+  //! rhs routine for optimizationType "interpreter" that evaluates rhsInterpreter_, the context is the CellmlAdapter object
+  static void rhsRoutineInterpreter(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);
+
+  //! rhs routine for a single instance for optimizationType "interpreter", this is needed for computing the equilibrium of the states
+  static void rhsRoutineSingleInstanceInterpreter(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);
+
+  //! make sure the library in the cache directory exists, compile it if needed. Per node and library only one rank checks the cache and compiles, the other ranks wait.
+  void createLibraryInCache(std::string libraryFilename, std::string libraryCacheKey);
+
+  //! compile the library if it does not exist, use a lock file such that only one rank compiles it, other ranks wait until the library has been created. Returns if the library is available.
+  bool createLibraryWithLockFile(std::string libraryFilename);
+
+  //! check if the lock file was left by a process that is no longer running (same host) or that did not renew it within libraryCacheLockTimeout_ (other host)
+  bool lockFileIsStale(std::string lockFilename, std::string hostname);
+
   std::string sourceToCompileFilename_;   //< filename of the processed source file that will be used to compile the library
   std::string optimizationType_;          //< type of generated file, e.g. "simd", "gpu", "openmp"
+  std::string gatingVariablesScheme_;     //< scheme for the gating variables in the FastMonodomainSolver, "heun" or "rushLarsen"
   bool approximateExponentialFunction_;   //< when using "vc" as optimizationType_, the exp() function should be approximated, this is faster
   int maximumNumberOfThreads_;            //< when using "openmp" as optimizationType_, the maximum number of threads to use, 0 means no restriction
+  std::string compilerFlags_;             //< flags to use for compilation of the generated source file, option "compilerFlags"
+  std::string libraryCacheDirectory_;     //< directory of the cache of compiled libraries, given by the option "libraryCacheDirectory", the cache is disabled if empty
+  double libraryCacheLockTimeout_;        //< time in seconds after which a lock file of a process on another host that was not renewed is considered stale, e.g., because the compiling process was killed
+  CellmlRhsInterpreter rhsInterpreter_;   //< bytecode program of the rhs, used instead of a compiled library if optimizationType_ is "interpreter"
 
   void (*rhsRoutine_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);                //< function pointer to the rhs routine that can compute several instances of the problem in parallel. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...). The first parameter is a this pointer.
 
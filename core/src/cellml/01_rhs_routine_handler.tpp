@@ -9,11 +9,23 @@
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
+#include "utility/vector_operators.h"
+#include "utility/mpi_utility.h"
 #include "mesh/mesh_manager/mesh_manager.h"
 
 #include <unistd.h>  //dlopen
 #include <dlfcn.h>
 #include <ctime>
+#include <fcntl.h>   // open() of lock file
+#include <cstdio>    // popen
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <signal.h>  // kill() to check if the holder of a lock file is alive
+#include <utime.h>
+#include <cerrno>
+#include <fstream>
+#include <algorithm>
 
 // forward declaration
 template <int nStates,int nAlgebraics_,typename FunctionSpaceType>
@@ -40,6 +52,15 @@ initializeRhsRoutine()
     LOG(WARNING) << "Option \"simdSourceFilename\" is no longer used, simply specify \"sourceFilename\" to create a simd version and compile the function.";
   }
 
+  // scheme for the gating variables, this is only used by the FastMonodomainSolver which generates its own time stepping code
+  gatingVariablesScheme_ = this->specificSettings_.getOptionString("gatingVariablesScheme", "heun");
+  if (gatingVariablesScheme_ != "heun" && gatingVariablesScheme_ != "rushLarsen")
+  {
+    LOG(ERROR) << "Option \"gatingVariablesScheme\" is \"" << gatingVariablesScheme_ << "\" but valid values are \"heun\" or \"rushLarsen\"."
+      << " Now setting to \"heun\".";
+    gatingVariablesScheme_ = "heun";
+  }
+
   // determine library filename, create library if necessary
   std::string libraryFilename;
   if (this->specificSettings_.hasKey("libraryFilename"))
@@ -51,13 +72,28 @@ initializeRhsRoutine()
     // load type
     optimizationType_ = this->specificSettings_.getOptionString("optimizationType", "vc");
 
-    if (optimizationType_ != "simd" && optimizationType_ != "vc" && optimizationType_ != "openmp" && optimizationType_ != "gpu")
+    if (optimizationType_ != "simd" && optimizationType_ != "vc" && optimizationType_ != "openmp" && optimizationType_ != "gpu"
+      && optimizationType_ != "interpreter")
     {
-      LOG(ERROR) << "Option \"optimizationType\" is \"" << optimizationType_ << "\" but valid values are \"simd\", \"vc\", \"openmp\" or \"gpu\"."
+      LOG(ERROR) << "Option \"optimizationType\" is \"" << optimizationType_ << "\" but valid values are \"simd\", \"vc\", \"openmp\", \"gpu\" or \"interpreter\"."
        << " Now setting to \"vc\".";
       optimizationType_ = "vc";
     }
 
+    // for the interpreter, the rhs is evaluated by a bytecode program that is created directly from the parsed model, no library is compiled
+    if (optimizationType_ == "interpreter")
+    {
+      this->cellmlSourceCodeGenerator_.generateInterpreterProgram(rhsInterpreter_);
+
+      rhsRoutine_ = rhsRoutineInterpreter;
+      rhsRoutineSingleInstance_ = rhsRoutineSingleInstanceInterpreter;
+      rhsRoutineGPU_ = nullptr;
+      initConstsOpenCOR_ = nullptr;
+      computeRatesOpenCOR_ = nullptr;
+      computeVariablesOpenCOR_ = nullptr;
+      return;
+    }
+
     // for vc optimization, the exponential function can be approximated which is faster than the exact exp function
     if (optimizationType_ == "vc")
     {
@@ -69,6 +105,13 @@ initializeRhsRoutine()
       maximumNumberOfThreads_ = this->specificSettings_.getOptionInt("maximumNumberOfThreads", 0, PythonUtility::NonNegative);
     }
 
+    // load compiler flags
+    compilerFlags_ = this->specificSettings_.getOptionString("compilerFlags", "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+
+    // directory of the library cache, if empty the cache is not used
+    libraryCacheDirectory_ = this->specificSettings_.getOptionString("libraryCacheDirectory", "");
+    libraryCacheLockTimeout_ = this->specificSettings_.getOptionDouble("libraryCacheLockTimeout", 600, PythonUtility::Positive);
+
     // compile source file to a library
     std::stringstream baseFilename;
     baseFilename << StringUtility::extractBasename(this->cellmlSourceCodeGenerator_.sourceFilename())
@@ -100,6 +143,26 @@ initializeRhsRoutine()
     s << "src/" << baseFilename.str() << "." << rankNoWorldCommunicator << this->cellmlSourceCodeGenerator_.sourceFileSuffix();
     sourceToCompileFilename_ = s.str();
 
+    // if the library cache is enabled, the library is stored under a name that contains the hash of all inputs
+    if (!libraryCacheDirectory_.empty())
+    {
+      std::string libraryCacheKey = computeLibraryCacheKey();
+
+      s.str("");
+      s << libraryCacheDirectory_ << "/" << baseFilename.str() << "_" << libraryCacheKey << ".so";
+      libraryFilename = s.str();
+
+      s.str("");
+      s << libraryCacheDirectory_ << "/src/" << baseFilename.str() << "_" << libraryCacheKey << "." << rankNoWorldCommunicator << this->cellmlSourceCodeGenerator_.sourceFileSuffix();
+      sourceToCompileFilename_ = s.str();
+
+      LOG(DEBUG) << "Use library \"" << libraryFilename << "\" of the library cache.";
+
+      createLibraryInCache(libraryFilename, libraryCacheKey);
+      loadRhsLibrary(libraryFilename);
+      return;
+    }
+
     // create path of library filename if it does not exist
     if (libraryFilename.find("/") != std::string::npos)
     {
@@ -158,6 +221,10 @@ loadRhsLibraryGetHandle(std::string libraryFilename)
   if (currentWorkingDirectory[currentWorkingDirectory.length()-1] != '/')
     currentWorkingDirectory += "/";
 
+  // absolute paths, e.g. of the library cache, are not relative to the working directory
+  if (!libraryFilename.empty() && libraryFilename[0] == '/')
+    currentWorkingDirectory = "";
+
   void *handle = NULL;
   for (int i = 0; handle == NULL && i < 50; i++)  // wait maximum 2.5 ms for rank 0 to finish
   {
@@ -250,9 +317,6 @@ template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
 void RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
 createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nInstancesRanks)
 {
-  // get the global rank no, needed for the output filenames
-  int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
-
   // determine if this rank should do compilation, such that each nInstances is compiled only once, by the rank with lowest number
   int i = 0;
   int rankWhichCompilesLibrary = 0;
@@ -272,87 +336,349 @@ createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nIns
   {
     LOG(DEBUG) << "compile on this rank";
 
-    // create source file
-    this->cellmlSourceCodeGenerator_.generateSourceFile(sourceToCompileFilename_, optimizationType_,
-                                                        approximateExponentialFunction_, maximumNumberOfThreads_);
+    compileLibrary(libraryFilename);
+  }
+  else
+  {
+    LOG(DEBUG) << "we are the wrong rank, do not compile library "
+      << "wait until library has been compiled";
+  }
+}
 
-    // create library file
-    if (libraryFilename.find("/") != std::string::npos)
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+bool RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+compileLibrary(std::string libraryFilename)
+{
+  // get the global rank no, needed for the output filenames
+  int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
+
+  // create source file
+  this->cellmlSourceCodeGenerator_.generateSourceFile(sourceToCompileFilename_, optimizationType_,
+                                                      approximateExponentialFunction_, maximumNumberOfThreads_);
+
+  // create library file
+  if (libraryFilename.find("/") != std::string::npos)
+  {
+    std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
+    int ret = system((std::string("mkdir -p ")+path).c_str());
+
+    if (ret != 0)
     {
-      std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
-      int ret = system((std::string("mkdir -p ")+path).c_str());
+      LOG(ERROR) << "Could not create path \"" << path << "\" for library file.";
+    }
+  }
+
+  std::stringstream compileCommand;
+  const std::string &compilerFlags = compilerFlags_;
+
+#ifdef NDEBUG
+  if (compilerFlags.find("-O3") == std::string::npos)
+  {
+    LOG(WARNING) << "\"compilerFlags\" does not contain \"-O3\", this may be slow.";
+  }
+#endif
+  // for GPU: -ta=host,tesla,time
+
+  // compose compile command
+  std::stringstream s;
+  s << this->cellmlSourceCodeGenerator_.compilerCommand() << " " << sourceToCompileFilename_ << " "
+    << compilerFlags << " " << this->cellmlSourceCodeGenerator_.additionalCompileFlags() << " ";
+
+  std::string compileCommandOptions = s.str();
+
+  // compile library to filename with "*.rankNoWorldCommunicator", then wait (different wait times for ranks), then rename file to without "*.rankNoWorldCommunicator"
+  compileCommand << compileCommandOptions
+    << " -o " << libraryFilename << "." << rankNoWorldCommunicator << " "
+    //<< " && sleep " << int((rankNoWorldCommunicator%100)/10+1)
+    << " && mv " << libraryFilename << "." << rankNoWorldCommunicator << " " << libraryFilename;
+
+  int ret = system(compileCommand.str().c_str());
+  if (ret != 0)
+  {
+    LOG(ERROR) << "Compilation failed. Command: \"" << compileCommand.str() << "\".";
+
+    // remove "-fopenmp" in the compile command
+    std::string newCompileCommand = compileCommand.str();
+    std::string strToReplace = "-fopenmp";
+    std::size_t pos = newCompileCommand.find(strToReplace);
+    newCompileCommand.replace(pos, strToReplace.length(), "");
+
+    // remove -foffload="..."strToReplace = "-fopenmp";
+    pos = newCompileCommand.find("-foffload=\"");
+    std::size_t pos2 = newCompileCommand.find("\"", pos+11);
+    newCompileCommand.replace(pos, pos2-pos+1, "");
+
+    LOG(INFO) << "Retry without offloading, command: \n" << newCompileCommand;
 
-      if (ret != 0)
+    // execute new compilation command
+    int ret = system(newCompileCommand.c_str());
+    if (ret != 0)
+    {
+      LOG(ERROR) << "Compilation failed again.";
+      return false;
+    }
+    else
+    {
+      LOG(DEBUG) << "Compilation successful.";
+    }
+  }
+  else
+  {
+    LOG(DEBUG) << "Compilation successful. Command: \"" << compileCommand.str() << "\".";
+  }
+  return true;
+}
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+std::string RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+computeLibraryCacheKey()
+{
+  // collect everything that influences the compiled library
+  std::stringstream description;
+  this->cellmlSourceCodeGenerator_.writeModelDescription(description);
+
+  // add the generated source code, such that a changed code generator, e.g. after an update of opendihu, does not reuse libraries of the old generator,
+  // the file is generated under the per-rank source filename and removed again, the library is compiled from a newly generated file
+  this->cellmlSourceCodeGenerator_.generateSourceFile(sourceToCompileFilename_, optimizationType_,
+                                                      approximateExponentialFunction_, maximumNumberOfThreads_);
+  std::ifstream generatedSourceFile(sourceToCompileFilename_);
+  if (!generatedSourceFile.is_open())
+  {
+    LOG(ERROR) << "Could not open generated source file \"" << sourceToCompileFilename_ << "\" to compute the library cache key.";
+  }
+  description << "generated source:\n" << generatedSourceFile.rdbuf() << "\n";
+  generatedSourceFile.close();
+  unlink(sourceToCompileFilename_.c_str());
+
+  description << "optimizationType: " << optimizationType_ << "\n";
+  if (optimizationType_ == "vc")
+    description << "approximateExponentialFunction: " << approximateExponentialFunction_ << "\n";
+  else if (optimizationType_ == "openmp")
+    description << "maximumNumberOfThreads: " << maximumNumberOfThreads_ << "\n";
+
+  description << "statesForTransfer: " << this->data_.statesForTransfer() << "\n"
+    << "algebraicsForTransfer: " << this->data_.algebraicsForTransfer() << "\n"
+    << "parametersForTransfer: " << this->data_.parametersForTransfer() << "\n"
+    << "compilerFlags: " << compilerFlags_ << "\n";
+
+  // determine the versions of the compilers on one rank, calling the compiler on every rank would be slow
+  MPI_Comm mpiCommunicator = this->functionSpace_->meshPartition()->mpiCommunicator();
+  std::string compilerVersion;
+  if (this->functionSpace_->meshPartition()->ownRankNo() == 0)
+  {
+    for (std::string compilerCommand : std::vector<std::string>{C_COMPILER_COMMAND, CXX_COMPILER_COMMAND})
+    {
+      compilerVersion += compilerCommand + ": ";
+
+      // only use the first line of the output of "--version"
+      FILE *pipe = popen((compilerCommand + " --version 2>&1").c_str(), "r");
+      if (pipe)
       {
-        LOG(ERROR) << "Could not create path \"" << path << "\" for library file.";
+        char buffer[512];
+        if (fgets(buffer, sizeof(buffer), pipe) != NULL)
+          compilerVersion += buffer;
+        pclose(pipe);
       }
     }
+  }
 
-    std::stringstream compileCommand;
+  // send the compiler version to all ranks
+  int compilerVersionLength = compilerVersion.length();
+  MPIUtility::handleReturnValue(MPI_Bcast(&compilerVersionLength, 1, MPI_INT, 0, mpiCommunicator), "MPI_Bcast");
+  compilerVersion.resize(compilerVersionLength);
+  MPIUtility::handleReturnValue(MPI_Bcast(&compilerVersion[0], compilerVersionLength, MPI_CHAR, 0, mpiCommunicator), "MPI_Bcast");
 
-    // load compiler flags
-    std::string compilerFlags = this->specificSettings_.getOptionString("compilerFlags", "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+  description << "compilerVersion: " << compilerVersion << "\n";
 
-#ifdef NDEBUG
-    if (compilerFlags.find("-O3") == std::string::npos)
+  std::string key = StringUtility::hash(description.str());
+  LOG(DEBUG) << "library cache key: " << key << ", compiler: " << compilerVersion;
+  return key;
+}
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+createLibraryInCache(std::string libraryFilename, std::string libraryCacheKey)
+{
+  MPI_Comm mpiCommunicator = this->functionSpace_->meshPartition()->mpiCommunicator();
+
+  // group the ranks on the same node
+  MPI_Comm nodeCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_split_type(mpiCommunicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeCommunicator), "MPI_Comm_split_type");
+
+  // group the ranks on the node that need the same library, the color is derived from the key (28 bits, to be non-negative)
+  int color = std::stoi(libraryCacheKey.substr(0,7), nullptr, 16);
+  MPI_Comm libraryCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_split(nodeCommunicator, color, 0, &libraryCommunicator), "MPI_Comm_split");
+
+  int ownRankNo = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(libraryCommunicator, &ownRankNo), "MPI_Comm_rank");
+
+  // the first rank on the node checks the cache and possibly compiles the library, the other ranks wait
+  int libraryIsAvailable = 0;
+  if (ownRankNo == 0)
+  {
+    libraryIsAvailable = createLibraryWithLockFile(libraryFilename);
+  }
+
+  // send the result and the key of the first rank, such that the other ranks neither poll the file system nor all compile again if the compilation failed
+  std::string libraryCacheKeyFirstRank = libraryCacheKey;
+  MPIUtility::handleReturnValue(MPI_Bcast(&libraryIsAvailable, 1, MPI_INT, 0, libraryCommunicator), "MPI_Bcast");
+  MPIUtility::handleReturnValue(MPI_Bcast(&libraryCacheKeyFirstRank[0], libraryCacheKeyFirstRank.length(), MPI_CHAR, 0, libraryCommunicator), "MPI_Bcast");
+
+  if (ownRankNo != 0)
+  {
+    // if a different library got the same color, this rank has to create its own library
+    if (libraryCacheKeyFirstRank != libraryCacheKey)
     {
-      LOG(WARNING) << "\"compilerFlags\" does not contain \"-O3\", this may be slow.";
+      createLibraryWithLockFile(libraryFilename);
     }
-#endif
-    // for GPU: -ta=host,tesla,time
-
-    // compose compile command
-    std::stringstream s;
-    s << this->cellmlSourceCodeGenerator_.compilerCommand() << " " << sourceToCompileFilename_ << " "
-      << compilerFlags << " " << this->cellmlSourceCodeGenerator_.additionalCompileFlags() << " ";
+    else if (!libraryIsAvailable)
+    {
+      LOG(ERROR) << "Library \"" << libraryFilename << "\" could not be created in the library cache by another rank on this node.";
+    }
+  }
 
-    std::string compileCommandOptions = s.str();
+  MPIUtility::handleReturnValue(MPI_Comm_free(&libraryCommunicator), "MPI_Comm_free");
+  MPIUtility::handleReturnValue(MPI_Comm_free(&nodeCommunicator), "MPI_Comm_free");
+}
 
-    // compile library to filename with "*.rankNoWorldCommunicator", then wait (different wait times for ranks), then rename file to without "*.rankNoWorldCommunicator"
-    compileCommand << compileCommandOptions
-      << " -o " << libraryFilename << "." << rankNoWorldCommunicator << " "
-      //<< " && sleep " << int((rankNoWorldCommunicator%100)/10+1)
-      << " && mv " << libraryFilename << "." << rankNoWorldCommunicator << " " << libraryFilename;
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+bool RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+createLibraryWithLockFile(std::string libraryFilename)
+{
+  // create the cache directory if it does not exist
+  struct stat info;
+  if (stat(libraryCacheDirectory_.c_str(), &info) != 0)
+  {
+    int ret = system((std::string("mkdir -p ")+libraryCacheDirectory_).c_str());
 
-    int ret = system(compileCommand.str().c_str());
     if (ret != 0)
     {
-      LOG(ERROR) << "Compilation failed. Command: \"" << compileCommand.str() << "\".";
+      LOG(ERROR) << "Could not create directory \"" << libraryCacheDirectory_ << "\" for the library cache.";
+    }
+  }
 
-      // remove "-fopenmp" in the compile command
-      std::string newCompileCommand = compileCommand.str();
-      std::string strToReplace = "-fopenmp";
-      std::size_t pos = newCompileCommand.find(strToReplace);
-      newCompileCommand.replace(pos, strToReplace.length(), "");
+  std::string lockFilename = libraryFilename + ".lock";
+  bool outputWaitMessage = true;
 
-      // remove -foffload="..."strToReplace = "-fopenmp";
-      pos = newCompileCommand.find("-foffload=\"");
-      std::size_t pos2 = newCompileCommand.find("\"", pos+11);
-      newCompileCommand.replace(pos, pos2-pos+1, "");
+  // the lock file contains "<hostname> <pid>" of the holder
+  char hostname[256] = {0};
+  gethostname(hostname, sizeof(hostname)-1);
 
-      LOG(INFO) << "Retry without offloading, command: \n" << newCompileCommand;
+  for (;;)
+  {
+    // if the library is already in the cache, we are done
+    if (stat(libraryFilename.c_str(), &info) == 0)
+    {
+      LOG(DEBUG) << "Library \"" << libraryFilename << "\" found in the library cache.";
+      return true;
+    }
 
-      // execute new compilation command
-      int ret = system(newCompileCommand.c_str());
-      if (ret != 0)
+    // try to acquire the lock, this fails if the lock file already exists
+    int fileDescriptor = open(lockFilename.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fileDescriptor != -1)
+    {
+      std::stringstream lockHolder;
+      lockHolder << hostname << " " << getpid() << "\n";
+      if (write(fileDescriptor, lockHolder.str().c_str(), lockHolder.str().length()) == -1)
       {
-        LOG(ERROR) << "Compilation failed again.";
+        LOG(WARNING) << "Could not write to lock file \"" << lockFilename << "\".";
       }
-      else
+      close(fileDescriptor);
+
+      bool compilationSucceeded = true;
+
+      // the library could have been created by another rank before we acquired the lock
+      if (stat(libraryFilename.c_str(), &info) != 0)
       {
-        LOG(DEBUG) << "Compilation successful.";
+        LOG(INFO) << "Compile library \"" << libraryFilename << "\" for the library cache.";
+
+        // renew the lock file while compiling, such that long compilations are not considered stale by processes on other nodes
+        std::atomic<bool> compilationIsDone(false);
+        std::thread renewLockThread([&compilationIsDone, &lockFilename, this]()
+        {
+          const std::chrono::milliseconds renewInterval(std::max(200, int(libraryCacheLockTimeout_*1000/4)));
+          std::chrono::steady_clock::time_point lastRenewal = std::chrono::steady_clock::now();
+          while (!compilationIsDone)
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (std::chrono::steady_clock::now() - lastRenewal >= renewInterval)
+            {
+              utime(lockFilename.c_str(), NULL);
+              lastRenewal = std::chrono::steady_clock::now();
+            }
+          }
+        });
+
+        // the library is compiled to a temporary filename and then renamed, therefore it appears atomically
+        compilationSucceeded = compileLibrary(libraryFilename);
+
+        compilationIsDone = true;
+        renewLockThread.join();
       }
+
+      unlink(lockFilename.c_str());
+      return compilationSucceeded;
     }
-    else
+
+    // another process is compiling the library, check if the lock is stale
+    if (lockFileIsStale(lockFilename, hostname))
+    {
+      LOG(WARNING) << "Lock file \"" << lockFilename << "\" is stale, the process that holds it is no longer running "
+        << "or did not renew it within " << libraryCacheLockTimeout_ << " s (option \"libraryCacheLockTimeout\"), remove it.";
+      unlink(lockFilename.c_str());
+      continue;
+    }
+
+    if (outputWaitMessage)
     {
-      LOG(DEBUG) << "Compilation successful. Command: \"" << compileCommand.str() << "\".";
+      LOG(DEBUG) << "Wait for library \"" << libraryFilename << "\" which is compiled by another process.";
+      outputWaitMessage = false;
     }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
   }
-  else
+}
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+bool RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+lockFileIsStale(std::string lockFilename, std::string hostname)
+{
+  struct stat info;
+  if (stat(lockFilename.c_str(), &info) != 0)
+    return false;
+
+  // if the holder runs on the same host, the lock is stale exactly if the holder process no longer exists
+  std::ifstream lockFile(lockFilename.c_str());
+  std::string lockHostname;
+  pid_t lockPid = 0;
+  if (lockFile >> lockHostname >> lockPid && lockHostname == hostname)
   {
-    LOG(DEBUG) << "we are the wrong rank, do not compile library "
-      << "wait until library has been compiled";
+    return kill(lockPid, 0) != 0 && errno == ESRCH;
   }
+
+  // if the holder runs on a different host, it renews the modification time of the lock file, use the timeout
+  return difftime(time(NULL), info.st_mtime) > libraryCacheLockTimeout_;
+}
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+rhsRoutineInterpreter(void *context, double t, double *states, double *rates, double *algebraics, double *parameters)
+{
+  // the context is the CellmlAdapter object, see CellmlAdapter::evaluateTimesteppingRightHandSideExplicit
+  RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType> *rhsRoutineHandler
+    = static_cast<CellmlAdapter<nStates,nAlgebraics_,FunctionSpaceType> *>(context);
+
+  rhsRoutineHandler->rhsInterpreter_.evaluate(t, states, rates, algebraics, parameters, rhsRoutineHandler->nInstances_);
+}
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+void RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
+rhsRoutineSingleInstanceInterpreter(void *context, double t, double *states, double *rates, double *algebraics, double *parameters)
+{
+  RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType> *rhsRoutineHandler
+    = static_cast<CellmlAdapter<nStates,nAlgebraics_,FunctionSpaceType> *>(context);
+
+  rhsRoutineHandler->rhsInterpreter_.evaluate(t, states, rates, algebraics, parameters, 1);
 }
 
 template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
@@ -366,3 +692,9 @@ std::string RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::optimizat
 {
   return optimizationType_;
 }
+
+template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
+std::string RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::gatingVariablesScheme()
+{
+  return gatingVariablesScheme_;
+}
@@ -515,6 +515,7 @@ parse(std::string line)
       if (entries.size() == 1)
       {
         condition = entries[0];
+        entries.clear();
       }
       else
       {
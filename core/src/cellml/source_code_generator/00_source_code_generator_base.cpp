@@ -9,6 +9,7 @@
 #include <sys/stat.h> // stat
 #include <unistd.h>   // stat
 #include <sstream>
+#include <fstream>
 #include "easylogging++.h"
 #include "utility/vector_operators.h"
 #include "control/dihu_context.h"
@@ -383,3 +384,26 @@ std::string CellmlSourceCodeGeneratorBase::compilerCommand() const
 {
   return compilerCommand_;
 }
+
+void CellmlSourceCodeGeneratorBase::writeModelDescription(std::ostream &stream) const
+{
+  // contents of the source file, this is the converted C file if the model was given as XML file
+  std::ifstream file(sourceFilename_);
+  if (!file.is_open())
+  {
+    LOG(ERROR) << "Could not open CellML source file \"" << sourceFilename_ << "\".";
+  }
+  stream << file.rdbuf() << "\n";
+
+  // layout of the instances and parameters
+  stream << "nInstances: " << nInstances_ << ", nParameters: " << nParameters_
+    << ", nStates: " << nStates_ << ", nAlgebraics: " << nAlgebraics_ << "\n"
+    << "parametersUsedAsAlgebraic: " << parametersUsedAsAlgebraic_ << "\n"
+    << "parametersUsedAsConstant: " << parametersUsedAsConstant_ << "\n";
+
+  // the constants can be modified by the parameters
+  for (const std::string &constantAssignment : constantAssignments_)
+  {
+    stream << constantAssignment << "\n";
+  }
+}
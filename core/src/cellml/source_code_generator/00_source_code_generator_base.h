@@ -60,6 +60,9 @@ public:
   //! get the suffix to use for the source file, e.g. ".c" or ".cpp"
   std::string sourceFileSuffix() const;
 
+  //! write everything that determines the generated source code, apart from the arguments of generateSourceFile, to the stream, this is used as key for the library cache
+  void writeModelDescription(std::ostream &stream) const;
+
 protected:
 
   struct code_expression_t
@@ -838,8 +838,173 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
   sourceFileSuffix_ = ".cpp";
 }
 
+std::string CellmlSourceCodeGeneratorVc::
+getFastMonodomainLineCode(code_expression_t &codeExpression, std::function<std::string(code_expression_t &expression, bool isFirstVariable)> variableName)
+{
+  if (codeExpression.type == code_expression_t::commented_out)
+    return "";
+
+  std::stringstream sourceCodeLine;
+  bool isCommentedOut = false;
+
+  codeExpression.visitLeafs([&sourceCodeLine,&isCommentedOut,&variableName](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
+  {
+    switch(expression.type)
+    {
+      case code_expression_t::variableName:
+
+        if (expression.code == "CONSTANTS")
+        {
+          // constants only exist once for all instances
+          sourceCodeLine << "constant" << expression.arrayIndex;
+        }
+        else if (expression.code == "parameters")
+        {
+          sourceCodeLine << "parameters[" << expression.arrayIndex << "]";
+        }
+        else if (expression.code == "states" || expression.code == "rates" || expression.code == "algebraics")
+        {
+          // all other variables (states, rates, algebraics) exist for every instance, their names depend on the step
+          sourceCodeLine << variableName(expression, isFirstVariable);
+        }
+        else
+        {
+          LOG(FATAL) << "unhandled variable type \"" << expression.code << "\".";
+        }
+        break;
+
+      case code_expression_t::otherCode:
+        sourceCodeLine << expression.code;
+        break;
+
+      case code_expression_t::commented_out:
+        sourceCodeLine << "  // (not assigning to a parameter) " << expression.code;
+        isCommentedOut = true;
+        break;
+
+      default:
+        break;
+    }
+  });
+
+  std::stringstream result;
+  if (isCommentedOut)
+  {
+    result << "  " << sourceCodeLine.str() << std::endl;
+  }
+  else
+  {
+    result << "  const double_v " << sourceCodeLine.str() << std::endl;
+  }
+  return result.str();
+}
+
+std::string CellmlSourceCodeGeneratorVc::
+getRushLarsenCoefficientsCode(const std::vector<int> &rushLarsenStates, std::string statePrefix, std::string stateSuffix,
+                              std::string namePrefix, std::string coefficientName)
+{
+  if (rushLarsenStates.empty())
+    return "";
+
+  // determine on which states the algebraics depend, directly or via other algebraics
+  std::vector<std::set<int>> algebraicStateDependencies(nAlgebraics_);
+  std::vector<std::set<int>> lineStateDependencies(cellMLCode_.lines.size());
+
+  for (int lineNo = 0; lineNo < cellMLCode_.lines.size(); lineNo++)
+  {
+    code_expression_t &codeExpression = cellMLCode_.lines[lineNo];
+    if (codeExpression.type == code_expression_t::commented_out)
+      continue;
+
+    std::string assignedArray;
+    int assignedIndex = -1;
+    std::set<int> &stateDependencies = lineStateDependencies[lineNo];
+
+    codeExpression.visitLeafs([&](code_expression_t &expression, bool isFirstVariable)
+    {
+      if (expression.type != code_expression_t::variableName)
+        return;
+
+      if (isFirstVariable)
+      {
+        assignedArray = expression.code;
+        assignedIndex = expression.arrayIndex;
+      }
+      else if (expression.code == "states")
+      {
+        stateDependencies.insert(expression.arrayIndex);
+      }
+      else if (expression.code == "algebraics" && expression.arrayIndex < algebraicStateDependencies.size())
+      {
+        stateDependencies.insert(algebraicStateDependencies[expression.arrayIndex].begin(), algebraicStateDependencies[expression.arrayIndex].end());
+      }
+    });
+
+    if (assignedArray == "algebraics" && assignedIndex >= 0 && assignedIndex < algebraicStateDependencies.size())
+      algebraicStateDependencies[assignedIndex] = stateDependencies;
+  }
+
+  // The rate of a gating state y is rhs(y) = a + b*y, the coefficient b is computed as b = rhs(y+1) - rhs(y).
+  // For this, all lines that depend on y are evaluated again with y+1.
+  std::stringstream sourceCode;
+  for (int stateNo : rushLarsenStates)
+  {
+    sourceCode << "\n  // coefficient of rate " << stateNo << " = a + b*state" << stateNo << " for Rush-Larsen\n";
+
+    for (int lineNo = 0; lineNo < cellMLCode_.lines.size(); lineNo++)
+    {
+      code_expression_t &codeExpression = cellMLCode_.lines[lineNo];
+      if (lineStateDependencies[lineNo].find(stateNo) == lineStateDependencies[lineNo].end())
+        continue;
+
+      // only the algebraics and the rate of the current state are needed
+      bool isNeeded = true;
+      codeExpression.visitLeafs([&isNeeded,stateNo](code_expression_t &expression, bool isFirstVariable)
+      {
+        if (isFirstVariable && expression.code == "rates" && expression.arrayIndex != stateNo)
+          isNeeded = false;
+      });
+      if (!isNeeded)
+        continue;
+
+      sourceCode << getFastMonodomainLineCode(codeExpression,
+        [&](code_expression_t &expression, bool isFirstVariable)
+      {
+        std::stringstream name;
+        if (expression.code == "states")
+        {
+          if (expression.arrayIndex == stateNo)
+            name << "(" << statePrefix << expression.arrayIndex << stateSuffix << " + 1.0)";
+          else
+            name << statePrefix << expression.arrayIndex << stateSuffix;
+        }
+        else if (expression.code == "rates")
+        {
+          name << namePrefix << (namePrefix.empty()? "rate" : "Rate") << "Perturbed" << expression.arrayIndex;
+        }
+        else if (expression.code == "algebraics")
+        {
+          name << namePrefix << (namePrefix.empty()? "algebraic" : "Algebraic") << expression.arrayIndex;
+
+          // algebraics that depend on the state are also computed again
+          if (expression.arrayIndex < algebraicStateDependencies.size()
+            && algebraicStateDependencies[expression.arrayIndex].find(stateNo) != algebraicStateDependencies[expression.arrayIndex].end())
+          {
+            name << "_perturbed" << stateNo;
+          }
+        }
+        return name.str();
+      });
+    }
+    sourceCode << "  const double_v " << coefficientName << stateNo << " = "
+      << namePrefix << (namePrefix.empty()? "rate" : "Rate") << "Perturbed" << stateNo << " - "
+      << namePrefix << (namePrefix.empty()? "rate" : "Rate") << stateNo << ";\n";
+  }
+  return sourceCode.str();
+}
+
 void CellmlSourceCodeGeneratorVc::
-generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExponentialFunction)
+generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExponentialFunction, const std::vector<int> &rushLarsenStates)
 {
   std::set<std::string> helperFunctions;   //< functions found in the CellML code that need to be provided, usually the pow2, pow3, etc. helper functions for pow(..., 2), pow(...,3) etc.
 
@@ -864,6 +1029,20 @@ generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExp
   // define helper functions
   sourceCode << defineHelperFunctions(helperFunctions, approximateExponentialFunction, true);
 
+  // define the factor (exp(b*dt) - 1)/b of the Rush-Larsen scheme, for small b*dt the Taylor series is used to avoid cancellation
+  if (!rushLarsenStates.empty())
+  {
+    sourceCode << R"(
+// factor (exp(b*dt) - 1)/b of the Rush-Larsen step y_n+1 = y_n + rhs(y_n)*(exp(b*dt) - 1)/b for rhs(y) = a + b*y
+double_v rushLarsenFactor(double_v b, double dt)
+{
+  const double_v x = b*dt;
+  return Vc::iif(Vc::abs(x) < 1e-3, dt*(1.0 + x*(0.5 + x/6.0)), (Vc::exp(x) - 1.0)/b);
+}
+
+)";
+  }
+
   // define initializeStates function
   sourceCode
     << "// set initial values for all states\n"
@@ -916,72 +1095,22 @@ generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExp
   // loop over lines of cellml code
   for (code_expression_t &codeExpression : cellMLCode_.lines)
   {
-    if (codeExpression.type != code_expression_t::commented_out)
+    sourceCode << getFastMonodomainLineCode(codeExpression, [](code_expression_t &expression, bool isFirstVariable)
     {
-      std::stringstream sourceCodeLine;
-      bool isCommentedOut = false;
-      
-      codeExpression.visitLeafs([&sourceCodeLine,&isCommentedOut,this](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
-      {
-        switch(expression.type)
-        {
-          case code_expression_t::variableName:
-
-            if (expression.code == "CONSTANTS")
-            {
-              // constants only exist once for all instances
-              sourceCodeLine << "constant" << expression.arrayIndex;
-            }
-            else
-            {
-              // all other variables (states, rates, algebraics, parameters) exist for every instance
-              if (expression.code == "states")
-              {
-                sourceCodeLine << "states[" << expression.arrayIndex << "]";
-              }
-              else if (expression.code == "rates")
-              {
-                sourceCodeLine << "rate" << expression.arrayIndex;
-              }
-              else if (expression.code == "algebraics")
-              {
-                sourceCodeLine << "algebraic" << expression.arrayIndex;
-              }
-              else if (expression.code == "parameters")
-              {
-                sourceCodeLine << "parameters[" << expression.arrayIndex << "]";
-              }
-              else
-              {
-                LOG(FATAL) << "unhandled variable type \"" << expression.code << "\".";
-              }
-            }
-            break;
-
-          case code_expression_t::otherCode:
-            sourceCodeLine << expression.code;
-            break;
+      std::stringstream name;
+      if (expression.code == "states")
+        name << "states[" << expression.arrayIndex << "]";
+      else if (expression.code == "rates")
+        name << "rate" << expression.arrayIndex;
+      else if (expression.code == "algebraics")
+        name << "algebraic" << expression.arrayIndex;
+      return name.str();
+    });
+  }
 
-          case code_expression_t::commented_out:
-            sourceCodeLine << "  // (not assigning to a parameter) " << expression.code;
-            isCommentedOut = true;
-            break;
+  // for the Rush-Larsen scheme, compute the coefficients b of the rates a + b*y of the gating states y
+  sourceCode << getRushLarsenCoefficientsCode(rushLarsenStates, "states[", "]", "", "rateCoefficient");
 
-          default:
-            break;
-        }
-      });
-      
-      if (isCommentedOut)
-      {
-        sourceCode << "  " << sourceCodeLine.str() << std::endl;
-      }
-      else
-      {
-        sourceCode << "  const double_v " << sourceCodeLine.str() << std::endl;
-      }
-    }
-  }
   sourceCode << "\n"
     << "  // algebraic step\n"
     << "  // compute y* = y_n + dt*rhs(y_n), y_n = state, rhs(y_n) = rate, y* = algebraicState\n";
@@ -992,7 +1121,16 @@ generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExp
     if (stateNo != 0)
       sourceCode << "const ";
 
-    sourceCode << "double_v algebraicState" << stateNo << " = states[" << stateNo << "] + timeStepWidth*rate" << stateNo << ";\n";
+    // for the gating states, this is a Rush-Larsen step
+    if (std::find(rushLarsenStates.begin(), rushLarsenStates.end(), stateNo) != rushLarsenStates.end())
+    {
+      sourceCode << "double_v algebraicState" << stateNo << " = states[" << stateNo << "] + rate" << stateNo
+        << "*rushLarsenFactor(rateCoefficient" << stateNo << ", timeStepWidth);\n";
+    }
+    else
+    {
+      sourceCode << "double_v algebraicState" << stateNo << " = states[" << stateNo << "] + timeStepWidth*rate" << stateNo << ";\n";
+    }
   }
   sourceCode << "\n\n"
     << R"(
@@ -1010,72 +1148,19 @@ generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExp
   // loop over lines of cellml code
   for (code_expression_t &codeExpression : cellMLCode_.lines)
   {
-    if (codeExpression.type != code_expression_t::commented_out)
+    sourceCode << getFastMonodomainLineCode(codeExpression, [](code_expression_t &expression, bool isFirstVariable)
     {
-      std::stringstream sourceCodeLine;
-      bool isCommentedOut = false;
-      
-      codeExpression.visitLeafs([&sourceCodeLine,&isCommentedOut,this](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
-      {
-        switch(expression.type)
-        {
-          case code_expression_t::variableName:
-
-            if (expression.code == "CONSTANTS")
-            {
-              // constants only exist once for all instances
-              sourceCodeLine << "constant" << expression.arrayIndex;
-            }
-            else
-            {
-              // all other variables (states, rates, algebraics, parameters) exist for every instance
-              if (expression.code == "states")
-              {
-                sourceCodeLine << "algebraicState" << expression.arrayIndex;
-              }
-              else if (expression.code == "rates")
-              {
-                sourceCodeLine << "algebraicRate" << expression.arrayIndex;
-              }
-              else if (expression.code == "algebraics")
-              {
-                sourceCodeLine << "algebraicAlgebraic" << expression.arrayIndex;
-              }
-              else if (expression.code == "parameters")
-              {
-                sourceCodeLine << "parameters[" << expression.arrayIndex << "]";
-              }
-              else
-              {
-                LOG(FATAL) << "unhandled variable type \"" << expression.code << "\".";
-              }
-            }
-            break;
-
-          case code_expression_t::otherCode:
-            sourceCodeLine << expression.code;
-            break;
-
-          case code_expression_t::commented_out:
-            sourceCodeLine << "  // (not assigning to a parameter) " << expression.code;
-            isCommentedOut = true;
-            break;
-
-          default:
-            break;
-        }
-      });
-      
-      if (isCommentedOut)
-      {
-        sourceCode << "  " << sourceCodeLine.str() << std::endl;
-      }
-      else
-      {
-        sourceCode << "  const double_v " << sourceCodeLine.str() << std::endl;
-      }
-    }
+      std::stringstream name;
+      if (expression.code == "states")
+        name << "algebraicState" << expression.arrayIndex;
+      else if (expression.code == "rates")
+        name << "algebraicRate" << expression.arrayIndex;
+      else if (expression.code == "algebraics")
+        name << "algebraicAlgebraic" << expression.arrayIndex;
+      return name.str();
+    });
   }
+  sourceCode << getRushLarsenCoefficientsCode(rushLarsenStates, "algebraicState", "", "algebraic", "algebraicRateCoefficient");
   sourceCode << std::endl;
 
   sourceCode << R"(
@@ -1085,7 +1170,21 @@ generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExp
 
   for (int stateNo = 0; stateNo < this->nStates_; stateNo++)
   {
-    sourceCode << "  states[" << stateNo << "] += 0.5*timeStepWidth*(rate" << stateNo << " + algebraicRate" << stateNo << ");\n";
+    if (std::find(rushLarsenStates.begin(), rushLarsenStates.end(), stateNo) != rushLarsenStates.end())
+    {
+      // Rush-Larsen step for gating state with the averaged coefficients of rhs(y) = a + b*y at y_n and y*,
+      // y_n+1 = y_n + (a + b*y_n)*(exp(b*dt) - 1)/b
+      sourceCode << "  {\n"
+        << "    const double_v b = 0.5*(rateCoefficient" << stateNo << " + algebraicRateCoefficient" << stateNo << ");\n"
+        << "    const double_v a = 0.5*(rate" << stateNo << " - rateCoefficient" << stateNo << "*states[" << stateNo << "]"
+        << " + algebraicRate" << stateNo << " - algebraicRateCoefficient" << stateNo << "*algebraicState" << stateNo << ");\n"
+        << "    states[" << stateNo << "] += (a + b*states[" << stateNo << "])*rushLarsenFactor(b, timeStepWidth);\n"
+        << "  }\n";
+    }
+    else
+    {
+      sourceCode << "  states[" << stateNo << "] += 0.5*timeStepWidth*(rate" << stateNo << " + algebraicRate" << stateNo << ");\n";
+    }
   }
 
   sourceCode << R"(
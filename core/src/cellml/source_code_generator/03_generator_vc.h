@@ -21,7 +21,9 @@ public:
 
   //! write the source file with explicit vectorization using Vc
   //! The file contains the source for the total solve the rhs computation
-  void generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExponentialFunction);
+  //! @param rushLarsenStates the gating states that are integrated with the Rush-Larsen scheme instead of Heun, e.g. from findGatingStates()
+  void generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExponentialFunction,
+                                        const std::vector<int> &rushLarsenStates = std::vector<int>());
 
 protected:
 
@@ -32,6 +34,14 @@ protected:
   //! define "pow" and "exponential" helper functions
   std::string defineHelperFunctions(std::set<std::string> &helperFunctions, bool approximateExponentialFunction, bool useVc, bool useReal = true);
 
+  //! get the code of a line of the CellML code for generateSourceFileFastMonodomain, variableName(expression, isFirstVariable) gives the names of the states, rates and algebraics
+  std::string getFastMonodomainLineCode(code_expression_t &codeExpression, std::function<std::string(code_expression_t &expression, bool isFirstVariable)> variableName);
+
+  //! get the code that computes the coefficients b of the rates a + b*y of the rushLarsenStates y, in variables <coefficientName><stateNo>,
+  //! the states are named <statePrefix><stateNo><stateSuffix>, the rates and algebraics start with namePrefix
+  std::string getRushLarsenCoefficientsCode(const std::vector<int> &rushLarsenStates, std::string statePrefix, std::string stateSuffix,
+                                            std::string namePrefix, std::string coefficientName);
+
   //! Write the source file with explicit vectorization using Vc
   //! The file contains the source for only the rhs computation
   void generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunction);
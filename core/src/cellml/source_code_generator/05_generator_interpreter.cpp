@@ -0,0 +1,728 @@
+#include "cellml/source_code_generator/05_generator_interpreter.h"
+
+#include <Python.h>  // has to be the first included header
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include "easylogging++.h"
+#include "utility/vector_operators.h"
+
+namespace
+{
+
+//! a token of a line of the model source code
+struct InterpreterToken
+{
+  enum {number, identifier, variable, symbol, end} type;
+
+  std::string code;      //< the identifier, the symbol or, if type=variable, the name of the array, e.g. "states" or "CONSTANTS"
+  int arrayIndex = 0;    //< if type=variable, the index of the variable
+  double value = 0.0;    //< if type=number, the value
+};
+
+//! a node of the syntax tree of an arithmetic expression
+struct InterpreterNode
+{
+  enum {constant, time, variable, operation} type;
+
+  CellmlRhsInterpreter::opcode_t opcode = CellmlRhsInterpreter::loadConstant;      //< if type=operation, the operation, the operands are the children
+  CellmlRhsInterpreter::variable_t array = CellmlRhsInterpreter::statesArray;      //< if type=variable, the array of the variable
+  int index = 0;                                //< if type=variable, the index of the variable
+  double value = 0.0;                           //< if type=constant, the value
+
+  std::vector<InterpreterNode> children;        //< the operands of an operation
+};
+
+//! split a piece of code into tokens and append them to tokens
+void tokenize(const std::string &code, std::vector<InterpreterToken> &tokens)
+{
+  for (size_t pos = 0; pos < code.length();)
+  {
+    const char c = code[pos];
+    if (isspace(c))
+    {
+      pos++;
+      continue;
+    }
+
+    InterpreterToken token;
+    if (isdigit(c) || (c == '.' && pos+1 < code.length() && isdigit(code[pos+1])))
+    {
+      // number, possibly with exponent, e.g. "1.00000e+06"
+      const char *begin = code.c_str() + pos;
+      char *end = nullptr;
+      token.type = InterpreterToken::number;
+      token.value = strtod(begin, &end);
+      token.code = code.substr(pos, end-begin);
+      pos += end-begin;
+    }
+    else if (isalpha(c) || c == '_')
+    {
+      // identifier, e.g. a function name or "VOI"
+      size_t endPos = pos;
+      while (endPos < code.length() && (isalnum(code[endPos]) || code[endPos] == '_'))
+        endPos++;
+
+      token.type = InterpreterToken::identifier;
+      token.code = code.substr(pos, endPos-pos);
+      pos = endPos;
+    }
+    else
+    {
+      // operators with one or two characters
+      std::string twoCharacters = code.substr(pos, 2);
+      token.type = InterpreterToken::symbol;
+      if (twoCharacters == "<=" || twoCharacters == ">=" || twoCharacters == "==" || twoCharacters == "!="
+        || twoCharacters == "&&" || twoCharacters == "||")
+      {
+        token.code = twoCharacters;
+        pos += 2;
+      }
+      else
+      {
+        token.code = std::string(1, c);
+        pos++;
+      }
+    }
+    tokens.push_back(token);
+  }
+}
+
+/** Recursive descent parser for a line "<variable> = <expression>;" of the model source code.
+ *  The precedence of the operators is the same as in C.
+ */
+class InterpreterParser
+{
+public:
+  //! constructor, line is only used for error messages
+  InterpreterParser(const std::vector<InterpreterToken> &tokens, const std::vector<double> &constantValues,
+                    const std::vector<bool> &constantIsAssigned, const std::string &line) :
+    tokens_(tokens), constantValues_(constantValues), constantIsAssigned_(constantIsAssigned), line_(line), position_(0)
+  {
+  }
+
+  //! parse the whole line, set the name and index of the assigned variable and the syntax tree of the expression
+  void parseAssignment(std::string &arrayName, int &arrayIndex, InterpreterNode &expression)
+  {
+    if (tokens_[position_].type != InterpreterToken::variable)
+      error("Expected variable at the beginning of the line");
+
+    arrayName = tokens_[position_].code;
+    arrayIndex = tokens_[position_].arrayIndex;
+    position_++;
+
+    expectSymbol("=");
+    expression = parseTernary();
+
+    // the semicolon at the end of the line is optional
+    if (isSymbol(";"))
+      position_++;
+
+    if (tokens_[position_].type != InterpreterToken::end)
+      error(std::string("Unexpected \"") + tokens_[position_].code + "\"");
+  }
+
+private:
+
+  //! ternary operator, it has the lowest precedence and is right-associative
+  InterpreterNode parseTernary()
+  {
+    InterpreterNode condition = parseBinary(1);
+    if (!isSymbol("?"))
+      return condition;
+
+    position_++;
+    InterpreterNode valueIfTrue = parseTernary();
+    expectSymbol(":");
+    InterpreterNode valueIfFalse = parseTernary();
+
+    return operation(CellmlRhsInterpreter::select, {condition, valueIfTrue, valueIfFalse});
+  }
+
+  //! left-associative binary operators with precedence at least minimumPrecedence
+  InterpreterNode parseBinary(int minimumPrecedence)
+  {
+    static const std::map<std::string, std::pair<int,CellmlRhsInterpreter::opcode_t>> binaryOperators = {
+      {"||", {1, CellmlRhsInterpreter::logicalOr}},
+      {"&&", {2, CellmlRhsInterpreter::logicalAnd}},
+      {"==", {3, CellmlRhsInterpreter::equal}},
+      {"!=", {3, CellmlRhsInterpreter::notEqual}},
+      {"<",  {4, CellmlRhsInterpreter::less}},
+      {"<=", {4, CellmlRhsInterpreter::lessEqual}},
+      {">",  {4, CellmlRhsInterpreter::greater}},
+      {">=", {4, CellmlRhsInterpreter::greaterEqual}},
+      {"+",  {5, CellmlRhsInterpreter::add}},
+      {"-",  {5, CellmlRhsInterpreter::subtract}},
+      {"*",  {6, CellmlRhsInterpreter::multiply}},
+      {"/",  {6, CellmlRhsInterpreter::divide}}
+    };
+
+    InterpreterNode leftOperand = parseUnary();
+    for (;;)
+    {
+      if (tokens_[position_].type != InterpreterToken::symbol)
+        break;
+
+      std::map<std::string, std::pair<int,CellmlRhsInterpreter::opcode_t>>::const_iterator iter = binaryOperators.find(tokens_[position_].code);
+      if (iter == binaryOperators.end() || iter->second.first < minimumPrecedence)
+        break;
+
+      position_++;
+      InterpreterNode rightOperand = parseBinary(iter->second.first + 1);
+      leftOperand = operation(iter->second.second, {leftOperand, rightOperand});
+    }
+    return leftOperand;
+  }
+
+  //! unary operators "-", "+" and "!"
+  InterpreterNode parseUnary()
+  {
+    if (isSymbol("-"))
+    {
+      position_++;
+      return operation(CellmlRhsInterpreter::negate, {parseUnary()});
+    }
+    else if (isSymbol("+"))
+    {
+      position_++;
+      return parseUnary();
+    }
+    else if (isSymbol("!"))
+    {
+      position_++;
+      return operation(CellmlRhsInterpreter::logicalNot, {parseUnary()});
+    }
+    return parsePrimary();
+  }
+
+  //! numbers, variables, function calls and expressions in parantheses
+  InterpreterNode parsePrimary()
+  {
+    const InterpreterToken &token = tokens_[position_];
+    InterpreterNode node;
+
+    if (token.type == InterpreterToken::number)
+    {
+      position_++;
+      node.type = InterpreterNode::constant;
+      node.value = token.value;
+    }
+    else if (token.type == InterpreterToken::variable)
+    {
+      position_++;
+      if (token.code == "CONSTANTS")
+      {
+        // constants are replaced by their value
+        node.type = InterpreterNode::constant;
+        if (token.arrayIndex < constantIsAssigned_.size() && constantIsAssigned_[token.arrayIndex])
+        {
+          node.value = constantValues_[token.arrayIndex];
+        }
+        else
+        {
+          LOG(WARNING) << "CONSTANTS[" << token.arrayIndex << "] is used but not assigned in the model, using value 0. Line: [" << line_ << "]";
+        }
+      }
+      else
+      {
+        node.type = InterpreterNode::variable;
+        node.index = token.arrayIndex;
+        if (token.code == "states")
+          node.array = CellmlRhsInterpreter::statesArray;
+        else if (token.code == "rates")
+          node.array = CellmlRhsInterpreter::ratesArray;
+        else if (token.code == "algebraics")
+          node.array = CellmlRhsInterpreter::algebraicsArray;
+        else if (token.code == "parameters")
+          node.array = CellmlRhsInterpreter::parametersArray;
+        else
+          error(std::string("Unknown variable \"") + token.code + "\"");
+      }
+    }
+    else if (isSymbol("("))
+    {
+      position_++;
+      node = parseTernary();
+      expectSymbol(")");
+    }
+    else if (token.type == InterpreterToken::identifier)
+    {
+      position_++;
+      if (token.code == "VOI")
+      {
+        node.type = InterpreterNode::time;
+      }
+      else if (isSymbol("("))
+      {
+        node = parseFunctionCall(token.code);
+      }
+      else
+      {
+        error(std::string("Unknown identifier \"") + token.code + "\"");
+      }
+    }
+    else
+    {
+      error(std::string("Unexpected \"") + token.code + "\"");
+    }
+    return node;
+  }
+
+  //! call of a function of the math library, the current token is the opening paranthesis
+  InterpreterNode parseFunctionCall(std::string functionName)
+  {
+    static const std::map<std::string, CellmlRhsInterpreter::opcode_t> functions = {
+      {"exp", CellmlRhsInterpreter::exp},     {"log", CellmlRhsInterpreter::log},     {"log10", CellmlRhsInterpreter::log10},
+      {"sqrt", CellmlRhsInterpreter::sqrt},   {"fabs", CellmlRhsInterpreter::fabs},   {"abs", CellmlRhsInterpreter::fabs},
+      {"floor", CellmlRhsInterpreter::floor}, {"ceil", CellmlRhsInterpreter::ceil},
+      {"sin", CellmlRhsInterpreter::sin},     {"cos", CellmlRhsInterpreter::cos},     {"tan", CellmlRhsInterpreter::tan},
+      {"asin", CellmlRhsInterpreter::asin},   {"acos", CellmlRhsInterpreter::acos},   {"atan", CellmlRhsInterpreter::atan},
+      {"sinh", CellmlRhsInterpreter::sinh},   {"cosh", CellmlRhsInterpreter::cosh},   {"tanh", CellmlRhsInterpreter::tanh},
+      {"pow", CellmlRhsInterpreter::pow},     {"atan2", CellmlRhsInterpreter::atan2},
+      {"fmin", CellmlRhsInterpreter::minimum}, {"min", CellmlRhsInterpreter::minimum},
+      {"fmax", CellmlRhsInterpreter::maximum}, {"max", CellmlRhsInterpreter::maximum}
+    };
+
+    // parse the arguments
+    std::vector<InterpreterNode> arguments;
+    expectSymbol("(");
+    if (!isSymbol(")"))
+    {
+      arguments.push_back(parseTernary());
+      while (isSymbol(","))
+      {
+        position_++;
+        arguments.push_back(parseTernary());
+      }
+    }
+    expectSymbol(")");
+
+    // arbitrary_log(x, base) from OpenCOR is log(x)/log(base)
+    if (functionName == "arbitrary_log" && arguments.size() == 2)
+    {
+      return operation(CellmlRhsInterpreter::divide, {
+        operation(CellmlRhsInterpreter::log, {arguments[0]}),
+        operation(CellmlRhsInterpreter::log, {arguments[1]})
+      });
+    }
+
+    std::map<std::string, CellmlRhsInterpreter::opcode_t>::const_iterator iter = functions.find(functionName);
+    if (iter == functions.end())
+    {
+      error(std::string("Function \"") + functionName + "\" is not supported by the interpreter");
+    }
+
+    const int nArguments = (CellmlRhsInterpreter::isBinaryOperation(iter->second)? 2 : 1);
+    if (arguments.size() != nArguments)
+    {
+      std::stringstream message;
+      message << "Function \"" << functionName << "\" expects " << nArguments << " argument" << (nArguments == 1? "" : "s")
+        << ", but " << arguments.size() << " are given";
+      error(message.str());
+    }
+
+    return operation(iter->second, arguments);
+  }
+
+  //! create a node of an operation
+  InterpreterNode operation(CellmlRhsInterpreter::opcode_t opcode, const std::vector<InterpreterNode> &operands)
+  {
+    InterpreterNode node;
+    node.type = InterpreterNode::operation;
+    node.opcode = opcode;
+    node.children = operands;
+    return node;
+  }
+
+  //! check if the current token is the given symbol
+  bool isSymbol(std::string symbol) const
+  {
+    return tokens_[position_].type == InterpreterToken::symbol && tokens_[position_].code == symbol;
+  }
+
+  //! advance over the given symbol, it is an error if the current token is a different one
+  void expectSymbol(std::string symbol)
+  {
+    if (!isSymbol(symbol))
+      error(std::string("Expected \"") + symbol + "\", but found \"" + tokens_[position_].code + "\"");
+    position_++;
+  }
+
+  //! abort with an error message
+  void error(std::string message) const
+  {
+    LOG(FATAL) << "Could not parse the model for the CellML rhs interpreter: " << message << " in line [" << line_ << "]. "
+      << "Use a different \"optimizationType\" for this model.";
+  }
+
+  const std::vector<InterpreterToken> &tokens_;     //< the tokens of the line, the last token has type end
+  const std::vector<double> &constantValues_;       //< the values of the constants that were computed so far
+  const std::vector<bool> &constantIsAssigned_;     //< for every constant if its value has been computed
+  std::string line_;                                //< the line, for error messages
+  int position_;                                    //< index of the current token
+};
+
+// forward declaration
+void emitInstructions(const InterpreterNode &node, CellmlRhsInterpreter &program);
+
+//! evaluate all operations that only depend on constant values and replace them by their result
+void foldConstants(InterpreterNode &node)
+{
+  if (node.type != InterpreterNode::operation)
+    return;
+
+  bool allOperandsAreConstant = true;
+  for (InterpreterNode &child : node.children)
+  {
+    foldConstants(child);
+    if (child.type != InterpreterNode::constant)
+      allOperandsAreConstant = false;
+  }
+
+  // a ternary operator with constant condition is replaced by the selected value
+  if (node.opcode == CellmlRhsInterpreter::select && node.children[0].type == InterpreterNode::constant)
+  {
+    InterpreterNode selectedValue = node.children[node.children[0].value != 0.0? 1 : 2];
+    node = selectedValue;
+    return;
+  }
+
+  if (allOperandsAreConstant)
+  {
+    // evaluate the operation with a program for a single instance, such that the result is the same as at runtime
+    CellmlRhsInterpreter program;
+    emitInstructions(node, program);
+    program.addInstruction(CellmlRhsInterpreter::store, CellmlRhsInterpreter::noImmediate, CellmlRhsInterpreter::algebraicsArray, 0);
+
+    double result = 0.0;
+    program.evaluate(0.0, nullptr, nullptr, &result, nullptr, 1);
+
+    node.type = InterpreterNode::constant;
+    node.value = result;
+    node.children.clear();
+  }
+}
+
+//! append the instructions that compute the expression to the program
+void emitInstructions(const InterpreterNode &node, CellmlRhsInterpreter &program)
+{
+  switch (node.type)
+  {
+  case InterpreterNode::constant:
+    program.addInstruction(CellmlRhsInterpreter::loadConstant, CellmlRhsInterpreter::noImmediate, CellmlRhsInterpreter::statesArray, 0, node.value);
+    break;
+
+  case InterpreterNode::time:
+    program.addInstruction(CellmlRhsInterpreter::loadTime);
+    break;
+
+  case InterpreterNode::variable:
+    program.addInstruction(CellmlRhsInterpreter::loadVariable, CellmlRhsInterpreter::noImmediate, node.array, node.index);
+    break;
+
+  case InterpreterNode::operation:
+    {
+      const std::vector<InterpreterNode> &operands = node.children;
+
+      // pow with small integer exponent is computed by multiplications
+      if (node.opcode == CellmlRhsInterpreter::pow && operands[1].type == InterpreterNode::constant
+        && operands[1].value == std::floor(operands[1].value) && std::fabs(operands[1].value) <= 32)
+      {
+        emitInstructions(operands[0], program);
+        program.addInstruction(CellmlRhsInterpreter::powInteger, CellmlRhsInterpreter::noImmediate, CellmlRhsInterpreter::statesArray, int(operands[1].value));
+      }
+      // binary operations with a constant operand use the value directly instead of loading it
+      else if (CellmlRhsInterpreter::isBinaryOperation(node.opcode) && operands[1].type == InterpreterNode::constant)
+      {
+        emitInstructions(operands[0], program);
+        program.addInstruction(node.opcode, CellmlRhsInterpreter::rightImmediate, CellmlRhsInterpreter::statesArray, 0, operands[1].value);
+      }
+      else if (CellmlRhsInterpreter::isBinaryOperation(node.opcode) && operands[0].type == InterpreterNode::constant)
+      {
+        emitInstructions(operands[1], program);
+        program.addInstruction(node.opcode, CellmlRhsInterpreter::leftImmediate, CellmlRhsInterpreter::statesArray, 0, operands[0].value);
+      }
+      else
+      {
+        for (const InterpreterNode &operand : operands)
+        {
+          emitInstructions(operand, program);
+        }
+        program.addInstruction(node.opcode);
+      }
+    }
+    break;
+  };
+}
+
+//! classification of an expression with respect to a state y, used to find the gating states
+enum dependency_t
+{
+  independent = 0,       //< the expression does not depend on y
+  affine = 1,            //< the expression is a + b*y, where a and b do not depend on y
+  nonlinear = 2          //< any other dependency on y
+};
+
+//! get the dependency of the expression on all states, stateDependencies[stateNo] = dependency, states that are not contained are independent, algebraicDependencies are the dependencies of the algebraics that were assigned before
+void determineStateDependencies(const InterpreterNode &node, const std::vector<std::map<int,dependency_t>> &algebraicDependencies,
+                                std::map<int,dependency_t> &stateDependencies)
+{
+  stateDependencies.clear();
+  switch (node.type)
+  {
+  case InterpreterNode::constant:
+  case InterpreterNode::time:
+    break;
+
+  case InterpreterNode::variable:
+    if (node.array == CellmlRhsInterpreter::statesArray)
+    {
+      stateDependencies[node.index] = affine;
+    }
+    else if (node.array == CellmlRhsInterpreter::algebraicsArray && node.index < algebraicDependencies.size())
+    {
+      stateDependencies = algebraicDependencies[node.index];
+    }
+    break;
+
+  case InterpreterNode::operation:
+    {
+      std::vector<std::map<int,dependency_t>> operandDependencies(node.children.size());
+      for (int i = 0; i < node.children.size(); i++)
+      {
+        determineStateDependencies(node.children[i], algebraicDependencies, operandDependencies[i]);
+      }
+
+      switch (node.opcode)
+      {
+      case CellmlRhsInterpreter::negate:
+        stateDependencies = operandDependencies[0];
+        break;
+
+      case CellmlRhsInterpreter::add:
+      case CellmlRhsInterpreter::subtract:
+        // a sum is affine in y if all summands are affine or independent
+        stateDependencies = operandDependencies[0];
+        for (const std::pair<const int,dependency_t> &entry : operandDependencies[1])
+        {
+          stateDependencies[entry.first] = std::max(stateDependencies[entry.first], entry.second);
+        }
+        break;
+
+      case CellmlRhsInterpreter::multiply:
+        // a product is affine in y if only one factor depends on y and this factor is affine
+        stateDependencies = operandDependencies[0];
+        for (const std::pair<const int,dependency_t> &entry : operandDependencies[1])
+        {
+          if (stateDependencies.find(entry.first) == stateDependencies.end())
+            stateDependencies[entry.first] = entry.second;
+          else
+            stateDependencies[entry.first] = nonlinear;
+        }
+        break;
+
+      case CellmlRhsInterpreter::divide:
+        // a quotient is affine in y if the numerator is affine and the denominator does not depend on y
+        stateDependencies = operandDependencies[0];
+        for (const std::pair<const int,dependency_t> &entry : operandDependencies[1])
+        {
+          stateDependencies[entry.first] = nonlinear;
+        }
+        break;
+
+      case CellmlRhsInterpreter::select:
+        // a ternary operator is affine in y if the condition does not depend on y and both values are affine
+        stateDependencies = operandDependencies[1];
+        for (const std::pair<const int,dependency_t> &entry : operandDependencies[2])
+        {
+          stateDependencies[entry.first] = std::max(stateDependencies[entry.first], entry.second);
+        }
+        for (const std::pair<const int,dependency_t> &entry : operandDependencies[0])
+        {
+          stateDependencies[entry.first] = nonlinear;
+        }
+        break;
+
+      default:
+        // all other operations are nonlinear in all variables that they depend on
+        for (const std::map<int,dependency_t> &dependencies : operandDependencies)
+        {
+          for (const std::pair<const int,dependency_t> &entry : dependencies)
+          {
+            stateDependencies[entry.first] = nonlinear;
+          }
+        }
+        break;
+      }
+    }
+    break;
+  };
+
+  // remove entries of states that are independent
+  for (std::map<int,dependency_t>::iterator iter = stateDependencies.begin(); iter != stateDependencies.end();)
+  {
+    if (iter->second == independent)
+      iter = stateDependencies.erase(iter);
+    else
+      iter++;
+  }
+}
+
+}  // namespace
+
+template<typename Callback>
+void CellmlSourceCodeGeneratorInterpreter::
+parseRhsLines(Callback callback)
+{
+  // get the tokens of a parsed line, returns false if the line is not used because it assigns a parameter
+  auto getTokens = [](code_expression_t &codeExpression, std::vector<InterpreterToken> &tokens) -> bool
+  {
+    bool lineIsUsed = true;
+    codeExpression.visitLeafs([&tokens,&lineIsUsed](code_expression_t &expression, bool isFirstVariable)
+    {
+      switch(expression.type)
+      {
+      case code_expression_t::variableName:
+        {
+          InterpreterToken token;
+          token.type = InterpreterToken::variable;
+          token.code = expression.code;
+          token.arrayIndex = expression.arrayIndex;
+          tokens.push_back(token);
+        }
+        break;
+
+      case code_expression_t::otherCode:
+        tokenize(expression.code, tokens);
+        break;
+
+      case code_expression_t::commented_out:
+        lineIsUsed = false;
+        break;
+
+      default:
+        break;
+      };
+    });
+
+    InterpreterToken endToken;
+    endToken.type = InterpreterToken::end;
+    tokens.push_back(endToken);
+    return lineIsUsed;
+  };
+
+  // compute the values of the constants, in the order of their assignments in the source code
+  std::vector<double> constantValues(nConstants_, 0.0);
+  std::vector<bool> constantIsAssigned(nConstants_, false);
+
+  for (const std::string &line : constantAssignments_)
+  {
+    code_expression_t codeExpression;
+    codeExpression.parse(line);
+
+    std::vector<InterpreterToken> tokens;
+    getTokens(codeExpression, tokens);
+
+    std::string arrayName;
+    int constantNo = 0;
+    InterpreterNode expression;
+    InterpreterParser(tokens, constantValues, constantIsAssigned, line).parseAssignment(arrayName, constantNo, expression);
+    foldConstants(expression);
+
+    if (arrayName != "CONSTANTS" || expression.type != InterpreterNode::constant)
+    {
+      LOG(FATAL) << "The assignment of a constant in line [" << line << "] does not only depend on constant values. "
+        << "This is not supported by the CellML rhs interpreter, use a different \"optimizationType\" for this model.";
+    }
+
+    if (constantNo >= constantValues.size())
+    {
+      constantValues.resize(constantNo+1, 0.0);
+      constantIsAssigned.resize(constantNo+1, false);
+    }
+    constantValues[constantNo] = expression.value;
+    constantIsAssigned[constantNo] = true;
+  }
+
+  // parse all lines of the rhs
+  for (code_expression_t &codeExpression : cellMLCode_.lines)
+  {
+    if (codeExpression.type == code_expression_t::commented_out)
+      continue;
+
+    std::vector<InterpreterToken> tokens;
+    if (!getTokens(codeExpression, tokens))
+      continue;
+
+    std::string arrayName;
+    int variableNo = 0;
+    InterpreterNode expression;
+    InterpreterParser(tokens, constantValues, constantIsAssigned, codeExpression.getString()).parseAssignment(arrayName, variableNo, expression);
+    foldConstants(expression);
+
+    if (arrayName != "rates" && arrayName != "algebraics")
+    {
+      LOG(FATAL) << "The CellML rhs interpreter can only assign rates and algebraics, not \"" << arrayName << "\", "
+        << "in line " << codeExpression.getString() << ".";
+    }
+
+    callback(arrayName, variableNo, expression);
+  }
+}
+
+void CellmlSourceCodeGeneratorInterpreter::
+generateInterpreterProgram(CellmlRhsInterpreter &program)
+{
+  LOG(DEBUG) << "generateInterpreterProgram";
+
+  program.clear();
+
+  // create the instructions for all lines of the rhs
+  parseRhsLines([&program](const std::string &arrayName, int variableNo, InterpreterNode &expression)
+  {
+    CellmlRhsInterpreter::variable_t variable = (arrayName == "rates"? CellmlRhsInterpreter::ratesArray : CellmlRhsInterpreter::algebraicsArray);
+
+    emitInstructions(expression, program);
+    program.addInstruction(CellmlRhsInterpreter::store, CellmlRhsInterpreter::noImmediate, variable, variableNo);
+  });
+
+  LOG(DEBUG) << "CellML rhs interpreter program has " << program.nInstructions() << " instructions.";
+  VLOG(1) << program.getString();
+}
+
+std::vector<int> CellmlSourceCodeGeneratorInterpreter::
+findGatingStates()
+{
+  std::vector<std::map<int,dependency_t>> algebraicDependencies(nAlgebraics_);
+  std::vector<int> gatingStates;
+
+  parseRhsLines([&algebraicDependencies,&gatingStates](const std::string &arrayName, int variableNo, InterpreterNode &expression)
+  {
+    std::map<int,dependency_t> stateDependencies;
+    determineStateDependencies(expression, algebraicDependencies, stateDependencies);
+
+    if (arrayName == "algebraics")
+    {
+      if (variableNo >= algebraicDependencies.size())
+        algebraicDependencies.resize(variableNo+1);
+      algebraicDependencies[variableNo] = stateDependencies;
+    }
+    else
+    {
+      // the rate of a gating state is an affine function of the state itself, the first state is the membrane voltage and is never a gating state
+      std::map<int,dependency_t>::iterator iter = stateDependencies.find(variableNo);
+      if (variableNo != 0 && iter != stateDependencies.end() && iter->second == affine)
+        gatingStates.push_back(variableNo);
+    }
+  });
+
+  std::sort(gatingStates.begin(), gatingStates.end());
+  LOG(DEBUG) << "found " << gatingStates.size() << " gating states: " << gatingStates;
+  return gatingStates;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include "cellml/source_code_generator/04_generator_gpu.h"
+#include "cellml/source_code_generator/rhs_interpreter.h"
+
+class CellmlSourceCodeGeneratorInterpreter :
+  public CellmlSourceCodeGeneratorGpu
+{
+public:
+  //! constructor of parent class
+  using CellmlSourceCodeGeneratorGpu::CellmlSourceCodeGeneratorGpu;
+
+  //! create the bytecode program of the rhs from the parsed source code, this is used instead of a compiled library for optimizationType "interpreter"
+  void generateInterpreterProgram(CellmlRhsInterpreter &program);
+
+  //! get the states whose rate is an affine function of the state itself, dy/dt = a + b*y where a and b do not depend on y, i.e., the gating variables (dy/dt = (y_inf - y)/tau), the first state (Vm) is excluded
+  std::vector<int> findGatingStates();
+
+private:
+
+  //! parse the constant assignments and all lines of the rhs into syntax trees, call callback(arrayName, variableNo, expression) for every line of the rhs
+  template<typename Callback>
+  void parseRhsLines(Callback callback);
+};
@@ -0,0 +1,298 @@
+#include "cellml/source_code_generator/rhs_interpreter.h"
+
+#include <Python.h>  // has to be the first included header
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <sstream>
+#include "easylogging++.h"
+
+namespace
+{
+
+//! apply a unary function to the top entry of the operand stack, the result is written to the register of that stack entry
+template<typename Function>
+inline void applyUnary(const double **stack, double *registers, int blockSize, int top, int n, Function function)
+{
+  const double *a = stack[top-1];
+  double *result = registers + (top-1)*blockSize;
+
+  for (int i = 0; i < n; i++)
+  {
+    result[i] = function(a[i]);
+  }
+  stack[top-1] = result;
+}
+
+//! apply a binary function to the top two entries of the operand stack or to the top entry and the immediate value of the instruction
+template<typename Function>
+inline void applyBinary(const CellmlRhsInterpreter::Instruction &instruction, const double **stack, double *registers, int blockSize, int &top, int n, Function function)
+{
+  const double value = instruction.value;
+
+  if (instruction.immediate == CellmlRhsInterpreter::rightImmediate)
+  {
+    const double *a = stack[top-1];
+    double *result = registers + (top-1)*blockSize;
+
+    for (int i = 0; i < n; i++)
+    {
+      result[i] = function(a[i], value);
+    }
+    stack[top-1] = result;
+  }
+  else if (instruction.immediate == CellmlRhsInterpreter::leftImmediate)
+  {
+    const double *b = stack[top-1];
+    double *result = registers + (top-1)*blockSize;
+
+    for (int i = 0; i < n; i++)
+    {
+      result[i] = function(value, b[i]);
+    }
+    stack[top-1] = result;
+  }
+  else
+  {
+    // the first operand is either a variable or in the register of its stack entry, the second operand can only be in a different register
+    const double *a = stack[top-2];
+    const double *b = stack[top-1];
+    double *result = registers + (top-2)*blockSize;
+
+    for (int i = 0; i < n; i++)
+    {
+      result[i] = function(a[i], b[i]);
+    }
+    stack[top-2] = result;
+    top--;
+  }
+}
+
+//! compute a^exponent for an integer exponent by repeated squaring
+inline double computePowInteger(double a, int exponent)
+{
+  double result = 1.0;
+  double factor = a;
+  for (int e = std::abs(exponent); e != 0; e >>= 1)
+  {
+    if (e & 1)
+      result *= factor;
+    factor *= factor;
+  }
+  return (exponent < 0? 1.0/result : result);
+}
+
+}  // namespace
+
+void CellmlRhsInterpreter::clear()
+{
+  instructions_.clear();
+  stackSize_ = 0;
+  currentStackSize_ = 0;
+}
+
+void CellmlRhsInterpreter::addInstruction(opcode_t opcode, immediate_t immediate, variable_t variable, int index, double value)
+{
+  Instruction instruction;
+  instruction.opcode = opcode;
+  instruction.immediate = immediate;
+  instruction.variable = variable;
+  instruction.index = index;
+  instruction.value = value;
+  instructions_.push_back(instruction);
+
+  // update the number of entries on the operand stack
+  if (opcode == loadConstant || opcode == loadTime || opcode == loadVariable)
+  {
+    currentStackSize_++;
+  }
+  else if (opcode == store || opcode == select)
+  {
+    currentStackSize_ -= (opcode == store? 1 : 2);
+  }
+  else if (isBinaryOperation(opcode) && immediate == noImmediate)
+  {
+    currentStackSize_--;
+  }
+
+  if (currentStackSize_ < 0)
+  {
+    LOG(FATAL) << "Invalid program for the CellML rhs interpreter, instruction " << instructions_.size()-1 << " needs more operands than available.";
+  }
+  stackSize_ = std::max(stackSize_, currentStackSize_);
+}
+
+void CellmlRhsInterpreter::evaluate(double t, const double *states, double *rates, double *algebraics, const double *parameters, int nInstances) const
+{
+  // registers for the entries of the operand stack, each holds the values of one block of instances.
+  // They are allocated once per thread and only grow, because evaluate is called in the innermost time stepping loop, possibly from several threads at once
+  static thread_local std::vector<double> registers;
+  static thread_local std::vector<const double *> stack;
+  if (registers.size() < (std::size_t)(std::max(1, stackSize_)*blockSize_))
+  {
+    registers.resize(std::max(1, stackSize_)*blockSize_);
+    stack.resize(std::max(1, stackSize_));
+  }
+
+  // the arrays of the variables, in the order of variable_t
+  const double *variables[4] = {states, rates, algebraics, parameters};
+  double *variablesToStore[4] = {nullptr, rates, algebraics, nullptr};
+
+  // loop over blocks of instances
+  for (int blockBegin = 0; blockBegin < nInstances; blockBegin += blockSize_)
+  {
+    const int n = std::min(blockSize_, nInstances - blockBegin);
+    int top = 0;    // number of entries on the operand stack
+
+    for (const Instruction &instruction : instructions_)
+    {
+      switch (instruction.opcode)
+      {
+      case loadConstant:
+      case loadTime:
+        {
+          const double value = (instruction.opcode == loadTime? t : instruction.value);
+          double *result = registers.data() + top*blockSize_;
+          for (int i = 0; i < n; i++)
+          {
+            result[i] = value;
+          }
+          stack[top++] = result;
+        }
+        break;
+
+      case loadVariable:
+        // variables are not copied, the stack entry directly points to the values of the block
+        stack[top++] = variables[instruction.variable] + instruction.index*nInstances + blockBegin;
+        break;
+
+      case store:
+        {
+          const double *a = stack[--top];
+          double *result = variablesToStore[instruction.variable] + instruction.index*nInstances + blockBegin;
+          std::copy(a, a+n, result);
+        }
+        break;
+
+      case select:
+        {
+          const double *condition = stack[top-3];
+          const double *a = stack[top-2];
+          const double *b = stack[top-1];
+          double *result = registers.data() + (top-3)*blockSize_;
+          for (int i = 0; i < n; i++)
+          {
+            result[i] = (condition[i] != 0.0? a[i] : b[i]);
+          }
+          stack[top-3] = result;
+          top -= 2;
+        }
+        break;
+
+      // unary operations
+      case negate:     applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return -a;}); break;
+      case logicalNot: applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return (a == 0.0? 1.0 : 0.0);}); break;
+      case exp:        applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::exp(a);}); break;
+      case log:        applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::log(a);}); break;
+      case log10:      applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::log10(a);}); break;
+      case sqrt:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::sqrt(a);}); break;
+      case fabs:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::fabs(a);}); break;
+      case floor:      applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::floor(a);}); break;
+      case ceil:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::ceil(a);}); break;
+      case sin:        applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::sin(a);}); break;
+      case cos:        applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::cos(a);}); break;
+      case tan:        applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::tan(a);}); break;
+      case asin:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::asin(a);}); break;
+      case acos:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::acos(a);}); break;
+      case atan:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::atan(a);}); break;
+      case sinh:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::sinh(a);}); break;
+      case cosh:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::cosh(a);}); break;
+      case tanh:       applyUnary(stack.data(), registers.data(), blockSize_, top, n, [](double a){return std::tanh(a);}); break;
+      case powInteger:
+        {
+          const int exponent = instruction.index;
+          applyUnary(stack.data(), registers.data(), blockSize_, top, n, [exponent](double a){return computePowInteger(a, exponent);});
+        }
+        break;
+
+      // binary operations
+      case add:          applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return a + b;}); break;
+      case subtract:     applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return a - b;}); break;
+      case multiply:     applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return a * b;}); break;
+      case divide:       applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return a / b;}); break;
+      case pow:          applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return std::pow(a, b);}); break;
+      case atan2:        applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return std::atan2(a, b);}); break;
+      case minimum:      applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return std::min(a, b);}); break;
+      case maximum:      applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return std::max(a, b);}); break;
+      case less:         applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a < b? 1.0 : 0.0);}); break;
+      case lessEqual:    applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a <= b? 1.0 : 0.0);}); break;
+      case greater:      applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a > b? 1.0 : 0.0);}); break;
+      case greaterEqual: applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a >= b? 1.0 : 0.0);}); break;
+      case equal:        applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a == b? 1.0 : 0.0);}); break;
+      case notEqual:     applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a != b? 1.0 : 0.0);}); break;
+      case logicalAnd:   applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a != 0.0 && b != 0.0? 1.0 : 0.0);}); break;
+      case logicalOr:    applyBinary(instruction, stack.data(), registers.data(), blockSize_, top, n, [](double a, double b){return (a != 0.0 || b != 0.0? 1.0 : 0.0);}); break;
+      };
+    }
+  }
+}
+
+int CellmlRhsInterpreter::nInstructions() const
+{
+  return instructions_.size();
+}
+
+bool CellmlRhsInterpreter::isUnaryOperation(opcode_t opcode)
+{
+  return opcode >= negate && opcode <= powInteger;
+}
+
+bool CellmlRhsInterpreter::isBinaryOperation(opcode_t opcode)
+{
+  return opcode >= add && opcode <= logicalOr;
+}
+
+std::string CellmlRhsInterpreter::getString() const
+{
+  static const char *opcodeNames[] = {
+    "loadConstant", "loadTime", "loadVariable", "store",
+    "negate", "logicalNot", "exp", "log", "log10", "sqrt", "fabs", "floor", "ceil",
+    "sin", "cos", "tan", "asin", "acos", "atan", "sinh", "cosh", "tanh", "powInteger",
+    "add", "subtract", "multiply", "divide", "pow", "atan2", "minimum", "maximum",
+    "less", "lessEqual", "greater", "greaterEqual", "equal", "notEqual", "logicalAnd", "logicalOr",
+    "select"
+  };
+  static const char *variableNames[] = {"states", "rates", "algebraics", "parameters"};
+
+  std::stringstream s;
+  s << instructions_.size() << " instructions, stack size " << stackSize_ << ":\n";
+  for (int instructionNo = 0; instructionNo < instructions_.size(); instructionNo++)
+  {
+    const Instruction &instruction = instructions_[instructionNo];
+    s << "  " << instructionNo << ": " << opcodeNames[instruction.opcode];
+
+    if (instruction.opcode == loadVariable || instruction.opcode == store)
+    {
+      s << " " << variableNames[instruction.variable] << "[" << instruction.index << "]";
+    }
+    else if (instruction.opcode == loadConstant)
+    {
+      s << " " << instruction.value;
+    }
+    else if (instruction.opcode == powInteger)
+    {
+      s << " " << instruction.index;
+    }
+    else if (instruction.immediate == leftImmediate)
+    {
+      s << " " << instruction.value << ", <stack>";
+    }
+    else if (instruction.immediate == rightImmediate)
+    {
+      s << " <stack>, " << instruction.value;
+    }
+    s << "\n";
+  }
+  return s.str();
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <vector>
+#include <string>
+
+/** A bytecode interpreter for the right hand side of a CellML model. It is used for the optimizationType "interpreter".
+ *  The program is created by CellmlSourceCodeGeneratorInterpreter from the parsed model source code in well under a second,
+ *  no source file is written and no compiler has to be called.
+ *
+ *  The program runs on a stack machine. Every instruction is executed for a whole block of instances at once,
+ *  such that the cost of the instruction dispatch is amortized over the block and the inner loops can be vectorized by the compiler.
+ *  All variables have the struct-of-array memory layout that is also used by the generated code,
+ *  i.e. the value of variable j of instance i is stored at index j*nInstances + i.
+ */
+class CellmlRhsInterpreter
+{
+public:
+
+  //! the array that a variable refers to
+  enum variable_t {statesArray, ratesArray, algebraicsArray, parametersArray};
+
+  //! operations of the instructions
+  enum opcode_t {
+    loadConstant, loadTime, loadVariable, store,                             // load and store
+    negate, logicalNot, exp, log, log10, sqrt, fabs, floor, ceil,            // unary operations
+    sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, powInteger,
+    add, subtract, multiply, divide, pow, atan2, minimum, maximum,           // binary operations
+    less, lessEqual, greater, greaterEqual, equal, notEqual, logicalAnd, logicalOr,
+    select                                                                   // ternary operator: condition, value if true, value if false
+  };
+
+  //! which operand of a binary operation is given directly in the instruction
+  enum immediate_t {noImmediate, leftImmediate, rightImmediate};
+
+  //! a single instruction of the program
+  struct Instruction
+  {
+    opcode_t opcode;                     //< the operation
+    immediate_t immediate;               //< for binary operations, if one operand is the constant value
+    variable_t variable;                 //< for loadVariable and store, the array of the variable
+    int index;                           //< for loadVariable and store the index of the variable, for powInteger the exponent
+    double value;                        //< for loadConstant and binary operations with immediate operand, the constant value
+  };
+
+  //! remove all instructions
+  void clear();
+
+  //! append an instruction to the program, this also updates the required stack size
+  void addInstruction(opcode_t opcode, immediate_t immediate = noImmediate, variable_t variable = statesArray, int index = 0, double value = 0.0);
+
+  //! evaluate the program for nInstances instances, the arguments are the same as for the generated computeCellMLRightHandSide function
+  void evaluate(double t, const double *states, double *rates, double *algebraics, const double *parameters, int nInstances) const;
+
+  //! get the number of instructions of the program
+  int nInstructions() const;
+
+  //! get a human readable listing of the program, for debugging output
+  std::string getString() const;
+
+  //! return if the opcode is a unary operation
+  static bool isUnaryOperation(opcode_t opcode);
+
+  //! return if the opcode is a binary operation
+  static bool isBinaryOperation(opcode_t opcode);
+
+private:
+
+  std::vector<Instruction> instructions_;    //< the program
+  int stackSize_ = 0;                        //< the maximum number of entries on the operand stack at the same time
+  int currentStackSize_ = 0;                 //< the number of entries on the operand stack after the last instruction, while the program is built
+
+  static const int blockSize_ = 64;          //< number of instances that are computed at once by every instruction
+};
@@ -2,14 +2,14 @@
 
 #include <Python.h>  // has to be the first included header
 
-#include "cellml/source_code_generator/04_generator_gpu.h"
+#include "cellml/source_code_generator/05_generator_interpreter.h"
 
 class CellmlSourceCodeGenerator :
-  public CellmlSourceCodeGeneratorGpu
+  public CellmlSourceCodeGeneratorInterpreter
 {
 public:
   //! constructor
-  using CellmlSourceCodeGeneratorGpu::CellmlSourceCodeGeneratorGpu;
+  using CellmlSourceCodeGeneratorInterpreter::CellmlSourceCodeGeneratorInterpreter;
 
   //! generate the source file according to optimizationType
   //! Possible values are: simd vc openmp
@@ -152,6 +152,14 @@ void PerformanceMeasurement::countNumber(std::string name, int number)
   iter->second += number;
 }
 
+int PerformanceMeasurement::getNumber(std::string name)
+{
+  if (sums_.find(name) == sums_.end())
+    return 0;
+
+  return sums_[name];
+}
+
 void PerformanceMeasurement::getMemoryConsumption(int &pageSize, long long &virtualMemorySize, long long &residentSetSize, long long &dataSize, double &totalUserTime)
 {
   // adapted from https://stackoverflow.com/questions/669438/how-to-get-memory-usage-at-runtime-using-c
@@ -33,6 +33,9 @@ public:
   
   //! compute sum of numbers
   static void countNumber(std::string name, int number);
+
+  //! get the current sum of a number that was counted by countNumber, 0 if there is no such number yet
+  static int getNumber(std::string name);
   
   //! write collected information to a log file
   static void writeLogFile(std::string logFileName = "logs/log");
@@ -569,6 +569,10 @@ DihuContext::~DihuContext()
     Control::PerformanceMeasurement::writeLogFile();
     MappingBetweenMeshes::Manager::writeLogFile();
 
+    // free the node positions that were shared between the ranks of a compute node, this is collective
+    if (meshManager_)
+      meshManager_->freeNodeSharedGeometry();
+
     // After a call to MPI_Finalize we cannot call MPI_Initialize() anymore.
     // This is only a problem when the code is tested with the GoogleTest framework, because then we want to run multiple tests in one executable.
     // In this case, do not finalize MPI, but call MPI_Barrier instead which also syncs the ranks.
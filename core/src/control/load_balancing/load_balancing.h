@@ -3,11 +3,14 @@
 #include "control/load_balancing/load_balancing_base.h"
 #include "operator_splitting/strang.h"
 #include "time_stepping_scheme/heun_adaptive.h"
+#include "control/load_balancing/structured_mesh_repartitioning.h"
 
 namespace Control
 {
 
-/** This is the load balancing class for any time stepping type, it does not perform load balancing.
+/** This is the load balancing class for any time stepping type. It monitors the measured load imbalance between the ranks.
+ *  If the imbalance exceeds the threshold and the nested solver is an ODE time stepping scheme of a finite element method on a structured deformable mesh,
+ *  the mesh is repartitioned by StructuredMeshRepartitioning. For all other nested solvers, the imbalance is only reported.
   */
 template<typename TimeStepping>
 class LoadBalancing:
@@ -15,11 +18,13 @@ class LoadBalancing:
 {
 public:
 
-  //! use constructor of base class
-  using LoadBalancingBase<TimeStepping>::LoadBalancingBase;
+  //! constructor
+  LoadBalancing(DihuContext context);
 
 protected:
-  virtual void rebalance(){};
+
+  //! compute the load imbalance, store it in the log and repartition the mesh of the nested solver if the imbalance is too high
+  virtual void rebalance();
 };
 
 /** This is the partial specialization for strang splitting, for which load balancing is implemented.
@@ -42,13 +47,13 @@ protected:
   //! check if the degrees of freedom should be redistributed among the ranks
   virtual void rebalance();
 
-private:
+  //! compute new split positions of the fiber nodes from the measured cost on the ranks of the fiber, the cost is assumed to be equally distributed among the local nodes of a rank
+  void computeSplitPositionsFromMeasuredCost(std::shared_ptr<Partition::RankSubset> rankSubsetFiber, int nNodesLocalWithoutGhosts, int nNodesGlobal,
+                                             int beginNodeGlobal, std::vector<int> &splitPositions);
 
-  // counter variable to keep track of rebalancing
-  double rebalanceCounter_;
+private:
 
-  // frequency of the rebalancing
-  int rebalanceFrequency_;
+  std::string rebalanceCriterion_;    //< how to determine the new partitioning, "peaks" places the split positions around the detected action potentials, "measuredCost" balances the measured cost
 };
 
 }  // namespace
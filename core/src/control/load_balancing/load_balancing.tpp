@@ -1,6 +1,7 @@
 #include "control/load_balancing/load_balancing.h"
 
 #include "spatial_discretization/finite_element_method/finite_element_method.h"
+#include "partition/balanced_partitioning/balanced_partitioning.h"
 
 #include <omp.h>
 #include <sstream>
@@ -8,19 +9,84 @@
 namespace Control
 {
 
+template<typename TimeStepping>
+LoadBalancing<TimeStepping>::
+LoadBalancing(DihuContext context) :
+  LoadBalancingBase<TimeStepping>(context)
+{
+  if (this->costDurationLogKey_ == "")
+  {
+    LOG(ERROR) << this->specificSettings_ << "[\"costDurationLogKey\"] is not set, therefore the load imbalance cannot be measured and no rebalancing is done. "
+      << "Set it to the \"durationLogKey\" of a nested solver that only computes.";
+  }
+}
+
+template<typename TimeStepping>
+void LoadBalancing<TimeStepping>::
+rebalance()
+{
+  if (!this->isRebalancingDue(this->currentTime_))
+    return;
+
+  // without a cost measurement, the imbalance is unknown
+  if (this->costDurationLogKey_ == "")
+    return;
+
+  // compute the imbalance of the measured cost over all ranks, all ranks get the same value, therefore the decision is consistent
+  std::shared_ptr<Partition::RankSubset> rankSubset = this->context_.partitionManager()->rankSubsetForCollectiveOperations();
+  double loadImbalance = this->computeLoadImbalance(rankSubset);
+
+  Control::PerformanceMeasurement::setParameter("loadImbalance", loadImbalance);
+
+  if (loadImbalance <= this->imbalanceThreshold_)
+  {
+    LOG(DEBUG) << "Load imbalance " << loadImbalance << " is below imbalanceThreshold " << this->imbalanceThreshold_ << ", no rebalancing";
+    this->resetMeasuredCost();
+    return;
+  }
+
+  if (!StructuredMeshRepartitioning<TimeStepping>::isSupported())
+  {
+    LOG(INFO) << "LoadBalancing: load imbalance " << loadImbalance << " exceeds imbalanceThreshold " << this->imbalanceThreshold_
+      << ", but the nested solver does not support redistribution of its degrees of freedom.";
+    this->resetMeasuredCost();
+    return;
+  }
+
+  LOG(INFO) << "LoadBalancing: load imbalance " << loadImbalance << " exceeds imbalanceThreshold " << this->imbalanceThreshold_
+    << ", repartition the mesh.";
+
+  // the new mesh gets the name of the old mesh with the suffix "_<rebalanceCounter_>"
+  std::stringstream meshNameSuffix;
+  meshNameSuffix << "_" << this->rebalanceCounter_;
+
+  StructuredMeshRepartitioning<TimeStepping>::repartition(this->context_, this->timeSteppingScheme_, this->durationSinceLastRebalancing_, meshNameSuffix.str());
+
+  // restart the cost measurement for the new partitioning
+  this->resetMeasuredCost();
+}
+
 template<typename CellMLAdapter, typename DiffusionTimeStepping>
 LoadBalancing<OperatorSplitting::Strang<TimeSteppingScheme::HeunAdaptive<CellMLAdapter>,DiffusionTimeStepping>>::
 LoadBalancing(DihuContext context) :
   LoadBalancingBase<OperatorSplitting::Strang<TimeSteppingScheme::HeunAdaptive<CellMLAdapter>,DiffusionTimeStepping>>(context)
 {
-  // get python config
-  this->specificSettings_ = this->context_.getPythonConfig();
+  // get criterion for the new partitioning, the rebalancing frequency in ms of simulation time is parsed in the base class
+  rebalanceCriterion_ = this->specificSettings_.getOptionString("rebalanceCriterion", "peaks");
 
-  // set rebalance counter. 0 triggers rebalancing at beginning of simulation
-  this->rebalanceCounter_ = 0;
+  if (rebalanceCriterion_ != "peaks" && rebalanceCriterion_ != "measuredCost")
+  {
+    LOG(ERROR) << this->specificSettings_ << "[\"rebalanceCriterion\"] is \"" << rebalanceCriterion_
+      << "\", but has to be \"peaks\" or \"measuredCost\". Using \"peaks\".";
+    rebalanceCriterion_ = "peaks";
+  }
 
-  // set rebalancing frequency. In ms of simulation time
-  this->rebalanceFrequency_ = 1;
+  if (rebalanceCriterion_ == "measuredCost" && this->costDurationLogKey_ == "")
+  {
+    LOG(ERROR) << this->specificSettings_ << "[\"rebalanceCriterion\"] is \"measuredCost\", but no \"costDurationLogKey\" is given. "
+      << "Set it to the \"durationLogKey\" of a nested solver that only computes. Using \"peaks\".";
+    rebalanceCriterion_ = "peaks";
+  }
 }
 
 template<typename CellMLAdapter, typename DiffusionTimeStepping>
@@ -51,17 +117,23 @@ rebalance()
   LOG(DEBUG) << "rankSubsetFiber: " << *rankSubsetFiber;
 
   // check if rebalancing is required. Depends on simulation progress
-  if (this->rebalanceCounter_ >= timeSteppingHeun.currentHeunTime())
+  if (!this->isRebalancingDue(timeSteppingHeun.currentHeunTime()))
   {
     // no rebalancing needed, return
     return;
   }
-  else
+
+  // compute the imbalance of the measured cost, all ranks get the same value, therefore the decision is consistent
+  double loadImbalance = this->computeLoadImbalance(rankSubsetGlobal);
+  Control::PerformanceMeasurement::setParameter("loadImbalance", loadImbalance);
+
+  if (rebalanceCriterion_ == "measuredCost" && loadImbalance <= this->imbalanceThreshold_)
   {
-    // defined frequency passed, rebalance. Raise counter for further rebalancing
-    this->rebalanceCounter_ = this->rebalanceCounter_ + rebalanceFrequency_;
-    LOG(DEBUG) << "Starting rebalancing process";
+    LOG(DEBUG) << "Load imbalance " << loadImbalance << " is below imbalanceThreshold " << this->imbalanceThreshold_ << ", no rebalancing";
+    this->resetMeasuredCost();
+    return;
   }
+  LOG(DEBUG) << "Starting rebalancing process, load imbalance: " << loadImbalance;
 
   // number of elements and elements in current progress and whole fibre
   int nNodesLocalWithoutGhosts = finiteElementMethod.functionSpace()->meshPartition()->nNodesLocalWithoutGhosts();
@@ -264,7 +336,7 @@ rebalance()
   std::vector<int> split_positions_fibre;
 
   // only collecting process of each fibre computes
-  if (rankSubsetFiber->ownRankNo() == 0)
+  if (rankSubsetFiber->ownRankNo() == 0 && rebalanceCriterion_ == "peaks")
   {
 
     // add regularly distributed split points to the vector
@@ -278,9 +350,9 @@ rebalance()
     {
       if (static_cast<int>(*it) < (nNodesGlobal/2))
       {
-        if (static_cast<int>(*it) - ((25/this->rebalanceFrequency_) - 5) > 0)
+        if (static_cast<int>(*it) - ((static_cast<int>(25/this->rebalanceFrequency_)) - 5) > 0)
         {
-          split_positions_fibre.push_back(static_cast<int>(*it) - (25/this->rebalanceFrequency_) - 5);
+          split_positions_fibre.push_back(static_cast<int>(*it) - (static_cast<int>(25/this->rebalanceFrequency_)) - 5);
         }
         if (static_cast<int>(*it) + 5 < nNodesGlobal)
         {
@@ -293,9 +365,9 @@ rebalance()
         {
           split_positions_fibre.push_back(static_cast<int>(*it) - 5);
         }
-        if (static_cast<int>(*it) + ((25/this->rebalanceFrequency_) + 8) < nNodesGlobal)
+        if (static_cast<int>(*it) + ((static_cast<int>(25/this->rebalanceFrequency_)) + 8) < nNodesGlobal)
         {
-          split_positions_fibre.push_back(static_cast<int>(*it) + (25/this->rebalanceFrequency_) + 8);
+          split_positions_fibre.push_back(static_cast<int>(*it) + (static_cast<int>(25/this->rebalanceFrequency_)) + 8);
         }
       }
     }
@@ -317,7 +389,7 @@ rebalance()
   split_positions_fibre_final.resize(rankSubsetFiber->size() - 1);
 
   // only collecting process of each fibre computes
-  if (rankSubsetFiber->ownRankNo() == 0)
+  if (rankSubsetFiber->ownRankNo() == 0 && rebalanceCriterion_ == "peaks")
   {
     // vector for the permutation containing 0's and 1's
     std::vector<int> split_positions_fibre_to_test(split_positions_fibre.size(),0);
@@ -476,6 +548,13 @@ rebalance()
     LOG(DEBUG) << "Best split point set calculated to " << split_positions_fibre_final;
   }
 
+  // alternatively balance the measured cost of the ranks of the fiber
+  if (rebalanceCriterion_ == "measuredCost")
+  {
+    int beginNodeGlobal = finiteElementMethod.functionSpace()->meshPartition()->beginNodeGlobalNatural(0,-1);
+    computeSplitPositionsFromMeasuredCost(rankSubsetFiber, nNodesLocalWithoutGhosts, nNodesGlobal, beginNodeGlobal, split_positions_fibre_final);
+  }
+
   // broadcast result to all processes of the fiber
   MPI_Bcast(split_positions_fibre_final.data(), rankSubsetFiber->size() - 1, MPI_INT, 0, rankSubsetFiber->mpiCommunicator());
 
@@ -917,7 +996,46 @@ rebalance()
   LOG(DEBUG) << "set " << diffusionValuesNew.size() << " values for " << timeSteppingDiffusion.data().solution()->functionSpace()->nDofsLocalWithoutGhosts() << " dofs";
   timeSteppingDiffusion.data().solution()->setValuesWithoutGhosts(diffusionValuesNew);
 
+  // restart the cost measurement for the new partitioning
+  this->resetMeasuredCost();
+
   LOG(DEBUG) << "Reached End of Rebalancing";
 }
 
+template<typename CellMLAdapter, typename DiffusionTimeStepping>
+void LoadBalancing<OperatorSplitting::Strang<TimeSteppingScheme::HeunAdaptive<CellMLAdapter>,DiffusionTimeStepping>>::
+computeSplitPositionsFromMeasuredCost(std::shared_ptr<Partition::RankSubset> rankSubsetFiber, int nNodesLocalWithoutGhosts, int nNodesGlobal,
+                                      int beginNodeGlobal, std::vector<int> &splitPositions)
+{
+  // gather the local node range and the measured cost of all ranks of the fiber
+  std::array<double,3> localInformation = {(double)beginNodeGlobal, (double)nNodesLocalWithoutGhosts, this->durationSinceLastRebalancing_};
+  std::vector<double> gatheredInformation(3*rankSubsetFiber->size());
+
+  MPIUtility::handleReturnValue(MPI_Gather(localInformation.data(), 3, MPI_DOUBLE, gatheredInformation.data(), 3, MPI_DOUBLE,
+                                           0, rankSubsetFiber->mpiCommunicator()), "MPI_Gather");
+
+  // only collecting process of each fibre computes
+  if (rankSubsetFiber->ownRankNo() != 0)
+    return;
+
+  // distribute the cost of every rank equally among its nodes
+  std::vector<double> costs(nNodesGlobal, 0.0);
+  for (int rankNo = 0; rankNo < rankSubsetFiber->size(); rankNo++)
+  {
+    int beginNode = (int)gatheredInformation[3*rankNo + 0];
+    int nNodes = (int)gatheredInformation[3*rankNo + 1];
+    double cost = gatheredInformation[3*rankNo + 2];
+
+    for (int nodeNo = beginNode; nodeNo < beginNode + nNodes && nodeNo < nNodesGlobal; nodeNo++)
+    {
+      costs[nodeNo] = cost / nNodes;
+    }
+  }
+
+  // every rank needs at least one element, the last rank has one more node than elements
+  Partition::BalancedPartitioning::computeSplitPositions(costs, rankSubsetFiber->size(), splitPositions, 2);
+
+  LOG(DEBUG) << "Split positions from measured cost: " << splitPositions;
+}
+
 } // namespace
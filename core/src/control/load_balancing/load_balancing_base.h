@@ -10,11 +10,15 @@
 #include "control/dihu_context.h"
 #include "control/python_config/python_config.h"
 #include "time_stepping_scheme/00_time_stepping_scheme.h"
+#include "partition/rank_subset.h"
 
 namespace Control
 {
 
 /** This class implements the time stepping, after each time step rebalance() is called, which can do load balancing.
+ *  The cost of the nested time stepping is measured on every rank and accumulated until the next rebalancing, this is the basis
+ *  for the decision whether and how to rebalance. The cost is the duration of the PerformanceMeasurement with the key "costDurationLogKey",
+ *  which should be a pure computation without communication. Without this key, no cost is measured.
  *  The actual implementation of the rebalancing has to be done in a derived class.
   */
 template<typename TimeStepping>
@@ -58,7 +62,24 @@ protected:
   //! check if the degrees of freedom should be redistributed among the ranks
   virtual void rebalance() = 0;
 
+  //! check if the next rebalancing is due according to rebalanceFrequency_, if so, advance rebalanceCounter_
+  bool isRebalancingDue(double currentTime);
+
+  //! compute the ratio of the maximum and the mean of durationSinceLastRebalancing_ over the ranks in rankSubset, this is a collective operation
+  double computeLoadImbalance(std::shared_ptr<Partition::RankSubset> rankSubset);
+
+  //! restart the cost measurement, to be called after the rebalancing
+  void resetMeasuredCost();
+
   TimeStepping timeSteppingScheme_;   //< the underlying timestepping method that is controlled by this class, e.g. Heun
+
+  double rebalanceCounter_;           //< simulation time when the next rebalancing is due, 0 triggers rebalancing at the beginning of the simulation
+  double rebalanceFrequency_;         //< interval of simulation time between two rebalancings, option "rebalanceFrequency"
+  double imbalanceThreshold_;         //< ratio of maximum to mean measured load above which the workload gets redistributed, option "imbalanceThreshold"
+  std::string costDurationLogKey_;    //< key of the PerformanceMeasurement whose duration is used as cost, empty if no cost is measured
+  double costDurationAtLastRebalancing_;  //< value of the PerformanceMeasurement duration with key costDurationLogKey_ at the last rebalancing
+  double durationSinceLastRebalancing_;  //< measured cost in s on this rank since the last rebalancing
+  double currentTime_;                //< simulation time at the end of the last time step
 };
 
 }  // namespace
@@ -3,6 +3,9 @@
 #include <omp.h>
 #include <sstream>
 
+#include "utility/mpi_utility.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
 namespace Control
 {
 
@@ -10,8 +13,15 @@ template<typename TimeStepping>
 LoadBalancingBase<TimeStepping>::
 LoadBalancingBase(DihuContext context) :
   Runnable(), ::TimeSteppingScheme::TimeSteppingScheme(context["LoadBalancing"]),
-  timeSteppingScheme_(this->context_)
+  timeSteppingScheme_(this->context_), rebalanceCounter_(0), costDurationAtLastRebalancing_(0), durationSinceLastRebalancing_(0), currentTime_(0)
 {
+  // get python config
+  this->specificSettings_ = this->context_.getPythonConfig();
+
+  // parse options for the rebalancing
+  rebalanceFrequency_ = this->specificSettings_.getOptionDouble("rebalanceFrequency", 1.0, PythonUtility::Positive);
+  imbalanceThreshold_ = this->specificSettings_.getOptionDouble("imbalanceThreshold", 1.1, PythonUtility::Positive);
+  costDurationLogKey_ = this->specificSettings_.getOptionString("costDurationLogKey", "");
 }
 
 template<typename TimeStepping>
@@ -45,6 +55,12 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     // advance the simulation by the specified time span
     timeSteppingScheme_.advanceTimeSpan(withOutputWritersEnabled);
 
+    // update the cost for the load balancing, the wall time of the nested time stepping is not used because it includes the time spent waiting in MPI calls
+    if (costDurationLogKey_ != "")
+      durationSinceLastRebalancing_ = Control::PerformanceMeasurement::getDuration(costDurationLogKey_) - costDurationAtLastRebalancing_;
+
+    currentTime_ = currentTime + this->timeStepWidth_;
+
     // check if the dofs can be rebalanced
     rebalance();
   }
@@ -54,6 +70,43 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     Control::PerformanceMeasurement::stop(this->durationLogKey_);
 }
 
+template<typename TimeStepping>
+bool LoadBalancingBase<TimeStepping>::
+isRebalancingDue(double currentTime)
+{
+  if (rebalanceCounter_ >= currentTime)
+    return false;
+
+  // defined frequency passed, raise counter for further rebalancing
+  rebalanceCounter_ += rebalanceFrequency_;
+  return true;
+}
+
+template<typename TimeStepping>
+double LoadBalancingBase<TimeStepping>::
+computeLoadImbalance(std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  double maximumDuration = 0;
+  double totalDuration = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&durationSinceLastRebalancing_, &maximumDuration, 1, MPI_DOUBLE, MPI_MAX, rankSubset->mpiCommunicator()), "MPI_Allreduce");
+  MPIUtility::handleReturnValue(MPI_Allreduce(&durationSinceLastRebalancing_, &totalDuration, 1, MPI_DOUBLE, MPI_SUM, rankSubset->mpiCommunicator()), "MPI_Allreduce");
+
+  double meanDuration = totalDuration / rankSubset->size();
+  if (meanDuration <= 0)
+    return 1.0;
+
+  return maximumDuration / meanDuration;
+}
+
+template<typename TimeStepping>
+void LoadBalancingBase<TimeStepping>::
+resetMeasuredCost()
+{
+  durationSinceLastRebalancing_ = 0;
+  if (costDurationLogKey_ != "")
+    costDurationAtLastRebalancing_ = Control::PerformanceMeasurement::getDuration(costDurationLogKey_);
+}
+
 template<typename TimeStepping>
 void LoadBalancingBase<TimeStepping>::
 initialize()
@@ -62,6 +115,9 @@ initialize()
 
   TimeSteppingScheme::TimeSteppingScheme::initialize();
   timeSteppingScheme_.initialize();
+
+  // start the cost measurement, durations of previous runs with the same key are not counted
+  resetMeasuredCost();
 }
 
 template<typename TimeStepping>
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <type_traits>
+
+#include "control/types.h"
+#include "control/dihu_context.h"
+#include "spatial_discretization/finite_element_method/finite_element_method.h"
+
+namespace Control
+{
+
+/** Type trait that is true for finite element methods of time dependent equations with Lagrange basis functions on a structured deformable mesh.
+ *  The meshes of these discretizations can be repartitioned by StructuredMeshRepartitioning.
+ */
+template<typename DiscretizableInTime>
+struct isRepartitionableFiniteElementMethod : std::false_type {};
+
+template<int D, int order, typename QuadratureType, typename Term>
+struct isRepartitionableFiniteElementMethod<
+  SpatialDiscretization::FiniteElementMethod<Mesh::StructuredDeformableOfDimension<D>,BasisFunction::LagrangeOfOrder<order>,QuadratureType,Term>
+> : std::integral_constant<bool, Term::usesTimeStepping> {};
+
+/** Repartitioning of the mesh of a nested time stepping scheme, such that the measured cost is balanced among the ranks.
+ *  This general template is used for all nested solvers that cannot be repartitioned, it does nothing.
+ */
+template<typename TimeStepping, typename = void>
+class StructuredMeshRepartitioning
+{
+public:
+
+  //! the mesh of the nested solver cannot be repartitioned
+  static constexpr bool isSupported() { return false; }
+
+  //! do nothing
+  static void repartition(DihuContext context, TimeStepping &timeStepping, double cost, std::string meshNameSuffix) {}
+};
+
+/** Partial specialization for ODE time stepping schemes, e.g. ImplicitEuler, of a finite element method on a structured deformable mesh.
+ *  The elements in every coordinate direction are redistributed among the partitions of this direction, such that the measured cost is balanced,
+ *  where the cost of every rank is assumed to be equally distributed among its local elements. The number of ranks per coordinate direction is kept.
+ *  The node positions and the values of the solution are sent to the new owners. Then the finite element method and the time stepping scheme
+ *  are recreated on the new partitioning, this rebuilds the PETSc Vecs, the system matrices and the linear solver.
+ */
+template<typename TimeStepping>
+class StructuredMeshRepartitioning<
+  TimeStepping,
+  std::enable_if_t<isRepartitionableFiniteElementMethod<typename TimeStepping::DiscretizableInTime>::value>
+>
+{
+public:
+
+  typedef typename TimeStepping::DiscretizableInTime FiniteElementMethodType;
+  typedef typename FiniteElementMethodType::FunctionSpace FunctionSpaceType;
+
+  //! the mesh of the nested solver can be repartitioned
+  static constexpr bool isSupported() { return true; }
+
+  //! repartition the mesh of the time stepping scheme according to the cost of the own rank and migrate the solution,
+  //! the new mesh is named like the old mesh with meshNameSuffix appended, this is a collective operation over the ranks of the mesh
+  static void repartition(DihuContext context, TimeStepping &timeStepping, double cost, std::string meshNameSuffix);
+
+protected:
+
+  //! compute the new number of elements of every partition in the given coordinate direction, from the costs of all ranks of the mesh
+  static void computeNewLocalSizes(std::shared_ptr<Partition::MeshPartition<FunctionSpaceType>> meshPartition, const std::vector<double> &costs,
+                                   int coordinateDirection, std::vector<element_no_t> &localSizesNew);
+};
+
+}  // namespace
+
+#include "control/load_balancing/structured_mesh_repartitioning.tpp"
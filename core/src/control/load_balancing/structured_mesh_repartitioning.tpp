@@ -0,0 +1,252 @@
+#include "control/load_balancing/structured_mesh_repartitioning.h"
+
+#include <algorithm>
+
+#include "utility/mpi_utility.h"
+#include "utility/vector_operators.h"
+#include "function_space/00_function_space_base_dim.h"
+#include "partition/balanced_partitioning/balanced_partitioning.h"
+#include "mesh/mesh_manager/mesh_manager.h"
+
+namespace Control
+{
+
+template<typename TimeStepping>
+void StructuredMeshRepartitioning<TimeStepping,std::enable_if_t<isRepartitionableFiniteElementMethod<typename TimeStepping::DiscretizableInTime>::value>>::
+repartition(DihuContext context, TimeStepping &timeStepping, double cost, std::string meshNameSuffix)
+{
+  const int D = FunctionSpaceType::dim();
+
+  FiniteElementMethodType &finiteElementMethod = timeStepping.discretizableInTime();
+  std::shared_ptr<FunctionSpaceType> functionSpace = finiteElementMethod.functionSpace();
+  std::shared_ptr<Partition::MeshPartition<FunctionSpaceType>> meshPartition = functionSpace->meshPartition();
+  std::shared_ptr<Partition::RankSubset> rankSubset = meshPartition->rankSubset();
+
+  // ranks that do not own a part of the mesh have nothing to do
+  if (!rankSubset->ownRankIsContained())
+    return;
+
+  // gather the measured cost of all ranks of the mesh
+  std::vector<double> costs(rankSubset->size());
+  MPIUtility::handleReturnValue(MPI_Allgather(&cost, 1, MPI_DOUBLE, costs.data(), 1, MPI_DOUBLE, rankSubset->mpiCommunicator()), "MPI_Allgather");
+
+  // compute the new number of elements of every partition in every coordinate direction, all ranks compute the same values
+  std::array<std::vector<element_no_t>,D> localSizesNew;
+  std::array<element_no_t,D> nElementsPerDimensionLocal;
+  std::array<int,D> nRanks;
+  bool partitioningChanged = false;
+
+  for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+  {
+    computeNewLocalSizes(meshPartition, costs, coordinateDirection, localSizesNew[coordinateDirection]);
+
+    nRanks[coordinateDirection] = meshPartition->nRanks(coordinateDirection);
+    nElementsPerDimensionLocal[coordinateDirection] = localSizesNew[coordinateDirection][meshPartition->ownRankPartitioningIndex(coordinateDirection)];
+
+    if (localSizesNew[coordinateDirection] != meshPartition->localSizesOnRanks(coordinateDirection))
+      partitioningChanged = true;
+  }
+
+  if (!partitioningChanged)
+  {
+    LOG(DEBUG) << "Repartitioning of mesh \"" << functionSpace->meshName() << "\" gives the same partitioning, keep the mesh.";
+    return;
+  }
+
+  // compute the first node of every new partition in every coordinate direction, a partition owns the nodes up to the first node of the next partition
+  const int nNodesPerElement1D = ::FunctionSpace::FunctionSpaceBaseDim<1,typename FunctionSpaceType::BasisFunction>::averageNNodesPerElement();
+  std::array<std::vector<global_no_t>,D> beginNodeNew;
+
+  for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+  {
+    beginNodeNew[coordinateDirection].resize(nRanks[coordinateDirection], 0);
+    for (int partitionIndex = 1; partitionIndex < nRanks[coordinateDirection]; partitionIndex++)
+    {
+      beginNodeNew[coordinateDirection][partitionIndex] = beginNodeNew[coordinateDirection][partitionIndex-1]
+        + localSizesNew[coordinateDirection][partitionIndex-1] * nNodesPerElement1D;
+    }
+  }
+
+  // get the local values of the geometry and the solution
+  std::vector<Vec3> geometryValues;
+  functionSpace->geometryField().getValuesWithoutGhosts(geometryValues);
+
+  std::vector<double> solutionValues;
+  timeStepping.data().solution()->getValuesWithoutGhosts(solutionValues);
+
+  // for every local node, send the global coordinates, the node position and the solution value to the rank that owns the node in the new partitioning
+  const int nValuesPerNode = D + 3 + 1;
+  std::vector<std::vector<double>> sendBuffers(rankSubset->size());
+
+  node_no_t nNodesLocalWithoutGhosts = meshPartition->nNodesLocalWithoutGhosts();
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocalWithoutGhosts; nodeNoLocal++)
+  {
+    std::array<global_no_t,D> coordinatesGlobal = meshPartition->getCoordinatesGlobal(nodeNoLocal);
+
+    // the rank with partitioning index (i,j,k) has the rank no i + nRanks[0]*(j + nRanks[1]*k) in the rank subset of the mesh
+    int rankNo = 0;
+    for (int coordinateDirection = D-1; coordinateDirection >= 0; coordinateDirection--)
+    {
+      const std::vector<global_no_t> &beginNodes = beginNodeNew[coordinateDirection];
+      int partitionIndex = std::upper_bound(beginNodes.begin(), beginNodes.end(), coordinatesGlobal[coordinateDirection]) - beginNodes.begin() - 1;
+      rankNo = rankNo*nRanks[coordinateDirection] + partitionIndex;
+    }
+
+    std::vector<double> &sendBuffer = sendBuffers[rankNo];
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+    {
+      sendBuffer.push_back((double)coordinatesGlobal[coordinateDirection]);
+    }
+    sendBuffer.insert(sendBuffer.end(), geometryValues[nodeNoLocal].begin(), geometryValues[nodeNoLocal].end());
+    sendBuffer.push_back(solutionValues[nodeNoLocal]);
+  }
+
+  // exchange the sizes of the messages
+  std::vector<int> sendCounts(rankSubset->size());
+  std::vector<int> sendDisplacements(rankSubset->size(), 0);
+  std::vector<double> sendBuffer;
+  for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
+  {
+    sendCounts[rankNo] = sendBuffers[rankNo].size();
+    sendDisplacements[rankNo] = sendBuffer.size();
+    sendBuffer.insert(sendBuffer.end(), sendBuffers[rankNo].begin(), sendBuffers[rankNo].end());
+  }
+
+  std::vector<int> receiveCounts(rankSubset->size());
+  MPIUtility::handleReturnValue(MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT,
+                                             rankSubset->mpiCommunicator()), "MPI_Alltoall");
+
+  std::vector<int> receiveDisplacements(rankSubset->size(), 0);
+  for (int rankNo = 1; rankNo < rankSubset->size(); rankNo++)
+  {
+    receiveDisplacements[rankNo] = receiveDisplacements[rankNo-1] + receiveCounts[rankNo-1];
+  }
+
+  // exchange the values
+  std::vector<double> receiveBuffer(receiveDisplacements.back() + receiveCounts.back());
+  MPIUtility::handleReturnValue(MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+                                              receiveBuffer.data(), receiveCounts.data(), receiveDisplacements.data(), MPI_DOUBLE,
+                                              rankSubset->mpiCommunicator()), "MPI_Alltoallv");
+
+  // create the new mesh partition with the same ranks
+  context.partitionManager()->setRankSubsetForNextCreatedPartitioning(rankSubset);
+
+  std::array<global_no_t,D> nElementsPerDimensionGlobal;
+  std::vector<int> rankNos;
+  std::shared_ptr<Partition::MeshPartition<FunctionSpaceType>> meshPartitionNew
+    = context.partitionManager()->template createPartitioningStructuredLocal<FunctionSpaceType>(
+        context.getPythonConfig(), nElementsPerDimensionGlobal, nElementsPerDimensionLocal, nRanks, rankNos);
+
+  for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+  {
+    if (nElementsPerDimensionGlobal[coordinateDirection] != meshPartition->nElementsGlobal(coordinateDirection))
+    {
+      LOG(FATAL) << "Number of global elements in coordinate direction " << coordinateDirection << " changed during repartitioning: old: "
+        << meshPartition->nElementsGlobal(coordinateDirection) << ", new: " << nElementsPerDimensionGlobal[coordinateDirection];
+    }
+  }
+
+  // store the received node positions and solution values at the new local node nos
+  node_no_t nNodesLocalWithoutGhostsNew = meshPartitionNew->nNodesLocalWithoutGhosts();
+  std::vector<Vec3> nodePositionsWithoutGhosts(nNodesLocalWithoutGhostsNew);
+  std::vector<double> solutionValuesNew(nNodesLocalWithoutGhostsNew);
+
+  if (receiveBuffer.size() != (std::size_t)nNodesLocalWithoutGhostsNew*nValuesPerNode)
+  {
+    LOG(FATAL) << "Repartitioning of mesh \"" << functionSpace->meshName() << "\": received " << receiveBuffer.size()/nValuesPerNode
+      << " nodes, but the new partition has " << nNodesLocalWithoutGhostsNew << " nodes.";
+  }
+
+  for (std::size_t index = 0; index < receiveBuffer.size(); index += nValuesPerNode)
+  {
+    std::array<global_no_t,D> coordinatesGlobal;
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+    {
+      coordinatesGlobal[coordinateDirection] = (global_no_t)receiveBuffer[index + coordinateDirection];
+    }
+
+    bool isOnLocalDomain = false;
+    node_no_t nodeNoLocal = meshPartitionNew->getNodeNoLocal(coordinatesGlobal, isOnLocalDomain);
+
+    if (!isOnLocalDomain || nodeNoLocal < 0 || nodeNoLocal >= nNodesLocalWithoutGhostsNew)
+    {
+      LOG(FATAL) << "Repartitioning of mesh \"" << functionSpace->meshName() << "\": received node with global coordinates " << coordinatesGlobal
+        << " that is not owned by the own rank in the new partitioning.";
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+      nodePositionsWithoutGhosts[nodeNoLocal][i] = receiveBuffer[index + D + i];
+    }
+    solutionValuesNew[nodeNoLocal] = receiveBuffer[index + D + 3];
+  }
+
+  LOG(INFO) << "Repartitioning of mesh \"" << functionSpace->meshName() << "\", number of elements: " << meshPartition->nElementsLocal()
+    << " -> " << meshPartitionNew->nElementsLocal() << ", number of nodes: " << nNodesLocalWithoutGhosts << " -> " << nNodesLocalWithoutGhostsNew;
+
+  // create the function space with the new mesh partition
+  std::string meshName = functionSpace->meshName() + meshNameSuffix;
+
+  context.partitionManager()->setRankSubsetForNextCreatedPartitioning(rankSubset);
+
+  std::shared_ptr<FunctionSpaceType> functionSpaceNew = context.meshManager()->template createFunctionSpaceWithGivenMeshPartition<FunctionSpaceType>(
+    meshName, meshPartitionNew, nodePositionsWithoutGhosts, nElementsPerDimensionLocal, nRanks);
+
+  // recreate the finite element method on the new function space
+  finiteElementMethod = std::move(FiniteElementMethodType(timeStepping.data().context(), functionSpaceNew));
+
+  // recreate the data of the time stepping scheme, this assembles the system matrices and creates the PETSc Vecs and the linear solver on the new partitioning
+  timeStepping.reset();
+  timeStepping.initialize();
+
+  // set the migrated solution
+  timeStepping.data().solution()->setValuesWithoutGhosts(solutionValuesNew);
+}
+
+template<typename TimeStepping>
+void StructuredMeshRepartitioning<TimeStepping,std::enable_if_t<isRepartitionableFiniteElementMethod<typename TimeStepping::DiscretizableInTime>::value>>::
+computeNewLocalSizes(std::shared_ptr<Partition::MeshPartition<FunctionSpaceType>> meshPartition, const std::vector<double> &costs,
+                     int coordinateDirection, std::vector<element_no_t> &localSizesNew)
+{
+  const std::vector<element_no_t> &localSizes = meshPartition->localSizesOnRanks(coordinateDirection);
+  const int nPartitions = meshPartition->nRanks(coordinateDirection);
+
+  // compute the first element of every partition in the coordinate direction
+  std::vector<element_no_t> beginElement(nPartitions+1, 0);
+  for (int partitionIndex = 0; partitionIndex < nPartitions; partitionIndex++)
+  {
+    beginElement[partitionIndex+1] = beginElement[partitionIndex] + localSizes[partitionIndex];
+  }
+
+  // compute the cost of every layer of elements orthogonal to the coordinate direction,
+  // every rank contributes the cost divided by its number of elements in the coordinate direction to each of its layers
+  std::vector<double> layerCosts(beginElement[nPartitions], 0.0);
+  for (int rankNo = 0; rankNo < (int)costs.size(); rankNo++)
+  {
+    int partitionIndex = meshPartition->convertRankNoToPartitionIndex(coordinateDirection, rankNo);
+    if (localSizes[partitionIndex] == 0)
+      continue;
+
+    for (element_no_t elementNo = beginElement[partitionIndex]; elementNo < beginElement[partitionIndex+1]; elementNo++)
+    {
+      layerCosts[elementNo] += costs[rankNo] / localSizes[partitionIndex];
+    }
+  }
+
+  // split the layers into contiguous parts of equal cost, every partition keeps at least one element
+  std::vector<int> splitPositions;
+  Partition::BalancedPartitioning::computeSplitPositions(layerCosts, nPartitions, splitPositions, 1);
+
+  localSizesNew.resize(nPartitions);
+  int beginElementNew = 0;
+  for (int partitionIndex = 0; partitionIndex < nPartitions; partitionIndex++)
+  {
+    int endElementNew = (partitionIndex < nPartitions-1? splitPositions[partitionIndex] : (int)layerCosts.size());
+    localSizesNew[partitionIndex] = endElementNew - beginElementNew;
+    beginElementNew = endElementNew;
+  }
+
+  VLOG(1) << "coordinate direction " << coordinateDirection << ", layer costs: " << layerCosts << ", local sizes: " << localSizes << " -> " << localSizesNew;
+}
+
+}  // namespace
@@ -62,6 +62,9 @@ public:
   //! the value of the parameter in the given element
   Vc::double_v value(Vc::int_v elementNoLocal) const;
 
+  //! check if the parameter has the same value in all elements on all ranks of mpiCommunicator, then set value to this value, this is a collective operation
+  bool isConstant(MPI_Comm mpiCommunicator, double &value) const;
+
 };
 
 //! partial specialization for Matrix values
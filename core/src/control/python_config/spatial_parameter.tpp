@@ -1,5 +1,10 @@
 #include "control/python_config/spatial_parameter.h"
 
+#include <limits>
+#include <algorithm>
+
+#include "utility/mpi_utility.h"
+
 //! initialize the spatial parameter from the settings, at the given parameter name "keyString"
 template <typename FunctionSpaceType, typename ValueType>
 void SpatialParameterBase<FunctionSpaceType,ValueType>::
@@ -114,6 +119,28 @@ value(Vc::int_v elementNoLocal) const
   return result;
 }
 
+//! check if the parameter has the same value in all elements on all ranks
+template <typename FunctionSpaceType>
+bool SpatialParameter<FunctionSpaceType,double>::
+isConstant(MPI_Comm mpiCommunicator, double &value) const
+{
+  // determine the range of values that are used in the local elements
+  double minimumValue = std::numeric_limits<double>::max();
+  double maximumValue = std::numeric_limits<double>::lowest();
+  for (int index : this->valueIndices_)
+  {
+    minimumValue = std::min(minimumValue, this->values_[index]);
+    maximumValue = std::max(maximumValue, this->values_[index]);
+  }
+
+  // reduce the range over all ranks, ranks without elements do not contribute
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &minimumValue, 1, MPI_DOUBLE, MPI_MIN, mpiCommunicator), "MPI_Allreduce");
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &maximumValue, 1, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+  value = minimumValue;
+  return minimumValue == maximumValue;
+}
+
 //! the value of the parameter in the given element
 template <typename FunctionSpaceType, int nRows, int nColumns>
 MathUtility::Matrix<nRows,nColumns,Vc::double_v> SpatialParameter<FunctionSpaceType,MathUtility::Matrix<nRows,nColumns>>::
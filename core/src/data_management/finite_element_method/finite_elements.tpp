@@ -12,6 +12,7 @@
 #include "control/dihu_context.h"
 #include "utility/petsc_utility.h"
 #include "function_space/function_space.h"
+#include "mesh/mesh_manager/mesh_manager.h"
 #include "mesh/unstructured_deformable.h"
 #include "basis_function/hermite.h"
 #include "partition/partitioned_petsc_mat/partitioned_petsc_mat.h"
@@ -87,6 +88,9 @@ updateGeometry(double scalingFactor)
   ierr = VecWAXPY(this->functionSpace_->geometryField().valuesGlobal(), scalingFactor, this->solution()->valuesGlobal(), this->referenceGeometry_->valuesGlobal()); CHKERRV(ierr);
   
   this->functionSpace_->geometryField().startGhostManipulation();
+
+  // the shared assembled matrices of the mesh belong to the old geometry
+  DihuContext::meshManager()->invalidateAssembledMatrices(this->functionSpace_->meshName());
   
   if (VLOG_IS_ON(1))
   {
@@ -65,6 +65,12 @@ public:
   //! set the solution variable if it is initialized externally, such as in a timestepping scheme
   void setSolutionVariable(std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> solution);
 
+  //! set if the stiffness matrix is applied matrix-free, then no stiffness matrices are allocated, this has to be called before initialize()
+  void setMatrixFree(bool matrixFree);
+
+  //! get if the stiffness matrix is applied matrix-free and is therefore not available
+  bool matrixFree() const;
+
   //! return reference to the stiffness matrix
   std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix();
 
@@ -76,6 +82,19 @@ public:
 
   //! get the inversed lumped mass matrix
   std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> inverseLumpedMassMatrix();
+
+  //! set the stiffness matrix to an already assembled matrix that is shared read-only with other objects on the same mesh, stiffnessMatrix() and stiffnessMatrixWithoutBc()
+  //! both return this matrix until copySharedStiffnessMatrix() is called. If this is called before initialize(), no stiffness matrices are allocated.
+  void setSharedStiffnessMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix);
+
+  //! get if the stiffness matrix is a shared matrix that was set by setSharedStiffnessMatrix() and must not be modified
+  bool stiffnessMatrixIsShared() const;
+
+  //! if the stiffness matrix is shared, replace it by an own copy that can be modified, e.g. by the Dirichlet boundary conditions (copy-on-write), this is collective
+  void copySharedStiffnessMatrix();
+
+  //! set the mass matrix to an already assembled matrix, which can be shared with other objects on the same mesh, then initializeMassMatrix() has no effect
+  void setMassMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> massMatrix);
   
   //! get maximum number of expected non-zeros in stiffness matrix
   static void getPetscMemoryParameters(int &nNonZerosDiagonal, int &nNonZerosOffdiagonal);
@@ -110,6 +129,7 @@ private:
   std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> solution_;            //< the vector of the quantity of interest, e.g. displacement
 
   std::shared_ptr<SlotConnectorDataType> slotConnectorData_;       //< the object that holds all slot connector components of field variables
+  bool matrixFree_ = false;                                        //< if the stiffness matrix is not assembled because the FiniteElementMethod uses a matrix-free operator
 };
 
 }  // namespace
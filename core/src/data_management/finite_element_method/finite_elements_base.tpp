@@ -120,15 +120,48 @@ createPetscObjects()
   LOG(DEBUG) << "d=" << this->functionSpace_->dimension()
     << ", number of diagonal non-zeros: " << nNonZerosDiagonal << ", number of off-diagonal non-zeros: " <<nNonZerosOffdiagonal;
 
+  // in matrix-free mode, the stiffness matrix is applied by a MatShell and not stored
+  if (matrixFree_)
+  {
+    LOG(DEBUG) << "matrix-free mode, do not create stiffnessMatrix";
+    return;
+  }
+
+  // a stiffness matrix that was already assembled by another object on the same mesh is used, do not allocate and preallocate own matrices
+  if (stiffnessMatrixIsShared())
+  {
+    LOG(DEBUG) << "stiffnessMatrix is shared, do not create stiffnessMatrix";
+    return;
+  }
+
   LOG(DEBUG) << "create new stiffnessMatrix";
   this->stiffnessMatrix_ = std::make_shared<PartitionedPetscMat<FunctionSpaceType>>(meshPartition, nComponents, nNonZerosDiagonal, nNonZerosOffdiagonal, "stiffnessMatrix");
   this->stiffnessMatrixWithoutBc_ = std::make_shared<PartitionedPetscMat<FunctionSpaceType>>(meshPartition, nComponents, nNonZerosDiagonal, nNonZerosOffdiagonal, "stiffnessMatrixWithoutBc");
 }
 
+template<typename FunctionSpaceType, int nComponents>
+void FiniteElementsBase<FunctionSpaceType,nComponents>::
+setMatrixFree(bool matrixFree)
+{
+  matrixFree_ = matrixFree;
+}
+
+template<typename FunctionSpaceType, int nComponents>
+bool FiniteElementsBase<FunctionSpaceType,nComponents>::
+matrixFree() const
+{
+  return matrixFree_;
+}
+
 template<typename FunctionSpaceType, int nComponents>
 std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> FiniteElementsBase<FunctionSpaceType,nComponents>::
 stiffnessMatrix()
 {
+  if (matrixFree_ && !this->stiffnessMatrix_)
+  {
+    LOG(FATAL) << "The stiffness matrix is not available because the FiniteElementMethod uses \"matrixFree\": True. "
+      << "The matrix-free mode can only be used for static problems and explicit time stepping schemes.";
+  }
   return this->stiffnessMatrix_;
 }
 
@@ -153,6 +186,45 @@ inverseLumpedMassMatrix()
   return this->inverseLumpedMassMatrix_;
 }
 
+template<typename FunctionSpaceType, int nComponents>
+void FiniteElementsBase<FunctionSpaceType,nComponents>::
+setSharedStiffnessMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix)
+{
+  // both slots point to the same matrix, the reference count of the shared_ptr gives the number of users
+  this->stiffnessMatrix_ = stiffnessMatrix;
+  this->stiffnessMatrixWithoutBc_ = stiffnessMatrix;
+}
+
+template<typename FunctionSpaceType, int nComponents>
+bool FiniteElementsBase<FunctionSpaceType,nComponents>::
+stiffnessMatrixIsShared() const
+{
+  return this->stiffnessMatrix_ && this->stiffnessMatrix_ == this->stiffnessMatrixWithoutBc_;
+}
+
+template<typename FunctionSpaceType, int nComponents>
+void FiniteElementsBase<FunctionSpaceType,nComponents>::
+copySharedStiffnessMatrix()
+{
+  if (!stiffnessMatrixIsShared())
+    return;
+
+  LOG(DEBUG) << "copy shared stiffness matrix before it is modified";
+
+  // the copy has the same sparsity pattern and values, the shared matrix stays in stiffnessMatrixWithoutBc_
+  Mat stiffnessMatrix;
+  PetscErrorCode ierr = MatDuplicate(this->stiffnessMatrixWithoutBc_->valuesGlobal(), MAT_COPY_VALUES, &stiffnessMatrix); CHKERRV(ierr);
+  this->stiffnessMatrix_ = std::make_shared<PartitionedPetscMat<FunctionSpaceType>>(
+    this->functionSpace_->meshPartition(), stiffnessMatrix, "stiffnessMatrix");
+}
+
+template<typename FunctionSpaceType, int nComponents>
+void FiniteElementsBase<FunctionSpaceType,nComponents>::
+setMassMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> massMatrix)
+{
+  this->massMatrix_ = massMatrix;
+}
+
 template<typename FunctionSpaceType, int nComponents>
 std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> FiniteElementsBase<FunctionSpaceType,nComponents>::
 rightHandSide()
@@ -207,7 +279,8 @@ print()
 
   VLOG(4) << "======================";
   VLOG(4) << "nComponents: " << nComponents;
-  VLOG(4) << *this->stiffnessMatrix_;
+  if (this->stiffnessMatrix_)
+    VLOG(4) << *this->stiffnessMatrix_;
   VLOG(4) << *this->rhs_;
   VLOG(4) << *this->solution_;
 
@@ -219,6 +292,12 @@ print()
 
   VLOG(4) << this->functionSpace_->geometryField();
   
+  if (!this->stiffnessMatrix_)
+  {
+    VLOG(4) << "======================";
+    return;
+  }
+
   MatInfo info;
   MatGetInfo(this->stiffnessMatrix_->valuesGlobal(), MAT_LOCAL, &info);
 
@@ -237,6 +237,9 @@ updateGeometry(double scalingFactor, bool updateLinearVariables)
 
   this->displacementsFunctionSpace_->geometryField().startGhostManipulation();
 
+  // the shared assembled matrices of the mesh belong to the old geometry
+  DihuContext::meshManager()->invalidateAssembledMatrices(this->displacementsFunctionSpace_->meshName());
+
   VLOG(1) << "update done.";
   VLOG(1) << "displacements representation: " << this->displacements_->partitionedPetscVec()->getCurrentRepresentationString();
   VLOG(1) << "geometryReference_ representation: " << this->geometryReference_->partitionedPetscVec()->getCurrentRepresentationString();
@@ -273,6 +276,7 @@ updateGeometry(double scalingFactor, bool updateLinearVariables)
                     1, this->displacementsLinearMesh_->valuesGlobal(), this->geometryReferenceLinearMesh_->valuesGlobal()); CHKERRV(ierr);
 
     this->pressureFunctionSpace_->geometryField().startGhostManipulation();
+    DihuContext::meshManager()->invalidateAssembledMatrices(this->pressureFunctionSpace_->meshName());
   }
 }
 
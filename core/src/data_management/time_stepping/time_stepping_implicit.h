@@ -45,6 +45,15 @@ public:
   //! initialize the integration matrix on the rhs from a PETSc matrix that was already created, in this case by a MatConvert
   void initializeIntegrationMatrixRightHandSide(Mat &integrationMatrix);
 
+  //! set the system matrix to a matrix that was computed earlier, or to nullptr such that initializeSystemMatrix will be called for a new matrix
+  void setSystemMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> systemMatrix);
+
+  //! set the integration matrix on the rhs to a matrix that was computed earlier, or to nullptr such that a new matrix will be created
+  void setIntegrationMatrixRightHandSide(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> integrationMatrixRightHandSide);
+
+  //! set the rhs summand vector of the boundary conditions, it belongs to the system matrix
+  void setBoundaryConditionsRightHandSideSummand(std::shared_ptr<FieldVariableType> boundaryConditionsRightHandSideSummand);
+
   //! initializes a PETSc matrix that is already created, by other PETSc routines like MatConvert or MatMatMult
   void initializeMatrix(Mat &matrixIn, std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> matrixOut, std::string name);
 
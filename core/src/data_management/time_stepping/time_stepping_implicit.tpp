@@ -64,6 +64,27 @@ initializeIntegrationMatrixRightHandSide(Mat &integrationMatrix)
   this->integrationMatrixRightHandSide_ = std::make_shared<PartitionedPetscMat<FunctionSpaceType>>(partition, integrationMatrix, "integrationMatrixRightHandSide");
 }
 
+template<typename FunctionSpaceType,int nComponents>
+void TimeSteppingImplicit<FunctionSpaceType,nComponents>::
+setSystemMatrix(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> systemMatrix)
+{
+  this->systemMatrix_ = systemMatrix;
+}
+
+template<typename FunctionSpaceType,int nComponents>
+void TimeSteppingImplicit<FunctionSpaceType,nComponents>::
+setIntegrationMatrixRightHandSide(std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> integrationMatrixRightHandSide)
+{
+  this->integrationMatrixRightHandSide_ = integrationMatrixRightHandSide;
+}
+
+template<typename FunctionSpaceType,int nComponents>
+void TimeSteppingImplicit<FunctionSpaceType,nComponents>::
+setBoundaryConditionsRightHandSideSummand(std::shared_ptr<FieldVariableType> boundaryConditionsRightHandSideSummand)
+{
+  this->boundaryConditionsRightHandSideSummand_ = boundaryConditionsRightHandSideSummand;
+}
+
 template<typename FunctionSpaceType,int nComponents>
 void TimeSteppingImplicit<FunctionSpaceType,nComponents>::
 initializeMatrix(Mat &matrixIn, std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> matrixOut, std::string name)
@@ -91,6 +91,11 @@ public:
   template<int nComponents2>
   void restoreExtractedComponent(std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,nComponents2>> extractedVec, int componentNo);
 
+  //! let the component componentNo use the same Petsc Vec as the component componentNoFieldVariable of fieldVariable, without copying the data.
+  //! Afterwards, values that are set in one of the field variables are also visible in the other. @return if this was possible
+  template<int nComponents2>
+  bool shareComponent(int componentNo, std::shared_ptr<FieldVariable<FunctionSpaceType,nComponents2>> fieldVariable, int componentNoFieldVariable);
+
   //! set the values for the given component from a petsc Vec
   void setValues(int componentNo, Vec petscVector);
 
@@ -455,6 +455,16 @@ restoreExtractedComponent(std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,
   this->values_->template restoreExtractedComponent<nComponents2>(extractedVec, componentNo);
 }
 
+template<typename FunctionSpaceType, int nComponents>
+template<int nComponents2>
+bool FieldVariableSetGetStructured<FunctionSpaceType,nComponents>::
+shareComponent(int componentNo, std::shared_ptr<FieldVariable<FunctionSpaceType,nComponents2>> fieldVariable, int componentNoFieldVariable)
+{
+  assert(fieldVariable->partitionedPetscVec());
+  assert(this->values_);
+  return this->values_->template shareComponent<nComponents2>(componentNo, *fieldVariable->partitionedPetscVec(), componentNoFieldVariable);
+}
+
 template<typename FunctionSpaceType, int nComponents>
 void FieldVariableSetGetStructured<FunctionSpaceType,nComponents>::
 setValues(int componentNo, Vec petscVector)
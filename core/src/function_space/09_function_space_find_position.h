@@ -3,6 +3,7 @@
 #include <Python.h>  // has to be the first included header
 
 #include "function_space/08_function_space_nodes.h"
+#include "function_space/09_function_space_spatial_index.h"
 #include "function_space/09_function_space_structured_check_neighbouring_elements.h"
 
 namespace FunctionSpace
@@ -39,12 +40,12 @@ public:
  */
 template<int D,typename BasisFunctionType>
 class FunctionSpaceFindPosition<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType,Mesh::UnstructuredDeformableOfDimension<D>> :
-  public FunctionSpaceNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>
+  public FunctionSpaceSpatialIndex<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>
 {
 public:
 
   //! inherit constructor
-  using FunctionSpaceNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::FunctionSpaceNodes;
+  using FunctionSpaceSpatialIndex<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::FunctionSpaceSpatialIndex;
 
   //! get the element no and the xi value of the point, return true if the point is inside the mesh or false otherwise. Start search at given elementNo
   //! ghostMeshNo: -1 means main mesh, 0-5 means ghost Mesh with respecitve Mesh::face_t
@@ -28,6 +28,14 @@ findPosition(Vec3 point, element_no_t &elementNo, int &ghostMeshNo, std::array<d
     return true;
   }
 
+  // if the spatial index has been created, only check the elements whose bounding box contains the point
+  if (this->findPositionInSpatialIndex(point, elementNo, xi, residual, xiTolerance))
+  {
+    searchedAllElements = false;
+    ghostMeshNo = -1;   // not a ghost mesh
+    return true;
+  }
+
   // look in every element, starting at elementNo-2
   element_no_t elementNoStart = (elementNo - 2 + nElements) % nElements;
   element_no_t elementNoEnd = (elementNo - 3 + nElements) % nElements;
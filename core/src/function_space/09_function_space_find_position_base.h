@@ -2,7 +2,7 @@
 
 #include <Python.h>  // has to be the first included header
 
-#include "function_space/08_function_space_nodes.h"
+#include "function_space/09_function_space_spatial_index.h"
 #include "mesh/face_or_edge_t.h"
 
 namespace FunctionSpace
@@ -17,12 +17,12 @@ class FunctionSpace;
  */
 template<typename MeshType,typename BasisFunctionType>
 class FunctionSpaceStructuredFindPositionBase :
-  public FunctionSpaceNodes<MeshType,BasisFunctionType>
+  public FunctionSpaceSpatialIndex<MeshType,BasisFunctionType>
 {
 public:
 
   //! inherit constructor
-  using FunctionSpaceNodes<MeshType,BasisFunctionType>::FunctionSpaceNodes;
+  using FunctionSpaceSpatialIndex<MeshType,BasisFunctionType>::FunctionSpaceSpatialIndex;
 
   //! store a ghost mesh which is a neighouring mesh with only one layer of elements, this will be used by pointIsInElement and findPosition
   void setGhostMesh(Mesh::face_or_edge_t face, const std::shared_ptr<FunctionSpace<MeshType,BasisFunctionType>> ghostMesh);
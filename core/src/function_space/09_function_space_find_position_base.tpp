@@ -180,6 +180,14 @@ findPosition(Vec3 point, element_no_t &elementNoLocal, int &ghostMeshNo, std::ar
     return true;
   }
 
+  // if the spatial index has been created, only check the elements whose bounding box contains the point
+  if (this->findPositionInSpatialIndex(point, elementNoLocal, xi, residual, xiTolerance))
+  {
+    VLOG(1) << "findPosition: found point in element " << elementNoLocal << " using the spatial index, xi=" << xi;
+    ghostMeshNo = -1;   // not a ghost mesh
+    return true;
+  }
+
   // search among all elements
   searchedAllElements = true;
 
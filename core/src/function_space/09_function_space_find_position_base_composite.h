@@ -40,6 +40,13 @@ public:
   //! return the sub mesh no. where the last point was found by findPosition
   int subMeshNoWherePointWasFound();
 
+  //! create or update the spatial indices of all sub meshes, they are used by findPosition of the sub meshes, see FunctionSpaceSpatialIndex
+  //! @return the total number of elements that were (re)inserted in the indices
+  int updateSpatialIndex(double relativeMargin);
+
+  //! get the number of queries to the spatial indices of all sub meshes and the number of those where all elements had to be searched
+  void spatialIndexStatistics(int &nQueries, int &nFallbacks) const;
+
 protected:
   int subMeshNoWherePointWasFound_ = 0;    //< findPositions sets this to the subMeshNo in which the point was found
 };
@@ -63,4 +63,32 @@ findPosition(Vec3 point, element_no_t &elementNoLocal, int &ghostMeshNo, std::ar
   return false;
 }
 
+template<int D,typename BasisFunctionType>
+int FunctionSpaceStructuredFindPositionBase<Mesh::CompositeOfDimension<D>,BasisFunctionType>::
+updateSpatialIndex(double relativeMargin)
+{
+  int nInsertedElements = 0;
+  for (int subMeshNo = 0; subMeshNo < this->subFunctionSpaces_.size(); subMeshNo++)
+  {
+    nInsertedElements += this->subFunctionSpaces_[subMeshNo]->updateSpatialIndex(relativeMargin);
+  }
+  return nInsertedElements;
+}
+
+template<int D,typename BasisFunctionType>
+void FunctionSpaceStructuredFindPositionBase<Mesh::CompositeOfDimension<D>,BasisFunctionType>::
+spatialIndexStatistics(int &nQueries, int &nFallbacks) const
+{
+  nQueries = 0;
+  nFallbacks = 0;
+  for (int subMeshNo = 0; subMeshNo < this->subFunctionSpaces_.size(); subMeshNo++)
+  {
+    int nQueriesSubMesh = 0;
+    int nFallbacksSubMesh = 0;
+    this->subFunctionSpaces_[subMeshNo]->spatialIndexStatistics(nQueriesSubMesh, nFallbacksSubMesh);
+    nQueries += nQueriesSubMesh;
+    nFallbacks += nFallbacksSubMesh;
+  }
+}
+
 } // namespace
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include "function_space/08_function_space_nodes.h"
+#include "mesh/spatial_index/element_grid_index.h"
+
+namespace FunctionSpace
+{
+
+//! forward declaration for field variables
+template<typename MeshType,typename BasisFunctionType>
+class FunctionSpace;
+
+/** Spatial index of the local elements, it is used by findPosition to locate points without iterating over all elements.
+ *  The index is only used after it has been created by updateSpatialIndex(), e.g. by MappingBetweenMeshes.
+ */
+template<typename MeshType,typename BasisFunctionType>
+class FunctionSpaceSpatialIndex :
+  public FunctionSpaceNodes<MeshType,BasisFunctionType>
+{
+public:
+
+  //! inherit constructor
+  using FunctionSpaceNodes<MeshType,BasisFunctionType>::FunctionSpaceNodes;
+
+  //! create the spatial index from the current geometry field or, if it exists, update it incrementally after the geometry has changed,
+  //! relativeMargin is the fraction of the element size by which the bounding boxes of the elements are enlarged, e.g. the xiTolerance
+  //! @return the number of elements that were (re)inserted in the index
+  int updateSpatialIndex(double relativeMargin);
+
+  //! get the number of calls to findPosition that used the spatial index and the number of those where the point was not found in the index and all elements had to be searched
+  void spatialIndexStatistics(int &nQueries, int &nFallbacks) const;
+
+  //! check if the point lies inside the element, if yes, return true and set xi to the value of the point, defined in 11_function_space_xi.h
+  virtual bool pointIsInElement(Vec3 point, element_no_t elementNo, std::array<double,MeshType::dim()> &xi, double &residual, double xiTolerance) = 0;
+
+protected:
+
+  //! find the element that contains the point among the elements whose bounding box contains the point, if there are multiple, use the one where the point is most inside,
+  //! @return false if the spatial index has not been created or no element was found
+  bool findPositionInSpatialIndex(const Vec3 &point, element_no_t &elementNoLocal, std::array<double,MeshType::dim()> &xi, double &residual, double xiTolerance);
+
+  Mesh::ElementGridIndex spatialIndex_;           //< uniform grid of the bounding boxes of the local elements
+  std::vector<element_no_t> candidateElementNos_; //< temporary buffer for the elements returned by the spatial index
+  int nSpatialIndexQueries_ = 0;                  //< number of calls to findPositionInSpatialIndex
+  int nSpatialIndexFallbacks_ = 0;                //< number of calls to findPositionInSpatialIndex where the point was not found
+};
+
+}  // namespace
+
+#include "function_space/09_function_space_spatial_index.tpp"
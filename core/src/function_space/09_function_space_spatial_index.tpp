@@ -0,0 +1,112 @@
+#include "function_space/09_function_space_spatial_index.h"
+
+#include <limits>
+#include <algorithm>
+
+#include "easylogging++.h"
+
+namespace FunctionSpace
+{
+
+template<typename MeshType, typename BasisFunctionType>
+int FunctionSpaceSpatialIndex<MeshType,BasisFunctionType>::
+updateSpatialIndex(double relativeMargin)
+{
+  const element_no_t nElements = this->nElementsLocal();
+  const int nDofsPerElement = FunctionSpace<MeshType,BasisFunctionType>::nDofsPerElement();
+
+  // compute the bounding boxes of all local elements from the node positions
+  std::vector<Mesh::ElementGridIndex::BoundingBox> boundingBoxes(nElements);
+  std::array<Vec3,nDofsPerElement> elementalNodePositions;
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElements; elementNoLocal++)
+  {
+    this->geometryField().getElementValues(elementNoLocal, elementalNodePositions);
+
+    Mesh::ElementGridIndex::BoundingBox &boundingBox = boundingBoxes[elementNoLocal];
+    boundingBox[0] = elementalNodePositions[0];
+    boundingBox[1] = elementalNodePositions[0];
+
+    for (const Vec3 &elementalNodePosition : elementalNodePositions)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        boundingBox[0][i] = std::min(boundingBox[0][i], elementalNodePosition[i]);
+        boundingBox[1][i] = std::max(boundingBox[1][i], elementalNodePosition[i]);
+      }
+    }
+  }
+
+  // create the index, if it does not exist or a larger margin is needed, otherwise only update the elements that moved
+  if (!spatialIndex_.isBuilt() || relativeMargin > spatialIndex_.relativeMargin())
+  {
+    spatialIndex_.build(boundingBoxes, relativeMargin);
+    return nElements;
+  }
+
+  return spatialIndex_.update(boundingBoxes);
+}
+
+template<typename MeshType, typename BasisFunctionType>
+void FunctionSpaceSpatialIndex<MeshType,BasisFunctionType>::
+spatialIndexStatistics(int &nQueries, int &nFallbacks) const
+{
+  nQueries = nSpatialIndexQueries_;
+  nFallbacks = nSpatialIndexFallbacks_;
+}
+
+template<typename MeshType, typename BasisFunctionType>
+bool FunctionSpaceSpatialIndex<MeshType,BasisFunctionType>::
+findPositionInSpatialIndex(const Vec3 &point, element_no_t &elementNoLocal, std::array<double,MeshType::dim()> &xi, double &residual, double xiTolerance)
+{
+  if (!spatialIndex_.isBuilt())
+    return false;
+
+  nSpatialIndexQueries_++;
+  spatialIndex_.getCandidateElements(point, candidateElementNos_);
+
+  VLOG(1) << "findPositionInSpatialIndex(" << point << "), candidate elements: " << candidateElementNos_;
+
+  // variables to store the best found element so far
+  bool elementFound = false;
+  double excessivityScoreBest = std::numeric_limits<double>::max();
+
+  for (element_no_t candidateElementNo : candidateElementNos_)
+  {
+    std::array<double,MeshType::dim()> xiCandidate;
+    double residualCandidate = 0;
+
+    if (this->pointIsInElement(point, candidateElementNo, xiCandidate, residualCandidate, xiTolerance))
+    {
+      // lower means more inside the element, <= 0 equals really totally inside the element, then (0 < xi < 1)
+      double excessivityScore = 0;
+      for (int i = 0; i < MeshType::dim(); i++)
+      {
+        excessivityScore = std::max({excessivityScore, xiCandidate[i] - 1.0, 0.0 - xiCandidate[i]});
+      }
+
+      if (excessivityScore < excessivityScoreBest)
+      {
+        elementFound = true;
+        excessivityScoreBest = excessivityScore;
+        elementNoLocal = candidateElementNo;
+        xi = xiCandidate;
+        residual = residualCandidate;
+      }
+
+      // if the point is really inside the element, do not check the other candidates
+      if (excessivityScore < 1e-12)
+        break;
+    }
+  }
+
+  if (!elementFound)
+  {
+    nSpatialIndexFallbacks_++;
+    VLOG(1) << "findPositionInSpatialIndex: point " << point << " was not found among " << candidateElementNos_.size() << " candidate elements";
+  }
+
+  return elementFound;
+}
+
+} // namespace
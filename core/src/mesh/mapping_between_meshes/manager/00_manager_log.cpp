@@ -81,6 +81,11 @@ std::string ManagerLog::produceLogContents()
         << "-> \"" << logEntry.meshNameTo << "\" (" << logEntry.dimensionalityTo << "D).";
       break;
 
+    case mappingLogEntry_t::logEvent_t::eventUpdateMapping:
+      log << "* Update mapping between meshes \"" << logEntry.meshNameFrom << "\" "
+        << "-> \"" << logEntry.meshNameTo << "\" after change of geometry.";
+      break;
+
     case mappingLogEntry_t::logEvent_t::eventMapForward:
     case mappingLogEntry_t::logEvent_t::eventMapReverse:
       log << "* Map from field variable \"" << logEntry.fieldVariableNameFrom << "\"";
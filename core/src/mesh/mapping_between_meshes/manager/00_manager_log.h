@@ -48,6 +48,7 @@ protected:
     {
       eventParseSettings,                 //< a mapping between "from" and "to" was read from the settings
       eventCreateMapping,                 //< a mapping between "from" and "to" was created
+      eventUpdateMapping,                 //< a mapping between "from" and "to" was updated after the geometry of one of the meshes has changed
       eventMapForward,                    //< mapping was performed between "from" and "to", using the corresponding mapping
       eventMapReverse,                    //< mapping was performed between "from" and "to", using the reverse direction of the reverse mapping
       eventMessage                        //< additional message to be displayed at the current location in the log
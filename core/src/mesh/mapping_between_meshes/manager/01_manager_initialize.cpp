@@ -5,6 +5,8 @@
 #include "mesh/unstructured_deformable.h"
 #include "utility/python_utility.h"
 
+#include <algorithm>
+
 namespace MappingBetweenMeshes
 {
 
@@ -13,6 +15,9 @@ ManagerInitialize::ManagerInitialize(PythonConfig specificSettings) :
 {
   // parse all settings in "MappingsBetweenMeshes" and store them in mappingsBetweenMeshes_
   storeMappingsBetweenMeshes(specificSettings);
+
+  // parse if connected slots on the same mesh can share the Petsc Vec's of their components
+  shareVecsOfConnectedSlots_ = specificSettings.getOptionBool("shareVecsOfConnectedSlots", false);
 }
 
 void ManagerInitialize::storeMappingBetweenMeshes(std::string sourceMeshName, PyObject *targetMeshPy)
@@ -32,6 +37,7 @@ void ManagerInitialize::storeMappingBetweenMeshes(std::string sourceMeshName, Py
       mappingWithSettings.enableWarnings = true;
       mappingWithSettings.compositeUseOnlyInitializedMappings = false;
       mappingWithSettings.isEnabledFixUnmappedDofs = true;
+      mappingWithSettings.useSpatialIndex = true;
       mappingWithSettings.defaultValue = 0.0;
       mappingsBetweenMeshes_[sourceMeshName].insert(std::pair<std::string,MappingWithSettings>(targetMeshToMapTo,mappingWithSettings));
 
@@ -55,6 +61,7 @@ void ManagerInitialize::storeMappingBetweenMeshes(std::string sourceMeshName, Py
     bool compositeUseOnlyInitializedMappings = PythonUtility::getOptionBool(targetMeshPy, "compositeUseOnlyInitializedMappings", stringPath.str(), false);
     bool isEnabledFixUnmappedDofs = PythonUtility::getOptionBool(targetMeshPy, "fixUnmappedDofs", stringPath.str(), true);
     double defaultValue = PythonUtility::getOptionDouble(targetMeshPy, "defaultValue", stringPath.str(), 0.0);
+    bool useSpatialIndex = PythonUtility::getOptionBool(targetMeshPy, "useSpatialIndex", stringPath.str(), true);
 
     VLOG(1) << "Store mapping between mesh \"" << sourceMeshName << "\" and " << targetMeshToMapTo << " with xiTolerance " << xiTolerance;
 
@@ -68,6 +75,7 @@ void ManagerInitialize::storeMappingBetweenMeshes(std::string sourceMeshName, Py
       mappingWithSettings.enableWarnings = enableWarnings;
       mappingWithSettings.compositeUseOnlyInitializedMappings = compositeUseOnlyInitializedMappings;
       mappingWithSettings.isEnabledFixUnmappedDofs = isEnabledFixUnmappedDofs;
+      mappingWithSettings.useSpatialIndex = useSpatialIndex;
       mappingWithSettings.defaultValue = defaultValue;
       mappingsBetweenMeshes_[sourceMeshName].insert(std::pair<std::string,MappingWithSettings>(targetMeshToMapTo,mappingWithSettings));
 
@@ -82,6 +90,38 @@ void ManagerInitialize::storeMappingBetweenMeshes(std::string sourceMeshName, Py
   }
 }
 
+void ManagerInitialize::updateMappingsBetweenMeshes(const std::vector<std::string> &meshNames, std::string excludedMeshName)
+{
+  // loop over all stored mappings
+  for (std::pair<const std::string, std::map<std::string, MappingWithSettings>> &mappingsFromSource : mappingsBetweenMeshes_)
+  {
+    const std::string &sourceMeshName = mappingsFromSource.first;
+
+    for (std::pair<const std::string, MappingWithSettings> &mappingWithSettings : mappingsFromSource.second)
+    {
+      const std::string &targetMeshName = mappingWithSettings.first;
+
+      // only consider mappings that have been created and that involve the mesh
+      if (!mappingWithSettings.second.mapping)
+        continue;
+
+      if (std::find(meshNames.begin(), meshNames.end(), sourceMeshName) == meshNames.end()
+          && std::find(meshNames.begin(), meshNames.end(), targetMeshName) == meshNames.end())
+        continue;
+
+      if (sourceMeshName == excludedMeshName || targetMeshName == excludedMeshName)
+        continue;
+
+      int nRelocatedSourceDofs = mappingWithSettings.second.mapping->updateMapping();
+
+      VLOG(1) << "updated mapping \"" << sourceMeshName << "\" -> \"" << targetMeshName << "\", " << nRelocatedSourceDofs << " source dofs relocated";
+
+      // log event, to be included in the log file
+      addLogEntryMapping(sourceMeshName, targetMeshName, mappingLogEntry_t::logEvent_t::eventUpdateMapping);
+    }
+  }
+}
+
 void ManagerInitialize::storeMappingsBetweenMeshes(PythonConfig specificSettings)
 {
   LOG(TRACE) << "MeshManagerInitialize::storeMappingsBetweenMeshes";
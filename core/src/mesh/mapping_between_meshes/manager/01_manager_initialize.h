@@ -30,6 +30,10 @@ public:
   bool hasMappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
                                std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget);
 
+  //! update all created mappings from or to any of the given meshes after their geometry has changed, except mappings from or to the mesh excludedMeshName,
+  //! this is faster than creating them again, see MappingBetweenMeshesConstruct::updateMapping
+  void updateMappingsBetweenMeshes(const std::vector<std::string> &meshNames, std::string excludedMeshName = "");
+
   //! helper function that call the initialization depending on which mapping direction has been set in the python config
   template<typename FunctionSpace1Type, typename FunctionSpace2Type>
   void initializeMappingsBetweenMeshesFromSettings(const std::shared_ptr<FunctionSpace1Type> functionSpace1,
@@ -58,6 +62,7 @@ protected:
     bool enableWarnings;        //< if warnings should be shown if source dofs are outside the target mesh with the given xi tolerance
     bool compositeUseOnlyInitializedMappings;   //< if for composite source meshes the mapping should be created from also defined mappings from the sub meshes
     bool isEnabledFixUnmappedDofs;              //< if the unmapped dofs in the target mesh should be fixed by interpolating in the source mesh
+    bool useSpatialIndex;       //< if a spatial index of the elements should be used to locate the source dofs in the target mesh
     double defaultValue;        //< default value that is used if a target dof has no source dof that provides any values
   };
 
@@ -65,6 +70,7 @@ protected:
   std::map<std::string, double> defaultValues_;    //< for every target mesh name the default value to set all target field variables to where there are no source dofs
 
   std::map<std::string, std::map<std::string, MappingWithSettings>> mappingsBetweenMeshes_;   //<["key mesh from"]["key mesh to"] mapping between meshes
+  bool shareVecsOfConnectedSlots_;   //< if components of multi-component field variables on the same mesh should use the same Petsc Vec instead of copying, when the slots are connected in both directions
 
 };
 
@@ -41,6 +41,7 @@ createMappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpac
     this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].enableWarnings = false;
     this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].compositeUseOnlyInitializedMappings = false;
     this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].isEnabledFixUnmappedDofs = false;
+    this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].useSpatialIndex = true;
     this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].defaultValue = 0;
     mappingFound = false;
   }
@@ -55,6 +56,7 @@ createMappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpac
   bool enableWarnings = this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].enableWarnings;
   bool compositeUseOnlyInitializedMappings = this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].compositeUseOnlyInitializedMappings;
   bool isEnabledFixUnmappedDofs = this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].isEnabledFixUnmappedDofs;
+  bool useSpatialIndex = this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].useSpatialIndex;
   double defaultValue = this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].defaultValue;
 
   std::stringstream s;
@@ -78,7 +80,8 @@ createMappingBetweenMeshes(std::shared_ptr<FunctionSpaceSourceType> functionSpac
   // create the mapping under the given source and target mesh names
   this->mappingsBetweenMeshes_[sourceMeshName][targetMeshName].mapping = std::static_pointer_cast<MappingBetweenMeshesBase>(
     std::make_shared<MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType>>(functionSpaceSource, functionSpaceTarget,
-                                                                                            xiTolerance, enableWarnings, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs)
+                                                                                            xiTolerance, enableWarnings, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs,
+                                                                                            useSpatialIndex)
   );
 
   // add default Value
@@ -1,5 +1,7 @@
 #include "mesh/mapping_between_meshes/manager/04_manager.h"
 
+#include "mesh/type_traits.h"
+
 namespace MappingBetweenMeshes
 {
 
@@ -55,6 +57,29 @@ struct ExtractComponentCopy<FieldVariableSourceType,FieldVariableTargetType,
 };
 
 
+template<typename FieldVariableSourceType, typename FieldVariableTargetType, typename Dummy=void>
+struct ShareComponent
+{
+  // helper function, sharing Vec's is not possible for different function spaces or unstructured meshes, then the values have to be copied
+  static bool call(int componentNoSource, std::shared_ptr<FieldVariableSourceType> fieldVariableSource, std::shared_ptr<FieldVariableTargetType> fieldVariableTarget, int componentNoTarget)
+  {
+    return false;
+  }
+};
+
+template<typename FieldVariableSourceType, typename FieldVariableTargetType>
+struct ShareComponent<FieldVariableSourceType,FieldVariableTargetType,
+  typename std::enable_if<std::is_same<typename FieldVariableSourceType::FunctionSpace,typename FieldVariableTargetType::FunctionSpace>::value
+     && std::is_same<typename FieldVariableTargetType::FunctionSpace::Mesh,Mesh::isStructuredOrComposite<typename FieldVariableTargetType::FunctionSpace::Mesh>>::value,void>::type
+>
+{
+  // let the target component use the Petsc Vec of the source component
+  static bool call(int componentNoSource, std::shared_ptr<FieldVariableSourceType> fieldVariableSource, std::shared_ptr<FieldVariableTargetType> fieldVariableTarget, int componentNoTarget)
+  {
+    return fieldVariableTarget->shareComponent(componentNoTarget, fieldVariableSource, componentNoSource);
+  }
+};
+
 template<typename FieldVariableSourceType, typename FieldVariableTargetType, typename Dummy=void>
 struct RestoreExtractedComponent
 {
@@ -285,8 +310,34 @@ map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
           }
         }
 
-        // fieldVariableTarget has > 1 components or avoidCopyIfPossible is false which means explicit copy
-        if (componentNoSource == -1)
+        // fieldVariableTarget has > 1 components or avoidCopyIfPossible is false
+        // If copy should be avoided and it is enabled by the option "shareVecsOfConnectedSlots", let the target components use the same Petsc Vec's
+        // as the source components. Then, no data has to be copied in this and all following transfers.
+        bool isComponentShared = false;
+        if (avoidCopyIfPossible && shareVecsOfConnectedSlots_)
+        {
+          if (componentNoSource == -1)
+          {
+            isComponentShared = true;
+            for (int componentNo = 0; componentNo < std::min(FieldVariableSourceType::nComponents(), FieldVariableTargetType::nComponents()); componentNo++)
+            {
+              if (!ShareComponent<FieldVariableSourceType,FieldVariableTargetType>::call(componentNo, fieldVariableSource, fieldVariableTarget, componentNo))
+                isComponentShared = false;
+            }
+          }
+          else
+          {
+            isComponentShared = ShareComponent<FieldVariableSourceType,FieldVariableTargetType>::call(componentNoSource, fieldVariableSource, fieldVariableTarget, componentNoTarget);
+          }
+          VLOG(1) << "share Vec of source component " << componentNoSource << " with target component " << componentNoTarget << ": " << isComponentShared;
+        }
+
+        // explicit copy
+        if (isComponentShared)
+        {
+          // the values are already in the target field variable
+        }
+        else if (componentNoSource == -1)
         {
           VLOG(1) << "copy all " << std::min(FieldVariableSourceType::nComponents(), FieldVariableTargetType::nComponents()) << " components";
 
@@ -15,7 +15,18 @@ namespace FieldVariable
 namespace MappingBetweenMeshes
 {
 
-class MappingBetweenMeshesBase{};
+/** Common base class of all mappings, such that they can be stored by the manager independent of the function space types.
+ */
+class MappingBetweenMeshesBase
+{
+public:
+  //! virtual destructor
+  virtual ~MappingBetweenMeshesBase() {}
+
+  //! update the mapping after the geometry of the source or target mesh has changed
+  //! @return the number of source dofs that were relocated to a different target element
+  virtual int updateMapping() = 0;
+};
 
 /**
  * This is a mapping between two meshes, e.g. one 1D fiber mesh and one 3D mesh.
@@ -31,7 +42,7 @@ public:
   //! constructor, the function spaces need to be initialized
   MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource, std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
                                 double xiTolerance=0, bool enableWarnings=true, bool compositeUseOnlyInitializedMappings=false,
-                                bool isEnabledFixUnmappedDofs=true);
+                                bool isEnabledFixUnmappedDofs=true, bool useSpatialIndex=true);
 
   /** data tytpe to store the target dofs of a source mesh dof to which the value will contribute
    */
@@ -49,12 +60,23 @@ public:
   //! get access to the internal targetMappingInfo_ variable
   const std::vector<targetDof_t> &targetMappingInfo() const;
 
+  //! update the mapping after the geometry of the source or target mesh has changed, instead of creating it again.
+  //! The previous target element of every source dof is checked first, only dofs whose xi left [0,1] are located in the neighbouring elements and,
+  //! if not found there, in the spatial index or among all elements. Source dofs that were outside of the target mesh stay unmapped.
+  //! @return the number of source dofs that were relocated to a different target element
+  int updateMapping() override;
+
 protected:
 
+  //! compute the factors with which the value of a source dof at xi in the target element is distributed to the dofs of the target element,
+  //! set targetDofIsMappedTo for the local target dofs that get a contribution
+  void computeScalingFactors(element_no_t targetElementNoLocal, const std::array<double,FunctionSpaceTargetType::dim()> &xi,
+                             typename targetDof_t::element_t &targetElement, std::vector<bool> &targetDofIsMappedTo);
+
   //! add mapping to the target that have so far no contribution from any source dof, by interpolating the source mesh
   void fixUnmappedDofs(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
                        std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
-                       double xiTolerance, bool compositeUseOnlyInitializedMappings, bool isEnabledFixUnmappedDofs, const std::vector<bool> &targetDofIsMappedTo,
+                       double xiTolerance, bool compositeUseOnlyInitializedMappings, bool isEnabledFixUnmappedDofs, bool useSpatialIndex, const std::vector<bool> &targetDofIsMappedTo,
                        int &nTargetDofsNotMapped, int &nTimesSearchedAllElements, int &nTargetDofNosLocaNotFixed
                       );
 
@@ -68,6 +90,12 @@ protected:
 
 
   std::vector<targetDof_t> targetMappingInfo_;  //< [localDofNo source functionSpace (low dim)] information where in the target (high dim) to store the value from local dof No of the source (low dim)
+
+  double xiTolerance_;                          //< the xiTolerance setting with which the mapping was created, used by updateMapping
+  bool enableWarnings_;                         //< if warnings should be shown if source dofs are outside the target mesh
+  bool compositeUseOnlyInitializedMappings_;    //< if for composite source meshes the mapping was created from the mappings of the sub meshes
+  bool isEnabledFixUnmappedDofs_;               //< if the unmapped dofs in the target mesh should be fixed by interpolating in the source mesh
+  bool useSpatialIndex_;                        //< if the spatial indices of the meshes should be used to locate the points
 };
 
 }  // namespace
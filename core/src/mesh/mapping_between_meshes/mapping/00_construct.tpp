@@ -16,9 +16,14 @@ MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>:
 MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
                               std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
                               double xiTolerance, bool enableWarnings, bool compositeUseOnlyInitializedMappings,
-                              bool isEnabledFixUnmappedDofs) :
+                              bool isEnabledFixUnmappedDofs, bool useSpatialIndex) :
   functionSpaceSource_(functionSpaceSource),
-  functionSpaceTarget_(functionSpaceTarget)
+  functionSpaceTarget_(functionSpaceTarget),
+  xiTolerance_(xiTolerance <= 0? 1e-1 : xiTolerance),
+  enableWarnings_(enableWarnings),
+  compositeUseOnlyInitializedMappings_(compositeUseOnlyInitializedMappings),
+  isEnabledFixUnmappedDofs_(isEnabledFixUnmappedDofs),
+  useSpatialIndex_(useSpatialIndex)
 {
   // for composite meshes if the option compositeUseOnlyInitializedMappings is set, do not create the mapping here
   if (Mesh::isComposite<std::shared_ptr<FunctionSpaceSourceType>>::value && compositeUseOnlyInitializedMappings)
@@ -82,7 +87,21 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
     // if xi tolerance was not set, set to default value
     if (xiTolerance <= 0)
       xiTolerance = 1e-1;
-      
+
+    // create or update the spatial index of the target elements, it is used by findPosition when the estimated element and its neighbours do not contain the point,
+    // the bounding boxes of the elements are enlarged by xiTolerance, such that points that are found with this tolerance are contained
+    int nSpatialIndexElementsInserted = 0;
+    int nSpatialIndexQueriesBefore = 0;
+    int nSpatialIndexFallbacksBefore = 0;
+    if (useSpatialIndex)
+    {
+      Control::PerformanceMeasurement::start("durationSpatialIndex");
+      nSpatialIndexElementsInserted = functionSpaceTarget->updateSpatialIndex(xiTolerance);
+      Control::PerformanceMeasurement::stop("durationSpatialIndex");
+
+      functionSpaceTarget->spatialIndexStatistics(nSpatialIndexQueriesBefore, nSpatialIndexFallbacksBefore);
+    }
+
     bool startSearchInCurrentElement = true;    // start in element 0, maybe this is already the first element (it is if both meshes are completely aligned)
     int nSourceDofsOutsideTargetMesh = 0;
     double residual;
@@ -146,56 +165,8 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
       // store element no
       targetMappingInfo.targetElements[0].elementNoLocal = elementNo;
 
-      std::array<dof_no_t,FunctionSpaceTargetType::nDofsPerElement()> targetDofNos = functionSpaceTarget->getElementDofNosLocal(elementNo);
-
       // determine factors how to distribute the source value to the dofs of the target element
-
-      // note: geometry value = sum over dofs of geometryValue_dof * phi_dof(xi)
-      for (int targetDofIndex = 0; targetDofIndex < nDofsPerTargetElement; targetDofIndex++)
-      {
-        double phiContribution;
-
-        // for quadratic elements, treat as consisting of linear elements, this is disabled because it gives worse quality than the direct quadratic contributions
-        if (false && std::is_same<typename FunctionSpaceTargetType::BasisFunction,typename BasisFunction::LagrangeOfOrder<2>>::value)
-        {
-          bool sourceDofHasContributionToTargetDof = true;
-          phiContribution = quadraticElementComputePhiContribution(xi, targetDofIndex, sourceDofHasContributionToTargetDof);
-
-          if (!sourceDofHasContributionToTargetDof)
-            continue;
-        }
-        else
-        {
-          // for linear elements
-          phiContribution = functionSpaceTarget->phi(targetDofIndex, xi);
-        }
-
-        // if phi is close to zero, set to 1e-14, this is practically zero, but it is still possible to divide by it in case the dof does not get any other contribution
-        if (fabs(phiContribution) < 1e-14)
-        {
-          if (phiContribution >= 0)
-          {
-            phiContribution = 1e-14;
-          }
-          else
-          {
-            phiContribution = -1e-14;
-          }
-        }
-        else
-        {
-          dof_no_t targetDofNoLocal = targetDofNos[targetDofIndex];
-
-          // if this dof is local, store information that this target dof will get a value in the mapping,
-          // i.e. there is a source dof that influences the mapped value of the target dof
-          if (targetDofNoLocal < nDofsLocalTarget)
-          {
-            targetDofIsMappedTo[targetDofNoLocal] = true;
-          }
-        }
-
-        targetMappingInfo.targetElements[0].scalingFactors[targetDofIndex] = phiContribution;
-      }
+      computeScalingFactors(elementNo, xi, targetMappingInfo.targetElements[0], targetDofIsMappedTo);
 
       // debugging output about how interpolation is done, only in debug mode
 #ifndef NDEBUG
@@ -236,7 +207,16 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
     int nTargetDofNosLocaNotFixed = 0;
 
     // find target dofs that do not appear in any targetMappingInfo and therefore will so far not receive any value when mapping from source to target
-    fixUnmappedDofs(functionSpaceSource, functionSpaceTarget, xiTolerance, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs, targetDofIsMappedTo,
+    int nSpatialIndexQueries = 0;
+    int nSpatialIndexFallbacks = 0;
+    if (useSpatialIndex)
+    {
+      functionSpaceTarget->spatialIndexStatistics(nSpatialIndexQueries, nSpatialIndexFallbacks);
+      nSpatialIndexQueries -= nSpatialIndexQueriesBefore;
+      nSpatialIndexFallbacks -= nSpatialIndexFallbacksBefore;
+    }
+
+    fixUnmappedDofs(functionSpaceSource, functionSpaceTarget, xiTolerance, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs, useSpatialIndex, targetDofIsMappedTo,
                     nTargetDofsNotMapped, nTimesSearchedAllElementsForFix, nTargetDofNosLocaNotFixed);
 
     Control::PerformanceMeasurement::stop("durationComputeMappingBetweenMeshes");
@@ -268,6 +248,12 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
         << "              iterated " << nTimesSearchedAllElements << " times over target mesh,\n"
         << "              \"xiTolerance\": " << xiTolerance << " (increase this value to reduce the number of (costly) iterations over the whole mesh, however increasing potentially leads to more elements being checked which takes longer).\n";
     }
+    if (useSpatialIndex)
+    {
+      logMessage << "              spatial index of target mesh: " << nSpatialIndexElementsInserted << " elements (re)inserted, "
+        << nSpatialIndexQueries << " queries, " << nSpatialIndexFallbacks << " of them not found in the index,\n"
+        << "              total duration of spatial index updates so far: " << Control::PerformanceMeasurement::getDuration("durationSpatialIndex") << " s,\n";
+    }
     logMessage << "              Total duration of all mappings so far: " << Control::PerformanceMeasurement::getDuration("durationComputeMappingBetweenMeshes") << " s.";
     DihuContext::mappingBetweenMeshesManager()->addLogMessage(logMessage.str());
 
@@ -344,12 +330,173 @@ quadraticElementComputePhiContribution(std::array<double,FunctionSpaceTargetType
   return phiContribution;
 }
 
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+computeScalingFactors(element_no_t targetElementNoLocal, const std::array<double,FunctionSpaceTargetType::dim()> &xi,
+                      typename targetDof_t::element_t &targetElement, std::vector<bool> &targetDofIsMappedTo)
+{
+  const dof_no_t nDofsLocalTarget = functionSpaceTarget_->nDofsLocalWithoutGhosts();
+  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+
+  std::array<dof_no_t,FunctionSpaceTargetType::nDofsPerElement()> targetDofNos = functionSpaceTarget_->getElementDofNosLocal(targetElementNoLocal);
+
+  // note: geometry value = sum over dofs of geometryValue_dof * phi_dof(xi)
+  for (int targetDofIndex = 0; targetDofIndex < nDofsPerTargetElement; targetDofIndex++)
+  {
+    double phiContribution;
+
+    // for quadratic elements, treat as consisting of linear elements, this is disabled because it gives worse quality than the direct quadratic contributions
+    if (false && std::is_same<typename FunctionSpaceTargetType::BasisFunction,typename BasisFunction::LagrangeOfOrder<2>>::value)
+    {
+      bool sourceDofHasContributionToTargetDof = true;
+      phiContribution = quadraticElementComputePhiContribution(xi, targetDofIndex, sourceDofHasContributionToTargetDof);
+
+      if (!sourceDofHasContributionToTargetDof)
+        continue;
+    }
+    else
+    {
+      // for linear elements
+      phiContribution = functionSpaceTarget_->phi(targetDofIndex, xi);
+    }
+
+    // if phi is close to zero, set to 1e-14, this is practically zero, but it is still possible to divide by it in case the dof does not get any other contribution
+    if (fabs(phiContribution) < 1e-14)
+    {
+      if (phiContribution >= 0)
+      {
+        phiContribution = 1e-14;
+      }
+      else
+      {
+        phiContribution = -1e-14;
+      }
+    }
+    else
+    {
+      dof_no_t targetDofNoLocal = targetDofNos[targetDofIndex];
+
+      // if this dof is local, store information that this target dof will get a value in the mapping,
+      // i.e. there is a source dof that influences the mapped value of the target dof
+      if (targetDofNoLocal < nDofsLocalTarget)
+      {
+        targetDofIsMappedTo[targetDofNoLocal] = true;
+      }
+    }
+
+    targetElement.scalingFactors[targetDofIndex] = phiContribution;
+  }
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+int MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+updateMapping()
+{
+  // if the mapping was not created, e.g. because one of the meshes has no elements, there is nothing to update
+  if (targetMappingInfo_.empty())
+    return 0;
+
+  Control::PerformanceMeasurement::start("durationUpdateMappingBetweenMeshes");
+
+  const dof_no_t nDofsLocalSource = functionSpaceSource_->nDofsLocalWithoutGhosts();
+  const dof_no_t nDofsLocalTarget = functionSpaceTarget_->nDofsLocalWithoutGhosts();
+  const int D = FunctionSpaceTargetType::dim();
+
+  // update the spatial index of the target elements, only the elements that moved out of their stored bounding box are reinserted
+  if (useSpatialIndex_)
+  {
+    Control::PerformanceMeasurement::start("durationSpatialIndex");
+    functionSpaceTarget_->updateSpatialIndex(xiTolerance_);
+    Control::PerformanceMeasurement::stop("durationSpatialIndex");
+  }
+
+  std::vector<bool> targetDofIsMappedTo(nDofsLocalTarget, false);   //< for every target dof if it will get a value from any source dof
+
+  int nRelocatedSourceDofs = 0;
+  int nSourceDofsOutsideTargetMesh = 0;
+  int nTimesSearchedAllElements = 0;
+
+  // loop over all local dofs of the source functionSpace
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
+  {
+    targetDof_t &targetMappingInfo = targetMappingInfo_[sourceDofNoLocal];
+
+    // remove the target elements that were added by fixUnmappedDofs, they are determined again below,
+    // if the mapping was composed from the mappings of the sub meshes, they cannot be determined again here and are kept
+    if (!compositeUseOnlyInitializedMappings_)
+      targetMappingInfo.targetElements.resize(1);
+
+    // source dofs that were outside of the target mesh stay unmapped, locating them again would require a search among all elements
+    if (!targetMappingInfo.mapThisDof || targetMappingInfo.targetElements.empty())
+    {
+      nSourceDofsOutsideTargetMesh++;
+      continue;
+    }
+
+    Vec3 position = functionSpaceSource_->getGeometry(sourceDofNoLocal);
+
+    // start the search at the previous target element, if the point is still inside with 0 <= xi <= 1, only this element is checked,
+    // otherwise the neighbouring elements are checked and the best fit is used
+    const element_no_t previousElementNo = targetMappingInfo.targetElements[0].elementNoLocal;
+    element_no_t elementNo = previousElementNo;
+    int ghostMeshNo = -1;
+    std::array<double,D> xi;
+    double residual;
+    bool searchedAllElements = false;
+    bool startSearchInCurrentElement = true;
+
+    if (functionSpaceTarget_->findPosition(position, elementNo, ghostMeshNo, xi, startSearchInCurrentElement, residual, searchedAllElements, xiTolerance_))
+    {
+      if (searchedAllElements)
+        nTimesSearchedAllElements++;
+
+      if (elementNo != previousElementNo)
+      {
+        nRelocatedSourceDofs++;
+        VLOG(1) << "source dof " << sourceDofNoLocal << " at " << position << " moved from element " << previousElementNo << " to element " << elementNo << ", xi=" << xi;
+      }
+    }
+    else
+    {
+      if (enableWarnings_)
+      {
+        LOG(INFO) << "In update of mapping between meshes \"" << functionSpaceSource_->meshName() << "\" and \""
+          << functionSpaceTarget_->meshName() << "\", source dof local " << sourceDofNoLocal << " at position " << position
+          << " is now outside of target mesh with tolerance " << xiTolerance_ << ".";
+      }
+
+      nSourceDofsOutsideTargetMesh++;
+      targetMappingInfo.mapThisDof = false;
+      continue;
+    }
+
+    // store element no and the new scaling factors
+    targetMappingInfo.targetElements[0].elementNoLocal = elementNo;
+    computeScalingFactors(elementNo, xi, targetMappingInfo.targetElements[0], targetDofIsMappedTo);
+  }
+
+  // add contributions to the target dofs that do not get any value from the source dofs
+  int nTargetDofsNotMapped = 0;
+  int nTimesSearchedAllElementsForFix = 0;
+  int nTargetDofNosLocaNotFixed = 0;
+  fixUnmappedDofs(functionSpaceSource_, functionSpaceTarget_, xiTolerance_, compositeUseOnlyInitializedMappings_, isEnabledFixUnmappedDofs_, useSpatialIndex_,
+                  targetDofIsMappedTo, nTargetDofsNotMapped, nTimesSearchedAllElementsForFix, nTargetDofNosLocaNotFixed);
+
+  Control::PerformanceMeasurement::stop("durationUpdateMappingBetweenMeshes");
+
+  LOG(DEBUG) << "updated mapping \"" << functionSpaceSource_->meshName() << "\" -> \"" << functionSpaceTarget_->meshName() << "\", "
+    << nRelocatedSourceDofs << "/" << nDofsLocalSource << " source dofs relocated, " << nSourceDofsOutsideTargetMesh << " outside of target mesh, "
+    << nTimesSearchedAllElements << " times searched all elements, " << nTargetDofsNotMapped << " target dofs not mapped";
+
+  return nRelocatedSourceDofs;
+}
+
 template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
 void MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>::
 fixUnmappedDofs(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
                 std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
-                double xiTolerance, bool compositeUseOnlyInitializedMappings, bool isEnabledFixUnmappedDofs, const std::vector<bool> &targetDofIsMappedTo,
-                int &nTargetDofsNotMapped, int &nTimesSearchedAllElements, int &nTargetDofNosLocaNotFixed)
+                double xiTolerance, bool compositeUseOnlyInitializedMappings, bool isEnabledFixUnmappedDofs, bool useSpatialIndex,
+                const std::vector<bool> &targetDofIsMappedTo, int &nTargetDofsNotMapped, int &nTimesSearchedAllElements, int &nTargetDofNosLocaNotFixed)
 {
   const dof_no_t nDofsLocalTarget = functionSpaceTarget->nDofsLocalWithoutGhosts();
   const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
@@ -404,6 +551,14 @@ fixUnmappedDofs(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource,
     std::set<dof_no_t> targetDofNoLocalNotFixed;    // collect all dofs that are still not fixed
     nTimesSearchedAllElements = 1;
 
+    // the target dofs are searched in the source mesh, use the spatial index of the source elements
+    if (useSpatialIndex)
+    {
+      Control::PerformanceMeasurement::start("durationSpatialIndex");
+      functionSpaceSource->updateSpatialIndex(xiTolerance);
+      Control::PerformanceMeasurement::stop("durationSpatialIndex");
+    }
+
     // loop over all elements in the target function space
     for (element_no_t targetElementNoLocal = 0; targetElementNoLocal < functionSpaceTarget->nElementsLocal(); targetElementNoLocal++)
     {
@@ -3,6 +3,7 @@
 #include <Python.h>  // has to be the first included header
 
 #include <memory>
+#include <vector>
 #include "control/types.h"
 
 #include "mesh/mapping_between_meshes/mapping/00_construct.h"
@@ -48,6 +49,33 @@ public:
   template<int nComponentsTarget, int nComponentsSource>
   void mapHighToLowDimension(FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponentsTarget> &fieldVariableSource, int componentNoSource,
                              FieldVariable::FieldVariable<FunctionSpaceSourceType,nComponentsSource> &fieldVariableTarget, int componentNoTarget);
+
+  //! update the mapping after the geometry of the source or target mesh has changed, the interpolation matrices will be assembled again at the next mapping
+  int updateMapping() override;
+
+protected:
+
+  /** The interpolation factors of one mapping direction as sparse matrix in CSR format. Every row contains the factors of one local dof (with ghosts)
+   *  of the function space that receives the values, the columns are local dof nos of the function space where the values are taken from.
+   */
+  struct InterpolationMatrix
+  {
+    std::vector<dof_no_t> rowDofNosLocal;       //< the local dof no of every row in the function space that receives the values
+    std::vector<int> rowBegin;                  //< [rowNo] index of the first entry of row rowNo in columnDofNosLocal and values, has one more entry than there are rows
+    std::vector<dof_no_t> columnDofNosLocal;    //< the local dof nos in the function space from which the values are taken
+    std::vector<double> values;                 //< the interpolation factors
+    std::vector<double> rowSums;                //< [rowNo] sum of the interpolation factors of every row, needed for targetFactorSum
+    bool isCreated = false;                     //< if the matrix has been assembled from the current targetMappingInfo_
+  };
+
+  //! assemble lowToHighMatrix_ from targetMappingInfo_, if this was not yet done
+  void createLowToHighMatrix();
+
+  //! assemble highToLowMatrix_ from targetMappingInfo_, if this was not yet done
+  void createHighToLowMatrix();
+
+  InterpolationMatrix lowToHighMatrix_;         //< the interpolation factors for mapLowToHighDimension, rows are target dofs, columns are source dofs
+  InterpolationMatrix highToLowMatrix_;         //< the normalized interpolation factors for mapHighToLowDimension, rows are source dofs, columns are target dofs
 };
 
 }  // namespace
@@ -13,6 +13,153 @@
 namespace MappingBetweenMeshes
 {
 
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+int MappingBetweenMeshesImplementation<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+updateMapping()
+{
+  // the interpolation factors change with the geometry, assemble the matrices again at the next mapping
+  lowToHighMatrix_.isCreated = false;
+  highToLowMatrix_.isCreated = false;
+
+  return MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::updateMapping();
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshesImplementation<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+createLowToHighMatrix()
+{
+  if (lowToHighMatrix_.isCreated)
+    return;
+
+  const dof_no_t nDofsLocalTarget = this->functionSpaceTarget_->nDofsLocalWithGhosts();
+  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+
+  // count the number of source dofs that contribute to every local target dof, a source dof can appear multiple times in a row
+  std::vector<int> nEntriesPerTargetDof(nDofsLocalTarget, 0);
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal < (dof_no_t)this->targetMappingInfo_.size(); sourceDofNoLocal++)
+  {
+    // if source dof is outside of target mesh, do nothing
+    if (!this->targetMappingInfo_[sourceDofNoLocal].mapThisDof)
+      continue;
+
+    for (const typename MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::targetDof_t::element_t &targetElement
+         : this->targetMappingInfo_[sourceDofNoLocal].targetElements)
+    {
+      for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
+      {
+        dof_no_t targetDofNoLocal = this->functionSpaceTarget_->getDofNo(targetElement.elementNoLocal, dofIndex);
+
+        if (targetDofNoLocal < 0 || targetDofNoLocal >= nDofsLocalTarget)
+        {
+          LOG(FATAL) << "Dof no " << targetDofNoLocal << " out of range, \"" << this->functionSpaceTarget_->meshName() << "\" has "
+            << nDofsLocalTarget << " local dofs with ghosts. Mapping \"" << this->functionSpaceSource_->meshName()
+            << "\" -> \"" << this->functionSpaceTarget_->meshName() << "\", targetElementNoLocal: "
+            << targetElement.elementNoLocal << "/" << this->functionSpaceTarget_->nElementsLocal() << ", dofIndex: " << dofIndex << "/" << nDofsPerTargetElement;
+        }
+        nEntriesPerTargetDof[targetDofNoLocal]++;
+      }
+    }
+  }
+
+  // create the rows for all target dofs that get any contribution
+  std::vector<int> rowNoOfTargetDof(nDofsLocalTarget, -1);
+  lowToHighMatrix_.rowDofNosLocal.clear();
+  lowToHighMatrix_.rowBegin.assign(1, 0);
+  for (dof_no_t targetDofNoLocal = 0; targetDofNoLocal < nDofsLocalTarget; targetDofNoLocal++)
+  {
+    if (nEntriesPerTargetDof[targetDofNoLocal] == 0)
+      continue;
+
+    rowNoOfTargetDof[targetDofNoLocal] = lowToHighMatrix_.rowDofNosLocal.size();
+    lowToHighMatrix_.rowDofNosLocal.push_back(targetDofNoLocal);
+    lowToHighMatrix_.rowBegin.push_back(lowToHighMatrix_.rowBegin.back() + nEntriesPerTargetDof[targetDofNoLocal]);
+  }
+
+  const int nRows = lowToHighMatrix_.rowDofNosLocal.size();
+  const int nEntries = lowToHighMatrix_.rowBegin.back();
+  lowToHighMatrix_.columnDofNosLocal.resize(nEntries);
+  lowToHighMatrix_.values.resize(nEntries);
+  lowToHighMatrix_.rowSums.assign(nRows, 0.0);
+
+  // fill in the entries, in the order of the source dofs
+  std::vector<int> nextEntryOfRow(lowToHighMatrix_.rowBegin.begin(), lowToHighMatrix_.rowBegin.end()-1);
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal < (dof_no_t)this->targetMappingInfo_.size(); sourceDofNoLocal++)
+  {
+    if (!this->targetMappingInfo_[sourceDofNoLocal].mapThisDof)
+      continue;
+
+    for (const typename MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::targetDof_t::element_t &targetElement
+         : this->targetMappingInfo_[sourceDofNoLocal].targetElements)
+    {
+      for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
+      {
+        const int rowNo = rowNoOfTargetDof[this->functionSpaceTarget_->getDofNo(targetElement.elementNoLocal, dofIndex)];
+        const int entryNo = nextEntryOfRow[rowNo]++;
+
+        lowToHighMatrix_.columnDofNosLocal[entryNo] = sourceDofNoLocal;
+        lowToHighMatrix_.values[entryNo] = targetElement.scalingFactors[dofIndex];
+        lowToHighMatrix_.rowSums[rowNo] += targetElement.scalingFactors[dofIndex];
+      }
+    }
+  }
+
+  lowToHighMatrix_.isCreated = true;
+
+  VLOG(1) << "created interpolation matrix \"" << this->functionSpaceSource_->meshName() << "\" -> \"" << this->functionSpaceTarget_->meshName()
+    << "\" with " << nRows << " rows and " << nEntries << " entries";
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshesImplementation<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+createHighToLowMatrix()
+{
+  if (highToLowMatrix_.isCreated)
+    return;
+
+  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+
+  highToLowMatrix_.rowDofNosLocal.clear();
+  highToLowMatrix_.rowBegin.assign(1, 0);
+  highToLowMatrix_.columnDofNosLocal.clear();
+  highToLowMatrix_.values.clear();
+  highToLowMatrix_.rowSums.clear();
+
+  // every source dof is interpolated in the target element where it is located, the first set of surrounding nodes (targetElements[0]) is enough
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal < (dof_no_t)this->targetMappingInfo_.size(); sourceDofNoLocal++)
+  {
+    // if source dof is outside of target mesh
+    if (!this->targetMappingInfo_[sourceDofNoLocal].mapThisDof || this->targetMappingInfo_[sourceDofNoLocal].targetElements.empty())
+      continue;
+
+    const typename MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::targetDof_t::element_t &targetElement
+      = this->targetMappingInfo_[sourceDofNoLocal].targetElements[0];
+
+    double scalingFactorsSum = 0;
+    for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
+    {
+      scalingFactorsSum += targetElement.scalingFactors[dofIndex];
+    }
+
+    if (fabs(scalingFactorsSum-1.0) > 1e-10)
+      LOG(ERROR) << "Scaling factors do not sum to 1, scalingFactorsSum: " << scalingFactorsSum << ", scalingFactors: " << targetElement.scalingFactors;
+
+    // store the normalized factors, such that the mapping is an interpolation
+    for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
+    {
+      highToLowMatrix_.columnDofNosLocal.push_back(this->functionSpaceTarget_->getDofNo(targetElement.elementNoLocal, dofIndex));
+      highToLowMatrix_.values.push_back(targetElement.scalingFactors[dofIndex] / scalingFactorsSum);
+    }
+    highToLowMatrix_.rowDofNosLocal.push_back(sourceDofNoLocal);
+    highToLowMatrix_.rowBegin.push_back(highToLowMatrix_.values.size());
+    highToLowMatrix_.rowSums.push_back(1.0);
+  }
+
+  highToLowMatrix_.isCreated = true;
+
+  VLOG(1) << "created interpolation matrix \"" << this->functionSpaceTarget_->meshName() << "\" -> \"" << this->functionSpaceSource_->meshName()
+    << "\" with " << highToLowMatrix_.rowDofNosLocal.size() << " rows and " << highToLowMatrix_.values.size() << " entries";
+}
+
 template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
   template<int nComponentsSource, int nComponentsTarget>
 void MappingBetweenMeshesImplementation<FunctionSpaceSourceType, FunctionSpaceTargetType>::
@@ -24,8 +171,8 @@ mapLowToHighDimension(
   assert(componentNoSource >= 0 && componentNoSource < nComponentsSource);
   assert(componentNoTarget >= 0 && componentNoTarget < nComponentsTarget);
 
-  const dof_no_t nDofsLocalSource = fieldVariableSource.functionSpace()->nDofsLocalWithoutGhosts();
-  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+  // assemble the interpolation matrix at the first call
+  createLowToHighMatrix();
 
   std::vector<double> sourceValues;
   fieldVariableSource.getValuesWithoutGhosts(componentNoSource, sourceValues);
@@ -36,48 +183,33 @@ mapLowToHighDimension(
       " (" << fieldVariableSource.functionSpace()->meshName() << ") -> " << fieldVariableTarget.name() << "." << componentNoTarget
       << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
-    VLOG(1) << "source has " << nDofsLocalSource << " local dofs";
+    VLOG(1) << "source has " << sourceValues.size() << " local dofs";
     VLOG(1) << fieldVariableSource;
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
-  // loop over all local dofs of the source functionSpace
-  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
-  {
-    // if source dof is outside of target mesh, do nothing
-    if (!this->targetMappingInfo_[sourceDofNoLocal].mapThisDof)
-      continue;
-
-    // get value
-    double sourceValue = sourceValues[sourceDofNoLocal];
+  // compute the contributions to all target dofs as sparse matrix-vector product
+  const int nRows = lowToHighMatrix_.rowDofNosLocal.size();
+  std::vector<double> targetValues(nRows, 0.0);
 
-    // loop over target elements that will be affected by this source value
-    for (int targetElementIndex = 0; targetElementIndex < this->targetMappingInfo_[sourceDofNoLocal].targetElements.size(); targetElementIndex++)
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    double targetValue = 0;
+    for (int entryNo = lowToHighMatrix_.rowBegin[rowNo]; entryNo < lowToHighMatrix_.rowBegin[rowNo+1]; entryNo++)
     {
-      const typename MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::targetDof_t::element_t &targetElement
-        = this->targetMappingInfo_[sourceDofNoLocal].targetElements[targetElementIndex];
-
-      // store the value to the target function space
-      element_no_t targetElementNoLocal = targetElement.elementNoLocal;
-      std::array<double,nDofsPerTargetElement> targetValues = targetElement.scalingFactors * sourceValue;
-
-      // determine dof nos of target element
-      std::array<dof_no_t,nDofsPerTargetElement> dofNosLocal;
-      for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
-      {
-        dofNosLocal[dofIndex] = fieldVariableTarget.functionSpace()->getDofNo(targetElementNoLocal, dofIndex);
-      }
+      targetValue += lowToHighMatrix_.values[entryNo] * sourceValues[lowToHighMatrix_.columnDofNosLocal[entryNo]];
+    }
+    targetValues[rowNo] = targetValue;
+  }
 
-      fieldVariableTarget.template setValues<nDofsPerTargetElement>(componentNoTarget, dofNosLocal, targetValues, ADD_VALUES);
-      targetFactorSum.template setValues<nDofsPerTargetElement>(dofNosLocal, targetElement.scalingFactors, ADD_VALUES);
+  // add the contributions to the target field variable, the division by targetFactorSum is done by the manager after all source meshes were mapped
+  fieldVariableTarget.setValues(componentNoTarget, lowToHighMatrix_.rowDofNosLocal, targetValues, ADD_VALUES);
+  targetFactorSum.setValues(0, lowToHighMatrix_.rowDofNosLocal, lowToHighMatrix_.rowSums, ADD_VALUES);
 
-      if (VLOG_IS_ON(2))
-      {
-        VLOG(2) << "  source dof " << sourceDofNoLocal << ", value: " << sourceValue << ", scaling factors: " << targetElement.scalingFactors
-          << ", targetValues: " << targetValues
-          << ", targetElementNoLocal: " << targetElementNoLocal << ", target dofs: " << dofNosLocal;
-      }
-    }
+  if (VLOG_IS_ON(2))
+  {
+    VLOG(2) << "  target dofs: " << lowToHighMatrix_.rowDofNosLocal << ", targetValues: " << targetValues
+      << ", factor sums: " << lowToHighMatrix_.rowSums;
   }
 }
 
@@ -90,8 +222,8 @@ mapLowToHighDimension(
   FieldVariable::FieldVariable<FunctionSpaceTargetType,1> &targetFactorSum
 )
 {
-  const dof_no_t nDofsLocalSource = fieldVariableSource.functionSpace()->nDofsLocalWithoutGhosts();
-  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+  // assemble the interpolation matrix at the first call
+  createLowToHighMatrix();
 
   std::vector<VecD<nComponents>> sourceValues;
   fieldVariableSource.getValuesWithoutGhosts(sourceValues);
@@ -101,62 +233,48 @@ mapLowToHighDimension(
     VLOG(1) << "map " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
       << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
-    VLOG(1) << "source has " << nDofsLocalSource << " local dofs";
+    VLOG(1) << "source has " << sourceValues.size() << " local dofs";
     VLOG(1) << fieldVariableSource;
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
-  // loop over all local dofs of the source functionSpace
-  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
+  if (targetFactorSum.functionSpace()->nDofsLocalWithGhosts() < this->functionSpaceTarget_->nDofsLocalWithGhosts())
   {
-    VLOG(1) << "source dof " << sourceDofNoLocal << " map: " << this->targetMappingInfo_[sourceDofNoLocal].mapThisDof
-      << ", has " << this->targetMappingInfo_[sourceDofNoLocal].targetElements.size() << " entry in target elements";
-
-    // if target dof is outside of source mesh
-    if (!this->targetMappingInfo_[sourceDofNoLocal].mapThisDof)
-      continue;
+    LOG(FATAL) << "\"" << targetFactorSum.functionSpace()->meshName() << "\" has " << targetFactorSum.functionSpace()->nDofsLocalWithGhosts()
+      << " local dofs with ghosts, but \"" << this->functionSpaceTarget_->meshName() << "\" has "
+      << this->functionSpaceTarget_->nDofsLocalWithGhosts() << " local dofs with ghosts. Mapping "
+      << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
+      << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
+  }
 
-    // get value
-    VecD<nComponents> sourceValue = sourceValues[sourceDofNoLocal];
+  // compute the contributions to all target dofs as sparse matrix-vector product
+  const int nRows = lowToHighMatrix_.rowDofNosLocal.size();
+  std::vector<VecD<nComponents>> targetValues(nRows);
 
-    // loop over target elements that will be affected by this source value
-    for (int targetElementIndex = 0; targetElementIndex < this->targetMappingInfo_[sourceDofNoLocal].targetElements.size(); targetElementIndex++)
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    VecD<nComponents> targetValue({0.0});
+    for (int entryNo = lowToHighMatrix_.rowBegin[rowNo]; entryNo < lowToHighMatrix_.rowBegin[rowNo+1]; entryNo++)
     {
-      const typename MappingBetweenMeshesConstruct<FunctionSpaceSourceType,FunctionSpaceTargetType>::targetDof_t::element_t &targetElement
-        = this->targetMappingInfo_[sourceDofNoLocal].targetElements[targetElementIndex];
-
-      // store the value to the target function space
-      element_no_t targetElementNoLocal = targetElement.elementNoLocal;
-      std::array<VecD<nComponents>,nDofsPerTargetElement> targetValues = targetElement.scalingFactors * sourceValue;
+      const double factor = lowToHighMatrix_.values[entryNo];
+      const VecD<nComponents> &sourceValue = sourceValues[lowToHighMatrix_.columnDofNosLocal[entryNo]];
 
-      // determine dof nos of target element
-      std::array<dof_no_t,nDofsPerTargetElement> dofNosLocal;
-      for (int dofIndex = 0; dofIndex < nDofsPerTargetElement; dofIndex++)
+      for (int componentNo = 0; componentNo < nComponents; componentNo++)
       {
-        dofNosLocal[dofIndex] = fieldVariableTarget.functionSpace()->getDofNo(targetElementNoLocal, dofIndex);
-
-        if (dofNosLocal[dofIndex] >= fieldVariableTarget.functionSpace()->nDofsLocalWithGhosts() 
-            || dofNosLocal[dofIndex] >= targetFactorSum.functionSpace()->nDofsLocalWithGhosts())
-        {
-          LOG(FATAL) << "Dof no " << dofNosLocal[dofIndex] << " out of range, \"" << fieldVariableTarget.functionSpace()->meshName() << "\" has "
-            << fieldVariableTarget.functionSpace()->nDofsLocalWithGhosts() << " local dofs with ghosts, \"" << targetFactorSum.functionSpace()->meshName() << "\" has "
-            << targetFactorSum.functionSpace()->nDofsLocalWithGhosts() << " local dofs with ghosts. Mapping "
-            << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
-            << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << "), targetElementNoLocal: " 
-            << targetElementNoLocal << "/" << fieldVariableTarget.functionSpace()->nElementsLocal() << ", dofIndex: " << dofIndex << "/" << nDofsPerTargetElement;
-        }
+        targetValue[componentNo] += factor * sourceValue[componentNo];
       }
+    }
+    targetValues[rowNo] = targetValue;
+  }
 
-      fieldVariableTarget.template setValues<nDofsPerTargetElement>(dofNosLocal, targetValues, ADD_VALUES);
-      targetFactorSum.template setValues<nDofsPerTargetElement>(dofNosLocal, targetElement.scalingFactors, ADD_VALUES);
+  // add the contributions to the target field variable, the division by targetFactorSum is done by the manager after all source meshes were mapped
+  fieldVariableTarget.setValues(lowToHighMatrix_.rowDofNosLocal, targetValues, ADD_VALUES);
+  targetFactorSum.setValues(0, lowToHighMatrix_.rowDofNosLocal, lowToHighMatrix_.rowSums, ADD_VALUES);
 
-      if (VLOG_IS_ON(2))
-      {
-        VLOG(2) << "  source dof " << sourceDofNoLocal << ", value: " << sourceValue << ", scaling factors: " << targetElement.scalingFactors
-          << ", targetValues: " << targetValues
-          << ", targetElementNoLocal: " << targetElementNoLocal << ", target dofs: " << dofNosLocal;
-      }
-    }
+  if (VLOG_IS_ON(2))
+  {
+    VLOG(2) << "  target dofs: " << lowToHighMatrix_.rowDofNosLocal << ", targetValues: " << targetValues
+      << ", factor sums: " << lowToHighMatrix_.rowSums;
   }
 }
 
@@ -171,28 +289,23 @@ mapHighToLowDimension(
   FieldVariable::FieldVariable<FunctionSpaceTargetType,nComponents> &fieldVariableTarget
 )
 {
-  const dof_no_t nDofsLocalTarget = fieldVariableTarget.functionSpace()->nDofsLocalWithoutGhosts();
-  const int nDofsPerSourceElement = FunctionSpaceSourceType::nDofsPerElement();
+  // assemble the interpolation matrix at the first call, rows are the dofs of fieldVariableTarget, columns the dofs of fieldVariableSource
+  createHighToLowMatrix();
+
+  // get all local source values including ghosts, because the elements of the source mesh where the target dofs are located can contain ghost dofs
+  std::vector<VecD<nComponents>> sourceValues;
+  fieldVariableSource.getValuesWithGhosts(sourceValues);
 
   if (VLOG_IS_ON(1))
   {
-    std::vector<VecD<nComponents>> sourceValues;
-    fieldVariableSource.getValuesWithoutGhosts(sourceValues);
-
     VLOG(1) << "map " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
       << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
-    VLOG(1) << "source has " << nDofsLocalTarget << " local dofs";
+    VLOG(1) << "target has " << fieldVariableTarget.functionSpace()->nDofsLocalWithoutGhosts() << " local dofs";
     VLOG(1) << fieldVariableSource;
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
-#ifdef OUTPUT_INTERPOLATION_LEAP
-  VecD<nComponents> previousTargetValue;
-  element_no_t previousSourceElementNoLocal;
-  std::array<double,FunctionSpaceSourceType::nDofsPerElement()> previousScalingFactors;
-#endif
-
   LOG(DEBUG) << "mapHighToLowDimension " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
       << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
@@ -201,65 +314,51 @@ mapHighToLowDimension(
   // visualization for 1D-1D: s=source, t=target
   // s--t--------s-----t-----s
 
-  // loop over all local dofs of the target functionSpace, which was the source function space when the mapping was initialized
-  for (dof_no_t targetDofNoLocal = 0; targetDofNoLocal != nDofsLocalTarget; targetDofNoLocal++)
-  {
-    // if source dof is outside of target mesh
-    if (!this->targetMappingInfo_[targetDofNoLocal].mapThisDof)
-      continue;
-
-    // the first set of surrounding nodes (targetElements[0]) is enough
-    const typename MappingBetweenMeshesConstruct<FunctionSpaceTargetType,FunctionSpaceSourceType>::targetDof_t::element_t &targetElement
-      = this->targetMappingInfo_[targetDofNoLocal].targetElements[0];
+  // compute the interpolated values as sparse matrix-vector product
+  const int nRows = highToLowMatrix_.rowDofNosLocal.size();
+  std::vector<VecD<nComponents>> targetValues(nRows);
 
-    element_no_t sourceElementNoLocal = targetElement.elementNoLocal;
-
-    // get source values of the element where targetDofNoLocal is in
-    std::array<VecD<nComponents>,nDofsPerSourceElement> sourceValues;
-    fieldVariableSource.getElementValues(sourceElementNoLocal, sourceValues);
-
-    double scalingFactorsSum = 0;
-    for (int i = 0; i < nDofsPerSourceElement; i++)
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
+    VecD<nComponents> targetValue({0.0});
+    for (int entryNo = highToLowMatrix_.rowBegin[rowNo]; entryNo < highToLowMatrix_.rowBegin[rowNo+1]; entryNo++)
     {
-      scalingFactorsSum += targetElement.scalingFactors[i];
-    }
-
-    if (fabs(scalingFactorsSum-1.0) > 1e-10)
-      LOG(ERROR) << "Scaling factors do not sum to 1, scalingFactorsSum: " << scalingFactorsSum << ", scalingFactors: " << targetElement.scalingFactors;
-
-    VecD<nComponents> targetValue = sourceValues * targetElement.scalingFactors;
-    fieldVariableTarget.setValue(targetDofNoLocal, targetValue, INSERT_VALUES);
-
-    LOG(DEBUG) << fieldVariableTarget.functionSpace()->meshName() << " dof " << targetDofNoLocal << " value = " << targetValue << " = " << sourceValues << " * " << targetElement.scalingFactors << ", interpolation in element " << sourceElementNoLocal << " of " << fieldVariableSource.functionSpace()->meshName();
+      const double factor = highToLowMatrix_.values[entryNo];
+      const VecD<nComponents> &sourceValue = sourceValues[highToLowMatrix_.columnDofNosLocal[entryNo]];
 
-#ifdef OUTPUT_INTERPOLATION_LEAP
-    if (targetDofNoLocal > 0)
-    {
-      double differenceToPrevious = MathUtility::distance<nComponents>(targetValue, previousTargetValue);
-      LOG(INFO) << "  target dof " << targetDofNoLocal << ", source element no local: " << sourceElementNoLocal << " differenceToPrevious=" << differenceToPrevious;
-      if (differenceToPrevious > 1)
+      for (int componentNo = 0; componentNo < nComponents; componentNo++)
       {
-        LOG(WARNING) << "In mapping " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
-          << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << "), differenceToPrevious=" << differenceToPrevious;
-        LOG(WARNING) << "  target dof " << targetDofNoLocal << ", source element no local: " << sourceElementNoLocal
-        << ", " << sourceValues.size() << " sourceValues: " << sourceValues
-        << ",\n scaling factors: " << targetElement.scalingFactors << " (scalingFactorsSum=" << scalingFactorsSum << "),\n previous target value: " << previousTargetValue
-        << ", target value: " << targetValue << ", previous source element: " << previousSourceElementNoLocal
-        << "\npreviousScalingFactors: " << previousScalingFactors;
+        targetValue[componentNo] += factor * sourceValue[componentNo];
       }
     }
-    if (VLOG_IS_ON(2))
+    targetValues[rowNo] = targetValue;
+  }
+
+  fieldVariableTarget.setValues(highToLowMatrix_.rowDofNosLocal, targetValues, INSERT_VALUES);
+
+#ifdef OUTPUT_INTERPOLATION_LEAP
+  for (int rowNo = 1; rowNo < nRows; rowNo++)
+  {
+    double differenceToPrevious = MathUtility::distance<nComponents>(targetValues[rowNo], targetValues[rowNo-1]);
+    LOG(INFO) << "  target dof " << highToLowMatrix_.rowDofNosLocal[rowNo] << " differenceToPrevious=" << differenceToPrevious;
+    if (differenceToPrevious > 1)
     {
-      VLOG(2)
-        << "  target dof " << targetDofNoLocal << ", source element no local: " << sourceElementNoLocal
-        << ", sourceValues: " << sourceValues
-        << ", scaling factors: " << targetElement.scalingFactors << " (scalingFactorsSum=" << scalingFactorsSum << "), target value: " << targetValue;
+      LOG(WARNING) << "In mapping " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
+        << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << "), differenceToPrevious=" << differenceToPrevious;
+      LOG(WARNING) << "  target dof " << highToLowMatrix_.rowDofNosLocal[rowNo] << ", source dofs: "
+        << std::vector<dof_no_t>(highToLowMatrix_.columnDofNosLocal.begin() + highToLowMatrix_.rowBegin[rowNo],
+                                 highToLowMatrix_.columnDofNosLocal.begin() + highToLowMatrix_.rowBegin[rowNo+1])
+        << ", scaling factors: "
+        << std::vector<double>(highToLowMatrix_.values.begin() + highToLowMatrix_.rowBegin[rowNo],
+                               highToLowMatrix_.values.begin() + highToLowMatrix_.rowBegin[rowNo+1])
+        << ", previous target value: " << targetValues[rowNo-1] << ", target value: " << targetValues[rowNo];
     }
-    // store quantities from last dof for debugging output
-    previousTargetValue = targetValue;
-    previousSourceElementNoLocal = sourceElementNoLocal;
-    previousScalingFactors = targetElement.scalingFactors;
+  }
 #endif
+
+  if (VLOG_IS_ON(2))
+  {
+    VLOG(2) << "  target dofs: " << highToLowMatrix_.rowDofNosLocal << ", targetValues: " << targetValues;
   }
 }
 
@@ -277,20 +376,21 @@ mapHighToLowDimension(
   assert(componentNoSource >= 0 && componentNoSource < nComponentsSource);
   assert(componentNoTarget >= 0 && componentNoTarget < nComponentsTarget);
 
-  const dof_no_t nDofsLocalTarget = fieldVariableTarget.functionSpace()->nDofsLocalWithoutGhosts();
-  const int nDofsPerSourceElement = FunctionSpaceSourceType::nDofsPerElement();
+  // assemble the interpolation matrix at the first call, rows are the dofs of fieldVariableTarget, columns the dofs of fieldVariableSource
+  createHighToLowMatrix();
+
+  // get all local source values including ghosts, because the elements of the source mesh where the target dofs are located can contain ghost dofs
+  std::vector<double> sourceValues;
+  fieldVariableSource.getValuesWithGhosts(componentNoSource, sourceValues);
 
   if (VLOG_IS_ON(1))
   {
-    std::vector<double> sourceValues;
-    fieldVariableSource.getValuesWithoutGhosts(componentNoSource, sourceValues);
-
     VLOG(1) << "map " << fieldVariableSource.name() << "." << componentNoSource
       << " (" << fieldVariableSource.functionSpace()->meshName()
       << ") -> " << fieldVariableTarget.name() << "." << componentNoTarget
       << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
-    VLOG(1) << "source has " << nDofsLocalTarget << " local dofs";
+    VLOG(1) << "target has " << fieldVariableTarget.functionSpace()->nDofsLocalWithoutGhosts() << " local dofs";
     VLOG(1) << fieldVariableSource;
     VLOG(1) << "extracted source values: " << sourceValues;
   }
@@ -298,42 +398,25 @@ mapHighToLowDimension(
   // visualization for 1D-1D: s=source, t=target
   // s--t--------s-----t-----s
 
-  // loop over all local dofs of the target functionSpace, which was the source function space when the mapping was initialized
-  for (dof_no_t targetDofNoLocal = 0; targetDofNoLocal != nDofsLocalTarget; targetDofNoLocal++)
-  {
-    // if source dof is outside of target mesh
-    if (!this->targetMappingInfo_[targetDofNoLocal].mapThisDof)
-      continue;
-
-    // the first set of surrounding nodes (targetElements[0]) is enough
-    const typename MappingBetweenMeshesConstruct<FunctionSpaceTargetType,FunctionSpaceSourceType>::targetDof_t::element_t &targetElement
-      = this->targetMappingInfo_[targetDofNoLocal].targetElements[0];
-
-    element_no_t sourceElementNoLocal = targetElement.elementNoLocal;
-
-    double scalingFactorsSum = 0;
-    for (int i = 0; i < nDofsPerSourceElement; i++)
-    {
-      scalingFactorsSum += targetElement.scalingFactors[i];
-    }
-
-    // get source values of the element where targetDofNoLocal is in
-    std::array<double,nDofsPerSourceElement> sourceValues;
-    fieldVariableSource.getElementValues(componentNoSource, sourceElementNoLocal, sourceValues);
+  // compute the interpolated values as sparse matrix-vector product
+  const int nRows = highToLowMatrix_.rowDofNosLocal.size();
+  std::vector<double> targetValues(nRows, 0.0);
 
+  for (int rowNo = 0; rowNo < nRows; rowNo++)
+  {
     double targetValue = 0;
-    for (int i = 0; i < nDofsPerSourceElement; i++)
+    for (int entryNo = highToLowMatrix_.rowBegin[rowNo]; entryNo < highToLowMatrix_.rowBegin[rowNo+1]; entryNo++)
     {
-      targetValue += sourceValues[i] * targetElement.scalingFactors[i] / scalingFactorsSum;
+      targetValue += highToLowMatrix_.values[entryNo] * sourceValues[highToLowMatrix_.columnDofNosLocal[entryNo]];
     }
-    fieldVariableTarget.setValue(componentNoTarget, targetDofNoLocal, targetValue, INSERT_VALUES);
+    targetValues[rowNo] = targetValue;
+  }
 
-    if (VLOG_IS_ON(2))
-    {
-      VLOG(2) << "  target dof " << targetDofNoLocal << ", source element no local: " << sourceElementNoLocal
-        << ", sourceValues: " << sourceValues
-        << ", scaling factors: " << targetElement.scalingFactors << ", target value: " << targetValue;
-    }
+  fieldVariableTarget.setValues(componentNoTarget, highToLowMatrix_.rowDofNosLocal, targetValues, INSERT_VALUES);
+
+  if (VLOG_IS_ON(2))
+  {
+    VLOG(2) << "  target dofs: " << highToLowMatrix_.rowDofNosLocal << ", targetValues: " << targetValues;
   }
 }
 
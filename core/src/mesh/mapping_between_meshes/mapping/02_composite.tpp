@@ -15,9 +15,9 @@ MappingBetweenMeshes<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,
 MappingBetweenMeshes(std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,BasisFunctionType>> functionSpaceSource,
                      std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
                      double xiTolerance, bool enableWarnings, bool compositeUseOnlyInitializedMappings,
-                     bool isEnabledFixUnmappedDofs) :
+                     bool isEnabledFixUnmappedDofs, bool useSpatialIndex) :
   MappingBetweenMeshesImplementation<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,BasisFunctionType>, FunctionSpaceTargetType>(
-    functionSpaceSource, functionSpaceTarget, xiTolerance, enableWarnings, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs)
+    functionSpaceSource, functionSpaceTarget, xiTolerance, enableWarnings, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs, useSpatialIndex)
 {
   if (compositeUseOnlyInitializedMappings)
   {
@@ -4,13 +4,26 @@
 #include "mesh/structured_regular_fixed.h"
 #include "mesh/unstructured_deformable.h"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <sstream>
+
 namespace Mesh
 {
 
 Manager::Manager(PythonConfig specificSettings) :
-  partitionManager_(nullptr), specificSettings_(specificSettings), numberAnonymousMeshes_(0)
+  partitionManager_(nullptr), specificSettings_(specificSettings), numberAnonymousMeshes_(0),
+  nodeSharedGeometryFromFile_(false), nodeSharedGeometryWindow_(MPI_WIN_NULL), nodeSharedGeometry_(nullptr), nNodeSharedMeshesNotCreated_(-1)
 {
   LOG(TRACE) << "MeshManager constructor";
+
+  // parse if node positions from files should be loaded only once per compute node
+  if (specificSettings_.pyObject())
+  {
+    nodeSharedGeometryFromFile_ = specificSettings_.getOptionBool("nodeSharedGeometryFromFile", false);
+  }
   storePreconfiguredMeshes();
 }
 
@@ -156,6 +169,14 @@ void Manager::loadGeometryFromFile()
 
     LOG(DEBUG) << "openFileName: " << openFileName;
 
+    // load the node positions only once per compute node, if enabled
+    if (nodeSharedGeometryFromFile_)
+    {
+      loadGeometryFromFileNodeShared(openFileName);
+      Control::PerformanceMeasurement::stop("durationReadGeometry");
+      return;
+    }
+
     // MPI-reduce maximum number of times (number of meshes) to read
     int nTimesInFile = 0;
     for (std::map<std::string, NodePositionsFromFile>::iterator iter = nodePositionsFromFile_.begin();
@@ -252,6 +273,270 @@ void Manager::loadGeometryFromFile()
   Control::PerformanceMeasurement::stop("durationReadGeometry");
 }
 
+void Manager::loadGeometryFromFileNodeShared(std::string filename)
+{
+  // create a communicator of all ranks that share the memory of the own compute node
+  MPI_Comm nodeCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, DihuContext::ownRankNoCommWorld(), MPI_INFO_NULL, &nodeCommunicator), "MPI_Comm_split_type");
+
+  int ownRankNoNode = 0;
+  int nRanksNode = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(nodeCommunicator, &ownRankNoNode), "MPI_Comm_rank");
+  MPIUtility::handleReturnValue(MPI_Comm_size(nodeCommunicator, &nRanksNode), "MPI_Comm_size");
+
+  // collect the chunks of all meshes that are stored in the file, as consecutive (offset in the file, number of double values)
+  std::vector<long long> chunks;
+  for (std::pair<const std::string, NodePositionsFromFile> &nodePositionsFromFile : nodePositionsFromFile_)
+  {
+    if (nodePositionsFromFile.second.filename != filename)
+      continue;
+
+    for (const std::pair<MPI_Offset,int> &chunk : nodePositionsFromFile.second.chunks)
+    {
+      chunks.push_back(chunk.first);
+      chunks.push_back(chunk.second*3);
+    }
+  }
+
+  // gather the chunks of all ranks of the compute node on the first rank of the node
+  int nChunkEntries = chunks.size();
+  std::vector<int> nChunkEntriesOnRanks(nRanksNode, 0);
+  MPIUtility::handleReturnValue(MPI_Gather(&nChunkEntries, 1, MPI_INT, nChunkEntriesOnRanks.data(), 1, MPI_INT, 0, nodeCommunicator), "MPI_Gather");
+
+  std::vector<int> chunkEntriesOffsets(nRanksNode, 0);
+  std::vector<int> nPositionsOnRanks(nRanksNode, 0);
+  std::vector<int> positionsOffsets(nRanksNode, 0);
+  for (int rankNo = 0; rankNo < nRanksNode; rankNo++)
+  {
+    nPositionsOnRanks[rankNo] = nChunkEntriesOnRanks[rankNo] / 2;
+    if (rankNo > 0)
+    {
+      chunkEntriesOffsets[rankNo] = chunkEntriesOffsets[rankNo-1] + nChunkEntriesOnRanks[rankNo-1];
+      positionsOffsets[rankNo] = positionsOffsets[rankNo-1] + nPositionsOnRanks[rankNo-1];
+    }
+  }
+  int nChunkEntriesNode = chunkEntriesOffsets[nRanksNode-1] + nChunkEntriesOnRanks[nRanksNode-1];
+
+  std::vector<long long> chunksOnRanks(ownRankNoNode == 0? nChunkEntriesNode : 0);
+  MPIUtility::handleReturnValue(MPI_Gatherv(chunks.data(), nChunkEntries, MPI_LONG_LONG, chunksOnRanks.data(), nChunkEntriesOnRanks.data(),
+                                            chunkEntriesOffsets.data(), MPI_LONG_LONG, 0, nodeCommunicator), "MPI_Gatherv");
+
+  // on the first rank of the node, merge the chunks that overlap or are adjacent in the file to intervals, which are stored only once,
+  // the intervals are placed in the shared memory segment in the order of their offsets in the file
+  std::map<std::pair<long long,long long>,long long> uniqueChunks;    // (offset in file, number of values) -> position in the segment
+  std::vector<std::array<long long,3>> intervals;                     // (offset of the start in the file, offset of the end in the file, position in the segment)
+  std::vector<long long> positionsOnRanks(ownRankNoNode == 0? nChunkEntriesNode/2 : 0);
+  long long segmentSize = 0;
+  long long nValuesRequestedNode = 0;   // number of values that the ranks of the node would store if every rank kept its own copy
+  if (ownRankNoNode == 0)
+  {
+    for (int i = 0; i < nChunkEntriesNode; i += 2)
+    {
+      uniqueChunks[std::pair<long long,long long>(chunksOnRanks[i], chunksOnRanks[i+1])] = 0;
+      nValuesRequestedNode += chunksOnRanks[i+1];
+    }
+
+    // the unique chunks are sorted by their offsets, a chunk is added to the last interval if it starts inside or at the end of it,
+    // and its values are aligned with the values of the interval, otherwise it starts a new interval
+    std::vector<int> intervalNoOfUniqueChunks;
+    for (const std::pair<const std::pair<long long,long long>,long long> &uniqueChunk : uniqueChunks)
+    {
+      long long chunkBegin = uniqueChunk.first.first;
+      long long chunkEnd = chunkBegin + uniqueChunk.first.second*(long long)sizeof(double);
+
+      if (!intervals.empty() && chunkBegin <= intervals.back()[1] && (chunkBegin - intervals.back()[0]) % (long long)sizeof(double) == 0)
+      {
+        intervals.back()[1] = std::max(intervals.back()[1], chunkEnd);
+      }
+      else
+      {
+        intervals.push_back(std::array<long long,3>({chunkBegin, chunkEnd, 0}));
+      }
+      intervalNoOfUniqueChunks.push_back(intervals.size()-1);
+    }
+
+    for (std::array<long long,3> &interval : intervals)
+    {
+      interval[2] = segmentSize;
+      segmentSize += (interval[1] - interval[0]) / (long long)sizeof(double);
+    }
+
+    // the position of a chunk is relative to the start of its interval
+    int uniqueChunkNo = 0;
+    for (std::pair<const std::pair<long long,long long>,long long> &uniqueChunk : uniqueChunks)
+    {
+      const std::array<long long,3> &interval = intervals[intervalNoOfUniqueChunks[uniqueChunkNo]];
+      uniqueChunk.second = interval[2] + (uniqueChunk.first.first - interval[0]) / (long long)sizeof(double);
+      uniqueChunkNo++;
+    }
+
+    for (int i = 0; i < nChunkEntriesNode; i += 2)
+    {
+      positionsOnRanks[i/2] = uniqueChunks[std::pair<long long,long long>(chunksOnRanks[i], chunksOnRanks[i+1])];
+    }
+  }
+
+  // send the positions in the segment back to the ranks, in the same order as the chunks were gathered
+  std::vector<long long> positions(nChunkEntries/2);
+  MPIUtility::handleReturnValue(MPI_Scatterv(positionsOnRanks.data(), nPositionsOnRanks.data(), positionsOffsets.data(), MPI_LONG_LONG,
+                                             positions.data(), nChunkEntries/2, MPI_LONG_LONG, 0, nodeCommunicator), "MPI_Scatterv");
+
+  // allocate the shared memory segment, only the first rank of the node contributes memory
+  double *ownSegment = nullptr;
+  MPIUtility::handleReturnValue(MPI_Win_allocate_shared((MPI_Aint)(segmentSize*sizeof(double)), sizeof(double), MPI_INFO_NULL, nodeCommunicator,
+                                                        &ownSegment, &nodeSharedGeometryWindow_), "MPI_Win_allocate_shared");
+
+  MPI_Aint segmentSizeBytes = 0;
+  int displacementUnit = 0;
+  MPIUtility::handleReturnValue(MPI_Win_shared_query(nodeSharedGeometryWindow_, 0, &segmentSizeBytes, &displacementUnit, &nodeSharedGeometry_), "MPI_Win_shared_query");
+
+  // create a communicator of the first ranks of all nodes, which read the file
+  MPI_Comm nodeLeadersCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_split(MPI_COMM_WORLD, ownRankNoNode == 0? 0 : MPI_UNDEFINED, DihuContext::ownRankNoCommWorld(), &nodeLeadersCommunicator), "MPI_Comm_split");
+
+  LOG(INFO) << "Read from file \"" << filename << "\" once per compute node, " << segmentSizeBytes / (1024.*1024.) << " MB shared by "
+    << nRanksNode << " ranks on this node.";
+
+  if (ownRankNoNode == 0)
+  {
+    LOG(INFO) << "Node-shared geometry: " << uniqueChunks.size() << " unique chunks in " << intervals.size() << " contiguous intervals, "
+      << segmentSize*sizeof(double) / (1024.*1024.) << " MB on this node instead of " << nValuesRequestedNode*sizeof(double) / (1024.*1024.)
+      << " MB for separate copies on every rank, saving " << (nValuesRequestedNode - segmentSize)*sizeof(double) / (1024.*1024.) << " MB.";
+  }
+
+  MPIUtility::handleReturnValue(MPI_Win_fence(0, nodeSharedGeometryWindow_), "MPI_Win_fence");
+  if (ownRankNoNode == 0)
+  {
+    // read every interval at once, intervals with more values than fit into the count argument of MPI are split,
+    // as (offset in the file, position in the segment, number of values)
+    std::vector<std::array<long long,3>> reads;
+    for (const std::array<long long,3> &interval : intervals)
+    {
+      long long nValuesInterval = (interval[1] - interval[0]) / (long long)sizeof(double);
+      for (long long valueNo = 0; valueNo < nValuesInterval; valueNo += std::numeric_limits<int>::max())
+      {
+        long long nValues = std::min(nValuesInterval - valueNo, (long long)std::numeric_limits<int>::max());
+        reads.push_back(std::array<long long,3>({interval[0] + valueNo*(long long)sizeof(double), interval[2] + valueNo, nValues}));
+      }
+    }
+
+    // the number of reads differs between the nodes, determine the maximum such that all node leaders can read collectively
+    int nReads = reads.size();
+    int nReadsGlobal = 0;
+    MPIUtility::handleReturnValue(MPI_Allreduce(&nReads, &nReadsGlobal, 1, MPI_INT, MPI_MAX, nodeLeadersCommunicator), "MPI_Allreduce");
+
+    LOG(DEBUG) << "read " << intervals.size() << " intervals in " << nReads << " reads, maximum number of reads on a node: " << nReadsGlobal;
+
+    MPI_File fileHandle;
+    MPIUtility::handleReturnValue(MPI_File_open(nodeLeadersCommunicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fileHandle), "MPI_File_open");
+
+    for (int readNo = 0; readNo < nReadsGlobal; readNo++)
+    {
+      if (readNo < nReads)
+      {
+        MPI_Offset offset = reads[readNo][0];
+        int nValues = reads[readNo][2];
+        MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle, offset, nodeSharedGeometry_ + reads[readNo][1], nValues, MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+      }
+      else
+      {
+        // this node has no more data to read, participate in the collective read with an empty read
+        double readBuffer = 0;
+        MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle, 0, &readBuffer, 0, MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+      }
+    }
+
+    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+    MPIUtility::handleReturnValue(MPI_Comm_free(&nodeLeadersCommunicator), "MPI_Comm_free");
+  }
+  MPIUtility::handleReturnValue(MPI_Win_fence(0, nodeSharedGeometryWindow_), "MPI_Win_fence");
+
+  // store the positions of the chunks in the segment for the meshes, the data vectors stay empty
+  int chunkNo = 0;
+  for (std::pair<const std::string, NodePositionsFromFile> &nodePositionsFromFile : nodePositionsFromFile_)
+  {
+    if (nodePositionsFromFile.second.filename != filename)
+      continue;
+
+    for (const std::pair<MPI_Offset,int> &chunk : nodePositionsFromFile.second.chunks)
+    {
+      nodePositionsFromFile.second.nodeSharedChunks.push_back(std::pair<long long,int>(positions[chunkNo], chunk.second*3));
+      chunkNo++;
+    }
+  }
+
+  // The window can be freed as soon as all meshes that use it are created, but MPI_Win_free is collective on the compute node.
+  // This is only safe if all ranks of the node create the same meshes, which is the case if they have the same node-shared meshes.
+  // Otherwise the window is kept until the end of the program.
+  std::stringstream meshNames;
+  int nNodeSharedMeshes = 0;
+  for (std::pair<const std::string, NodePositionsFromFile> &nodePositionsFromFile : nodePositionsFromFile_)
+  {
+    if (!nodePositionsFromFile.second.nodeSharedChunks.empty())
+    {
+      meshNames << nodePositionsFromFile.first << "\n";
+      nNodeSharedMeshes++;
+    }
+  }
+
+  unsigned long long meshNamesHash = std::hash<std::string>()(meshNames.str());
+  std::array<unsigned long long,2> meshesLocal({(unsigned long long)nNodeSharedMeshes, meshNamesHash});
+  std::array<unsigned long long,2> meshesMinimum, meshesMaximum;
+  MPIUtility::handleReturnValue(MPI_Allreduce(meshesLocal.data(), meshesMinimum.data(), 2, MPI_UNSIGNED_LONG_LONG, MPI_MIN, nodeCommunicator), "MPI_Allreduce");
+  MPIUtility::handleReturnValue(MPI_Allreduce(meshesLocal.data(), meshesMaximum.data(), 2, MPI_UNSIGNED_LONG_LONG, MPI_MAX, nodeCommunicator), "MPI_Allreduce");
+
+  if (meshesMinimum == meshesMaximum)
+  {
+    nNodeSharedMeshesNotCreated_ = nNodeSharedMeshes;
+  }
+  else
+  {
+    nNodeSharedMeshesNotCreated_ = -1;
+    LOG(DEBUG) << "The ranks of this compute node use different node-shared meshes, the shared memory window is kept until the end.";
+  }
+
+  // the window keeps its own reference to the group of the node
+  MPIUtility::handleReturnValue(MPI_Comm_free(&nodeCommunicator), "MPI_Comm_free");
+}
+
+void Manager::nodeSharedMeshCreated(std::string meshName)
+{
+  NodePositionsFromFile &nodePositionsFromFile = nodePositionsFromFile_[meshName];
+  if (nodePositionsFromFile.nodeSharedMeshCreated)
+    return;
+
+  nodePositionsFromFile.nodeSharedMeshCreated = true;
+
+  // if the window is not freed early or it was already freed, there is nothing more to do
+  if (nNodeSharedMeshesNotCreated_ <= 0)
+    return;
+
+  nNodeSharedMeshesNotCreated_--;
+
+  // all ranks of the node have now copied their node positions to their meshes, the shared memory is no longer needed
+  if (nNodeSharedMeshesNotCreated_ == 0)
+  {
+    LOG(DEBUG) << "All meshes with node-shared geometry were created, free the shared memory window.";
+    freeNodeSharedGeometry();
+  }
+}
+
+void Manager::freeNodeSharedGeometry()
+{
+  if (nodeSharedGeometryWindow_ == MPI_WIN_NULL)
+    return;
+
+  // the node positions of the meshes that were not yet created are no longer available
+  for (std::pair<const std::string, NodePositionsFromFile> &nodePositionsFromFile : nodePositionsFromFile_)
+  {
+    nodePositionsFromFile.second.nodeSharedChunks.clear();
+  }
+
+  MPIUtility::handleReturnValue(MPI_Win_free(&nodeSharedGeometryWindow_), "MPI_Win_free");
+  nodeSharedGeometry_ = nullptr;
+  nNodeSharedMeshesNotCreated_ = -1;
+}
+
 std::shared_ptr<FunctionSpace::Generic> Manager::
 createGenericFunctionSpace(int nEntries, std::string name)
 {
@@ -303,6 +588,51 @@ void Manager::deleteFunctionSpace(std::string meshName)
     LOG(DEBUG) << "deleteFunctionSpace(" << meshName << ")";
     functionSpaces_.erase(meshName);
   }
+
+  invalidateAssembledMatrices(meshName);
+}
+
+void Manager::invalidateAssembledMatrices(std::string meshName)
+{
+  // remove the assembled matrices of the mesh, their keys start with "<meshName>/"
+  std::string prefix = meshName + "/";
+  for (std::map<std::string, AssembledMatrix>::iterator iter = assembledMatrices_.begin(); iter != assembledMatrices_.end();)
+  {
+    if (iter->first.compare(0, prefix.length(), prefix) == 0)
+    {
+      LOG(DEBUG) << "invalidate assembled matrix \"" << iter->first << "\"";
+      iter = assembledMatrices_.erase(iter);
+    }
+    else
+      iter++;
+  }
+}
+
+void Manager::releaseUnusedAssembledMatrices()
+{
+  double totalMemory = 0;
+  for (std::map<std::string, AssembledMatrix>::iterator iter = assembledMatrices_.begin(); iter != assembledMatrices_.end();)
+  {
+    // the reference held by assembledMatrices_ itself is not counted, an object that uses a shared stiffness matrix without own copy holds two references
+    int nReferences = iter->second.matrix.use_count() - 1;
+
+    if (nReferences == 0)
+    {
+      LOG(DEBUG) << "release assembled matrix \"" << iter->first << "\", it is no longer used";
+      iter = assembledMatrices_.erase(iter);
+      continue;
+    }
+
+    MatInfo info;
+    PetscErrorCode ierr = MatGetInfo(iter->second.petscMatrix, MAT_LOCAL, &info); CHKERRV(ierr);
+    totalMemory += info.memory;
+
+    LOG(DEBUG) << "assembled matrix \"" << iter->first << "\" has " << nReferences << " reference" << (nReferences == 1? "" : "s")
+      << ", local memory: " << info.memory << " bytes";
+    iter++;
+  }
+
+  LOG(DEBUG) << assembledMatrices_.size() << " shared assembled matrices, total local memory: " << totalMemory << " bytes";
 }
 
 } // namespace
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Python.h>  // has to be the first included header
+#include <petscmat.h>
 #include <map>
 
 #include "control/dihu_context.h"
@@ -79,9 +80,29 @@ public:
   //! \param name is the name of the Petsc Vec, used for debugging output.
   std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace::Generic,1>> createGenericFieldVariable(int nEntries, std::string name);
 
-  //! remove a function space if it exists
+  //! remove a function space if it exists, this also removes all assembled matrices that are stored for this mesh
   void deleteFunctionSpace(std::string meshName);
 
+  //! get an assembled matrix (e.g. stiffness or mass matrix) that was previously stored under the given key by storeAssembledMatrix, returns nullptr if there is no such matrix.
+  //! The key has to start with the mesh name, followed by "/", the rest of the key identifies the matrix on this mesh.
+  template<typename PartitionedPetscMatType>
+  std::shared_ptr<PartitionedPetscMatType> assembledMatrix(std::string key);
+
+  //! store an assembled matrix under the given key, such that other objects on the same mesh can use it instead of assembling their own copy
+  template<typename PartitionedPetscMatType>
+  void storeAssembledMatrix(std::string key, std::shared_ptr<PartitionedPetscMatType> matrix);
+
+  //! remove all stored assembled matrices of the given mesh, this has to be called when the geometry of the mesh changes,
+  //! such that objects that are initialized afterwards assemble new matrices, objects that already use the matrices keep them
+  void invalidateAssembledMatrices(std::string meshName);
+
+  //! remove stored assembled matrices that are no longer used by any object, log the number of users and the memory consumption of the remaining matrices
+  void releaseUnusedAssembledMatrices();
+
+  //! free the shared memory window with the node positions that were loaded once per compute node (option "nodeSharedGeometryFromFile"),
+  //! this has to be called collectively on all ranks before MPI is finalized
+  void freeNodeSharedGeometry();
+
   friend class NodePositionsTester;    //< a class used for testing
 
 private:
@@ -95,6 +116,8 @@ private:
     std::string filename;                            //< filename of the file to read
     std::vector<std::pair<MPI_Offset,int>> chunks;   //< pairs of (offset, number of values), where each value corresponds to 3 double values (position x,y,z) in data
     std::vector<double> data;                        //< the values of the node positions
+    std::vector<std::pair<long long,int>> nodeSharedChunks;   //< if the node positions were loaded into the node-shared memory segment, pairs of (position in the segment, number of double values)
+    bool nodeSharedMeshCreated = false;              //< if the mesh was already created from the node positions in the node-shared memory segment
   };
 
   //! store settings for all meshes that are specified in specificSettings_
@@ -103,6 +126,12 @@ private:
   //! resolves the requested geometry data in nodePositionsFromFile_
   void loadGeometryFromFile();
 
+  //! read the node positions from the file only once per compute node into a shared memory window, chunks that are requested by multiple ranks of the node are only stored once
+  void loadGeometryFromFileNodeShared(std::string filename);
+
+  //! count the creation of a mesh whose node positions are in the node-shared memory segment, free the segment after the last of these meshes was created
+  void nodeSharedMeshCreated(std::string meshName);
+
   std::shared_ptr<Partition::Manager> partitionManager_;                //< the partition manager object
   PythonConfig specificSettings_;                                       //< the top level python settings
   
@@ -111,6 +140,17 @@ private:
   std::map<std::string, PythonConfig> meshConfiguration_;               //< the python dicts for the meshes that were defined under "Meshes"
   std::map<std::string, std::shared_ptr<Mesh>> functionSpaces_;         //< the managed function spaces with their string key
   std::map<std::string, NodePositionsFromFile> nodePositionsFromFile_;  //< filename, offset, length, data of nodePosition data specified in a binary file
+  bool nodeSharedGeometryFromFile_;                                     //< if the node positions from file should be loaded only once per compute node into a MPI-3 shared memory window
+  MPI_Win nodeSharedGeometryWindow_;                                    //< the shared memory window of the node positions, MPI_WIN_NULL if it was not created
+  double *nodeSharedGeometry_;                                          //< pointer to the start of the shared memory segment of the node positions
+  int nNodeSharedMeshesNotCreated_;                                     //< number of meshes with node positions in the shared memory segment that were not yet created, -1 if the segment is only freed at the end
+
+  struct AssembledMatrix
+  {
+    std::shared_ptr<void> matrix;                                       //< the PartitionedPetscMat object, shared by all objects that use it, the reference count gives the number of users
+    Mat petscMatrix;                                                    //< the global Petsc Mat of the matrix, only used to report the memory consumption
+  };
+  std::map<std::string, AssembledMatrix> assembledMatrices_;            //< assembled matrices that are shared between objects on the same mesh, with key "<meshName>/<description of the matrix>"
 };
 
 /** Helper class to create the composite meshes
@@ -133,6 +133,26 @@ std::shared_ptr<FunctionSpaceType> Manager::functionSpace(std::string meshName)
 
 //! create a mesh not from python config but directly by calling an appropriate construtor. 
 //! With this e.g. meshes from node positions can be created.
+template<typename PartitionedPetscMatType>
+std::shared_ptr<PartitionedPetscMatType> Manager::assembledMatrix(std::string key)
+{
+  if (assembledMatrices_.find(key) == assembledMatrices_.end())
+    return nullptr;
+
+  return std::static_pointer_cast<PartitionedPetscMatType>(assembledMatrices_[key].matrix);
+}
+
+template<typename PartitionedPetscMatType>
+void Manager::storeAssembledMatrix(std::string key, std::shared_ptr<PartitionedPetscMatType> matrix)
+{
+  LOG(DEBUG) << "store assembled matrix \"" << key << "\"";
+
+  AssembledMatrix assembledMatrix;
+  assembledMatrix.matrix = matrix;
+  assembledMatrix.petscMatrix = matrix->valuesGlobal();
+  assembledMatrices_[key] = assembledMatrix;
+}
+
 template<typename FunctionSpaceType, typename ...Args>
 std::shared_ptr<FunctionSpaceType> Manager::createFunctionSpace(std::string name, Args && ...args)
 {
@@ -149,10 +169,32 @@ std::shared_ptr<FunctionSpaceType> Manager::createFunctionSpace(std::string name
   std::shared_ptr<FunctionSpaceType> functionSpace;
 
   // check if node positions from file are available
+  bool isNodeSharedMesh = false;
   if (nodePositionsFromFile_.find(name) != nodePositionsFromFile_.end())
   {
-    std::vector<double> &nodePositions = nodePositionsFromFile_[name].data;
-    functionSpace = std::make_shared<FunctionSpaceType>(this->partitionManager_, nodePositions, std::forward<Args>(args)...);
+    NodePositionsFromFile &nodePositionsFromFile = nodePositionsFromFile_[name];
+
+    // if the node positions are stored in the node-shared memory segment, collect the chunks of this mesh in a temporary vector
+    if (!nodePositionsFromFile.nodeSharedChunks.empty())
+    {
+      std::vector<double> nodePositions;
+      std::size_t nValues = 0;
+      for (const std::pair<long long,int> &chunk : nodePositionsFromFile.nodeSharedChunks)
+        nValues += chunk.second;
+
+      nodePositions.reserve(nValues);
+      for (const std::pair<long long,int> &chunk : nodePositionsFromFile.nodeSharedChunks)
+      {
+        nodePositions.insert(nodePositions.end(), nodeSharedGeometry_ + chunk.first, nodeSharedGeometry_ + chunk.first + chunk.second);
+      }
+      functionSpace = std::make_shared<FunctionSpaceType>(this->partitionManager_, nodePositions, std::forward<Args>(args)...);
+      isNodeSharedMesh = true;
+    }
+    else
+    {
+      std::vector<double> &nodePositions = nodePositionsFromFile.data;
+      functionSpace = std::make_shared<FunctionSpaceType>(this->partitionManager_, nodePositions, std::forward<Args>(args)...);
+    }
   }
   else
   {
@@ -165,6 +207,10 @@ std::shared_ptr<FunctionSpaceType> Manager::createFunctionSpace(std::string name
 
   functionSpaces_[name] = functionSpace;
 
+  // the mesh has its own copy of the node positions now, the node-shared memory segment may be freed
+  if (isNodeSharedMesh)
+    nodeSharedMeshCreated(name);
+
   VLOG(1) << "mesh nNodes: (local without ghosts: " << functionSpace->nNodesLocalWithoutGhosts()
     << ", with ghosts: " << functionSpace->nNodesLocalWithGhosts() << "), stored under key \"" << name << "\"";
 
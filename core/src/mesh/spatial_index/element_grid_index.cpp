@@ -0,0 +1,246 @@
+#include "mesh/spatial_index/element_grid_index.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "easylogging++.h"
+#include "utility/vector_operators.h"
+
+namespace Mesh
+{
+
+ElementGridIndex::ElementGridIndex() :
+  gridMinimum_({0.0,0.0,0.0}), cellWidth_({1.0,1.0,1.0}), nCells_({1,1,1}), relativeMargin_(0), isBuilt_(false)
+{
+}
+
+void ElementGridIndex::build(const std::vector<BoundingBox> &boundingBoxes, double relativeMargin)
+{
+  const element_no_t nElements = boundingBoxes.size();
+  relativeMargin_ = relativeMargin;
+
+  // store the enlarged boxes, they are enlarged by twice the margin, such that small deformations do not require to reinsert the elements
+  storedBoundingBoxes_.resize(nElements);
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElements; elementNoLocal++)
+  {
+    storedBoundingBoxes_[elementNoLocal] = enlargedBox(boundingBoxes[elementNoLocal], 2*relativeMargin_);
+  }
+
+  // determine the extent of the grid
+  Vec3 gridMaximum = {0.0,0.0,0.0};
+  if (nElements > 0)
+  {
+    gridMinimum_ = storedBoundingBoxes_[0][0];
+    gridMaximum = storedBoundingBoxes_[0][1];
+  }
+  for (const BoundingBox &boundingBox : storedBoundingBoxes_)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      gridMinimum_[i] = std::min(gridMinimum_[i], boundingBox[0][i]);
+      gridMaximum[i] = std::max(gridMaximum[i], boundingBox[1][i]);
+    }
+  }
+
+  // determine the number of cells, such that there is approximately one cell per element,
+  // coordinate directions in which the mesh has no extent, e.g. for 1D fiber meshes, get only one cell
+  Vec3 extent;
+  double maximumExtent = 0;
+  for (int i = 0; i < 3; i++)
+  {
+    extent[i] = gridMaximum[i] - gridMinimum_[i];
+    maximumExtent = std::max(maximumExtent, extent[i]);
+  }
+
+  int nDimensions = 0;
+  double volume = 1;
+  for (int i = 0; i < 3; i++)
+  {
+    if (extent[i] > 1e-12*maximumExtent)
+    {
+      nDimensions++;
+      volume *= extent[i];
+    }
+  }
+
+  nCells_ = {1,1,1};
+  if (nDimensions > 0 && nElements > 0)
+  {
+    const double cellSize = std::pow(volume / nElements, 1.0/nDimensions);
+    for (int i = 0; i < 3; i++)
+    {
+      if (extent[i] > 1e-12*maximumExtent)
+        nCells_[i] = std::max(1, (int)std::ceil(extent[i] / cellSize));
+    }
+
+    // limit the number of cells for very elongated meshes
+    while ((double)nCells_[0]*nCells_[1]*nCells_[2] > 8.0*nElements + 8)
+    {
+      int coordinateDirection = std::max_element(nCells_.begin(), nCells_.end()) - nCells_.begin();
+      nCells_[coordinateDirection] = (nCells_[coordinateDirection] + 1) / 2;
+    }
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    cellWidth_[i] = (extent[i] > 1e-12*maximumExtent && maximumExtent > 0? extent[i] / nCells_[i] : 1.0);
+  }
+
+  // insert all elements
+  cells_.clear();
+  cells_.resize(nCells_[0]*nCells_[1]*nCells_[2]);
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElements; elementNoLocal++)
+  {
+    insertElement(elementNoLocal);
+  }
+
+  isBuilt_ = true;
+
+  VLOG(1) << "ElementGridIndex::build, " << nElements << " elements, grid " << nCells_ << " cells, minimum: " << gridMinimum_
+    << ", cell width: " << cellWidth_;
+}
+
+int ElementGridIndex::update(const std::vector<BoundingBox> &boundingBoxes)
+{
+  const element_no_t nElements = boundingBoxes.size();
+
+  if (!isBuilt_ || nElements != (element_no_t)storedBoundingBoxes_.size())
+  {
+    build(boundingBoxes, relativeMargin_);
+    return nElements;
+  }
+
+  // determine the elements whose box with the required margin is no longer contained in the stored box
+  std::vector<element_no_t> movedElementNos;
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElements; elementNoLocal++)
+  {
+    BoundingBox requiredBox = enlargedBox(boundingBoxes[elementNoLocal], relativeMargin_);
+    const BoundingBox &storedBox = storedBoundingBoxes_[elementNoLocal];
+
+    for (int i = 0; i < 3; i++)
+    {
+      if (requiredBox[0][i] < storedBox[0][i] || requiredBox[1][i] > storedBox[1][i])
+      {
+        movedElementNos.push_back(elementNoLocal);
+        break;
+      }
+    }
+  }
+
+  // if the geometry changed too much, create the grid again, because also the extent of the grid has to be adjusted
+  if ((element_no_t)movedElementNos.size() > nElements/2)
+  {
+    build(boundingBoxes, relativeMargin_);
+    return nElements;
+  }
+
+  for (element_no_t elementNoLocal : movedElementNos)
+  {
+    removeElement(elementNoLocal);
+    storedBoundingBoxes_[elementNoLocal] = enlargedBox(boundingBoxes[elementNoLocal], 2*relativeMargin_);
+    insertElement(elementNoLocal);
+  }
+
+  VLOG(1) << "ElementGridIndex::update, reinserted " << movedElementNos.size() << "/" << nElements << " elements";
+  return movedElementNos.size();
+}
+
+void ElementGridIndex::getCandidateElements(const Vec3 &point, std::vector<element_no_t> &elementNos) const
+{
+  elementNos.clear();
+  if (!isBuilt_)
+    return;
+
+  int cellNo = cellCoordinate(point[0], 0) + nCells_[0]*(cellCoordinate(point[1], 1) + nCells_[1]*cellCoordinate(point[2], 2));
+
+  for (element_no_t elementNoLocal : cells_[cellNo])
+  {
+    const BoundingBox &storedBox = storedBoundingBoxes_[elementNoLocal];
+    if (storedBox[0][0] <= point[0] && point[0] <= storedBox[1][0]
+      && storedBox[0][1] <= point[1] && point[1] <= storedBox[1][1]
+      && storedBox[0][2] <= point[2] && point[2] <= storedBox[1][2])
+    {
+      elementNos.push_back(elementNoLocal);
+    }
+  }
+
+  // elements that were reinserted by update() are at the end of the cell lists
+  std::sort(elementNos.begin(), elementNos.end());
+}
+
+bool ElementGridIndex::isBuilt() const
+{
+  return isBuilt_;
+}
+
+element_no_t ElementGridIndex::nElements() const
+{
+  return storedBoundingBoxes_.size();
+}
+
+double ElementGridIndex::relativeMargin() const
+{
+  return relativeMargin_;
+}
+
+ElementGridIndex::BoundingBox ElementGridIndex::enlargedBox(const BoundingBox &boundingBox, double factor) const
+{
+  // use the same margin in all coordinate directions, such that also flat elements, e.g. of 2D meshes in 3D space, get a margin
+  double size = 0;
+  for (int i = 0; i < 3; i++)
+  {
+    size = std::max(size, boundingBox[1][i] - boundingBox[0][i]);
+  }
+
+  BoundingBox result = boundingBox;
+  for (int i = 0; i < 3; i++)
+  {
+    result[0][i] -= factor*size;
+    result[1][i] += factor*size;
+  }
+  return result;
+}
+
+int ElementGridIndex::cellCoordinate(double coordinate, int coordinateDirection) const
+{
+  int index = (int)std::floor((coordinate - gridMinimum_[coordinateDirection]) / cellWidth_[coordinateDirection]);
+  return std::min(std::max(index, 0), nCells_[coordinateDirection]-1);
+}
+
+void ElementGridIndex::insertElement(element_no_t elementNoLocal)
+{
+  const BoundingBox &storedBox = storedBoundingBoxes_[elementNoLocal];
+
+  for (int k = cellCoordinate(storedBox[0][2], 2); k <= cellCoordinate(storedBox[1][2], 2); k++)
+  {
+    for (int j = cellCoordinate(storedBox[0][1], 1); j <= cellCoordinate(storedBox[1][1], 1); j++)
+    {
+      for (int i = cellCoordinate(storedBox[0][0], 0); i <= cellCoordinate(storedBox[1][0], 0); i++)
+      {
+        cells_[i + nCells_[0]*(j + nCells_[1]*k)].push_back(elementNoLocal);
+      }
+    }
+  }
+}
+
+void ElementGridIndex::removeElement(element_no_t elementNoLocal)
+{
+  const BoundingBox &storedBox = storedBoundingBoxes_[elementNoLocal];
+
+  for (int k = cellCoordinate(storedBox[0][2], 2); k <= cellCoordinate(storedBox[1][2], 2); k++)
+  {
+    for (int j = cellCoordinate(storedBox[0][1], 1); j <= cellCoordinate(storedBox[1][1], 1); j++)
+    {
+      for (int i = cellCoordinate(storedBox[0][0], 0); i <= cellCoordinate(storedBox[1][0], 0); i++)
+      {
+        std::vector<element_no_t> &cell = cells_[i + nCells_[0]*(j + nCells_[1]*k)];
+        std::vector<element_no_t>::iterator iter = std::find(cell.begin(), cell.end(), elementNoLocal);
+        if (iter != cell.end())
+          cell.erase(iter);
+      }
+    }
+  }
+}
+
+}  // namespace
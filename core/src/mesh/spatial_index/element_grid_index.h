@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <array>
+#include <vector>
+
+#include "control/types.h"
+
+namespace Mesh
+{
+
+/** A uniform grid over the bounding boxes of the local elements of a mesh, to find the elements that can contain a given point.
+ *  Every grid cell stores the elements whose bounding box overlaps the cell. The number of cells is in the order of the number of elements,
+ *  such that a query only has to check a few elements, independent of the size of the mesh.
+ *
+ *  The stored bounding boxes are enlarged by a margin. When the geometry changes, update() only reinserts the elements
+ *  whose new bounding box is no longer contained in the stored box. Points outside of the grid are assigned to the nearest cell,
+ *  therefore the index stays valid if elements move out of the initial extent, only the efficiency decreases.
+ */
+class ElementGridIndex
+{
+public:
+
+  typedef std::array<Vec3,2> BoundingBox;   //< minimum and maximum coordinates of a box
+
+  //! constructor
+  ElementGridIndex();
+
+  //! create the grid for the given bounding boxes of the elements, boundingBoxes[elementNoLocal] = {min, max},
+  //! relativeMargin is the fraction of the size of a box by which it is enlarged on each side
+  void build(const std::vector<BoundingBox> &boundingBoxes, double relativeMargin);
+
+  //! update the grid for new bounding boxes of the same elements, after the geometry has changed,
+  //! only the elements that moved out of their stored box are reinserted, if this are too many, the grid is created again
+  //! @return the number of elements that were reinserted
+  int update(const std::vector<BoundingBox> &boundingBoxes);
+
+  //! get the elements whose stored bounding box contains the point, ordered by element no
+  void getCandidateElements(const Vec3 &point, std::vector<element_no_t> &elementNos) const;
+
+  //! if build() has been called
+  bool isBuilt() const;
+
+  //! the number of elements in the index
+  element_no_t nElements() const;
+
+  //! the relative margin with which the index was built
+  double relativeMargin() const;
+
+private:
+
+  //! get the enlarged box of the given box
+  BoundingBox enlargedBox(const BoundingBox &boundingBox, double factor) const;
+
+  //! get the index of the cell in the given coordinate direction that contains the coordinate, clamped to the grid
+  int cellCoordinate(double coordinate, int coordinateDirection) const;
+
+  //! add the element to all cells that overlap its stored box
+  void insertElement(element_no_t elementNoLocal);
+
+  //! remove the element from all cells that overlap its stored box
+  void removeElement(element_no_t elementNoLocal);
+
+  Vec3 gridMinimum_;                                 //< lower corner of the grid
+  Vec3 cellWidth_;                                   //< width of a cell in every coordinate direction
+  std::array<int,3> nCells_;                         //< number of cells in every coordinate direction
+  std::vector<std::vector<element_no_t>> cells_;     //< the element nos for every cell, x index fastest
+  std::vector<BoundingBox> storedBoundingBoxes_;     //< the enlarged bounding box of every element, with which it is stored in the cells
+  double relativeMargin_;                            //< fraction of the box size by which the stored bounding boxes are enlarged on each side
+  bool isBuilt_;                                     //< if the grid has been created
+};
+
+}  // namespace
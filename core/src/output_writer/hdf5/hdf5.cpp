@@ -0,0 +1,752 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <mpi.h>
+
+#include "easylogging++.h"
+#include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include "utility/string_utility.h"
+#include "utility/vector_operators.h"
+
+namespace OutputWriter
+{
+
+#ifdef HAVE_HDF5
+HDF5::HDF5(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset), file_(-1), timeDataset_(-1), transferProperties_(-1), xdmfClosingTagsPosition_(0)
+{
+  compressionLevel_ = specificSettings_.getOptionInt("compressionLevel", 4, PythonUtility::NonNegative);
+  if (compressionLevel_ > 9)
+  {
+    LOG(WARNING) << specificSettings_ << "[\"compressionLevel\"] is " << compressionLevel_ << ", but the maximum gzip compression level is 9. Using 9.";
+    compressionLevel_ = 9;
+  }
+  chunkSize_ = specificSettings_.getOptionInt("chunkSize", 65536, PythonUtility::Positive);
+}
+
+HDF5::~HDF5()
+{
+  // the file can only be closed while MPI is still active, otherwise HDF5 has already closed it during MPI_Finalize
+  int mpiFinalized = 0;
+  MPI_Finalized(&mpiFinalized);
+
+  if (!mpiFinalized)
+    closeHdf5File();
+}
+
+void HDF5::collectGlobalMeshes()
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  int nRanks = this->rankSubset_->size();
+
+  // serialize the description of the local meshes, one item per line: mesh name, dimensionality, number of field variables, then name and number of components of each field variable
+  std::stringstream localDescription;
+  for (std::string meshName : meshNames_)
+  {
+    const PolyDataPropertiesForMesh &properties = meshes_[meshName].properties;
+    localDescription << meshName << "\n" << properties.dimensionality << "\n" << properties.pointDataArrays.size() << "\n";
+    for (const PolyDataPropertiesForMesh::DataArrayName &dataArray : properties.pointDataArrays)
+    {
+      localDescription << dataArray.name << "\n" << dataArray.nComponents << "\n";
+    }
+  }
+  std::string localString = localDescription.str();
+
+  // gather the descriptions of all ranks
+  int localLength = localString.length();
+  std::vector<int> lengths(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&localLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, mpiCommunicator), "MPI_Allgather");
+
+  std::vector<int> offsets(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+  {
+    offsets[rankNo] = offsets[rankNo-1] + lengths[rankNo-1];
+  }
+  std::vector<char> globalDescription(offsets[nRanks-1] + lengths[nRanks-1] + 1, '\0');
+
+  MPIUtility::handleReturnValue(MPI_Allgatherv(localString.data(), localLength, MPI_CHAR,
+                                               globalDescription.data(), lengths.data(), offsets.data(), MPI_CHAR, mpiCommunicator), "MPI_Allgatherv");
+
+  // parse the descriptions in the order of the ranks, this gives the same field variables in the same order on every rank
+  std::map<std::string,PolyDataPropertiesForMesh> globalMeshes;
+  std::istringstream stream(std::string(globalDescription.data()));
+  std::string meshName;
+  while (std::getline(stream, meshName))
+  {
+    std::string line;
+    std::getline(stream, line);
+    int dimensionality = atoi(line.c_str());
+    std::getline(stream, line);
+    int nDataArrays = atoi(line.c_str());
+
+    PolyDataPropertiesForMesh &properties = globalMeshes[meshName];
+    properties.dimensionality = dimensionality;
+
+    for (int dataArrayNo = 0; dataArrayNo < nDataArrays; dataArrayNo++)
+    {
+      PolyDataPropertiesForMesh::DataArrayName dataArray;
+      std::getline(stream, dataArray.name);
+      std::getline(stream, line);
+      dataArray.nComponents = atoi(line.c_str());
+
+      // field variables can occur multiple times, e.g. if they are contained in the output of multiple solvers or on multiple ranks
+      std::vector<PolyDataPropertiesForMesh::DataArrayName> &pointDataArrays = properties.pointDataArrays;
+      if (std::find_if(pointDataArrays.begin(), pointDataArrays.end(),
+                       [&dataArray](const PolyDataPropertiesForMesh::DataArrayName &entry){return entry.name == dataArray.name;}) == pointDataArrays.end())
+      {
+        pointDataArrays.push_back(dataArray);
+      }
+    }
+  }
+
+  // add the meshes that are not present on the own rank, without local points and cells
+  meshNames_.clear();
+  for (std::pair<const std::string,PolyDataPropertiesForMesh> &globalMesh : globalMeshes)
+  {
+    meshNames_.push_back(globalMesh.first);
+
+    if (meshes_.find(globalMesh.first) == meshes_.end())
+    {
+      PolyDataPropertiesForMesh &properties = meshes_[globalMesh.first].properties;
+      properties.dimensionality = globalMesh.second.dimensionality;
+      properties.nPointsLocal = 0;
+      properties.nCellsLocal = 0;
+      properties.nPointsGlobal = 0;
+      properties.nCellsGlobal = 0;
+      properties.nNodesLocalWithGhosts.assign(properties.dimensionality, 0);
+    }
+    meshes_[globalMesh.first].properties.pointDataArrays = globalMesh.second.pointDataArrays;
+  }
+
+  LOG(DEBUG) << "HDF5: global meshes: " << meshNames_;
+}
+
+void HDF5::combineMeshes()
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  int ownRankNo = this->rankSubset_->ownRankNo();
+  const int nMeshes = meshNames_.size();
+
+  // compute the global sizes and the offsets of the own rank of all meshes at once, the ghost points are stored on every rank like in the Paraview output
+  std::vector<global_no_t> localSizes(2*nMeshes);
+  std::vector<global_no_t> globalSizes(2*nMeshes, 0);
+  std::vector<global_no_t> sizesPreviousRanks(2*nMeshes, 0);
+  for (int meshNo = 0; meshNo < nMeshes; meshNo++)
+  {
+    const PolyDataPropertiesForMesh &properties = meshes_[meshNames_[meshNo]].properties;
+    localSizes[2*meshNo+0] = properties.nPointsLocal;
+    localSizes[2*meshNo+1] = properties.nCellsLocal;
+  }
+
+  MPIUtility::handleReturnValue(MPI_Allreduce(localSizes.data(), globalSizes.data(), 2*nMeshes, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+  MPIUtility::handleReturnValue(MPI_Exscan(localSizes.data(), sizesPreviousRanks.data(), 2*nMeshes, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+
+  // the result of MPI_Exscan is undefined on the first rank
+  if (ownRankNo == 0)
+    std::fill(sizesPreviousRanks.begin(), sizesPreviousRanks.end(), 0);
+
+  // two meshes can be combined if they have the same field variables in the same order
+  auto haveSameFieldVariables = [](const std::vector<PolyDataPropertiesForMesh::DataArrayName> &pointDataArrays1,
+                                   const std::vector<PolyDataPropertiesForMesh::DataArrayName> &pointDataArrays2)
+  {
+    if (pointDataArrays1.size() != pointDataArrays2.size())
+      return false;
+
+    for (int i = 0; i < pointDataArrays1.size(); i++)
+    {
+      if (pointDataArrays1[i].name != pointDataArrays2[i].name || pointDataArrays1[i].nComponents != pointDataArrays2[i].nComponents)
+        return false;
+    }
+    return true;
+  };
+
+  // assign the meshes to the combined meshes, the meshes are processed in the same order on all ranks, therefore all ranks get the same groups
+  combinedMeshes_.clear();
+  for (int meshNo = 0; meshNo < nMeshes; meshNo++)
+  {
+    std::string meshName = meshNames_[meshNo];
+    MeshInfo &meshInfo = meshes_[meshName];
+    const PolyDataPropertiesForMesh &properties = meshInfo.properties;
+
+    meshInfo.nPointsGlobal = globalSizes[2*meshNo+0];
+    meshInfo.nCellsGlobal = globalSizes[2*meshNo+1];
+
+    std::vector<CombinedMeshes>::iterator combinedMeshesIter = std::find_if(combinedMeshes_.begin(), combinedMeshes_.end(),
+      [&](const CombinedMeshes &combinedMeshes)
+      {
+        return combinedMeshes.dimensionality == properties.dimensionality && haveSameFieldVariables(combinedMeshes.pointDataArrays, properties.pointDataArrays);
+      });
+
+    // if there are no meshes yet with the same dimensionality and field variables, start a new group
+    if (combinedMeshesIter == combinedMeshes_.end())
+    {
+      int nGroupsOfDimensionality = std::count_if(combinedMeshes_.begin(), combinedMeshes_.end(),
+        [&properties](const CombinedMeshes &combinedMeshes){return combinedMeshes.dimensionality == properties.dimensionality;});
+
+      std::stringstream name;
+      name << properties.dimensionality << "D";
+      if (nGroupsOfDimensionality > 0)
+        name << "_" << nGroupsOfDimensionality;
+
+      CombinedMeshes combinedMeshes;
+      combinedMeshes.name = name.str();
+      combinedMeshes.dimensionality = properties.dimensionality;
+      combinedMeshes.pointDataArrays = properties.pointDataArrays;
+      combinedMeshes.nPointsGlobal = 0;
+      combinedMeshes.nCellsGlobal = 0;
+      combinedMeshes.group = -1;
+      combinedMeshes.geometryDataset = -1;
+
+      if (properties.dimensionality == 1)
+        combinedMeshes.nNodesPerCell = 2;
+      else if (properties.dimensionality == 2)
+        combinedMeshes.nNodesPerCell = 4;
+      else
+        combinedMeshes.nNodesPerCell = 8;
+
+      combinedMeshes_.push_back(combinedMeshes);
+      combinedMeshesIter = combinedMeshes_.end()-1;
+    }
+
+    // the mesh is stored after the previous meshes of the group, within the mesh the local parts of the ranks are ordered by rank
+    meshInfo.pointOffset = combinedMeshesIter->nPointsGlobal + sizesPreviousRanks[2*meshNo+0];
+    meshInfo.cellOffset = combinedMeshesIter->nCellsGlobal + sizesPreviousRanks[2*meshNo+1];
+
+    combinedMeshesIter->nPointsGlobal += meshInfo.nPointsGlobal;
+    combinedMeshesIter->nCellsGlobal += meshInfo.nCellsGlobal;
+    combinedMeshesIter->meshNames.push_back(meshName);
+  }
+
+  for (const CombinedMeshes &combinedMeshes : combinedMeshes_)
+  {
+    LOG(DEBUG) << "HDF5: group \"" << combinedMeshes.name << "\" combines meshes " << combinedMeshes.meshNames
+      << ", " << combinedMeshes.nPointsGlobal << " points, " << combinedMeshes.nCellsGlobal << " cells";
+  }
+}
+
+void HDF5::openHdf5File(std::string filename)
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  int ownRankNo = this->rankSubset_->ownRankNo();
+
+  LOG(DEBUG) << "HDF5: create file \"" << filename << "\" with meshes " << meshNames_;
+
+  // let rank 0 create the directory if necessary, the file itself is truncated by H5Fcreate
+  if (ownRankNo == 0)
+  {
+    std::ofstream file;
+    Generic::openFile(file, filename);
+    file.close();
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(mpiCommunicator), "MPI_Barrier");
+
+  // create the file collectively with the MPI-IO driver
+  hid_t fileAccessProperties = H5Pcreate(H5P_FILE_ACCESS);
+  checkError(H5Pset_fapl_mpio(fileAccessProperties, mpiCommunicator, MPI_INFO_NULL), "H5Pset_fapl_mpio");
+
+  file_ = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccessProperties);
+  H5Pclose(fileAccessProperties);
+
+  if (file_ < 0)
+  {
+    LOG(ERROR) << "Could not create HDF5 file \"" << filename << "\".";
+    return;
+  }
+  hdf5Filename_ = filename;
+
+  // all data is written collectively, this is required for compressed datasets
+  transferProperties_ = H5Pcreate(H5P_DATASET_XFER);
+  checkError(H5Pset_dxpl_mpio(transferProperties_, H5FD_MPIO_COLLECTIVE), "H5Pset_dxpl_mpio");
+
+  // create the dataset for the simulation times
+  hsize_t dimensions[1] = {0};
+  hsize_t maximumDimensions[1] = {H5S_UNLIMITED};
+  hsize_t chunkDimensions[1] = {1024};
+
+  hid_t dataspace = H5Screate_simple(1, dimensions, maximumDimensions);
+  hid_t creationProperties = H5Pcreate(H5P_DATASET_CREATE);
+  checkError(H5Pset_chunk(creationProperties, 1, chunkDimensions), "H5Pset_chunk");
+
+  timeDataset_ = H5Dcreate2(file_, "time", H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, creationProperties, H5P_DEFAULT);
+  if (timeDataset_ < 0)
+    LOG(ERROR) << "Could not create dataset \"time\" in HDF5 file \"" << filename << "\".";
+
+  H5Pclose(creationProperties);
+  H5Sclose(dataspace);
+
+  // create groups and datasets for all combined meshes
+  for (CombinedMeshes &combinedMeshes : combinedMeshes_)
+  {
+    combinedMeshes.group = H5Gcreate2(file_, combinedMeshes.name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (combinedMeshes.group < 0)
+      LOG(ERROR) << "Could not create group \"" << combinedMeshes.name << "\" in HDF5 file \"" << filename << "\".";
+
+    combinedMeshes.geometryDataset = createTimeDependentDataset(combinedMeshes.group, "geometry", combinedMeshes.nPointsGlobal, 3);
+
+    // the field variables are unique and in the same order on all ranks, this was ensured by collectGlobalMeshes
+    for (const PolyDataPropertiesForMesh::DataArrayName &dataArray : combinedMeshes.pointDataArrays)
+    {
+      combinedMeshes.datasets[dataArray.name] = createTimeDependentDataset(combinedMeshes.group, dataArray.name, combinedMeshes.nPointsGlobal, dataArray.nComponents);
+    }
+
+    // the connectivity and the offsets of the meshes do not change over time, they are only written once
+    writeConnectivity(combinedMeshes);
+    writeMeshOffsets(combinedMeshes);
+  }
+}
+
+void HDF5::closeHdf5File()
+{
+  if (file_ < 0)
+    return;
+
+  for (CombinedMeshes &combinedMeshes : combinedMeshes_)
+  {
+    for (std::pair<const std::string,hid_t> &dataset : combinedMeshes.datasets)
+    {
+      H5Dclose(dataset.second);
+    }
+    H5Dclose(combinedMeshes.geometryDataset);
+    H5Gclose(combinedMeshes.group);
+  }
+  combinedMeshes_.clear();
+  meshes_.clear();
+
+  H5Dclose(timeDataset_);
+  H5Pclose(transferProperties_);
+  checkError(H5Fclose(file_), "H5Fclose");
+
+  file_ = -1;
+  timeDataset_ = -1;
+  transferProperties_ = -1;
+}
+
+hid_t HDF5::createTimeDependentDataset(hid_t location, std::string name, global_no_t nPointsGlobal, int nComponents)
+{
+  hsize_t dimensions[3] = {0, nPointsGlobal, (hsize_t)nComponents};
+  hsize_t maximumDimensions[3] = {H5S_UNLIMITED, nPointsGlobal, (hsize_t)nComponents};
+
+  // one chunk contains the values of chunkSize_ points of a single output
+  hsize_t chunkDimensions[3] = {1, std::max((hsize_t)1, std::min((hsize_t)chunkSize_, (hsize_t)nPointsGlobal)), (hsize_t)nComponents};
+
+  hid_t dataspace = H5Screate_simple(3, dimensions, maximumDimensions);
+  hid_t creationProperties = H5Pcreate(H5P_DATASET_CREATE);
+  checkError(H5Pset_chunk(creationProperties, 3, chunkDimensions), "H5Pset_chunk");
+
+  // the chunks are always completely written, so there is no need to initialize them with the fill value
+  checkError(H5Pset_fill_time(creationProperties, H5D_FILL_TIME_NEVER), "H5Pset_fill_time");
+
+  if (compressionLevel_ > 0)
+  {
+    // the shuffle filter groups the bytes of the doubles by significance, which improves the compression ratio
+    checkError(H5Pset_shuffle(creationProperties), "H5Pset_shuffle");
+    checkError(H5Pset_deflate(creationProperties, compressionLevel_), "H5Pset_deflate");
+  }
+
+  hid_t dataset = H5Dcreate2(location, name.c_str(), H5T_NATIVE_DOUBLE, dataspace, H5P_DEFAULT, creationProperties, H5P_DEFAULT);
+  if (dataset < 0)
+    LOG(ERROR) << "Could not create dataset \"" << name << "\" in HDF5 file \"" << hdf5Filename_ << "\".";
+
+  H5Pclose(creationProperties);
+  H5Sclose(dataspace);
+
+  return dataset;
+}
+
+void HDF5::writeTimeStep(hid_t dataset, const std::vector<double> &values, const std::vector<std::pair<global_no_t,global_no_t>> &pointRanges, int nComponents)
+{
+  const hsize_t outputNo = outputTimes_.size()-1;
+
+  global_no_t nPointsLocal = 0;
+  for (const std::pair<global_no_t,global_no_t> &pointRange : pointRanges)
+  {
+    nPointsLocal += pointRange.second;
+  }
+
+  // the write is collective, therefore every rank has to write exactly its share, even if the number of values does not match
+  const double *data = values.data();
+  std::vector<double> buffer;
+  if (values.size() != nPointsLocal*nComponents)
+  {
+    LOG(ERROR) << "HDF5: Number of values to write (" << values.size() << ") does not match number of points (" << nPointsLocal
+      << ") times number of components (" << nComponents << ").";
+    buffer = values;
+    buffer.resize(nPointsLocal*nComponents, 0.0);
+    data = buffer.data();
+  }
+
+  // HDF5 needs a valid pointer even if nothing is written
+  double dummy = 0;
+  if (nPointsLocal == 0)
+    data = &dummy;
+
+  // extend the time dimension of the dataset by the current output
+  hid_t fileDataspace = H5Dget_space(dataset);
+  hsize_t dimensions[3];
+  H5Sget_simple_extent_dims(fileDataspace, dimensions, NULL);
+  H5Sclose(fileDataspace);
+
+  dimensions[0] = outputNo+1;
+  checkError(H5Dset_extent(dataset, dimensions), "H5Dset_extent");
+
+  // select the local parts of all meshes of the current output, they are in increasing order in the file like the values in memory
+  fileDataspace = H5Dget_space(dataset);
+  hsize_t memoryDimensions[1] = {nPointsLocal*nComponents};
+  hid_t memoryDataspace = H5Screate_simple(1, memoryDimensions, NULL);
+
+  if (nPointsLocal == 0)
+  {
+    H5Sselect_none(fileDataspace);
+    H5Sselect_none(memoryDataspace);
+  }
+  else
+  {
+    H5S_seloper_t selectOperation = H5S_SELECT_SET;
+    for (const std::pair<global_no_t,global_no_t> &pointRange : pointRanges)
+    {
+      hsize_t start[3] = {outputNo, pointRange.first, 0};
+      hsize_t count[3] = {1, pointRange.second, (hsize_t)nComponents};
+      checkError(H5Sselect_hyperslab(fileDataspace, selectOperation, start, NULL, count, NULL), "H5Sselect_hyperslab");
+      selectOperation = H5S_SELECT_OR;
+    }
+  }
+
+  checkError(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memoryDataspace, fileDataspace, transferProperties_, data), "H5Dwrite");
+
+  H5Sclose(memoryDataspace);
+  H5Sclose(fileDataspace);
+}
+
+void HDF5::writeConnectivity(CombinedMeshes &combinedMeshes)
+{
+  const int nNodesPerCell = combinedMeshes.nNodesPerCell;
+
+  // the connectivity of the local cells of all meshes, in global point numbering of the combined meshes
+  std::vector<int> connectivityValues;
+  std::vector<std::pair<global_no_t,global_no_t>> cellRanges;
+
+  for (std::string meshName : combinedMeshes.meshNames)
+  {
+    const MeshInfo &meshInfo = meshes_[meshName];
+    const PolyDataPropertiesForMesh &properties = meshInfo.properties;
+    const int offset = meshInfo.pointOffset;
+    const std::vector<node_no_t> &nNodes = properties.nNodesLocalWithGhosts;
+
+    // the mesh is not present on the own rank or has no local cells
+    if (properties.nCellsLocal == 0)
+      continue;
+
+    cellRanges.push_back(std::make_pair(meshInfo.cellOffset, properties.nCellsLocal));
+
+    const int nConnectivityValuesBefore = connectivityValues.size();
+    connectivityValues.reserve(nConnectivityValuesBefore + properties.nCellsLocal * nNodesPerCell);
+
+    if (!properties.unstructuredMeshConnectivityValues.empty())
+    {
+      // for unstructured meshes, the node numbers of the cells are given
+      for (int nodeNo : properties.unstructuredMeshConnectivityValues)
+      {
+        connectivityValues.push_back(offset + nodeNo);
+      }
+    }
+    else if (properties.dimensionality == 1)
+    {
+      for (int indexX = 0; indexX < nNodes[0]-1; indexX++)
+      {
+        connectivityValues.push_back(offset + indexX);
+        connectivityValues.push_back(offset + indexX + 1);
+      }
+    }
+    else if (properties.dimensionality == 2)
+    {
+      // same node order as VTK_QUAD
+      for (int indexY = 0; indexY < nNodes[1]-1; indexY++)
+      {
+        for (int indexX = 0; indexX < nNodes[0]-1; indexX++)
+        {
+          connectivityValues.push_back(offset + indexY*nNodes[0] + indexX);
+          connectivityValues.push_back(offset + indexY*nNodes[0] + indexX + 1);
+          connectivityValues.push_back(offset + (indexY+1)*nNodes[0] + indexX + 1);
+          connectivityValues.push_back(offset + (indexY+1)*nNodes[0] + indexX);
+        }
+      }
+    }
+    else
+    {
+      // same node order as VTK_HEXAHEDRON
+      for (int indexZ = 0; indexZ < nNodes[2]-1; indexZ++)
+      {
+        for (int indexY = 0; indexY < nNodes[1]-1; indexY++)
+        {
+          for (int indexX = 0; indexX < nNodes[0]-1; indexX++)
+          {
+            for (int z = 0; z < 2; z++)
+            {
+              connectivityValues.push_back(offset + (indexZ+z)*nNodes[0]*nNodes[1] + indexY*nNodes[0] + indexX);
+              connectivityValues.push_back(offset + (indexZ+z)*nNodes[0]*nNodes[1] + indexY*nNodes[0] + indexX + 1);
+              connectivityValues.push_back(offset + (indexZ+z)*nNodes[0]*nNodes[1] + (indexY+1)*nNodes[0] + indexX + 1);
+              connectivityValues.push_back(offset + (indexZ+z)*nNodes[0]*nNodes[1] + (indexY+1)*nNodes[0] + indexX);
+            }
+          }
+        }
+      }
+    }
+
+    // the write is collective, therefore every rank has to write exactly its share
+    if (connectivityValues.size() - nConnectivityValuesBefore != properties.nCellsLocal * nNodesPerCell)
+    {
+      LOG(ERROR) << "HDF5: Number of connectivity values of mesh \"" << meshName << "\" (" << connectivityValues.size() - nConnectivityValuesBefore
+        << ") does not match number of cells (" << properties.nCellsLocal << ") times " << nNodesPerCell << ".";
+      connectivityValues.resize(nConnectivityValuesBefore + properties.nCellsLocal * nNodesPerCell, offset);
+    }
+  }
+
+  hsize_t dimensions[2] = {combinedMeshes.nCellsGlobal, (hsize_t)nNodesPerCell};
+  hid_t fileDataspace = H5Screate_simple(2, dimensions, NULL);
+  hid_t dataset = H5Dcreate2(combinedMeshes.group, "connectivity", H5T_NATIVE_INT, fileDataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if (dataset < 0)
+    LOG(ERROR) << "Could not create dataset \"connectivity\" in HDF5 file \"" << hdf5Filename_ << "\".";
+
+  hsize_t memoryDimensions[1] = {connectivityValues.size()};
+  hid_t memoryDataspace = H5Screate_simple(1, memoryDimensions, NULL);
+
+  // ranks without local cells only participate in the collective write
+  int dummy = 0;
+  const int *data = &dummy;
+  if (cellRanges.empty())
+  {
+    H5Sselect_none(fileDataspace);
+    H5Sselect_none(memoryDataspace);
+  }
+  else
+  {
+    H5S_seloper_t selectOperation = H5S_SELECT_SET;
+    for (const std::pair<global_no_t,global_no_t> &cellRange : cellRanges)
+    {
+      hsize_t start[2] = {cellRange.first, 0};
+      hsize_t count[2] = {cellRange.second, (hsize_t)nNodesPerCell};
+      checkError(H5Sselect_hyperslab(fileDataspace, selectOperation, start, NULL, count, NULL), "H5Sselect_hyperslab");
+      selectOperation = H5S_SELECT_OR;
+    }
+    data = connectivityValues.data();
+  }
+
+  checkError(H5Dwrite(dataset, H5T_NATIVE_INT, memoryDataspace, fileDataspace, transferProperties_, data), "H5Dwrite");
+
+  H5Sclose(memoryDataspace);
+  H5Sclose(fileDataspace);
+  H5Dclose(dataset);
+}
+
+void HDF5::writeMeshOffsets(CombinedMeshes &combinedMeshes)
+{
+  const int nMeshes = combinedMeshes.meshNames.size();
+
+  // the offsets of the first point and cell of every mesh, the last entry is the total number
+  std::vector<global_no_t> pointOffsets(nMeshes+1, 0);
+  std::vector<global_no_t> cellOffsets(nMeshes+1, 0);
+  std::stringstream meshNames;
+  for (int meshNo = 0; meshNo < nMeshes; meshNo++)
+  {
+    const MeshInfo &meshInfo = meshes_[combinedMeshes.meshNames[meshNo]];
+    pointOffsets[meshNo+1] = pointOffsets[meshNo] + meshInfo.nPointsGlobal;
+    cellOffsets[meshNo+1] = cellOffsets[meshNo] + meshInfo.nCellsGlobal;
+    meshNames << (meshNo == 0? "" : " ") << combinedMeshes.meshNames[meshNo];
+  }
+
+  // the values are the same on all ranks, only rank 0 writes them, but all ranks have to participate in the collective write
+  auto writeOffsets = [&](std::string datasetName, const std::vector<global_no_t> &offsets)
+  {
+    hsize_t dimensions[1] = {offsets.size()};
+    hid_t fileDataspace = H5Screate_simple(1, dimensions, NULL);
+    hid_t memoryDataspace = H5Screate_simple(1, dimensions, NULL);
+
+    hid_t dataset = H5Dcreate2(combinedMeshes.group, datasetName.c_str(), H5T_NATIVE_ULLONG, fileDataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (dataset < 0)
+      LOG(ERROR) << "Could not create dataset \"" << datasetName << "\" in HDF5 file \"" << hdf5Filename_ << "\".";
+
+    if (this->rankSubset_->ownRankNo() != 0)
+    {
+      H5Sselect_none(fileDataspace);
+      H5Sselect_none(memoryDataspace);
+    }
+
+    checkError(H5Dwrite(dataset, H5T_NATIVE_ULLONG, memoryDataspace, fileDataspace, transferProperties_, offsets.data()), "H5Dwrite");
+
+    H5Sclose(memoryDataspace);
+    H5Sclose(fileDataspace);
+    return dataset;
+  };
+
+  hid_t pointOffsetsDataset = writeOffsets("pointOffsets", pointOffsets);
+  hid_t cellOffsetsDataset = writeOffsets("cellOffsets", cellOffsets);
+
+  // store the names of the meshes, separated by spaces, as attribute of the point offsets, attributes are written with the same value by all ranks
+  std::string meshNamesString = meshNames.str();
+  hid_t stringType = H5Tcopy(H5T_C_S1);
+  checkError(H5Tset_size(stringType, meshNamesString.length()+1), "H5Tset_size");
+
+  hid_t attributeDataspace = H5Screate(H5S_SCALAR);
+  hid_t attribute = H5Acreate2(pointOffsetsDataset, "meshNames", stringType, attributeDataspace, H5P_DEFAULT, H5P_DEFAULT);
+  checkError(H5Awrite(attribute, stringType, meshNamesString.c_str()), "H5Awrite");
+
+  H5Aclose(attribute);
+  H5Sclose(attributeDataspace);
+  H5Tclose(stringType);
+  H5Dclose(cellOffsetsDataset);
+  H5Dclose(pointOffsetsDataset);
+}
+
+void HDF5::writeOutputTime()
+{
+  const hsize_t outputNo = outputTimes_.size()-1;
+
+  hsize_t dimensions[1] = {outputNo+1};
+  checkError(H5Dset_extent(timeDataset_, dimensions), "H5Dset_extent");
+
+  // only rank 0 writes the value, but all ranks have to participate in the collective write
+  hid_t fileDataspace = H5Dget_space(timeDataset_);
+  hsize_t memoryDimensions[1] = {1};
+  hid_t memoryDataspace = H5Screate_simple(1, memoryDimensions, NULL);
+
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    hsize_t start[1] = {outputNo};
+    hsize_t count[1] = {1};
+    checkError(H5Sselect_hyperslab(fileDataspace, H5S_SELECT_SET, start, NULL, count, NULL), "H5Sselect_hyperslab");
+  }
+  else
+  {
+    H5Sselect_none(fileDataspace);
+    H5Sselect_none(memoryDataspace);
+  }
+
+  checkError(H5Dwrite(timeDataset_, H5T_NATIVE_DOUBLE, memoryDataspace, fileDataspace, transferProperties_, &outputTimes_.back()), "H5Dwrite");
+
+  H5Sclose(memoryDataspace);
+  H5Sclose(fileDataspace);
+}
+
+void HDF5::writeXdmfFile()
+{
+  const int outputNo = outputTimes_.size()-1;
+  const int nOutputs = outputTimes_.size();
+
+  // the HDF5 file is referenced relative to the XDMF file, which is in the same directory
+  std::string hdf5Filename = hdf5Filename_.substr(hdf5Filename_.rfind("/")+1);
+  std::string xdmfFilename = this->filenameBase_ + ".xdmf";
+
+  // create the grid of the current output, it is a spatial collection of all meshes
+  std::stringstream grid;
+  grid << "    <Grid Name=\"output_" << outputNo << "\" GridType=\"Collection\" CollectionType=\"Spatial\">" << std::endl
+    << "      <Time Value=\"" << std::setprecision(17) << outputTimes_.back() << "\"/>" << std::endl;
+
+  // one grid per group of combined meshes
+  for (const CombinedMeshes &combinedMeshes : combinedMeshes_)
+  {
+    const std::string &groupName = combinedMeshes.name;
+
+    // the values of the current output are a hyperslab of the time dependent dataset
+    auto writeHyperslab = [&](std::string datasetName, int nComponents)
+    {
+      grid << "          <DataItem ItemType=\"HyperSlab\" Dimensions=\"" << combinedMeshes.nPointsGlobal << " " << nComponents << "\" Type=\"HyperSlab\">" << std::endl
+        << "            <DataItem Dimensions=\"3 3\" Format=\"XML\">" << outputNo << " 0 0 1 1 1 1 " << combinedMeshes.nPointsGlobal << " " << nComponents << "</DataItem>" << std::endl
+        << "            <DataItem Dimensions=\"" << nOutputs << " " << combinedMeshes.nPointsGlobal << " " << nComponents << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+        << hdf5Filename << ":/" << groupName << "/" << datasetName << "</DataItem>" << std::endl
+        << "          </DataItem>" << std::endl;
+    };
+
+    std::string topologyType = "Hexahedron";
+    if (combinedMeshes.dimensionality == 1)
+      topologyType = "Polyline\" NodesPerElement=\"2";
+    else if (combinedMeshes.dimensionality == 2)
+      topologyType = "Quadrilateral";
+
+    grid << "      <Grid Name=\"" << groupName << "\" GridType=\"Uniform\">" << std::endl
+      << "        <Topology TopologyType=\"" << topologyType << "\" NumberOfElements=\"" << combinedMeshes.nCellsGlobal << "\">" << std::endl
+      << "          <DataItem Dimensions=\"" << combinedMeshes.nCellsGlobal << " " << combinedMeshes.nNodesPerCell << "\" NumberType=\"Int\" Precision=\"4\" Format=\"HDF\">"
+      << hdf5Filename << ":/" << groupName << "/connectivity</DataItem>" << std::endl
+      << "        </Topology>" << std::endl
+      << "        <Geometry GeometryType=\"XYZ\">" << std::endl;
+    writeHyperslab("geometry", 3);
+    grid << "        </Geometry>" << std::endl;
+
+    for (const PolyDataPropertiesForMesh::DataArrayName &dataArray : combinedMeshes.pointDataArrays)
+    {
+      std::string attributeType = "Matrix";
+      if (dataArray.nComponents == 1)
+        attributeType = "Scalar";
+      else if (dataArray.nComponents == 3)
+        attributeType = "Vector";
+      else if (dataArray.nComponents == 6)
+        attributeType = "Tensor6";
+      else if (dataArray.nComponents == 9)
+        attributeType = "Tensor";
+
+      grid << "        <Attribute Name=\"" << dataArray.name << "\" AttributeType=\"" << attributeType << "\" Center=\"Node\">" << std::endl;
+      writeHyperslab(dataArray.name, dataArray.nComponents);
+      grid << "        </Attribute>" << std::endl;
+    }
+    grid << "      </Grid>" << std::endl;
+  }
+  grid << "    </Grid>" << std::endl;
+
+  // the grids of the previous outputs are kept, the dimensions of their datasets are only needed to interpret the hyperslabs, they can be smaller than the actual extent
+  std::fstream file;
+  if (outputNo == 0)
+  {
+    std::ofstream newFile;
+    Generic::openFile(newFile, xdmfFilename);
+    newFile << "<?xml version=\"1.0\" ?>" << std::endl
+      << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>" << std::endl
+      << "<Xdmf Version=\"3.0\">" << std::endl
+      << "  <Domain>" << std::endl
+      << "    <Grid Name=\"" << StringUtility::extractBasename(this->filenameBase_) << "\" GridType=\"Collection\" CollectionType=\"Temporal\">" << std::endl;
+    xdmfClosingTagsPosition_ = newFile.tellp();
+    newFile.close();
+  }
+
+  // insert the new grid before the closing tags
+  file.open(xdmfFilename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  if (!file.is_open())
+  {
+    LOG(WARNING) << "Could not open file \"" << xdmfFilename << "\" for writing!";
+    return;
+  }
+
+  file.seekp(xdmfClosingTagsPosition_);
+  file << grid.str();
+  xdmfClosingTagsPosition_ = file.tellp();
+
+  file << "    </Grid>" << std::endl
+    << "  </Domain>" << std::endl
+    << "</Xdmf>" << std::endl;
+  file.close();
+}
+
+void HDF5::checkError(herr_t returnValue, std::string functionName)
+{
+  if (returnValue < 0)
+  {
+    LOG(ERROR) << "HDF5 function " << functionName << " failed with return value " << returnValue << ".";
+  }
+}
+
+#else
+
+HDF5::HDF5(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset)
+{
+}
+
+HDF5::~HDF5()
+{
+}
+
+#endif
+
+}  // namespace
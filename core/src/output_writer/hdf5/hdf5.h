@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <iostream>
+#include <vector>
+#include <map>
+
+#ifdef HAVE_HDF5
+#include <hdf5.h>
+#endif
+
+#include "control/types.h"
+#include "output_writer/generic.h"
+#include "output_writer/paraview/poly_data_properties_for_mesh.h"
+
+namespace OutputWriter
+{
+
+/** Output writer that writes all field variables of all meshes into a single parallel HDF5 file per run.
+ *  The time is an additional dimension of the datasets, i.e. every output call appends one entry in the first dimension.
+ *  The datasets are chunked and optionally compressed. Every rank writes its local values (including ghosts, like the Paraview writer) into a hyperslab with collective MPI I/O.
+ *  Additionally, rank 0 writes an XDMF file that describes the contents of the HDF5 file, such that the output can be opened by ParaView or VisIt.
+ *
+ *  Like the combined files of the Paraview writer, all meshes with the same dimensionality and the same field variables are combined into one group,
+ *  such that every output needs only one collective write per field variable and not one per mesh. The meshes are stored one after another in the point and cell dimension.
+ *
+ *  Layout of the HDF5 file:
+ *    /time                              [nOutputs]                          simulation times of the outputs
+ *    /<D>D/connectivity                 [nCellsGlobal, nNodesPerCell]       node numbers of the cells of all meshes with dimensionality D, written at the first output
+ *    /<D>D/geometry                     [nOutputs, nPointsGlobal, 3]        node positions
+ *    /<D>D/<fieldVariableName>          [nOutputs, nPointsGlobal, nComponents]
+ *    /<D>D/pointOffsets                 [nMeshes+1]                         offset of the points of every mesh in the point dimension, the attribute "meshNames" lists the meshes
+ *    /<D>D/cellOffsets                  [nMeshes+1]                         offset of the cells of every mesh in the connectivity
+ *  If meshes with the same dimensionality have different field variables, the further groups are named <D>D_1, <D>D_2 etc.
+ */
+class HDF5 : public Generic
+{
+public:
+
+  //! constructor
+  HDF5(DihuContext context, PythonConfig specificSettings, std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
+
+  //! destructor, closes the file
+  virtual ~HDF5();
+
+  //! append the current values to the HDF5 file, if output should be written in this timestep
+  template<typename DataType>
+  void write(DataType &data, int timeStepNo = -1, double currentTime = -1, int callCountIncrement = 1);
+
+#ifdef HAVE_HDF5
+protected:
+
+  //! information of one mesh in the output file, the numbers are the same on all ranks except the offsets and the local sizes, which are zero on ranks that do not hold the mesh
+  struct MeshInfo
+  {
+    PolyDataPropertiesForMesh properties;   //< the collected properties of the mesh, i.e. dimensionality, local sizes and names of the field variables
+    global_no_t nPointsGlobal;              //< sum of the local number of points including ghosts over all ranks
+    global_no_t nCellsGlobal;               //< global number of cells
+    global_no_t pointOffset;                //< offset of the local points of the own rank in the datasets of the combined meshes
+    global_no_t cellOffset;                 //< offset of the local cells of the own rank in the connectivity dataset of the combined meshes
+  };
+
+  //! meshes with the same dimensionality and field variables that are stored in the same datasets, the meshes follow each other in the order of meshNames
+  struct CombinedMeshes
+  {
+    std::string name;                       //< name of the HDF5 group, e.g. "1D"
+    std::vector<std::string> meshNames;     //< names of the combined meshes, sorted
+    int dimensionality;                     //< dimensionality of all meshes
+    int nNodesPerCell;                      //< number of nodes per cell, 2 for lines, 4 for quadrilaterals, 8 for hexahedra
+    std::vector<PolyDataPropertiesForMesh::DataArrayName> pointDataArrays;   //< the field variables, the same for all meshes
+    global_no_t nPointsGlobal;              //< total number of points of all meshes, this is the size of the point dimension in the datasets
+    global_no_t nCellsGlobal;               //< total number of cells of all meshes
+    hid_t group;                            //< the HDF5 group
+    hid_t geometryDataset;                  //< dataset of the node positions
+    std::map<std::string,hid_t> datasets;   //< the datasets of the field variables, key is the field variable name
+  };
+
+  //! write all values of the field variables, this is the actual implementation of write
+  template<typename FieldVariablesForOutputWriterType>
+  void writeFieldVariables(const FieldVariablesForOutputWriterType &fieldVariables);
+
+  //! gather the meshes of all ranks, such that every rank creates and writes the same groups and datasets in the same order, as required for collective HDF5 calls
+  void collectGlobalMeshes();
+
+  //! compute the global sizes and offsets of all meshes and combine the meshes with the same dimensionality and field variables
+  void combineMeshes();
+
+  //! open the HDF5 file collectively, create the groups and datasets for all combined meshes and write the connectivity
+  void openHdf5File(std::string filename);
+
+  //! close all datasets, groups and the file
+  void closeHdf5File();
+
+  //! create an extendible, chunked and compressed dataset of doubles with shape [time, nPointsGlobal, nComponents]
+  hid_t createTimeDependentDataset(hid_t location, std::string name, global_no_t nPointsGlobal, int nComponents);
+
+  //! write the local values of the current output to the dataset, the values are the local points of the meshes, one after another,
+  //! pointRanges contains the offset in the dataset and the number of local points of every local mesh
+  void writeTimeStep(hid_t dataset, const std::vector<double> &values, const std::vector<std::pair<global_no_t,global_no_t>> &pointRanges, int nComponents);
+
+  //! compute the connectivity of the local cells of all meshes in global point numbering and write it to the connectivity dataset
+  void writeConnectivity(CombinedMeshes &combinedMeshes);
+
+  //! write the offsets of the meshes in the point and cell dimension and the mesh names
+  void writeMeshOffsets(CombinedMeshes &combinedMeshes);
+
+  //! append the current simulation time to the time dataset
+  void writeOutputTime();
+
+  //! write the XDMF file that references the datasets of all outputs so far, this is done by rank 0
+  void writeXdmfFile();
+
+  //! check the return value of an HDF5 function, output an error if it indicates failure
+  static void checkError(herr_t returnValue, std::string functionName);
+
+  std::string hdf5Filename_;                  //< name of the currently opened HDF5 file
+  hid_t file_;                                //< the HDF5 file, -1 if no file is open
+  hid_t timeDataset_;                         //< the dataset with the simulation times of the outputs
+  hid_t transferProperties_;                  //< property list for collective writes
+  std::map<std::string,MeshInfo> meshes_;     //< information for all meshes in the file, key is the mesh name
+  std::vector<CombinedMeshes> combinedMeshes_; //< the groups of combined meshes in the file
+  std::vector<std::string> meshNames_;        //< sorted names of the meshes of all ranks, also the meshes that are not present on the own rank
+  std::vector<double> outputTimes_;           //< simulation times of all outputs written so far
+  long long xdmfClosingTagsPosition_;         //< position in the XDMF file where the closing tags start, the grid of the next output is inserted there
+
+  int compressionLevel_;                      //< gzip compression level 0-9, 0 means no compression
+  int chunkSize_;                             //< number of points per chunk in the datasets
+#endif
+};
+
+} // namespace
+
+#include "output_writer/hdf5/hdf5.tpp"
@@ -0,0 +1,113 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <set>
+
+#include "easylogging++.h"
+
+#include "output_writer/paraview/loop_collect_mesh_properties.h"
+#include "output_writer/paraview/loop_get_nodal_values.h"
+#include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
+namespace OutputWriter
+{
+
+template<typename DataType>
+void HDF5::write(DataType& data, int timeStepNo, double currentTime, int callCountIncrement)
+{
+  // check if output should be written in this timestep and prepare filename
+  if (!Generic::prepareWrite(data, timeStepNo, currentTime, callCountIncrement))
+  {
+    return;
+  }
+
+#ifdef HAVE_HDF5
+  Control::PerformanceMeasurement::start("durationHDF5Output");
+
+  writeFieldVariables<typename DataType::FieldVariablesForOutputWriter>(data.getFieldVariablesForOutputWriter());
+
+  Control::PerformanceMeasurement::stop("durationHDF5Output");
+#endif
+}
+
+#ifdef HAVE_HDF5
+template<typename FieldVariablesForOutputWriterType>
+void HDF5::writeFieldVariables(const FieldVariablesForOutputWriterType &fieldVariables)
+{
+  // all outputs of the run go to one file, the time step number is not part of the filename
+  std::string filename = this->filenameBase_ + ".h5";
+
+  // at the first output or when the filename was changed, collect the properties of all meshes and create the file
+  if (file_ < 0 || filename != hdf5Filename_)
+  {
+    closeHdf5File();
+
+    meshes_.clear();
+    meshNames_.clear();
+    outputTimes_.clear();
+
+    std::map<std::string,PolyDataPropertiesForMesh> meshProperties;
+    ParaviewLoopOverTuple::loopCollectMeshProperties<FieldVariablesForOutputWriterType>(fieldVariables, meshProperties, meshNames_);
+
+    for (std::string meshName : meshNames_)
+    {
+      meshes_[meshName].properties = meshProperties[meshName];
+    }
+
+    // the ranks can have different meshes, e.g. different fibers, but the groups and datasets have to be created and written collectively
+    collectGlobalMeshes();
+    combineMeshes();
+
+    openHdf5File(filename);
+
+    if (file_ < 0)
+      return;
+  }
+
+  outputTimes_.push_back(this->currentTime_);
+  writeOutputTime();
+
+  // loop over the combined meshes and append the values of the current output, the values of all local meshes are written at once
+  for (CombinedMeshes &combinedMeshes : combinedMeshes_)
+  {
+    std::vector<std::pair<global_no_t,global_no_t>> pointRanges;
+    std::vector<double> geometryValues;
+    std::map<std::string,std::vector<double>> fieldVariableValues;
+
+    for (std::string meshName : combinedMeshes.meshNames)
+    {
+      const MeshInfo &meshInfo = meshes_[meshName];
+      const global_no_t nPointsLocal = meshInfo.properties.nPointsLocal;
+
+      // the mesh is not present on the own rank
+      if (nPointsLocal == 0)
+        continue;
+
+      pointRanges.push_back(std::make_pair(meshInfo.pointOffset, nPointsLocal));
+
+      // collect the node positions and the values of all field variables of the mesh, the values of the meshes are appended
+      std::set<std::string> meshNames{meshName};
+      ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, geometryValues);
+      ParaviewLoopOverTuple::loopGetNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, fieldVariableValues);
+    }
+
+    // ranks that do not hold any of the meshes participate with an empty selection
+    writeTimeStep(combinedMeshes.geometryDataset, geometryValues, pointRanges, 3);
+
+    for (const PolyDataPropertiesForMesh::DataArrayName &dataArray : combinedMeshes.pointDataArrays)
+    {
+      writeTimeStep(combinedMeshes.datasets[dataArray.name], fieldVariableValues[dataArray.name], pointRanges, dataArray.nComponents);
+    }
+  }
+
+  // make the data of the current output visible in the file, such that the output can already be inspected during the simulation
+  checkError(H5Fflush(file_, H5F_SCOPE_GLOBAL), "H5Fflush");
+
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    writeXdmfFile();
+  }
+}
+#endif
+
+}  // namespace
@@ -0,0 +1,201 @@
+#include "output_writer/paraview/async_file_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <algorithm>
+
+#include "easylogging++.h"
+
+namespace OutputWriter
+{
+
+AsyncFileWriter::AsyncFileWriter(int maxPendingJobs) :
+  maxPendingJobs_(std::max(1, maxPendingJobs)), finish_(false), nAddedJobs_(0), nFinishedJobs_(0), thread_(nullptr)
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+  if (thread_)
+  {
+    // let the thread write all remaining jobs and terminate
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      finish_ = true;
+    }
+    jobAdded_.notify_all();
+    thread_->join();
+    thread_ = nullptr;
+  }
+  logErrors();
+}
+
+void AsyncFileWriter::writeAsync(Job &&job)
+{
+  logErrors();
+
+  // start the background thread
+  if (!thread_)
+  {
+    thread_ = std::make_shared<std::thread>([this](){ this->run(); });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // bound the memory consumption by waiting until there is space in the queue
+    if (jobs_.size() >= maxPendingJobs_)
+    {
+      VLOG(1) << "AsyncFileWriter: " << jobs_.size() << " pending output files, wait for background writer";
+      jobFinished_.wait(lock, [this](){ return jobs_.size() < maxPendingJobs_; });
+    }
+
+    jobs_.push_back(std::move(job));
+    nAddedJobs_++;
+  }
+  jobAdded_.notify_one();
+}
+
+void AsyncFileWriter::waitForFile(std::string filename)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobFinished_.wait(lock, [this, &filename]()
+    {
+      return std::none_of(jobs_.begin(), jobs_.end(), [&filename](const Job &job){ return job.filename == filename; });
+    });
+  }
+  logErrors();
+}
+
+bool AsyncFileWriter::hasPendingJob(std::string filename)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  return std::any_of(jobs_.begin(), jobs_.end(), [&filename](const Job &job){ return job.filename == filename; });
+}
+
+long long AsyncFileWriter::nFinishedJobs()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  return nFinishedJobs_;
+}
+
+long long AsyncFileWriter::nAddedJobs()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  return nAddedJobs_;
+}
+
+void AsyncFileWriter::waitForAllJobs()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobFinished_.wait(lock, [this](){ return jobs_.empty(); });
+  }
+  logErrors();
+}
+
+void AsyncFileWriter::run()
+{
+  for (;;)
+  {
+    // wait for the next job, it stays in the queue until it has been written, such that waitForFile() sees it
+    Job *job = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobAdded_.wait(lock, [this](){ return !jobs_.empty() || finish_; });
+
+      if (jobs_.empty())
+        return;
+
+      job = &jobs_.front();
+    }
+
+    // write the file without holding the lock
+    std::string errorMessage = writeJob(*job);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!errorMessage.empty())
+        errorMessages_.push_back(errorMessage);
+      jobs_.pop_front();
+      nFinishedJobs_++;
+    }
+    jobFinished_.notify_all();
+  }
+}
+
+std::string AsyncFileWriter::writeJob(const Job &job)
+{
+  // the file is created by the first rank that opens it, it was already removed by rank 0 before
+  int fileDescriptor = open(job.filename.c_str(), O_WRONLY | O_CREAT, 0644);
+  if (fileDescriptor == -1)
+  {
+    std::stringstream message;
+    message << "Could not open file \"" << job.filename << "\" for writing: " << strerror(errno);
+    return message.str();
+  }
+
+  std::string errorMessage;
+  for (const Segment &segment : job.segments)
+  {
+    // pwrite may write less bytes than requested, repeat until everything is written
+    const char *data = segment.data.c_str();
+    long long nBytesRemaining = segment.data.size();
+    long long offset = segment.offset;
+
+    while (nBytesRemaining > 0)
+    {
+      ssize_t nBytesWritten = pwrite(fileDescriptor, data, nBytesRemaining, offset);
+      if (nBytesWritten == -1)
+      {
+        if (errno == EINTR)
+          continue;
+
+        std::stringstream message;
+        message << "Could not write " << nBytesRemaining << " bytes at offset " << offset << " to file \"" << job.filename << "\": " << strerror(errno);
+        errorMessage = message.str();
+        break;
+      }
+      data += nBytesWritten;
+      nBytesRemaining -= nBytesWritten;
+      offset += nBytesWritten;
+    }
+
+    if (!errorMessage.empty())
+      break;
+  }
+
+  // remove old contents after the end of the file
+  if (job.truncateFile && errorMessage.empty())
+  {
+    if (ftruncate(fileDescriptor, job.fileSize) == -1)
+    {
+      std::stringstream message;
+      message << "Could not set size of file \"" << job.filename << "\" to " << job.fileSize << " bytes: " << strerror(errno);
+      errorMessage = message.str();
+    }
+  }
+
+  close(fileDescriptor);
+  return errorMessage;
+}
+
+void AsyncFileWriter::logErrors()
+{
+  std::vector<std::string> errorMessages;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    errorMessages.swap(errorMessages_);
+  }
+
+  for (const std::string &errorMessage : errorMessages)
+  {
+    LOG(ERROR) << "Asynchronous output: " << errorMessage;
+  }
+}
+
+} // namespace
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace OutputWriter
+{
+
+/** Writes the local portions of combined output files in a background thread.
+ *  The caller serializes the data of the own rank into a job that contains the file offset of every segment ("snapshot").
+ *  The file I/O is then done asynchronously by plain POSIX calls, such that no MPI calls are needed in the background thread.
+ *  The number of jobs that are queued but not yet written is bounded by maxPendingJobs, when the bound is reached, writeAsync() blocks.
+ */
+class AsyncFileWriter
+{
+public:
+
+  //! a contiguous part of the file that is written by the own rank
+  struct Segment
+  {
+    long long offset;               //< byte offset in the file
+    std::string data;               //< data to write
+  };
+
+  //! all data of the own rank for one file
+  struct Job
+  {
+    std::string filename;           //< the file to write
+    std::vector<Segment> segments;  //< the local parts of the file
+    long long fileSize;             //< total size of the file, over all ranks
+    bool truncateFile;              //< if the file should be truncated to fileSize, this is done by only one rank
+  };
+
+  //! constructor, maxPendingJobs is the maximum number of jobs that are queued and not yet written
+  AsyncFileWriter(int maxPendingJobs);
+
+  //! destructor, waits until all pending jobs are written
+  ~AsyncFileWriter();
+
+  //! add a job to the queue, blocks if there are already maxPendingJobs jobs in the queue, starts the background thread on the first call
+  void writeAsync(Job &&job);
+
+  //! block until there is no more pending job that writes the given file
+  void waitForFile(std::string filename);
+
+  //! check if there is a pending job that writes the given file
+  bool hasPendingJob(std::string filename);
+
+  //! get the number of jobs that have been completely written, jobs are written in the order in which they were added
+  long long nFinishedJobs();
+
+  //! get the number of jobs that have been added by writeAsync()
+  long long nAddedJobs();
+
+  //! block until all pending jobs have been written
+  void waitForAllJobs();
+
+protected:
+
+  //! main loop of the background thread
+  void run();
+
+  //! write the segments of a single job to the file, return an error message or an empty string on success
+  static std::string writeJob(const Job &job);
+
+  //! output error messages of the background thread, this has to be called from the main thread because the logging is not thread safe
+  void logErrors();
+
+  int maxPendingJobs_;                         //< maximum number of jobs in jobs_, including the one that is currently written
+  std::list<Job> jobs_;                        //< queue of jobs, the front job is the one that is currently written
+  std::vector<std::string> errorMessages_;     //< errors of the background thread that have not yet been output
+  bool finish_;                                //< if the background thread should terminate after the queue is empty
+  long long nAddedJobs_;                       //< number of jobs that were added by writeAsync()
+  long long nFinishedJobs_;                    //< number of jobs that have been written
+  std::shared_ptr<std::thread> thread_;        //< the background thread, created on the first call to writeAsync()
+  std::mutex mutex_;                           //< mutex that protects jobs_, errorMessages_, finish_ and the job counters
+  std::condition_variable jobAdded_;           //< signalled when a job was added or finish_ was set
+  std::condition_variable jobFinished_;        //< signalled when a job has been written
+};
+
+} // namespace
@@ -27,6 +27,45 @@ Paraview::Paraview(DihuContext context, PythonConfig settings, std::shared_ptr<P
   binaryOutput_ = settings.getOptionBool("binary", true);
   fixedFormat_ = settings.getOptionBool("fixedFormat", true);
   combineFiles_ = settings.getOptionBool("combineFiles", false);
+  asyncOutput_ = settings.getOptionBool("asyncOutput", false);
+
+  if (asyncOutput_)
+  {
+    if (!combineFiles_)
+    {
+      LOG(WARNING) << settings << "[\"asyncOutput\"] is only used together with \"combineFiles\": True.";
+      asyncOutput_ = false;
+    }
+    else
+    {
+      int maxPendingOutputs = settings.getOptionInt("maxPendingOutputs", 2, PythonUtility::Positive);
+      asyncFileWriter_ = std::make_shared<AsyncFileWriter>(maxPendingOutputs);
+    }
+  }
+}
+
+Paraview::~Paraview()
+{
+  if (asyncFileWriter_)
+  {
+    // wait until all outputs of this rank are written
+    asyncFileWriter_->waitForAllJobs();
+
+    // The remaining files are only registered at the series writer when they are written on all ranks, like in synchronizeAsyncOutput.
+    // The destructor is collective on the rank subset, all ranks destroy the output writer together with the solver that owns it.
+    int mpiIsFinalized = 0;
+    MPI_Finalized(&mpiIsFinalized);
+    if (!mpiIsFinalized)
+    {
+      MPIUtility::handleReturnValue(MPI_Barrier(this->rankSubset_->mpiCommunicator()), "MPI_Barrier");
+      registerFinishedAsyncOutputs(asyncFileWriter_->nFinishedJobs());
+    }
+    else
+    {
+      LOG(WARNING) << "MPI is already finalized when the Paraview output writer is destroyed, "
+        << "the last " << pendingSeriesEntries_.size() << " asynchronously written files are not registered in the *.series file.";
+    }
+  }
 }
 
 std::string Paraview::encodeBase64Vec(const Vec &vector, bool withEncodedSizePrefix)
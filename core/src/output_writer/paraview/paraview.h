@@ -5,9 +5,12 @@
 #include <vector>
 
 #include "control/types.h"
+#include <list>
+
 #include "output_writer/generic.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
 #include "output_writer/paraview/series_writer.h"
+#include "output_writer/paraview/async_file_writer.h"
 
 namespace OutputWriter
 {
@@ -19,6 +22,9 @@ public:
   //! constructor
   Paraview(DihuContext context, PythonConfig specificSettings, std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
 
+  //! destructor, for asyncOutput_ waits for the background writer and registers the remaining files at the series writer, collective on the rank subset
+  ~Paraview();
+
   //! write out solution to given filename, if timeStepNo is not -1, this value will be part of the filename
   template<typename DataType>
   void write(DataType &data, int timeStepNo = -1, double currentTime = -1, int callCountIncrement = 1);
@@ -104,6 +110,20 @@ protected:
   //! write some ascii data to the file as a collective shared operation. Only rank 0 writes, but the other ranks wait and the shared file pointer is incremented.
   void writeAsciiDataShared(MPI_File fileHandle, int ownRankNo, std::string writeBuffer);
 
+  //! collectively write the local buffers of all ranks in rank order, like MPI_File_write_ordered, for asyncOutput_ only store the buffer in stagedSegments_
+  void writeOrdered(MPI_File fileHandle, const std::string &writeBuffer);
+
+  //! compute the file offsets of all staged segments and pass them to the background writer, this replaces MPI_File_close for asyncOutput_.
+  //! The file is registered at the series writer only after it has been written on all ranks, see synchronizeAsyncOutput.
+  void writeStagedFileAsync(std::string filename);
+
+  //! collective on the rank subset, called before a new combined file is written for asyncOutput_.
+  //! If any rank still writes the file with the same name in the background, all ranks wait for it. Register all files at the series writer that have been written on all ranks.
+  void synchronizeAsyncOutput(std::string filename);
+
+  //! on rank 0 register all pending files at the series writer whose job number is lower than nJobsFinishedOnAllRanks
+  void registerFinishedAsyncOutputs(long long nJobsFinishedOnAllRanks);
+
   //! write the values vector combined to the file, correctly encoded, identifier is an id to access cached values
   template<typename T>
   void writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, const std::vector<T> &values, int identifier, bool writeFloatsAsInt=false);
@@ -122,6 +142,17 @@ protected:
   bool fixedFormat_;    //< if non-binary output is selected, if the ascii values should be written with a fixed precision, like 1.000000e5
 
   bool combineFiles_;   //< if the output data should be combined for 1D meshes into a single PolyData output file (*.vtp) and for 2D and 3D meshes to normal *.vtu,*.vts or *.vtr files. This is needed when the number of output files should be reduced.
+  bool asyncOutput_;    //< if the combined files should be written by a background thread while the computation continues
+  std::shared_ptr<AsyncFileWriter> asyncFileWriter_;   //< the background writer for asyncOutput_
+  std::vector<std::string> stagedSegments_;   //< the local data of the current combined file that is written for asyncOutput_, one entry for every call to writeOrdered
+
+  struct PendingSeriesEntry
+  {
+    long long jobNo;            //< number of the job of the background writer that writes the file
+    std::string filename;       //< the filename to register at the series writer
+    double currentTime;         //< the simulation time of the file
+  };
+  std::list<PendingSeriesEntry> pendingSeriesEntries_;   //< for asyncOutput_ on rank 0, files that are not yet registered at the series writer because they may not yet be written on all ranks
 
   std::vector<int> globalValuesSize_;   //< cached values used in writeCombinedValuesVector
   std::vector<int> nPreviousValues_;    //< cached values used in writeCombinedValuesVector
@@ -11,6 +11,7 @@
 #include "output_writer/paraview/loop_output.h"
 #include "output_writer/paraview/loop_collect_mesh_properties.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
+#include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter
 {
@@ -20,14 +21,108 @@ void Paraview::writeAsciiDataShared(MPI_File fileHandle, int ownRankNo, std::str
   // collective blocking write, only rank 0 writes, but afterwards all have the same shared file pointer position
   if (ownRankNo == 0)
   {
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_ordered", &status);
+    writeOrdered(fileHandle, writeBuffer);
   }
   else
   {
-    char b[1];
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, b, 0, MPI_BYTE, &status), "MPI_File_write_ordered", &status);
+    writeOrdered(fileHandle, std::string(""));
+  }
+}
+
+void Paraview::writeOrdered(MPI_File fileHandle, const std::string &writeBuffer)
+{
+  // for asynchronous output, only store the data, the offsets are computed in writeStagedFileAsync
+  if (asyncOutput_)
+  {
+    stagedSegments_.push_back(writeBuffer);
+    return;
+  }
+
+  MPI_Status status;
+  MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_ordered", &status);
+}
+
+void Paraview::writeStagedFileAsync(std::string filename)
+{
+  assert(asyncFileWriter_);
+  Control::PerformanceMeasurement::start("durationParaviewAsyncStaging");
+
+  // all ranks have the same number of segments, the segments of one part of the file are ordered by rank
+  int nSegments = stagedSegments_.size();
+  int nRanks = this->rankSubset_->size();
+  int ownRankNo = this->rankSubset_->ownRankNo();
+
+  std::vector<long long> localSizes(nSegments);
+  for (int segmentNo = 0; segmentNo < nSegments; segmentNo++)
+  {
+    localSizes[segmentNo] = stagedSegments_[segmentNo].length();
+  }
+
+  // exchange the sizes of all segments of all ranks in a single collective call
+  std::vector<long long> sizes(nSegments*nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(localSizes.data(), nSegments, MPI_LONG_LONG, sizes.data(), nSegments, MPI_LONG_LONG,
+                                              this->rankSubset_->mpiCommunicator()), "MPI_Allgather");
+
+  // compute the offsets of the own segments
+  AsyncFileWriter::Job job;
+  job.filename = filename;
+
+  long long offset = 0;
+  for (int segmentNo = 0; segmentNo < nSegments; segmentNo++)
+  {
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    {
+      if (rankNo == ownRankNo && !stagedSegments_[segmentNo].empty())
+      {
+        job.segments.push_back(AsyncFileWriter::Segment{offset, std::move(stagedSegments_[segmentNo])});
+      }
+      offset += sizes[rankNo*nSegments + segmentNo];
+    }
+  }
+  job.fileSize = offset;
+  job.truncateFile = (ownRankNo == 0);
+
+  stagedSegments_.clear();
+
+  VLOG(1) << "pass " << job.segments.size() << " segments of file \"" << filename << "\" (" << job.fileSize << " bytes) to background writer";
+  Control::PerformanceMeasurement::stop("durationParaviewAsyncStaging");
+
+  // remember the file to register it at the series writer when it has been written on all ranks
+  if (ownRankNo == 0)
+  {
+    pendingSeriesEntries_.push_back(PendingSeriesEntry{asyncFileWriter_->nAddedJobs(), filename, this->currentTime_});
+  }
+
+  // this blocks if the maximum number of pending files is reached
+  asyncFileWriter_->writeAsync(std::move(job));
+}
+
+void Paraview::synchronizeAsyncOutput(std::string filename)
+{
+  assert(asyncFileWriter_);
+
+  // determine in one collective call if any rank still writes the file and how many jobs are finished on all ranks,
+  // the minimum of the finished jobs is computed as maximum of the negative values
+  long long localValues[2] = {asyncFileWriter_->hasPendingJob(filename)? 1 : 0, -asyncFileWriter_->nFinishedJobs()};
+  long long globalValues[2] = {0, 0};
+  MPIUtility::handleReturnValue(MPI_Allreduce(localValues, globalValues, 2, MPI_LONG_LONG, MPI_MAX, this->rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+
+  // if the file is still being written on any rank, wait until it is finished everywhere, before rank 0 truncates it
+  if (globalValues[0] != 0)
+  {
+    asyncFileWriter_->waitForFile(filename);
+    MPIUtility::handleReturnValue(MPI_Barrier(this->rankSubset_->mpiCommunicator()), "MPI_Barrier");
+  }
+
+  registerFinishedAsyncOutputs(-globalValues[1]);
+}
+
+void Paraview::registerFinishedAsyncOutputs(long long nJobsFinishedOnAllRanks)
+{
+  while (!pendingSeriesEntries_.empty() && pendingSeriesEntries_.front().jobNo < nJobsFinishedOnAllRanks)
+  {
+    Paraview::seriesWriter().registerNewFile(pendingSeriesEntries_.front().filename, pendingSeriesEntries_.front().currentTime);
+    pendingSeriesEntries_.pop_front();
   }
 }
 
@@ -64,17 +159,7 @@ void Paraview::writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int
   }
 
   // collective blocking write, only rank 0 writes, but afterwards all have the same shared file pointer position
-  if (ownRankNo == 0)
-  {
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_ordered", &status);
-  }
-  else
-  {
-    char b[1];
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, b, 0, MPI_BYTE, &status), "MPI_File_write_ordered", &status);
-  }
+  writeAsciiDataShared(fileHandle, ownRankNo, writeBuffer);
 }
 
 //! constructor, initialize nPoints and nCells to 0
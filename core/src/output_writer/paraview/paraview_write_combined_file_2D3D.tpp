@@ -264,8 +264,12 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
 
   std::string filenameStr(receiveBuffer.begin(), receiveBuffer.end());
 
-  // remove file if it exists, synchronization afterwards by MPI calls, that is why the remove call is already here
+  // if the same file is still being written in the background on any rank, wait until this is finished
   assert(this->rankSubset_);
+  if (asyncOutput_)
+    synchronizeAsyncOutput(filenameStr);
+
+  // remove file if it exists, synchronization afterwards by MPI calls, that is why the remove call is already here
   int ownRankNo = this->rankSubset_->ownRankNo();
   if (ownRankNo == 0)
   {
@@ -720,18 +724,24 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
 
   LOG(DEBUG) << "open MPI file \"" << filenameStr << "\" for rankSubset " << *this->rankSubset_;
 
-  // open file
-  MPI_File fileHandle;
-
-  // set a maximum timeout of 10s if the file is not writable
-  MPI_Info info;
-  MPIUtility::handleReturnValue(MPI_Info_create(&info), "MPI_Info_create");
-  MPIUtility::handleReturnValue(MPI_Info_set(info, "shared_file_timeout", "10.0"), "MPI_Info_set");
-
-  MPIUtility::handleReturnValue(MPI_File_open(this->rankSubset_->mpiCommunicator(), filenameStr.c_str(),
-                                              //MPI_MODE_WRONLY | MPI_MODE_CREATE | MPI_MODE_UNIQUE_OPEN,
-                                              MPI_MODE_WRONLY | MPI_MODE_CREATE,
-                                              info, &fileHandle), "MPI_File_open");
+  // open file, for asynchronous output the data is only staged and written later by the background thread
+  MPI_File fileHandle = MPI_FILE_NULL;
+  if (asyncOutput_)
+  {
+    stagedSegments_.clear();
+  }
+  else
+  {
+    // set a maximum timeout of 10s if the file is not writable
+    MPI_Info info;
+    MPIUtility::handleReturnValue(MPI_Info_create(&info), "MPI_Info_create");
+    MPIUtility::handleReturnValue(MPI_Info_set(info, "shared_file_timeout", "10.0"), "MPI_Info_set");
+
+    MPIUtility::handleReturnValue(MPI_File_open(this->rankSubset_->mpiCommunicator(), filenameStr.c_str(),
+                                                //MPI_MODE_WRONLY | MPI_MODE_CREATE | MPI_MODE_UNIQUE_OPEN,
+                                                MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                                info, &fileHandle), "MPI_File_open");
+  }
 
   Control::PerformanceMeasurement::start("durationParaview3DWrite");
 
@@ -744,9 +754,12 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
   VLOG(1) << "get current shared file position";
 
   // get current file position
-  MPI_Offset currentFilePosition = 0;
-  MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
-  LOG(DEBUG) << "current shared file position: " << currentFilePosition;
+  if (!asyncOutput_)
+  {
+    MPI_Offset currentFilePosition = 0;
+    MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
+    LOG(DEBUG) << "current shared file position: " << currentFilePosition;
+  }
 
   // write field variables
   // loop over field variables
@@ -813,10 +826,18 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
   */
 
   Control::PerformanceMeasurement::stop("durationParaview3DWrite");
-  MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+  if (asyncOutput_)
+  {
+    // compute file offsets and hand the data over to the background thread
+    writeStagedFileAsync(filenameStr);
+  }
+  else
+  {
+    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+  }
 
-  // register file at SeriesWriter to be included in the "*.vtk.series" JSON file
-  if (ownRankNo == 0)
+  // register file at SeriesWriter to be included in the "*.vtk.series" JSON file, for asyncOutput_ this is done after the file was written
+  if (ownRankNo == 0 && !asyncOutput_)
   {
     Paraview::seriesWriter().registerNewFile(filenameStr, this->currentTime_);
   }
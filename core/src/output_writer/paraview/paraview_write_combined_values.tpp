@@ -270,7 +270,7 @@ void Paraview::writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, con
     writeBuffer += std::string(5,'\t');
   }
 
-  MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_ordered");
+  writeOrdered(fileHandle, writeBuffer);
 }
 
 } // namespace
@@ -0,0 +1,69 @@
+#include "partition/balanced_partitioning/balanced_partitioning.h"
+
+#include <algorithm>
+
+#include "easylogging++.h"
+#include "utility/vector_operators.h"
+
+namespace Partition
+{
+namespace BalancedPartitioning
+{
+
+void computeSplitPositions(const std::vector<double> &costs, int nParts, std::vector<int> &splitPositions, int minimumPartSize)
+{
+  const int nEntries = costs.size();
+  splitPositions.resize(std::max(0, nParts-1));
+
+  if (nParts <= 1)
+    return;
+
+  if (nEntries < nParts*minimumPartSize)
+  {
+    LOG(FATAL) << "Cannot partition " << nEntries << " entries into " << nParts << " parts with at least "
+      << minimumPartSize << " entries each.";
+  }
+
+  // compute prefix sums, prefixSum[i] is the cost of the entries [0,i)
+  std::vector<double> prefixSum(nEntries+1, 0.0);
+  for (int i = 0; i < nEntries; i++)
+  {
+    prefixSum[i+1] = prefixSum[i] + std::max(0.0, costs[i]);
+  }
+  const double totalCost = prefixSum[nEntries];
+
+  // place each split at the position where the prefix sum is closest to the ideal cost of the preceding parts
+  for (int partNo = 1; partNo < nParts; partNo++)
+  {
+    // without any cost information fall back to equally sized parts
+    if (totalCost <= 0)
+    {
+      splitPositions[partNo-1] = (int)((long long)nEntries * partNo / nParts);
+      continue;
+    }
+
+    const double targetCost = totalCost * partNo / nParts;
+    int position = std::lower_bound(prefixSum.begin(), prefixSum.end(), targetCost) - prefixSum.begin();
+    if (position > 0 && targetCost - prefixSum[position-1] < prefixSum[position] - targetCost)
+      position--;
+
+    splitPositions[partNo-1] = position;
+  }
+
+  // enforce the minimum part size, first from the front, then from the back
+  for (int partNo = 0; partNo < nParts-1; partNo++)
+  {
+    int lowerBound = (partNo == 0? 0 : splitPositions[partNo-1]) + minimumPartSize;
+    splitPositions[partNo] = std::max(splitPositions[partNo], lowerBound);
+  }
+  for (int partNo = nParts-2; partNo >= 0; partNo--)
+  {
+    int upperBound = (partNo == nParts-2? nEntries : splitPositions[partNo+1]) - minimumPartSize;
+    splitPositions[partNo] = std::min(splitPositions[partNo], upperBound);
+  }
+
+  VLOG(1) << "computeSplitPositions: " << nEntries << " entries, total cost " << totalCost << ", " << nParts << " parts, split positions: " << splitPositions;
+}
+
+}  // namespace BalancedPartitioning
+}  // namespace Partition
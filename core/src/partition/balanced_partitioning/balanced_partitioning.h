@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+
+namespace Partition
+{
+
+/** Helper functions to compute a partitioning that balances a measured or estimated cost.
+ *  This is used by the load balancing of fibers, where the nodes of a 1D mesh are split into contiguous partitions.
+ */
+namespace BalancedPartitioning
+{
+
+//! compute the split positions that partition the entries of costs into nParts contiguous intervals of approximately equal cost,
+//! the maximum cost of an interval exceeds the mean by at most the largest single cost,
+//! splitPositions[i] is the first index of part i+1, i.e. part i has the indices [splitPositions[i-1], splitPositions[i]), every part gets at least minimumPartSize entries
+void computeSplitPositions(const std::vector<double> &costs, int nParts, std::vector<int> &splitPositions, int minimumPartSize = 1);
+
+}  // namespace BalancedPartitioning
+}  // namespace Partition
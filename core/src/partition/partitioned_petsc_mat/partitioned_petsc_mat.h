@@ -62,6 +62,12 @@ public:
   template<int nComponents>
   void setValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const std::vector<std::array<double,nComponents>> &v, InsertMode addv);
 
+  //! set the dense element matrix of a single component for all elements that are computed at once (nVcComponents elements if USE_VECTORIZED_FE_MATRIX_ASSEMBLY is set, else 1),
+  //! values[i*nDofsPerElement + j] is the entry for the element dofs i and j, this calls MatSetValues once per element instead of once per entry, elements with dof no -1 are skipped
+  template<int nDofsPerElement>
+  void setValuesElement(int componentNo, const std::array<dof_no_v_t,nDofsPerElement> &dofNosLocal,
+                        const std::array<double_v_t,nDofsPerElement*nDofsPerElement> &values, InsertMode addv);
+
   //! set entries in the given submatrix, uses the global/Petsc indexing. This is not the global natural numbering!
   void setValuesGlobalPetscIndexing(int componentNo, PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const PetscScalar v[], InsertMode addv);
 
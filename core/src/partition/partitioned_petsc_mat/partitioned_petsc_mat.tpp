@@ -212,6 +212,49 @@ setValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[],
   }
 }
 
+//! set the dense element matrix of a single component for all elements that are computed at once, one MatSetValues call per element
+template<typename RowsFunctionSpaceType, typename ColumnsFunctionSpaceType>
+template<int nDofsPerElement>
+void PartitionedPetscMat<RowsFunctionSpaceType,ColumnsFunctionSpaceType>::
+setValuesElement(int componentNo, const std::array<dof_no_v_t,nDofsPerElement> &dofNosLocal,
+                 const std::array<double_v_t,nDofsPerElement*nDofsPerElement> &values, InsertMode addv)
+{
+  assert(0 <= componentNo && componentNo < matrixComponents_.size());
+
+  std::array<PetscInt,nDofsPerElement> indices;
+
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+  std::array<double,nDofsPerElement*nDofsPerElement> elementValues;
+
+  // loop over the elements of the vectorized values, extract the dense element matrix of every element and set it at once
+  for (int vcComponentNo = 0; vcComponentNo < nVcComponents; vcComponentNo++)
+  {
+    // skip lanes that do not contain an element, i.e. at the end of the element loop
+    if (dofNosLocal[0][vcComponentNo] == -1)
+      continue;
+
+    for (int i = 0; i < nDofsPerElement; i++)
+    {
+      indices[i] = dofNosLocal[i][vcComponentNo];
+    }
+
+    for (int entryNo = 0; entryNo < nDofsPerElement*nDofsPerElement; entryNo++)
+    {
+      elementValues[entryNo] = values[entryNo][vcComponentNo];
+    }
+
+    matrixComponents_[componentNo].setValues(nDofsPerElement, indices.data(), nDofsPerElement, indices.data(), elementValues.data(), addv);
+  }
+#else
+  for (int i = 0; i < nDofsPerElement; i++)
+  {
+    indices[i] = dofNosLocal[i];
+  }
+
+  matrixComponents_[componentNo].setValues(nDofsPerElement, indices.data(), nDofsPerElement, indices.data(), values.data(), addv);
+#endif
+}
+
 //! wrapper of MatZeroRowsColumns, zeros all entries (except possibly the main diagonal) of a set of local rows and columns
 template<typename RowsFunctionSpaceType, typename ColumnsFunctionSpaceType>
 void PartitionedPetscMat<RowsFunctionSpaceType,ColumnsFunctionSpaceType>::
@@ -193,6 +193,11 @@ public:
   template<int nComponents2>
   void restoreExtractedComponent(std::shared_ptr<PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents2>> extractedPartitionedPetscVec, int componentNo);
 
+  //! let the component componentNo use the same Petsc Vec's as the component rhsComponentNo of rhs (no copy), afterwards changed values in one vector are also visible in the other.
+  //! Both vectors are set to global representation. @return if this was possible, it is not possible if one of the vectors has an extracted component or if the partitions differ
+  template<int nComponents2>
+  bool shareComponent(int componentNo, PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents2> &rhs, int rhsComponentNo);
+
   //! wrapper to the PETSc VecGetValues, acting only on the local data, the indices ix are the local dof nos
   void getValues(int componentNo, PetscInt ni, const PetscInt ix[], PetscScalar y[]);
   
@@ -1,5 +1,7 @@
 #include "partition/partitioned_petsc_vec/partitioned_petsc_vec.h"
 
+#include "utility/mpi_utility.h"
+
 //! constructor
 template<typename MeshType,typename BasisFunctionType,int nComponents>
 PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
@@ -45,6 +47,11 @@ PartitionedPetscVecNComponentsStructured(PartitionedPetscVec<FunctionSpace::Func
       }
       vectorGlobal_[componentNo] = rhs.vectorGlobal_[rhsComponentNoBegin + componentNo];
       vectorLocal_[componentNo] = rhs.vectorLocal_[rhsComponentNoBegin + componentNo];
+
+      // count the reference of this object, such that the global Vec is not destroyed while it is still used here, e.g. by shareComponent of rhs,
+      // the local Vec is the local form of the global Vec and lives as long as the global Vec
+      PetscErrorCode ierr;
+      ierr = PetscObjectReference((PetscObject)vectorGlobal_[componentNo]); CHKERRV(ierr);
     }
 
     valuesContiguous_ = rhs.valuesContiguous_;
@@ -1017,6 +1024,104 @@ restoreExtractedComponent(std::shared_ptr<PartitionedPetscVec<FunctionSpace::Fun
   }
 }
 
+template<typename MeshType,typename BasisFunctionType,int nComponents>
+template<int nComponents2>
+bool PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
+shareComponent(int componentNo, PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents2> &rhs, int rhsComponentNo)
+{
+  assert(componentNo >= 0 && componentNo < nComponents);
+  assert(rhsComponentNo >= 0 && rhsComponentNo < nComponents2);
+
+  VLOG(2) << "\"" << this->name_ << "\" shareComponent(componentNo=" << componentNo << ") with \"" << rhs.name() << "\" component " << rhsComponentNo;
+
+  // while a component is extracted, the values are only in the raw array of the contiguous vector
+  if (this->currentRepresentation_ == Partition::values_representation_t::representationInvalid
+      || rhs.currentRepresentation() == Partition::values_representation_t::representationInvalid)
+  {
+    VLOG(1) << "Cannot share component of \"" << this->name_ << "\" and \"" << rhs.name() << "\", because a component is extracted.";
+    return false;
+  }
+
+  // if the Vec's are already shared, there is nothing more to do, this is the case for all but the first call from the mapping manager,
+  // sharing is collective, therefore the result is the same on all ranks and no communication is needed
+  if (vectorGlobal_[componentNo] == rhs.vectorGlobal_[rhsComponentNo])
+  {
+    // bring the current values of both vectors to the global vectors, e.g. if the values are currently in the contiguous representation
+    setRepresentationGlobal();
+    rhs.setRepresentationGlobal();
+    return true;
+  }
+
+  // the Vec's can only be used by both vectors if the parallel layout is the same, i.e. the local and global sizes and the ownership ranges agree on all ranks
+  PetscErrorCode ierr;
+  PetscInt globalSize, rhsGlobalSize, localSizeWithGhosts, rhsLocalSizeWithGhosts;
+  PetscInt ownershipBegin, ownershipEnd, rhsOwnershipBegin, rhsOwnershipEnd;
+  ierr = VecGetSize(vectorGlobal_[componentNo], &globalSize); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  ierr = VecGetSize(rhs.vectorGlobal_[rhsComponentNo], &rhsGlobalSize); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  ierr = VecGetSize(vectorLocal_[componentNo], &localSizeWithGhosts); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  ierr = VecGetSize(rhs.vectorLocal_[rhsComponentNo], &rhsLocalSizeWithGhosts); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  ierr = VecGetOwnershipRange(vectorGlobal_[componentNo], &ownershipBegin, &ownershipEnd); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  ierr = VecGetOwnershipRange(rhs.vectorGlobal_[rhsComponentNo], &rhsOwnershipBegin, &rhsOwnershipEnd); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+
+  bool isLayoutEqual = (globalSize == rhsGlobalSize && localSizeWithGhosts == rhsLocalSizeWithGhosts
+    && ownershipBegin == rhsOwnershipBegin && ownershipEnd == rhsOwnershipEnd);
+
+  // the own Vec is released below, this is only safe if no other object holds a reference to it, e.g. a KSP, a SNES or another vector
+  // that was created with reuseData=true, the only expected references are the own one and the one of the nested vector
+  PetscInt referenceCount = 0;
+  ierr = PetscObjectGetReference((PetscObject)vectorGlobal_[componentNo], &referenceCount); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  bool isOnlyUsedHere = (referenceCount <= (nComponents > 1? 2 : 1));
+
+  // the same holds for the nested vector that is recreated below
+  if (nComponents > 1)
+  {
+    ierr = PetscObjectGetReference((PetscObject)vectorNestedGlobal_, &referenceCount); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+    if (referenceCount > 1)
+      isOnlyUsedHere = false;
+  }
+
+  // the decision has to be the same on all ranks, because VecCreateNest below is collective
+  int canShareLocal = (isLayoutEqual && isOnlyUsedHere);
+  int canShare = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&canShareLocal, &canShare, 1, MPI_INT, MPI_LAND, this->meshPartition_->mpiCommunicator()), "MPI_Allreduce");
+
+  if (!canShare)
+  {
+    VLOG(1) << "Cannot share component of \"" << this->name_ << "\" and \"" << rhs.name() << "\", because the partitions differ"
+      << " or the Vec is still referenced by another object.";
+    return false;
+  }
+
+  // bring the current values of both vectors to the global vectors, e.g. if the values are currently in the contiguous representation
+  setRepresentationGlobal();
+  rhs.setRepresentationGlobal();
+
+  VLOG(1) << "\"" << this->name_ << "\" component " << componentNo << " now uses the Vec of \"" << rhs.name() << "\" component " << rhsComponentNo;
+
+  // use the Petsc Vec's of rhs, the same as the constructor with reuseData=true does for all components,
+  // take a reference of the new global Vec and release the previous one, it is only freed if no other vector uses it,
+  // the local Vec's are the local forms of the global Vec's, which are not referenced in the global representation and live as long as the global Vec's
+  ierr = PetscObjectReference((PetscObject)rhs.vectorGlobal_[rhsComponentNo]); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+
+  // the nested vector contains the previous Vec, destroy it and create it again
+  if (nComponents > 1)
+  {
+    ierr = VecDestroy(&vectorNestedGlobal_); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  }
+
+  ierr = VecDestroy(&vectorGlobal_[componentNo]); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+
+  vectorGlobal_[componentNo] = rhs.vectorGlobal_[rhsComponentNo];
+  vectorLocal_[componentNo] = rhs.vectorLocal_[rhsComponentNo];
+
+  if (nComponents > 1)
+  {
+    ierr = VecCreateNest(this->meshPartition_->mpiCommunicator(), nComponents, NULL, vectorGlobal_.data(), &vectorNestedGlobal_); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+  }
+
+  return true;
+}
+
 template<typename MeshType,typename BasisFunctionType,int nComponents>
 void PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
 extractComponentCopy(int componentNo, std::shared_ptr<PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,1>> extractedPartitionedPetscVec)
@@ -1,5 +1,8 @@
 #include "slot_connection/data_helper/slot_connector_data_helper.h"
 
+#include "control/dihu_context.h"
+#include "mesh/mesh_manager/mesh_manager.h"
+
 /** Helper class that gives the number of connector slots
  */
 template<typename SlotConnectorDataType>
@@ -162,6 +165,9 @@ slotSetGeometryValues(
       << "function space \"" << fieldVariable->functionSpace()->meshName() << "\", "
       << "set dofs " << dofNosLocal << " of geometry field to values " << values;
     fieldVariable->functionSpace()->geometryField().setValues(dofNosLocal, values);
+
+    // the shared assembled matrices of the mesh belong to the old geometry
+    DihuContext::meshManager()->invalidateAssembledMatrices(fieldVariable->functionSpace()->meshName());
   }
   else
   {
@@ -175,6 +181,9 @@ slotSetGeometryValues(
       << "function space \"" << fieldVariable->functionSpace()->meshName() << "\", "
       << "set dofs " << dofNosLocal << " of geometry field to values " << values;
     fieldVariable->functionSpace()->geometryField().setValues(dofNosLocal, values);
+
+    // the shared assembled matrices of the mesh belong to the old geometry
+    DihuContext::meshManager()->invalidateAssembledMatrices(fieldVariable->functionSpace()->meshName());
   }
 }
 
@@ -1,5 +1,8 @@
 #include "slot_connection/data_helper/slot_connector_data_helper.h"
 
+#include "control/dihu_context.h"
+#include "mesh/mesh_manager/mesh_manager.h"
+
 // ----------------------------------
 // vector of vector
 
@@ -231,6 +234,9 @@ slotSetGeometryValues(
       << "in fieldVariable \"" << fieldVariable->name() << "\", function space \"" << fieldVariable->functionSpace()->meshName() << "\""
       << ", set dofs " << dofNosLocal << " to values " << values;
     fieldVariable->functionSpace()->geometryField().setValues(dofNosLocal, values);
+
+    // the shared assembled matrices of the mesh belong to the old geometry
+    DihuContext::meshManager()->invalidateAssembledMatrices(fieldVariable->functionSpace()->meshName());
   }
   else
   {
@@ -244,6 +250,9 @@ slotSetGeometryValues(
       << "in fieldVariable \"" << fieldVariable->name() << "\", function space \"" << fieldVariable->functionSpace()->meshName() << "\""
       << ", set dofs " << dofNosLocal << " to values " << values;
     fieldVariable->functionSpace()->geometryField().setValues(dofNosLocal, values);
+
+    // the shared assembled matrices of the mesh belong to the old geometry
+    DihuContext::meshManager()->invalidateAssembledMatrices(fieldVariable->functionSpace()->meshName());
   }
 }
 
@@ -144,18 +144,25 @@ void SlotsConnection::setTransferDirection(bool term1To2)
 
 void SlotsConnection::updateAvoidCopyIfPossible()
 {
+  // reset all values, because connections may have changed
+  for (Connector &connector : connectorForVisualizerTerm1To2_)
+    connector.avoidCopyIfPossible = false;
+  for (Connector &connector : connectorForVisualizerTerm2To1_)
+    connector.avoidCopyIfPossible = false;
+
   // if field variable gets mapped in both directions, set avoidCopyIfPossible to true
   for (int i = 0; i < connectorForVisualizerTerm1To2_.size(); i++)
   {
     int mappedIndex = connectorForVisualizerTerm1To2_[i].index;
 
     // check if other direction is mapped the same way
-    if (connectorForVisualizerTerm2To1_.size() > mappedIndex)
+    if (mappedIndex >= 0 && connectorForVisualizerTerm2To1_.size() > mappedIndex)
     {
       if (connectorForVisualizerTerm2To1_[mappedIndex].index == i)
       {
+        // set the flag for both connectors, i -> mappedIndex and mappedIndex -> i
         connectorForVisualizerTerm1To2_[i].avoidCopyIfPossible = true;
-        connectorForVisualizerTerm2To1_[i].avoidCopyIfPossible = true;
+        connectorForVisualizerTerm2To1_[mappedIndex].avoidCopyIfPossible = true;
       }
     }
   }
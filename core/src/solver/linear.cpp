@@ -84,9 +84,24 @@ void Linear::setupKsp(KSP ksp)
 
   LOG(DEBUG) << "linear solver type: " << solverType_ << " (" << kspType_ << "), preconditionerType_: " << preconditionerType_ << " (" << pcType_ << ")";
 
+  // set solver and preconditioner type
+  setSolverAndPreconditionerType(ksp, solverType_, preconditionerType_);
+
+  PetscErrorCode ierr;
+  //                                    relative tol,      absolute tol,  diverg tol.,   max_iterations
+  ierr = KSPSetTolerances (ksp, relativeTolerance_, absoluteTolerance_, PETSC_DEFAULT, maxIterations_); CHKERRV(ierr);
+
+}
+
+void Linear::setSolverAndPreconditionerType(KSP ksp, std::string solverType, std::string preconditionerType)
+{
+  KSPType kspType;
+  PCType pcType;
+  parseSolverTypes(solverType, preconditionerType, kspType, pcType);
+
   // set solver type
   PetscErrorCode ierr;
-  ierr = KSPSetType(ksp, kspType_); CHKERRV(ierr);
+  ierr = KSPSetType(ksp, kspType); CHKERRV(ierr);
 
   // set options from command line, this overrides the python config
   ierr = KSPSetFromOptions(ksp); CHKERRV(ierr);
@@ -96,10 +111,10 @@ void Linear::setupKsp(KSP ksp)
   ierr = KSPGetPC(ksp, &pc); CHKERRV(ierr);
 
   // set type of preconditioner
-  ierr = PCSetType(pc, pcType_); CHKERRV(ierr);
+  ierr = PCSetType(pc, pcType); CHKERRV(ierr);
 
   // for multigrid set number of levels and cycle type
-  if (pcType_ == std::string(PCGAMG))
+  if (pcType == std::string(PCGAMG))
   {
     int nLevels = this->specificSettings_.getOptionInt("nLevels", 25, PythonUtility::Positive);
     ierr = PCMGSetLevels(pc, nLevels, NULL); CHKERRV(ierr);
@@ -131,31 +146,27 @@ void Linear::setupKsp(KSP ksp)
     ierr = PCMGSetCycleType(pc, cycleType); CHKERRV(ierr);    
   }
   // set Hypre Options from Python config
-  else if (pcType_ == std::string(PCHYPRE))
+  else if (pcType == std::string(PCHYPRE))
   {
     std::string hypreOptions = this->specificSettings_.getOptionString("hypreOptions", "");
     PetscOptionsInsertString(NULL, hypreOptions.c_str());
     
-    // if one of the hypre preconditioners is in preconditionerType_, pcType_ was set to HYPRE, now set the chosen preconditioner as -pc_hypre_type
-    if (preconditionerType_ == "euclid" || preconditionerType_ == "pilut" || preconditionerType_ == "parasails" 
-      || preconditionerType_ == "boomeramg" || preconditionerType_ == "ams" || preconditionerType_ == "ads")
+    // if one of the hypre preconditioners is in preconditionerType, pcType_ was set to HYPRE, now set the chosen preconditioner as -pc_hypre_type
+    if (preconditionerType == "euclid" || preconditionerType == "pilut" || preconditionerType == "parasails" 
+      || preconditionerType == "boomeramg" || preconditionerType == "ams" || preconditionerType == "ads")
     {
 #if defined(PETSC_HAVE_HYPRE)
-      ierr = PCHYPRESetType(pc, preconditionerType_.c_str()); CHKERRV(ierr);
+      ierr = PCHYPRESetType(pc, preconditionerType.c_str()); CHKERRV(ierr);
 #else
       LOG(ERROR) << "Petsc is not compiled with HYPRE!";
 #endif
       
-      LOG(DEBUG) << "set pc_hypre_type to " << preconditionerType_;
+      LOG(DEBUG) << "set pc_hypre_type to " << preconditionerType;
     }
   }
 
   // set options from command line, this overrides the python config
   ierr = PCSetFromOptions(pc); CHKERRV(ierr);
-
-  //                                    relative tol,      absolute tol,  diverg tol.,   max_iterations
-  ierr = KSPSetTolerances (ksp, relativeTolerance_, absoluteTolerance_, PETSC_DEFAULT, maxIterations_); CHKERRV(ierr);
-
 }
 
 void Linear::parseSolverTypes(std::string solverType, std::string preconditionerType, KSPType &kspType, PCType &pcType)
@@ -191,6 +202,10 @@ void Linear::parseSolverTypes(std::string solverType, std::string preconditioner
   {
     pcType = PCBJACOBI;
   }
+  else if (preconditionerType == "fieldsplit")
+  {
+    pcType = PCFIELDSPLIT;
+  }
   // the hypre boomeramg as the only solver does not provide the correct solution 
   else if (preconditionerType == "pchypre")
   {
@@ -44,6 +44,10 @@ public:
   //! @param pcType [out]
   static void parseSolverTypes(std::string solverType, std::string preconditionerType, KSPType &kspType, PCType &pcType);
 
+  //! set the solver and preconditioner type to the given KSP object, including the multigrid and hypre options of the settings of this solver,
+  //! this is also used for the sub solvers of block preconditioners, e.g. fieldsplit
+  void setSolverAndPreconditionerType(KSP ksp, std::string solverType, std::string preconditionerType);
+
 protected:
 
   //! parse options from settings
@@ -28,4 +28,9 @@ std::string Solver::name()
   return name_;
 }
 
+PythonConfig Solver::specificSettings()
+{
+  return specificSettings_;
+}
+
 } // namespace
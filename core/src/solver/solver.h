@@ -26,6 +26,9 @@ public:
   //! get the name of the solver
   std::string name();
 
+  //! get the python config of the solver, this can be used to create another solver object with the same settings
+  PythonConfig specificSettings();
+
 protected:
 
   PythonConfig specificSettings_;   //< the python config dict
@@ -54,6 +54,9 @@ public:
   //! get the boundary conditions data organized by component
   const std::array<BoundaryConditionsForComponent, nComponents> &boundaryConditionsByComponent() const;
 
+  //! get the number of times the boundary condition dofs or prescribed values were set, this allows to detect if data that depends on the prescribed values is outdated
+  int prescribedValuesChangeCounter() const;
+
 protected:
 
   //! fill auxiliary ghost element data structures, this is only needed for Dirichlet boundary conditions on scalar fields
@@ -86,6 +89,7 @@ protected:
   std::array<BoundaryConditionsForComponent, nComponents> boundaryConditionsByComponent_;   //< the local boundary condition data organized by component, entries are sorted by dofNoLocal, without ghost dofs
 
   std::string filenameOutput_;                                  //< output filename for the vtk file that will contain all Dirichlet boundary conditions for visualization
+  int prescribedValuesChangeCounter_ = 0;                       //< incremented whenever the boundary condition dofs or the prescribed values change
 };
 
 template<typename FunctionSpaceType, int nComponents>
@@ -375,6 +375,8 @@ generateBoundaryConditionsByComponent()
       boundaryConditionsByComponent_[componentNo].values[i] = dofNosValues[i].second;
     }
   }
+
+  prescribedValuesChangeCounter_++;
 }
 
 //! add boundary conditions to the currently present boundary conditions
@@ -575,6 +577,13 @@ boundaryConditionsByComponent() const
   return boundaryConditionsByComponent_;
 }
 
+template<typename FunctionSpaceType,int nComponents>
+int DirichletBoundaryConditionsBase<FunctionSpaceType,nComponents>::
+prescribedValuesChangeCounter() const
+{
+  return prescribedValuesChangeCounter_;
+}
+
 template<typename FunctionSpaceType, int nComponents>
 std::ostream &operator<<(std::ostream &stream, const typename DirichletBoundaryConditionsBase<FunctionSpaceType,nComponents>::BoundaryConditionsForComponent rhs)
 {
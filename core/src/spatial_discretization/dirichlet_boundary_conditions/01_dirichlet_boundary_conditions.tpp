@@ -644,6 +644,9 @@ updatePrescribedValuesFromSolution(std::shared_ptr<FieldVariable::FieldVariable<
     LOG(DEBUG) << "set all values for component " << componentNo << ": " << solutionValuesComponent << ", dofs: " << dofNosLocal;
   }
 
+  // the prescribed values changed, data that was computed from the previous values, e.g. rhs summands of time stepping schemes, is outdated
+  this->prescribedValuesChangeCounter_++;
+
   // set foreignGhostElements_
   // std::map<int,std::vector<GhostElement>> foreignGhostElements_;   //< ghost elements that are normal elements on this rank, key is the rankNo of the rank to send them to
   // std::vector<GhostElement> ownGhostElements_;   //< the ghost elements for this rank
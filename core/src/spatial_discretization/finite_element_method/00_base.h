@@ -6,6 +6,7 @@
 #include "interfaces/runnable.h"
 #include "interfaces/multipliable.h"
 #include "output_writer/manager.h"
+#include "spatial_discretization/finite_element_method/matrix_free_operator.h"
 
 //#define QUADRATURE_TEST    //< if evaluation of quadrature accuracy takes place
 //#define EXACT_QUADRATURE Quadrature::Gauss<20>
@@ -65,6 +66,16 @@ protected:
   //! initialize the coordinates in PETSc that are needed for AMG solvers
   void setInformationToPreconditioner();
 
+  //! parse the option "matrixFree" and check if the matrix-free operator can be used for this function space and equation
+  void initializeMatrixFree();
+
+  //! set the jacobi preconditioner if a preconditioner is selected that cannot be used with the MatShell of the matrix-free operators
+  void setMatrixFreePreconditioner(std::shared_ptr<KSP> ksp);
+
+  //! get the key under which the assembled matrix matrixName ("stiffnessMatrix" or "massMatrix") is shared in the mesh manager,
+  //! returns false if the option "reuseAssembledMatrices" is not set or the matrix depends on more than the mesh, the equation and a constant prefactor
+  bool assembledMatrixKey(std::string matrixName, std::string &key);
+
   //! read in rhs values from config and creates a FE rhs vector out of it
   virtual void setRightHandSide() = 0;
 
@@ -90,6 +101,10 @@ protected:
   SpatialParameter<FunctionSpaceType,double> prefactor_;      //< the prefactor paramater that can be different for every element
 
   bool updatePrescribedValuesFromSolution_ = false;           //< this is an option, where the prescribed values of DirichletBC are changed before the solve() to the values that are then stored in solution, i.e. the initial values
+  bool reuseAssembledMatrices_ = false;                       //< option "reuseAssembledMatrices", if the stiffness and mass matrices should be shared with other FiniteElementMethod objects on the same mesh instead of assembling them again
+
+  std::shared_ptr<MatrixFreeOperator<FunctionSpaceType,QuadratureType>> matrixFreeStiffnessOperator_;   //< the operator that applies the stiffness matrix without assembling it, only set if option "matrixFree" is True
+  std::shared_ptr<MatrixFreeOperator<FunctionSpaceType,QuadratureType>> matrixFreeMassOperator_;        //< the operator that applies the mass matrix without assembling it, only set if option "matrixFree" is True and the mass matrix is needed
 
   bool initialized_;                          //< if initialize was already called on this object, then further calls to initialize() have no effect
 };
@@ -5,11 +5,15 @@
 #include <petscksp.h>
 #include <memory>
 #include <cassert>
+#include <iomanip>
+#include <sstream>
 
 #include "easylogging++.h"
 
 #include "control/types.h"
 #include "utility/python_utility.h"
+#include "utility/string_utility.h"
+#include "utility/math_utility.h"
 
 #include "mesh/structured_regular_fixed.h"
 #include "basis_function/lagrange.h"
@@ -79,7 +83,8 @@ initialize()
   if (initialized_)
     return;
 
-  data_.initialize();
+  // check if the stiffness matrix should be applied matrix-free, then it will not be allocated by data_.initialize()
+  initializeMatrixFree();
 
   if (specificSettings_.hasKey("updatePrescribedValuesFromSolution"))
   {
@@ -87,23 +92,62 @@ initialize()
     LOG(DEBUG) << "set updatePrescribedValuesFromSolution = " << updatePrescribedValuesFromSolution_;
   }
 
-  // assemble stiffness matrix
-  Control::PerformanceMeasurement::start("durationSetStiffnessMatrix");
+  // parse if the assembled stiffness and mass matrices should be shared with other objects on the same mesh
+  reuseAssembledMatrices_ = specificSettings_.getOptionBool("reuseAssembledMatrices", false);
 
   // initialize spatial parameter prefactor
   prefactor_.initialize(specificSettings_, "prefactor", 1.0, this->data_.functionSpace());
 
-  // compute the stiffness matrix
-  setStiffnessMatrix();
+  // get the stiffness matrix of another object on the same mesh with the same equation and prefactor, if it was already assembled,
+  // then it is shared read-only and data_.initialize() does not allocate own stiffness matrices
+  std::string stiffnessMatrixKey;
+  std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> storedStiffnessMatrix = nullptr;
+  if (!matrixFreeStiffnessOperator_ && assembledMatrixKey("stiffnessMatrix", stiffnessMatrixKey))
+  {
+    storedStiffnessMatrix = context_.meshManager()->template assembledMatrix<PartitionedPetscMat<FunctionSpaceType>>(stiffnessMatrixKey);
+    if (storedStiffnessMatrix)
+      this->data_.setSharedStiffnessMatrix(storedStiffnessMatrix);
+  }
+
+  data_.initialize();
+
+  // assemble stiffness matrix
+  Control::PerformanceMeasurement::start("durationSetStiffnessMatrix");
 
-  // save the stiffness matrix also in the other slot, that will not be overwritten by applyBoundaryConditions
-  PetscErrorCode ierr = MatDuplicate(this->data_.stiffnessMatrix()->valuesGlobal(), MAT_COPY_VALUES,
-                                     &this->data_.stiffnessMatrixWithoutBc()->valuesGlobal()); CHKERRV(ierr);
-  this->data_.stiffnessMatrixWithoutBc()->assembly(MAT_FINAL_ASSEMBLY);
+  if (matrixFreeStiffnessOperator_)
+  {
+    // precompute the geometric factors instead of assembling the stiffness matrix
+    matrixFreeStiffnessOperator_->initialize(prefactor_);
+  }
+  else if (storedStiffnessMatrix)
+  {
+    // the stored matrix is only copied if the boundary conditions have to be applied to it, see applyDirichletBoundaryConditions
+    LOG(DEBUG) << "reuse assembled stiffness matrix \"" << stiffnessMatrixKey << "\"";
+  }
+  else
+  {
+    // compute the stiffness matrix
+    setStiffnessMatrix();
+
+    if (!stiffnessMatrixKey.empty())
+    {
+      // share the matrix read-only with this object's boundary conditions and with other objects,
+      // the stiffness matrix is only copied when the boundary conditions modify it, then the stored matrix stays without boundary conditions
+      this->data_.setSharedStiffnessMatrix(this->data_.stiffnessMatrix());
+      context_.meshManager()->storeAssembledMatrix(stiffnessMatrixKey, this->data_.stiffnessMatrix());
+    }
+    else
+    {
+      // save the stiffness matrix also in the other slot, that will not be overwritten by applyBoundaryConditions
+      PetscErrorCode ierr = MatDuplicate(this->data_.stiffnessMatrix()->valuesGlobal(), MAT_COPY_VALUES,
+                                         &this->data_.stiffnessMatrixWithoutBc()->valuesGlobal()); CHKERRV(ierr);
+      this->data_.stiffnessMatrixWithoutBc()->assembly(MAT_FINAL_ASSEMBLY);
+    }
+  }
 
   Control::PerformanceMeasurement::stop("durationSetStiffnessMatrix");
 
-  if (updatePrescribedValuesFromSolution_)
+  if (updatePrescribedValuesFromSolution_ && !matrixFreeStiffnessOperator_)
   {
     PetscUtility::dumpMatrix("stiffnessmatrix_w", "matlab", this->data_.stiffnessMatrixWithoutBc()->valuesGlobal(), MPI_COMM_WORLD);
     PetscUtility::dumpMatrix("stiffnessmatrix", "matlab", this->data_.stiffnessMatrix()->valuesGlobal(), MPI_COMM_WORLD);
@@ -119,6 +163,10 @@ initialize()
   this->applyBoundaryConditions();
   Control::PerformanceMeasurement::stop("durationAssembleBoundaryConditions");
 
+  // log the memory of the shared matrices
+  if (reuseAssembledMatrices_)
+    context_.meshManager()->releaseUnusedAssembledMatrices();
+
   // add this solver to the solvers diagram
   DihuContext::solverStructureVisualizer()->addSolver("FiniteElementMethod");
   DihuContext::solverStructureVisualizer()->setSlotConnectorData(getSlotConnectorData());
@@ -126,12 +174,106 @@ initialize()
   initialized_ = true;
 }
 
+template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
+void FiniteElementMethodBase<FunctionSpaceType,QuadratureType,nComponents,Term>::
+initializeMatrixFree()
+{
+  bool matrixFree = specificSettings_.getOptionBool("matrixFree", false);
+  if (!matrixFree)
+    return;
+
+  typedef MatrixFreeOperator<FunctionSpaceType,QuadratureType> MatrixFreeOperatorType;
+
+  // the matrix-free operators only implement the Laplace operator and the mass matrix for scalar problems on structured meshes with Lagrange basis functions
+  if (!MatrixFreeOperatorType::isSupported() || nComponents != 1 || !Term::hasLaplaceOperator || Term::hasGeneralizedLaplaceOperator)
+  {
+    LOG(WARNING) << specificSettings_ << "[\"matrixFree\"] is True, but the matrix-free operator is only implemented for the Laplace operator with scalar "
+      << "Lagrange basis functions on structured meshes. The stiffness matrix will be assembled.";
+    return;
+  }
+
+  LOG(DEBUG) << "FiniteElementMethod uses matrix-free stiffness operator";
+  matrixFreeStiffnessOperator_ = std::make_shared<MatrixFreeOperatorType>(data_.functionSpace(), MatrixFreeOperatorType::stiffnessOperator, "stiffnessMatrix");
+  data_.setMatrixFree(true);
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
+void FiniteElementMethodBase<FunctionSpaceType,QuadratureType,nComponents,Term>::
+setMatrixFreePreconditioner(std::shared_ptr<KSP> ksp)
+{
+  PetscErrorCode ierr;
+  PC pc;
+  ierr = KSPGetPC(*ksp, &pc); CHKERRV(ierr);
+
+  PetscBool useJacobiPreconditioner, useNoPreconditioner;
+  ierr = PetscObjectTypeCompare((PetscObject)pc, PCJACOBI, &useJacobiPreconditioner); CHKERRV(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)pc, PCNONE, &useNoPreconditioner); CHKERRV(ierr);
+
+  // the MatShell only provides MatMult and MatGetDiagonal
+  if (!useJacobiPreconditioner && !useNoPreconditioner)
+  {
+    LOG(WARNING) << "FiniteElementMethod uses \"matrixFree\": True, where only the preconditioners \"jacobi\" and \"none\" are possible. "
+      << "Now using \"jacobi\".";
+    ierr = PCSetType(pc, PCJACOBI); CHKERRV(ierr);
+  }
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
+bool FiniteElementMethodBase<FunctionSpaceType,QuadratureType,nComponents,Term>::
+assembledMatrixKey(std::string matrixName, std::string &key)
+{
+  if (!reuseAssembledMatrices_)
+    return false;
+
+  // the matrices depend on the mesh, the basis functions, the quadrature and the number of components
+  std::stringstream s;
+  s << data_.functionSpace()->meshName() << "/" << matrixName << "/" << StringUtility::demangle(typeid(FunctionSpaceType).name())
+    << "/" << StringUtility::demangle(typeid(QuadratureType).name()) << "/" << nComponents;
+
+  // the stiffness matrix additionally depends on the equation and the prefactor
+  if (matrixName == "stiffnessMatrix")
+  {
+    // diffusion tensors and material parameters are not part of the key, do not share these stiffness matrices
+    if (Term::hasGeneralizedLaplaceOperator || Term::isSolidMechanics
+        || std::is_same<Term,Equation::Static::LinearElasticity>::value || std::is_same<Term,Equation::Static::LinearElasticityActiveStress>::value)
+    {
+      LOG(DEBUG) << "stiffness matrix of equation " << StringUtility::demangle(typeid(Term).name()) << " cannot be reused";
+      return false;
+    }
+
+    // the stiffness matrix with boundary conditions is created as a copy of the shared matrix, this is only implemented for a single component
+    if (nComponents != 1)
+    {
+      LOG(DEBUG) << "stiffness matrix with " << nComponents << " components cannot be reused";
+      return false;
+    }
+
+    double prefactor = 0;
+    if (!prefactor_.isConstant(data_.functionSpace()->meshPartition()->mpiCommunicator(), prefactor))
+    {
+      LOG(DEBUG) << "stiffness matrix cannot be reused because the prefactor is not constant";
+      return false;
+    }
+
+    s << "/" << StringUtility::demangle(typeid(Term).name()) << "/" << std::setprecision(17) << prefactor;
+  }
+
+  key = s.str();
+  return true;
+}
+
 template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
 void FiniteElementMethodBase<FunctionSpaceType,QuadratureType,nComponents,Term>::
 reset()
 {
   data_.reset();
+  matrixFreeStiffnessOperator_ = nullptr;
+  matrixFreeMassOperator_ = nullptr;
   initialized_ = false;
+
+  // remove shared matrices that are no longer used by any object
+  if (reuseAssembledMatrices_)
+    context_.meshManager()->releaseUnusedAssembledMatrices();
 }
 
 template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
@@ -168,24 +310,36 @@ solve()
     return;
   }
 
-  // get stiffness matrix
-  std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix = data_.stiffnessMatrix();
-
-  // assemble matrix such that all entries are at their place
-  stiffnessMatrix->assembly(MAT_FINAL_ASSEMBLY);
-  
   // get linear solver context from solver manager
   std::shared_ptr<Solver::Linear> linearSolver = this->context_.solverManager()->template solver<Solver::Linear>(
     this->specificSettings_, this->data_.functionSpace()->meshPartition()->mpiCommunicator());
   std::shared_ptr<KSP> ksp = linearSolver->ksp();
   assert(ksp != nullptr);
 
-  // set matrix used for linear system and preconditioner to ksp context
   PetscErrorCode ierr;
-  ierr = KSPSetOperators(*ksp, stiffnessMatrix->valuesGlobal(), stiffnessMatrix->valuesGlobal()); CHKERRV(ierr);
+  if (matrixFreeStiffnessOperator_)
+  {
+    // set the MatShell as system matrix, only preconditioners that do not need the matrix entries can be used
+    Mat &shellMatrix = matrixFreeStiffnessOperator_->valuesGlobal();
+    ierr = KSPSetOperators(*ksp, shellMatrix, shellMatrix); CHKERRV(ierr);
+    setMatrixFreePreconditioner(ksp);
 
-  VLOG(1) << "rhs: " << *data_.rightHandSide();
-  VLOG(1) << "stiffnessMatrix: " << *stiffnessMatrix;
+    VLOG(1) << "rhs: " << *data_.rightHandSide();
+  }
+  else
+  {
+    // get stiffness matrix
+    std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix = data_.stiffnessMatrix();
+
+    // assemble matrix such that all entries are at their place
+    stiffnessMatrix->assembly(MAT_FINAL_ASSEMBLY);
+
+    // set matrix used for linear system and preconditioner to ksp context
+    ierr = KSPSetOperators(*ksp, stiffnessMatrix->valuesGlobal(), stiffnessMatrix->valuesGlobal()); CHKERRV(ierr);
+
+    VLOG(1) << "rhs: " << *data_.rightHandSide();
+    VLOG(1) << "stiffnessMatrix: " << *stiffnessMatrix;
+  }
 
   // initialize coordinates for PETSc geometric multi-grid solvers
   setInformationToPreconditioner();
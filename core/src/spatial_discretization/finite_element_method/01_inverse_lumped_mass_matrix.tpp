@@ -19,20 +19,31 @@ setInverseLumpedMassMatrix()
 
   std::shared_ptr<FunctionSpaceType> functionSpace = std::static_pointer_cast<FunctionSpaceType>(this->data_.functionSpace());
   Mat &inverseLumpedMassMatrix = this->data_.inverseLumpedMassMatrix()->valuesGlobal();
-  Mat &massMatrix = this->data_.massMatrix()->valuesGlobal();
-  //this->data_.massMatrix()->assembly(MAT_FINAL_ASSEMBLY);
 
   PetscErrorCode ierr;
 
-  PetscInt nRows, nColumns;
-  ierr = MatGetSize(massMatrix,&nRows,&nColumns); CHKERRV(ierr);
-  VLOG(1) << "massMatrix nRows " << nRows << " nColumns " << nColumns;
-
   std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,1>> rowSum = std::make_shared<PartitionedPetscVec<FunctionSpaceType,1>>(functionSpace->meshPartition(), "rowSum");
 
-  // In case of linear and bilinear basis functions
-  // store the sum of each row of the matrix in the vector rowSum
-  ierr = MatGetRowSum(massMatrix, rowSum->valuesGlobal()); CHKERRV(ierr);
+  if (this->matrixFreeMassOperator_)
+  {
+    // the row sums are the mass matrix applied to a vector of ones
+    std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,1>> ones = std::make_shared<PartitionedPetscVec<FunctionSpaceType,1>>(functionSpace->meshPartition(), "ones");
+    ierr = VecSet(ones->valuesGlobal(), 1.0); CHKERRV(ierr);
+    this->matrixFreeMassOperator_->apply(ones->valuesGlobal(), rowSum->valuesGlobal(), false);
+  }
+  else
+  {
+    Mat &massMatrix = this->data_.massMatrix()->valuesGlobal();
+    //this->data_.massMatrix()->assembly(MAT_FINAL_ASSEMBLY);
+
+    PetscInt nRows, nColumns;
+    ierr = MatGetSize(massMatrix,&nRows,&nColumns); CHKERRV(ierr);
+    VLOG(1) << "massMatrix nRows " << nRows << " nColumns " << nColumns;
+
+    // In case of linear and bilinear basis functions
+    // store the sum of each row of the matrix in the vector rowSum
+    ierr = MatGetRowSum(massMatrix, rowSum->valuesGlobal()); CHKERRV(ierr);
+  }
 
   // for the inverse matrix, replace each entry in rowSum by its reciprocal
   ierr = VecReciprocal(rowSum->valuesGlobal()); CHKERRV(ierr);
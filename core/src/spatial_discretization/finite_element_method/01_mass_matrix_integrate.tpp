@@ -6,6 +6,7 @@
 #include <petscsys.h>
 
 #include "quadrature/tensor_product.h"
+#include "spatial_discretization/quadrature_point_cache/quadrature_point_cache.h"
 #include "spatial_discretization/finite_element_method/integrand/integrand_mass_matrix.h"
 
 namespace SpatialDiscretization
@@ -55,6 +56,17 @@ setMassMatrix()
 
   element_no_t nElementsLocal = functionSpace->nElementsLocal();
 
+  // cache of the element jacobians at the quadrature points, only used for regular fixed meshes where all elements have the same jacobians
+  QuadraturePointCache<FunctionSpaceType,QuadratureDD> quadraturePointCache;
+  quadraturePointCache.reset(nElementsLocal);
+
+  // element matrix with all entries zero, used to initialize the sparsity pattern of the matrix
+  std::array<double_v_t,nDofsPerElement*nDofsPerElement> zeroValues;
+  zeroValues.fill(0.0);
+
+  // element matrix of a single component, to be set at once in the matrix
+  std::array<double_v_t,nDofsPerElement*nDofsPerElement> elementValues;
+
   // initialize values to zero
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
@@ -79,21 +91,10 @@ setMassMatrix()
 
     std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
 
-    for (int i = 0; i < nDofsPerElement; i++)
+    // set the whole element matrix at once for every component (1,...,D^2 for solid mechanics)
+    for (int componentNo = 0; componentNo < nComponents*nComponents; componentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
-      {
-        // loop over components (1,...,D for solid mechanics)
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
-        {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
-          {
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
-
-            massMatrix->setValue(componentNo, dofNosLocal[i], dofNosLocal[j], 0, INSERT_VALUES);
-          }
-        }
-      }
+      massMatrix->setValuesElement(componentNo, dofNosLocal, zeroValues, INSERT_VALUES);
     }
   }
   massMatrix->assembly(MAT_FLUSH_ASSEMBLY);
@@ -123,8 +124,10 @@ setMassMatrix()
     std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
 
     // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
-    std::array<Vec3_v_t,FunctionSpaceType::nDofsPerElement()> geometry;
-    functionSpace->getElementGeometry(elementNoLocalv, geometry);
+    // for regular fixed meshes the jacobians of the first element are reused and the geometry does not need to be retrieved
+    std::array<Vec3_v_t,FunctionSpaceType::nDofsPerElement()> geometry{};
+    if (!quadraturePointCache.isJacobianStored(elementNoLocal))
+      functionSpace->getElementGeometry(elementNoLocalv, geometry);
 
     // compute integral
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
@@ -133,7 +136,7 @@ setMassMatrix()
       std::array<double,D> xi = samplingPoints[samplingPointIndex];
 
       // compute the 3xD jacobian of the parameter space to world space mapping
-      auto jacobian = FunctionSpaceType::computeJacobian(geometry, xi);
+      auto jacobian = quadraturePointCache.jacobian(elementNoLocal, samplingPointIndex, geometry);
 
       // get evaluations of integrand which is defined in another class
       evaluationsArray[samplingPointIndex] = IntegrandMassMatrix<D,EvaluationsType,FunctionSpaceType,nComponents,double_v_t,dof_no_v_t,Term>::evaluateIntegrand(jacobian,xi);
@@ -143,32 +146,27 @@ setMassMatrix()
     // integrate all values for the (i,j) dof pairs at once
     EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
 
-    // perform integration and add to entry in rhs vector
-    for (int i = 0; i < nDofsPerElement; i++)
+    // add the entries to the mass matrix, one dense element matrix per component (1,...,D^2 for solid mechanics)
+    for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
+      for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
       {
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
+        int componentNo = rowComponentNo*nComponents + columnComponentNo;
+
+        // extract the entries of the current component from the integrated values of all (i,j) dof pairs
+        for (int i = 0; i < nDofsPerElement; i++)
         {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
+          for (int j = 0; j < nDofsPerElement; j++)
           {
-            // integrate value and set entry in discretization matrix
-            double_v_t integratedValue = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
-
-            // get local dof no
-            dof_no_v_t dofINoLocal = dofNosLocal[i];
-            dof_no_v_t dofJNoLocal = dofNosLocal[j];
-
-            // add the entry in the stiffness matrix, for all dofs of the vectorized values at once,
-            // i.e. K_dofINoLocal[0],dofJNoLocal[0] = value[0]
-            // i.e. K_dofINoLocal[1],dofJNoLocal[1] = value[1], etc.
-            // Note that K_dofINoLocal[0],dofJNoLocal[1] would be potentially zero, the contributions are considered element-wise
-            massMatrix->setValue(componentNo, dofINoLocal, dofJNoLocal, integratedValue, ADD_VALUES);
+            elementValues[i*nDofsPerElement + j] = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
           }
         }
-      }  // j
-    }  // i
+
+        // add the element matrix of all elements of the vectorized values, i.e. for elementNoLocalv[0], elementNoLocalv[1], etc.,
+        // with one call to MatSetValues per element
+        massMatrix->setValuesElement(componentNo, dofNosLocal, elementValues, ADD_VALUES);
+      }
+    }
   }  // elementNoLocalv
 
   // merge local changes in parallel and assemble the matrix (MatAssemblyBegin, MatAssemblyEnd)
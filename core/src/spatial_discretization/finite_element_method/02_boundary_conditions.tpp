@@ -7,6 +7,7 @@
 
 #include "quadrature/tensor_product.h"
 #include "utility/vector_operators.h"
+#include "utility/mpi_utility.h"
 
 namespace SpatialDiscretization
 {
@@ -160,17 +161,58 @@ applyDirichletBoundaryConditions()
     updateMatrixAndRightHandSide = true;
   }
 
-  if (updateMatrixAndRightHandSide)
+  if (updateMatrixAndRightHandSide && this->matrixFreeStiffnessOperator_)
+  {
+    // in matrix-free mode, the operator replaces rows and columns of Dirichlet BC dofs by the identity when it is applied
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> rightHandSide = this->data_.rightHandSide();
+    this->matrixFreeStiffnessOperator_->setBoundaryConditionDofs(dirichletBoundaryConditions_->boundaryConditionNonGhostDofLocalNos());
+
+    // compute the vector of prescribed values, all other entries are zero
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> prescribedValues
+      = this->data_.functionSpace()->template createFieldVariable<nComponents>("prescribedValues");
+    prescribedValues->zeroEntries();
+    dirichletBoundaryConditions_->applyInVector(prescribedValues);
+
+    // add terms with the operator without boundary conditions to the rhs, rhs -= A*prescribedValues
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> operatorTimesPrescribedValues
+      = this->data_.functionSpace()->template createFieldVariable<nComponents>("operatorTimesPrescribedValues");
+    this->matrixFreeStiffnessOperator_->apply(prescribedValues->valuesGlobal(), operatorTimesPrescribedValues->valuesGlobal(), false);
+
+    PetscErrorCode ierr;
+    ierr = VecAXPY(rightHandSide->valuesGlobal(), -1, operatorTimesPrescribedValues->valuesGlobal()); CHKERRV(ierr);
+    dirichletBoundaryConditionsApplied_ = true;
+
+    // set prescribed values in rhs
+    dirichletBoundaryConditions_->applyInRightHandSide(rightHandSide, rightHandSide);
+  }
+  else if (updateMatrixAndRightHandSide)
   {
     // get abbreviations
     std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> rightHandSide = this->data_.rightHandSide();
+    bool systemMatrixAlreadySet = this->systemMatrixAlreadySet_;
+
+    // the stiffness matrix may be shared read-only with other objects on the same mesh (option "reuseAssembledMatrices"),
+    // get an own copy only if there are boundary conditions to set in the matrix on any rank, otherwise keep using the shared matrix
+    if (this->data_.stiffnessMatrixIsShared() && !systemMatrixAlreadySet)
+    {
+      int nBoundaryConditionDofsLocal = dirichletBoundaryConditions_->boundaryConditionNonGhostDofLocalNos().size();
+      int nBoundaryConditionDofsGlobal = 0;
+      MPIUtility::handleReturnValue(MPI_Allreduce(&nBoundaryConditionDofsLocal, &nBoundaryConditionDofsGlobal, 1, MPI_INT, MPI_SUM,
+                                                  this->data_.functionSpace()->meshPartition()->mpiCommunicator()), "MPI_Allreduce");
+
+      if (nBoundaryConditionDofsGlobal > 0)
+        this->data_.copySharedStiffnessMatrix();
+      else
+        systemMatrixAlreadySet = true;
+    }
+
     std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix = this->data_.stiffnessMatrix();
     std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrixWithoutBc = this->data_.stiffnessMatrixWithoutBc();
 
     // apply the boundary conditions in stiffness matrix
     // (set bc rows and columns of stiffnessMatrix to 0 and diagonal to 1), also add terms with matrix entries to rhs, for the reading of matrix entries, stiffnessMatrixWithoutBc is used.
     LOG(DEBUG) << "call applyInSystemMatrix from applyBoundaryConditions, this->systemMatrixAlreadySet: " << this->systemMatrixAlreadySet_;
-    dirichletBoundaryConditions_->applyInSystemMatrix(stiffnessMatrixWithoutBc, stiffnessMatrix, rightHandSide, this->systemMatrixAlreadySet_);
+    dirichletBoundaryConditions_->applyInSystemMatrix(stiffnessMatrixWithoutBc, stiffnessMatrix, rightHandSide, systemMatrixAlreadySet);
     this->systemMatrixAlreadySet_ = true;
     dirichletBoundaryConditionsApplied_ = true;
 
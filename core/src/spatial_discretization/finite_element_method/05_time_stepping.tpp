@@ -15,6 +15,7 @@
 #include "utility/petsc_utility.h"
 #include "solver/solver_manager.h"
 #include "solver/linear.h"
+#include "mesh/mesh_manager/mesh_manager.h"
 
 
 namespace SpatialDiscretization
@@ -65,11 +66,45 @@ initializeForImplicitTimeStepping()
   // currently this is executed regardless of explicit or implicit time stepping scheme
 
   // initialize matrices
-  this->data_.initializeMassMatrix();
   this->data_.initializeInverseLumpedMassMatrix();
 
-  // compute the mass matrix
-  this->setMassMatrix();
+  if (this->matrixFreeStiffnessOperator_)
+  {
+    // in matrix-free mode, also the mass matrix is not assembled
+    if (!this->matrixFreeMassOperator_)
+    {
+      typedef MatrixFreeOperator<FunctionSpaceType,QuadratureType> MatrixFreeOperatorType;
+      this->matrixFreeMassOperator_ = std::make_shared<MatrixFreeOperatorType>(this->data_.functionSpace(), MatrixFreeOperatorType::massOperator, "massMatrix");
+      this->matrixFreeMassOperator_->initialize(this->prefactor_);
+    }
+  }
+  else
+  {
+    // get the mass matrix of another object on the same mesh, if it was already assembled
+    std::string massMatrixKey;
+    std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> storedMassMatrix = nullptr;
+    if (this->assembledMatrixKey("massMatrix", massMatrixKey))
+    {
+      storedMassMatrix = this->context_.meshManager()->template assembledMatrix<PartitionedPetscMat<FunctionSpaceType>>(massMatrixKey);
+    }
+
+    if (storedMassMatrix)
+    {
+      LOG(DEBUG) << "reuse assembled mass matrix \"" << massMatrixKey << "\"";
+      this->data_.setMassMatrix(storedMassMatrix);
+    }
+    else
+    {
+      this->data_.initializeMassMatrix();
+
+      // compute the mass matrix
+      this->setMassMatrix();
+
+      // make the matrix available for other objects
+      if (!massMatrixKey.empty())
+        this->context_.meshManager()->storeAssembledMatrix(massMatrixKey, this->data_.massMatrix());
+    }
+  }
 
   // compute inverse lumped mass matrix
   this->setInverseLumpedMassMatrix();
@@ -24,7 +24,6 @@ computeInverseMassMatrixTimesRightHandSide(Vec &result)
 {
   // massMatrix * f_strong = rhs_weak
   Vec &rightHandSide = this->data_.rightHandSide()->valuesGlobal();   // rhs in weak formulation
-  std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> massMatrix = this->data_.massMatrix();
 
   PetscErrorCode ierr;
 
@@ -33,7 +32,17 @@ computeInverseMassMatrixTimesRightHandSide(Vec &result)
   initializeLinearSolver();
 
   // set matrix used for linear system and preconditioner to ksp context
-  ierr = KSPSetOperators(*ksp_, massMatrix->valuesGlobal(), massMatrix->valuesGlobal()); CHKERRV(ierr);
+  if (this->matrixFreeMassOperator_)
+  {
+    Mat &massMatrix = this->matrixFreeMassOperator_->valuesGlobal();
+    ierr = KSPSetOperators(*ksp_, massMatrix, massMatrix); CHKERRV(ierr);
+    this->setMatrixFreePreconditioner(ksp_);
+  }
+  else
+  {
+    std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> massMatrix = this->data_.massMatrix();
+    ierr = KSPSetOperators(*ksp_, massMatrix->valuesGlobal(), massMatrix->valuesGlobal()); CHKERRV(ierr);
+  }
 
   // solve the system, KSP assumes the initial guess is to be zero (and thus zeros it out before solving)
   if (VLOG_IS_ON(1))
@@ -51,15 +60,24 @@ void FiniteElementMethodTimeStepping<FunctionSpaceType, QuadratureType, nCompone
 evaluateTimesteppingRightHandSideExplicit(Vec &input, Vec &output, int timeStepNo, double currentTime)
 {
   // this method computes output = M^{-1}*K*input
-  std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix = this->data_.stiffnessMatrix();
   Vec &rhs = this->data_.rightHandSide()->valuesGlobal();
 
-  // check if matrix and vector sizes match
-  PetscUtility::checkDimensionsMatrixVector(stiffnessMatrix->valuesGlobal(), input);
+  if (this->matrixFreeStiffnessOperator_)
+  {
+    // compute rhs = stiffnessMatrix*input without assembled matrix, boundary conditions are handled by the time stepping scheme
+    this->matrixFreeStiffnessOperator_->apply(input, rhs, false);
+  }
+  else
+  {
+    std::shared_ptr<PartitionedPetscMat<FunctionSpaceType>> stiffnessMatrix = this->data_.stiffnessMatrix();
+
+    // check if matrix and vector sizes match
+    PetscUtility::checkDimensionsMatrixVector(stiffnessMatrix->valuesGlobal(), input);
 
-  // compute rhs = stiffnessMatrix*input
-  PetscErrorCode ierr;
-  ierr = MatMult(stiffnessMatrix->valuesGlobal(), input, rhs); CHKERRV(ierr);
+    // compute rhs = stiffnessMatrix*input
+    PetscErrorCode ierr;
+    ierr = MatMult(stiffnessMatrix->valuesGlobal(), input, rhs); CHKERRV(ierr);
+  }
 
   // compute output = massMatrix^{-1}*rhs
   computeInverseMassMatrixTimesRightHandSide(output);
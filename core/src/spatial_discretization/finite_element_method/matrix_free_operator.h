@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <memory>
+#include <vector>
+#include <array>
+#include <type_traits>
+#include <petscmat.h>
+
+#include "control/types.h"
+#include "control/python_config/spatial_parameter.h"
+#include "function_space/function_space.h"
+#include "mesh/type_traits.h"
+#include "quadrature/quadrature.h"
+#include "quadrature/gauss.h"
+#include "partition/partitioned_petsc_vec/partitioned_petsc_vec.h"
+#include "utility/math_utility.h"
+
+namespace SpatialDiscretization
+{
+
+/** Matrix-free application of the stiffness matrix of the Laplace operator or of the mass matrix of a scalar finite element problem.
+ *  The operator is wrapped in a PETSc matrix of type MATSHELL, such that it can be used with KSP and MatMult instead of the assembled matrix.
+ *
+ *  This is the generic class for function spaces where matrix-free operator application is not implemented (unstructured meshes, Hermite basis functions).
+ *  All methods only output an error.
+ */
+template<typename FunctionSpaceType,typename QuadratureType,typename=typename FunctionSpaceType::Mesh,typename=typename FunctionSpaceType::BasisFunction>
+class MatrixFreeOperator
+{
+public:
+
+  //! which operator is applied
+  enum operator_t {stiffnessOperator, massOperator};
+
+  //! constructor
+  MatrixFreeOperator(std::shared_ptr<FunctionSpaceType> functionSpace, operator_t operatorType, std::string name);
+
+  //! if matrix-free application is implemented for the function space
+  static constexpr bool isSupported() {return false;}
+
+  //! precompute the geometric factors at the quadrature points and create the MatShell
+  void initialize(const SpatialParameter<FunctionSpaceType,double> &prefactor);
+
+  //! set the local non-ghost dofs where Dirichlet boundary conditions are prescribed
+  void setBoundaryConditionDofs(const std::vector<dof_no_t> &boundaryConditionDofNosLocal);
+
+  //! compute output = A*input, if applyBoundaryConditions is set, rows and columns of Dirichlet boundary condition dofs are replaced by the identity
+  void apply(Vec input, Vec output, bool applyBoundaryConditions = true);
+
+  //! get the PETSc MatShell that applies the operator
+  Mat &valuesGlobal();
+
+protected:
+
+  std::string name_;    //< name of the operator, for error messages
+  Mat shellMatrix_;     //< not used, only returned by valuesGlobal()
+};
+
+/** Matrix-free operator for Lagrange basis functions on structured meshes.
+ *
+ *  The element contributions are computed with sum factorization: The element-local values are interpolated to the tensor product quadrature points
+ *  by applying the 1D basis functions (or their derivatives) one dimension at a time. Then the precomputed geometric factors are applied and the result
+ *  is integrated against the test functions by the transposed 1D operations. For nDofsPerElement1D ~ nQuadraturePoints1D ~ n this needs O(D*n^(D+1))
+ *  instead of O(n^(2D)) operations per element.
+ *
+ *  The geometric factors w*|J|*(J^T J)^{-1} (stiffness) or w*|J| (mass) are stored for every local element and quadrature point, for structured regular fixed
+ *  meshes only for one element. Thus, the memory scales with the number of elements instead of the number of matrix non-zeros.
+ *  The computed operators equal the assembled matrices of setStiffnessMatrix() (including the negative sign and the prefactor) and setMassMatrix().
+ *  If QuadratureType is Quadrature::None (for meshes where stencils are used), Gauss quadrature with order+1 points is used, which is exact for both operators.
+ */
+template<typename MeshType,int order,typename QuadratureType>
+class MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>
+{
+public:
+
+  typedef FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>> FunctionSpaceType;
+  typedef std::conditional_t<std::is_same<QuadratureType,Quadrature::None>::value, Quadrature::Gauss<order+1>, QuadratureType> Quadrature1D;   //< the 1D quadrature rule of the tensor product quadrature
+
+  //! which operator is applied
+  enum operator_t {stiffnessOperator, massOperator};
+
+  //! constructor
+  MatrixFreeOperator(std::shared_ptr<FunctionSpaceType> functionSpace, operator_t operatorType, std::string name);
+
+  //! destructor, destroys the MatShell
+  ~MatrixFreeOperator();
+
+  //! if matrix-free application is implemented for the function space
+  static constexpr bool isSupported() {return true;}
+
+  //! precompute the geometric factors at the quadrature points and create the MatShell, for the stiffness operator the prefactor is included
+  void initialize(const SpatialParameter<FunctionSpaceType,double> &prefactor);
+
+  //! set the local non-ghost dofs where Dirichlet boundary conditions are prescribed
+  void setBoundaryConditionDofs(const std::vector<dof_no_t> &boundaryConditionDofNosLocal);
+
+  //! compute output = A*input, if applyBoundaryConditions is set, rows and columns of Dirichlet boundary condition dofs are replaced by the identity
+  void apply(Vec input, Vec output, bool applyBoundaryConditions = true);
+
+  //! get the PETSc MatShell that applies the operator
+  Mat &valuesGlobal();
+
+protected:
+
+  static constexpr int D = MeshType::dim();                                           //< dimension of the mesh
+  static constexpr int nDofsPerElement1D = order+1;                                   //< number of dofs of an element in one coordinate direction
+  static constexpr int nDofsPerElement = MathUtility::powConst(nDofsPerElement1D, D); //< number of dofs of an element
+  static constexpr int nQuadraturePoints1D = Quadrature1D::numberEvaluations();     //< number of quadrature points in one coordinate direction
+  static constexpr int nQuadraturePoints = MathUtility::powConst(nQuadraturePoints1D, D);  //< number of quadrature points of an element
+  static constexpr int nBufferEntries = MathUtility::powConst(nDofsPerElement1D > nQuadraturePoints1D? nDofsPerElement1D : nQuadraturePoints1D, D);  //< size of the intermediate tensors of sum factorization
+
+  //! PETSc callback for MatMult of the MatShell
+  static PetscErrorCode matMult(Mat matrix, Vec input, Vec output);
+
+  //! PETSc callback for MatGetDiagonal of the MatShell, this is needed for the Jacobi preconditioner
+  static PetscErrorCode matGetDiagonal(Mat matrix, Vec diagonal);
+
+  //! apply a 1D matrix (nOut x nIn, row-major) along dimension dimNo of the tensor in (with dimension 0 being the fastest index), write to out, update shape
+  static void applyAlongDimension(const double *matrix, int nOut, int nIn, int dimNo, std::array<int,D> &shape, const double *in, double *out);
+
+  //! interpolate the element values to the quadrature points, using the derivatives of the basis functions in dimension derivativeDimNo (or -1 for no derivative)
+  void interpolate(const double *elementValues, int derivativeDimNo, double *quadraturePointValues);
+
+  //! integrate the values at the quadrature points against the test functions (or their derivatives in dimension derivativeDimNo) and add to the element values
+  void integrateAndAdd(const double *quadraturePointValues, int derivativeDimNo, double *elementValues);
+
+  //! compute the element contribution output = A_e*input of a single element
+  void applyElement(element_no_t elementNoLocal, const std::array<double,nDofsPerElement> &input, std::array<double,nDofsPerElement> &output);
+
+  //! compute the geometric factors at the quadrature points of the given element and store them in geometricFactors_
+  void computeGeometricFactors(element_no_t elementNoLocal, double *geometricFactors);
+
+  //! compute the diagonal of the operator, without boundary conditions, store in diagonal_
+  void computeDiagonal();
+
+  std::shared_ptr<FunctionSpaceType> functionSpace_;    //< the function space on which the operator is defined
+  operator_t operatorType_;                             //< if this is the stiffness or the mass operator
+  std::string name_;                                    //< name of the operator, for debugging output
+  Mat shellMatrix_;                                     //< the PETSc MatShell that calls matMult and matGetDiagonal
+  bool initialized_;                                    //< if initialize() has been called
+
+  std::array<double,nQuadraturePoints1D*nDofsPerElement1D> basis1D_;              //< values of the 1D basis functions at the quadrature points, basis1D_[q*nDofsPerElement1D + i] = phi_i(xi_q)
+  std::array<double,nQuadraturePoints1D*nDofsPerElement1D> derivative1D_;         //< derivatives of the 1D basis functions at the quadrature points, same layout as basis1D_
+  std::array<double,nDofsPerElement1D*nQuadraturePoints1D> basis1DTransposed_;    //< transposed basis1D_, basis1DTransposed_[i*nQuadraturePoints1D + q] = phi_i(xi_q)
+  std::array<double,nDofsPerElement1D*nQuadraturePoints1D> derivative1DTransposed_;  //< transposed derivative1D_
+
+  int nGeometricFactorsPerPoint_;                       //< number of stored geometric factors per quadrature point, D*(D+1)/2 for the packed symmetric matrix of the stiffness operator, 1 for the mass operator
+  bool allElementsHaveSameGeometry_;                    //< if the geometric factors are the same for all elements (structured regular fixed meshes), then they are only stored for one element
+  std::vector<double> geometricFactors_;                //< the geometric factors for all elements and quadrature points, including the quadrature weights
+  std::vector<double> elementPrefactors_;               //< the factor for every element, -prefactor for the stiffness operator and 1 for the mass operator
+
+  std::vector<dof_no_t> boundaryConditionDofNosLocal_;  //< local non-ghost dofs with Dirichlet boundary conditions, their rows and columns are replaced by the identity
+  std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,1>> input_;      //< work vector with ghost values for the input of apply()
+  std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,1>> output_;     //< work vector with ghost values for the output of apply()
+  std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,1>> diagonal_;   //< the diagonal of the operator without boundary conditions
+};
+
+}  // namespace
+
+#include "spatial_discretization/finite_element_method/matrix_free_operator.tpp"
@@ -0,0 +1,607 @@
+#include "spatial_discretization/finite_element_method/matrix_free_operator.h"
+
+#include <Python.h>  // has to be the first included header
+#include <cmath>
+#include <algorithm>
+
+#include "easylogging++.h"
+#include "quadrature/tensor_product.h"
+#include "utility/string_utility.h"
+#include "utility/vector_operators.h"
+
+namespace SpatialDiscretization
+{
+
+// ---- generic class for unsupported function spaces ----
+
+template<typename FunctionSpaceType,typename QuadratureType,typename Dummy1,typename Dummy2>
+MatrixFreeOperator<FunctionSpaceType,QuadratureType,Dummy1,Dummy2>::
+MatrixFreeOperator(std::shared_ptr<FunctionSpaceType> functionSpace, operator_t operatorType, std::string name) :
+  name_(name), shellMatrix_(PETSC_NULL)
+{
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,typename Dummy1,typename Dummy2>
+void MatrixFreeOperator<FunctionSpaceType,QuadratureType,Dummy1,Dummy2>::
+initialize(const SpatialParameter<FunctionSpaceType,double> &prefactor)
+{
+  LOG(FATAL) << "Matrix-free operator \"" << name_ << "\" is only implemented for Lagrange basis functions on structured meshes, "
+    << "not for " << StringUtility::demangle(typeid(FunctionSpaceType).name()) << ".";
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,typename Dummy1,typename Dummy2>
+void MatrixFreeOperator<FunctionSpaceType,QuadratureType,Dummy1,Dummy2>::
+setBoundaryConditionDofs(const std::vector<dof_no_t> &boundaryConditionDofNosLocal)
+{
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,typename Dummy1,typename Dummy2>
+void MatrixFreeOperator<FunctionSpaceType,QuadratureType,Dummy1,Dummy2>::
+apply(Vec input, Vec output, bool applyBoundaryConditions)
+{
+  LOG(FATAL) << "Matrix-free operator \"" << name_ << "\" is not implemented for " << StringUtility::demangle(typeid(FunctionSpaceType).name()) << ".";
+}
+
+template<typename FunctionSpaceType,typename QuadratureType,typename Dummy1,typename Dummy2>
+Mat &MatrixFreeOperator<FunctionSpaceType,QuadratureType,Dummy1,Dummy2>::
+valuesGlobal()
+{
+  return shellMatrix_;
+}
+
+// ---- Lagrange basis functions on structured meshes ----
+
+template<typename MeshType,int order,typename QuadratureType>
+MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+MatrixFreeOperator(std::shared_ptr<FunctionSpaceType> functionSpace, operator_t operatorType, std::string name) :
+  functionSpace_(functionSpace), operatorType_(operatorType), name_(name), shellMatrix_(PETSC_NULL), initialized_(false)
+{
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+~MatrixFreeOperator()
+{
+  if (shellMatrix_ != PETSC_NULL)
+  {
+    PetscErrorCode ierr;
+    ierr = MatDestroy(&shellMatrix_); CHKERRV(ierr);
+  }
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+initialize(const SpatialParameter<FunctionSpaceType,double> &prefactor)
+{
+  if (initialized_)
+    return;
+
+  LOG(DEBUG) << "initialize matrix-free operator \"" << name_ << "\", " << D << "D, "
+    << nDofsPerElement1D << " dofs and " << nQuadraturePoints1D << " quadrature points per element and direction";
+
+  // tabulate the 1D basis functions and their derivatives at the 1D quadrature points
+  std::array<double,nQuadraturePoints1D> samplingPoints1D = Quadrature1D::samplingPoints();
+  for (int q = 0; q < nQuadraturePoints1D; q++)
+  {
+    for (int i = 0; i < nDofsPerElement1D; i++)
+    {
+      basis1D_[q*nDofsPerElement1D + i] = BasisFunction::LagrangeOfOrder<order>::phi(i, samplingPoints1D[q]);
+      derivative1D_[q*nDofsPerElement1D + i] = BasisFunction::LagrangeOfOrder<order>::dphi_dxi(i, samplingPoints1D[q]);
+
+      basis1DTransposed_[i*nQuadraturePoints1D + q] = basis1D_[q*nDofsPerElement1D + i];
+      derivative1DTransposed_[i*nQuadraturePoints1D + q] = derivative1D_[q*nDofsPerElement1D + i];
+    }
+  }
+
+  // compute the geometric factors, for regular fixed meshes all elements have the same geometry and only one element has to be stored
+  const element_no_t nElementsLocal = functionSpace_->nElementsLocal();
+  allElementsHaveSameGeometry_ = std::is_same<MeshType,Mesh::StructuredRegularFixedOfDimension<D>>::value;
+  nGeometricFactorsPerPoint_ = (operatorType_ == stiffnessOperator? D*(D+1)/2 : 1);
+
+  functionSpace_->geometryField().setRepresentationGlobal();
+  functionSpace_->geometryField().startGhostManipulation();   // ensure that local ghost values of geometry field are set
+
+  const element_no_t nElementsWithGeometricFactors = (allElementsHaveSameGeometry_? std::min(1, nElementsLocal) : nElementsLocal);
+  geometricFactors_.resize(nElementsWithGeometricFactors * nQuadraturePoints * nGeometricFactorsPerPoint_);
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsWithGeometricFactors; elementNoLocal++)
+  {
+    computeGeometricFactors(elementNoLocal, geometricFactors_.data() + elementNoLocal*nQuadraturePoints*nGeometricFactorsPerPoint_);
+  }
+
+  // store the prefactor of every element, the stiffness matrix is -prefactor * ∫ ∇phi_i • ∇phi_j dx, the mass matrix has no prefactor
+  elementPrefactors_.resize(nElementsLocal);
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    if (operatorType_ == stiffnessOperator)
+      elementPrefactors_[elementNoLocal] = -prefactor.value(elementNoLocal);
+    else
+      elementPrefactors_[elementNoLocal] = 1.0;
+  }
+
+  // create work vectors that have ghost values
+  auto meshPartition = functionSpace_->meshPartition();
+  input_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,1>>(meshPartition, name_ + "_input");
+  output_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,1>>(meshPartition, name_ + "_output");
+  diagonal_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,1>>(meshPartition, name_ + "_diagonal");
+
+  computeDiagonal();
+
+  // create the MatShell
+  PetscErrorCode ierr;
+  const dof_no_t nDofsLocal = meshPartition->nDofsLocalWithoutGhosts();
+  const global_no_t nDofsGlobal = meshPartition->nDofsGlobal();
+
+  ierr = MatCreateShell(meshPartition->mpiCommunicator(), nDofsLocal, nDofsLocal, nDofsGlobal, nDofsGlobal, this, &shellMatrix_); CHKERRV(ierr);
+  ierr = MatShellSetOperation(shellMatrix_, MATOP_MULT, (void(*)(void))matMult); CHKERRV(ierr);
+  ierr = MatShellSetOperation(shellMatrix_, MATOP_MULT_TRANSPOSE, (void(*)(void))matMult); CHKERRV(ierr);
+  ierr = MatShellSetOperation(shellMatrix_, MATOP_GET_DIAGONAL, (void(*)(void))matGetDiagonal); CHKERRV(ierr);
+  ierr = MatSetOption(shellMatrix_, MAT_SYMMETRIC, PETSC_TRUE); CHKERRV(ierr);
+  ierr = PetscObjectSetName((PetscObject)shellMatrix_, name_.c_str()); CHKERRV(ierr);
+
+  LOG(DEBUG) << "matrix-free operator \"" << name_ << "\" stores " << geometricFactors_.size() << " geometric factors for "
+    << nElementsLocal << " local elements";
+
+  initialized_ = true;
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+computeGeometricFactors(element_no_t elementNoLocal, double *geometricFactors)
+{
+  typedef Quadrature::TensorProduct<D,Quadrature1D> QuadratureDD;
+  std::array<std::array<double,D>,nQuadraturePoints> samplingPoints = QuadratureDD::samplingPoints();
+  std::array<double,nQuadraturePoints1D> weights1D = Quadrature1D::quadratureWeights();
+
+  // get geometry field (node positions) of the element
+  std::array<Vec3,nDofsPerElement> geometry;
+  functionSpace_->getElementGeometry(elementNoLocal, geometry);
+
+  // loop over quadrature points, the x index is the fastest
+  for (int quadraturePointNo = 0; quadraturePointNo < nQuadraturePoints; quadraturePointNo++)
+  {
+    // compute the quadrature weight of the tensor product quadrature
+    double weight = 1.0;
+    for (int dimNo = 0, index = quadraturePointNo; dimNo < D; dimNo++, index /= nQuadraturePoints1D)
+    {
+      weight *= weights1D[index % nQuadraturePoints1D];
+    }
+
+    // compute the 3xD jacobian of the parameter space to world space mapping and the metric tensor g = J^T J
+    std::array<Vec3,D> jacobian = FunctionSpaceType::computeJacobian(geometry, samplingPoints[quadraturePointNo]);
+
+    std::array<std::array<double,3>,3> metric{};
+    for (int i = 0; i < D; i++)
+    {
+      for (int j = 0; j < D; j++)
+      {
+        metric[i][j] = jacobian[i][0]*jacobian[j][0] + jacobian[i][1]*jacobian[j][1] + jacobian[i][2]*jacobian[j][2];
+      }
+    }
+
+    // compute the determinant and the inverse of the metric tensor
+    double determinant = 0;
+    std::array<std::array<double,3>,3> inverseMetric{};
+    if (D == 1)
+    {
+      determinant = metric[0][0];
+      inverseMetric[0][0] = 1./determinant;
+    }
+    else if (D == 2)
+    {
+      determinant = metric[0][0]*metric[1][1] - metric[0][1]*metric[1][0];
+      inverseMetric[0][0] =  metric[1][1] / determinant;
+      inverseMetric[0][1] = -metric[0][1] / determinant;
+      inverseMetric[1][0] = -metric[1][0] / determinant;
+      inverseMetric[1][1] =  metric[0][0] / determinant;
+    }
+    else
+    {
+      determinant = metric[0][0]*(metric[1][1]*metric[2][2] - metric[1][2]*metric[2][1])
+        - metric[0][1]*(metric[1][0]*metric[2][2] - metric[1][2]*metric[2][0])
+        + metric[0][2]*(metric[1][0]*metric[2][1] - metric[1][1]*metric[2][0]);
+
+      inverseMetric[0][0] = (metric[1][1]*metric[2][2] - metric[1][2]*metric[2][1]) / determinant;
+      inverseMetric[0][1] = (metric[0][2]*metric[2][1] - metric[0][1]*metric[2][2]) / determinant;
+      inverseMetric[0][2] = (metric[0][1]*metric[1][2] - metric[0][2]*metric[1][1]) / determinant;
+      inverseMetric[1][0] = inverseMetric[0][1];
+      inverseMetric[1][1] = (metric[0][0]*metric[2][2] - metric[0][2]*metric[2][0]) / determinant;
+      inverseMetric[1][2] = (metric[0][2]*metric[1][0] - metric[0][0]*metric[1][2]) / determinant;
+      inverseMetric[2][0] = inverseMetric[0][2];
+      inverseMetric[2][1] = inverseMetric[1][2];
+      inverseMetric[2][2] = (metric[0][0]*metric[1][1] - metric[0][1]*metric[1][0]) / determinant;
+    }
+
+    if (determinant <= 0)
+    {
+      LOG(ERROR) << "Matrix-free operator \"" << name_ << "\": Jacobian of element " << elementNoLocal << " is singular at xi="
+        << samplingPoints[quadraturePointNo] << ", geometry: " << geometry;
+    }
+
+    // integration factor |J| = sqrt(det(J^T J)), this is the same as MathUtility::computeIntegrationFactor
+    double integrationFactor = sqrt(determinant);
+
+    double *factors = geometricFactors + quadraturePointNo*nGeometricFactorsPerPoint_;
+    if (operatorType_ == stiffnessOperator)
+    {
+      // store the upper triangle of the symmetric matrix w*|J|*(J^T J)^{-1}, row-wise
+      int entryNo = 0;
+      for (int i = 0; i < D; i++)
+      {
+        for (int j = i; j < D; j++, entryNo++)
+        {
+          factors[entryNo] = weight * integrationFactor * inverseMetric[i][j];
+        }
+      }
+    }
+    else
+    {
+      factors[0] = weight * integrationFactor;
+    }
+  }
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+applyAlongDimension(const double *matrix, int nOut, int nIn, int dimNo, std::array<int,D> &shape, const double *in, double *out)
+{
+  assert(shape[dimNo] == nIn);
+
+  // number of entries with lower and higher index than dimNo
+  int nInner = 1;
+  for (int i = 0; i < dimNo; i++)
+    nInner *= shape[i];
+
+  int nOuter = 1;
+  for (int i = dimNo+1; i < D; i++)
+    nOuter *= shape[i];
+
+  // out[outer][k][inner] = sum_j matrix[k][j] * in[outer][j][inner]
+  for (int outerNo = 0; outerNo < nOuter; outerNo++)
+  {
+    for (int k = 0; k < nOut; k++)
+    {
+      double *result = out + (outerNo*nOut + k)*nInner;
+      for (int innerNo = 0; innerNo < nInner; innerNo++)
+        result[innerNo] = 0;
+
+      for (int j = 0; j < nIn; j++)
+      {
+        const double matrixEntry = matrix[k*nIn + j];
+        const double *value = in + (outerNo*nIn + j)*nInner;
+        for (int innerNo = 0; innerNo < nInner; innerNo++)
+        {
+          result[innerNo] += matrixEntry * value[innerNo];
+        }
+      }
+    }
+  }
+
+  shape[dimNo] = nOut;
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+interpolate(const double *elementValues, int derivativeDimNo, double *quadraturePointValues)
+{
+  std::array<double,nBufferEntries> buffer0, buffer1;
+  std::array<int,D> shape;
+  shape.fill(nDofsPerElement1D);
+
+  std::copy(elementValues, elementValues + nDofsPerElement, buffer0.begin());
+  double *in = buffer0.data();
+  double *out = buffer1.data();
+
+  // sum factorization, contract one dimension after the other
+  for (int dimNo = 0; dimNo < D; dimNo++)
+  {
+    const double *matrix = (dimNo == derivativeDimNo? derivative1D_.data() : basis1D_.data());
+    applyAlongDimension(matrix, nQuadraturePoints1D, nDofsPerElement1D, dimNo, shape, in, out);
+    std::swap(in, out);
+  }
+
+  std::copy(in, in + nQuadraturePoints, quadraturePointValues);
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+integrateAndAdd(const double *quadraturePointValues, int derivativeDimNo, double *elementValues)
+{
+  std::array<double,nBufferEntries> buffer0, buffer1;
+  std::array<int,D> shape;
+  shape.fill(nQuadraturePoints1D);
+
+  std::copy(quadraturePointValues, quadraturePointValues + nQuadraturePoints, buffer0.begin());
+  double *in = buffer0.data();
+  double *out = buffer1.data();
+
+  // sum factorization with the transposed 1D matrices
+  for (int dimNo = 0; dimNo < D; dimNo++)
+  {
+    const double *matrix = (dimNo == derivativeDimNo? derivative1DTransposed_.data() : basis1DTransposed_.data());
+    applyAlongDimension(matrix, nDofsPerElement1D, nQuadraturePoints1D, dimNo, shape, in, out);
+    std::swap(in, out);
+  }
+
+  for (int i = 0; i < nDofsPerElement; i++)
+  {
+    elementValues[i] += in[i];
+  }
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+applyElement(element_no_t elementNoLocal, const std::array<double,nDofsPerElement> &input, std::array<double,nDofsPerElement> &output)
+{
+  const double *geometricFactors = geometricFactors_.data() + (allElementsHaveSameGeometry_? 0 : elementNoLocal*nQuadraturePoints*nGeometricFactorsPerPoint_);
+  const double prefactor = elementPrefactors_[elementNoLocal];
+
+  output.fill(0.0);
+
+  if (operatorType_ == massOperator)
+  {
+    // interpolate values to quadrature points, scale by w*|J| and integrate against the basis functions
+    std::array<double,nQuadraturePoints> values;
+    interpolate(input.data(), -1, values.data());
+
+    for (int quadraturePointNo = 0; quadraturePointNo < nQuadraturePoints; quadraturePointNo++)
+    {
+      values[quadraturePointNo] *= prefactor * geometricFactors[quadraturePointNo];
+    }
+
+    integrateAndAdd(values.data(), -1, output.data());
+  }
+  else
+  {
+    // compute the gradient in parameter space at the quadrature points
+    std::array<std::array<double,nQuadraturePoints>,D> gradient;
+    for (int dimNo = 0; dimNo < D; dimNo++)
+    {
+      interpolate(input.data(), dimNo, gradient[dimNo].data());
+    }
+
+    // multiply by the symmetric matrix w*|J|*(J^T J)^{-1}
+    std::array<std::array<double,nQuadraturePoints>,D> flux;
+    for (int quadraturePointNo = 0; quadraturePointNo < nQuadraturePoints; quadraturePointNo++)
+    {
+      const double *factors = geometricFactors + quadraturePointNo*nGeometricFactorsPerPoint_;
+
+      // unpack the upper triangle
+      std::array<std::array<double,D>,D> matrix;
+      int entryNo = 0;
+      for (int i = 0; i < D; i++)
+      {
+        for (int j = i; j < D; j++, entryNo++)
+        {
+          matrix[i][j] = factors[entryNo];
+          matrix[j][i] = factors[entryNo];
+        }
+      }
+
+      for (int i = 0; i < D; i++)
+      {
+        double value = 0;
+        for (int j = 0; j < D; j++)
+        {
+          value += matrix[i][j] * gradient[j][quadraturePointNo];
+        }
+        flux[i][quadraturePointNo] = prefactor * value;
+      }
+    }
+
+    // integrate against the gradients of the test functions
+    for (int dimNo = 0; dimNo < D; dimNo++)
+    {
+      integrateAndAdd(flux[dimNo].data(), dimNo, output.data());
+    }
+  }
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+computeDiagonal()
+{
+  const element_no_t nElementsLocal = functionSpace_->nElementsLocal();
+
+  PetscErrorCode ierr;
+  diagonal_->setRepresentationGlobal();
+  diagonal_->startGhostManipulation();
+  ierr = VecZeroEntries(diagonal_->valuesLocal()); CHKERRV(ierr);
+
+  double *diagonalValues;
+  ierr = VecGetArray(diagonal_->valuesLocal(), &diagonalValues); CHKERRV(ierr);
+
+  // the diagonal entry of dof i is the integral of the product of the basis function i with itself (or of its gradient with itself)
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    const double *geometricFactors = geometricFactors_.data() + (allElementsHaveSameGeometry_? 0 : elementNoLocal*nQuadraturePoints*nGeometricFactorsPerPoint_);
+    std::array<dof_no_t,nDofsPerElement> dofNosLocal = functionSpace_->getElementDofNosLocal(elementNoLocal);
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      double value = 0;
+      for (int quadraturePointNo = 0; quadraturePointNo < nQuadraturePoints; quadraturePointNo++)
+      {
+        // compute the values or gradient of the basis function at the quadrature point from the 1D tabulated values
+        std::array<double,D> gradient;
+        double phi = 1.0;
+        for (int dimNo = 0; dimNo < D; dimNo++)
+        {
+          gradient[dimNo] = 1.0;
+        }
+
+        for (int dimNo = 0, dofIndex1D = dofIndex, quadraturePointIndex1D = quadraturePointNo; dimNo < D;
+             dimNo++, dofIndex1D /= nDofsPerElement1D, quadraturePointIndex1D /= nQuadraturePoints1D)
+        {
+          const int entryNo = (quadraturePointIndex1D % nQuadraturePoints1D)*nDofsPerElement1D + dofIndex1D % nDofsPerElement1D;
+          phi *= basis1D_[entryNo];
+          for (int derivativeDimNo = 0; derivativeDimNo < D; derivativeDimNo++)
+          {
+            gradient[derivativeDimNo] *= (derivativeDimNo == dimNo? derivative1D_[entryNo] : basis1D_[entryNo]);
+          }
+        }
+
+        const double *factors = geometricFactors + quadraturePointNo*nGeometricFactorsPerPoint_;
+        if (operatorType_ == massOperator)
+        {
+          value += factors[0] * phi * phi;
+        }
+        else
+        {
+          int entryNo = 0;
+          for (int i = 0; i < D; i++)
+          {
+            for (int j = i; j < D; j++, entryNo++)
+            {
+              value += (i == j? 1.0 : 2.0) * factors[entryNo] * gradient[i] * gradient[j];
+            }
+          }
+        }
+      }
+
+      diagonalValues[dofNosLocal[dofIndex]] += elementPrefactors_[elementNoLocal] * value;
+    }
+  }
+
+  ierr = VecRestoreArray(diagonal_->valuesLocal(), &diagonalValues); CHKERRV(ierr);
+
+  // add up the ghost contributions
+  diagonal_->finishGhostManipulation();
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+setBoundaryConditionDofs(const std::vector<dof_no_t> &boundaryConditionDofNosLocal)
+{
+  boundaryConditionDofNosLocal_ = boundaryConditionDofNosLocal;
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+void MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+apply(Vec input, Vec output, bool applyBoundaryConditions)
+{
+  assert(initialized_);
+  PetscErrorCode ierr;
+
+  // copy input to the work vector, set the values of the boundary condition dofs to zero, which zeros the corresponding columns
+  ierr = VecCopy(input, input_->valuesGlobal()); CHKERRV(ierr);
+
+  if (applyBoundaryConditions && !boundaryConditionDofNosLocal_.empty())
+  {
+    double *inputValues;
+    ierr = VecGetArray(input_->valuesGlobal(), &inputValues); CHKERRV(ierr);
+    for (dof_no_t dofNoLocal : boundaryConditionDofNosLocal_)
+    {
+      inputValues[dofNoLocal] = 0.0;
+    }
+    ierr = VecRestoreArray(input_->valuesGlobal(), &inputValues); CHKERRV(ierr);
+  }
+
+  // get the ghost values of the input
+  input_->startGhostManipulation();
+
+  output_->setRepresentationGlobal();
+  output_->startGhostManipulation();
+  ierr = VecZeroEntries(output_->valuesLocal()); CHKERRV(ierr);
+
+  const double *inputValues;
+  double *outputValues;
+  ierr = VecGetArrayRead(input_->valuesLocal(), &inputValues); CHKERRV(ierr);
+  ierr = VecGetArray(output_->valuesLocal(), &outputValues); CHKERRV(ierr);
+
+  // loop over local elements and add the element contributions
+  const element_no_t nElementsLocal = functionSpace_->nElementsLocal();
+  std::array<double,nDofsPerElement> elementInput;
+  std::array<double,nDofsPerElement> elementOutput;
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    std::array<dof_no_t,nDofsPerElement> dofNosLocal = functionSpace_->getElementDofNosLocal(elementNoLocal);
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      elementInput[dofIndex] = inputValues[dofNosLocal[dofIndex]];
+    }
+
+    applyElement(elementNoLocal, elementInput, elementOutput);
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      outputValues[dofNosLocal[dofIndex]] += elementOutput[dofIndex];
+    }
+  }
+
+  ierr = VecRestoreArrayRead(input_->valuesLocal(), &inputValues); CHKERRV(ierr);
+  ierr = VecRestoreArray(output_->valuesLocal(), &outputValues); CHKERRV(ierr);
+
+  // the input work vector is not changed, restore global representation without communication
+  input_->setRepresentationGlobal();
+
+  // add up the ghost contributions
+  output_->finishGhostManipulation();
+
+  // set identity in the rows of the boundary condition dofs
+  if (applyBoundaryConditions && !boundaryConditionDofNosLocal_.empty())
+  {
+    const double *originalInputValues;
+    ierr = VecGetArrayRead(input, &originalInputValues); CHKERRV(ierr);
+    ierr = VecGetArray(output_->valuesGlobal(), &outputValues); CHKERRV(ierr);
+
+    for (dof_no_t dofNoLocal : boundaryConditionDofNosLocal_)
+    {
+      outputValues[dofNoLocal] = originalInputValues[dofNoLocal];
+    }
+
+    ierr = VecRestoreArray(output_->valuesGlobal(), &outputValues); CHKERRV(ierr);
+    ierr = VecRestoreArrayRead(input, &originalInputValues); CHKERRV(ierr);
+  }
+
+  ierr = VecCopy(output_->valuesGlobal(), output); CHKERRV(ierr);
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+Mat &MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+valuesGlobal()
+{
+  return shellMatrix_;
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+PetscErrorCode MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+matMult(Mat matrix, Vec input, Vec output)
+{
+  void *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(matrix, &context); CHKERRQ(ierr);
+
+  MatrixFreeOperator *matrixFreeOperator = static_cast<MatrixFreeOperator *>(context);
+  matrixFreeOperator->apply(input, output, true);
+  return 0;
+}
+
+template<typename MeshType,int order,typename QuadratureType>
+PetscErrorCode MatrixFreeOperator<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<order>>,QuadratureType,Mesh::isStructured<MeshType>,BasisFunction::LagrangeOfOrder<order>>::
+matGetDiagonal(Mat matrix, Vec diagonal)
+{
+  void *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(matrix, &context); CHKERRQ(ierr);
+
+  MatrixFreeOperator *matrixFreeOperator = static_cast<MatrixFreeOperator *>(context);
+  ierr = VecCopy(matrixFreeOperator->diagonal_->valuesGlobal(), diagonal); CHKERRQ(ierr);
+
+  // the boundary condition rows have 1 on the diagonal
+  if (!matrixFreeOperator->boundaryConditionDofNosLocal_.empty())
+  {
+    double *diagonalValues;
+    ierr = VecGetArray(diagonal, &diagonalValues); CHKERRQ(ierr);
+    for (dof_no_t dofNoLocal : matrixFreeOperator->boundaryConditionDofNosLocal_)
+    {
+      diagonalValues[dofNoLocal] = 1.0;
+    }
+    ierr = VecRestoreArray(diagonal, &diagonalValues); CHKERRQ(ierr);
+  }
+  return 0;
+}
+
+}  // namespace
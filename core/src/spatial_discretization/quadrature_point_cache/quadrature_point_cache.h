@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <array>
+#include <vector>
+#include <type_traits>
+
+#include "control/types.h"
+#include "mesh/type_traits.h"
+
+namespace SpatialDiscretization
+{
+
+/** Cache of quantities at the quadrature points of all elements of a function space, for loops over the elements that are
+ *  executed multiple times with the same geometry.
+ *
+ *  The gradients of the basis functions at the quadrature points are the same for all elements and are tabulated once per
+ *  combination of function space and quadrature. The element jacobians, their inverses and determinants depend on the geometry.
+ *  They are computed on the first access of an element and reused on later accesses, until reset() is called, which has to be done
+ *  when the geometry changes. For StructuredRegularFixed meshes all elements have the same geometry and only one set of values is stored,
+ *  for other meshes the values of all elements are only stored if they fit into the given memory limit, otherwise they are computed on every access.
+ *
+ *  The element loops proceed in blocks of nVcComponents elements, the element no. passed to the methods is the first element of such a block.
+ */
+template<typename FunctionSpaceType, typename QuadratureDD>
+class QuadraturePointCache
+{
+public:
+
+  static constexpr int D = FunctionSpaceType::dim();
+  static constexpr int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+  static constexpr int nSamplingPoints = QuadratureDD::numberEvaluations();
+
+  typedef std::array<std::array<std::array<double,D>,nDofsPerElement>,nSamplingPoints> GradPhiTableType;    //< gradPhi[samplingPointIndex][dofIndex][xiDirection]
+  typedef std::array<Vec3_v_t,D> JacobianType;                                                              //< the 3xD jacobian of the mapping from parameter space to world space
+
+  //! constructor, the element quantities of non-regular meshes are only stored if they need at most maximumMemory MB
+  QuadraturePointCache(double maximumMemory = 0);
+
+  //! get the gradients of all basis functions with respect to xi at all quadrature points, they are computed on the first call
+  static const GradPhiTableType &gradPhi();
+
+  //! clear all stored element quantities and set the number of local elements, this has to be called initially and whenever the geometry changes
+  void reset(element_no_t nElementsLocal);
+
+  //! if the jacobians of the given element block are stored, then the geometry values do not need to be provided to jacobian()
+  bool isJacobianStored(element_no_t elementNoLocal) const;
+
+  //! if the inverse jacobians of the given element block are stored, then the geometry values do not need to be provided to inverseJacobian()
+  bool isInverseJacobianStored(element_no_t elementNoLocal) const;
+
+  //! get the jacobian of the given element block at the quadrature point, geometry are the element geometry values, they are only used if the jacobian is not yet stored
+  JacobianType jacobian(element_no_t elementNoLocal, int samplingPointIndex, const std::array<Vec3_v_t,nDofsPerElement> &geometry);
+
+  //! get the inverse jacobian and its determinant of the given element block at the quadrature point, only for D=3,
+  //! geometry are the element geometry values, they are only used if the values are not yet stored
+  Tensor2_v_t<D> inverseJacobian(element_no_t elementNoLocal, int samplingPointIndex, const std::array<Vec3_v_t,nDofsPerElement> &geometry,
+                                 double_v_t approximateMeshWidth, double_v_t &jacobianDeterminant);
+
+private:
+
+  //! get the index of the block in the storage, -1 if the block should not be stored
+  int storageIndex(element_no_t elementNoLocal) const;
+
+  //! the number of blocks that are stored, 1 for regular fixed meshes
+  int nStoredBlocks() const;
+
+  static constexpr bool isRegularFixed_ = std::is_same<typename FunctionSpaceType::Mesh, Mesh::StructuredRegularFixedOfDimension<D>>::value;  //< if all elements have the same geometry
+
+  double maximumMemory_;                        //< memory limit in MB for the element quantities of non-regular meshes
+  element_no_t nElementsLocal_;                 //< number of local elements, set by reset()
+
+  std::vector<std::array<JacobianType,nSamplingPoints>> jacobians_;            //< stored jacobians for every element block and quadrature point
+  std::vector<bool> isJacobianStored_;                                         //< for every element block if the jacobians are stored in jacobians_
+  std::vector<std::array<Tensor2_v_t<D>,nSamplingPoints>> inverseJacobians_;   //< stored inverse jacobians for every element block and quadrature point
+  std::vector<std::array<double_v_t,nSamplingPoints>> jacobianDeterminants_;   //< stored determinants of the jacobians for every element block and quadrature point
+  std::vector<bool> isInverseJacobianStored_;                                  //< for every element block if the inverse jacobians are stored
+  bool storeJacobians_;                         //< if the jacobians can be stored, i.e. if they fit into the memory limit
+  bool storeInverseJacobians_;                  //< if the inverse jacobians can be stored
+};
+
+}  // namespace
+
+#include "spatial_discretization/quadrature_point_cache/quadrature_point_cache.tpp"
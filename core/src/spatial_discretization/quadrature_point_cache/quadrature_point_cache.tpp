@@ -0,0 +1,171 @@
+#include "spatial_discretization/quadrature_point_cache/quadrature_point_cache.h"
+
+#include "utility/math_utility.h"
+#include "easylogging++.h"
+
+namespace SpatialDiscretization
+{
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+QuadraturePointCache(double maximumMemory) :
+  maximumMemory_(maximumMemory), nElementsLocal_(0), storeJacobians_(false), storeInverseJacobians_(false)
+{
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+const typename QuadraturePointCache<FunctionSpaceType,QuadratureDD>::GradPhiTableType &QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+gradPhi()
+{
+  static const GradPhiTableType gradPhiTable = []()
+  {
+    GradPhiTableType result;
+    std::array<std::array<double,D>,nSamplingPoints> samplingPoints = QuadratureDD::samplingPoints();
+    for (int samplingPointIndex = 0; samplingPointIndex < nSamplingPoints; samplingPointIndex++)
+    {
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        result[samplingPointIndex][dofIndex] = FunctionSpaceType::gradPhi(dofIndex, samplingPoints[samplingPointIndex]);
+      }
+    }
+    return result;
+  }();
+
+  return gradPhiTable;
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+void QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+reset(element_no_t nElementsLocal)
+{
+  nElementsLocal_ = nElementsLocal;
+
+  // determine if the values fit into the memory limit, for regular fixed meshes only one block is stored which is always possible
+  const int nBlocks = nStoredBlocks();
+  const double memoryJacobians = (double)nBlocks * sizeof(std::array<JacobianType,nSamplingPoints>) / (1024.*1024.);
+  const double memoryInverseJacobians = (double)nBlocks * (sizeof(std::array<Tensor2_v_t<D>,nSamplingPoints>)
+    + sizeof(std::array<double_v_t,nSamplingPoints>)) / (1024.*1024.);
+
+  storeJacobians_ = isRegularFixed_ || memoryJacobians <= maximumMemory_;
+  storeInverseJacobians_ = isRegularFixed_ || memoryInverseJacobians <= maximumMemory_;
+
+  VLOG(1) << "QuadraturePointCache::reset(" << nElementsLocal << "), " << nBlocks << " blocks, memory for jacobians: " << memoryJacobians
+    << " MB, inverse jacobians: " << memoryInverseJacobians << " MB, limit: " << maximumMemory_ << " MB";
+
+  // clear the stored values, the storage is allocated on first use
+  jacobians_.clear();
+  isJacobianStored_.assign(storeJacobians_? nBlocks : 0, false);
+  inverseJacobians_.clear();
+  jacobianDeterminants_.clear();
+  isInverseJacobianStored_.assign(storeInverseJacobians_? nBlocks : 0, false);
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+int QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+nStoredBlocks() const
+{
+  if (isRegularFixed_)
+    return 1;
+
+  return (nElementsLocal_ + nVcComponents - 1) / nVcComponents;
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+int QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+storageIndex(element_no_t elementNoLocal) const
+{
+  if (isRegularFixed_)
+  {
+    // only a complete block contains valid values in all entries, these are the same for all elements
+    if (elementNoLocal + nVcComponents > nElementsLocal_)
+      return -1;
+    return 0;
+  }
+
+  assert(elementNoLocal % nVcComponents == 0);
+  return elementNoLocal / nVcComponents;
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+bool QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+isJacobianStored(element_no_t elementNoLocal) const
+{
+  int index = storageIndex(elementNoLocal);
+  return storeJacobians_ && index != -1 && index < (int)isJacobianStored_.size() && isJacobianStored_[index];
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+bool QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+isInverseJacobianStored(element_no_t elementNoLocal) const
+{
+  int index = storageIndex(elementNoLocal);
+  return storeInverseJacobians_ && index != -1 && index < (int)isInverseJacobianStored_.size() && isInverseJacobianStored_[index];
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+typename QuadraturePointCache<FunctionSpaceType,QuadratureDD>::JacobianType QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+jacobian(element_no_t elementNoLocal, int samplingPointIndex, const std::array<Vec3_v_t,nDofsPerElement> &geometry)
+{
+  if (isJacobianStored(elementNoLocal))
+    return jacobians_[storageIndex(elementNoLocal)][samplingPointIndex];
+
+  int index = storageIndex(elementNoLocal);
+  if (!storeJacobians_ || index == -1)
+  {
+    return FunctionSpaceType::computeJacobian(geometry, QuadratureDD::samplingPoints()[samplingPointIndex]);
+  }
+
+  // compute the jacobians at all quadrature points of the block and store them
+  if (jacobians_.empty())
+    jacobians_.resize(nStoredBlocks());
+
+  std::array<std::array<double,D>,nSamplingPoints> samplingPoints = QuadratureDD::samplingPoints();
+  for (int i = 0; i < nSamplingPoints; i++)
+  {
+    jacobians_[index][i] = FunctionSpaceType::computeJacobian(geometry, samplingPoints[i]);
+  }
+  isJacobianStored_[index] = true;
+
+  return jacobians_[index][samplingPointIndex];
+}
+
+template<typename FunctionSpaceType, typename QuadratureDD>
+Tensor2_v_t<QuadraturePointCache<FunctionSpaceType,QuadratureDD>::D> QuadraturePointCache<FunctionSpaceType,QuadratureDD>::
+inverseJacobian(element_no_t elementNoLocal, int samplingPointIndex, const std::array<Vec3_v_t,nDofsPerElement> &geometry,
+                double_v_t approximateMeshWidth, double_v_t &jacobianDeterminant)
+{
+  static_assert(D == 3, "The inverse jacobian is only available for 3D meshes.");
+
+  int index = storageIndex(elementNoLocal);
+  if (isInverseJacobianStored(elementNoLocal))
+  {
+    jacobianDeterminant = jacobianDeterminants_[index][samplingPointIndex];
+    return inverseJacobians_[index][samplingPointIndex];
+  }
+
+  if (!storeInverseJacobians_ || index == -1)
+  {
+    Tensor2_v_t<D> jacobianMaterial = FunctionSpaceType::computeJacobian(geometry, QuadratureDD::samplingPoints()[samplingPointIndex]);
+    return MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+  }
+
+  // compute the inverse jacobians at all quadrature points of the block and store them
+  if (inverseJacobians_.empty())
+  {
+    inverseJacobians_.resize(nStoredBlocks());
+    jacobianDeterminants_.resize(nStoredBlocks());
+  }
+
+  std::array<std::array<double,D>,nSamplingPoints> samplingPoints = QuadratureDD::samplingPoints();
+  for (int i = 0; i < nSamplingPoints; i++)
+  {
+    Tensor2_v_t<D> jacobianMaterial = FunctionSpaceType::computeJacobian(geometry, samplingPoints[i]);
+    inverseJacobians_[index][i] = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminants_[index][i]);
+  }
+  isInverseJacobianStored_[index] = true;
+
+  jacobianDeterminant = jacobianDeterminants_[index][samplingPointIndex];
+  return inverseJacobians_[index][samplingPointIndex];
+}
+
+}  // namespace
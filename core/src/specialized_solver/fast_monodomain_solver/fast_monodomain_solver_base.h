@@ -2,6 +2,7 @@
 
 #include <Python.h>  // has to be the first included header
 #include <array>
+#include <map>
 #include <vc_or_std_simd.h>  // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 
 #include "control/multiple_instances.h"
@@ -21,6 +22,9 @@
 template<int nStates>
 struct FiberPointBuffers
 {
+  //! empty constructor that leaves the states uninitialized, such that the memory is not touched on resize() of the vector but by the OpenMP thread that initializes the states (NUMA first-touch placement)
+  FiberPointBuffers() {}
+
   Vc::double_v states[nStates];
 };
 
@@ -119,23 +123,59 @@ protected:
   //! create a source file with compute0D function from the CellML model, using the gpu optimization type
   void initializeCellMLSourceFileGpu();
 
-  //! get element lengths and vmValues from the other ranks
-  void fetchFiberData();
+  //! get element lengths and vmValues from the other ranks, if startComputation0D, compute the first 0D half step of every point buffer as soon as the data of its fibers has arrived
+  void fetchFiberData(bool startComputation0D = false);
 
   //! send vmValues data from fiberData_ back to the fibers where it belongs to and set in the respective field variable
   void updateFiberData();
 
+  //! compute the counts and offsets of the gather and scatter operations of all fibers and allocate the persistent buffers in fiberCommunication_
+  void initializeFiberCommunication();
+
+  //! store the received Vm values, parameters and element lengths of a fiber in the compute buffers, called from fetchFiberData as soon as the data of the fiber has arrived
+  void storeFetchedFiberData(int fiberNo, int nParametersPerInstance);
+
+  //! store the received Vm values and further states and algebraics of a fiber in the field variables, called from updateFiberData as soon as the data of the fiber has arrived
+  void storeUpdatedFiberData(int fiberNo);
+
+  //! estimate the computational cost of the fibers from the measured durations of compute0D and compute1D, migrate fibers from overloaded ranks to less loaded ranks of their rank subset
+  void rebalanceFibers();
+
+  //! compute the cost of every fiber in fiberData_ from fiberPointBuffersComputeDuration0D_ and computeDuration1D_, in seconds
+  void computeFiberCosts(std::vector<double> &fiberCosts);
+
+  //! rebuild fiberData_ and all point buffers for the new assignment in fiberComputingRank_, keep the data of the own fibers that stay and insert the received data of migrated fibers
+  void redistributeFiberPointBuffers(const std::vector<int> &fiberComputingRankPrevious, std::map<int,std::vector<double>> &receivedFiberData);
+
+  //! serialize the states, algebraics for transfer and stimulation data of a fiber in fiberData_ into a buffer that can be sent to another rank
+  void packFiberData(int fiberDataNo, std::vector<double> &buffer);
+
+  //! size of the buffer that packFiberData creates for a fiber with nValues points
+  int packedFiberDataSize(int nValues);
+
   //! solve the 0D problem, starting from startTime. This is the part that is usually provided by the cellml file
   void compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer);
 
+  //! compute all time steps of compute0D for a single point buffer, this only writes to the point buffer itself and can be called from multiple threads
+  void compute0DPointBuffer(global_no_t pointBuffersNo, double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer);
+
+  //! update the equilibrium information of all point buffers after all point buffers have been computed in compute0D, this involves the neighbouring point buffers
+  void updateEquilibrium0D(int nTimeSteps);
+
+  //! set the time span of the 0D solver to the first half step of the splitting and get its time step width and number of time steps, also sets durationLogKey0D_
+  void getTimeStepping0D(double &startTime, double &timeStepWidth, int &nTimeSteps);
+
   //! compute one time step of the right hand side for a single simd vector of instances
   virtual void compute0DInstance(Vc::double_v states[], std::vector<Vc::double_v> &parameters, double currentTime, double timeStepWidth,
                                  bool stimulate, bool storeAlgebraicsForTransfer,
                                  std::vector<Vc::double_v> &algebraicsForTransfer){};
 
-  //! solve the 1D problem (diffusion), starting from startTime
+  //! solve the 1D problem (diffusion), starting from startTime, the tridiagonal systems of Vc::double_v::size() fibers are solved at once using SIMD
   void compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefactor);
 
+  //! group the fibers in fiberData_ to batches of Vc::double_v::size() fibers of equal length that will be solved together in compute1D
+  void initializeFiberBatches1D();
+
   //! compute the 0D-1D problem with Strang splitting
   void computeMonodomain();
 
@@ -143,11 +183,23 @@ protected:
   struct FiberData;
   bool isCurrentPointStimulated(int fiberDataNo, double currentTime, bool currentPointIsInCenter);
 
+  //! determine the stimulation of all fibers for the time steps of the next compute0D call, fills fiberStimulatedInTimeStep_, fiberFirstStimulatedTimeStepNo_ and fiberFirstComputedTimeStepNo_
+  void prepareStimulation0D(double startTime, double timeStepWidth, int nTimeSteps);
+
+  //! advance the states of a single point buffer from startTime to endTime with adaptive time step widths, using the step doubling error estimate of HeunAdaptive, this does not modify shared members and can be called from multiple threads
+  void compute0DInstanceAdaptive(int pointBuffersNo, double startTime, double endTime, double timeStepWidth, bool storeAlgebraicsForTransfer);
+
+  //! compute statistics of the adaptive time stepping in compute0D and store them in the performance measurement log
+  void logAdaptiveTimeStepping0DStatistics();
+
+  //! check if the states of the point buffer did not change significantly compared to statesPreviousValues, this does not modify any member and can be called from multiple threads
+  bool checkStatesAreAtEquilibrium(const Vc::double_v statesPreviousValues[], int pointBuffersNo);
+
   //! method to be called after the compute0D, updates the information in fiberPointBuffersStatesAreCloseToEquilibrium_
-  void equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int pointBuffersNo);
+  void equilibriumAccelerationUpdate(bool statesAreAtEquilibrium, int pointBuffersNo);
 
-  //! check if the 0D computations for the current point are disabled because the states are in equilibrium
-  bool isEquilibriumAccelerationCurrentPointDisabled(bool stimulateCurrentPoint, int pointBuffersNo);
+  //! set the neighbouring point buffers of a stimulated point buffer to neighbour_not_constant, or the point buffer itself to not_constant if setOwnPointBuffer
+  void equilibriumAccelerationStimulate(int pointBuffersNo, bool setOwnPointBuffer);
 
   //! set the initial values for all states
   virtual void initializeStates(Vc::double_v states[]){};
@@ -194,6 +246,34 @@ protected:
     bool currentlyStimulating;                    //< if a stimulation is in progress at the current time
   };
 
+  /** data for the nonblocking gather and scatter operations of a single fiber in fetchFiberData and updateFiberData
+   *  The counts and offsets only depend on the partitioning and are computed once, the buffers have to persist while the operations are in progress.
+   */
+  struct FiberCommunication
+  {
+    int instanceNo;                       //< index of the outer instance in nestedSolvers_
+    int innerInstanceNo;                  //< index of the inner instance, i.e., the fiber in the outer instance
+    int fiberDataNo;                      //< index in fiberData_ if the fiber is computed by the own rank, -1 otherwise, set in fetchFiberData
+
+    std::vector<int> nElementsOnRanks;    //< number of elements of the fiber on every rank of the fiber's rank subset
+    std::vector<int> nDofsOnRanks;        //< number of dofs of the fiber on every rank
+    std::vector<int> offsetsOnRanks;      //< global natural no. of the first node on every rank, offset for elements and dofs
+    std::vector<int> nParametersOnRanks;  //< number of parameter values on every rank
+    std::vector<int> parameterOffsetsOnRanks;   //< offsets of the parameter values on every rank
+    std::vector<int> nValuesOnRanks;      //< number of further states and algebraics values on every rank
+    std::vector<int> valuesOffsetsOnRanks;      //< offsets of the further states and algebraics values on every rank
+
+    std::vector<double> elementLengthsSendBuffer;  //< lengths of the local elements
+    std::vector<double> vmValuesSendBuffer;        //< local values of Vm to gather
+    std::vector<double> parametersSendBuffer;      //< local parameter values to gather, only the actual parameters of the instances
+    std::vector<double> parametersReceiveBuffer;   //< on the computing rank, the parameter values of the whole fiber
+    std::vector<double> vmValuesReceiveBuffer;     //< local values of Vm that were computed
+    std::vector<double> valuesReceiveBuffer;       //< local values of the further states and algebraics for transfer
+  };
+
+  std::vector<FiberCommunication> fiberCommunication_;      //< for every fiber in nestedSolvers_, the data for the communication with the computing rank
+  std::vector<MPI_Request> fiberCommunicationRequests_;     //< requests of the nonblocking gather and scatter operations of all fibers
+
   std::vector<FiberPointBuffers<nStates>> fiberPointBuffers_;    //< computation buffers for the 0D problem, the states vector used when optimizationType == "vc"
 
   std::string fiberDistributionFilename_;  //< filename of the fiberDistributionFile, which contains motor unit numbers for fiber numbers
@@ -226,6 +306,39 @@ protected:
   std::vector<state_t> fiberPointBuffersStatesAreCloseToEquilibrium_;       //< for every entry in fiberPointBuffers_, constant if the states didn't change too much in the last compute0D, neighbour_not_constant if the state of the neighbouring pointBuffer changes
   int nFiberPointBufferStatesCloseToEquilibrium_;                           //< number of "constant" entries in fiberPointBuffersStatesAreCloseToEquilibrium_
 
+  std::vector<std::vector<int>> fiberBatches1D_;                            //< groups of Vc::double_v::size() fibers with the same valuesLength, fiberBatches1D_[batchNo][laneNo] = fiberDataNo, incomplete groups are padded with their last fiber
+  std::vector<std::pair<int,int>> fiberBatch1DNoAndLaneNo_;                 //< for every fiber in fiberData_ the batchNo and laneNo in fiberBatches1D_
+  std::vector<std::vector<Vc::double_v>> fiberBatches1DVmValues_;           //< values of Vm for compute1D, one SIMD lane per fiber, fiberBatches1DVmValues_[batchNo][valueNo][laneNo]
+
+  bool adaptiveTimeStepping0D_;                                              //< option "adaptiveTimeStepping0D", if the point buffers in compute0D use their own adaptive time step widths instead of the fixed dt0D
+  double adaptiveTimeStepping0DTolerance_;                                  //< option "adaptiveTimeStepping0DTolerance", tolerance for the error estimator of the adaptive time stepping
+  double adaptiveTimeStepping0DMinimumTimeStepWidth_;                       //< option "adaptiveTimeStepping0DMinimumTimeStepWidth", steps with this width are always accepted
+  double adaptiveTimeStepping0DMaximumTimeStepWidth_;                       //< option "adaptiveTimeStepping0DMaximumTimeStepWidth", upper bound of the time step width, 0 means only bounded by the time span of compute0D
+  std::vector<double> fiberPointBuffersTimeStepWidth0D_;                    //< for every entry in fiberPointBuffers_, the current adaptive time step width, kept between the compute0D calls, 0 if not yet set
+  std::vector<int> fiberPointBuffersNSteps0D_;                              //< for every entry in fiberPointBuffers_, number of accepted adaptive steps in the last compute0D
+  std::vector<int> fiberPointBuffersNRejectedSteps0D_;                      //< for every entry in fiberPointBuffers_, number of rejected adaptive steps in the last compute0D
+  long long nAdaptiveSteps0DTotal_;                                         //< sum of all accepted adaptive steps of all point buffers over all compute0D calls
+  long long nAdaptiveRejectedSteps0DTotal_;                                 //< sum of all rejected adaptive steps of all point buffers over all compute0D calls
+  long long nAdaptiveComputedPointBuffers0DTotal_;                          //< number of point buffer computations over all compute0D calls, to compute the mean number of steps per point buffer
+  int nAdaptiveSteps0DMaximum_;                                             //< maximum number of accepted steps of a single point buffer in one compute0D call
+
+  std::vector<char> fiberPointBuffersAreAtEquilibrium_;                     //< for every entry in fiberPointBuffers_, result of checkStatesAreAtEquilibrium in the last compute0D, char instead of bool such that threads can write concurrently
+
+  bool loadBalancing_;                                //< option "loadBalancing", if the fibers are dynamically reassigned to the ranks of their rank subset according to the measured computation time
+  int loadBalancingInterval_;                         //< option "loadBalancingInterval", number of advanceTimeSpan calls between two checks for rebalancing
+  double loadBalancingImbalanceThreshold_;            //< option "loadBalancingImbalanceThreshold", fibers are only migrated if the maximum load of all ranks divided by the mean load exceeds this value
+  int nAdvanceTimeSpanCallsSinceLoadBalancing_;       //< number of advanceTimeSpan calls since the last check for rebalancing, the durations are accumulated over these calls
+  std::vector<int> fiberComputingRank_;               //< for every fiber in nestedSolvers_ (not only the computed ones), the rank no. in the rank subset of the fiber that computes it
+  std::vector<std::vector<int>> fiberRankSubsetGlobalRankNos_;  //< for every fiber in nestedSolvers_, the rank nos. in rankSubsetForCollectiveOperations of the ranks of the fiber's rank subset, set at the first rebalancing
+  std::vector<double> fiberPointBuffersComputeDuration0D_;      //< for every entry in fiberPointBuffers_, the accumulated wall time of compute0D since the last rebalancing, only measured if loadBalancing_
+  double computeDuration1D_;                          //< accumulated wall time of compute1D since the last rebalancing, only measured if loadBalancing_
+  bool first0DStepComputedDuringFetch_;               //< if the first 0D half step of the next computeMonodomain call has already been computed in fetchFiberData
+
+  int nThreads_;                                      //< number of OpenMP threads to use for the loop over fiberPointBuffers_ in compute0D, value of option "nThreads", 0 means the OpenMP default
+  std::vector<char> fiberStimulatedInTimeStep_;       //< for the current compute0D call, if the fiber gets stimulated at a time step, fiberStimulatedInTimeStep_[fiberDataNo*nTimeSteps + timeStepNo]
+  std::vector<int> fiberFirstStimulatedTimeStepNo_;   //< for the current compute0D call, the first time step no. where the fiber gets stimulated, nTimeSteps if it is not stimulated
+  std::vector<int> fiberFirstComputedTimeStepNo_;     //< for the current compute0D call, the first time step no. from which the fiber has to be computed (for onlyComputeIfHasBeenStimulated_)
+
   std::vector<int> statesForTransferIndices_;          //< state no.s to transfer to other solvers within slot connector data
   std::vector<int> algebraicsForTransferIndices_;      //< which algebraics should be transferred to other solvers as part of slot connector data
   double valueForStimulatedPoint_;              //< value to which the first state will be set if stimulated
@@ -277,3 +390,4 @@ protected:
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_compute.tpp"
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_initialization.tpp"
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_gpu.tpp"
+#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_load_balancing.tpp"
@@ -3,12 +3,10 @@
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
 
-//! get element lengths and vmValues from the other ranks
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
-fetchFiberData()
+initializeFiberCommunication()
 {
-  VLOG(1) << "fetchFiberData";
   std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
   CellmlAdapterType &cellmlAdapter = instances[0].timeStepping1().instancesLocal()[0].discretizableInTime();
@@ -18,210 +16,374 @@ fetchFiberData()
   int nParametersPerInstance;
   cellmlAdapter.getNumbers(nInstancesLocalCellml, nAlgebraicsLocalCellml, nParametersPerInstance);
 
-  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing
-  int fiberNo = 0;
-  int fiberDataNo = 0;
+  int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
+
+  // the counts and offsets of the gather and scatter operations only depend on the partitioning, compute them once for every fiber
+  fiberCommunication_.clear();
   for (int i = 0; i < instances.size(); i++)
   {
     std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
       = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
 
-    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    for (int j = 0; j < innerInstances.size(); j++)
     {
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
-      LOG(DEBUG) << "instance (inner,outer)=(" << i << "," << j << "), fiberNo: " << fiberNo
-        << ", functionSpace " << fiberFunctionSpace->meshName()
-        << "," << fiberFunctionSpace->meshPartition()->rankSubset()->size() << " ranks (" << *fiberFunctionSpace->meshPartition()->rankSubset() << ")"
-        << ", " << innerInstances.size() << " inner instances";
+      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+      const int nRanks = rankSubset->size();
+
+      fiberCommunication_.emplace_back();
+      FiberCommunication &fiberCommunication = fiberCommunication_.back();
 
-      // communicate element lengths
-      std::vector<double> localLengths(fiberFunctionSpace->nElementsLocal());
+      fiberCommunication.instanceNo = i;
+      fiberCommunication.innerInstanceNo = j;
+      fiberCommunication.fiberDataNo = -1;
 
-      // loop over local elements and compute element lengths
-      for (element_no_t elementNoLocal = 0; elementNoLocal < fiberFunctionSpace->nElementsLocal(); elementNoLocal++)
+      fiberCommunication.nElementsOnRanks.resize(nRanks);
+      fiberCommunication.nDofsOnRanks.resize(nRanks);
+      fiberCommunication.offsetsOnRanks.resize(nRanks);
+      fiberCommunication.nParametersOnRanks.resize(nRanks);
+      fiberCommunication.parameterOffsetsOnRanks.resize(nRanks);
+      fiberCommunication.nValuesOnRanks.resize(nRanks);
+      fiberCommunication.valuesOffsetsOnRanks.resize(nRanks);
+
+      for (int rankNo = 0; rankNo < nRanks; rankNo++)
       {
-        std::array<Vec3, FiberFunctionSpace::nDofsPerElement()> geometryElementValues;
-        fiberFunctionSpace->geometryField().getElementValues(elementNoLocal, geometryElementValues);
-        double elementLength = MathUtility::distance<3>(geometryElementValues[0], geometryElementValues[1]);
-        localLengths[elementNoLocal] = elementLength;
+        fiberCommunication.nElementsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithGhosts(0, rankNo) - 1;
+        fiberCommunication.offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
+        fiberCommunication.nDofsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
+        fiberCommunication.parameterOffsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo) * nParametersPerInstance;
+        fiberCommunication.nParametersOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo) * nParametersPerInstance;
+        fiberCommunication.valuesOffsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo) * nStatesAndAlgebraicsValues;
+        fiberCommunication.nValuesOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo) * nStatesAndAlgebraicsValues;
       }
 
-      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
-      MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
-      int computingRank = fiberNo % rankSubset->size();
+      // allocate the local buffers, they have to persist while the nonblocking operations are in progress
+      fiberCommunication.elementLengthsSendBuffer.resize(fiberFunctionSpace->nElementsLocal());
+      fiberCommunication.parametersSendBuffer.resize(nParametersPerInstance * fiberFunctionSpace->nDofsLocalWithoutGhosts());
+      fiberCommunication.vmValuesReceiveBuffer.resize(fiberFunctionSpace->nDofsLocalWithoutGhosts());
+      fiberCommunication.valuesReceiveBuffer.resize(fiberFunctionSpace->nDofsLocalWithoutGhosts() * nStatesAndAlgebraicsValues);
+    }
+  }
 
-      std::vector<int> nElementsOnRanks(rankSubset->size());
-      std::vector<int> nDofsOnRanks(rankSubset->size());
-      std::vector<int> offsetsOnRanks(rankSubset->size());
-      std::vector<int> nParametersOnRanks(rankSubset->size());
-      std::vector<int> parameterOffsetsOnRanks(rankSubset->size());
+  LOG(DEBUG) << "initialized communication data for " << fiberCommunication_.size() << " fibers";
+}
 
-      double *elementLengthsReceiveBuffer = nullptr;
-      double *vmValuesReceiveBuffer = nullptr;
-      std::vector<double> parametersReceiveBuffer(fiberFunctionSpace->nDofsGlobal()*nParametersPerInstance);
+//! get element lengths and vmValues from the other ranks
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+fetchFiberData(bool startComputation0D)
+{
+  VLOG(1) << "fetchFiberData";
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
-      if (computingRank == rankSubset->ownRankNo())
-      {
-        // allocate buffers
-        fiberData_[fiberDataNo].elementLengths.resize(fiberFunctionSpace->nElementsGlobal());
-        fiberData_[fiberDataNo].vmValues.resize(fiberFunctionSpace->nDofsGlobal());
-
-        // resize buffer of further data that will be transferred back in updateFiberData()
-        int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
-        fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues.resize(fiberFunctionSpace->nDofsGlobal() * nStatesAndAlgebraicsValues);
-        
-        elementLengthsReceiveBuffer = fiberData_[fiberDataNo].elementLengths.data();
-        vmValuesReceiveBuffer = fiberData_[fiberDataNo].vmValues.data();
-      }
+  CellmlAdapterType &cellmlAdapter = instances[0].timeStepping1().instancesLocal()[0].discretizableInTime();
 
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
-      {
-        nElementsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithGhosts(0, rankNo) - 1;
-        offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
-        nDofsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
-        parameterOffsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo) * nParametersPerInstance;
-        nParametersOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo) * nParametersPerInstance;
-      }
+  int nInstancesLocalCellml;
+  int nAlgebraicsLocalCellml;
+  int nParametersPerInstance;
+  cellmlAdapter.getNumbers(nInstancesLocalCellml, nAlgebraicsLocalCellml, nParametersPerInstance);
 
-      // int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
-      //          void *recvbuf, const int *recvcounts, const int *displs,
-      //          MPI_Datatype recvtype, int root, MPI_Comm comm)
-      //
-      VLOG(1) << "Gatherv of element lengths to rank " << computingRank << ", values " << localLengths << ", sizes: " << nElementsOnRanks << ", offsets: " << offsetsOnRanks;
+  if (fiberCommunication_.empty())
+    initializeFiberCommunication();
 
-      MPI_Gatherv(localLengths.data(), fiberFunctionSpace->nElementsLocal(), MPI_DOUBLE,
-                  elementLengthsReceiveBuffer, nElementsOnRanks.data(), offsetsOnRanks.data(),
-                  MPI_DOUBLE, computingRank, mpiCommunicator);
+  // The data of all fibers is gathered with nonblocking collective operations, which are all started at once such that their latencies overlap.
+  // The received data of a fiber is stored in the compute buffers as soon as the operations of this fiber are complete, while the other fibers are still in transfer.
+  // If startComputation0D is set, the first 0D half step of a point buffer is computed as soon as the data of all fibers in this point buffer has arrived,
+  // such that the computation overlaps with the transfer of the remaining fibers.
+  // There are three operations per fiber: element lengths, Vm values and parameters.
+  const int nRequestsPerFiber = 3;
+  const int nFibers = fiberCommunication_.size();
+  fiberCommunicationRequests_.resize(nFibers*nRequestsPerFiber);
 
-      // get own vm values
-      std::vector<double> vmValuesLocal;
-      innerInstances[j].data().solution()->getValuesWithoutGhosts(0, vmValuesLocal);
+  // loop over fibers and start the communication of element lengths, Vm values and parameters to the ranks that participate in computing
+  int fiberDataNo = 0;
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    FiberCommunication &fiberCommunication = fiberCommunication_[fiberNo];
+    const int i = fiberCommunication.instanceNo;
+    const int j = fiberCommunication.innerInstanceNo;
 
-      // communicate Vm values
-      LOG(DEBUG) << "Gatherv of values to rank " << computingRank << ", sizes: " << nDofsOnRanks << ", offsets: " << offsetsOnRanks << ", local values " << vmValuesLocal;
+    TimeSteppingScheme::Heun<CellmlAdapterType> &innerInstance = instances[i].timeStepping1().instancesLocal()[j];
 
-      MPI_Gatherv(vmValuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
-                  vmValuesReceiveBuffer, nDofsOnRanks.data(), offsetsOnRanks.data(),
-                  MPI_DOUBLE, computingRank, mpiCommunicator);
+    std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstance.data().functionSpace();
+    LOG(DEBUG) << "instance (inner,outer)=(" << i << "," << j << "), fiberNo: " << fiberNo
+      << ", functionSpace " << fiberFunctionSpace->meshName()
+      << "," << fiberFunctionSpace->meshPartition()->rankSubset()->size() << " ranks (" << *fiberFunctionSpace->meshPartition()->rankSubset() << ")";
 
-      // communicate parameter values
-      // get own parameter values
+    // loop over local elements and compute element lengths
+    std::vector<double> &localLengths = fiberCommunication.elementLengthsSendBuffer;
+    for (element_no_t elementNoLocal = 0; elementNoLocal < fiberFunctionSpace->nElementsLocal(); elementNoLocal++)
+    {
+      std::array<Vec3, FiberFunctionSpace::nDofsPerElement()> geometryElementValues;
+      fiberFunctionSpace->geometryField().getElementValues(elementNoLocal, geometryElementValues);
+      double elementLength = MathUtility::distance<3>(geometryElementValues[0], geometryElementValues[1]);
+      localLengths[elementNoLocal] = elementLength;
+    }
 
-      // get the data_.parameters() raw pointer
-      innerInstances[j].discretizableInTime().data().prepareParameterValues();
+    std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+    MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+    int computingRank = fiberComputingRank_[fiberNo];
 
-      double *parameterValuesLocal = innerInstances[j].discretizableInTime().data().parameterValues();  
-      // size of this array is fiberFunctionSpace->nDofsLocalWithoutGhosts() * nAlgebraics
-      // parameterValuesLocal has struct of array memory layout with space for a total of nAlgebraics_ parameters [i0p0, i1p0, i2p0, ... i0p1, i1p1, i2p1, ...]
+    double *elementLengthsReceiveBuffer = nullptr;
+    double *vmValuesReceiveBuffer = nullptr;
+    double *parametersReceiveBuffer = nullptr;
 
-      // only the actual parameter values should be sent, not the rest of the parameters buffer
-      // therefore allocate a send buffer with the according size
-      int nParametersLocal = nParametersPerInstance * fiberFunctionSpace->nDofsLocalWithoutGhosts();
-      std::vector<double> parametersSendBuffer(nParametersLocal);
+    fiberCommunication.fiberDataNo = -1;
+    if (computingRank == rankSubset->ownRankNo())
+    {
+      fiberCommunication.fiberDataNo = fiberDataNo;
 
-      // loop over the actual parameter values for every dof
-      for (int dofNoLocal = 0; dofNoLocal < fiberFunctionSpace->nDofsLocalWithoutGhosts(); dofNoLocal++)
-      {
-        for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
-        {
-          // store parameter values to send buffer
-          parametersSendBuffer[dofNoLocal*nParametersPerInstance + parameterNo] = parameterValuesLocal[parameterNo*fiberFunctionSpace->nDofsLocalWithoutGhosts() + dofNoLocal];
-        }
-      }
+      // allocate buffers
+      fiberData_[fiberDataNo].elementLengths.resize(fiberFunctionSpace->nElementsGlobal());
+      fiberData_[fiberDataNo].vmValues.resize(fiberFunctionSpace->nDofsGlobal());
+      fiberCommunication.parametersReceiveBuffer.resize(fiberFunctionSpace->nDofsGlobal()*nParametersPerInstance);
 
-      if (VLOG_IS_ON(1))
+      // resize buffer of further data that will be transferred back in updateFiberData()
+      int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
+      fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues.resize(fiberFunctionSpace->nDofsGlobal() * nStatesAndAlgebraicsValues);
+
+      elementLengthsReceiveBuffer = fiberData_[fiberDataNo].elementLengths.data();
+      vmValuesReceiveBuffer = fiberData_[fiberDataNo].vmValues.data();
+      parametersReceiveBuffer = fiberCommunication.parametersReceiveBuffer.data();
+    }
+
+    // int MPI_Igatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+    //          void *recvbuf, const int *recvcounts, const int *displs,
+    //          MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request)
+    //
+    VLOG(1) << "Igatherv of element lengths to rank " << computingRank << ", values " << localLengths
+      << ", sizes: " << fiberCommunication.nElementsOnRanks << ", offsets: " << fiberCommunication.offsetsOnRanks;
+
+    MPIUtility::handleReturnValue(MPI_Igatherv(localLengths.data(), fiberFunctionSpace->nElementsLocal(), MPI_DOUBLE,
+                                               elementLengthsReceiveBuffer, fiberCommunication.nElementsOnRanks.data(), fiberCommunication.offsetsOnRanks.data(),
+                                               MPI_DOUBLE, computingRank, mpiCommunicator, &fiberCommunicationRequests_[fiberNo*nRequestsPerFiber + 0]), "MPI_Igatherv");
+
+    // get own vm values
+    std::vector<double> &vmValuesLocal = fiberCommunication.vmValuesSendBuffer;
+    innerInstance.data().solution()->getValuesWithoutGhosts(0, vmValuesLocal);
+
+    // communicate Vm values
+    LOG(DEBUG) << "Igatherv of values to rank " << computingRank << ", sizes: " << fiberCommunication.nDofsOnRanks
+      << ", offsets: " << fiberCommunication.offsetsOnRanks << ", local values " << vmValuesLocal;
+
+    MPIUtility::handleReturnValue(MPI_Igatherv(vmValuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
+                                               vmValuesReceiveBuffer, fiberCommunication.nDofsOnRanks.data(), fiberCommunication.offsetsOnRanks.data(),
+                                               MPI_DOUBLE, computingRank, mpiCommunicator, &fiberCommunicationRequests_[fiberNo*nRequestsPerFiber + 1]), "MPI_Igatherv");
+
+    // communicate parameter values
+    // get own parameter values
+
+    // get the data_.parameters() raw pointer
+    innerInstance.discretizableInTime().data().prepareParameterValues();
+
+    double *parameterValuesLocal = innerInstance.discretizableInTime().data().parameterValues();
+    // size of this array is fiberFunctionSpace->nDofsLocalWithoutGhosts() * nAlgebraics
+    // parameterValuesLocal has struct of array memory layout with space for a total of nAlgebraics_ parameters [i0p0, i1p0, i2p0, ... i0p1, i1p1, i2p1, ...]
+
+    // only the actual parameter values should be sent, not the rest of the parameters buffer
+    // therefore the send buffer has the according size
+    int nParametersLocal = nParametersPerInstance * fiberFunctionSpace->nDofsLocalWithoutGhosts();
+    std::vector<double> &parametersSendBuffer = fiberCommunication.parametersSendBuffer;
+
+    // loop over the actual parameter values for every dof
+    for (int dofNoLocal = 0; dofNoLocal < fiberFunctionSpace->nDofsLocalWithoutGhosts(); dofNoLocal++)
+    {
+      for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
       {
-        VLOG(1) << "Gatherv of parameters to rank " << computingRank << ", send buffer: " << parametersSendBuffer << " contains " << nParametersLocal << " parameters "
-          << " " << nParametersPerInstance << " per instances with " << fiberFunctionSpace->nDofsLocalWithoutGhosts() << " local instances.";
+        // store parameter values to send buffer
+        parametersSendBuffer[dofNoLocal*nParametersPerInstance + parameterNo] = parameterValuesLocal[parameterNo*fiberFunctionSpace->nDofsLocalWithoutGhosts() + dofNoLocal];
       }
+    }
 
-      // send data
-      MPI_Gatherv(parametersSendBuffer.data(), nParametersLocal, MPI_DOUBLE,
-                  parametersReceiveBuffer.data(), nParametersOnRanks.data(), parameterOffsetsOnRanks.data(),
-                  MPI_DOUBLE, computingRank, mpiCommunicator);
+    // restore the data_.parameters() raw pointer, the values are already copied to the send buffer
+    innerInstance.discretizableInTime().data().restoreParameterValues();
 
-      // store result from parametersReceiveBuffer (for current fiber) to fiberPointBuffersParameters_ (for a vc vector)
-      // loop over number of instances of the problem on the current fiber
-      if (computingRank == rankSubset->ownRankNo())
-      {
-        int nInstancesOnFiber = fiberData_[fiberDataNo].vmValues.size();
+    if (VLOG_IS_ON(1))
+    {
+      VLOG(1) << "Igatherv of parameters to rank " << computingRank << ", send buffer: " << parametersSendBuffer << " contains " << nParametersLocal << " parameters "
+        << " " << nParametersPerInstance << " per instances with " << fiberFunctionSpace->nDofsLocalWithoutGhosts() << " local instances.";
+    }
 
-        for (int instanceNo = 0; instanceNo < nInstancesOnFiber; instanceNo++)
-        {
-          // compute indices for fiberPointBuffersParameters_
-          global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + instanceNo;
+    // send data
+    MPIUtility::handleReturnValue(MPI_Igatherv(parametersSendBuffer.data(), nParametersLocal, MPI_DOUBLE,
+                                               parametersReceiveBuffer, fiberCommunication.nParametersOnRanks.data(), fiberCommunication.parameterOffsetsOnRanks.data(),
+                                               MPI_DOUBLE, computingRank, mpiCommunicator, &fiberCommunicationRequests_[fiberNo*nRequestsPerFiber + 2]), "MPI_Igatherv");
 
-          if (useVc_)
-          {
-            global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
-            int entryNo = valueIndexAllFibers % Vc::double_v::size();
+    // increase index for fiberData_ struct
+    if (computingRank == rankSubset->ownRankNo())
+      fiberDataNo++;
+  }
 
-            //LOG(DEBUG) << "valueIndexAllFibers: " << valueIndexAllFibers << ", (" << pointBuffersNo << "," << entryNo << ")";
+  // prepare the computation of the first 0D half step, this does not depend on the data that is in transfer
+  const bool computeDuringFetch = startComputation0D && useVc_ && !fiberData_.empty() && instances[0].numberTimeSteps() > 0;
+  double startTime0D = 0;
+  double timeStepWidth0D = 0;
+  int nTimeSteps0D = 0;
+  std::vector<int> nMissingFibersOfPointBuffer;       // for every point buffer, the number of fibers in the point buffer whose data has not yet arrived
+  std::vector<global_no_t> readyPointBuffers;         // point buffers whose data is complete and that can be computed
 
-            // set all received parameter values for the current instance in the correct slot in the vc vector of the current pointBuffer compute buffer
-            for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
-            {
-              fiberPointBuffersParameters_[pointBuffersNo][parameterNo][entryNo] = parametersReceiveBuffer[instanceNo*nParametersPerInstance + parameterNo];
-            }
+  if (computeDuringFetch)
+  {
+    getTimeStepping0D(startTime0D, timeStepWidth0D, nTimeSteps0D);
 
-            if (VLOG_IS_ON(1))
-            {
-              if (entryNo == Vc::double_v::size()-1)
-              {
-                VLOG(1) << "stored " << nParametersPerInstance << " parameters in buffer no " << pointBuffersNo << ": " << fiberPointBuffersParameters_[pointBuffersNo];
-              }
-            }
-          }
-          else
+    Control::PerformanceMeasurement::start(durationLogKey0D_);
+    prepareStimulation0D(startTime0D, timeStepWidth0D, nTimeSteps0D);
+    Control::PerformanceMeasurement::stop(durationLogKey0D_, 0);
+
+    // a point buffer can contain values of two or more fibers
+    nMissingFibersOfPointBuffer.assign(fiberPointBuffers_.size(), 0);
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      const global_no_t firstPointBuffersNo = fiberData_[fiberDataNo].valuesOffset / Vc::double_v::size();
+      const global_no_t lastPointBuffersNo = (fiberData_[fiberDataNo].valuesOffset + fiberData_[fiberDataNo].valuesLength - 1) / Vc::double_v::size();
+
+      for (global_no_t pointBuffersNo = firstPointBuffersNo; pointBuffersNo <= lastPointBuffersNo; pointBuffersNo++)
+        nMissingFibersOfPointBuffer[pointBuffersNo]++;
+    }
+  }
+
+  // wait for the operations to complete, store the data of every fiber as soon as all its operations are complete
+  std::vector<int> nCompletedRequests(nFibers, 0);
+  std::vector<int> completedRequestIndices(fiberCommunicationRequests_.size());
+  int nRemainingFibers = nFibers;
+
+  while (nRemainingFibers > 0)
+  {
+    int nCompleted = 0;
+    MPIUtility::handleReturnValue(MPI_Waitsome(fiberCommunicationRequests_.size(), fiberCommunicationRequests_.data(), &nCompleted,
+                                               completedRequestIndices.data(), MPI_STATUSES_IGNORE), "MPI_Waitsome");
+
+    if (nCompleted == MPI_UNDEFINED)
+      break;
+
+    for (int completedNo = 0; completedNo < nCompleted; completedNo++)
+    {
+      const int fiberNo = completedRequestIndices[completedNo] / nRequestsPerFiber;
+      nCompletedRequests[fiberNo]++;
+
+      if (nCompletedRequests[fiberNo] == nRequestsPerFiber)
+      {
+        nRemainingFibers--;
+
+        // store result from parametersReceiveBuffer and vmValues (for current fiber) to the compute buffers
+        const int fiberDataNo = fiberCommunication_[fiberNo].fiberDataNo;
+        if (fiberDataNo != -1)
+        {
+          storeFetchedFiberData(fiberNo, nParametersPerInstance);
+
+          // point buffers for which this was the last missing fiber are ready to be computed
+          if (computeDuringFetch)
           {
-            int instanceNoToCompute = fiberDataNo*nInstancesOnFiber + instanceNo;
+            const global_no_t firstPointBuffersNo = fiberData_[fiberDataNo].valuesOffset / Vc::double_v::size();
+            const global_no_t lastPointBuffersNo = (fiberData_[fiberDataNo].valuesOffset + fiberData_[fiberDataNo].valuesLength - 1) / Vc::double_v::size();
 
-            // set all received parameter values for the current instance in the correct slot in the vc vector of the current pointBuffer compute buffer
-            for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
+            for (global_no_t pointBuffersNo = firstPointBuffersNo; pointBuffersNo <= lastPointBuffersNo; pointBuffersNo++)
             {
-              // gpuParameters_[parameterNo*nInstances + instanceNo]
-              gpuParameters_[parameterNo*nInstancesToCompute_ + instanceNoToCompute] = parametersReceiveBuffer[instanceNo*nParametersPerInstance + parameterNo];
+              nMissingFibersOfPointBuffer[pointBuffersNo]--;
+              if (nMissingFibersOfPointBuffer[pointBuffersNo] == 0)
+                readyPointBuffers.push_back(pointBuffersNo);
             }
           }
         }
+      }
+    }
 
-        if (!useVc_)
-        {
-          int nElementsOnFiber = fiberFunctionSpace->nElementsGlobal();
-          for (int elementNo = 0; elementNo < nElementsOnFiber; elementNo++)
-          {
-            gpuElementLengths_[fiberDataNo*nElementsOnFiber + elementNo] = elementLengthsReceiveBuffer[elementNo];
-          }
-        }
+    // compute the first 0D half step of the point buffers that are ready, while the data of the other fibers is still in transfer
+    if (computeDuringFetch && !readyPointBuffers.empty())
+    {
+      Control::PerformanceMeasurement::start(durationLogKey0D_);
+
+      const int nReadyPointBuffers = readyPointBuffers.size();
+      #pragma omp parallel for num_threads(nThreads_) schedule(static)
+      for (int readyPointBuffersNo = 0; readyPointBuffersNo < nReadyPointBuffers; readyPointBuffersNo++)
+      {
+        compute0DPointBuffer(readyPointBuffers[readyPointBuffersNo], startTime0D, timeStepWidth0D, nTimeSteps0D, false);
       }
+      readyPointBuffers.clear();
+
+      Control::PerformanceMeasurement::stop(durationLogKey0D_, 0);
+    }
+  }
 
-      // get the data_.parameters() raw pointer
-      innerInstances[j].discretizableInTime().data().restoreParameterValues();
+  // finish the first 0D half step, like at the end of compute0D, after all point buffers have been computed
+  if (computeDuringFetch)
+  {
+    Control::PerformanceMeasurement::start(durationLogKey0D_);
+    updateEquilibrium0D(nTimeSteps0D);
 
-      // increase index for fiberData_ struct
-      if (computingRank == rankSubset->ownRankNo())
-        fiberDataNo++;
+    if (adaptiveTimeStepping0D_)
+    {
+      logAdaptiveTimeStepping0DStatistics();
     }
+    Control::PerformanceMeasurement::stop(durationLogKey0D_);
+
+    // computeMonodomain does not compute this half step again
+    first0DStepComputedDuringFetch_ = true;
   }
+}
 
-  if (useVc_)
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+storeFetchedFiberData(int fiberNo, int nParametersPerInstance)
+{
+  const FiberCommunication &fiberCommunication = fiberCommunication_[fiberNo];
+  const int fiberDataNo = fiberCommunication.fiberDataNo;
+  const std::vector<double> &parametersReceiveBuffer = fiberCommunication.parametersReceiveBuffer;
+
+  // store result from parametersReceiveBuffer (for current fiber) to fiberPointBuffersParameters_ (for a vc vector)
+  // loop over number of instances of the problem on the current fiber
+  int nInstancesOnFiber = fiberData_[fiberDataNo].vmValues.size();
+
+  for (int instanceNo = 0; instanceNo < nInstancesOnFiber; instanceNo++)
   {
-    // copy Vm values to compute buffers
-    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    // compute indices for fiberPointBuffersParameters_
+    global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + instanceNo;
+
+    if (useVc_)
     {
-      int nValues = fiberData_[fiberDataNo].vmValues.size();
+      global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+      int entryNo = valueIndexAllFibers % Vc::double_v::size();
 
-      for (int valueNo = 0; valueNo < nValues; valueNo++)
+      //LOG(DEBUG) << "valueIndexAllFibers: " << valueIndexAllFibers << ", (" << pointBuffersNo << "," << entryNo << ")";
+
+      // set all received parameter values for the current instance in the correct slot in the vc vector of the current pointBuffer compute buffer
+      for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
       {
-        global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
+        fiberPointBuffersParameters_[pointBuffersNo][parameterNo][entryNo] = parametersReceiveBuffer[instanceNo*nParametersPerInstance + parameterNo];
+      }
 
-        global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
-        int entryNo = valueIndexAllFibers % Vc::double_v::size();
+      // copy Vm value to compute buffers
+      fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = fiberData_[fiberDataNo].vmValues[instanceNo];
 
-        fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = fiberData_[fiberDataNo].vmValues[valueNo];
+      if (VLOG_IS_ON(1))
+      {
+        if (entryNo == Vc::double_v::size()-1)
+        {
+          VLOG(1) << "stored " << nParametersPerInstance << " parameters in buffer no " << pointBuffersNo << ": " << fiberPointBuffersParameters_[pointBuffersNo];
+        }
+      }
+    }
+    else
+    {
+      int instanceNoToCompute = fiberDataNo*nInstancesOnFiber + instanceNo;
+
+      // set all received parameter values for the current instance in the correct slot in the vc vector of the current pointBuffer compute buffer
+      for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
+      {
+        // gpuParameters_[parameterNo*nInstances + instanceNo]
+        gpuParameters_[parameterNo*nInstancesToCompute_ + instanceNoToCompute] = parametersReceiveBuffer[instanceNo*nParametersPerInstance + parameterNo];
       }
     }
   }
+
+  if (!useVc_)
+  {
+    int nElementsOnFiber = fiberData_[fiberDataNo].elementLengths.size();
+    for (int elementNo = 0; elementNo < nElementsOnFiber; elementNo++)
+    {
+      gpuElementLengths_[fiberDataNo*nElementsOnFiber + elementNo] = fiberData_[fiberDataNo].elementLengths[elementNo];
+    }
+  }
 }
 
 //! send vmValues data from fiberData_ back to the fibers where it belongs to and set in the respective field variable
@@ -270,158 +432,179 @@ updateFiberData()
   }
 
   LOG(TRACE) << "updateFiberData";
-  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
-  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing
+  if (fiberCommunication_.empty())
+    initializeFiberCommunication();
 
-  int fiberNo = 0;
-  int fiberDataNo = 0;
-  for (int i = 0; i < instances.size(); i++)
+  // As in fetchFiberData, the scatter operations of all fibers are started at once and the received values of a fiber
+  // are stored in the field variables as soon as its operations are complete.
+  // There are two operations per fiber: Vm values and further states and algebraics
+  const int nRequestsPerFiber = 2;
+  const int nFibers = fiberCommunication_.size();
+  fiberCommunicationRequests_.resize(nFibers*nRequestsPerFiber);
+
+  int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
+
+  // loop over fibers and start the communication of the values back to the ranks that own parts of the fiber
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
   {
-    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
-      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+    FiberCommunication &fiberCommunication = fiberCommunication_[fiberNo];
+    const int i = fiberCommunication.instanceNo;
+    const int j = fiberCommunication.innerInstanceNo;
 
-    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
-    {
-      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
-      //CellmlAdapterType &cellmlAdapter = innerInstances[j].discretizableInTime();
+    std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = nestedSolvers_.instancesLocal()[i].timeStepping1().instancesLocal()[j].data().functionSpace();
 
-      // prepare helper variables for Scatterv
-      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
-      MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
-      int computingRank = fiberNo % rankSubset->size();
+    // prepare helper variables for Scatterv
+    std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+    MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+    int computingRank = fiberComputingRank_[fiberNo];
 
-      std::vector<int> nDofsOnRanks(rankSubset->size());
-      std::vector<int> offsetsOnRanks(rankSubset->size());
+    double *sendBufferVmValues = nullptr;
+    double *sendBuffer = nullptr;
+    if (computingRank == rankSubset->ownRankNo())
+    {
+      sendBufferVmValues = fiberData_[fiberCommunication.fiberDataNo].vmValues.data();
+      sendBuffer = fiberData_[fiberCommunication.fiberDataNo].furtherStatesAndAlgebraicsValues.data();
+    }
 
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
-      {
-        offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
-        nDofsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
-      }
+    //  int MPI_Iscatterv(const void *sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype,
+    //                  void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request)
+    // communicate Vm values
+    MPIUtility::handleReturnValue(MPI_Iscatterv(sendBufferVmValues, fiberCommunication.nDofsOnRanks.data(), fiberCommunication.offsetsOnRanks.data(), MPI_DOUBLE,
+                                                fiberCommunication.vmValuesReceiveBuffer.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
+                                                computingRank, mpiCommunicator, &fiberCommunicationRequests_[fiberNo*nRequestsPerFiber + 0]), "MPI_Iscatterv");
 
-      double *sendBufferVmValues = nullptr;
-      if (computingRank == rankSubset->ownRankNo())
-      {
-        sendBufferVmValues = fiberData_[fiberDataNo].vmValues.data();
-      }
+    // communicate further states and algebraics that are selected by the options "statesForTransfer" and "algebraicsForTransfer"
+    MPIUtility::handleReturnValue(MPI_Iscatterv(sendBuffer, fiberCommunication.nValuesOnRanks.data(), fiberCommunication.valuesOffsetsOnRanks.data(), MPI_DOUBLE,
+                                                fiberCommunication.valuesReceiveBuffer.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts() * nStatesAndAlgebraicsValues, MPI_DOUBLE,
+                                                computingRank, mpiCommunicator, &fiberCommunicationRequests_[fiberNo*nRequestsPerFiber + 1]), "MPI_Iscatterv");
 
-      //  int MPI_Scatterv(const void *sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype,
-      //                  void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm)
-      // communicate Vm values
-      std::vector<double> vmValuesLocal(fiberFunctionSpace->nDofsLocalWithoutGhosts());
-      MPI_Scatterv(sendBufferVmValues, nDofsOnRanks.data(), offsetsOnRanks.data(), MPI_DOUBLE,
-                   vmValuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
-                   computingRank, mpiCommunicator);
+    VLOG(1) << "Iscatterv from rank " << computingRank << ", sizes: " << fiberCommunication.nDofsOnRanks << ", offsets: " << fiberCommunication.offsetsOnRanks
+      << ", furtherStatesAndAlgebraicsValues sizes: " << fiberCommunication.nValuesOnRanks << ", offsets: " << fiberCommunication.valuesOffsetsOnRanks;
+  }
 
-      VLOG(1) << "Scatterv from rank " << computingRank << ", sizes: " << nDofsOnRanks << ", offsets: " << offsetsOnRanks << ", received local values " << vmValuesLocal;
+  // wait for the operations to complete, store the values of every fiber as soon as all its operations are complete
+  std::vector<int> nCompletedRequests(nFibers, 0);
+  std::vector<int> completedRequestIndices(fiberCommunicationRequests_.size());
+  int nRemainingFibers = nFibers;
 
-      // store Vm values in CellmlAdapter and diffusion FiniteElementMethod
-      VLOG(1) << "fiber " << fiberDataNo << ", set values " << vmValuesLocal;
-      innerInstances[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
-      instances[i].timeStepping2().instancesLocal()[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
+  while (nRemainingFibers > 0)
+  {
+    int nCompleted = 0;
+    MPIUtility::handleReturnValue(MPI_Waitsome(fiberCommunicationRequests_.size(), fiberCommunicationRequests_.data(), &nCompleted,
+                                               completedRequestIndices.data(), MPI_STATUSES_IGNORE), "MPI_Waitsome");
 
-      // ----------------------
-      // communicate further states and algebraics that are selected by the options "statesForTransfer" and "algebraicsForTransfer"
+    if (nCompleted == MPI_UNDEFINED)
+      break;
 
-      std::vector<int> nValuesOnRanks(rankSubset->size());
-      int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
+    for (int completedNo = 0; completedNo < nCompleted; completedNo++)
+    {
+      const int fiberNo = completedRequestIndices[completedNo] / nRequestsPerFiber;
+      nCompletedRequests[fiberNo]++;
 
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
+      if (nCompletedRequests[fiberNo] == nRequestsPerFiber)
       {
-        offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo) * nStatesAndAlgebraicsValues;
-        nValuesOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo) * nStatesAndAlgebraicsValues;
+        nRemainingFibers--;
+        storeUpdatedFiberData(fiberNo);
       }
+    }
+  }
+}
 
-      double *sendBuffer = nullptr;
-      if (computingRank == rankSubset->ownRankNo())
-      {
-        sendBuffer = fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues.data();
-      }
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+storeUpdatedFiberData(int fiberNo)
+{
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
-      std::vector<double> valuesLocal(fiberFunctionSpace->nDofsLocalWithoutGhosts() * nStatesAndAlgebraicsValues);
-      MPI_Scatterv(sendBuffer, nValuesOnRanks.data(), offsetsOnRanks.data(), MPI_DOUBLE,
-                   valuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts() * nStatesAndAlgebraicsValues, MPI_DOUBLE,
-                   computingRank, mpiCommunicator);
+  const FiberCommunication &fiberCommunication = fiberCommunication_[fiberNo];
+  const int i = fiberCommunication.instanceNo;
+  const int j = fiberCommunication.innerInstanceNo;
 
-      VLOG(1) << "Scatterv furtherStatesAndAlgebraicsValues from rank " << computingRank << ", sizes: " << nValuesOnRanks << ", offsets: " << offsetsOnRanks
-        << ", sendBuffer: " << sendBuffer << ", received local values: " << valuesLocal;
+  std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+    = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
 
-      // store received states and algebraics values in diffusion slotConnectorData
-      // loop over further states to transfer
-      int furtherDataIndex = 0;
-      for (int stateIndex = 1; stateIndex < statesForTransferIndices_.size(); stateIndex++, furtherDataIndex++)
-      {
-        // store in diffusion
+  std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
 
-        // get field variable
-        std::vector<::Data::ComponentOfFieldVariable<FiberFunctionSpace,1>> &variable1
-          = instances[i].timeStepping2().instancesLocal()[j].getSlotConnectorData()->variable1;
+  const std::vector<double> &vmValuesLocal = fiberCommunication.vmValuesReceiveBuffer;
+  const std::vector<double> &valuesLocal = fiberCommunication.valuesReceiveBuffer;
 
-        if (stateIndex >= variable1.size())
-        {
-          continue;
-        }
-        std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableStates
-          = variable1[stateIndex].values;
+  // store Vm values in CellmlAdapter and diffusion FiniteElementMethod
+  VLOG(1) << "fiber " << fiberNo << ", set values " << vmValuesLocal;
+  innerInstances[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
+  instances[i].timeStepping2().instancesLocal()[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
 
-        int nValues = fiberFunctionSpace->nDofsLocalWithoutGhosts();
-        double *values = valuesLocal.data() + furtherDataIndex * nValues;
+  VLOG(1) << "received furtherStatesAndAlgebraicsValues: " << valuesLocal;
 
-        // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
-        fieldVariableStates->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+  // store received states and algebraics values in diffusion slotConnectorData
+  // loop over further states to transfer
+  int furtherDataIndex = 0;
+  for (int stateIndex = 1; stateIndex < statesForTransferIndices_.size(); stateIndex++, furtherDataIndex++)
+  {
+    // store in diffusion
 
-        // store in cellmlAdapter
-        std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,nStates>> fieldVariableStatesCellML
-          = instances[i].timeStepping1().instancesLocal()[j].getSlotConnectorData()->variable1[stateIndex].values;
+    // get field variable
+    std::vector<::Data::ComponentOfFieldVariable<FiberFunctionSpace,1>> &variable1
+      = instances[i].timeStepping2().instancesLocal()[j].getSlotConnectorData()->variable1;
 
-        const int componentNo = statesForTransferIndices_[stateIndex];
+    if (stateIndex >= variable1.size())
+    {
+      continue;
+    }
+    std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableStates
+      = variable1[stateIndex].values;
 
-        // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
-        fieldVariableStatesCellML->setValues(componentNo, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+    int nValues = fiberFunctionSpace->nDofsLocalWithoutGhosts();
+    const double *values = valuesLocal.data() + furtherDataIndex * nValues;
 
-        VLOG(1) << "store " << nValues << " values for additional state " << statesForTransferIndices_[stateIndex];
-      }
+    // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
+    fieldVariableStates->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
 
-      // loop over algebraics to transfer
-      for (int algebraicIndex = 0; algebraicIndex < algebraicsForTransferIndices_.size(); algebraicIndex++, furtherDataIndex++)
-      {
-        // store in diffusion
+    // store in cellmlAdapter
+    std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,nStates>> fieldVariableStatesCellML
+      = instances[i].timeStepping1().instancesLocal()[j].getSlotConnectorData()->variable1[stateIndex].values;
 
-        // get field variable
-        std::vector<::Data::ComponentOfFieldVariable<FiberFunctionSpace,1>> &variable2
-          = instances[i].timeStepping2().instancesLocal()[j].getSlotConnectorData()->variable2;
+    const int componentNo = statesForTransferIndices_[stateIndex];
 
-        if (algebraicIndex >= variable2.size())
-        {
-          continue;
-        }
+    // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
+    fieldVariableStatesCellML->setValues(componentNo, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+
+    VLOG(1) << "store " << nValues << " values for additional state " << statesForTransferIndices_[stateIndex];
+  }
+
+  // loop over algebraics to transfer
+  for (int algebraicIndex = 0; algebraicIndex < algebraicsForTransferIndices_.size(); algebraicIndex++, furtherDataIndex++)
+  {
+    // store in diffusion
 
-        std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableAlgebraics
-          = variable2[algebraicIndex].values;
+    // get field variable
+    std::vector<::Data::ComponentOfFieldVariable<FiberFunctionSpace,1>> &variable2
+      = instances[i].timeStepping2().instancesLocal()[j].getSlotConnectorData()->variable2;
 
-        int nValues = fiberFunctionSpace->nDofsLocalWithoutGhosts();
-        double *values = valuesLocal.data() + furtherDataIndex * nValues;
+    if (algebraicIndex >= variable2.size())
+    {
+      continue;
+    }
 
-        // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
-        fieldVariableAlgebraics->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+    std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableAlgebraics
+      = variable2[algebraicIndex].values;
 
-        // store in CellmlAdapter
-        std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableAlgebraicsCellML
-          = instances[i].timeStepping1().instancesLocal()[j].getSlotConnectorData()->variable2[algebraicIndex].values;
+    int nValues = fiberFunctionSpace->nDofsLocalWithoutGhosts();
+    const double *values = valuesLocal.data() + furtherDataIndex * nValues;
 
-        //const int componentNo = algebraicsForTransferIndices_[algebraicIndex];
+    // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
+    fieldVariableAlgebraics->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
 
-        // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
-        fieldVariableAlgebraicsCellML->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+    // store in CellmlAdapter
+    std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>> fieldVariableAlgebraicsCellML
+      = instances[i].timeStepping1().instancesLocal()[j].getSlotConnectorData()->variable2[algebraicIndex].values;
 
-        LOG(DEBUG) << "store " << nValues << " values for algebraic " << algebraicsForTransferIndices_[algebraicIndex];
-        LOG(DEBUG) << *fieldVariableAlgebraics;
-      }
+    //const int componentNo = algebraicsForTransferIndices_[algebraicIndex];
 
-      // increase index for fiberData_ struct
-      if (computingRank == rankSubset->ownRankNo())
-        fiberDataNo++;
-    }
+    // int componentNo, int nValues, const dof_no_t *dofNosLocal, const double *values
+    fieldVariableAlgebraicsCellML->setValues(0, nValues, fiberFunctionSpace->meshPartition()->dofNosLocal().data(), values);
+
+    LOG(DEBUG) << "store " << nValues << " values for algebraic " << algebraicsForTransferIndices_[algebraicIndex];
+    LOG(DEBUG) << *fieldVariableAlgebraics;
   }
 }
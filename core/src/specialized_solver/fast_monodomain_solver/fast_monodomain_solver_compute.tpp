@@ -2,6 +2,8 @@
 
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include <omp.h>
+#include <map>
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
@@ -17,8 +19,15 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 {
   LOG(TRACE) << "FastMonodomainSolver::advanceTimeSpan";
 
-  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing
-  fetchFiberData();
+  // migrate fibers from overloaded ranks to other ranks, this has to be done before the data of the fibers is fetched to the computing ranks
+  if (loadBalancing_ && nAdvanceTimeSpanCallsSinceLoadBalancing_ >= loadBalancingInterval_)
+  {
+    rebalanceFibers();
+  }
+
+  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing,
+  // the first 0D half step of the point buffers already starts while the data of other fibers is still in transfer
+  fetchFiberData(true);
 
   //Control::PerformanceMeasurement::startFlops();
 
@@ -27,6 +36,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
   //Control::PerformanceMeasurement::endFlops();
 
+  if (loadBalancing_)
+    nAdvanceTimeSpanCallsSinceLoadBalancing_++;
+
   // loop over fibers and communicate resulting values back
   updateFiberData();
 
@@ -61,9 +73,6 @@ computeMonodomain()
   // fetch timestep widths and total time span
   std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
-  TimeSteppingScheme::Heun<CellmlAdapterType> &heun = instances[0].timeStepping1().instancesLocal()[0];
-  durationLogKey0D_ = heun.durationLogKey();
-
   DiffusionTimeSteppingScheme &implicitEuler = instances[0].timeStepping2().instancesLocal()[0];
   durationLogKey1D_ = implicitEuler.durationLogKey();
   double prefactor = implicitEuler.discretizableInTime().data().context().getPythonConfig().getOptionDouble("prefactor", 1.0);
@@ -74,9 +83,9 @@ computeMonodomain()
   double timeStepWidthSplitting = instances[0].timeStepWidth();
   nTimeStepsSplitting_ = instances[0].numberTimeSteps();
 
-  heun.setTimeSpan(startTime, startTime + 0.5 * timeStepWidthSplitting);
-  double dt0D = heun.timeStepWidth();
-  int nTimeSteps0D = heun.numberTimeSteps();
+  double dt0D = 0;
+  int nTimeSteps0D = 0;
+  getTimeStepping0D(startTime, dt0D, nTimeSteps0D);
 
   implicitEuler.setTimeSpan(startTime, startTime + timeStepWidthSplitting);
   double dt1D = implicitEuler.timeStepWidth();
@@ -95,6 +104,10 @@ computeMonodomain()
   //        |
   //        2
 
+  // the first 0D half step of the first splitting time step may already have been computed in fetchFiberData
+  const bool first0DStepComputedDuringFetch = first0DStepComputedDuringFetch_;
+  first0DStepComputedDuringFetch_ = false;
+
   if (fiberData_.empty())
   {
     LOG(DEBUG) << "In computeMonodomain(" << startTime << "," << timeStepWidthSplitting
@@ -116,14 +129,35 @@ computeMonodomain()
     bool storeAlgebraicsForTransfer = timeStepNo == nTimeStepsSplitting_-1;   // after the last timestep, store the algebraics for transfer
 
     // perform splitting
-    compute0D(currentTime, dt0D, nTimeSteps0D, false);
+    if (timeStepNo > 0 || !first0DStepComputedDuringFetch)
+      compute0D(currentTime, dt0D, nTimeSteps0D, false);
+    const double startTime1D = omp_get_wtime();
     compute1D(currentTime, dt1D, nTimeSteps1D, prefactor);
+    if (loadBalancing_)
+      computeDuration1D_ += omp_get_wtime() - startTime1D;
+
     compute0D(midTime,     dt0D, nTimeSteps0D, storeAlgebraicsForTransfer);
   }
 
   currentTime_ = instances[0].endTime();
 }
 
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+getTimeStepping0D(double &startTime, double &timeStepWidth, int &nTimeSteps)
+{
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+
+  TimeSteppingScheme::Heun<CellmlAdapterType> &heun = instances[0].timeStepping1().instancesLocal()[0];
+  durationLogKey0D_ = heun.durationLogKey();
+
+  // the 0D problem is solved for half of the splitting time step width
+  startTime = instances[0].startTime();
+  heun.setTimeSpan(startTime, startTime + 0.5 * instances[0].timeStepWidth());
+  timeStepWidth = heun.timeStepWidth();
+  nTimeSteps = heun.numberTimeSteps();
+}
+
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer)
@@ -147,31 +181,150 @@ compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlge
     return;
   }
 
-  const double factorForForDataNo = (double)Vc::double_v::size() / fiberData_[0].valuesLength;
+  // The computation is done in three phases:
+  // 1. (serial) determine for all fibers at which time steps they get stimulated, this modifies fiberData_ and fiberHasBeenStimulated_
+  // 2. (parallel) compute all point buffers, every thread only writes to its own point buffers
+  // 3. (serial) update the equilibrium information, which involves the neighbouring point buffers
+  // This way the result does not depend on the number of threads.
+
+  // phase 1: determine stimulation
+  prepareStimulation0D(startTime, timeStepWidth, nTimeSteps);
+
+  // phase 2: compute all point buffers
+  #pragma omp parallel for num_threads(nThreads_) schedule(static)
   for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
   {
-    int fiberDataNo = pointBuffersNo * factorForForDataNo;
-    int indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
+    compute0DPointBuffer(pointBuffersNo, startTime, timeStepWidth, nTimeSteps, storeAlgebraicsForTransfer);
+  }
 
-    // determine if current point is at center of fiber
-    int fiberCenterIndex = fiberData_[fiberDataNo].fiberStimulationPointIndex;
-    bool currentPointIsInCenter = (unsigned long)(fiberCenterIndex - indexInFiber) < Vc::double_v::size();  // note that this is different from abs(...)
+  // phase 3: update the information which point buffers are at equilibrium
+  updateEquilibrium0D(nTimeSteps);
 
-    VLOG(3) << "currentPointIsInCenter: " << currentPointIsInCenter << ", pointBuffersNo: " << pointBuffersNo << ", fiberDataNo: " << fiberDataNo << ", indexInFiber:" << indexInFiber << ", fiberCenterIndex: " << fiberCenterIndex << ", " << (indexInFiber - fiberCenterIndex) << " < " << Vc::double_v::size();
+  // visualize equilibrium states for debugging
+#if 0
+  if (storeAlgebraicsForTransfer)
+  {
+    std::stringstream s;
+    int fiberDataNoPrevious = -1;
+    for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+    {
+      int fiberDataNo = pointBuffersNo * Vc::double_v::size() / fiberData_[0].valuesLength;
+      if (fiberDataNoPrevious != fiberDataNo)
+      {
+        s << std::endl << fiberDataNo;
+        fiberDataNoPrevious = fiberDataNo;
+      }
 
-    VLOG(3) << "pointBuffersNo: " << pointBuffersNo << ", fiberDataNo: " << fiberDataNo << ", indexInFiber: " << indexInFiber;
+      switch(fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo])
+      {
+      case constant:
+        s << ".";
+        break;
+      case neighbour_not_constant:
+        s << "n";
+        break;
+      case not_constant:
+        s << "N";
+        break;
+      }
+    }
+    LOG(INFO) << s.str();
+  }
+#endif
+
+  if (adaptiveTimeStepping0D_)
+  {
+    logAdaptiveTimeStepping0DStatistics();
+  }
+
+  VLOG(1) << "nFiberPointBuffers: " << nPointBuffers;
+  Control::PerformanceMeasurement::stop(durationLogKey0D_);
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+compute0DPointBuffer(global_no_t pointBuffersNo, double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer)
+{
+  const double factorForForDataNo = (double)Vc::double_v::size() / fiberData_[0].valuesLength;
+
+  // measure the computation time of the point buffer for the load balancing
+  const double computeStartTime = (loadBalancing_? omp_get_wtime() : 0.0);
 
-    // save previous state values for equilibrium acceleration
-    Vc::double_v statesPreviousValues[nStates];
+  int fiberDataNo = pointBuffersNo * factorForForDataNo;
+  int indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
 
-    if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  // determine if current point is at center of fiber
+  int fiberCenterIndex = fiberData_[fiberDataNo].fiberStimulationPointIndex;
+  bool currentPointIsInCenter = (unsigned long)(fiberCenterIndex - indexInFiber) < Vc::double_v::size();  // note that this is different from abs(...)
+
+  // the first time step at which the current point gets stimulated, or nTimeSteps if it is not stimulated
+  const int firstStimulatedTimeStepNo = (currentPointIsInCenter? fiberFirstStimulatedTimeStepNo_[fiberDataNo] : nTimeSteps);
+
+  // save previous state values for equilibrium acceleration
+  Vc::double_v statesPreviousValues[nStates];
+
+  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  {
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
     {
-      for (int stateNo = 0; stateNo < nStates; stateNo++)
+      statesPreviousValues[stateNo] = fiberPointBuffers_[pointBuffersNo].states[stateNo];
+    }
+  }
+
+  // if the current point does not need to get computed because the value won't change, until it gets stimulated
+  const bool isAtEquilibrium = disableComputationWhenStatesAreCloseToEquilibrium_
+    && fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] == constant;
+
+  if (adaptiveTimeStepping0D_)
+  {
+    fiberPointBuffersNSteps0D_[pointBuffersNo] = 0;
+    fiberPointBuffersNRejectedSteps0D_[pointBuffersNo] = 0;
+
+    // determine the first time step that has to be computed, the time steps before are skipped like in the loop with fixed time step width below
+    int timeStepNo = 0;
+    if (isAtEquilibrium)
+      timeStepNo = firstStimulatedTimeStepNo;
+    if (onlyComputeIfHasBeenStimulated_)
+      timeStepNo = std::max(timeStepNo, fiberFirstComputedTimeStepNo_[fiberDataNo]);
+
+    // advance with adaptive time step widths between the stimulated time steps, the stimulated time steps themselves are computed with the fixed time step width
+    while (timeStepNo < nTimeSteps)
+    {
+      double currentTime = startTime + timeStepNo * timeStepWidth;
+
+      // compute a stimulated time step with the fixed time step width
+      if (currentPointIsInCenter && fiberStimulatedInTimeStep_[fiberDataNo*nTimeSteps + timeStepNo])
       {
-        statesPreviousValues[stateNo] = fiberPointBuffers_[pointBuffersNo].states[stateNo];
+        const bool argumentStoreAlgebraics = storeAlgebraicsForTransfer && timeStepNo == nTimeSteps-1;
+        compute0DInstance_(fiberPointBuffers_[pointBuffersNo].states, fiberPointBuffersParameters_[pointBuffersNo],
+                           currentTime, timeStepWidth, true,
+                           argumentStoreAlgebraics, fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo],
+                           algebraicsForTransferIndices_, valueForStimulatedPoint_);
+        fiberPointBuffersNSteps0D_[pointBuffersNo]++;
+        timeStepNo++;
+        continue;
+      }
+
+      // find the next stimulated time step, the adaptive steps have to end exactly there
+      int nextStimulatedTimeStepNo = timeStepNo+1;
+      if (currentPointIsInCenter)
+      {
+        while (nextStimulatedTimeStepNo < nTimeSteps && !fiberStimulatedInTimeStep_[fiberDataNo*nTimeSteps + nextStimulatedTimeStepNo])
+          nextStimulatedTimeStepNo++;
+      }
+      else
+      {
+        nextStimulatedTimeStepNo = nTimeSteps;
       }
-    }
 
+      const bool argumentStoreAlgebraics = storeAlgebraicsForTransfer && nextStimulatedTimeStepNo == nTimeSteps;
+      compute0DInstanceAdaptive(pointBuffersNo, currentTime, startTime + nextStimulatedTimeStepNo * timeStepWidth,
+                                timeStepWidth, argumentStoreAlgebraics);
+      timeStepNo = nextStimulatedTimeStepNo;
+    }
+  }
+  else
+  {
     // loop over timesteps
     for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
     {
@@ -179,19 +332,17 @@ compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlge
       double currentTime = startTime + timeStepNo * timeStepWidth;
 
       // check if current point will be stimulated
-      bool stimulateCurrentPoint = false;
-      if (currentPointIsInCenter)
-        stimulateCurrentPoint = isCurrentPointStimulated(fiberDataNo, currentTime, currentPointIsInCenter);
+      bool stimulateCurrentPoint = currentPointIsInCenter && fiberStimulatedInTimeStep_[fiberDataNo*nTimeSteps + timeStepNo];
       const bool argumentStoreAlgebraics = storeAlgebraicsForTransfer && timeStepNo == nTimeSteps-1;
 
       // if the current point does not need to get computed because the value won't change
-      if (isEquilibriumAccelerationCurrentPointDisabled(stimulateCurrentPoint, pointBuffersNo))
+      if (isAtEquilibrium && timeStepNo < firstStimulatedTimeStepNo)
       {
         continue;
       }
 
       // do not compute fiber if respective option is set and the fiber has not yet been stimulated
-      if (onlyComputeIfHasBeenStimulated_ && !fiberHasBeenStimulated_[fiberDataNo])
+      if (onlyComputeIfHasBeenStimulated_ && timeStepNo < fiberFirstComputedTimeStepNo_[fiberDataNo])
       {
         continue;
       }
@@ -203,46 +354,233 @@ compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlge
                          argumentStoreAlgebraics, fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo],
                          algebraicsForTransferIndices_, valueForStimulatedPoint_);
     }  // loop over timesteps
+  }
 
-    equilibriumAccelerationUpdate(statesPreviousValues, pointBuffersNo);
+  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  {
+    fiberPointBuffersAreAtEquilibrium_[pointBuffersNo] = checkStatesAreAtEquilibrium(statesPreviousValues, pointBuffersNo);
+  }
 
-    //VLOG(3) << "-> index " << pointBuffersNo << ", states [" << state0 << "," << state1 << "," << state2 << "," << state3 << "]";
+  if (loadBalancing_)
+  {
+    fiberPointBuffersComputeDuration0D_[pointBuffersNo] += omp_get_wtime() - computeStartTime;
   }
+}
 
-  // visualize equilibrium states for debugging
-#if 0
-  if (storeAlgebraicsForTransfer)
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+updateEquilibrium0D(int nTimeSteps)
+{
+  if (!disableComputationWhenStatesAreCloseToEquilibrium_)
+    return;
+
+  const int nPointBuffers = fiberPointBuffers_.size();
+  const double factorForForDataNo = (double)Vc::double_v::size() / fiberData_[0].valuesLength;
+
+  for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
   {
-    std::stringstream s;
-    int fiberDataNoPrevious = -1;
-    for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+    // if the point buffer was stimulated, it is no longer constant
+    int fiberDataNo = pointBuffersNo * factorForForDataNo;
+    int indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
+    int fiberCenterIndex = fiberData_[fiberDataNo].fiberStimulationPointIndex;
+    bool currentPointIsInCenter = (unsigned long)(fiberCenterIndex - indexInFiber) < Vc::double_v::size();
+
+    if (currentPointIsInCenter && fiberFirstStimulatedTimeStepNo_[fiberDataNo] < nTimeSteps)
     {
-      int fiberDataNo = pointBuffersNo * Vc::double_v::size() / fiberData_[0].valuesLength;
-      if (fiberDataNoPrevious != fiberDataNo)
+      equilibriumAccelerationStimulate(pointBuffersNo, true);
+    }
+
+    equilibriumAccelerationUpdate(fiberPointBuffersAreAtEquilibrium_[pointBuffersNo], pointBuffersNo);
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+compute0DInstanceAdaptive(int pointBuffersNo, double startTime, double endTime, double timeStepWidth, bool storeAlgebraicsForTransfer)
+{
+  // This is the step size control of TimeSteppingScheme::HeunAdaptive, applied to a single point buffer:
+  // one Heun step with width h is compared to two Heun steps with width h/2, the difference gives the estimator of the local error.
+  // The steps with width h/2 are accepted if the estimator is below the tolerance. The time step width is kept for the next call,
+  // such that point buffers at rest quickly reach large time step widths and point buffers in the wavefront keep small ones.
+  // No logging in this method, because it is called from multiple threads.
+
+  double &adaptiveTimeStepWidth = fiberPointBuffersTimeStepWidth0D_[pointBuffersNo];
+  if (adaptiveTimeStepWidth <= 0)
+    adaptiveTimeStepWidth = timeStepWidth;
+
+  const double maximumTimeStepWidth = (adaptiveTimeStepping0DMaximumTimeStepWidth_ > 0? adaptiveTimeStepping0DMaximumTimeStepWidth_ : endTime - startTime);
+  const double timeEpsilon = 1e-10 * timeStepWidth;
+
+  Vc::double_v *states = fiberPointBuffers_[pointBuffersNo].states;
+  Vc::double_v statesFullStep[nStates];
+  Vc::double_v statesHalfSteps[nStates];
+
+  double currentTime = startTime;
+  while (currentTime < endTime - timeEpsilon)
+  {
+    // the last step ends exactly at endTime
+    const double remainingTime = endTime - currentTime;
+    const bool isTruncated = adaptiveTimeStepWidth >= remainingTime - timeEpsilon;
+    const double h = (isTruncated? remainingTime : adaptiveTimeStepWidth);
+
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      statesFullStep[stateNo] = states[stateNo];
+      statesHalfSteps[stateNo] = states[stateNo];
+    }
+
+    // one step with h, two steps with h/2, only the last step stores the algebraics for transfer
+    compute0DInstance_(statesFullStep, fiberPointBuffersParameters_[pointBuffersNo], currentTime, h, false,
+                       false, fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo], algebraicsForTransferIndices_, valueForStimulatedPoint_);
+    compute0DInstance_(statesHalfSteps, fiberPointBuffersParameters_[pointBuffersNo], currentTime, 0.5*h, false,
+                       false, fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo], algebraicsForTransferIndices_, valueForStimulatedPoint_);
+    compute0DInstance_(statesHalfSteps, fiberPointBuffersParameters_[pointBuffersNo], currentTime + 0.5*h, 0.5*h, false,
+                       storeAlgebraicsForTransfer && isTruncated, fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo],
+                       algebraicsForTransferIndices_, valueForStimulatedPoint_);
+
+    // compute the 2-norm of the difference over all states and lanes, as in HeunAdaptive
+    Vc::double_v squaredDifference = 0.0;
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      const Vc::double_v difference = statesHalfSteps[stateNo] - statesFullStep[stateNo];
+      squaredDifference += difference*difference;
+    }
+    double differenceNorm = 0;
+    for (int laneNo = 0; laneNo < Vc::double_v::size(); laneNo++)
+    {
+      differenceNorm += squaredDifference[laneNo];
+    }
+    differenceNorm = std::sqrt(differenceNorm);
+
+    double estimator;
+    if (!std::isfinite(differenceNorm) || differenceNorm > 1e+75)
+      estimator = 1.2*adaptiveTimeStepping0DTolerance_;
+    else
+      estimator = std::max(1e-10, differenceNorm / ((1.0 - pow(0.5, 2))*h));
+
+    const double alpha = pow(adaptiveTimeStepping0DTolerance_/estimator, 1.0/3.0);
+
+    // accept the step if the error is below the tolerance or the time step width cannot be reduced any further
+    if (estimator <= adaptiveTimeStepping0DTolerance_ || h <= adaptiveTimeStepping0DMinimumTimeStepWidth_)
+    {
+      for (int stateNo = 0; stateNo < nStates; stateNo++)
       {
-        s << std::endl << fiberDataNo;
-        fiberDataNoPrevious = fiberDataNo;
+        states[stateNo] = statesHalfSteps[stateNo];
       }
+      currentTime += h;
+      fiberPointBuffersNSteps0D_[pointBuffersNo]++;
+    }
+    else
+    {
+      fiberPointBuffersNRejectedSteps0D_[pointBuffersNo]++;
+    }
 
-      switch(fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo])
+    // adjust the time step width, a step that was truncated to end at endTime does not increase it
+    if (!isTruncated || alpha < 1.0)
+    {
+      adaptiveTimeStepWidth = std::min(maximumTimeStepWidth, std::max(adaptiveTimeStepping0DMinimumTimeStepWidth_, 0.9*alpha*h));
+    }
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+logAdaptiveTimeStepping0DStatistics()
+{
+  // accumulate the numbers of steps of the last compute0D call
+  const int nPointBuffers = fiberPointBuffers_.size();
+  long long nSteps = 0;
+  long long nRejectedSteps = 0;
+  for (int pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+  {
+    const int nStepsPointBuffer = fiberPointBuffersNSteps0D_[pointBuffersNo];
+    const int nRejectedStepsPointBuffer = fiberPointBuffersNRejectedSteps0D_[pointBuffersNo];
+
+    // point buffers that were skipped completely, e.g., because they are at equilibrium, do not count
+    if (nStepsPointBuffer + nRejectedStepsPointBuffer > 0)
+      nAdaptiveComputedPointBuffers0DTotal_++;
+
+    nSteps += nStepsPointBuffer;
+    nRejectedSteps += nRejectedStepsPointBuffer;
+    nAdaptiveSteps0DMaximum_ = std::max(nAdaptiveSteps0DMaximum_, nStepsPointBuffer);
+  }
+  nAdaptiveSteps0DTotal_ += nSteps;
+  nAdaptiveRejectedSteps0DTotal_ += nRejectedSteps;
+
+  VLOG(1) << "adaptive time stepping in compute0D: " << nSteps << " accepted and " << nRejectedSteps << " rejected steps of "
+    << nPointBuffers << " point buffers";
+
+  // store the statistics over all compute0D calls in the log file
+  double nStepsPerPointBufferMean = 0;
+  if (nAdaptiveComputedPointBuffers0DTotal_ > 0)
+    nStepsPerPointBufferMean = (double)nAdaptiveSteps0DTotal_ / nAdaptiveComputedPointBuffers0DTotal_;
+
+  Control::PerformanceMeasurement::setParameter("nAdaptiveSteps0DTotal", nAdaptiveSteps0DTotal_);
+  Control::PerformanceMeasurement::setParameter("nAdaptiveRejectedSteps0DTotal", nAdaptiveRejectedSteps0DTotal_);
+  Control::PerformanceMeasurement::setParameter("nAdaptiveSteps0DPerPointBufferMean", nStepsPerPointBufferMean);
+  Control::PerformanceMeasurement::setParameter("nAdaptiveSteps0DPerPointBufferMaximum", nAdaptiveSteps0DMaximum_);
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+prepareStimulation0D(double startTime, double timeStepWidth, int nTimeSteps)
+{
+  const int nFibers = fiberData_.size();
+  fiberStimulatedInTimeStep_.assign(nFibers*nTimeSteps, 0);
+  fiberFirstStimulatedTimeStepNo_.assign(nFibers, nTimeSteps);
+  fiberFirstComputedTimeStepNo_.resize(nFibers);
+
+  // fibers that have already been stimulated in a previous call are computed from the beginning
+  for (int fiberDataNo = 0; fiberDataNo < nFibers; fiberDataNo++)
+  {
+    fiberFirstComputedTimeStepNo_[fiberDataNo] = (fiberHasBeenStimulated_[fiberDataNo]? 0 : nTimeSteps);
+  }
+
+  // loop over point buffers to find the ones at the stimulation points of the fibers
+  const int nPointBuffers = fiberPointBuffers_.size();
+  const double factorForForDataNo = (double)Vc::double_v::size() / fiberData_[0].valuesLength;
+
+  for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+  {
+    int fiberDataNo = pointBuffersNo * factorForForDataNo;
+    int indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
+
+    // determine if current point is at center of fiber
+    int fiberCenterIndex = fiberData_[fiberDataNo].fiberStimulationPointIndex;
+    bool currentPointIsInCenter = (unsigned long)(fiberCenterIndex - indexInFiber) < Vc::double_v::size();  // note that this is different from abs(...)
+
+    VLOG(3) << "currentPointIsInCenter: " << currentPointIsInCenter << ", pointBuffersNo: " << pointBuffersNo << ", fiberDataNo: " << fiberDataNo << ", indexInFiber:" << indexInFiber << ", fiberCenterIndex: " << fiberCenterIndex << ", " << (indexInFiber - fiberCenterIndex) << " < " << Vc::double_v::size();
+
+    if (!currentPointIsInCenter)
+      continue;
+
+    // loop over timesteps
+    for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
+    {
+      double currentTime = startTime + timeStepNo * timeStepWidth;
+
+      // check if current point will be stimulated
+      bool stimulateCurrentPoint = isCurrentPointStimulated(fiberDataNo, currentTime, currentPointIsInCenter);
+      fiberStimulatedInTimeStep_[fiberDataNo*nTimeSteps + timeStepNo] = stimulateCurrentPoint;
+
+      if (stimulateCurrentPoint && fiberFirstStimulatedTimeStepNo_[fiberDataNo] == nTimeSteps)
       {
-      case constant:
-        s << ".";
-        break;
-      case neighbour_not_constant:
-        s << "n";
-        break;
-      case not_constant:
-        s << "N";
-        break;
+        fiberFirstStimulatedTimeStepNo_[fiberDataNo] = timeStepNo;
+      }
+
+      // the fiber has to be computed from the first time step on which it has been stimulated
+      if (fiberHasBeenStimulated_[fiberDataNo] && fiberFirstComputedTimeStepNo_[fiberDataNo] == nTimeSteps)
+      {
+        fiberFirstComputedTimeStepNo_[fiberDataNo] = timeStepNo;
       }
     }
-    LOG(INFO) << s.str();
-  }
-#endif
 
-  VLOG(1) << "nFiberPointBuffers: " << nPointBuffers;
-  Control::PerformanceMeasurement::stop(durationLogKey0D_);
+    // the neighbouring point buffers have to be computed as the stimulation diffuses into them
+    if (disableComputationWhenStatesAreCloseToEquilibrium_ && fiberFirstStimulatedTimeStepNo_[fiberDataNo] < nTimeSteps)
+    {
+      equilibriumAccelerationStimulate(pointBuffersNo, false);
+    }
+  }
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -260,6 +598,8 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
 
   LOG(DEBUG) << "compute1D(" << startTime << ")";
 
+  using Vc::double_v;
+
   // depending on DiffusionTimeSteppingScheme either do Implicit Euler or Crank-Nicolson
   // Implicit Euler step:
   // (K - 1/dt*M) u^{n+1} = -1/dt*M u^{n})
@@ -273,215 +613,183 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
                             TimeSteppingScheme::ImplicitEuler<typename DiffusionTimeSteppingScheme::DiscretizableInTime>
                           >::value;
 
+  // both schemes are theta-schemes: (theta*K - 1/dt*M) u^{n+1} = (-(1-theta)*K - 1/dt*M) u^{n}
+  const double theta = (useImplicitEuler? 1.0 : 0.5);
   const double dt = timeStepWidth;
 
-  // loop over fibers
-  for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+  // The tridiagonal systems of Vc::double_v::size() fibers with the same number of values are solved at once,
+  // every fiber of such a batch is stored in one SIMD lane (see initializeFiberBatches1D).
+  const int nLanes = Vc::double_v::size();
+  const int nBatches = fiberBatches1D_.size();
+  const int nPointBuffers = fiberPointBuffers_.size();
+
+  #pragma omp parallel num_threads(nThreads_)
   {
-    int nValues = fiberData_[fiberDataNo].vmValues.size();
+    // helper buffers c', d' and element lengths, they are allocated once per thread and reused for all batches
+    std::vector<double_v> cAlgebraic;
+    std::vector<double_v> dAlgebraic;
+    std::vector<double_v> elementLengths;
+
+    // loop over batches of fibers
+    #pragma omp for schedule(static)
+    for (int batchNo = 0; batchNo < nBatches; batchNo++)
+    {
+      const std::vector<int> &batch = fiberBatches1D_[batchNo];
+      std::vector<double_v> &u = fiberBatches1DVmValues_[batchNo];
+      const int nValues = fiberData_[batch[0]].valuesLength;
 
-#ifndef NDEBUG
-    VLOG(1) << "fiber " << fiberDataNo << "/" << fiberData_.size() << ", valuesOffset: " << fiberData_[fiberDataNo].valuesOffset
-      << ", has " << nValues << " values: ";
+      cAlgebraic.resize(nValues);
+      dAlgebraic.resize(nValues);
+      elementLengths.resize(nValues-1);
 
-    std::stringstream s, s2;
-    for (int valueNo = 0; valueNo < nValues; valueNo++)
-    {
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-      double u = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
-      if (valueNo != 0)
+      // gather the values of Vm and the element lengths of the fibers into the lanes
+      for (int laneNo = 0; laneNo < nLanes; laneNo++)
       {
-        s << ", ";
-        s2 << ",";
+        const FiberData &fiberData = fiberData_[batch[laneNo]];
+        for (int valueNo = 0; valueNo < nValues; valueNo++)
+        {
+          global_no_t valuesIndexAllFibers = fiberData.valuesOffset + valueNo;
+          global_no_t pointBuffersNo = valuesIndexAllFibers / nLanes;
+          int entryNo = valuesIndexAllFibers % nLanes;
+          u[valueNo][laneNo] = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+        }
+        for (int elementNo = 0; elementNo < nValues-1; elementNo++)
+        {
+          elementLengths[elementNo][laneNo] = fiberData.elementLengths[elementNo];
+        }
       }
-      s << u;
-      s2 << "[" << pointBuffersNo << "][" << entryNo << "](" << valuesIndexAllFibers << ")  ";
-    }
-    VLOG(1) << s.str();
-    //LOG(DEBUG) << "indices: " << s2.str();
-#endif
-    // [ b c     ] [x]   [d]
-    // [ a b c   ] [x] = [d]
-    // [   a b c ] [x]   [d]
-    // [     a b ] [x]   [d]
 
-    // Thomas algorithm
-    // forward substitution
-    // c'_0 = c_0 / b_0
-    // c'_i = c_i / (b_i - c'_{i-1}*a_i)
+      // [ b c     ] [x]   [d]
+      // [ a b c   ] [x] = [d]
+      // [   a b c ] [x]   [d]
+      // [     a b ] [x]   [d]
 
-    // d'_0 = d_0 / b_0
-    // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
+      // Thomas algorithm
+      // forward substitution
+      // c'_0 = c_0 / b_0
+      // c'_i = c_i / (b_i - c'_{i-1}*a_i)
 
-    // backward substitution
-    // x_n = d'_n
-    // x_i = d'_i - c'_i * x_{i+1}
+      // d'_0 = d_0 / b_0
+      // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
 
-    // helper buffers c', d'
-    static std::vector<double> cAlgebraic(nValues-1);
-    static std::vector<double> dAlgebraic(nValues);
-
-    // perform forward substitution
-    // loop over entries / rows of matrices
-    for (int valueNo = 0; valueNo < nValues; valueNo++)
-    {
-     // new with CN
-      double a = 0;
-      double b = 0;
-      double c = 0;
-      double d = 0;
-
-      double u_previous = 0;
-      double u_center = 0;
-      double u_next = 0;
-
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-      u_center = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+      // backward substitution
+      // x_n = d'_n
+      // x_i = d'_i - c'_i * x_{i+1}
 
-      // contribution from left element
-      if (valueNo > 0)
+      // perform forward substitution
+      // loop over entries / rows of matrices
+      for (int valueNo = 0; valueNo < nValues; valueNo++)
       {
-        global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo - 1;
-        global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-        int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-        u_previous = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+        double_v a = 0;
+        double_v b = 0;
+        double_v c = 0;
+        double_v d = 0;
 
-        // stencil K: 1/h*[1   _-1_ ]*prefactor
-        // stencil M:   h*[1/6 _1/3_]
+        const double_v u_center = u[valueNo];
 
-        double h_left = fiberData_[fiberDataNo].elementLengths[valueNo-1];
-        double k_left = 1./h_left*(1) * prefactor;
-        double m_left = h_left*1./6;
-
-        if (useImplicitEuler)
-        {
-          a = (k_left - 1/dt*m_left);
-        }
-        else  // Crank-Nicolson
+        // contribution from left element
+        if (valueNo > 0)
         {
-          a = (k_left/2. - 1/dt*m_left);
+          // stencil K: 1/h*[1   _-1_ ]*prefactor
+          // stencil M:   h*[1/6 _1/3_]
+
+          const double_v h_left = elementLengths[valueNo-1];
+          const double_v k_offDiagonal = prefactor / h_left;
+          const double_v m_offDiagonal = h_left * (1./6);
+          const double_v k_diagonal = -k_offDiagonal;
+          const double_v m_diagonal = h_left * (1./3);
+
+          a = theta*k_offDiagonal - 1/dt*m_offDiagonal;
+          b += theta*k_diagonal - 1/dt*m_diagonal;
+          d += (-(1-theta)*k_offDiagonal - 1/dt*m_offDiagonal) * u[valueNo-1] + (-(1-theta)*k_diagonal - 1/dt*m_diagonal) * u_center;
         }
 
-        double k_right = 1./h_left*(-1) * prefactor;
-        double m_right = h_left*1./3;
-
-        if (useImplicitEuler)
-        {
-          b += (k_right - 1/dt*m_right);
-          d += (-1/dt*m_left) * u_previous + (-1/dt*m_right) * u_center;
-        }
-        else  // Crank-Nicolson
+        // contribution from right element
+        if (valueNo < nValues-1)
         {
-          b += (k_right/2. - 1/dt*m_right);
-          d += (-k_left/2. - 1/dt*m_left) * u_previous + (-k_right/2. - 1/dt*m_right) * u_center;
+          // stencil K: 1/h*[_-1_  1  ]*prefactor
+          // stencil M:   h*[_1/3_ 1/6]
+
+          const double_v h_right = elementLengths[valueNo];
+          const double_v k_offDiagonal = prefactor / h_right;
+          const double_v m_offDiagonal = h_right * (1./6);
+          const double_v k_diagonal = -k_offDiagonal;
+          const double_v m_diagonal = h_right * (1./3);
+
+          c = theta*k_offDiagonal - 1/dt*m_offDiagonal;
+          b += theta*k_diagonal - 1/dt*m_diagonal;
+          d += (-(1-theta)*k_diagonal - 1/dt*m_diagonal) * u_center + (-(1-theta)*k_offDiagonal - 1/dt*m_offDiagonal) * u[valueNo+1];
         }
-      }
-
-      // contribution from right element
-      if (valueNo < nValues-1)
-      {
-        global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo + 1;
-        global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-        int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-        u_next = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
 
-        // stencil K: 1/h*[_-1_  1  ]*prefactor
-        // stencil M:   h*[_1/3_ 1/6]
-
-        double h_right = fiberData_[fiberDataNo].elementLengths[valueNo];
-        double k_right = 1./h_right*(1) * prefactor;
-        double m_right = h_right*1./6;
-
-        if (useImplicitEuler)
+        if (valueNo == 0)
         {
-          c = (k_right - 1/dt*m_right);
+          // c'_0 = c_0 / b_0
+          cAlgebraic[valueNo] = c / b;
+
+          // d'_0 = d_0 / b_0
+          dAlgebraic[valueNo] = d / b;
         }
-        else  // Crank-Nicolson
+        else
         {
-          c = (k_right/2. - 1/dt*m_right);
-        }
+          const double_v denominator = b - cAlgebraic[valueNo-1]*a;
 
-        double k_left = 1./h_right*(-1) * prefactor;
-        double m_left = h_right*1./3;
+          // c'_i = c_i / (b_i - c'_{i-1}*a_i)
+          cAlgebraic[valueNo] = c / denominator;
 
-        if (useImplicitEuler)
-        {
-          b += (k_left - 1/dt*m_left);
-          d += (-1/dt*m_left) * u_center + (-1/dt*m_right) * u_next;
-        }
-        else  // Crank-Nicolson
-        {
-          b += (k_left/2. - 1/dt*m_left);
-          d += (-k_left/2. - 1/dt*m_left) * u_center + (-k_right/2. - 1/dt*m_right) * u_next;
+          // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
+          dAlgebraic[valueNo] = (d - dAlgebraic[valueNo-1]*a) / denominator;
         }
       }
 
-      if (valueNo == 0)
-      {
-        // c'_0 = c_0 / b_0
-        cAlgebraic[valueNo] = c / b;
+      // perform backward substitution
+      // x_n = d'_n
+      u[nValues-1] = dAlgebraic[nValues-1];
 
-        // d'_0 = d_0 / b_0
-        dAlgebraic[valueNo] = d / b;
-      }
-      else
+      // loop over entries / rows of matrices
+      for (int valueNo = nValues-2; valueNo >= 0; valueNo--)
       {
-        if (valueNo != nValues-1)
-        {
-          // c'_i = c_i / (b_i - c'_{i-1}*a_i)
-          cAlgebraic[valueNo] = c / (b - cAlgebraic[valueNo-1]*a);
-        }
-
-        // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
-        dAlgebraic[valueNo] = (d - dAlgebraic[valueNo-1]*a) / (b - cAlgebraic[valueNo-1]*a);
+        // x_i = d'_i - c'_i * x_{i+1}
+        u[valueNo] = dAlgebraic[valueNo] - cAlgebraic[valueNo] * u[valueNo+1];
       }
+    }  // implicit barrier, all batches are solved
 
-#ifndef NDEBUG
-      if (valueNo < 5 || valueNo >= nValues-6)
-      {
-        VLOG(2) << "valueNo: " << valueNo << ", a: " << a << ", b: " << b << ", c: " << c << ", d: " << d
-          << ", u: " << u_center << ", c': " << (valueNo < nValues-1? cAlgebraic[valueNo] : 0) << ", d': " << dAlgebraic[valueNo]
-          << " = (" << d << "-" << dAlgebraic[valueNo-1]*a << ")/(" << b << "-" << cAlgebraic[valueNo-1]*a << ") = " << (d - dAlgebraic[valueNo-1]*a) << "/" << (b - cAlgebraic[valueNo-1]*a);
-      }
-#endif
-    }
+    // scatter the results back to the point buffers, every point buffer is written by a single thread only
+    int fiberDataNo = 0;
+    #pragma omp for schedule(static)
+    for (int pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+    {
+      double_v vmValues = fiberPointBuffers_[pointBuffersNo].states[0];
 
-    //LOG(DEBUG) << "cAlgebraic: " << cAlgebraic;
-    //LOG(DEBUG) << "dAlgebraic: " << dAlgebraic;
+      for (int entryNo = 0; entryNo < nLanes; entryNo++)
+      {
+        global_no_t valuesIndexAllFibers = pointBuffersNo * nLanes + entryNo;
 
-    // perform backward substitution
-    // x_n = d'_n
-    global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + nValues-1;
-    global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-    int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-    fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = dAlgebraic[nValues-1];
-    //LOG(DEBUG) << "set entry (" << pointBuffersNo << "," << entryNo << ") to " << dAlgebraic[nValues-1];
+        // advance to the fiber that contains the current value, fibers are stored contiguously in ascending order
+        while (fiberDataNo+1 < fiberData_.size() && valuesIndexAllFibers >= fiberData_[fiberDataNo+1].valuesOffset)
+          fiberDataNo++;
+        while (fiberDataNo > 0 && valuesIndexAllFibers < fiberData_[fiberDataNo].valuesOffset)
+          fiberDataNo--;
 
-    double previousValue = dAlgebraic[nValues-1];
+        const int valueNo = valuesIndexAllFibers - fiberData_[fiberDataNo].valuesOffset;
 
-    // loop over entries / rows of matrices
-    for (int valueNo = nValues-2; valueNo >= 0; valueNo--)
-    {
-      // x_i = d'_i - c'_i * x_{i+1}
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
+        // the last point buffer can contain padding entries that do not belong to any fiber
+        if (valueNo >= fiberData_[fiberDataNo].valuesLength)
+          continue;
 
-      double resultValue = dAlgebraic[valueNo] - cAlgebraic[valueNo] * previousValue;
-      fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = resultValue;
+        const std::pair<int,int> &batchNoAndLaneNo = fiberBatch1DNoAndLaneNo_[fiberDataNo];
+        vmValues[entryNo] = fiberBatches1DVmValues_[batchNoAndLaneNo.first][valueNo][batchNoAndLaneNo.second];
+      }
 
-      previousValue = resultValue;
+      fiberPointBuffers_[pointBuffersNo].states[0] = vmValues;
     }
-
-    int nPointBuffers = fiberPointBuffers_.size();
-    pointBuffersNo = int(nPointBuffers/2);
+  }
 
 #ifndef NDEBUG
-    s.str("");
+  for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+  {
+    int nValues = fiberData_[fiberDataNo].valuesLength;
+
+    std::stringstream s;
     for (int valueNo = 0; valueNo < nValues; valueNo++)
     {
       global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
@@ -492,12 +800,58 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
         s << ", ";
       s << u;
     }
-    VLOG(1) << " -> " << s.str();
-#endif
+    VLOG(1) << "fiber " << fiberDataNo << "/" << fiberData_.size() << ", valuesOffset: " << fiberData_[fiberDataNo].valuesOffset
+      << " -> " << s.str();
   }
+#endif
   Control::PerformanceMeasurement::stop(durationLogKey1D_);
 }
 
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+initializeFiberBatches1D()
+{
+  const int nLanes = Vc::double_v::size();
+
+  // group the fibers by their number of values, only fibers of equal length can be solved together
+  std::map<int,std::vector<int>> fiberDataNosByLength;
+  for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+  {
+    fiberDataNosByLength[fiberData_[fiberDataNo].valuesLength].push_back(fiberDataNo);
+  }
+
+  fiberBatches1D_.clear();
+  fiberBatches1DVmValues_.clear();
+  fiberBatch1DNoAndLaneNo_.resize(fiberData_.size());
+
+  // split every group into batches of nLanes fibers
+  for (std::pair<const int,std::vector<int>> &group : fiberDataNosByLength)
+  {
+    const int nValues = group.first;
+    const std::vector<int> &fiberDataNos = group.second;
+
+    for (int i = 0; i < fiberDataNos.size(); i += nLanes)
+    {
+      const int batchNo = fiberBatches1D_.size();
+      std::vector<int> batch(nLanes);
+      for (int laneNo = 0; laneNo < nLanes; laneNo++)
+      {
+        // if there are not enough fibers left, pad by repeating the last fiber, the result of these lanes is not used
+        const int fiberDataNo = fiberDataNos[std::min(i + laneNo, (int)fiberDataNos.size()-1)];
+        batch[laneNo] = fiberDataNo;
+
+        if (i + laneNo < fiberDataNos.size())
+          fiberBatch1DNoAndLaneNo_[fiberDataNo] = std::pair<int,int>(batchNo, laneNo);
+      }
+
+      fiberBatches1D_.push_back(batch);
+      fiberBatches1DVmValues_.push_back(std::vector<Vc::double_v>(nValues));
+    }
+  }
+
+  LOG(DEBUG) << "compute1D solves " << fiberData_.size() << " fibers in " << fiberBatches1D_.size() << " batches of " << nLanes << " fibers";
+}
+
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 bool FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 isCurrentPointStimulated(int fiberDataNo, double currentTime, bool currentPointIsInCenter)
@@ -620,48 +974,49 @@ isCurrentPointStimulated(int fiberDataNo, double currentTime, bool currentPointI
 
 // methods to improve speed by only computing states that are not in equilibrium
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
-void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
-equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int pointBuffersNo)
+bool FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+checkStatesAreAtEquilibrium(const Vc::double_v statesPreviousValues[], int pointBuffersNo)
 {
-  // check if states for the current point are at their equilibrium
-  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  // loop over all states
+  for (int stateNo = 0; stateNo < nStates; stateNo++)
   {
-    bool statesAreAtEquilibrium = true;
+    // compute relative change
+    const Vc::double_v newValue = fiberPointBuffers_[pointBuffersNo].states[stateNo];
+    const Vc::double_v oldValue = statesPreviousValues[stateNo];
 
-    // if the current point is not constant and therefore was computed
-    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] != constant)
+    Vc::double_v relativeChange;
+    // if any value is 0, use absolute error
+    if (fabs(Vc::min(newValue)) < 1e-11)
     {
-      // check if it now was indeed constant
-      // loop over all states
-      for (int stateNo = 0; stateNo < nStates; stateNo++)
-      {
-        // compute relative change
-        const Vc::double_v newValue = fiberPointBuffers_[pointBuffersNo].states[stateNo];
-        const Vc::double_v oldValue = statesPreviousValues[stateNo];
-
-        Vc::double_v relativeChange;
-        // if any value is 0, use absolute error
-        if (fabs(Vc::min(newValue)) < 1e-11)
-        {
-          relativeChange = Vc::abs(newValue - oldValue);
-        }
-        else
-        {
-          // values are not zero, use relative error
-          relativeChange = Vc::abs((newValue - oldValue) / newValue);
-        }
-        double changeValue = Vc::max(relativeChange);
-
+      relativeChange = Vc::abs(newValue - oldValue);
+    }
+    else
+    {
+      // values are not zero, use relative error
+      relativeChange = Vc::abs((newValue - oldValue) / newValue);
+    }
+    double changeValue = Vc::max(relativeChange);
 
-        // if change is higher than tolerance
-        if (changeValue > 1e-5)
-        {
-          //LOG(INFO) << "point " << pointBuffersNo << " state " << stateNo << " " << oldValue << "->" << newValue << ": " << relativeChange << " " << changeValue;
+    // if change is higher than tolerance
+    if (changeValue > 1e-5)
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-          statesAreAtEquilibrium = false;
-          break;
-        }
-      }
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+equilibriumAccelerationUpdate(bool statesAreAtEquilibrium, int pointBuffersNo)
+{
+  // check if states for the current point are at their equilibrium
+  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  {
+    // if the current point is constant, it was not computed and is still at equilibrium
+    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] == constant)
+    {
+      statesAreAtEquilibrium = true;
     }
 /*
     // for debugging
@@ -748,37 +1103,28 @@ equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int poi
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
-bool FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
-isEquilibriumAccelerationCurrentPointDisabled(bool stimulateCurrentPoint, int pointBuffersNo)
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+equilibriumAccelerationStimulate(int pointBuffersNo, bool setOwnPointBuffer)
 {
-  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  if (setOwnPointBuffer)
   {
-    if (stimulateCurrentPoint)
-    {
-      fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = not_constant;
+    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] == constant)
+      nFiberPointBufferStatesCloseToEquilibrium_--;
+    fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = not_constant;
+    return;
+  }
 
-      // set neighbouring point buffers to "neighbour_not_constant"
-      if (pointBuffersNo > 0)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == constant)
-        {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == constant)
-            nFiberPointBufferStatesCloseToEquilibrium_--;
-          fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] = neighbour_not_constant;
-        }
-      if (pointBuffersNo < fiberPointBuffers_.size()-1)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == constant)
-        {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == constant)
-            nFiberPointBufferStatesCloseToEquilibrium_--;
-          fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] = neighbour_not_constant;
-        }
+  // set neighbouring point buffers to "neighbour_not_constant"
+  if (pointBuffersNo > 0)
+    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == constant)
+    {
+      nFiberPointBufferStatesCloseToEquilibrium_--;
+      fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] = neighbour_not_constant;
     }
-
-    // do not compute current point if the states are at the equilibrium anyways and won't change by the computation
-    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] == constant)
+  if (pointBuffersNo < fiberPointBuffers_.size()-1)
+    if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == constant)
     {
-      return true;
+      nFiberPointBufferStatesCloseToEquilibrium_--;
+      fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] = neighbour_not_constant;
     }
-  }
-  return false;
 }
@@ -17,6 +17,12 @@ initializeCellMLSourceFileGpu()
   CellmlAdapterType &cellmlAdapter = nestedSolvers_.instancesLocal()[0].timeStepping1().instancesLocal()[0].discretizableInTime();
   bool approximateExponentialFunction = cellmlAdapter.approximateExponentialFunction();
 
+  if (cellmlAdapter.gatingVariablesScheme() != "heun")
+  {
+    LOG(WARNING) << "Option \"gatingVariablesScheme\": \"" << cellmlAdapter.gatingVariablesScheme() << "\" of the CellML adapter "
+      << "is not implemented for the FastMonodomainSolver with optimizationType \"gpu\", all states are integrated with the Heun scheme.";
+  }
+
   PythonConfig specificSettingsCellML = cellmlAdapter.specificSettings();
   CellmlSourceCodeGenerator &cellmlSourceCodeGenerator = cellmlAdapter.cellmlSourceCodeGenerator();
 
@@ -4,6 +4,7 @@
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
 #include <random>
+#include <omp.h>
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
@@ -55,6 +56,26 @@ initialize()
   valueForStimulatedPoint_ = specificSettings_.getOptionDouble("valueForStimulatedPoint", 20.0);
   neuromuscularJunctionRelativeSize_ = specificSettings_.getOptionDouble("neuromuscularJunctionRelativeSize", 0.0);
   generateGpuSource_ = specificSettings_.getOptionBool("generateGPUSource", true);
+  nThreads_ = specificSettings_.getOptionInt("nThreads", 1, PythonUtility::NonNegative);
+  adaptiveTimeStepping0D_ = specificSettings_.getOptionBool("adaptiveTimeStepping0D", false);
+  adaptiveTimeStepping0DTolerance_ = specificSettings_.getOptionDouble("adaptiveTimeStepping0DTolerance", 0.1, PythonUtility::Positive);
+  adaptiveTimeStepping0DMinimumTimeStepWidth_ = specificSettings_.getOptionDouble("adaptiveTimeStepping0DMinimumTimeStepWidth", 1e-6, PythonUtility::Positive);
+  adaptiveTimeStepping0DMaximumTimeStepWidth_ = specificSettings_.getOptionDouble("adaptiveTimeStepping0DMaximumTimeStepWidth", 0.0, PythonUtility::NonNegative);
+  nAdaptiveSteps0DTotal_ = 0;
+  nAdaptiveRejectedSteps0DTotal_ = 0;
+  nAdaptiveComputedPointBuffers0DTotal_ = 0;
+  nAdaptiveSteps0DMaximum_ = 0;
+  loadBalancing_ = specificSettings_.getOptionBool("loadBalancing", false);
+  loadBalancingInterval_ = specificSettings_.getOptionInt("loadBalancingInterval", 10, PythonUtility::Positive);
+  loadBalancingImbalanceThreshold_ = specificSettings_.getOptionDouble("loadBalancingImbalanceThreshold", 1.1, PythonUtility::Positive);
+  nAdvanceTimeSpanCallsSinceLoadBalancing_ = 0;
+  first0DStepComputedDuringFetch_ = false;
+  computeDuration1D_ = 0;
+
+  // 0 means to use the default number of threads of OpenMP, e.g., given by the OMP_NUM_THREADS environment variable
+  if (nThreads_ == 0)
+    nThreads_ = omp_get_max_threads();
+  LOG(DEBUG) << "compute0D uses " << nThreads_ << " thread" << (nThreads_ == 1? "" : "s");
 
   // output warning if there are output writers
   if (this->outputWriterManager_.hasOutputWriters())
@@ -74,6 +95,14 @@ initialize()
     useVc_ = false;
   else if (optimizationType_ == "vc")
     useVc_ = true;
+  else if (optimizationType_ == "interpreter")
+  {
+    // the 0D code of the FastMonodomainSolver is always generated and compiled, there is no interpreter variant of it
+    LOG(WARNING) << "FastMonodomainSolver is used with \"optimizationType\": \"interpreter\", but the bytecode interpreter is not used by the FastMonodomainSolver. "
+      << "Now using \"vc\", i.e. the 0D code is generated and compiled at runtime.";
+    useVc_ = true;
+    optimizationType_ = "vc";
+  }
   else
   {
     LOG(ERROR) << "FastMonodomainSolver is used with invalid \"optimizationType\": \"" << optimizationType_
@@ -82,6 +111,20 @@ initialize()
     optimizationType_ = "vc";
   }
 
+  if (adaptiveTimeStepping0D_ && !useVc_)
+  {
+    LOG(WARNING) << "Option \"adaptiveTimeStepping0D\" of FastMonodomainSolver is only implemented for optimizationType \"vc\", "
+      << "not for \"" << optimizationType_ << "\". Now using the fixed time step width of the Heun scheme.";
+    adaptiveTimeStepping0D_ = false;
+  }
+
+  if (loadBalancing_ && !useVc_)
+  {
+    LOG(WARNING) << "Option \"loadBalancing\" of FastMonodomainSolver is only implemented for optimizationType \"vc\", "
+      << "not for \"" << optimizationType_ << "\". Now using the static assignment of fibers to ranks.";
+    loadBalancing_ = false;
+  }
+
   std::shared_ptr<Partition::RankSubset> rankSubset = nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
 
   LOG(DEBUG) << "config: " << specificSettings_;
@@ -179,6 +222,7 @@ initialize()
   int nFibers = 0;
   int fiberNo = 0;
   nFibersToCompute_ = 0;
+  fiberComputingRank_.clear();
 
   LOG(DEBUG) << "initialize " << instances.size() << " outer instances";
 
@@ -192,7 +236,10 @@ initialize()
     {
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+
+      // initially, the fibers are assigned round-robin to the ranks of their rank subset, this can be changed later by rebalanceFibers()
       int computingRank = fiberNo % rankSubset->size();
+      fiberComputingRank_.push_back(computingRank);
 
       LOG(DEBUG) << "instance (inner,outer)=(i,j)=(" << i << "," << j << ")/(" << instances.size() << "," << innerInstances.size() << ")"
         << ", fiberNo " << fiberNo << ", rankSubset: " << *rankSubset << ", mesh" << fiberFunctionSpace->meshName() << ", computingRank " << computingRank << ", own rank: " << rankSubset->ownRankNo() << "/" << rankSubset->size();
@@ -238,7 +285,7 @@ initialize()
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
 
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
-      int computingRank = fiberNo % rankSubset->size();
+      int computingRank = fiberComputingRank_[fiberNo];
 
       if (computingRank == rankSubset->ownRankNo())
       {
@@ -353,8 +400,15 @@ initialize()
     fiberPointBuffersAlgebraicsForTransfer_.resize(nVcVectors);
     fiberPointBuffersParameters_.resize(nVcVectors);
     fiberPointBuffersStatesAreCloseToEquilibrium_.resize(nVcVectors, not_constant);
+    fiberPointBuffersAreAtEquilibrium_.resize(nVcVectors, false);
+    fiberPointBuffersTimeStepWidth0D_.resize(nVcVectors, 0.0);
+    fiberPointBuffersNSteps0D_.resize(nVcVectors, 0);
+    fiberPointBuffersNRejectedSteps0D_.resize(nVcVectors, 0);
+    fiberPointBuffersComputeDuration0D_.resize(nVcVectors, 0.0);
     nFiberPointBufferStatesCloseToEquilibrium_ = 0;
 
+    // allocate the per point buffer data with the same thread distribution as in compute0D, such that the memory is located at the NUMA domain of the computing thread (first touch)
+    #pragma omp parallel for num_threads(nThreads_) schedule(static)
     for (int i = 0; i < nVcVectors; i++)
     {
       fiberPointBuffersAlgebraicsForTransfer_[i].resize(algebraicsForTransferIndices_.size());
@@ -363,11 +417,14 @@ initialize()
       for (int parameterNo = 0; parameterNo < nParametersPerInstance_; parameterNo++)
       {
         fiberPointBuffersParameters_[i][parameterNo] = parameterValues[parameterNo*nAlgebraicsLocalCellml];    // note, the stride in parameterValues is "nAlgebraicsLocalCellml", not "nParametersPerInstance_"
-
-        VLOG(1) << "fiberPointBuffersParameters_ buffer no " << i << ", parameter no " << parameterNo
-          << ", value: " <<  fiberPointBuffersParameters_[i][parameterNo];
       }
     }
+
+    for (int parameterNo = 0; parameterNo < nParametersPerInstance_ && nVcVectors > 0; parameterNo++)
+    {
+      VLOG(1) << "fiberPointBuffersParameters_ parameter no " << parameterNo
+        << ", value: " <<  fiberPointBuffersParameters_[0][parameterNo];
+    }
   }
   else
   {
@@ -426,7 +483,12 @@ initialize()
     initializeValuesOnGpu();
   }
 
-  // initialize state values
+  // group the fibers for the batched solution of the 1D problems
+  if (useVc_)
+    initializeFiberBatches1D();
+
+  // initialize state values, this is the first touch of the entries of fiberPointBuffers_, use the same thread distribution as in compute0D
+  #pragma omp parallel for num_threads(nThreads_) schedule(static)
   for (int i = 0; i < fiberPointBuffers_.size(); i++)
   {
     if (initializeStates_ != nullptr)
@@ -566,8 +628,16 @@ initializeCellMLSourceFileVc()
 
     LOG(DEBUG) << "generate source file \"" << sourceToCompileFilename << "\".";
 
+    // determine the gating states that will be integrated with the Rush-Larsen scheme
+    std::vector<int> rushLarsenStates;
+    if (cellmlAdapter.gatingVariablesScheme() == "rushLarsen")
+    {
+      rushLarsenStates = cellmlSourceCodeGenerator.findGatingStates();
+      LOG(INFO) << "FastMonodomainSolver: " << rushLarsenStates.size() << " of " << nStates << " states are integrated with the Rush-Larsen scheme.";
+    }
+
     // create source file
-    cellmlSourceCodeGenerator.generateSourceFileFastMonodomain(sourceToCompileFilename, approximateExponentialFunction);
+    cellmlSourceCodeGenerator.generateSourceFileFastMonodomain(sourceToCompileFilename, approximateExponentialFunction, rushLarsenStates);
 
     // create path for library file
     if (libraryFilename.find("/") != std::string::npos)
@@ -0,0 +1,487 @@
+#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_base.h"
+
+#include "partition/rank_subset.h"
+#include <omp.h>
+#include <numeric>
+#include <algorithm>
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+rebalanceFibers()
+{
+  LOG(TRACE) << "rebalanceFibers";
+
+  // The load balancing works as follows:
+  // 1. Every rank estimates the cost of its own fibers from the durations of compute0D and compute1D, measured since the last rebalancing.
+  // 2. The loads of all ranks are gathered. If the maximum load exceeds the mean load by more than loadBalancingImbalanceThreshold_, fibers are migrated.
+  // 3. Every overloaded rank decides for its own fibers, starting with the most expensive one, whether it can give the fiber to the least loaded rank
+  //    of the fiber's rank subset. Fibers can only move within their rank subset, because only these ranks have the data of the fiber.
+  //    The decision is broadcast in the rank subset of the fiber.
+  // 4. The states and stimulation data of the migrated fibers are sent to the new computing rank and all point buffers are rebuilt.
+  // The decisions of different overloaded ranks are not coordinated, i.e., a rank can receive fibers from multiple ranks and become overloaded itself.
+  // This is corrected at the next rebalancing.
+
+  nAdvanceTimeSpanCallsSinceLoadBalancing_ = 0;
+
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+
+  std::shared_ptr<Partition::RankSubset> rankSubsetGlobal = DihuContext::partitionManager()->rankSubsetForCollectiveOperations();
+  MPI_Comm mpiCommunicatorGlobal = rankSubsetGlobal->mpiCommunicator();
+  const int nRanksGlobal = rankSubsetGlobal->size();
+  int ownRankNoGlobal = rankSubsetGlobal->ownRankNo();
+
+  // determine the cost of the own fibers
+  std::vector<double> fiberCosts;
+  computeFiberCosts(fiberCosts);
+  double ownLoad = std::accumulate(fiberCosts.begin(), fiberCosts.end(), 0.0);
+
+  // reset the measured durations, the next rebalancing only considers the new measurements
+  std::fill(fiberPointBuffersComputeDuration0D_.begin(), fiberPointBuffersComputeDuration0D_.end(), 0.0);
+  computeDuration1D_ = 0;
+
+  // gather the loads of all ranks, then all ranks take the same decision whether to rebalance
+  std::vector<double> loads(nRanksGlobal);
+  MPIUtility::handleReturnValue(MPI_Allgather(&ownLoad, 1, MPI_DOUBLE, loads.data(), 1, MPI_DOUBLE, mpiCommunicatorGlobal), "MPI_Allgather");
+
+  const double meanLoad = std::accumulate(loads.begin(), loads.end(), 0.0) / nRanksGlobal;
+  const double maximumLoad = *std::max_element(loads.begin(), loads.end());
+  const double imbalance = (meanLoad > 0? maximumLoad / meanLoad : 1.0);
+
+  LOG(DEBUG) << "rebalanceFibers: own load " << ownLoad << " s, mean load: " << meanLoad << " s, maximum load: " << maximumLoad
+    << " s, imbalance: " << imbalance << ", threshold: " << loadBalancingImbalanceThreshold_;
+  Control::PerformanceMeasurement::setParameter("loadImbalanceFastMonodomain", imbalance);
+
+  if (imbalance <= loadBalancingImbalanceThreshold_)
+    return;
+
+  // determine the rank nos in rankSubsetGlobal of the ranks of every fiber's rank subset, this is only needed once
+  if (fiberRankSubsetGlobalRankNos_.empty())
+  {
+    for (int i = 0; i < instances.size(); i++)
+    {
+      std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+        = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+      for (int j = 0; j < innerInstances.size(); j++)
+      {
+        std::shared_ptr<Partition::RankSubset> rankSubset = innerInstances[j].data().functionSpace()->meshPartition()->rankSubset();
+
+        std::vector<int> globalRankNos(rankSubset->size());
+        MPIUtility::handleReturnValue(MPI_Allgather(&ownRankNoGlobal, 1, MPI_INT, globalRankNos.data(), 1, MPI_INT,
+                                                    rankSubset->mpiCommunicator()), "MPI_Allgather");
+        fiberRankSubsetGlobalRankNos_.push_back(globalRankNos);
+      }
+    }
+  }
+
+  // determine the fiberNo of every own fiber in fiberData_
+  std::vector<int> fiberNoOfFiberDataNo;
+  int fiberNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      std::shared_ptr<Partition::RankSubset> rankSubset = innerInstances[j].data().functionSpace()->meshPartition()->rankSubset();
+      if (fiberComputingRank_[fiberNo] == rankSubset->ownRankNo())
+        fiberNoOfFiberDataNo.push_back(fiberNo);
+    }
+  }
+  assert(fiberNoOfFiberDataNo.size() == fiberData_.size());
+
+  // decide which own fibers to give away, start with the most expensive fibers
+  std::vector<int> newComputingRankOfFiberDataNo(fiberData_.size(), -1);
+  std::vector<int> fiberDataNosSortedByCost(fiberData_.size());
+  std::iota(fiberDataNosSortedByCost.begin(), fiberDataNosSortedByCost.end(), 0);
+  std::stable_sort(fiberDataNosSortedByCost.begin(), fiberDataNosSortedByCost.end(),
+                   [&fiberCosts](int a, int b){return fiberCosts[a] > fiberCosts[b];});
+
+  for (int fiberDataNo : fiberDataNosSortedByCost)
+  {
+    if (ownLoad <= meanLoad)
+      break;
+
+    const double cost = fiberCosts[fiberDataNo];
+    if (cost <= 0)
+      continue;
+
+    // find the least loaded rank in the rank subset of the fiber
+    const std::vector<int> &globalRankNos = fiberRankSubsetGlobalRankNos_[fiberNoOfFiberDataNo[fiberDataNo]];
+    int targetRankNo = -1;
+    for (int rankNo = 0; rankNo < globalRankNos.size(); rankNo++)
+    {
+      if (globalRankNos[rankNo] == ownRankNoGlobal)
+        continue;
+
+      if (targetRankNo == -1 || loads[globalRankNos[rankNo]] < loads[globalRankNos[targetRankNo]])
+        targetRankNo = rankNo;
+    }
+
+    if (targetRankNo == -1)
+      continue;
+
+    // only migrate the fiber if the target rank stays below the own load and has less than the mean load
+    double &targetLoad = loads[globalRankNos[targetRankNo]];
+    if (targetLoad >= meanLoad || targetLoad + cost >= ownLoad)
+      continue;
+
+    newComputingRankOfFiberDataNo[fiberDataNo] = targetRankNo;
+    targetLoad += cost;
+    ownLoad -= cost;
+  }
+
+  // broadcast the new computing ranks in the rank subsets of the fibers and send the data of the migrated fibers
+  std::vector<int> fiberComputingRankPrevious = fiberComputingRank_;
+  std::map<int,std::vector<double>> sendFiberData;       // key is fiberNo, std::map such that the buffers do not move while the sends are in progress
+  std::map<int,std::vector<double>> receivedFiberData;   // key is fiberNo
+  std::vector<MPI_Request> requests;
+  int nMigratedFibers = 0;
+
+  fiberNo = 0;
+  int fiberDataNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
+      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+      MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+      const int computingRank = fiberComputingRankPrevious[fiberNo];
+
+      int newComputingRank = computingRank;
+      if (computingRank == rankSubset->ownRankNo())
+      {
+        if (newComputingRankOfFiberDataNo[fiberDataNo] != -1)
+          newComputingRank = newComputingRankOfFiberDataNo[fiberDataNo];
+      }
+
+      MPIUtility::handleReturnValue(MPI_Bcast(&newComputingRank, 1, MPI_INT, computingRank, mpiCommunicator), "MPI_Bcast");
+      fiberComputingRank_[fiberNo] = newComputingRank;
+
+      // send the data of the fiber from the previous to the new computing rank,
+      // all messages use the same tag, they are matched in the order of the fibers which is the same on all ranks
+      if (newComputingRank != computingRank)
+      {
+        nMigratedFibers++;
+        const int nValues = fiberFunctionSpace->nDofsGlobal();
+
+        if (computingRank == rankSubset->ownRankNo())
+        {
+          std::vector<double> &buffer = sendFiberData[fiberNo];
+          packFiberData(fiberDataNo, buffer);
+
+          requests.emplace_back();
+          MPIUtility::handleReturnValue(MPI_Isend(buffer.data(), buffer.size(), MPI_DOUBLE, newComputingRank, 0,
+                                                  mpiCommunicator, &requests.back()), "MPI_Isend");
+        }
+        else if (newComputingRank == rankSubset->ownRankNo())
+        {
+          std::vector<double> &buffer = receivedFiberData[fiberNo];
+          buffer.resize(packedFiberDataSize(nValues));
+
+          requests.emplace_back();
+          MPIUtility::handleReturnValue(MPI_Irecv(buffer.data(), buffer.size(), MPI_DOUBLE, computingRank, 0,
+                                                  mpiCommunicator, &requests.back()), "MPI_Irecv");
+        }
+      }
+
+      if (computingRank == rankSubset->ownRankNo())
+        fiberDataNo++;
+    }
+  }
+
+  if (!requests.empty())
+  {
+    MPIUtility::handleReturnValue(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+  }
+
+  LOG(DEBUG) << "rebalanceFibers: " << nMigratedFibers << " fibers of the own rank subsets are migrated, "
+    << sendFiberData.size() << " are sent, " << receivedFiberData.size() << " are received.";
+
+  // rebuild the data structures for the new assignment of the fibers
+  redistributeFiberPointBuffers(fiberComputingRankPrevious, receivedFiberData);
+
+  LOG(INFO) << "FastMonodomainSolver: load imbalance " << imbalance << ", now computing " << nFibersToCompute_ << " fibers on own rank ("
+    << sendFiberData.size() << " sent, " << receivedFiberData.size() << " received)";
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+computeFiberCosts(std::vector<double> &fiberCosts)
+{
+  const int nLanes = Vc::double_v::size();
+  const int nPointBuffers = fiberPointBuffers_.size();
+
+  fiberCosts.assign(fiberData_.size(), 0.0);
+  if (fiberData_.empty())
+    return;
+
+  // distribute the duration of every point buffer evenly to its entries, a point buffer can contain points of two fibers
+  int fiberDataNo = 0;
+  for (int pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+  {
+    for (int entryNo = 0; entryNo < nLanes; entryNo++)
+    {
+      global_no_t valuesIndexAllFibers = pointBuffersNo * nLanes + entryNo;
+
+      // advance to the fiber that contains the current value, fibers are stored contiguously in ascending order
+      while (fiberDataNo+1 < fiberData_.size() && valuesIndexAllFibers >= fiberData_[fiberDataNo+1].valuesOffset)
+        fiberDataNo++;
+
+      // the last point buffer can contain padding entries that do not belong to any fiber
+      if (valuesIndexAllFibers - fiberData_[fiberDataNo].valuesOffset >= fiberData_[fiberDataNo].valuesLength)
+        continue;
+
+      fiberCosts[fiberDataNo] += fiberPointBuffersComputeDuration0D_[pointBuffersNo] / nLanes;
+    }
+  }
+
+  // the cost of the 1D problem is proportional to the number of values of the fiber
+  if (nInstancesToCompute_ > 0)
+  {
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      fiberCosts[fiberDataNo] += computeDuration1D_ * fiberData_[fiberDataNo].valuesLength / nInstancesToCompute_;
+    }
+  }
+
+  VLOG(1) << "fiber costs: " << fiberCosts;
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+int FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+packedFiberDataSize(int nValues)
+{
+  // fiberStimulationPointIndex, lastStimulationCheckTime, currentJitter, jitterIndex, currentlyStimulating, fiberHasBeenStimulated_, states, algebraics for transfer
+  return 6 + nValues * (nStates + algebraicsForTransferIndices_.size());
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+packFiberData(int fiberDataNo, std::vector<double> &buffer)
+{
+  const FiberData &fiberData = fiberData_[fiberDataNo];
+  const int nValues = fiberData.valuesLength;
+  const int nAlgebraicsForTransfer = algebraicsForTransferIndices_.size();
+
+  buffer.resize(packedFiberDataSize(nValues));
+
+  // the data that changes during the simulation, the settings are taken from the CellmlAdapter on the receiving rank
+  buffer[0] = fiberData.fiberStimulationPointIndex;
+  buffer[1] = fiberData.lastStimulationCheckTime;
+  buffer[2] = fiberData.currentJitter;
+  buffer[3] = fiberData.jitterIndex;
+  buffer[4] = (fiberData.currentlyStimulating? 1.0 : 0.0);
+  buffer[5] = (fiberHasBeenStimulated_[fiberDataNo]? 1.0 : 0.0);
+
+  // states and algebraics for transfer, [s0p0, s0p1, s0p2, ... s1p0, s1p1, ...]
+  double *values = buffer.data() + 6;
+  for (int valueNo = 0; valueNo < nValues; valueNo++)
+  {
+    global_no_t valueIndexAllFibers = fiberData.valuesOffset + valueNo;
+    global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+    int entryNo = valueIndexAllFibers % Vc::double_v::size();
+
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      values[stateNo*nValues + valueNo] = fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo];
+    }
+    for (int algebraicNo = 0; algebraicNo < nAlgebraicsForTransfer; algebraicNo++)
+    {
+      values[(nStates + algebraicNo)*nValues + valueNo] = fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo][algebraicNo][entryNo];
+    }
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+redistributeFiberPointBuffers(const std::vector<int> &fiberComputingRankPrevious, std::map<int,std::vector<double>> &receivedFiberData)
+{
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+  const int nAlgebraicsForTransfer = algebraicsForTransferIndices_.size();
+
+  // keep the previous data to copy the fibers that stay on the own rank
+  std::vector<FiberData> fiberDataPrevious;
+  std::vector<bool> fiberHasBeenStimulatedPrevious;
+  std::vector<FiberPointBuffers<nStates>> fiberPointBuffersPrevious;
+  std::vector<std::vector<Vc::double_v>> fiberPointBuffersAlgebraicsForTransferPrevious;
+  fiberDataPrevious.swap(fiberData_);
+  fiberHasBeenStimulatedPrevious.swap(fiberHasBeenStimulated_);
+  fiberPointBuffersPrevious.swap(fiberPointBuffers_);
+  fiberPointBuffersAlgebraicsForTransferPrevious.swap(fiberPointBuffersAlgebraicsForTransfer_);
+
+  // determine the new fibers, for every new fiber the index in fiberDataPrevious or the fiberNo of the received data
+  std::vector<int> fiberDataNoPrevious;
+  std::vector<int> fiberNoReceived;
+  int fiberNo = 0;
+  int fiberDataNoPreviousCounter = 0;
+  nInstancesToCompute_ = 0;
+
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
+      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+
+      const bool wasComputed = fiberComputingRankPrevious[fiberNo] == rankSubset->ownRankNo();
+      const bool isComputed = fiberComputingRank_[fiberNo] == rankSubset->ownRankNo();
+
+      if (isComputed)
+      {
+        if (wasComputed)
+        {
+          // the fiber stays on the own rank
+          fiberData_.push_back(fiberDataPrevious[fiberDataNoPreviousCounter]);
+          fiberHasBeenStimulated_.push_back(fiberHasBeenStimulatedPrevious[fiberDataNoPreviousCounter]);
+          fiberDataNoPrevious.push_back(fiberDataNoPreviousCounter);
+          fiberNoReceived.push_back(-1);
+        }
+        else
+        {
+          // the fiber was received, set the settings from the CellmlAdapter as in initialize() and the current data from the received buffer
+          CellmlAdapterType &cellmlAdapter = innerInstances[j].discretizableInTime();
+          const std::vector<double> &buffer = receivedFiberData.at(fiberNo);
+
+          FiberData fiberData;
+          fiberData.valuesLength = fiberFunctionSpace->nDofsGlobal();
+          fiberData.fiberNoGlobal = PythonUtility::convertFromPython<int>::get(cellmlAdapter.pySetFunctionAdditionalParameter_);
+          fiberData.motorUnitNo = motorUnitNo_[fiberData.fiberNoGlobal % motorUnitNo_.size()];
+
+          fiberData.setSpecificStatesCallFrequency = cellmlAdapter.setSpecificStatesCallFrequency_;
+          fiberData.setSpecificStatesFrequencyJitter = cellmlAdapter.setSpecificStatesFrequencyJitter_;
+          fiberData.setSpecificStatesRepeatAfterFirstCall = cellmlAdapter.setSpecificStatesRepeatAfterFirstCall_;
+          fiberData.setSpecificStatesCallEnableBegin = cellmlAdapter.setSpecificStatesCallEnableBegin_;
+
+          fiberData.fiberStimulationPointIndex = (int)buffer[0];
+          fiberData.lastStimulationCheckTime = buffer[1];
+          fiberData.currentJitter = buffer[2];
+          fiberData.jitterIndex = (int)buffer[3];
+          fiberData.currentlyStimulating = buffer[4] != 0.0;
+
+          fiberData_.push_back(fiberData);
+          fiberHasBeenStimulated_.push_back(buffer[5] != 0.0);
+          fiberDataNoPrevious.push_back(-1);
+          fiberNoReceived.push_back(fiberNo);
+        }
+
+        // the fibers are stored contiguously in the point buffers
+        fiberData_.back().valuesOffset = nInstancesToCompute_;
+        nInstancesToCompute_ += fiberData_.back().valuesLength;
+      }
+
+      if (wasComputed)
+        fiberDataNoPreviousCounter++;
+    }
+  }
+
+  nFibersToCompute_ = fiberData_.size();
+
+  // get the initial parameter values, as in initialize()
+  CellmlAdapterType &cellmlAdapter = instances[0].timeStepping1().instancesLocal()[0].discretizableInTime();
+  int nInstancesLocalCellml;
+  int nAlgebraicsLocalCellml;
+  cellmlAdapter.getNumbers(nInstancesLocalCellml, nAlgebraicsLocalCellml, nParametersPerInstance_);
+  cellmlAdapter.data().prepareParameterValues();
+  double *parameterValues = cellmlAdapter.data().parameterValues();
+
+  // allocate and initialize the point buffers with the same thread distribution as in compute0D (first touch)
+  const int nVcVectors = (nInstancesToCompute_ + Vc::double_v::size() - 1) / Vc::double_v::size();
+
+  fiberPointBuffers_.resize(nVcVectors);
+  fiberPointBuffersAlgebraicsForTransfer_.resize(nVcVectors);
+  fiberPointBuffersParameters_.clear();
+  fiberPointBuffersParameters_.resize(nVcVectors);
+
+  #pragma omp parallel for num_threads(nThreads_) schedule(static)
+  for (int i = 0; i < nVcVectors; i++)
+  {
+    fiberPointBuffersAlgebraicsForTransfer_[i].resize(nAlgebraicsForTransfer);
+    fiberPointBuffersParameters_[i].resize(nParametersPerInstance_);
+
+    for (int parameterNo = 0; parameterNo < nParametersPerInstance_; parameterNo++)
+    {
+      fiberPointBuffersParameters_[i][parameterNo] = parameterValues[parameterNo*nAlgebraicsLocalCellml];    // note, the stride in parameterValues is "nAlgebraicsLocalCellml", not "nParametersPerInstance_"
+    }
+
+    // initialize the states such that the padding entries of the last point buffer have valid values
+    if (initializeStates_ != nullptr)
+    {
+      initializeStates_(fiberPointBuffers_[i].states);
+    }
+    else
+    {
+      initializeStates(fiberPointBuffers_[i].states);
+    }
+  }
+
+  cellmlAdapter.data().restoreParameterValues();
+
+  // copy the states and algebraics for transfer of all fibers to the new point buffers
+  for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+  {
+    const int nValues = fiberData_[fiberDataNo].valuesLength;
+    const double *receivedValues = nullptr;
+    if (fiberNoReceived[fiberDataNo] != -1)
+      receivedValues = receivedFiberData.at(fiberNoReceived[fiberDataNo]).data() + 6;
+
+    for (int valueNo = 0; valueNo < nValues; valueNo++)
+    {
+      global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
+      global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+      int entryNo = valueIndexAllFibers % Vc::double_v::size();
+
+      if (receivedValues)
+      {
+        for (int stateNo = 0; stateNo < nStates; stateNo++)
+        {
+          fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo] = receivedValues[stateNo*nValues + valueNo];
+        }
+        for (int algebraicNo = 0; algebraicNo < nAlgebraicsForTransfer; algebraicNo++)
+        {
+          fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo][algebraicNo][entryNo] = receivedValues[(nStates + algebraicNo)*nValues + valueNo];
+        }
+      }
+      else
+      {
+        global_no_t valueIndexAllFibersPrevious = fiberDataPrevious[fiberDataNoPrevious[fiberDataNo]].valuesOffset + valueNo;
+        global_no_t pointBuffersNoPrevious = valueIndexAllFibersPrevious / Vc::double_v::size();
+        int entryNoPrevious = valueIndexAllFibersPrevious % Vc::double_v::size();
+
+        for (int stateNo = 0; stateNo < nStates; stateNo++)
+        {
+          fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo] = fiberPointBuffersPrevious[pointBuffersNoPrevious].states[stateNo][entryNoPrevious];
+        }
+        for (int algebraicNo = 0; algebraicNo < nAlgebraicsForTransfer; algebraicNo++)
+        {
+          fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo][algebraicNo][entryNo]
+            = fiberPointBuffersAlgebraicsForTransferPrevious[pointBuffersNoPrevious][algebraicNo][entryNoPrevious];
+        }
+      }
+    }
+  }
+
+  // reset the per point buffer data, the point buffers now contain different points,
+  // all points are computed again in the next compute0D, this determines their equilibrium state anew
+  fiberPointBuffersStatesAreCloseToEquilibrium_.assign(nVcVectors, not_constant);
+  fiberPointBuffersAreAtEquilibrium_.assign(nVcVectors, false);
+  nFiberPointBufferStatesCloseToEquilibrium_ = 0;
+  fiberPointBuffersTimeStepWidth0D_.assign(nVcVectors, 0.0);
+  fiberPointBuffersNSteps0D_.assign(nVcVectors, 0);
+  fiberPointBuffersNRejectedSteps0D_.assign(nVcVectors, 0);
+  fiberPointBuffersComputeDuration0D_.assign(nVcVectors, 0.0);
+
+  // group the new fibers for the batched solution of the 1D problems
+  initializeFiberBatches1D();
+
+  LOG(DEBUG) << "redistributeFiberPointBuffers: " << fiberDataPrevious.size() << " -> " << nFibersToCompute_ << " fibers, "
+    << nInstancesToCompute_ << " instances, " << nVcVectors << " point buffers";
+}
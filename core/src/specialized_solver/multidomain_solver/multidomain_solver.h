@@ -6,6 +6,7 @@
 #include "data_management/specialized_solver/multidomain.h"
 #include "control/dihu_context.h"
 #include "partition/rank_subset.h"
+#include "specialized_solver/multidomain_solver/nested_mat_vec_utility.h"
 
 namespace TimeSteppingScheme
 {
@@ -72,9 +73,12 @@ protected:
   //! assemble the sub matrices of the system matrix, that is a block matrix containing stiffness matrices of the diffusion sub problems
   virtual void setSystemMatrixSubmatrices(double timeStepWidth);
 
-  //! create the nested and single system matrix from the initialized submatrices
+  //! assemble the single system matrix directly from the initialized submatrices, the sparsity pattern is kept when the matrix is rebuilt
   void createSystemMatrixFromSubmatrices();
 
+  //! get the diagonal of the inverse lumped mass matrix into inverseLumpedMassMatrixDiagonal_, the Vec is created on the first call
+  void updateInverseLumpedMassMatrixDiagonal();
+
   //! solve the linear system of equations of the implicit scheme with rightHandSide_ and solution_
   virtual void solveLinearSystem();
 
@@ -87,6 +91,9 @@ protected:
   //! set in the Petsc preconditioner object the information about matrix blocks for block jacobi and the node positions (PCSetCoordinates)
   virtual void setInformationToPreconditioner();
 
+  //! set the index sets of the compartment and extracellular fields and the split type for the fieldsplit preconditioner pc of linearSolver, also configure the sub solvers
+  void setFieldSplitInformationToPreconditioner(PC pc, std::shared_ptr<Solver::Linear> linearSolver);
+
   //! initialize all information for the linearSolver_ object, also set information to preconditioner
   virtual void initializeLinearSolver();
 
@@ -102,18 +109,16 @@ protected:
   std::shared_ptr<Partition::RankSubset> rankSubset_;         //< the rankSubset for all involved ranks
 
   int nCompartments_;                         //< the number of instances of the diffusion problem, or the number of motor units
-  Mat nestedSystemMatrix_;                    //< nested Petsc Mat, the system matrix which has more components than dofs, later this should be placed inside the data object
-  Vec nestedSolution_;                        //< nested Petsc Vec, solution vector
-  Vec nestedRightHandSide_;                   //< nested Petsc Vec, rhs
   Mat singleSystemMatrix_;                    //< non-nested Petsc Mat that contains all entries, the system matrix
   Mat singlePreconditionerMatrix_;            //< non-nested Petsc Mat that contains the preconditioner matrix
   Vec singleSolution_;                        //< non-nested Petsc Vec, solution vector
   Vec singleRightHandSide_;                   //< non-nested Petsc Vec, distributed rhs
 
-  std::vector<Vec> subvectorsRightHandSide_;  //< the sub vectors that are used in the nested vector nestedRightHandSide_
-  std::vector<Vec> subvectorsSolution_;       //< the sub vectors that are used in the nested vector nestedSolution_
-  std::vector<Mat> submatricesSystemMatrix_;  //< the sub matrices of the whole system matrix
-  std::vector<Mat> submatricesPreconditionerMatrix_;  //< the sub matrices of the matrix used as preconditioner
+  std::vector<Vec> subvectorsRightHandSide_;  //< the sub vectors of the rhs, their values are copied to singleRightHandSide_
+  std::vector<Vec> subvectorsSolution_;       //< the sub vectors of the solution, their values are copied to and from singleSolution_
+  std::vector<NestedMatVecUtility::MatrixBlock> submatricesSystemMatrix_;         //< the blocks of the whole system matrix, they reference the matrices of the finite element objects and are assembled directly into singleSystemMatrix_
+  std::vector<NestedMatVecUtility::MatrixBlock> submatricesPreconditionerMatrix_;  //< the blocks of the matrix used as preconditioner
+  Vec inverseLumpedMassMatrixDiagonal_;       //< the diagonal of the inverse lumped mass matrix, with which the rows of the stiffness matrix are scaled to get the blocks M^{-1}*K
   int nColumnSubmatricesSystemMatrix_;           //< number of rows of nested submatrices in the system matrix
 
   std::vector<double> am_, cm_;  //< the Am and Cm prefactors for the compartments, Am = surface-volume ratio, Cm = capacitance
@@ -130,6 +135,8 @@ protected:
   bool setDirichletBoundaryConditionPhiE_;    //< if the last dof of the extracellular space should have a 0 Dirichlet boundary condition
   bool resetToAverageZeroPhiB_;               //< if a constant should be added to the phi_b part of the solution vector after every solve, such that the average is zero
   bool resetToAverageZeroPhiE_;               //< if a constant should be added to the phi_e part of the solution vector after every solve, such that the average is zero
+  std::string fieldSplitType_;                //< the type of the fieldsplit preconditioner, one of "additive", "multiplicative", "symmetric_multiplicative" or "schur", only used if the preconditioner is "fieldsplit"
+  std::string schurFactorizationType_;        //< for fieldSplitType "schur", which part of the block factorization is used, one of "diag", "lower", "upper" or "full"
 };
 
 }  // namespace
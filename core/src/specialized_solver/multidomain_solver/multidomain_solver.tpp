@@ -61,6 +61,10 @@ MultidomainSolver(DihuContext context) :
   }
   useSymmetricPreconditionerMatrix_ = this->specificSettings_.getOptionBool("useSymmetricPreconditionerMatrix", true);
 
+  // parse options for the fieldsplit preconditioner
+  fieldSplitType_ = this->specificSettings_.getOptionString("fieldSplitType", "multiplicative");
+  schurFactorizationType_ = this->specificSettings_.getOptionString("schurFactorizationType", "full");
+
   // create finiteElement objects for diffusion in compartments
   finiteElementMethodDiffusionCompartment_.reserve(nCompartments_);
   for (int k = 0; k < nCompartments_; k++)
@@ -72,6 +76,7 @@ MultidomainSolver(DihuContext context) :
   singleSolution_ = PETSC_NULL;
   singleRightHandSide_ = PETSC_NULL;
   singlePreconditionerMatrix_ = PETSC_NULL;
+  inverseLumpedMassMatrixDiagonal_ = PETSC_NULL;
   lastNumberOfIterations_ = 0;
 }
 
@@ -355,13 +360,8 @@ initializeMatricesAndVectors()
   subvectorsSolution_[nCompartments_] = dataMultidomain_.extraCellularPotential()->valuesGlobal();
   ierr = VecZeroEntries(subvectorsSolution_[nCompartments_]); CHKERRV(ierr);
 
-  // create the nested vectors
-  LOG(DEBUG) << "create nested vector";
-  ierr = VecCreateNest(this->rankSubset_->mpiCommunicator(), nCompartments_+1, NULL, subvectorsRightHandSide_.data(), &nestedRightHandSide_); CHKERRV(ierr);
-  ierr = VecCreateNest(this->rankSubset_->mpiCommunicator(), nCompartments_+1, NULL, subvectorsSolution_.data(), &nestedSolution_); CHKERRV(ierr);
-
-  // copy the values from a nested Petsc Vec to a single Vec that contains all entries
-  NestedMatVecUtility::createVecFromNestedVec(nestedRightHandSide_, singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
+  // create the single Vec that contains all entries of the sub vectors and copy the values
+  NestedMatVecUtility::createVecFromSubvectors(subvectorsRightHandSide_, singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
@@ -395,6 +395,20 @@ initializeLinearSolver()
 
   // set block information in preconditioner for block jacobi and node positions for MG preconditioners
   setInformationToPreconditioner();
+
+  // the fieldsplit preconditioner of the alternative linear solver also needs the index sets of the fields
+  if (this->alternativeLinearSolver_)
+  {
+    PC pc;
+    ierr = KSPGetPC(*this->alternativeLinearSolver_->ksp(), &pc); CHKERRV(ierr);
+
+    PetscBool useFieldSplitPreconditioner;
+    PetscObjectTypeCompare((PetscObject)pc, PCFIELDSPLIT, &useFieldSplitPreconditioner);
+    if (useFieldSplitPreconditioner)
+    {
+      setFieldSplitInformationToPreconditioner(pc, this->alternativeLinearSolver_);
+    }
+  }
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
@@ -422,6 +436,15 @@ setInformationToPreconditioner()
     ierr = PCBJacobiSetTotalBlocks(pc, nColumnSubmatricesSystemMatrix_, lengthsOfBlocks.data()); CHKERRV(ierr);
   }
 
+  // set the fields for the fieldsplit preconditioner, the node positions are then set to the sub preconditioners
+  PetscBool useFieldSplitPreconditioner;
+  PetscObjectTypeCompare((PetscObject)pc, PCFIELDSPLIT, &useFieldSplitPreconditioner);
+  if (useFieldSplitPreconditioner)
+  {
+    setFieldSplitInformationToPreconditioner(pc, linearSolver_);
+    return;
+  }
+
   // set the local node positions for the preconditioner
   int nDofsPerNode = dataMultidomain_.functionSpace()->nDofsPerNode();
   int nNodesLocal = dataMultidomain_.functionSpace()->nNodesLocalWithoutGhosts();
@@ -443,6 +466,193 @@ setInformationToPreconditioner()
   ierr = PCSetCoordinates(pc, 3, nNodesLocal, nodePositionCoordinatesForPreconditioner.data()); CHKERRV(ierr);
 }
 
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+setFieldSplitInformationToPreconditioner(PC pc, std::shared_ptr<Solver::Linear> linearSolver)
+{
+  PetscErrorCode ierr;
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+
+  // The system matrix consists of nColumnSubmatricesSystemMatrix_ x nColumnSubmatricesSystemMatrix_ blocks,
+  // the first nCompartments_ block rows correspond to V_mk of the compartments, the remaining block rows to the potentials phi_e (and phi_b).
+  // In singleSystemMatrix_, the local rows of every block row are stored one after another (see NestedMatVecUtility::createMatFromBlocks),
+  // therefore, the local rows of every field are a contiguous range.
+
+  // get the local number of rows of every block row
+  std::vector<PetscInt> nRowsLocalBlock(nColumnSubmatricesSystemMatrix_, 0);
+  for (int rowNo = 0; rowNo < nColumnSubmatricesSystemMatrix_; rowNo++)
+  {
+    for (int columnNo = 0; columnNo < nColumnSubmatricesSystemMatrix_; columnNo++)
+    {
+      const NestedMatVecUtility::MatrixBlock &block = submatricesSystemMatrix_[rowNo*nColumnSubmatricesSystemMatrix_ + columnNo];
+      if (!block.terms.empty())
+      {
+        ierr = MatGetLocalSize(block.terms[0].matrix, &nRowsLocalBlock[rowNo], NULL); CHKERRV(ierr);
+        break;
+      }
+    }
+  }
+
+  PetscInt rowNoGlobalBegin = 0;
+  ierr = MatGetOwnershipRange(singleSystemMatrix_, &rowNoGlobalBegin, NULL); CHKERRV(ierr);
+
+  // define the fields, each as a range of block rows [blockNoBegin, blockNoEnd)
+  struct Field
+  {
+    std::string name;
+    int blockNoBegin;
+    int blockNoEnd;
+  };
+  std::vector<Field> fields;
+
+  PCCompositeType compositeType = PC_COMPOSITE_MULTIPLICATIVE;
+  if (fieldSplitType_ == "schur")
+  {
+    // two fields, all compartments and all potentials
+    compositeType = PC_COMPOSITE_SCHUR;
+    fields.push_back(Field{"vm", 0, nCompartments_});
+    fields.push_back(Field{"phi", nCompartments_, nColumnSubmatricesSystemMatrix_});
+  }
+  else
+  {
+    if (fieldSplitType_ == "additive")
+    {
+      compositeType = PC_COMPOSITE_ADDITIVE;
+    }
+    else if (fieldSplitType_ == "symmetric_multiplicative")
+    {
+      compositeType = PC_COMPOSITE_SYMMETRIC_MULTIPLICATIVE;
+    }
+    else if (fieldSplitType_ != "multiplicative")
+    {
+      LOG(ERROR) << this->specificSettings_ << "[\"fieldSplitType\"] is \"" << fieldSplitType_ << "\", but has to be one of "
+        << "\"additive\", \"multiplicative\", \"symmetric_multiplicative\" or \"schur\". Using \"multiplicative\".";
+    }
+
+    // one field for every compartment and one for every potential
+    for (int blockNo = 0; blockNo < nColumnSubmatricesSystemMatrix_; blockNo++)
+    {
+      std::stringstream name;
+      if (blockNo < nCompartments_)
+        name << "vm" << blockNo;
+      else if (blockNo == nCompartments_)
+        name << "phie";
+      else
+        name << "phib";
+      fields.push_back(Field{name.str(), blockNo, blockNo+1});
+    }
+  }
+
+  // create the index sets of the fields and set them in the preconditioner
+  PetscInt rowOffset = 0;
+  for (const Field &field : fields)
+  {
+    PetscInt nRowsLocalField = 0;
+    for (int blockNo = field.blockNoBegin; blockNo < field.blockNoEnd; blockNo++)
+      nRowsLocalField += nRowsLocalBlock[blockNo];
+
+    IS indexSet;
+    ierr = ISCreateStride(mpiCommunicator, nRowsLocalField, rowNoGlobalBegin + rowOffset, 1, &indexSet); CHKERRV(ierr);
+    ierr = PCFieldSplitSetIS(pc, field.name.c_str(), indexSet); CHKERRV(ierr);
+    ierr = ISDestroy(&indexSet); CHKERRV(ierr);
+
+    rowOffset += nRowsLocalField;
+  }
+
+  ierr = PCFieldSplitSetType(pc, compositeType); CHKERRV(ierr);
+
+  if (compositeType == PC_COMPOSITE_SCHUR)
+  {
+    PCFieldSplitSchurFactType schurFactorizationType = PC_FIELDSPLIT_SCHUR_FACT_FULL;
+    if (schurFactorizationType_ == "diag")
+    {
+      schurFactorizationType = PC_FIELDSPLIT_SCHUR_FACT_DIAG;
+    }
+    else if (schurFactorizationType_ == "lower")
+    {
+      schurFactorizationType = PC_FIELDSPLIT_SCHUR_FACT_LOWER;
+    }
+    else if (schurFactorizationType_ == "upper")
+    {
+      schurFactorizationType = PC_FIELDSPLIT_SCHUR_FACT_UPPER;
+    }
+    else if (schurFactorizationType_ != "full")
+    {
+      LOG(ERROR) << this->specificSettings_ << "[\"schurFactorizationType\"] is \"" << schurFactorizationType_ << "\", but has to be one of "
+        << "\"diag\", \"lower\", \"upper\" or \"full\". Using \"full\".";
+    }
+    ierr = PCFieldSplitSetSchurFactType(pc, schurFactorizationType); CHKERRV(ierr);
+
+    // the Schur complement is preconditioned by the approximation given by the bottom right block A11 of the preconditioner matrix,
+    // i.e. the stiffness matrix of the extracellular space, PETSc extracts it anyway for the field of the potentials
+    ierr = PCFieldSplitSetSchurPre(pc, PC_FIELDSPLIT_SCHUR_PRE_A11, NULL); CHKERRV(ierr);
+
+    // the coupling blocks are taken from the system matrix, because they are not contained in the symmetric preconditioner matrix
+    ierr = PCFieldSplitSetOffDiagUseAmat(pc, PETSC_TRUE); CHKERRV(ierr);
+  }
+
+  // set options from command line, this overrides the python config
+  ierr = PCSetFromOptions(pc); CHKERRV(ierr);
+
+  // create internal data structures of ksp and pc, such that the sub solvers exist
+  ierr = PCSetUp(pc); CHKERRV(ierr);
+
+  PetscInt nSubKsps = 0;
+  KSP *subKsps;
+  ierr = PCFieldSplitGetSubKSP(pc, &nSubKsps, &subKsps); CHKERRV(ierr);
+
+  LOG(INFO) << "using fieldsplit preconditioner of type \"" << fieldSplitType_ << "\" with " << fields.size() << " fields";
+
+  // parse solver type of the sub solvers, if none of them is given, the defaults of PETSc are used
+  bool setSubSolverTypes = this->specificSettings_.hasKey("subSolverType") || this->specificSettings_.hasKey("subPreconditionerType");
+  std::string subSolverType = this->specificSettings_.getOptionString("subSolverType", "preonly");
+  std::string subPreconditionerType = this->specificSettings_.getOptionString("subPreconditionerType", "none");
+
+  // get the local node positions for the sub preconditioners
+  int nNodesLocal = dataMultidomain_.functionSpace()->nNodesLocalWithoutGhosts();
+  std::vector<double> nodePositionCoordinatesForPreconditioner;
+  nodePositionCoordinatesForPreconditioner.reserve(3*nNodesLocal);
+
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nNodesLocal*dataMultidomain_.functionSpace()->nDofsPerNode(); dofNoLocal++)
+  {
+    Vec3 nodePosition = dataMultidomain_.functionSpace()->getGeometry(dofNoLocal);
+    for (int i = 0; i < 3; i++)
+      nodePositionCoordinatesForPreconditioner.push_back(nodePosition[i]);
+  }
+
+  for (int subKspNo = 0; subKspNo < nSubKsps; subKspNo++)
+  {
+    KSP subKsp = subKsps[subKspNo];
+
+    // set solver and preconditioner type, the same way as for the linear solver itself
+    if (setSubSolverTypes)
+    {
+      linearSolver->setSolverAndPreconditionerType(subKsp, subSolverType, subPreconditionerType);
+    }
+    else
+    {
+      // set options from command line
+      ierr = KSPSetFromOptions(subKsp); CHKERRV(ierr);
+    }
+
+    PC subPc;
+    ierr = KSPGetPC(subKsp, &subPc); CHKERRV(ierr);
+
+    // set the node positions if the field consists of a single block of the muscle mesh
+    Mat subMatrix;
+    PetscInt nRowsLocalSubMatrix = 0;
+    ierr = KSPGetOperators(subKsp, NULL, &subMatrix); CHKERRV(ierr);
+    ierr = MatGetLocalSize(subMatrix, &nRowsLocalSubMatrix, NULL); CHKERRV(ierr);
+
+    if (nRowsLocalSubMatrix == nNodesLocal)
+    {
+      ierr = PCSetCoordinates(subPc, 3, nNodesLocal, nodePositionCoordinatesForPreconditioner.data()); CHKERRV(ierr);
+    }
+  }
+
+  ierr = PetscFree(subKsps); CHKERRV(ierr);
+}
+
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
 void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
 initializeCompartmentRelativeFactors()
@@ -531,8 +741,9 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   // initialize the number of rows, this will already be set when the method is called for the inherited class MultidomainWithFatSolver
   if (nColumnSubmatricesSystemMatrix_ == 0)
     nColumnSubmatricesSystemMatrix_ = nCompartments_+1;
-    
-  this->submatricesSystemMatrix_.resize(MathUtility::sqr(nColumnSubmatricesSystemMatrix_),NULL);
+
+  // blocks without terms are empty (zero) blocks
+  this->submatricesSystemMatrix_.resize(MathUtility::sqr(nColumnSubmatricesSystemMatrix_));
 
   LOG(TRACE) << "setSystemMatrix";
 
@@ -547,59 +758,40 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   // where V_mk^(i) is the input and should be connected to the output of the reaction term.
   // V_mk^(i+1) is the output and should be connected to the input of the reaction term.
 
-  // fill submatricesSystemMatrix_, empty submatricesSystemMatrix_ may be NULL
-  // stiffnessMatrix and inverse lumped mass matrix without prefactor
+  // The blocks are not stored as separate matrices, they only reference the matrices of the finite element objects together with
+  // the prefactors. The values are computed when they are written into singleSystemMatrix_ by NestedMatVecUtility::createMatFromBlocks.
+  // The inverse lumped mass matrix is diagonal, therefore M^{-1}*K is given by scaling the rows of K with the diagonal of M^{-1}.
   Mat stiffnessMatrix = finiteElementMethodDiffusion_.data().stiffnessMatrix()->valuesGlobal();
-  Mat inverseLumpedMassMatrix = finiteElementMethodDiffusion_.data().inverseLumpedMassMatrix()->valuesGlobal();
+  updateInverseLumpedMassMatrixDiagonal();
 
-  PetscErrorCode ierr;
-  // set all submatricesSystemMatrix_
+  // set all blocks
   for (int k = 0; k < nCompartments_; k++)
   {
-
     // right column matrix
     double prefactor = -timeStepWidth / (am_[k]*cm_[k]);
 
     VLOG(2) << "k=" << k << ", am: " << am_[k] << ", cm: " << cm_[k] << ", prefactor: " << prefactor;
 
-    // create matrix as M^{-1}*K
-    Mat matrixOnRightColumn;
-    ierr = MatMatMult(inverseLumpedMassMatrix, stiffnessMatrix, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &matrixOnRightColumn); CHKERRV(ierr);
-
-    // scale matrix on right column with prefactor
-    ierr = MatScale(matrixOnRightColumn, prefactor); CHKERRV(ierr);
-
-    // copy right block matrix also to diagonal matrix
-    Mat matrixOnDiagonalBlock;
-    ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX, &matrixOnDiagonalBlock); CHKERRV(ierr);
+    // block on right column, prefactor*M^{-1}*K
+    NestedMatVecUtility::MatrixBlock &blockOnRightColumn = submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1];
+    blockOnRightColumn = NestedMatVecUtility::MatrixBlock();
+    blockOnRightColumn.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, prefactor, inverseLumpedMassMatrixDiagonal_});
 
     // for debugging zero all entries
 #ifdef MONODOMAIN
-/**/    ierr = MatZeroEntries(matrixOnRightColumn); CHKERRV(ierr);
+/**/    blockOnRightColumn.terms.clear();
 #endif
 
-    // set on right column of the system matrix
-    submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1] = matrixOnRightColumn;
-
-    if (VLOG_IS_ON(2))
-    {
-      VLOG(2) << "matrixOnRightColumn: " << PetscUtility::getStringMatrix(matrixOnRightColumn);
-      VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1;
-    }
+    VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1;
 
     // ---
-    // diagonal matrix
-    // add identity
-    ierr = MatShift(matrixOnDiagonalBlock, 1); CHKERRV(ierr);
+    // block on diagonal, prefactor*M^{-1}*K + I
+    NestedMatVecUtility::MatrixBlock &blockOnDiagonal = submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + k];
+    blockOnDiagonal = NestedMatVecUtility::MatrixBlock();
+    blockOnDiagonal.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, prefactor, inverseLumpedMassMatrixDiagonal_});
+    blockOnDiagonal.diagonalShift = 1.0;
 
-    // set on diagonal
-    submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + k] = matrixOnDiagonalBlock;
-
-    if (VLOG_IS_ON(2))
-    {
-      VLOG(2) << "matrixOnDiagonalBlock:" << PetscUtility::getStringMatrix(matrixOnDiagonalBlock);
-      VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + k;
-    }
+    VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + k;
 
     // ---
     // bottom row matrices
@@ -607,65 +799,21 @@ setSystemMatrixSubmatrices(double timeStepWidth)
     // stiffnessMatrixWithPrefactor is f_k*K
     Mat stiffnessMatrixWithPrefactor = finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
 
-    // create matrix as copy of stiffnessMatrix
-    Mat matrixOnBottomRow;
-    ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME, MAT_INITIAL_MATRIX, &matrixOnBottomRow); CHKERRV(ierr);
-    
-#if 0
-    // debugging test, gives slightly different results due to approximation of test
-    Mat test;
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &test); CHKERRV(ierr);
-
-    // get the relative factor of the compartment
-    Vec compartmentRelativeFactor = dataMultidomain_.compartmentRelativeFactor(k)->valuesGlobal();
-
-    int i = 0;double v = 0;
-    MatGetValues(test,1,&i,1,&i,&v);
-    LOG(DEBUG) << "compartmentRelativeFactor: " << PetscUtility::getStringVector(compartmentRelativeFactor);
-    LOG(DEBUG) << "test[0][0] = " << v;
-
-    // MatDiagonalScale(A,l,NULL) computes A = diag(l)*A, this scales the rows of A with the values in l (each row with one entry of l)
-    ierr = MatDiagonalScale(test, compartmentRelativeFactor, NULL); CHKERRV(ierr);
-
-    MatGetValues(test,1,&i,1,&i,&v);
-    LOG(DEBUG) << "MatdiagonalScale";
-    LOG(DEBUG) << "test[0][0] = " << v;
-
-    // test if "test" and matrixOnBottomRow yield the same matrices
-    PetscInt nRows, nColumns;
-    ierr = MatGetSize(matrixOnBottomRow,&nRows,&nColumns); CHKERRV(ierr);
-    double max_diff = 0;
-    for (int column = 0; column < nColumns; column++)
-    {
-      for (int row = 0; row < nRows; row++)
-      {
-        double value1, value2;
-        ierr = MatGetValues(matrixOnBottomRow,1,&row,1,&column,&value1); CHKERRV(ierr);
-        ierr = MatGetValues(test,1,&row,1,&column,&value2); CHKERRV(ierr);
-        double difference = fabs(value1-value2);
-        max_diff = std::max(max_diff, difference);
-        if (difference > 1e-5)
-        {
-          LOG(DEBUG) << "bottom matrix entry row=" << row << ", column=" << column << " is different: " << value1 << "," << value2 << ", diff: " << difference;
-
-        }
-      }
-    }
-    LOG(FATAL) << "max_diff:" << max_diff;
-#endif
     if (VLOG_IS_ON(2))
     {
-      VLOG(2) << "matrixOnBottomRow: " << PetscUtility::getStringMatrix(matrixOnBottomRow);
+      VLOG(2) << "matrixOnBottomRow: " << PetscUtility::getStringMatrix(stiffnessMatrixWithPrefactor);
     }
 
+    // set on bottom row of the system matrix
+    NestedMatVecUtility::MatrixBlock &blockOnBottomRow = submatricesSystemMatrix_[((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k];
+    blockOnBottomRow = NestedMatVecUtility::MatrixBlock();
+    blockOnBottomRow.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrixWithPrefactor, 1.0, PETSC_NULL});
+
     // for debugging zero all entries
 #ifdef MONODOMAIN
-/**/    ierr = MatZeroEntries(matrixOnBottomRow); CHKERRV(ierr);
+/**/    blockOnBottomRow.terms.clear();
 #endif
 
-    // set on bottom row of the system matrix
-    submatricesSystemMatrix_[((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k] = matrixOnBottomRow;
-
     VLOG(2) << "set at index " << ((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k;
   }
 
@@ -679,64 +827,81 @@ setSystemMatrixSubmatrices(double timeStepWidth)
 
   // for debugging set to identity
 #ifdef MONODOMAIN
+/**/  PetscErrorCode ierr;
 /**/  ierr = MatZeroEntries(stiffnessMatrixBottomRight); CHKERRV(ierr);
 /**/  ierr = MatShift(stiffnessMatrixBottomRight,1); CHKERRV(ierr);
 #endif
 
   // set on bottom right
-  submatricesSystemMatrix_[((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1)-1] = stiffnessMatrixBottomRight;
+  NestedMatVecUtility::MatrixBlock &blockBottomRight = submatricesSystemMatrix_[((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1)-1];
+  blockBottomRight = NestedMatVecUtility::MatrixBlock();
+  blockBottomRight.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrixBottomRight, 1.0, PETSC_NULL});
   VLOG(2) << "set at index " << ((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1)-1;
 
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
 void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
-createSystemMatrixFromSubmatrices()
+updateInverseLumpedMassMatrixDiagonal()
 {
+  Mat inverseLumpedMassMatrix = finiteElementMethodDiffusion_.data().inverseLumpedMassMatrix()->valuesGlobal();
+
   PetscErrorCode ierr;
+  if (inverseLumpedMassMatrixDiagonal_ == PETSC_NULL)
+  {
+    // create a Vec with the same parallel layout as the rows of the matrix
+    ierr = MatCreateVecs(inverseLumpedMassMatrix, NULL, &inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+  }
+
+  ierr = MatGetDiagonal(inverseLumpedMassMatrix, inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void MultidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+createSystemMatrixFromSubmatrices()
+{
   assert(submatricesSystemMatrix_.size() == nColumnSubmatricesSystemMatrix_*nColumnSubmatricesSystemMatrix_);
 
 #ifndef NDEBUG
-  LOG(DEBUG) << "nested matrix with " << nColumnSubmatricesSystemMatrix_ << "x" << nColumnSubmatricesSystemMatrix_ << " submatrices, nCompartments_=" << nCompartments_;
+  PetscErrorCode ierr;
+  LOG(DEBUG) << "system matrix with " << nColumnSubmatricesSystemMatrix_ << "x" << nColumnSubmatricesSystemMatrix_ << " submatrices, nCompartments_=" << nCompartments_;
 
   // output dimensions of submatrices for debugging
   for (int rowNo = 0; rowNo < nColumnSubmatricesSystemMatrix_; rowNo++)
   {
     for (int columnNo = 0; columnNo < nColumnSubmatricesSystemMatrix_; columnNo++)
     {
-      Mat subMatrix = submatricesSystemMatrix_[rowNo*nColumnSubmatricesSystemMatrix_ + columnNo];
+      const NestedMatVecUtility::MatrixBlock &block = submatricesSystemMatrix_[rowNo*nColumnSubmatricesSystemMatrix_ + columnNo];
       
-      if (!subMatrix)
+      if (block.terms.empty())
       {
-        LOG(DEBUG) << "submatrix (" << rowNo << "," << columnNo << ") is empty (NULL)";
+        LOG(DEBUG) << "submatrix (" << rowNo << "," << columnNo << ") is empty";
       }
       else
       {
         PetscInt nRows, nColumns;
-        ierr = MatGetSize(subMatrix, &nRows, &nColumns); CHKERRV(ierr);
+        ierr = MatGetSize(block.terms[0].matrix, &nRows, &nColumns); CHKERRV(ierr);
         std::string name;
         char *cName;
-        ierr = PetscObjectGetName((PetscObject)subMatrix, (const char **)&cName); CHKERRV(ierr);
+        ierr = PetscObjectGetName((PetscObject)block.terms[0].matrix, (const char **)&cName); CHKERRV(ierr);
         name = cName;
         
-        LOG(DEBUG) << "submatrix (" << rowNo << "," << columnNo << ") is \"" << name << "\" (" << nRows << "x" << nColumns << ")";
+        LOG(DEBUG) << "submatrix (" << rowNo << "," << columnNo << ") is computed from \"" << name << "\" (" << nRows << "x" << nColumns << "), "
+          << block.terms.size() << " term(s), diagonal shift " << block.diagonalShift;
       }
     }
   }
 #endif
 
-  // create nested matrix
-  ierr = MatCreateNest(this->rankSubset_->mpiCommunicator(),
-                       nColumnSubmatricesSystemMatrix_, NULL, nColumnSubmatricesSystemMatrix_, NULL, submatricesSystemMatrix_.data(), &nestedSystemMatrix_); CHKERRV(ierr);
-
-  // create a single Mat object from the nested Mat
-  NestedMatVecUtility::createMatFromNestedMat(nestedSystemMatrix_, singleSystemMatrix_, data().functionSpace()->meshPartition()->rankSubset());
+  // assemble the single Mat object directly from the blocks, if it already exists, its sparsity pattern is reused
+  NestedMatVecUtility::createMatFromBlocks(submatricesSystemMatrix_, nColumnSubmatricesSystemMatrix_, nColumnSubmatricesSystemMatrix_,
+                                           singleSystemMatrix_, data().functionSpace()->meshPartition()->rankSubset());
 
   if (useSymmetricPreconditionerMatrix_)
   {
     this->submatricesPreconditionerMatrix_ = submatricesSystemMatrix_;
 
-    // set offdiagonal matrices to NULL
+    // set offdiagonal blocks to empty blocks
     for (int rowNo = 0; rowNo < nColumnSubmatricesSystemMatrix_; rowNo++)
     {
       for (int columnNo = 0; columnNo < nColumnSubmatricesSystemMatrix_; columnNo++)
@@ -748,47 +913,42 @@ createSystemMatrixFromSubmatrices()
 
         if (!isOnDiagonal && !isSymmetricOffDiagonal)
         {
-          submatricesPreconditionerMatrix_[index] = NULL;
+          submatricesPreconditionerMatrix_[index] = NestedMatVecUtility::MatrixBlock();
         }
       }
     }
 #ifndef NDEBUG
-    LOG(DEBUG) << "preconditioner: nested matrix with " << nColumnSubmatricesSystemMatrix_ << "x" << nColumnSubmatricesSystemMatrix_ << " submatrices, nCompartments_=" << nCompartments_;
+    LOG(DEBUG) << "preconditioner: matrix with " << nColumnSubmatricesSystemMatrix_ << "x" << nColumnSubmatricesSystemMatrix_ << " submatrices, nCompartments_=" << nCompartments_;
 
     // output dimensions of submatrices for debugging
     for (int rowNo = 0; rowNo < nColumnSubmatricesSystemMatrix_; rowNo++)
     {
       for (int columnNo = 0; columnNo < nColumnSubmatricesSystemMatrix_; columnNo++)
       {
-        Mat subMatrix = submatricesPreconditionerMatrix_[rowNo*nColumnSubmatricesSystemMatrix_ + columnNo];
+        const NestedMatVecUtility::MatrixBlock &block = submatricesPreconditionerMatrix_[rowNo*nColumnSubmatricesSystemMatrix_ + columnNo];
 
-        if (!subMatrix)
+        if (block.terms.empty())
         {
-          LOG(DEBUG) << "preconditioner submatrix (" << rowNo << "," << columnNo << ") is empty (NULL)";
+          LOG(DEBUG) << "preconditioner submatrix (" << rowNo << "," << columnNo << ") is empty";
         }
         else
         {
           PetscInt nRows, nColumns;
-          ierr = MatGetSize(subMatrix, &nRows, &nColumns); CHKERRV(ierr);
+          ierr = MatGetSize(block.terms[0].matrix, &nRows, &nColumns); CHKERRV(ierr);
           std::string name;
           char *cName;
-          ierr = PetscObjectGetName((PetscObject)subMatrix, (const char **)&cName); CHKERRV(ierr);
+          ierr = PetscObjectGetName((PetscObject)block.terms[0].matrix, (const char **)&cName); CHKERRV(ierr);
           name = cName;
 
-          LOG(DEBUG) << "preconditioner submatrix (" << rowNo << "," << columnNo << ") is \"" << name << "\" (" << nRows << "x" << nColumns << ")";
+          LOG(DEBUG) << "preconditioner submatrix (" << rowNo << "," << columnNo << ") is computed from \"" << name << "\" (" << nRows << "x" << nColumns << ")";
         }
       }
     }
 #endif
 
-    Mat nestedPreconditionerMatrix;
-
-    // create nested matrix
-    ierr = MatCreateNest(this->rankSubset_->mpiCommunicator(),
-                        nColumnSubmatricesSystemMatrix_, NULL, nColumnSubmatricesSystemMatrix_, NULL, submatricesPreconditionerMatrix_.data(), &nestedPreconditionerMatrix); CHKERRV(ierr);
-
-    // create a single Mat object from the nested Mat
-    NestedMatVecUtility::createMatFromNestedMat(nestedPreconditionerMatrix, singlePreconditionerMatrix_, data().functionSpace()->meshPartition()->rankSubset());
+    // assemble the single Mat object directly from the blocks, if it already exists, its sparsity pattern is reused
+    NestedMatVecUtility::createMatFromBlocks(submatricesPreconditionerMatrix_, nColumnSubmatricesSystemMatrix_, nColumnSubmatricesSystemMatrix_,
+                                             singlePreconditionerMatrix_, data().functionSpace()->meshPartition()->rankSubset());
   }
   else 
   {
@@ -836,20 +996,19 @@ solveLinearSystem()
     ierr = KSPSetInitialGuessNonzero(*this->linearSolver_->ksp(), PETSC_TRUE); CHKERRV(ierr);
   }
 
-  // copy the values from a nested Petsc Vec to a single Vec that contains all entries
-  NestedMatVecUtility::createVecFromNestedVec(nestedRightHandSide_, singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
+  // copy the values from the sub vectors to a single Vec that contains all entries
+  NestedMatVecUtility::createVecFromSubvectors(subvectorsRightHandSide_, singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
 
   // solve the linear system
-  // this can be done using the nested Vecs and nested Mat (nestedSolution_, nestedRightHandSide_, nestedSystemMatrix_),
-  // or the single Vecs and Mats that contain all values directly  (singleSolution_, singleRightHandSide_, singleSystemMatrix_) 
+  // this is done using the single Vecs and Mats that contain all values directly  (singleSolution_, singleRightHandSide_, singleSystemMatrix_)
 
   bool hasSolverConverged = false;
 
   // try up to three times to solve the system
   for (int solveNo = 0; solveNo < 5; solveNo++)
   {
-    // copy the values from a nested Petsc Vec to a single Vec that contains all entries
-    NestedMatVecUtility::createVecFromNestedVec(nestedSolution_, singleSolution_, data().functionSpace()->meshPartition()->rankSubset());
+    // copy the values from the sub vectors to a single Vec that contains all entries
+    NestedMatVecUtility::createVecFromSubvectors(subvectorsSolution_, singleSolution_, data().functionSpace()->meshPartition()->rankSubset());
 
     if (showLinearSolverOutput_)
     {
@@ -873,8 +1032,8 @@ solveLinearSystem()
   // store the last number of iterations
   lastNumberOfIterations_ = this->linearSolver_->lastNumberOfIterations();
   
-  // copy the values back from a single Vec that contains all entries to a nested Petsc Vec
-  NestedMatVecUtility::fillNestedVec(singleSolution_, nestedSolution_);
+  // copy the values back from a single Vec that contains all entries to the sub vectors
+  NestedMatVecUtility::fillSubvectors(singleSolution_, subvectorsSolution_);
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
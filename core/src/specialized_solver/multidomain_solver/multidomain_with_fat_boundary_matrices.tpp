@@ -451,10 +451,10 @@ initializeBoundaryVariables()
   setEntriesBoundaryMatrices(originalMatrixB, originalMatrixC, matrixB, matrixC, matrixD, matrixE);
 
   // store the matrices in the system matrix
-  this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0] = matrixB;
-  this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1] = matrixC;
-  this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1] = matrixD;
-  this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0] = matrixE;
+  this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0].terms.assign(1, NestedMatVecUtility::MatrixBlockTerm{matrixB, 1.0, PETSC_NULL});
+  this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1].terms.assign(1, NestedMatVecUtility::MatrixBlockTerm{matrixC, 1.0, PETSC_NULL});
+  this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1].terms.assign(1, NestedMatVecUtility::MatrixBlockTerm{matrixD, 1.0, PETSC_NULL});
+  this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0].terms.assign(1, NestedMatVecUtility::MatrixBlockTerm{matrixE, 1.0, PETSC_NULL});
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusionMuscle,typename FiniteElementMethodDiffusionFat>
@@ -617,10 +617,10 @@ updateBoundaryMatrices()
   Mat originalMatrixC = this->finiteElementMethodFat_.data().stiffnessMatrix()->valuesGlobal();
 
   // store the matrices in the system matrix
-  Mat &matrixB = this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0];
-  Mat &matrixC = this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1];
-  Mat &matrixD = this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1];
-  Mat &matrixE = this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0];
+  Mat matrixB = this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0].terms[0].matrix;
+  Mat matrixC = this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1].terms[0].matrix;
+  Mat matrixD = this->submatricesSystemMatrix_[(this->nCompartments_+0)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+1].terms[0].matrix;
+  Mat matrixE = this->submatricesSystemMatrix_[(this->nCompartments_+1)*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_+0].terms[0].matrix;
 
   // compute entries
   setEntriesBoundaryMatrices(originalMatrixB, originalMatrixC, matrixB, matrixC, matrixD, matrixE);
@@ -79,7 +79,7 @@ protected:
   //! set the zero Dirichlet BCs for phi_e and phi_b in the rhs, if enabled by setDirichletBoundaryConditionPhiE_ and setDirichletBoundaryConditionPhiB_
   void setDirichletBoundaryConditionsInRightHandSide();
 
-  // ! copy the incoming data in the phiB field variable from the dataFat_ object to the nested Vec solution which only contains not-shared dofs
+  // ! copy the incoming data in the phiB field variable from the dataFat_ object to the sub vector of the solution which only contains not-shared dofs
   void copyPhiBToSolution();
 
   // ! copy the results from the linear solve in solution, which contains non-shared dofs, to the phi_b field variable in dataFat_, the missing values for the shared dofs are taken from phi_e
@@ -77,8 +77,7 @@ initialize()
   // also set the last zero entry of the rhs and the entry for phi_b^(i+1) in the solution vector
   initializeBoundaryVariables();
 
-  // from the initialize submatrices create the actual system matrix, this->nestedSystemMatrix_ 
-  // as nested Petsc Mat and also the single Mat, this->singleSystemMatrix_ 
+  // from the initialized submatrices assemble the actual system matrix, the single Mat this->singleSystemMatrix_
   this->createSystemMatrixFromSubmatrices();
   
   // zero rows and colums of the additional dirichlet BC's for phi_e and phi_b
@@ -125,14 +124,6 @@ initialize()
   ierr = VecZeroEntries(this->subvectorsSolution_[this->nCompartments_]); CHKERRV(ierr);
   // subvectorsSolution_[nCompartments_+1] has been set by initializeBoundaryVariables()
 
-  // create the nested Petsc Vec's
-  LOG(DEBUG) << "create nested vector";
-  ierr = VecCreateNest(this->rankSubset_->mpiCommunicator(), this->nCompartments_+2, NULL,
-                       this->subvectorsRightHandSide_.data(), &this->nestedRightHandSide_); CHKERRV(ierr);
-
-  ierr = VecCreateNest(this->rankSubset_->mpiCommunicator(), this->nCompartments_+2, NULL, 
-                       this->subvectorsSolution_.data(), &this->nestedSolution_); CHKERRV(ierr);
-
   // write initial meshes
   callOutputWriter(0, 0.0, 0);
 }
@@ -150,7 +141,7 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   // initialize number of submatrix rows in the system matrix
   this->nColumnSubmatricesSystemMatrix_ = this->nCompartments_+1+1;
 
-  this->submatricesSystemMatrix_.resize(MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_),NULL);
+  this->submatricesSystemMatrix_.resize(MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_));
 
   // system to be solved:
   //
@@ -162,7 +153,7 @@ setSystemMatrixSubmatrices(double timeStepWidth)
 
   LOG(TRACE) << "setSystemMatrix";
 
-  // fill this->submatricesSystemMatrix_, empty submatrices may be NULL
+  // fill this->submatricesSystemMatrix_, empty submatrices have no terms
   // stiffnessMatrix and inverse lumped mass matrix without prefactor
   Mat stiffnessMatrix = this->finiteElementMethodDiffusion_.data().stiffnessMatrix()->valuesGlobal();
   Mat massMatrix = this->finiteElementMethodDiffusion_.data().massMatrix()->valuesGlobal();
@@ -177,6 +168,13 @@ setSystemMatrixSubmatrices(double timeStepWidth)
     ierr = MatScale(minusDtMInv, -timeStepWidth); CHKERRV(ierr);
   }
 
+  // The blocks are not stored as separate matrices, they only reference the matrices of the finite element objects together with the prefactors,
+  // the values are computed when they are written into singleSystemMatrix_. M^{-1}*K is given by scaling the rows of K with the diagonal of M^{-1}.
+  if (useLumpedMassMatrix_)
+  {
+    this->updateInverseLumpedMassMatrixDiagonal();
+  }
+
   // set all submatrices
   for (int k = 0; k < this->nCompartments_; k++)
   {
@@ -185,60 +183,49 @@ setSystemMatrixSubmatrices(double timeStepWidth)
 
     VLOG(2) << "k=" << k << ", am: " << this->am_[k] << ", cm: " << this->cm_[k] << ", prefactor: " << prefactor;
 
-    // matrix B on right column
-    // create matrix as theta/(Am*Cm)*K
-    Mat matrixOnRightColumn;
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &matrixOnRightColumn); CHKERRV(ierr);
-
-    // scale matrix on right column with prefactor
-    ierr = MatScale(matrixOnRightColumn, prefactor); CHKERRV(ierr);
+    // matrix B on right column, theta/(Am*Cm)*K
+    NestedMatVecUtility::MatrixBlockTerm termOnRightColumn{stiffnessMatrix, prefactor, PETSC_NULL};
 
     if (useLumpedMassMatrix_)
     {
       // in this formulation the matrix B is B = -dt*theta/(Am*Cm)*M^-1*K
-      Mat result;
-      ierr = MatMatMult(minusDtMInv, matrixOnRightColumn, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &result); CHKERRV(ierr);
-      matrixOnRightColumn = result;
+      termOnRightColumn.scalingFactor = -timeStepWidth*prefactor;
+      termOnRightColumn.rowScaling = this->inverseLumpedMassMatrixDiagonal_;
     }
 
     // set on right column of the system matrix
-    this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_] = matrixOnRightColumn;
+    NestedMatVecUtility::MatrixBlock &blockOnRightColumn = this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_];
+    blockOnRightColumn = NestedMatVecUtility::MatrixBlock();
+    blockOnRightColumn.terms.push_back(termOnRightColumn);
 
     // ---
     // matrix on diagonal, A
-    // copy right block matrix also to diagonal matrix
-    Mat matrixOnDiagonalBlock;
-    ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX, &matrixOnDiagonalBlock); CHKERRV(ierr);
+    NestedMatVecUtility::MatrixBlock &blockOnDiagonal = this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + k];
+    blockOnDiagonal = NestedMatVecUtility::MatrixBlock();
+    blockOnDiagonal.terms.push_back(termOnRightColumn);
 
     if (useLumpedMassMatrix_)
     {
       // in this formulation the matrix A is A = -dt*theta/(Amk*Cmk)*M^-1*K + I, with B = -dt*theta/(Amk*Cmk)*M^-1*K this becomes A = B + I
       // add identity
-      ierr = MatShift(matrixOnDiagonalBlock, 1); CHKERRV(ierr);
+      blockOnDiagonal.diagonalShift = 1.0;
     }
     else 
     {
       // in this formulation the matrix A is A = theta/(Amk*Cmk)*K - 1/dt*M, with B = theta/(Am*Cm)*K this becomes A = B - 1/dt*M
-
-      // add scaled mass matrix, -1/dt*M,  AXPY: Y = a*X + Y  MatAXPY(Y,a,X,SAME_NONZERO_PATTERN)
-      prefactor = -1/timeStepWidth;
-      ierr = MatAXPY(matrixOnDiagonalBlock, prefactor, massMatrix, SAME_NONZERO_PATTERN); CHKERRV(ierr);
+      // add scaled mass matrix, -1/dt*M
+      blockOnDiagonal.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{massMatrix, -1/timeStepWidth, PETSC_NULL});
     }
 
-    // set on diagonal
-    this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + k] = matrixOnDiagonalBlock;
-
     // ---
     // bottom row matrices, B
     // stiffnessMatrixWithPrefactor is f_k*K
     Mat stiffnessMatrixWithPrefactor = this->finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
 
-    // create matrix as copy of stiffnessMatrix
-    Mat matrixOnBottomRow;
-    ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME, MAT_INITIAL_MATRIX, &matrixOnBottomRow); CHKERRV(ierr);
-
     // set on bottom row of the system matrix
-    this->submatricesSystemMatrix_[this->nCompartments_*this->nColumnSubmatricesSystemMatrix_ + k] = matrixOnBottomRow;
+    NestedMatVecUtility::MatrixBlock &blockOnBottomRow = this->submatricesSystemMatrix_[this->nCompartments_*this->nColumnSubmatricesSystemMatrix_ + k];
+    blockOnBottomRow = NestedMatVecUtility::MatrixBlock();
+    blockOnBottomRow.terms.push_back(NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrixWithPrefactor, 1.0, PETSC_NULL});
   }
 
   // ---
@@ -247,7 +234,6 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   b2_.resize(this->nCompartments_);
 
   // initialize the matrices b1, b2 to compute the rhs
-  // set all this->submatricesSystemMatrix_
   for (int k = 0; k < this->nCompartments_; k++)
   {
     // set b1_ = (θ-1)*1/(Am^k*Cm^k)*K_sigmai^k
@@ -339,7 +325,7 @@ setInformationToPreconditioner()
     }
 
     // set entries for block of fat meh
-    Mat matrixC = this->submatricesSystemMatrix_[MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_)-1];
+    Mat matrixC = this->submatricesSystemMatrix_[MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_)-1].terms[0].matrix;
     const PetscInt *matrixCOwnershipRanges;
     ierr = MatGetOwnershipRanges(matrixC, &matrixCOwnershipRanges); CHKERRV(ierr);
 
@@ -380,7 +366,7 @@ setInformationToPreconditioner()
     
     // set last block size
     PetscInt nRowsGlobalLastSubMatrix;
-    ierr = MatGetSize(this->submatricesSystemMatrix_[MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_)-1], &nRowsGlobalLastSubMatrix, NULL); CHKERRV(ierr);
+    ierr = MatGetSize(this->submatricesSystemMatrix_[MathUtility::sqr(this->nColumnSubmatricesSystemMatrix_)-1].terms[0].matrix, &nRowsGlobalLastSubMatrix, NULL); CHKERRV(ierr);
     lengthsOfBlocks[nBlocks-1] = nRowsGlobalLastSubMatrix;
 
     // assert that size matches global matrix size
@@ -403,6 +389,14 @@ setInformationToPreconditioner()
     ierr = PCBJacobiSetTotalBlocks(pc, this->nColumnSubmatricesSystemMatrix_, lengthsOfBlocks.data()); CHKERRV(ierr);
 #endif
   }
+
+  // set the fields for the fieldsplit preconditioner, the node positions are then set to the sub preconditioners
+  PetscBool useFieldSplitPreconditioner;
+  PetscObjectTypeCompare((PetscObject)pc, PCFIELDSPLIT, &useFieldSplitPreconditioner);
+  if (useFieldSplitPreconditioner)
+  {
+    this->setFieldSplitInformationToPreconditioner(pc, this->linearSolver_);
+  }
   
   // set node positions
 
@@ -441,7 +435,10 @@ setInformationToPreconditioner()
 
   LOG(DEBUG) << "set coordinates to preconditioner, " << nNodesLocalBlock << " node coordinates";
 
-  ierr = PCSetCoordinates(pc, 3, nNodesLocalBlock, nodePositionCoordinatesForPreconditioner.data()); CHKERRV(ierr);
+  if (!useFieldSplitPreconditioner)
+  {
+    ierr = PCSetCoordinates(pc, 3, nNodesLocalBlock, nodePositionCoordinatesForPreconditioner.data()); CHKERRV(ierr);
+  }
 
   // initialize preconditioner of alternative linear solver
   if (this->alternativeLinearSolver_)
@@ -564,11 +561,11 @@ updateSystemMatrix()
 
   for (int i = 0; i < this->submatricesSystemMatrix_.size(); i++)
   {
-    if (this->submatricesSystemMatrix_[i])
+    for (int termNo = 0; termNo < this->submatricesSystemMatrix_[i].terms.size(); termNo++)
     {
       std::stringstream name;
-      name << s.str() << "_submatrix_" << i;
-      PetscUtility::dumpMatrix(name.str(), "matlab", this->submatricesSystemMatrix_[i], MPI_COMM_WORLD);
+      name << s.str() << "_submatrix_" << i << "_term_" << termNo;
+      PetscUtility::dumpMatrix(name.str(), "matlab", this->submatricesSystemMatrix_[i].terms[termNo].matrix, MPI_COMM_WORLD);
     }
   }
 
@@ -765,15 +762,14 @@ solveLinearSystem()
     ierr = MatMultAdd(b2_[k], phie_k, temporary_, this->subvectorsRightHandSide_[k]); CHKERRV(ierr);   // v3 = v2 + A * v1, MatMultAdd(Mat mat,Vec v1,Vec v2,Vec v3)
   }
 
-  // copy the values from the nested Petsc Vec nestedRightHandSide_ to the single Vec, singleRightHandSide_, that contains all entries
-  NestedMatVecUtility::createVecFromNestedVec(this->nestedRightHandSide_, this->singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
+  // copy the values from the sub vectors subvectorsRightHandSide_ to the single Vec, singleRightHandSide_, that contains all entries
+  NestedMatVecUtility::createVecFromSubvectors(this->subvectorsRightHandSide_, this->singleRightHandSide_, data().functionSpace()->meshPartition()->rankSubset());
 
   // set the rhs to 0 in phi_e and phi_b, if enabled
   setDirichletBoundaryConditionsInRightHandSide();
 
   if (VLOG_IS_ON(1))
   {
-    VLOG(1) << "this->nestedRightHandSide_: " << PetscUtility::getStringVector(this->nestedRightHandSide_);
     VLOG(1) << "this->singleRightHandSide_: " << PetscUtility::getStringVector(this->singleRightHandSide_);
   }
   
@@ -784,13 +780,13 @@ solveLinearSystem()
   {
     if (solveNo == 0 || solveNo == 1)
     {
-      // copy the values from the nested Petsc Vec,nestedSolution_, to the single Vec, singleSolution_, that contains all entries
-      NestedMatVecUtility::createVecFromNestedVec(this->nestedSolution_, this->singleSolution_, data().functionSpace()->meshPartition()->rankSubset());
+      // copy the values from the sub vectors subvectorsSolution_ to the single Vec, singleSolution_, that contains all entries
+      NestedMatVecUtility::createVecFromSubvectors(this->subvectorsSolution_, this->singleSolution_, data().functionSpace()->meshPartition()->rankSubset());
     }
 
     // Solve the linear system
     // using single Vecs and Mats that contain all values directly  (singleSolution_, singleRightHandSide_, singleSystemMatrix_)
-    // This is better compared to using the nested Vec's, because more solvers are available for normal Vec's.
+    // This is better compared to using nested Vec's, because more solvers are available for normal Vec's.
     if (this->showLinearSolverOutput_)
     {
       // solve and show information on convergence
@@ -823,14 +819,13 @@ solveLinearSystem()
   // store the last number of iterations
   this->lastNumberOfIterations_ = this->linearSolver_->lastNumberOfIterations();
 
-  // copy the values back from the single Vec, singleSolution_, that contains all entries 
-  // to the nested Petsc Vec, nestedSolution_ which contains the components in subvectorsSolution_
-  NestedMatVecUtility::fillNestedVec(this->singleSolution_, this->nestedSolution_);
+  // copy the values back from the single Vec, singleSolution_, that contains all entries to the sub vectors subvectorsSolution_
+  NestedMatVecUtility::fillSubvectors(this->singleSolution_, this->subvectorsSolution_);
 
   // add a constant to phi_e and phi_b such that the average is zero, if enabled
   resetToAverageZero();
 
-  // the vector for phi_b in nestedSolution_ contains only entries for non-boundary dofs, 
+  // the vector for phi_b in subvectorsSolution_ contains only entries for non-boundary dofs, 
   // copy all values and the boundary dof values to the proper phi_b which is dataFat_.extraCellularPotentialFat()->valuesGlobal()
   copySolutionToPhiB();
 
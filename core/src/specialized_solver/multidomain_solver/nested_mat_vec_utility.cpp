@@ -25,7 +25,6 @@ void createVecFromNestedVec(Vec nestedVec, Vec &singleVec, std::shared_ptr<Parti
   return;
 #endif
 
-  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
   PetscErrorCode ierr;
 
   // get the nested Vecs
@@ -33,84 +32,8 @@ void createVecFromNestedVec(Vec nestedVec, Vec &singleVec, std::shared_ptr<Parti
   Vec *nestedVecs;
   ierr = VecNestGetSubVecs(nestedVec, &nNestedVecs, &nestedVecs); CHKERRV(ierr);
 
-  // if Vec object does not yet exist, create new one
-  if (singleVec == PETSC_NULL)
-  {
-
-    // get the total sizes of all nested vecs
-    int nEntriesGlobal = 0;
-    int nEntriesLocal = 0;
-    for (int nestedVecNo = 0; nestedVecNo < nNestedVecs; nestedVecNo++)
-    {
-      // sum up global size
-      PetscInt nEntriesGlobalNestedVec = 0;
-      ierr = VecGetSize(nestedVecs[nestedVecNo], &nEntriesGlobalNestedVec); CHKERRV(ierr);
-      nEntriesGlobal += nEntriesGlobalNestedVec;
-      
-      // sum up local size
-      PetscInt nEntriesLocalNestedVec = 0;
-      ierr = VecGetLocalSize(nestedVecs[nestedVecNo], &nEntriesLocalNestedVec); CHKERRV(ierr);
-      nEntriesLocal += nEntriesLocalNestedVec;
-    }
-
-    // get name of first subvec
-    std::string name;
-    char *cName;
-    ierr = PetscObjectGetName((PetscObject)nestedVecs[0], (const char **)&cName); CHKERRV(ierr);
-    name = cName;
-
-    name += std::string("_singleVec");
-
-    LOG(DEBUG) << "create single Vec \"" << name << "\" from " << nNestedVecs << " nested vecs, n entries global: " << nEntriesGlobal << ", local: " << nEntriesLocal;
-
-    // create new Vec and assign name
-    ierr = VecCreate(mpiCommunicator, &singleVec); CHKERRV(ierr);
-    ierr = PetscObjectSetName((PetscObject) singleVec, name.c_str()); CHKERRV(ierr);
-
-    // initialize size of vector
-    ierr = VecSetSizes(singleVec, nEntriesLocal, nEntriesGlobal); CHKERRV(ierr);
-
-    // set sparsity type and other options
-    ierr = VecSetFromOptions(singleVec); CHKERRV(ierr);
-
-  }
-
-  // transfer the values from nestedVec to singleVec
-  std::vector<int> indices;
-  std::vector<double> values;
-
-  // get global offset of the local portion in the single vec
-  PetscInt singleVecGlobalBegin = 0;
-  ierr = VecGetOwnershipRange(singleVec, &singleVecGlobalBegin, NULL); CHKERRV(ierr);
-
-  // loop over subvecs
-  for (int nestedVecNo = 0; nestedVecNo < nNestedVecs; nestedVecNo++)
-  {
-    Vec currentVec = nestedVecs[nestedVecNo];
-
-    // get local range in the nested vec
-    PetscInt valueNoGlobalBegin = 0;
-    PetscInt valueNoGlobalEnd = 0;
-    ierr = VecGetOwnershipRange(currentVec, &valueNoGlobalBegin, &valueNoGlobalEnd); CHKERRV(ierr);
-    PetscInt nEntriesLocal = valueNoGlobalEnd - valueNoGlobalBegin;
-
-    // get local values of the nested vec
-    indices.resize(nEntriesLocal);
-    std::iota(indices.begin(), indices.end(), valueNoGlobalBegin);
-
-    values.resize(nEntriesLocal);
-    ierr = VecGetValues(currentVec, indices.size(), indices.data(), values.data()); CHKERRV(ierr);
-    
-    // set values in the singleVec
-    std::iota(indices.begin(), indices.end(), singleVecGlobalBegin);
-    ierr = VecSetValues(singleVec, indices.size(), indices.data(), values.data(), INSERT_VALUES);
-
-    singleVecGlobalBegin += nEntriesLocal;
-  }
-
-  // parallel assembly of single vec
-  VecAssemblyBegin(singleVec);
-  VecAssemblyEnd(singleVec);
+  std::vector<Vec> subvectors(nestedVecs, nestedVecs + nNestedVecs);
+  createVecFromSubvectors(subvectors, singleVec, rankSubset);
 
   // dump vector singleVec to file
   if (VLOG_IS_ON(1))
@@ -124,7 +47,7 @@ void createVecFromNestedVec(Vec nestedVec, Vec &singleVec, std::shared_ptr<Parti
     name = cName;
 
     filename << "out/" << name << "_createVecFromNestedVec";
-    PetscUtility::dumpVector(filename.str(), std::string("matlab"), singleVec, mpiCommunicator);
+    PetscUtility::dumpVector(filename.str(), std::string("matlab"), singleVec, rankSubset->mpiCommunicator());
   }
 }
 
@@ -143,61 +66,126 @@ void fillNestedVec(Vec singleVec, Vec nestedVec)
   Vec *nestedVecs;
   ierr = VecNestGetSubVecs(nestedVec, &nNestedVecs, &nestedVecs); CHKERRV(ierr);
 
-  // get all local values
-
-  // get global offset of the local portion in the single vec
-  PetscInt singleVecGlobalBegin = 0;
-  PetscInt singleVecGlobalEnd = 0;
-  ierr = VecGetOwnershipRange(singleVec, &singleVecGlobalBegin, &singleVecGlobalEnd); CHKERRV(ierr);
+  std::vector<Vec> subvectors(nestedVecs, nestedVecs + nNestedVecs);
+  fillSubvectors(singleVec, subvectors);
 
-  PetscInt nEntriesLocal = singleVecGlobalEnd - singleVecGlobalBegin;
+  // dump vector nestedVec to file
+  if (VLOG_IS_ON(1))
+  {
+    // determine file name
+    std::stringstream filename;
+    // get name of first subvec
+    std::string name;
+    char *cName;
+    ierr = PetscObjectGetName((PetscObject)nestedVecs[0], (const char **)&cName); CHKERRV(ierr);
+    name = cName;
 
-  std::vector<int> indices(nEntriesLocal);
-  std::vector<double> values(nEntriesLocal);
-  std::iota(indices.begin(), indices.end(), singleVecGlobalBegin);
+    filename << "out/" << name << "_fillNestedVec";
+    PetscUtility::dumpVector(filename.str(), std::string("matlab"), nestedVec, MPI_COMM_WORLD);
+  }
+}
 
-  ierr = VecGetValues(singleVec, indices.size(), indices.data(), values.data()); CHKERRV(ierr);
+//! from a list of Petsc Vecs (subvectors) create a new Petsc Vec (singleVec) that contains all values at once, without the need for a nested Vec.
+void createVecFromSubvectors(const std::vector<Vec> &subvectors, Vec &singleVec, std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+  PetscErrorCode ierr;
 
-  PetscInt valuesOffset = 0;
+  assert(!subvectors.empty());
 
-  // loop over subvecs
-  for (int nestedVecNo = 0; nestedVecNo < nNestedVecs; nestedVecNo++)
+  // if Vec object does not yet exist, create new one
+  if (singleVec == PETSC_NULL)
   {
-    Vec currentVec = nestedVecs[nestedVecNo];
+    // get the total sizes of all subvectors
+    PetscInt nEntriesGlobal = 0;
+    PetscInt nEntriesLocal = 0;
+    for (Vec subvector : subvectors)
+    {
+      // sum up global size
+      PetscInt nEntriesGlobalSubvector = 0;
+      ierr = VecGetSize(subvector, &nEntriesGlobalSubvector); CHKERRV(ierr);
+      nEntriesGlobal += nEntriesGlobalSubvector;
+
+      // sum up local size
+      PetscInt nEntriesLocalSubvector = 0;
+      ierr = VecGetLocalSize(subvector, &nEntriesLocalSubvector); CHKERRV(ierr);
+      nEntriesLocal += nEntriesLocalSubvector;
+    }
 
-    // get local range in the nested vec
-    PetscInt valueNoGlobalBegin = 0;
-    PetscInt valueNoGlobalEnd = 0;
-    ierr = VecGetOwnershipRange(currentVec, &valueNoGlobalBegin, &valueNoGlobalEnd); CHKERRV(ierr);
-    PetscInt nEntriesLocal = valueNoGlobalEnd - valueNoGlobalBegin;
+    // get name of first subvec
+    std::string name;
+    char *cName;
+    ierr = PetscObjectGetName((PetscObject)subvectors[0], (const char **)&cName); CHKERRV(ierr);
+    name = cName;
+
+    name += std::string("_singleVec");
+
+    LOG(DEBUG) << "create single Vec \"" << name << "\" from " << subvectors.size() << " sub vecs, n entries global: " << nEntriesGlobal << ", local: " << nEntriesLocal;
+
+    // create new Vec and assign name
+    ierr = VecCreate(mpiCommunicator, &singleVec); CHKERRV(ierr);
+    ierr = PetscObjectSetName((PetscObject) singleVec, name.c_str()); CHKERRV(ierr);
 
-    // set local values of the nested vec
-    indices.resize(nEntriesLocal);
-    std::iota(indices.begin(), indices.end(), valueNoGlobalBegin);
+    // initialize size of vector
+    ierr = VecSetSizes(singleVec, nEntriesLocal, nEntriesGlobal); CHKERRV(ierr);
 
-    ierr = VecSetValues(currentVec, indices.size(), indices.data(), values.data() + valuesOffset, INSERT_VALUES); CHKERRV(ierr);
+    // set sparsity type and other options
+    ierr = VecSetFromOptions(singleVec); CHKERRV(ierr);
+  }
 
-    // parallel assembly of current vec
-    VecAssemblyBegin(currentVec);
-    VecAssemblyEnd(currentVec);
+  // transfer the values from the subvectors to singleVec,
+  // the local portion of singleVec consists of the local portions of all subvectors one after another,
+  // therefore the local arrays can be copied directly without communication
+  double *singleVecValues;
+  ierr = VecGetArray(singleVec, &singleVecValues); CHKERRV(ierr);
+
+  PetscInt valuesOffset = 0;
+  for (Vec subvector : subvectors)
+  {
+    PetscInt nEntriesLocal = 0;
+    ierr = VecGetLocalSize(subvector, &nEntriesLocal); CHKERRV(ierr);
+
+    const double *subvectorValues;
+    ierr = VecGetArrayRead(subvector, &subvectorValues); CHKERRV(ierr);
+    std::copy(subvectorValues, subvectorValues + nEntriesLocal, singleVecValues + valuesOffset);
+    ierr = VecRestoreArrayRead(subvector, &subvectorValues); CHKERRV(ierr);
 
     valuesOffset += nEntriesLocal;
   }
 
-  // dump vector nestedVec to file
-  if (VLOG_IS_ON(1))
+#ifndef NDEBUG
+  PetscInt nEntriesLocalSingleVec = 0;
+  ierr = VecGetLocalSize(singleVec, &nEntriesLocalSingleVec); CHKERRV(ierr);
+  assert(valuesOffset == nEntriesLocalSingleVec);
+#endif
+
+  ierr = VecRestoreArray(singleVec, &singleVecValues); CHKERRV(ierr);
+}
+
+//! copy the local values from a singleVec back to the subvectors
+void fillSubvectors(Vec singleVec, const std::vector<Vec> &subvectors)
+{
+  PetscErrorCode ierr;
+
+  // the local portion of singleVec consists of the local portions of all subvectors one after another
+  const double *singleVecValues;
+  ierr = VecGetArrayRead(singleVec, &singleVecValues); CHKERRV(ierr);
+
+  PetscInt valuesOffset = 0;
+  for (Vec subvector : subvectors)
   {
-    // determine file name
-    std::stringstream filename;
-    // get name of first subvec
-    std::string name;
-    char *cName;
-    ierr = PetscObjectGetName((PetscObject)nestedVecs[0], (const char **)&cName); CHKERRV(ierr);
-    name = cName;
+    PetscInt nEntriesLocal = 0;
+    ierr = VecGetLocalSize(subvector, &nEntriesLocal); CHKERRV(ierr);
 
-    filename << "out/" << name << "_fillNestedVec";
-    PetscUtility::dumpVector(filename.str(), std::string("matlab"), nestedVec, MPI_COMM_WORLD);
+    double *subvectorValues;
+    ierr = VecGetArray(subvector, &subvectorValues); CHKERRV(ierr);
+    std::copy(singleVecValues + valuesOffset, singleVecValues + valuesOffset + nEntriesLocal, subvectorValues);
+    ierr = VecRestoreArray(subvector, &subvectorValues); CHKERRV(ierr);
+
+    valuesOffset += nEntriesLocal;
   }
+
+  ierr = VecRestoreArrayRead(singleVec, &singleVecValues); CHKERRV(ierr);
 }
 
 //! from a Petsc Mat with nested type (nestedMat) create a new Petsc Mat (singleMat) that contains all values at once. If the singleMat already exists, do not create again, only copy the values.
@@ -207,338 +195,362 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat, std::shared_ptr<Parti
   singleMat = nestedMat;
   return;
 #endif
-  
-  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
-  int nRanks = rankSubset->size();
-  int ownRankNo = rankSubset->ownRankNo();
-  
-  // collect sizes of nested Mats
-  int nNestedMatRows;
-  int nNestedMatColumns;
+
   PetscErrorCode ierr;
 
   // get the nested Mats as two-dimensional array, nestedMats[rowNo][columnNo]
+  int nNestedMatRows;
+  int nNestedMatColumns;
   Mat **nestedMats;
   ierr = MatNestGetSubMats(nestedMat, &nNestedMatRows, &nNestedMatColumns, &nestedMats); CHKERRV(ierr);
 
-  // get the sizes of all nested Mats and the global number of rows and columns
-  std::vector<PetscInt> nRowsGlobalNestedMats(nNestedMatRows);
-  std::vector<PetscInt> nRowsLocalNestedMats(nNestedMatRows);
-  std::vector<PetscInt> nColumnsGlobalNestedMats(nNestedMatColumns);
-  std::vector<PetscInt> nColumnsLocalNestedMats(nNestedMatColumns);
-
-  int nRowsGlobal = 0;
-  int nRowsLocal = 0;
-  int nColumnsGlobal = 0;
-  int nColumnsLocal = 0;
-
-  // loop over rows of nested mat
+  // store sub matrices in row-major order
+  std::vector<Mat> submatrices(nNestedMatRows*nNestedMatColumns);
   for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows; nestedMatRowNo++)
   {
     for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns; nestedMatColumnNo++)
     {
-      Mat currentMat = nestedMats[nestedMatRowNo][nestedMatColumnNo];
+      submatrices[nestedMatRowNo*nNestedMatColumns + nestedMatColumnNo] = nestedMats[nestedMatRowNo][nestedMatColumnNo];
+    }
+  }
+
+  createMatFromSubmatrices(submatrices, nNestedMatRows, nNestedMatColumns, singleMat, rankSubset);
+}
+
+//! from the sub matrices of a block matrix assemble a Petsc Mat (singleMat) that contains all values at once, without the need for a nested Mat
+void createMatFromSubmatrices(const std::vector<Mat> &submatrices, int nSubmatrixRows, int nSubmatrixColumns,
+                              Mat &singleMat, std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  // every block consists of the sub matrix itself
+  std::vector<MatrixBlock> blocks(submatrices.size());
+  for (int blockNo = 0; blockNo < submatrices.size(); blockNo++)
+  {
+    if (submatrices[blockNo] != PETSC_NULL)
+      blocks[blockNo].terms.push_back(MatrixBlockTerm{submatrices[blockNo], 1.0, PETSC_NULL});
+  }
+
+  createMatFromBlocks(blocks, nSubmatrixRows, nSubmatrixColumns, singleMat, rankSubset);
+}
+
+//! from the blocks of a block matrix assemble a Petsc Mat (singleMat) that contains all values at once, without a separate Mat per block
+void createMatFromBlocks(const std::vector<MatrixBlock> &blocks, int nBlockRows, int nBlockColumns,
+                         Mat &singleMat, std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+  int nRanks = rankSubset->size();
+  int ownRankNo = rankSubset->ownRankNo();
+  PetscErrorCode ierr;
+
+  assert(blocks.size() == nBlockRows*nBlockColumns);
+
+  // The layout of singleMat is as follows: The local rows of a rank consist of the local rows of all block rows, one after another.
+  // Likewise, the column block of a rank consists of the column blocks of this rank of all block columns, one after another.
+  // Consequently, every rank only sets values in its own rows and no communication is needed for the assembly.
+  // The sizes of the blocks are given by the matrices of their terms, all terms of a block have the same parallel layout.
+
+  // get the local row ranges of the block rows
+  std::vector<PetscInt> rowNoGlobalBeginBlockRow(nBlockRows, 0);
+  std::vector<PetscInt> nRowsLocalBlockRow(nBlockRows, 0);
+  PetscInt nRowsGlobal = 0;
+  PetscInt nRowsLocal = 0;
+
+  for (int blockRowNo = 0; blockRowNo < nBlockRows; blockRowNo++)
+  {
+    bool blockFound = false;
+    for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
+    {
+      const MatrixBlock &block = blocks[blockRowNo*nBlockColumns + blockColumnNo];
 
-      if (currentMat != PETSC_NULL)
+      if (!block.terms.empty())
       {
-        PetscInt nColumns = 0;
-        ierr = MatGetSize(currentMat, &nRowsGlobalNestedMats[nestedMatRowNo], &nColumns); CHKERRV(ierr);
-        ierr = MatGetLocalSize(currentMat, &nRowsLocalNestedMats[nestedMatRowNo], &nColumns); CHKERRV(ierr);
-        
-        nRowsGlobal += nRowsGlobalNestedMats[nestedMatRowNo];
-        nRowsLocal += nRowsLocalNestedMats[nestedMatRowNo];
+        PetscInt nRowsGlobalBlock = 0;
+        PetscInt rowNoGlobalEnd = 0;
+        ierr = MatGetSize(block.terms[0].matrix, &nRowsGlobalBlock, NULL); CHKERRV(ierr);
+        ierr = MatGetOwnershipRange(block.terms[0].matrix, &rowNoGlobalBeginBlockRow[blockRowNo], &rowNoGlobalEnd); CHKERRV(ierr);
+        nRowsLocalBlockRow[blockRowNo] = rowNoGlobalEnd - rowNoGlobalBeginBlockRow[blockRowNo];
 
+        nRowsGlobal += nRowsGlobalBlock;
+        nRowsLocal += nRowsLocalBlockRow[blockRowNo];
+        blockFound = true;
         break;
       }
     }
+    if (!blockFound)
+      LOG(FATAL) << "createMatFromBlocks: row " << blockRowNo << " of the blocks contains no matrix, the number of rows can not be determined.";
   }
 
-  // loop over columns of nested mat
-  for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns; nestedMatColumnNo++)
+  // get the column ranges of all ranks of the block columns
+  std::vector<const PetscInt *> columnRangesBlockColumn(nBlockColumns, NULL);
+  PetscInt nColumnsGlobal = 0;
+
+  for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
   {
-    for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows; nestedMatRowNo++)
+    for (int blockRowNo = 0; blockRowNo < nBlockRows; blockRowNo++)
     {
-      Mat currentMat = nestedMats[nestedMatRowNo][nestedMatColumnNo];
+      const MatrixBlock &block = blocks[blockRowNo*nBlockColumns + blockColumnNo];
 
-      if (currentMat != PETSC_NULL)
+      if (!block.terms.empty())
       {
+        PetscInt nColumnsGlobalBlock = 0;
+        ierr = MatGetSize(block.terms[0].matrix, NULL, &nColumnsGlobalBlock); CHKERRV(ierr);
+        ierr = MatGetOwnershipRangesColumn(block.terms[0].matrix, &columnRangesBlockColumn[blockColumnNo]); CHKERRV(ierr);
 
-        PetscInt nRows = 0;
-        ierr = MatGetSize(currentMat, &nRows, &nColumnsGlobalNestedMats[nestedMatColumnNo]); CHKERRV(ierr);
-        ierr = MatGetLocalSize(currentMat, &nRows, &nColumnsLocalNestedMats[nestedMatColumnNo]); CHKERRV(ierr);
-        
-        nColumnsGlobal += nColumnsGlobalNestedMats[nestedMatColumnNo];
-        nColumnsLocal += nColumnsLocalNestedMats[nestedMatColumnNo];
-
+        nColumnsGlobal += nColumnsGlobalBlock;
         break;
       }
     }
+    if (columnRangesBlockColumn[blockColumnNo] == NULL)
+      LOG(FATAL) << "createMatFromBlocks: column " << blockColumnNo << " of the blocks contains no matrix, the number of columns can not be determined.";
   }
 
-  LOG(DEBUG) << "createMatFromNestedMat, nested mat has " << nNestedMatRows << "x" << nNestedMatColumns
-    << " sub matrices, sizes global: " << nRowsGlobalNestedMats << " x " << nColumnsGlobalNestedMats
-    << ", local: " << nRowsLocalNestedMats << " x " << nColumnsLocalNestedMats;
+  // determine the column ranges of singleMat, columnRangesGlobal[rankNo] is the first column of the column block of rank rankNo,
+  // and the offsets of the block columns inside the column blocks of the ranks, columnOffset[blockColumnNo*nRanks + rankNo]
+  std::vector<PetscInt> columnRangesGlobal(nRanks+1, 0);
+  std::vector<PetscInt> columnOffset(nBlockColumns*nRanks, 0);
 
-  // determine maximum number of nonzeros per row
-  // loop over rows of sub matrices
-  int nMaximumNonzerosPerRow = 0;
-  for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows; nestedMatRowNo++)
+  for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
   {
-    std::vector<PetscInt> nNonzeroEntriesRows;
-    for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns; nestedMatColumnNo++)
+    const PetscInt *columnRanges = columnRangesBlockColumn[blockColumnNo];
+    for (int rankNo = 0; rankNo <= nRanks; rankNo++)
+    {
+      columnRangesGlobal[rankNo] += columnRanges[rankNo];
+    }
+  }
+
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    PetscInt offset = 0;
+    for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
+    {
+      const PetscInt *columnRanges = columnRangesBlockColumn[blockColumnNo];
+      columnOffset[blockColumnNo*nRanks + rankNo] = offset;
+      offset += columnRanges[rankNo+1] - columnRanges[rankNo];
+    }
+  }
+
+  PetscInt nColumnsLocal = columnRangesGlobal[ownRankNo+1] - columnRangesGlobal[ownRankNo];
+
+  LOG(DEBUG) << "createMatFromBlocks, " << nBlockRows << "x" << nBlockColumns << " blocks, size global: "
+    << nRowsGlobal << "x" << nColumnsGlobal << ", local: " << nRowsLocal << "x" << nColumnsLocal;
+
+  // helper function that computes a local row of a block from its terms, the entries are stored in rowColumnIndices and rowValues
+  // with the global column indices of singleMat, the number of entries in the diagonal block (i.e. the columns owned by the own rank) is returned in nEntriesDiagonal
+  std::vector<std::pair<PetscInt,double>> rowEntries;   // (global column index in the block, value)
+  std::vector<PetscInt> rowColumnIndices;
+  std::vector<double> rowValues;
+  std::vector<const double *> rowScalingValues;         // local values of the rowScaling Vecs of the terms of the current block
+
+  auto computeBlockRow = [&](const MatrixBlock &block, int blockRowNo, int blockColumnNo, PetscInt rowNoLocal, PetscInt &nEntriesDiagonal)
+  {
+    rowEntries.clear();
+
+    // collect the entries of all terms
+    for (int termNo = 0; termNo < block.terms.size(); termNo++)
     {
-      Mat currentMat = nestedMats[nestedMatRowNo][nestedMatColumnNo];
+      const MatrixBlockTerm &term = block.terms[termNo];
+
+      double factor = term.scalingFactor;
+      if (rowScalingValues[termNo])
+        factor *= rowScalingValues[termNo][rowNoLocal];
 
-      if (currentMat != PETSC_NULL)
+      PetscInt rowNoGlobal = rowNoGlobalBeginBlockRow[blockRowNo] + rowNoLocal;
+      PetscInt nNonzeroEntriesInRow;
+      const PetscInt *columnIndices;
+      const double *values;
+      ierr = MatGetRow(term.matrix, rowNoGlobal, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
+
+      for (PetscInt entryNo = 0; entryNo < nNonzeroEntriesInRow; entryNo++)
       {
-        PetscInt rowNoGlobalBegin = 0;
-        PetscInt rowNoGlobalEnd = 0;
-        ierr = MatGetOwnershipRange(currentMat, &rowNoGlobalBegin, &rowNoGlobalEnd); CHKERRV(ierr);
+        rowEntries.push_back(std::make_pair(columnIndices[entryNo], factor*values[entryNo]));
+      }
+
+      ierr = MatRestoreRow(term.matrix, rowNoGlobal, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
+    }
+
+    // add the diagonal shift, the diagonal column of a square block has the same global number as the row
+    if (block.diagonalShift != 0.0)
+    {
+      rowEntries.push_back(std::make_pair(rowNoGlobalBeginBlockRow[blockRowNo] + rowNoLocal, block.diagonalShift));
+    }
 
-        if (nNonzeroEntriesRows.empty())
-          nNonzeroEntriesRows.resize(rowNoGlobalEnd-rowNoGlobalBegin, 0);
+    // merge entries of the same column, the rows of a single Petsc Mat are already sorted
+    if (block.terms.size() > 1 || block.diagonalShift != 0.0)
+    {
+      std::sort(rowEntries.begin(), rowEntries.end(), [](const std::pair<PetscInt,double> &a, const std::pair<PetscInt,double> &b)
+      {
+        return a.first < b.first;
+      });
 
-        // loop over rows of mat
-        for (int rowNoGlobal = rowNoGlobalBegin; rowNoGlobal < rowNoGlobalEnd; rowNoGlobal++)
+      int nMergedEntries = 0;
+      for (int entryNo = 0; entryNo < rowEntries.size(); entryNo++)
+      {
+        if (nMergedEntries > 0 && rowEntries[nMergedEntries-1].first == rowEntries[entryNo].first)
+        {
+          rowEntries[nMergedEntries-1].second += rowEntries[entryNo].second;
+        }
+        else
         {
-          PetscInt nNonzeroEntriesInRow;
-          const PetscInt *columnIndices;
-          const double *values;
-          ierr = MatGetRow(currentMat, rowNoGlobal, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
-          ierr = MatRestoreRow(currentMat, rowNoGlobal, NULL, &columnIndices, &values); CHKERRV(ierr);
-
-          int rowNoLocal = rowNoGlobal - rowNoGlobalBegin;
-          nNonzeroEntriesRows[rowNoLocal] += nNonzeroEntriesInRow;
+          rowEntries[nMergedEntries++] = rowEntries[entryNo];
         }
       }
+      rowEntries.resize(nMergedEntries);
     }
 
-    PetscInt nMaximumNonzerosPerRowCurrentMatRow = *std::max_element(nNonzeroEntriesRows.begin(), nNonzeroEntriesRows.end());
-    nMaximumNonzerosPerRow = std::max(nMaximumNonzerosPerRow, nMaximumNonzerosPerRowCurrentMatRow);
-  }
-  
-  LOG(DEBUG) << "nMaximumNonzerosPerRow: " << nMaximumNonzerosPerRow;
+    // transform the column indices of the block to the column indices of singleMat
+    const PetscInt *columnRanges = columnRangesBlockColumn[blockColumnNo];
+
+    rowColumnIndices.resize(rowEntries.size());
+    rowValues.resize(rowEntries.size());
+    nEntriesDiagonal = 0;
+    for (int entryNo = 0; entryNo < rowEntries.size(); entryNo++)
+    {
+      // determine the rank that owns the column
+      PetscInt columnNoGlobal = rowEntries[entryNo].first;
+      int rankNo = std::upper_bound(columnRanges, columnRanges+nRanks+1, columnNoGlobal) - columnRanges - 1;
+
+      rowColumnIndices[entryNo] = columnRangesGlobal[rankNo] + columnOffset[blockColumnNo*nRanks + rankNo] + columnNoGlobal - columnRanges[rankNo];
+      rowValues[entryNo] = rowEntries[entryNo].second;
+
+      if (rankNo == ownRankNo)
+        nEntriesDiagonal++;
+    }
+  };
+
+  // helper functions that get and restore the local arrays of the rowScaling Vecs of the terms of a block
+  auto getRowScalingValues = [&](const MatrixBlock &block)
+  {
+    rowScalingValues.assign(block.terms.size(), NULL);
+    for (int termNo = 0; termNo < block.terms.size(); termNo++)
+    {
+      if (block.terms[termNo].rowScaling != PETSC_NULL)
+      {
+        ierr = VecGetArrayRead(block.terms[termNo].rowScaling, &rowScalingValues[termNo]); CHKERRV(ierr);
+      }
+    }
+  };
+
+  auto restoreRowScalingValues = [&](const MatrixBlock &block)
+  {
+    for (int termNo = 0; termNo < block.terms.size(); termNo++)
+    {
+      if (block.terms[termNo].rowScaling != PETSC_NULL)
+      {
+        ierr = VecRestoreArrayRead(block.terms[termNo].rowScaling, &rowScalingValues[termNo]); CHKERRV(ierr);
+      }
+    }
+  };
 
   // if Mat object does not yet exist, create new one
   if (singleMat == PETSC_NULL)
   {
-    ierr = MatCreate(mpiCommunicator, &singleMat); CHKERRV(ierr);
-    ierr = MatSetSizes(singleMat, nRowsLocal, nColumnsLocal, nRowsGlobal, nColumnsGlobal); CHKERRV(ierr);
-    ierr = MatSetType(singleMat, MATAIJ); CHKERRV(ierr);
-    
-    // sparse matrix: preallocation of internal data structure
-    // http://www.mcs.anl.gov/petsc/petsc-current/docs/manualpages/Mat/MATAIJ.html#MATAIJ
-    // MATAIJ = "aij" - A matrix type to be used for sparse matrices. This matrix type is identical to MATSEQAIJ when constructed with a single process communicator, and MATMPIAIJ otherwise.
-    // As a result, for single process communicators, MatSeqAIJSetPreallocation is supported, and similarly MatMPIAIJSetPreallocation is supported for communicators controlling multiple processes.
-    // It is recommended that you call both of the above preallocation routines for simplicity.
-    PetscInt nNonZerosDiagonal = nMaximumNonzerosPerRow;
-    PetscInt nNonZerosOffdiagonal = nMaximumNonzerosPerRow;
-    ierr = MatSeqAIJSetPreallocation(singleMat, nNonZerosDiagonal, NULL); CHKERRV(ierr);
-    ierr = MatMPIAIJSetPreallocation(singleMat, nNonZerosDiagonal, NULL, nNonZerosOffdiagonal, NULL); CHKERRV(ierr);
-    
-    // get name of first sub Mat
-    std::string name;
-    char *cName;
-    ierr = PetscObjectGetName((PetscObject)nestedMats[0][0], (const char **)&cName); CHKERRV(ierr);
-    name = cName;
+    // count the number of nonzero entries in every local row, in the diagonal and off-diagonal block
+    std::vector<PetscInt> nNonzerosDiagonal(nRowsLocal, 0);
+    std::vector<PetscInt> nNonzerosOffdiagonal(nRowsLocal, 0);
 
-    name += std::string("_singleMat");
+    PetscInt rowOffset = 0;
+    for (int blockRowNo = 0; blockRowNo < nBlockRows; blockRowNo++)
+    {
+      for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
+      {
+        const MatrixBlock &block = blocks[blockRowNo*nBlockColumns + blockColumnNo];
 
-    //ierr = MatSetFromOptions(singleMat); CHKERRV(ierr);         // either use MatSetFromOptions or MatSetUp to allocate internal data structures
-    ierr = PetscObjectSetName((PetscObject)singleMat, name.c_str()); CHKERRV(ierr);
-    
-    LOG(DEBUG) << "create single Mat " << singleMat << " \"" << name << "\" with size local " << nRowsLocal << "x" << nColumnsLocal
-      << ", global " << nRowsGlobal << "x" << nColumnsGlobal << ", nNonzeros: " << nMaximumNonzerosPerRow;
-  }
+        if (block.terms.empty())
+          continue;
 
-  // set values
-  PetscInt singleMatRowNoGlobalBegin = 0;
-  ierr = MatGetOwnershipRange(singleMat, &singleMatRowNoGlobalBegin, NULL); CHKERRV(ierr);
+        getRowScalingValues(block);
 
-  std::vector<PetscInt> indices;
+        // loop over local rows of the block
+        for (PetscInt rowNoLocal = 0; rowNoLocal < nRowsLocalBlockRow[blockRowNo]; rowNoLocal++)
+        {
+          PetscInt nEntriesDiagonal = 0;
+          computeBlockRow(block, blockRowNo, blockColumnNo, rowNoLocal, nEntriesDiagonal);
 
-  // determine column ranges of ranks of all nested mats
-  std::vector<const PetscInt *> columnRangesNested(nNestedMatColumns);
+          nNonzerosDiagonal[rowOffset + rowNoLocal] += nEntriesDiagonal;
+          nNonzerosOffdiagonal[rowOffset + rowNoLocal] += rowColumnIndices.size() - nEntriesDiagonal;
+        }
 
-  // loop over all nested mats
-  for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns; nestedMatColumnNo++)
-  {
-    for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows; nestedMatRowNo++)
+        restoreRowScalingValues(block);
+      }
+      rowOffset += nRowsLocalBlockRow[blockRowNo];
+    }
+
+    // the sequential preallocation needs the total number of nonzeros per row
+    std::vector<PetscInt> nNonzeros(nRowsLocal);
+    for (PetscInt rowNoLocal = 0; rowNoLocal < nRowsLocal; rowNoLocal++)
     {
-      Mat currentMat = nestedMats[nestedMatRowNo][nestedMatColumnNo];
+      nNonzeros[rowNoLocal] = nNonzerosDiagonal[rowNoLocal] + nNonzerosOffdiagonal[rowNoLocal];
+    }
+
+    ierr = MatCreate(mpiCommunicator, &singleMat); CHKERRV(ierr);
+    ierr = MatSetSizes(singleMat, nRowsLocal, nColumnsLocal, nRowsGlobal, nColumnsGlobal); CHKERRV(ierr);
+    ierr = MatSetType(singleMat, MATAIJ); CHKERRV(ierr);
+
+    // sparse matrix: exact preallocation of internal data structure, it is recommended to call both preallocation routines
+    ierr = MatSeqAIJSetPreallocation(singleMat, 0, nNonzeros.data()); CHKERRV(ierr);
+    ierr = MatMPIAIJSetPreallocation(singleMat, 0, nNonzerosDiagonal.data(), 0, nNonzerosOffdiagonal.data()); CHKERRV(ierr);
 
-      if (currentMat != PETSC_NULL)
+    // keep the sparsity pattern when rows are zeroed for Dirichlet boundary conditions, such that the matrix can be filled again with the same structure,
+    // new nonzero entries are still allowed but need a new allocation
+    ierr = MatSetOption(singleMat, MAT_KEEP_NONZERO_PATTERN, PETSC_TRUE); CHKERRV(ierr);
+    ierr = MatSetOption(singleMat, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+
+    // get name of first matrix
+    std::string name;
+    for (const MatrixBlock &block : blocks)
+    {
+      if (!block.terms.empty())
       {
-        ierr = MatGetOwnershipRangesColumn(currentMat, &columnRangesNested[nestedMatColumnNo]); CHKERRV(ierr);
+        char *cName;
+        ierr = PetscObjectGetName((PetscObject)block.terms[0].matrix, (const char **)&cName); CHKERRV(ierr);
+        name = cName;
         break;
       }
     }
-  }
-
-  // determine column ranges for the single mat
-  const PetscInt *columnRangesGlobal;
-  ierr = MatGetOwnershipRangesColumn(singleMat, &columnRangesGlobal); CHKERRV(ierr);
+    name += std::string("_singleMat");
+    ierr = PetscObjectSetName((PetscObject)singleMat, name.c_str()); CHKERRV(ierr);
 
-#ifndef NDEBUG
-  std::stringstream s;
-  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    LOG(DEBUG) << "create single Mat " << singleMat << " \"" << name << "\" with size local " << nRowsLocal << "x" << nColumnsLocal
+      << ", global " << nRowsGlobal << "x" << nColumnsGlobal << ", nNonzeros local: " << std::accumulate(nNonzeros.begin(), nNonzeros.end(), (PetscInt)0);
+  }
+  else
   {
-    s << columnRangesGlobal[rankNo] << ",";
+    // the matrix already exists, reuse its sparsity pattern and only set new values
+    ierr = MatZeroEntries(singleMat); CHKERRV(ierr);
   }
-  LOG(DEBUG) << "columnRangesGlobal: " << s.str();
-#endif
 
-  PetscInt rowOffsetInSingleMatOwnDomain = 0;
+  // set values, every block is computed from its terms and written directly at its row and column offsets
+  PetscInt singleMatRowNoGlobalBegin = 0;
+  ierr = MatGetOwnershipRange(singleMat, &singleMatRowNoGlobalBegin, NULL); CHKERRV(ierr);
 
-  // loop over all nested mats
-  for (int nestedMatRowNo = 0; nestedMatRowNo < nNestedMatRows; nestedMatRowNo++)
+  PetscInt rowOffset = 0;
+  for (int blockRowNo = 0; blockRowNo < nBlockRows; blockRowNo++)
   {
-    std::vector<PetscInt> columnOffsetInSingleMatOwnDomain(nRanks,0);
-    for (int nestedMatColumnNo = 0; nestedMatColumnNo < nNestedMatColumns; nestedMatColumnNo++)
+    for (int blockColumnNo = 0; blockColumnNo < nBlockColumns; blockColumnNo++)
     {
-      Mat currentMat = nestedMats[nestedMatRowNo][nestedMatColumnNo];
-
-      if (currentMat != PETSC_NULL)
-      {
-        PetscInt rowNoGlobalBegin = 0;
-        PetscInt rowNoGlobalEnd = 0;
-        ierr = MatGetOwnershipRange(currentMat, &rowNoGlobalBegin, &rowNoGlobalEnd); CHKERRV(ierr);
-
-        PetscInt nRowsLocal = rowNoGlobalEnd - rowNoGlobalBegin;
-
-        // create index set indicating all rows of currentMat that are stored locally, in global numbering
-        IS indexSetRows[1];
-        ISCreateStride(mpiCommunicator, nRowsLocal, rowNoGlobalBegin, 1, &indexSetRows[0]);
-
-        // create index set indicating all columns of currentMat that are stored locally (which are also all global columns), in global numbering
-        IS indexSetColumns[1];
-        ISCreateStride(mpiCommunicator, nColumnsGlobalNestedMats[nestedMatColumnNo], 0, 1, &indexSetColumns[0]);
-        
-        Mat *localSubMatrix;
-        ierr = MatCreateSubMatrices(currentMat, 1, indexSetRows, indexSetColumns, MAT_INITIAL_MATRIX, &localSubMatrix); CHKERRV(ierr);
-
-        PetscInt nRowsLocalSubMatrix = 0;
-        PetscInt nColumnsLocalSubMatrix = 0;
-        ierr = MatGetSize(localSubMatrix[0], &nRowsLocalSubMatrix, &nColumnsLocalSubMatrix); CHKERRV(ierr);
-        
-        if (VLOG_IS_ON(1))
-        {
-          std::stringstream filename;
-          filename << "out/localSubMatrix" << nestedMatRowNo << "_" << nestedMatColumnNo << "_" << ownRankNo;
-          PetscUtility::dumpMatrix(filename.str(), std::string("matlab"), localSubMatrix[0], MPI_COMM_SELF);
-        }
+      const MatrixBlock &block = blocks[blockRowNo*nBlockColumns + blockColumnNo];
 
-        // loop over rows of mat
-        for (PetscInt rowNoGlobal = rowNoGlobalBegin; rowNoGlobal < rowNoGlobalEnd; rowNoGlobal++)
-        {
-          PetscInt rowNoLocal = rowNoGlobal - rowNoGlobalBegin;
-          
-          // transfer row from nested mat to singleMat
-          // get values of current row, this row will be split and the parts set at different locations
-          PetscInt nNonzeroEntriesInRow;
-          const PetscInt *columnIndices;
-          const double *values;
-          ierr = MatGetRow(localSubMatrix[0], rowNoLocal, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
+      if (block.terms.empty())
+        continue;
 
-          PetscInt singleMatRowNoGlobal = singleMatRowNoGlobalBegin + rowOffsetInSingleMatOwnDomain + rowNoLocal;
+      getRowScalingValues(block);
 
-#ifndef NDEBUG
-          PetscInt begin = 0;
-          PetscInt end = 0;
-          ierr = MatGetOwnershipRange(singleMat, &begin, &end); CHKERRV(ierr);
-
-          if (!(begin <= singleMatRowNoGlobal && singleMatRowNoGlobal < end))
-          {
-            LOG(FATAL) << "(" << nestedMatRowNo << "," << nestedMatColumnNo << ") set in row " << singleMatRowNoGlobal << " cols " << indices 
-              << ", ownership: [" << begin << "," << end << "], nestedMatRowNo: " << nestedMatRowNo
-              << ", nestedMatColumnNo: " << nestedMatColumnNo << ", rowNoGlobal: " << rowNoGlobal;
-
-          }
-          assert(begin <= singleMatRowNoGlobal);
-          assert(singleMatRowNoGlobal < end);
-#endif
-          
-          // loop over the ranges of ranks of the current retrieved row of currentMat, i.e. columnRangesNested[nestedMatColumnNo]
-          // at the same time find out global column indices within this range, they are in [currentColumnIndexBegin,currentColumnIndexEnd]
-          int currentColumnIndexBegin = 0;  
-          int currentColumnIndexEnd = 0;
-          int columnIndexNo = 0;
-            
-          for (int columnRangeNo = 0; columnRangeNo < nRanks; columnRangeNo++)
-          {
-            int currentColumnIndexRangeBegin = columnRangesNested[nestedMatColumnNo][columnRangeNo];
-            int currentColumnIndexRangeEnd = columnRangesNested[nestedMatColumnNo][columnRangeNo+1];
-          
-            // find out end of current column range in columnIndices array
-            for (; columnIndexNo < nNonzeroEntriesInRow; columnIndexNo++)
-            {
-              if (columnIndices[columnIndexNo] >= currentColumnIndexRangeEnd)
-              {
-                currentColumnIndexEnd = columnIndexNo;
-                break;
-              }
-            }
-            if (columnIndexNo == nNonzeroEntriesInRow)
-              currentColumnIndexEnd = columnIndexNo;
-            
-            PetscInt nColumnIndicesInRange = currentColumnIndexEnd - currentColumnIndexBegin;
-
-            // here, the columnIndices[i] are considered for i in [currentColumnIndexBegin,currentColumnIndexEnd]
-            // the corresponding values will be stored to the global column block of the rank = columnRangeNo
-            // and within this block to the sub part corresponding to the own part in the own block (columnRangesNested[columnRangeNo])
-
-            PetscInt singleMatColumnNoGlobalBegin = columnRangesGlobal[columnRangeNo];
-
-            // create global column indices for the singleMat
-            std::stringstream s;
-            indices.resize(nColumnIndicesInRange);
-            for (int i = 0; i < nColumnIndicesInRange; i++)
-            {
-              PetscInt columnNoLocal = columnIndices[currentColumnIndexBegin + i] - currentColumnIndexRangeBegin;
-              
-              if (VLOG_IS_ON(1))
-                s << columnNoLocal << ",";
-
-              indices[i] = singleMatColumnNoGlobalBegin + columnOffsetInSingleMatOwnDomain[columnRangeNo] + columnNoLocal;
-            }
-
-            if (VLOG_IS_ON(1))
-            {
-              if (nestedMatRowNo == 1 && nestedMatColumnNo == 1)
-              {
-                VLOG(1) << "from (" << nestedMatRowNo << "," << nestedMatColumnNo << ")/(" << nNestedMatRows << "," << nNestedMatColumns << ") row " 
-                  << rowNoGlobal << "/[" << rowNoGlobalBegin << "," << rowNoGlobalEnd << "]"
-                  << " range " << columnRangeNo << "/" << nRanks << " (cols " << currentColumnIndexRangeBegin << "-" << currentColumnIndexRangeEnd-1 << ", "
-                  << " indices from columnIndices[" << currentColumnIndexBegin << "-" << currentColumnIndexEnd-1 << "]/" << nNonzeroEntriesInRow 
-                  << ": " << columnIndices[currentColumnIndexBegin] << "-" << columnIndices[currentColumnIndexEnd-1] << "), local: [" << s.str() << "] " 
-                  << "set at global block " << columnRangeNo << "/" << nRanks << " starting at " << columnRangesGlobal[columnRangeNo] << " + local block " << nestedMatColumnNo 
-                  << " (+" << columnOffsetInSingleMatOwnDomain[columnRangeNo] << "), begin: " << singleMatColumnNoGlobalBegin + columnOffsetInSingleMatOwnDomain[columnRangeNo]
-                  << ", " << nColumnIndicesInRange << " indices: " << indices;
-              }
-            }
-
-            ierr = MatSetValues(singleMat, 1, &singleMatRowNoGlobal, nColumnIndicesInRange, indices.data(), values + currentColumnIndexBegin, INSERT_VALUES);
-
-            // columns in next columnRange start from end point of current columnRange
-            currentColumnIndexBegin = currentColumnIndexEnd;
-          }
-
-          ierr = MatRestoreRow(localSubMatrix[0], rowNoLocal, NULL, &columnIndices, &values); CHKERRV(ierr);
-        }
+      // loop over local rows of the block
+      for (PetscInt rowNoLocal = 0; rowNoLocal < nRowsLocalBlockRow[blockRowNo]; rowNoLocal++)
+      {
+        PetscInt nEntriesDiagonal = 0;
+        computeBlockRow(block, blockRowNo, blockColumnNo, rowNoLocal, nEntriesDiagonal);
 
-        ierr = MatDestroySubMatrices(1, &localSubMatrix); CHKERRV(ierr);
+        PetscInt singleMatRowNoGlobal = singleMatRowNoGlobalBegin + rowOffset + rowNoLocal;
+        ierr = MatSetValues(singleMat, 1, &singleMatRowNoGlobal, rowColumnIndices.size(), rowColumnIndices.data(), rowValues.data(), INSERT_VALUES); CHKERRV(ierr);
       }
 
-      for (int rankNo = 0; rankNo < nRanks; rankNo++)
-      {
-        columnOffsetInSingleMatOwnDomain[rankNo] += columnRangesNested[nestedMatColumnNo][rankNo+1] - columnRangesNested[nestedMatColumnNo][rankNo];
-      }
+      restoreRowScalingValues(block);
     }
-    rowOffsetInSingleMatOwnDomain += nRowsLocalNestedMats[nestedMatRowNo];
+    rowOffset += nRowsLocalBlockRow[blockRowNo];
   }
 
   LOG(DEBUG) << "final assembly";
- 
+
   ierr = MatAssemblyBegin(singleMat, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
   ierr = MatAssemblyEnd(singleMat, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
 }
@@ -2,6 +2,7 @@
 
 #include <petsc.h>
 #include <memory>
+#include <vector>
 
 #include "partition/rank_subset.h"
 
@@ -17,8 +18,42 @@ void createVecFromNestedVec(Vec nestedVec, Vec &singleVec, std::shared_ptr<Parti
 //! copy the values from a singleVec back to the nested Petsc Vec (nestedVec)
 void fillNestedVec(Vec singleVec, Vec nestedVec);
 
+//! from a list of Petsc Vecs (subvectors) create a new Petsc Vec (singleVec) that contains all values at once, without the need for a nested Vec.
+//! If the singleVec already exists, do not create again, only copy the local values.
+void createVecFromSubvectors(const std::vector<Vec> &subvectors, Vec &singleVec, std::shared_ptr<Partition::RankSubset> rankSubset);
+
+//! copy the local values from a singleVec back to the subvectors
+void fillSubvectors(Vec singleVec, const std::vector<Vec> &subvectors);
+
 //! from a Petsc Mat with nested type (nestedMat) create a new Petsc Mat (singleMat) that contains all values at once. If the singleMat already exists, do not create again, only copy the values.
 void createMatFromNestedMat(Mat nestedMat, Mat &singleMat, std::shared_ptr<Partition::RankSubset> rankSubset);
 
-} 
+//! one summand of a block of a block matrix, the summand is scalingFactor * diag(rowScaling) * matrix
+struct MatrixBlockTerm
+{
+  Mat matrix;                 //< the matrix from which the values are taken, it is not modified
+  double scalingFactor;       //< factor with which all values of matrix are multiplied
+  Vec rowScaling;             //< if not NULL, every local row of matrix is additionally multiplied by the corresponding local entry of this Vec
+};
+
+//! a block of a block matrix, given as sum of terms plus diagonalShift * I. The block is not stored as a separate Petsc Mat,
+//! its values are computed from the terms while they are set in the single Mat. A block without terms is an empty (zero) block.
+struct MatrixBlock
+{
+  std::vector<MatrixBlockTerm> terms;   //< the summands of the block, empty for a zero block
+  double diagonalShift = 0.0;           //< value that is added to the diagonal entries of the block, only for square blocks
+};
+
+//! from the blocks of a block matrix, blocks[rowNo*nBlockColumns + columnNo], assemble a Petsc Mat (singleMat) that contains all values at once,
+//! without the need for a nested Mat or for a separate Mat per block. If the singleMat does not yet exist, it is created with the exact preallocation.
+//! If it already exists, its sparsity pattern is kept and only the values are set again.
+void createMatFromBlocks(const std::vector<MatrixBlock> &blocks, int nBlockRows, int nBlockColumns,
+                         Mat &singleMat, std::shared_ptr<Partition::RankSubset> rankSubset);
+
+//! from the sub matrices of a block matrix, submatrices[rowNo*nSubmatrixColumns + columnNo] (empty blocks are NULL), assemble a Petsc Mat (singleMat)
+//! that contains all values at once, this is createMatFromBlocks where every block consists of the sub matrix only.
+void createMatFromSubmatrices(const std::vector<Mat> &submatrices, int nSubmatrixRows, int nSubmatrixColumns,
+                              Mat &singleMat, std::shared_ptr<Partition::RankSubset> rankSubset);
+
+}
 }  // namespace
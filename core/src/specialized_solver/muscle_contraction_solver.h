@@ -86,6 +86,7 @@ protected:
   bool enableForceLengthRelation_;              //< if the force-length relation factor f_l(λ_f) should be multiplied
   double lambdaDotScalingFactor_;               //< scaling factor for the computation of lambdaDot
   std::vector<std::string> meshNamesOfGeometryToMapTo_;   //< a list of mesh names which will get updated with the geometry
+  bool updateMappingsBetweenMeshes_;            //< if the mappings between the meshes in meshNamesOfGeometryToMapTo_ and other meshes should be updated after the geometry was transferred
 
   bool initialized_;                            //< if initialize was already called
 };
@@ -39,6 +39,7 @@ MuscleContractionSolver(DihuContext context) :
   lambdaDotScalingFactor_ = this->specificSettings_.getOptionDouble("lambdaDotScalingFactor", 1.0);
 
   this->specificSettings_.template getOptionVector<std::string>("mapGeometryToMeshes", meshNamesOfGeometryToMapTo_);
+  updateMappingsBetweenMeshes_ = this->specificSettings_.getOptionBool("updateMappingsBetweenMeshes", false);
 }
 
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
@@ -484,6 +485,13 @@ mapGeometryToGivenMeshes()
         DihuContext::mappingBetweenMeshesManager()->template finalizeMapping<SourceFieldVariableType,TargetFieldVariableType4>(geometryFieldSource, geometryFieldTarget, -1, -1, false);
       }
     }
+
+    // update the mappings between the meshes that got the new geometry and other meshes, e.g. between fibers and a 3D mesh,
+    // the mappings to and from the mechanics mesh are not updated, because the geometry was transferred by them and they stay valid
+    if (updateMappingsBetweenMeshes_)
+    {
+      DihuContext::mappingBetweenMeshesManager()->updateMappingsBetweenMeshes(meshNamesOfGeometryToMapTo_, data_.functionSpace()->meshName());
+    }
   }
 
   if (this->durationLogKey_ != "")
@@ -10,6 +10,9 @@
 #include "data_management/specialized_solver/hyperelasticity_solver.h"
 #include "spatial_discretization/dirichlet_boundary_conditions/01_dirichlet_boundary_conditions.h"
 #include "spatial_discretization/neumann_boundary_conditions/01_neumann_boundary_conditions.h"
+#include "spatial_discretization/quadrature_point_cache/quadrature_point_cache.h"
+#include "quadrature/tensor_product.h"
+#include "quadrature/gauss.h"
 #include "specialized_solver/solid_mechanics/hyperelasticity/pressure_function_space_creator.h"
 
 namespace SpatialDiscretization
@@ -40,9 +43,15 @@ public:
   typedef PartitionedPetscVecForHyperelasticity<DisplacementsFunctionSpace,PressureFunctionSpace,Term,nDisplacementComponents> VecHyperelasticity;
   typedef PartitionedPetscMatForHyperelasticity<DisplacementsFunctionSpace,PressureFunctionSpace,Term,nDisplacementComponents> MatHyperelasticity;
 
+  //! cache of the basis functions and jacobians of the reference configuration at the quadrature points of the displacements function space
+  typedef QuadraturePointCache<DisplacementsFunctionSpace,Quadrature::TensorProduct<3,Quadrature::Gauss<3>>> QuadraturePointCacheType;
+
   //! constructor
   HyperelasticityInitialize(DihuContext context, std::string settingsKey = "HyperelasticitySolver");
 
+  //! destructor
+  virtual ~HyperelasticityInitialize();
+
   //! initialize components of the simulation
   void initialize();
 
@@ -76,6 +85,9 @@ public:
   //! get the PartitionedPetsVec for the solution
   std::shared_ptr<VecHyperelasticity> combinedVecSolution();
 
+  //! get the PartitionedPetscMat for the jacobian, it holds the result of evaluateAnalyticJacobian
+  std::shared_ptr<MatHyperelasticity> combinedMatrixJacobian();
+
   //! output the jacobian matrix for debugging
   void dumpJacobianMatrix(Mat jac);
 
@@ -109,6 +121,9 @@ public:
   //! @return if computation was successful
   virtual bool evaluateAnalyticJacobian(Vec x, Mat jac) = 0;
 
+  //! this assembles the constant preconditioner matrix that is used with the matrix-free jacobian
+  virtual void evaluateMatrixFreePreconditioner() = 0;
+
   //! get the Petsc Vec of the current state (uvp vector), this is needed to save and restore checkpoints from the PreciceAdapter
   Vec currentState();
 
@@ -200,8 +215,18 @@ protected:
 
   bool useAnalyticJacobian_;                                //< if the analytically computed Jacobian of the Newton scheme should be used. Theoretically if it is correct, this is the fastest option.
   bool useNumericJacobian_;                                 //< if a numerically computed Jacobian should be used, approximated by finite differences
+  bool useMatrixFreeJacobian_;                              //< if the action of the Jacobian is computed matrix-free by finite differences of the residual, solverMatrixJacobian_ then holds a constant preconditioner
+  Mat solverMatrixJacobianMatrixFree_;                      //< the matrix-free jacobian, a MATMFFD shell matrix, only used if useMatrixFreeJacobian_
   bool extrapolateInitialGuess_;                            //< if the initial values for the dynamic nonlinear problem should be computed by extrapolating the previous displacements and velocities
   bool scaleInitialGuess_;                                  //< when load stepping is used, scale initial guess between load steps a and b by sqrt(a*b)/a
+  int jacobianLag_;                                         //< the jacobian is only rebuilt every jacobianLag_ Newton iterations, option "jacobianLag", 1 means every iteration
+  int preconditionerLag_;                                   //< the preconditioner is only rebuilt every preconditionerLag_ jacobian evaluations, option "preconditionerLag"
+  bool lagAcrossSolves_;                                    //< if the lagged jacobian and preconditioner are kept between nonlinear solves, i.e. time steps and load factors, option "lagAcrossSolves"
+  double jacobianRefreshThreshold_;                         //< if the residual norm reduction in one iteration is worse than this factor, a lagged jacobian is rebuilt in the next iteration
+  bool jacobianRefreshRequested_;                           //< if a rebuild of the lagged jacobian was requested and the lag settings have to be restored afterwards
+  int nJacobianEvaluations_;                                //< number of evaluations of the jacobian in total
+  int nJacobianEvaluationsAtRefreshRequest_;                //< value of nJacobianEvaluations_ when the last rebuild of the jacobian was requested
+  QuadraturePointCacheType quadraturePointCacheReference_;  //< stored inverse jacobians of the reference configuration at the quadrature points, they are constant during the whole simulation
 };
 
 }  // namespace
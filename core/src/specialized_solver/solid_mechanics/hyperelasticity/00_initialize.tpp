@@ -6,6 +6,7 @@
 #include "utility/petsc_utility.h"
 #include "solver/solver_manager.h"
 #include "data_management/specialized_solver/multidomain.h"
+#include "data_management/finite_element_method/finite_elements_base.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
 #include "partition/mesh_partition/01_mesh_partition_structured.h"
@@ -18,7 +19,9 @@ template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementC
 HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
   context_(context[settingsKey]), data_(context_), pressureDataCopy_(context_), initialized_(false),
-  endTime_(0), lastNorm_(0), secondLastNorm_(0), currentLoadFactor_(1.0), lastSolveSucceeded_(false), nNonZerosJacobian_(0)
+  endTime_(0), lastNorm_(0), secondLastNorm_(0), currentLoadFactor_(1.0), lastSolveSucceeded_(false), nNonZerosJacobian_(0),
+  solverMatrixJacobianMatrixFree_(PETSC_NULL),
+  jacobianRefreshRequested_(false), nJacobianEvaluations_(0), nJacobianEvaluationsAtRefreshRequest_(0)
 {
   // get python config
   this->specificSettings_ = this->context_.getPythonConfig();
@@ -32,14 +35,43 @@ HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
   // parse options concerning jacobian
   useAnalyticJacobian_  = this->specificSettings_.getOptionBool("useAnalyticJacobian", true);
   useNumericJacobian_   = this->specificSettings_.getOptionBool("useNumericJacobian", true);
+  useMatrixFreeJacobian_ = this->specificSettings_.getOptionBool("useMatrixFreeJacobian", false);
   nNonlinearSolveCalls_ = this->specificSettings_.getOptionInt("nNonlinearSolveCalls", 1, PythonUtility::Positive);
   loadFactorGiveUpThreshold_ = this->specificSettings_.getOptionDouble("loadFactorGiveUpThreshold", 1e-5, PythonUtility::Positive);
   scaleInitialGuess_ = this->specificSettings_.getOptionBool("scaleInitialGuess", false);
 
+  // parse options concerning lagging of jacobian and preconditioner
+  jacobianLag_ = this->specificSettings_.getOptionInt("jacobianLag", 1, PythonUtility::Positive);
+  preconditionerLag_ = this->specificSettings_.getOptionInt("preconditionerLag", 1, PythonUtility::Positive);
+  lagAcrossSolves_ = this->specificSettings_.getOptionBool("lagAcrossSolves", false);
+  jacobianRefreshThreshold_ = this->specificSettings_.getOptionDouble("jacobianRefreshThreshold", 0.5, PythonUtility::NonNegative);
+
+  // parse the memory limit of the cache for values at the quadrature points
+  double quadraturePointCacheMaximumMemory = this->specificSettings_.getOptionDouble("quadraturePointCacheMaximumMemory", 512, PythonUtility::NonNegative);
+  quadraturePointCacheReference_ = QuadraturePointCacheType(quadraturePointCacheMaximumMemory);
+
   // parse constant body force, a value of "None" yields the default value, (0,0,0)
   constantBodyForce_ = this->specificSettings_.template getOptionArray<double,3>("constantBodyForce", Vec3{0.0,0.0,0.0});
 
-  if (!useAnalyticJacobian_ && !useNumericJacobian_)
+  // the preconditioner of the matrix-free jacobian does not contain the velocity equations of the dynamic problem
+  if (useMatrixFreeJacobian_ && nDisplacementComponents == 6)
+  {
+    LOG(WARNING) << "\"useMatrixFreeJacobian\" is only implemented for the static problem, now using the assembled jacobian.";
+    useMatrixFreeJacobian_ = false;
+  }
+
+  // the matrix-free jacobian replaces the analytic and numeric jacobians, it is preconditioned by a constant matrix and its base point is updated in every Newton iteration
+  if (useMatrixFreeJacobian_)
+  {
+    if (jacobianLag_ != 1 || preconditionerLag_ != 1)
+    {
+      LOG(WARNING) << "\"useMatrixFreeJacobian\" is True, the options \"jacobianLag\" and \"preconditionerLag\" have no effect, "
+        << "because the matrix-free jacobian is evaluated at the current solution in every Newton iteration and the preconditioner is constant.";
+    }
+    useAnalyticJacobian_ = false;
+    useNumericJacobian_ = false;
+  }
+  else if (!useAnalyticJacobian_ && !useNumericJacobian_)
   {
     LOG(WARNING) << "Cannot set both \"useAnalyticJacobian\" and \"useNumericJacobian\" to False, now using numeric jacobian.";
     useNumericJacobian_ = true;
@@ -105,6 +137,9 @@ initialize()
   pressureDataCopy_.initialize(data_.pressure(), data_.displacementsLinearMesh(), data_.velocitiesLinearMesh());
   pressureDataCopy_.setFunctionSpace(pressureFunctionSpace_);
 
+  // the reference configuration does not change, the quadrature point cache is filled on the first evaluation of the residual or jacobian
+  quadraturePointCacheReference_.reset(displacementsFunctionSpace_->nElementsLocal());
+
   // create nonlinear solver PETSc context (snes)
   nonlinearSolver_ = this->context_.solverManager()->template solver<Solver::Nonlinear>(
     this->specificSettings_, this->displacementsFunctionSpace_->meshPartition()->mpiCommunicator());
@@ -513,7 +548,20 @@ initializePetscVariables()
   // create matrix with same dof mapping as vectors
   //std::shared_ptr<::FunctionSpace::Generic> genericFunctionSpace = context_.meshManager()->createGenericFunctionSpace(nMatrixRowsLocal, displacementsFunctionSpace_->meshPartition(), "genericMesh");
 
-  combinedMatrixJacobian_ = createPartitionedPetscMat("combinedJacobian");
+  if (useMatrixFreeJacobian_)
+  {
+    // the preconditioner of the matrix-free jacobian only couples equal displacement components, it needs the same number of entries per row as a scalar problem
+    int nNonZerosDiagonal = 0;
+    int nNonZerosOffdiagonal = 0;
+    ::Data::FiniteElementsBase<DisplacementsFunctionSpace,1>::getPetscMemoryParameters(nNonZerosDiagonal, nNonZerosOffdiagonal);
+
+    LOG(INFO) << "Preallocation for matrix \"combinedPreconditioner\": diagonal nz: " << nNonZerosDiagonal << ", offdiagonal nz: " << nNonZerosOffdiagonal;
+    combinedMatrixJacobian_ = std::make_shared<MatHyperelasticity>(combinedVecSolution_, nNonZerosDiagonal, nNonZerosOffdiagonal, "combinedPreconditioner");
+  }
+  else
+  {
+    combinedMatrixJacobian_ = createPartitionedPetscMat("combinedJacobian");
+  }
 
   solverMatrixAdditionalNumericJacobian_ = PETSC_NULL;
 
@@ -584,6 +632,15 @@ initializePetscVariables()
     dumpJacobianMatrix(solverMatrixJacobian_);
   }
 
+  if (useMatrixFreeJacobian_)
+  {
+    // the preconditioner does not depend on the solution, it is assembled once
+    evaluateMatrixFreePreconditioner();
+
+    LOG(DEBUG) << "preconditioner matrix for the matrix-free jacobian: ";
+    dumpJacobianMatrix(solverMatrixJacobian_);
+  }
+
   // assign all callback functions
   this->initializePetscCallbackFunctions();
 
@@ -964,6 +1021,25 @@ combinedVecSolution()
   return this->combinedVecSolution_;
 }
 
+//! get the PartitionedPetscMat for the jacobian
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+std::shared_ptr<typename HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::MatHyperelasticity> HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+combinedMatrixJacobian()
+{
+  return this->combinedMatrixJacobian_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+~HyperelasticityInitialize()
+{
+  if (solverMatrixJacobianMatrixFree_ != PETSC_NULL)
+  {
+    PetscErrorCode ierr;
+    ierr = MatDestroy(&solverMatrixJacobianMatrixFree_); CHKERRV(ierr);
+  }
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 reset()
@@ -29,6 +29,7 @@ public:
 
   typedef PartitionedPetscVecForHyperelasticity<DisplacementsFunctionSpace,PressureFunctionSpace,Term,nDisplacementComponents> VecHyperelasticity;
   typedef PartitionedPetscMatForHyperelasticity<DisplacementsFunctionSpace,PressureFunctionSpace,Term,nDisplacementComponents> MatHyperelasticity;
+  typedef QuadraturePointCache<DisplacementsFunctionSpace,Quadrature::TensorProduct<3,Quadrature::Gauss<3>>> QuadraturePointCacheType;
 
   //! constructor
   HyperelasticityMaterialComputations(DihuContext context, std::string settingsKey = "HyperelasticitySolver");
@@ -94,6 +95,10 @@ protected:
   //! @return true if computation was successful (i.e. no negative jacobian)
   bool materialComputeJacobian();
 
+  //! compute the preconditioner for the matrix-free jacobian, this is the linear elasticity stiffness matrix of the reference configuration with only the couplings of equal displacement components,
+  //! for incompressible materials the pressure block is the pressure mass matrix scaled by the inverse shear modulus, output is in combinedMatrixJacobian_
+  void materialComputeMatrixFreePreconditioner();
+
   //! compute the deformation gradient, F inside the current element at position xi, the value of F is still with respect to the reference configuration,
   //! the formula is F_ij = x_i,j = δ_ij + u_i,j
   template<typename double_v_t>
@@ -101,6 +106,12 @@ protected:
                                                  const Tensor2<3,double_v_t> &inverseJacobianMaterial,
                                                  const std::array<double,3> xi);
 
+  //! compute the deformation gradient F, the same as the previous method but with the gradients of the basis functions w.r.t. xi already evaluated at the position, e.g. from the QuadraturePointCache
+  template<typename double_v_t>
+  Tensor2<3,double_v_t> computeDeformationGradient(const std::array<VecD<3,double_v_t>,DisplacementsFunctionSpace::nDofsPerElement()> &displacements,
+                                                 const Tensor2<3,double_v_t> &inverseJacobianMaterial,
+                                                 const std::array<std::array<double,3>,DisplacementsFunctionSpace::nDofsPerElement()> &gradPhi);
+
   //! compute the time velocity of the deformation gradient, Fdot inside the current element at position xi, the value of F is still with respect to the reference configuration,
   //! the formula is Fdot_ij = d/dt x_i,j = v_i,j
   template<typename double_v_t>
@@ -178,6 +189,7 @@ protected:
   using Parent::externalVirtualWorkDead_;             //< the external virtual work resulting from the traction, this is a dead load, i.e. it does not change during deformation
   using Parent::getString;                            //< function to get a string representation of the values for debugging output
   using Parent::setUVP;                               //< function to copy the values of the vector x which contains (u and p) or (u,v and p) values to this->data_.displacements(), this->data_.velocities() and this->data_.pressure();
+  using Parent::quadraturePointCacheReference_;       //< stored inverse jacobians of the reference configuration at the quadrature points
 };
 
 }  // namespace
@@ -138,10 +138,10 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
       // get parameter values of current sampling point
       Vec3 xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3x3 jacobian of the parameter space to world space mapping
-      Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
+      // get the inverse of the 3x3 jacobian of the parameter space to world space mapping, this is only computed once and then taken from the cache
       double_v_t jacobianDeterminant;
-      Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+      Tensor2_v_t<D> inverseJacobianMaterial = this->quadraturePointCacheReference_.inverseJacobian(
+        elementNoLocal, samplingPointIndex, geometryReferenceValues, approximateMeshWidth, jacobianDeterminant);
 
       // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
@@ -150,7 +150,8 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
       double_v_t integrationFactor = MathUtility::abs(jacobianDeterminant); // MathUtility::computeIntegrationFactor(jacobianMaterial);
 
       // F
-      Tensor2_v_t<D> deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial, xi);
+      Tensor2_v_t<D> deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial,
+                                                                            QuadraturePointCacheType::gradPhi()[samplingPointIndex]);
       double_v_t deformationGradientDeterminant = MathUtility::computeDeterminant(deformationGradient);  // J
 
       Tensor2_v_t<D> rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
@@ -224,7 +225,6 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
         VLOG(2) << "element local " << elementNoLocal << " global " << elementNoGlobal << " xi: " << xi;
         VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
         VLOG(2) << "  displacementsValues: " << displacementsValues;
-        VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
         VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
         VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
         VLOG(2) << "  deformationGradient: F=" << deformationGradient;
@@ -1097,10 +1097,10 @@ materialComputeJacobian()
       // get parameter values of current sampling point
       Vec3 xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3x3 jacobian of the parameter space to world space mapping
-      Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
+      // get the inverse of the 3x3 jacobian of the parameter space to world space mapping, this is only computed once and then taken from the cache
       double_v_t jacobianDeterminant;
-      Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+      Tensor2_v_t<D> inverseJacobianMaterial = this->quadraturePointCacheReference_.inverseJacobian(
+        elementNoLocal, samplingPointIndex, geometryReferenceValues, approximateMeshWidth, jacobianDeterminant);
 
       // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
@@ -1108,7 +1108,8 @@ materialComputeJacobian()
       // get the factor in the integral that arises from the change in integration domain from world to parameter space
       double_v_t integrationFactor = MathUtility::abs(jacobianDeterminant);   //MathUtility::computeIntegrationFactor(jacobianMaterial);
 
-      Tensor2_v_t<D> deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial, xi);    // F
+      Tensor2_v_t<D> deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial,
+                                                                            QuadraturePointCacheType::gradPhi()[samplingPointIndex]);    // F
       double_v_t deformationGradientDeterminant;    // J
       Tensor2_v_t<D> inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, deformationGradientDeterminant);  // F^-1
 
@@ -1170,7 +1171,6 @@ materialComputeJacobian()
       VLOG(2) << "element " << elementNoLocal << " xi: " << xi;
       VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
       VLOG(2) << "  displacementsValues: " << displacementsValues;
-      VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
       VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
       VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
       VLOG(2) << "  deformationGradient: F=" << deformationGradient;
@@ -1498,4 +1498,197 @@ materialComputeJacobian()
 }
 
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+materialComputeMatrixFreePreconditioner()
+{
+  // The preconditioner does not depend on the solution. It is the tangent stiffness in the undeformed configuration, i.e. the linear elasticity stiffness,
+  // where only the entries between equal displacement components are kept (the "separate displacement components" approximation).
+  // The matrix therefore has the sparsity pattern of a scalar problem and is only assembled once.
+
+  // get pointer to function space
+  std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
+  std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
+
+  const int D = 3;  // dimension
+  const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
+  const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
+
+  // define shortcuts for quadrature
+  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;
+
+  // define types to hold evaluations of integrand, the entries of the displacements block are stored for (L,M,a)
+  typedef std::array<double_v_t, nDisplacementsDofsPerElement*nDisplacementsDofsPerElement*D> EvaluationsDisplacementsType;
+  std::array<EvaluationsDisplacementsType, QuadratureDD::numberEvaluations()> evaluationsArrayDisplacements{};
+
+  typedef std::array<double_v_t, nPressureDofsPerElement*nPressureDofsPerElement> EvaluationsPressureType;
+  std::array<EvaluationsPressureType, QuadratureDD::numberEvaluations()> evaluationsArrayPressure{};
+
+  // setup arrays used for integration
+  std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
+
+  // quantities of the undeformed configuration, F = C = C^-1 = I and J = 1
+  Tensor2_v_t<D> identity{};
+  for (int i = 0; i < D; i++)
+    identity[i][i] = 1.0;
+  const double_v_t determinant = 1.0;
+
+  // loop over elements, always 4 elements at once using the vectorized functions
+  for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
+  {
+
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+    dof_no_v_t elementNoLocalv([elementNoLocal, nElementsLocal](dof_no_t i)
+    {
+      return (i >= nVcComponents || elementNoLocal+i >= nElementsLocal? -1: elementNoLocal+i);
+    });
+#else
+    int elementNoLocalv = elementNoLocal;
+#endif
+
+    // get geometry field of reference configuration
+    std::array<Vec3_v_t,nDisplacementsDofsPerElement> geometryReferenceValues;
+    this->data_.geometryReference()->getElementValues(elementNoLocalv, geometryReferenceValues);
+    double_v_t approximateMeshWidth = MathUtility::computeApproximateMeshWidth<double_v_t,nDisplacementsDofsPerElement>(geometryReferenceValues);
+
+    std::array<Vec3_v_t,nDisplacementsDofsPerElement> elementalDirectionValues;
+    this->data_.fiberDirection()->getElementValues(elementNoLocalv, elementalDirectionValues);
+
+    // loop over integration points (e.g. gauss points) for displacements field
+    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+    {
+      // get parameter values of current sampling point
+      Vec3 xi = samplingPoints[samplingPointIndex];
+
+      // get the inverse of the 3x3 jacobian of the parameter space to world space mapping
+      double_v_t jacobianDeterminant;
+      Tensor2_v_t<D> inverseJacobianMaterial = this->quadraturePointCacheReference_.inverseJacobian(
+        elementNoLocal, samplingPointIndex, geometryReferenceValues, approximateMeshWidth, jacobianDeterminant);
+
+      double_v_t integrationFactor = MathUtility::abs(jacobianDeterminant);
+
+      // fiber direction
+      Vec3_v_t fiberDirection = displacementsFunctionSpace->template interpolateValueInElement<3>(elementalDirectionValues, xi);
+      if (Term::usesFiberDirection)
+      {
+        MathUtility::normalize<3>(fiberDirection);
+      }
+
+      // compute the elasticity tensor of the undeformed configuration, this is the tensor of linear elasticity
+      std::array<double_v_t,5> invariants = this->computeInvariants(identity, determinant, fiberDirection);
+      std::array<double_v_t,5> reducedInvariants = this->computeReducedInvariants(invariants, determinant);
+
+      double_v_t pressure = 0;
+      Tensor2_v_t<D> fictitiousPK2Stress;
+      Tensor2_v_t<D> pk2StressIsochoric;
+      this->computePK2Stress(pressure, identity, identity, invariants, reducedInvariants, determinant, fiberDirection,
+                             fictitiousPK2Stress, pk2StressIsochoric);
+
+      Tensor4_v_t<D> elasticityTensor;
+      Tensor4_v_t<D> fictitiousElasticityTensor;
+      Tensor4_v_t<3> elasticityTensorIso;
+      computeElasticityTensor(identity, identity, determinant, pressure, invariants, reducedInvariants, fictitiousPK2Stress, pk2StressIsochoric, fiberDirection,
+                              fictitiousElasticityTensor, elasticityTensorIso, elasticityTensor);
+
+      // compute the derivatives of the basis functions with respect to the reference configuration, dphiL_dX[L][B] = dphi_L/dX_B
+      const std::array<Vec3,nDisplacementsDofsPerElement> &gradPhi = QuadraturePointCacheType::gradPhi()[samplingPointIndex];
+      std::array<Vec3_v_t,nDisplacementsDofsPerElement> dphiL_dX{};
+      for (int lDof = 0; lDof < nDisplacementsDofsPerElement; lDof++)
+      {
+        for (int bInternal = 0; bInternal < D; bInternal++)
+        {
+          for (int k = 0; k < D; k++)
+          {
+            dphiL_dX[lDof][bInternal] += gradPhi[lDof][k] * inverseJacobianMaterial[bInternal][k];
+          }
+        }
+      }
+
+      // integrand phi_La,B * c_aBaD * phi_Ma,D, with F = I the term of the tangent is k_abBD = c_aBbD and only a = b is kept
+      for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)      // L
+      {
+        for (int bDof = 0; bDof < nDisplacementsDofsPerElement; bDof++)    // M
+        {
+          for (int aComponent = 0; aComponent < D; aComponent++)           // a
+          {
+            double_v_t integrand = 0.0;
+            for (int bInternal = 0; bInternal < D; bInternal++)            // B
+            {
+              for (int dInternal = 0; dInternal < D; dInternal++)          // D
+              {
+                // elasticityTensor[D][C][B][A] = c_{ABCD}
+                integrand += dphiL_dX[aDof][bInternal] * elasticityTensor[dInternal][aComponent][bInternal][aComponent] * dphiL_dX[bDof][dInternal];
+              }
+            }
+
+            const int index = (aDof*nDisplacementsDofsPerElement + bDof)*D + aComponent;
+            evaluationsArrayDisplacements[samplingPointIndex][index] = integrand * integrationFactor;
+          }
+        }
+      }
+
+      // the pressure block is the mass matrix scaled by the inverse shear modulus c_0101, which gives the Schur complement of the incompressible problem up to a constant
+      if (Term::isIncompressible)
+      {
+        const double_v_t shearModulus = elasticityTensor[1][0][1][0];
+
+        for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+        {
+          for (int mDof = 0; mDof < nPressureDofsPerElement; mDof++)
+          {
+            const double integrand = pressureFunctionSpace->phi(lDof,xi) * pressureFunctionSpace->phi(mDof,xi);
+            evaluationsArrayPressure[samplingPointIndex][lDof*nPressureDofsPerElement + mDof] = integrand / shearModulus * integrationFactor;
+          }
+        }
+      }
+    }   // sampling points
+
+    // integrate all values for result vector entries at once
+    EvaluationsDisplacementsType integratedValuesDisplacements = QuadratureDD::computeIntegral(evaluationsArrayDisplacements);
+
+    EvaluationsPressureType integratedValuesPressure;
+    if (Term::isIncompressible)
+    {
+      integratedValuesPressure = QuadratureDD::computeIntegral(evaluationsArrayPressure);
+    }
+
+    // get indices of element-local dofs
+    std::array<dof_no_v_t,nDisplacementsDofsPerElement> dofNosLocal = displacementsFunctionSpace->getElementDofNosLocal(elementNoLocalv);
+    std::array<dof_no_v_t,nPressureDofsPerElement> dofNosLocalPressure = pressureFunctionSpace->getElementDofNosLocal(elementNoLocalv);
+
+    // add entries of the displacements block, the entries of prescribed dofs are skipped by setValue
+    for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)        // L
+    {
+      for (int bDof = 0; bDof < nDisplacementsDofsPerElement; bDof++)      // M
+      {
+        for (int aComponent = 0; aComponent < D; aComponent++)             // a
+        {
+          const int index = (aDof*nDisplacementsDofsPerElement + bDof)*D + aComponent;
+
+          // parameters: componentNoRow, dofNoLocalRow, componentNoColumn, dofNoLocalColumn, value
+          combinedMatrixJacobian_->setValue(aComponent, dofNosLocal[aDof], aComponent, dofNosLocal[bDof], integratedValuesDisplacements[index], ADD_VALUES);
+        }
+      }
+    }
+
+    // add entries of the pressure block
+    if (Term::isIncompressible)
+    {
+      const int pressureDofNo = nDisplacementComponents;
+
+      for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+      {
+        for (int mDof = 0; mDof < nPressureDofsPerElement; mDof++)
+        {
+          combinedMatrixJacobian_->setValue(pressureDofNo, dofNosLocalPressure[lDof], pressureDofNo, dofNosLocalPressure[mDof],
+                                            integratedValuesPressure[lDof*nPressureDofsPerElement + mDof], ADD_VALUES);
+        }
+      }
+    }
+  }  // local elements
+
+  combinedMatrixJacobian_->assembly(MAT_FINAL_ASSEMBLY);
+}
+
 } // namespace
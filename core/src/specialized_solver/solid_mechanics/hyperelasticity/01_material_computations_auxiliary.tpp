@@ -17,6 +17,25 @@ computeDeformationGradient(const std::array<VecD<3,double_v_t>,DisplacementsFunc
                            const Tensor2<3,double_v_t> &inverseJacobianMaterial,
                            const std::array<double, 3> xi
                           )
+{
+  // evaluate the gradients of the basis functions at xi
+  const int nDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  std::array<std::array<double,3>,nDofsPerElement> gradPhi;
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+  {
+    gradPhi[dofIndex] = DisplacementsFunctionSpace::gradPhi(dofIndex, xi);
+  }
+
+  return computeDeformationGradient(displacements, inverseJacobianMaterial, gradPhi);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+template<typename double_v_t>
+Tensor2<3,double_v_t> HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+computeDeformationGradient(const std::array<VecD<3,double_v_t>,DisplacementsFunctionSpace::nDofsPerElement()> &displacements,
+                           const Tensor2<3,double_v_t> &inverseJacobianMaterial,
+                           const std::array<std::array<double,3>,DisplacementsFunctionSpace::nDofsPerElement()> &gradPhi
+                          )
 {
   // compute the deformation gradient x_i,j = δ_ij + u_i,j
   // where j is dimensionColumn and i is component of the used Vec3's
@@ -47,7 +66,7 @@ computeDeformationGradient(const std::array<VecD<3,double_v_t>,DisplacementsFunc
       for (int l = 0; l < 3; l++)
       {
         VLOG(3) << "   l = " << l;
-        double_v_t dphi_dxil = DisplacementsFunctionSpace::dphi_dxi(dofIndex, l, xi);
+        double_v_t dphi_dxil = gradPhi[dofIndex][l];
         double_v_t dxil_dX = inverseJacobianMaterial[dimensionColumn][l];     // inverseJacobianMaterial[j][l] = J_lj = dxi_l/dX_j
 
         VLOG(3) << "     dphi_dxil = " << dphi_dxil << ", dxil_dX = " << dxil_dX;
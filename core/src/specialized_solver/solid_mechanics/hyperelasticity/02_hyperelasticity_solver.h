@@ -88,6 +88,12 @@ public:
   //! callback after each nonlinear iteration
   void monitorSolvingIteration(SNES snes, PetscInt its, PetscReal norm);
 
+  //! callback after each evaluation of the jacobian, counts the evaluations
+  void countJacobianEvaluation();
+
+  //! for the matrix-free jacobian, assemble the constant preconditioner matrix, the linear elasticity stiffness with only the couplings of equal displacement components
+  void evaluateMatrixFreePreconditioner();
+
 protected:
 
   typedef HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents> Parent;
@@ -105,6 +111,15 @@ protected:
   //! set all PETSc callback functions, e.g. for computation jacobian or the nonlinear function itself
   void initializePetscCallbackFunctions();
 
+  //! let the SNES rebuild the jacobian and the preconditioner at the next iteration, regardless of the lag settings
+  void requestJacobianRefresh(SNES snes);
+
+  //! restore the lag settings of the SNES after a requested rebuild of the jacobian has happened
+  void restoreJacobianLag(SNES snes);
+
+  //! if the jacobian or the preconditioner is possibly not rebuilt in every Newton iteration
+  bool isJacobianLagged();
+
   using Parent::lastSolution_;           //< a temporary variable to hold the previous solution in the nonlinear solver, to be used to reset the nonlinear scheme if it diverged
   using Parent::bestSolution_;           //< a temporary variable to hold the best solution so, the one with the lowest residual norm
 
@@ -118,6 +133,16 @@ protected:
   using Parent::lastSolveSucceeded_;     //< if the last computation of the residual or jacobian succeeded, if this is false, it indicates that there was a negative jacobian
   using Parent::loadFactorGiveUpThreshold_;   //< a threshold for the load factor, if it is below, the solve is aborted
 
+  using Parent::jacobianLag_;            //< the jacobian is only rebuilt every jacobianLag_ Newton iterations
+  using Parent::preconditionerLag_;      //< the preconditioner is only rebuilt every preconditionerLag_ jacobian evaluations
+  using Parent::lagAcrossSolves_;        //< if the lagged jacobian and preconditioner are kept between nonlinear solves
+  using Parent::jacobianRefreshThreshold_;    //< if the residual norm reduction in one iteration is worse than this factor, a lagged jacobian is rebuilt
+  using Parent::jacobianRefreshRequested_;    //< if a rebuild of the lagged jacobian was requested
+  using Parent::nJacobianEvaluations_;   //< number of evaluations of the jacobian in total
+  using Parent::nJacobianEvaluationsAtRefreshRequest_;   //< value of nJacobianEvaluations_ when the last rebuild of the jacobian was requested
+  using Parent::useMatrixFreeJacobian_;  //< if the action of the Jacobian is computed matrix-free, the assembled analytic jacobian is then only used as preconditioner
+  using Parent::solverMatrixJacobianMatrixFree_;  //< the matrix-free jacobian, a MATMFFD shell matrix
+
   using Parent::endTime_;                //< end time of the simulation
   using Parent::combinedVecResidual_;    //< the Vec for the residual and result of the nonlinear function
   using Parent::combinedVecSolution_;    //< the Vec for the solution, combined means that ux,uy,uz and p components are combined in one vector
@@ -96,6 +96,7 @@ nonlinearSolve()
 
       // reset indicator whether the last solve did not encounter a negative jacobian
       this->lastSolveSucceeded_ = true;
+
       // solve the system nonlinearFunction(displacements) = 0
       ierr = SNESSolve(*snes, NULL, solverVariableSolution_); CHKERRV(ierr);
 
@@ -140,6 +141,10 @@ nonlinearSolve()
 
         this->lastSolveSucceeded_ = false;
 
+        // a lagged jacobian that belongs to the failed solve should not be reused for the retry
+        if (isJacobianLagged())
+          requestJacobianRefresh(*snes);
+
         // restore last solution
         ierr = VecCopy(lastSolution_, solverVariableSolution_); CHKERRV(ierr);
       }
@@ -225,6 +230,21 @@ monitorSolvingIteration(SNES snes, PetscInt its, PetscReal currentNorm)
   // e_current = e_old ^ c = exp(c*log(e_old)) => c = log(e_current) / log(e_old)
   PetscReal experimentalOrderOfConvergence = log(currentNorm) / log(lastNorm_);
 
+  // restore the lag settings once the requested rebuild of the jacobian has happened
+  if (jacobianRefreshRequested_ && nJacobianEvaluations_ > nJacobianEvaluationsAtRefreshRequest_)
+  {
+    restoreJacobianLag(snes);
+  }
+
+  // if the jacobian is lagged and the residual norm does not decrease fast enough, rebuild the jacobian in the next iteration
+  if (isJacobianLagged() && !jacobianRefreshRequested_ && its > 0 && lastNorm_ > 0
+      && currentNorm > jacobianRefreshThreshold_*lastNorm_)
+  {
+    LOG(DEBUG) << "Residual norm reduction " << currentNorm/lastNorm_ << " is worse than jacobianRefreshThreshold "
+      << jacobianRefreshThreshold_ << ", rebuild lagged jacobian.";
+    requestJacobianRefresh(snes);
+  }
+
   secondLastNorm_ = lastNorm_;
   lastNorm_ = currentNorm;
   this->norms_.push_back(currentNorm);
@@ -271,6 +291,61 @@ monitorSolvingIteration(SNES snes, PetscInt its, PetscReal currentNorm)
     }
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+countJacobianEvaluation()
+{
+  nJacobianEvaluations_++;
+
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::countNumber(this->durationLogKey_+std::string("_nJacobianEvaluations"), 1);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+evaluateMatrixFreePreconditioner()
+{
+  this->materialComputeMatrixFreePreconditioner();
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+bool HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+isJacobianLagged()
+{
+  // the matrix-free jacobian is evaluated at the current solution in every Newton iteration and its preconditioner is constant
+  if (useMatrixFreeJacobian_)
+    return false;
+
+  return jacobianLag_ != 1 || preconditionerLag_ != 1 || lagAcrossSolves_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+requestJacobianRefresh(SNES snes)
+{
+  // a lag of -2 lets PETSc rebuild at the next opportunity, afterwards it would never rebuild again, therefore the lag is restored in restoreJacobianLag()
+  PetscErrorCode ierr;
+  ierr = SNESSetLagJacobian(snes, -2); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditioner(snes, -2); CHKERRV(ierr);
+
+  jacobianRefreshRequested_ = true;
+  nJacobianEvaluationsAtRefreshRequest_ = nJacobianEvaluations_;
+
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::countNumber(this->durationLogKey_+std::string("_nJacobianRefreshes"), 1);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+restoreJacobianLag(SNES snes)
+{
+  PetscErrorCode ierr;
+  ierr = SNESSetLagJacobian(snes, useMatrixFreeJacobian_? 1 : jacobianLag_); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditioner(snes, useMatrixFreeJacobian_? 1 : preconditionerLag_); CHKERRV(ierr);
+
+  jacobianRefreshRequested_ = false;
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 initializePetscCallbackFunctions()
@@ -288,6 +363,7 @@ initializePetscCallbackFunctions()
   PetscErrorCode (*callbackJacobianAnalytic)(SNES, Vec, Mat, Mat, void *)          = *jacobianFunctionAnalytic<ThisClass>;
   PetscErrorCode (*callbackJacobianFiniteDifferences)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionFiniteDifferences<ThisClass>;
   PetscErrorCode (*callbackJacobianCombined)(SNES, Vec, Mat, Mat, void *)          = *jacobianFunctionCombined<ThisClass>;
+  PetscErrorCode (*callbackJacobianMatrixFree)(SNES, Vec, Mat, Mat, void *)        = *jacobianFunctionMatrixFree<ThisClass>;
   PetscErrorCode (*callbackMonitorFunction)(SNES, PetscInt, PetscReal, void *)     = *monitorFunction<ThisClass>;
 
   // set function
@@ -295,7 +371,18 @@ initializePetscCallbackFunctions()
   ierr = SNESSetFunction(*snes, solverVariableResidual_, callbackNonlinearFunction, this); CHKERRV(ierr);
 
   // set jacobian
-  if (this->useAnalyticJacobian_)
+  if (this->useMatrixFreeJacobian_)
+  {
+    // the action of the jacobian is computed by finite differences of the nonlinear function, solverMatrixJacobian_ holds the constant preconditioner
+    if (this->solverMatrixJacobianMatrixFree_ != PETSC_NULL)
+    {
+      ierr = MatDestroy(&this->solverMatrixJacobianMatrixFree_); CHKERRV(ierr);
+    }
+    ierr = MatCreateSNESMF(*snes, &this->solverMatrixJacobianMatrixFree_); CHKERRV(ierr);
+    ierr = SNESSetJacobian(*snes, this->solverMatrixJacobianMatrixFree_, this->solverMatrixJacobian_, callbackJacobianMatrixFree, this); CHKERRV(ierr);
+    LOG(DEBUG) << "Use matrix-free jacobian with linear elasticity preconditioner: " << this->solverMatrixJacobian_;
+  }
+  else if (this->useAnalyticJacobian_)
   {
     if (this->useNumericJacobian_)   // use combination of analytic jacobian also with finite differences
     {
@@ -318,6 +405,20 @@ initializePetscCallbackFunctions()
     LOG(DEBUG) << "Use Finite-Differences approximation for jacobian";
   }
 
+  // set lagging of jacobian and preconditioner, the jacobian is then only rebuilt every jacobianLag_ Newton iterations
+  // and the preconditioner every preconditionerLag_ jacobian evaluations, with lagAcrossSolves_ the counting continues over multiple solves
+  // the base point of the matrix-free jacobian has to be updated in every Newton iteration, this is cheap because its preconditioner matrix does not change
+  ierr = SNESSetLagJacobian(*snes, this->useMatrixFreeJacobian_? 1 : this->jacobianLag_); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditioner(*snes, this->useMatrixFreeJacobian_? 1 : this->preconditionerLag_); CHKERRV(ierr);
+  ierr = SNESSetLagJacobianPersists(*snes, this->lagAcrossSolves_? PETSC_TRUE : PETSC_FALSE); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditionerPersists(*snes, this->lagAcrossSolves_? PETSC_TRUE : PETSC_FALSE); CHKERRV(ierr);
+
+  if (this->jacobianLag_ != 1 || this->preconditionerLag_ != 1)
+  {
+    LOG(DEBUG) << "Lag jacobian: " << this->jacobianLag_ << ", lag preconditioner: " << this->preconditionerLag_
+      << ", lag across solves: " << this->lagAcrossSolves_;
+  }
+
   // prepare log file
   if (this->specificSettings_.hasKey("residualNormLogFilename"))
   {
@@ -42,6 +42,13 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
 template<typename T>
 PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *context);
 
+/**
+ * Updates the base point of the matrix-free jacobian jac, which computes its action by finite differences of the nonlinear function,
+ * the preconditioner matrix b is constant
+ */
+template<typename T>
+PetscErrorCode jacobianFunctionMatrixFree(SNES snes, Vec x, Mat jac, Mat b, void *context);
+
 /**
  * Monitor convergence of nonlinear solver
  *
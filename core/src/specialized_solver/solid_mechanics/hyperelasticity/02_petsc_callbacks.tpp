@@ -61,6 +61,7 @@ PetscErrorCode jacobianFunctionAnalytic(SNES snes, Vec x, Mat jac, Mat b, void *
 
   // compute jacobian by analytic formula
   object->evaluateAnalyticJacobian(x, jac);
+  object->countJacobianEvaluation();
 
   // output the jacobian matrix for debugging
   object->dumpJacobianMatrix(jac);
@@ -86,6 +87,7 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
 
   // compute jacobian by finite differences, in b (but this is the same pointer as jac)
   SNESComputeJacobianDefault(snes, x, jac, b, context);
+  object->countJacobianEvaluation();
 
   // output the jacobian matrix for debugging
   object->dumpJacobianMatrix(jac);
@@ -115,6 +117,7 @@ PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *
 
   // compute the analytical jacobian matrix, stored in the preconditioner slot b
   object->evaluateAnalyticJacobian(x, b);
+  object->countJacobianEvaluation();
 
   // output the jacobian matrix for debugging
   object->dumpJacobianMatrix(b);
@@ -123,6 +126,26 @@ PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *
   return 0;
 }
 
+template<typename T>
+PetscErrorCode jacobianFunctionMatrixFree(SNES snes, Vec x, Mat jac, Mat b, void *context)
+{
+  T* object = static_cast<T*>(context);
+
+  VLOG(1) << "in jacobianFunctionMatrixFree";
+  VLOG(1) << "pointer value x:   " << x;
+  VLOG(1) << "pointer value jac: " << jac << " (should be the matrix-free slot)";
+  VLOG(1) << "pointer value b:   " << b << " (should be the preconditioner slot)";
+
+  // set the current solution as base point of the matrix-free jacobian, the residual at x is reused from the SNES
+  PetscErrorCode ierr;
+  ierr = MatMFFDComputeJacobian(snes, x, jac, jac, context); CHKERRQ(ierr);
+
+  // the preconditioner matrix b is constant, it is not modified such that PETSc keeps the setup of the preconditioner
+  object->countJacobianEvaluation();
+
+  return 0;
+}
+
 /**
  * Monitor convergence of nonlinear solver
  *
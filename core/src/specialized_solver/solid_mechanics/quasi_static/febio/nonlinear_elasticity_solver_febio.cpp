@@ -639,6 +639,9 @@ loadFebioOutputFile()
   this->data_.functionSpace()->geometryField().setRepresentationGlobal();
   this->data_.functionSpace()->geometryField().startGhostManipulation();
 
+  // the shared assembled matrices of the mesh belong to the old geometry
+  DihuContext::meshManager()->invalidateAssembledMatrices(this->data_.functionSpace()->meshName());
+
   LOG(DEBUG) << "geometryField pointer: " << this->data_.functionSpace()->geometryField().partitionedPetscVec();
   LOG(DEBUG) << "referenceGeometry pointer: " << this->data_.referenceGeometry()->partitionedPetscVec();
 }
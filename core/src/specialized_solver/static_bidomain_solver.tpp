@@ -147,7 +147,8 @@ initialize()
   // indicate in solverStructureVisualizer that the child solver initialization is done
   DihuContext::solverStructureVisualizer()->endChild();
 
-  // initialize the matrix to be used for computing the rhs
+  // initialize the matrix to be used for computing the rhs, it is scaled in place, therefore it must not be shared with other objects
+  finiteElementMethodDiffusionTransmembrane_.data().copySharedStiffnessMatrix();
   data_.rhsMatrix() = finiteElementMethodDiffusionTransmembrane_.data().stiffnessMatrix()->valuesGlobal();
   PetscErrorCode ierr;
   ierr = MatScale(data_.rhsMatrix(), -1); CHKERRV(ierr);
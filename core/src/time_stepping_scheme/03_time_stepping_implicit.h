@@ -7,6 +7,8 @@
 #include "control/dihu_context.h"
 #include "solver/linear.h"
 
+#include <vector>
+
 namespace TimeSteppingScheme
 {
 
@@ -58,12 +60,47 @@ protected:
   
   //! solves the linear system of equations resulting from the Implicit Euler method time discretization
   void solveLinearSystem(Vec &input, Vec &output);
+
+  //! check if the two time step widths are equal within the relative tolerance timeStepWidthRelativeTolerance_
+  bool timeStepWidthsEqual(double timeStepWidth0, double timeStepWidth1);
+
+  //! if there is a cached setup for the given time step width, use its system matrix and linear solver and return true, otherwise return false
+  bool activateCachedTimeStepWidthSetup(double timeStepWidth);
+
+  //! select the entry in timeStepWidthSetups_ that will be computed for a new time step width, either a new one or the least recently used one
+  void prepareNewTimeStepWidthSetup();
+
+  //! set the system matrix, integration matrix, boundary condition rhs summand and linear solver of the setup with the given index as the current ones
+  void activateTimeStepWidthSetup(int setupNo);
+
+  //! check if the stiffness matrix or the prescribed values of the Dirichlet boundary conditions changed since the cached setups were computed
+  bool timeStepWidthSetupsOutdated();
+
+  //! discard all cached setups, such that the next call to initializeWithTimeStepWidth computes a new setup
+  void clearTimeStepWidthSetups();
   
   std::shared_ptr<Data::TimeSteppingImplicit<typename DiscretizableInTimeType::FunctionSpace, DiscretizableInTimeType::nComponents()>> dataImplicit_;  //< a pointer to the data_ object but of type Data::TimeSteppingImplicit
   std::shared_ptr<Solver::Linear> linearSolver_;   //< the linear solver used for solving the system
   std::shared_ptr<KSP> ksp_;     //< the ksp object of the linear solver
 
   double initializedTimeStepWidth_ = -1.0; //< the time step width that was used for the initialization, or negative if the step width has not been initialized
+
+  struct TimeStepWidthSetup
+  {
+    double timeStepWidth;                                                                            //< the time step width for which the setup was computed
+    std::shared_ptr<PartitionedPetscMat<FunctionSpace>> systemMatrix;                                //< the system matrix with applied boundary conditions
+    std::shared_ptr<PartitionedPetscMat<FunctionSpace>> integrationMatrixRightHandSide;              //< the integration matrix of the rhs, only for Crank-Nicolson
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace,DiscretizableInTimeType::nComponents()>> boundaryConditionsRightHandSideSummand;  //< the rhs summand of the boundary conditions, which depends on the system matrix
+    std::shared_ptr<Solver::Linear> linearSolver;                                                    //< the linear solver, its KSP keeps the preconditioner setup of the system matrix
+    int lastUsed;                                                                                    //< value of timeStepWidthSetupCounter_ when the setup was used last
+  };
+  std::vector<TimeStepWidthSetup> timeStepWidthSetups_;   //< cache of setups for the most recently used time step widths, such that alternating time step widths do not require a new setup
+  int nCachedTimeStepWidths_;                             //< option "nCachedTimeStepWidths", the maximum number of entries in timeStepWidthSetups_
+  int activeTimeStepWidthSetupNo_ = -1;                   //< index into timeStepWidthSetups_ of the setup that is currently used
+  int timeStepWidthSetupCounter_ = 0;                     //< counter that is incremented whenever a setup is used, to determine the least recently used setup
+  Mat setupsStiffnessMatrix_ = PETSC_NULL;                //< the stiffness matrix from which the cached setups were computed
+  PetscObjectState setupsStiffnessMatrixState_ = 0;       //< the PETSc object state of setupsStiffnessMatrix_ when the last setup was computed, it changes when the matrix entries change
+  int setupsPrescribedValuesChangeCounter_ = 0;           //< the value of prescribedValuesChangeCounter() of the Dirichlet boundary conditions when the last setup was computed
   double timeStepWidthRelativeTolerance_; //< tolerance for the time step width to rebuild the system matrix and integrationMatrixRHS
   std::string durationInitTimeStepLogKey_; //< log key for the duration of the (re)initialization of the system matrix and integrationMatrixRHS
 };
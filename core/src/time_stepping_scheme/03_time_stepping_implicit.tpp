@@ -8,6 +8,9 @@
 #include "solver/solver_manager.h"
 #include "solver/linear.h"
 #include "data_management/time_stepping/time_stepping_implicit.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
+#include <sstream>
 
 namespace TimeSteppingScheme
 {
@@ -32,6 +35,13 @@ initialize()
   TimeSteppingSchemeOde<DiscretizableInTimeType>::initialize();
   LOG(TRACE) << "TimeSteppingImplicit::initialize";
 
+  // the system matrix is computed from the assembled stiffness matrix, which does not exist in matrix-free mode
+  if (this->discretizableInTime_.data().matrixFree())
+  {
+    LOG(FATAL) << this->specificSettings() << ": The FiniteElementMethod uses \"matrixFree\": True, this is not possible with implicit time stepping schemes, "
+      << "because they need the assembled stiffness matrix. Set \"matrixFree\": False or use an explicit time stepping scheme.";
+  }
+
   timeStepWidthRelativeTolerance_ = this->specificSettings().getOptionDouble("timeStepWidthRelativeTolerance", 1e-10, PythonUtility::NonNegative);
   if (this->specificSettings().hasKey("timeStepWidthRelativeToleranceAsKey"))
   {
@@ -44,6 +54,9 @@ initialize()
     this->durationInitTimeStepLogKey_ = this->specificSettings().getOptionString("durationInitTimeStepLogKey", "");
   }
 
+  // parse for how many different time step widths the system matrix and the preconditioner setup should be kept
+  nCachedTimeStepWidths_ = this->specificSettings().getOptionInt("nCachedTimeStepWidths", 1, PythonUtility::Positive);
+
   this->initialized_ = true;
 }
 
@@ -54,6 +67,12 @@ initializeWithTimeStepWidth(double timeStepWidth)
 {
   LOG(TRACE) << "TimeSteppingImplicit::initializeWithTimeStepWidth(" << timeStepWidth << ")";
 
+  // the cached setups depend on the stiffness matrix and the prescribed values, discard them if these have changed
+  if (!timeStepWidthSetups_.empty() && timeStepWidthSetupsOutdated())
+  {
+    clearTimeStepWidthSetups();
+  }
+
   // check if the time step changed and a new initialization is neccessary
   if (this->initializedTimeStepWidth_ < 0.0 || !this->dataImplicit_->systemMatrix())
   {
@@ -66,12 +85,24 @@ initializeWithTimeStepWidth(double timeStepWidth)
     const double eps = this->timeStepWidthRelativeTolerance_;
 
     const double relDiff = (this->initializedTimeStepWidth_ - timeStepWidth) / this->initializedTimeStepWidth_;
-    if (-eps <= relDiff && relDiff <= eps)
+    if (timeStepWidthsEqual(this->initializedTimeStepWidth_, timeStepWidth))
     {
       LOG(DEBUG) << "do not re-initializeWithTimeStepWidth as relative difference of time steps is small (tolerance: " << eps << "): "
         << relDiff << ". Old: " << this->initializedTimeStepWidth_ << ", new: " << timeStepWidth;
       return;
     }
+
+    // check if the setup for the new time step width was computed earlier and is still cached
+    if (activateCachedTimeStepWidthSetup(timeStepWidth))
+    {
+      LOG(DEBUG) << "re-initializeWithTimeStepWidth not necessary, use the cached system matrix and linear solver for time step width " << timeStepWidth
+        << ". Old: " << this->initializedTimeStepWidth_;
+
+      Control::PerformanceMeasurement::countNumber(this->name_ + "_nTimeStepWidthSetupsReused", 1);
+      this->initializedTimeStepWidth_ = timeStepWidth;
+      return;
+    }
+
     LOG(DEBUG) << "re-initializeWithTimeStepWidth as relative difference of time steps is too large (tolerance: " << eps << "): "
       << relDiff << ". Old: " << this->initializedTimeStepWidth_ << ", new: " << timeStepWidth;
   }
@@ -79,15 +110,158 @@ initializeWithTimeStepWidth(double timeStepWidth)
   if (this->durationInitTimeStepLogKey_ != "")
     Control::PerformanceMeasurement::start(this->durationInitTimeStepLogKey_);
 
+  // select the cache entry that will hold the new setup
+  prepareNewTimeStepWidthSetup();
+
   // perform actual (re-)initialization
   this->initializeWithTimeStepWidth_impl(timeStepWidth);
 
   if (this->durationInitTimeStepLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationInitTimeStepLogKey_);
 
+  // store the new setup in the cache
+  TimeStepWidthSetup &timeStepWidthSetup = timeStepWidthSetups_[activeTimeStepWidthSetupNo_];
+  timeStepWidthSetup.timeStepWidth = timeStepWidth;
+  timeStepWidthSetup.systemMatrix = this->dataImplicit_->systemMatrix();
+  timeStepWidthSetup.integrationMatrixRightHandSide = this->dataImplicit_->integrationMatrixRightHandSide();
+  timeStepWidthSetup.boundaryConditionsRightHandSideSummand = this->dataImplicit_->boundaryConditionsRightHandSideSummand();
+  timeStepWidthSetup.linearSolver = linearSolver_;
+
+  // store the state of the data the setups depend on
+  setupsStiffnessMatrix_ = this->discretizableInTime_.data().stiffnessMatrix()->valuesGlobal();
+  PetscErrorCode ierr;
+  ierr = PetscObjectStateGet((PetscObject)setupsStiffnessMatrix_, &setupsStiffnessMatrixState_); CHKERRV(ierr);
+  setupsPrescribedValuesChangeCounter_ = this->dirichletBoundaryConditions_->prescribedValuesChangeCounter();
+
+  Control::PerformanceMeasurement::countNumber(this->name_ + "_nTimeStepWidthSetups", 1);
   this->initializedTimeStepWidth_ = timeStepWidth;
 }
 
+template<typename DiscretizableInTimeType>
+bool TimeSteppingImplicit<DiscretizableInTimeType>::
+timeStepWidthsEqual(double timeStepWidth0, double timeStepWidth1)
+{
+  const double eps = this->timeStepWidthRelativeTolerance_;
+  const double relDiff = (timeStepWidth0 - timeStepWidth1) / timeStepWidth0;
+  return -eps <= relDiff && relDiff <= eps;
+}
+
+template<typename DiscretizableInTimeType>
+bool TimeSteppingImplicit<DiscretizableInTimeType>::
+activateCachedTimeStepWidthSetup(double timeStepWidth)
+{
+  for (int setupNo = 0; setupNo < timeStepWidthSetups_.size(); setupNo++)
+  {
+    if (setupNo != activeTimeStepWidthSetupNo_ && timeStepWidthsEqual(timeStepWidthSetups_[setupNo].timeStepWidth, timeStepWidth))
+    {
+      activateTimeStepWidthSetup(setupNo);
+      return true;
+    }
+  }
+  return false;
+}
+
+template<typename DiscretizableInTimeType>
+void TimeSteppingImplicit<DiscretizableInTimeType>::
+prepareNewTimeStepWidthSetup()
+{
+  if ((int)timeStepWidthSetups_.size() < nCachedTimeStepWidths_)
+  {
+    // add a new entry, the first entry uses the objects that are already present in dataImplicit_ and the linear solver from the solver manager
+    if (!timeStepWidthSetups_.empty())
+    {
+      // let setSystemMatrix create new matrices, such that the matrices of the other cached setups are kept
+      this->dataImplicit_->setSystemMatrix(nullptr);
+      this->dataImplicit_->setIntegrationMatrixRightHandSide(nullptr);
+      this->dataImplicit_->setBoundaryConditionsRightHandSideSummand(
+        this->data_->functionSpace()->template createFieldVariable<DiscretizableInTimeType::nComponents()>("boundaryConditionsRightHandSideSummand"));
+
+      // create a separate linear solver with the same settings, its KSP will keep the preconditioner setup of the new system matrix
+      initializeLinearSolver();
+      std::stringstream name;
+      name << linearSolver_->name() << "_timeStepWidthSetup" << timeStepWidthSetups_.size();
+      linearSolver_ = std::make_shared<Solver::Linear>(linearSolver_->specificSettings(),
+                                                       this->data_->functionSpace()->meshPartition()->mpiCommunicator(), name.str());
+      linearSolver_->initialize();
+      ksp_ = linearSolver_->ksp();
+    }
+
+    timeStepWidthSetups_.push_back(TimeStepWidthSetup());
+    activeTimeStepWidthSetupNo_ = timeStepWidthSetups_.size()-1;
+  }
+  else
+  {
+    // all entries are used, overwrite the least recently used setup, with only one entry (the default) this is always the current setup
+    int leastRecentlyUsedSetupNo = 0;
+    for (int setupNo = 1; setupNo < timeStepWidthSetups_.size(); setupNo++)
+    {
+      if (timeStepWidthSetups_[setupNo].lastUsed < timeStepWidthSetups_[leastRecentlyUsedSetupNo].lastUsed)
+        leastRecentlyUsedSetupNo = setupNo;
+    }
+
+    activateTimeStepWidthSetup(leastRecentlyUsedSetupNo);
+  }
+
+  timeStepWidthSetups_[activeTimeStepWidthSetupNo_].lastUsed = timeStepWidthSetupCounter_++;
+
+  // the boundary conditions are added to the rhs summand by applyInSystemMatrix, start from zero for the new system matrix
+  this->dataImplicit_->boundaryConditionsRightHandSideSummand()->zeroEntries();
+}
+
+template<typename DiscretizableInTimeType>
+void TimeSteppingImplicit<DiscretizableInTimeType>::
+activateTimeStepWidthSetup(int setupNo)
+{
+  TimeStepWidthSetup &timeStepWidthSetup = timeStepWidthSetups_[setupNo];
+
+  this->dataImplicit_->setSystemMatrix(timeStepWidthSetup.systemMatrix);
+  this->dataImplicit_->setIntegrationMatrixRightHandSide(timeStepWidthSetup.integrationMatrixRightHandSide);
+  this->dataImplicit_->setBoundaryConditionsRightHandSideSummand(timeStepWidthSetup.boundaryConditionsRightHandSideSummand);
+
+  linearSolver_ = timeStepWidthSetup.linearSolver;
+  ksp_ = linearSolver_->ksp();
+
+  timeStepWidthSetup.lastUsed = timeStepWidthSetupCounter_++;
+  activeTimeStepWidthSetupNo_ = setupNo;
+}
+
+template<typename DiscretizableInTimeType>
+bool TimeSteppingImplicit<DiscretizableInTimeType>::
+timeStepWidthSetupsOutdated()
+{
+  Mat stiffnessMatrix = this->discretizableInTime_.data().stiffnessMatrix()->valuesGlobal();
+  if (stiffnessMatrix != setupsStiffnessMatrix_)
+    return true;
+
+  PetscObjectState stiffnessMatrixState;
+  PetscErrorCode ierr;
+  ierr = PetscObjectStateGet((PetscObject)stiffnessMatrix, &stiffnessMatrixState); CHKERRABORT(this->data_->functionSpace()->meshPartition()->mpiCommunicator(), ierr);
+  if (stiffnessMatrixState != setupsStiffnessMatrixState_)
+    return true;
+
+  return this->dirichletBoundaryConditions_->prescribedValuesChangeCounter() != setupsPrescribedValuesChangeCounter_;
+}
+
+template<typename DiscretizableInTimeType>
+void TimeSteppingImplicit<DiscretizableInTimeType>::
+clearTimeStepWidthSetups()
+{
+  LOG(DEBUG) << "discard " << timeStepWidthSetups_.size() << " cached time step width setup(s), because the stiffness matrix or the prescribed values changed";
+
+  // go back to the objects of the first setup, which are the ones that are stored in the data object and the solver manager
+  activateTimeStepWidthSetup(0);
+
+  // if the stiffness matrix was replaced, the system matrix has to be created again, because it was computed by MatMatMult from the old matrix
+  if (this->discretizableInTime_.data().stiffnessMatrix()->valuesGlobal() != setupsStiffnessMatrix_)
+    this->dataImplicit_->setSystemMatrix(nullptr);
+
+  timeStepWidthSetups_.clear();
+  activeTimeStepWidthSetupNo_ = -1;
+
+  // force a complete initialization for the next time step width, also if it is equal to the current one
+  this->initializedTimeStepWidth_ = -1.0;
+}
+
 template<typename DiscretizableInTimeType>
 void TimeSteppingImplicit<DiscretizableInTimeType>::
 initializeWithTimeStepWidth_impl(double timeStepWidth)
@@ -116,6 +290,10 @@ reset()
 {
   TimeSteppingSchemeOdeBaseDiscretizable<DiscretizableInTimeType>::reset();
 
+  // the linear solvers of further cached setups are not stored in the solver manager, only the one of the first setup
+  if (!timeStepWidthSetups_.empty())
+    linearSolver_ = timeStepWidthSetups_[0].linearSolver;
+
   LOG(DEBUG) << "set linearSolver_ to nullptr";
   if (linearSolver_)
   {
@@ -124,6 +302,10 @@ reset()
   }
 
   linearSolver_ = nullptr;
+
+  // clear the cached setups of the time step widths
+  timeStepWidthSetups_.clear();
+  activeTimeStepWidthSetupNo_ = -1;
 }
 
 template<typename DiscretizableInTimeType>
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <sstream>
+#include <cstdint>
 #ifdef __GNUC__
 #include <cxxabi.h>
 #endif
@@ -146,4 +148,19 @@ std::size_t stringLength(std::string string)
   return length;
 }
 
+std::string hash(const std::string &str)
+{
+  // FNV-1a, see http://www.isthe.com/chongo/tech/comp/fnv/
+  uint64_t value = 14695981039346656037ull;   // offset basis
+  for (const char &character : str)
+  {
+    value ^= (unsigned char)character;
+    value *= 1099511628211ull;    // FNV prime
+  }
+
+  std::stringstream s;
+  s << std::hex << std::setw(16) << std::setfill('0') << value;
+  return s.str();
+}
+
 }  // namespace
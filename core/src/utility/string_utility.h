@@ -45,6 +45,9 @@ std::string timeToString(const tm* const time);
 //! return the human readable version of the result of typeid(<class>).name()
 std::string demangle(const char *typeidName);
 
+//! compute a 64 bit FNV-1a hash of the string and return it as 16 hexadecimal digits, the value is the same on every platform and for every run
+std::string hash(const std::string &str);
+
 //! get the correct length of the string, also if it contains utf-8 based unicode charactors, such as λ,γ etc.
 std::size_t stringLength(std::string string);
 
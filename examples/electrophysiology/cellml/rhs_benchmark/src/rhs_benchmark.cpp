@@ -0,0 +1,102 @@
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+#include "opendihu.h"
+
+// Benchmark of the rhs of a CellML model, compares the optimizationType "interpreter" with the compiled "vc" code.
+// For both variants, the time of the setup (code generation and compilation or creation of the bytecode program)
+// and the time of the explicit Euler time steps is measured.
+//
+// usage: ./rhs_benchmark [<modelFilename> [<nInstances> [<nTimeSteps>]]]
+//
+// The model has to have 56 states and 71 algebraics like the default model Shorten 2007, otherwise change the template arguments of CellmlAdapter.
+
+int main(int argc, char *argv[])
+{
+  std::string modelFilename = "../../../input/shorten_ocallaghan_davidson_soboleva_2007.c";
+  int nInstances = 10000;
+  int nTimeSteps = 100;
+
+  if (argc > 1)
+    modelFilename = argv[1];
+  if (argc > 2)
+    nInstances = atoi(argv[2]);
+  if (argc > 3)
+    nTimeSteps = atoi(argv[3]);
+
+  const double dt = 1e-5;
+  std::vector<std::string> optimizationTypes = {"vc", "interpreter"};
+  std::vector<double> durationsSetup, durationsTimeSteps;
+
+  for (std::string optimizationType : optimizationTypes)
+  {
+    // remove libraries of previous runs, such that the compilation is included in the setup time
+    int ret = system("rm -f lib/*.so");
+    if (ret != 0)
+      std::cout << "Could not remove old libraries." << std::endl;
+
+    std::stringstream pythonConfig;
+    pythonConfig << R"(
+config = {
+  "ExplicitEuler": {
+    "timeStepWidth":          )" << dt << R"(,
+    "endTime":                )" << nTimeSteps*dt << R"(,
+    "initialValues":          [],
+    "timeStepOutputInterval": 1e5,
+    "inputMeshIsGlobal":      True,
+    "OutputWriter":           [],
+
+    "CellML": {
+      "nElements":                              )" << nInstances-1 << R"(,
+      "inputMeshIsGlobal":                      True,
+      "modelFilename":                          ")" << modelFilename << R"(",
+      "optimizationType":                       ")" << optimizationType << R"(",
+      "approximateExponentialFunction":         False,
+      "compilerFlags":                          "-fPIC -O3 -march=native -shared ",
+      "initializeStatesToEquilibrium":          False,
+      "parametersUsedAsAlgebraic":              [],
+      "parametersUsedAsConstant":               [],
+      "parametersInitialValues":                [],
+      "statesForTransfer":                      [0],
+      "algebraicsForTransfer":                  [],
+      "parametersForTransfer":                  [],
+    },
+  },
+}
+)";
+
+    DihuContext settings(argc, argv, pythonConfig.str());
+
+    TimeSteppingScheme::ExplicitEuler<
+      CellmlAdapter<56,71>
+    > problem(settings);
+
+    // setup, this generates and compiles the code or creates the bytecode program
+    auto tStart = std::chrono::steady_clock::now();
+    problem.initialize();
+    auto tSetup = std::chrono::steady_clock::now();
+
+    // time steps
+    problem.advanceTimeSpan(false);
+    auto tEnd = std::chrono::steady_clock::now();
+
+    durationsSetup.push_back(std::chrono::duration<double>(tSetup - tStart).count());
+    durationsTimeSteps.push_back(std::chrono::duration<double>(tEnd - tSetup).count());
+  }
+
+  // output results
+  std::cout << std::endl << "model \"" << modelFilename << "\", " << nInstances << " instances, " << nTimeSteps << " time steps" << std::endl
+    << std::setw(18) << "optimizationType" << std::setw(12) << "setup [s]" << std::setw(18) << "time steps [s]"
+    << std::setw(26) << "per instance and step [ns]" << std::endl;
+
+  for (int i = 0; i < optimizationTypes.size(); i++)
+  {
+    std::cout << std::setw(18) << optimizationTypes[i] << std::setw(12) << durationsSetup[i] << std::setw(18) << durationsTimeSteps[i]
+      << std::setw(26) << durationsTimeSteps[i] / nInstances / nTimeSteps * 1e9 << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+
+#include "opendihu.h"
+
+// Benchmark of the quadrature point cache in the HyperelasticitySolver. The residual and the analytic jacobian are evaluated
+// repeatedly for a box mesh, once with the cache of the reference configuration enabled and once with the cache disabled.
+//
+// usage: ./quadrature_point_cache_benchmark [<nElementsPerCoordinateDirection> [<nEvaluations>]]
+
+int main(int argc, char *argv[])
+{
+  int nElementsPerCoordinateDirection = 8;
+  int nEvaluations = 10;
+
+  if (argc > 1)
+    nElementsPerCoordinateDirection = atoi(argv[1]);
+  if (argc > 2)
+    nEvaluations = atoi(argv[2]);
+
+  const int n = nElementsPerCoordinateDirection;
+  std::vector<double> maximumMemories = {512, 0};   // in MB, 0 disables the cache
+  std::vector<double> durationsResidual, durationsJacobian;
+
+  for (double maximumMemory : maximumMemories)
+  {
+    std::stringstream pythonConfig;
+    pythonConfig << R"(
+n = )" << n << R"(
+m = 2*n + 1
+
+# fix the bottom plane
+dirichlet_bc = {j*m + i: [0.0,0.0,0.0] for j in range(m) for i in range(m)}
+
+config = {
+  "HyperelasticitySolver": {
+    "durationLogKey":             "nonlinear",
+    "materialParameters":         [0.0,1.0],
+    "displacementsScalingFactor": 1.0,
+    "constantBodyForce":          [5e-2, 0.0, 0.0],
+    "useAnalyticJacobian":        True,
+    "useNumericJacobian":         False,
+    "dumpDenseMatlabVariables":   False,
+    "quadraturePointCacheMaximumMemory": )" << maximumMemory << R"(,
+
+    "nElements":                  [n, n, n],
+    "inputMeshIsGlobal":          True,
+    "physicalExtent":             [1.0, 1.0, 1.0],
+    "physicalOffset":             [0, 0, 0],
+
+    "relativeTolerance":          1e-5,
+    "absoluteTolerance":          1e-5,
+    "solverType":                 "preonly",
+    "preconditionerType":         "lu",
+    "maxIterations":              1e4,
+    "dumpFilename":               "",
+    "dumpFormat":                 "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations":          15,
+    "snesRelativeTolerance":      1e-5,
+    "snesLineSearchType":         "l2",
+    "snesAbsoluteTolerance":      1e-5,
+    "loadFactorGiveUpThreshold":  0.1,
+    "loadFactors":                [],
+    "nNonlinearSolveCalls":       1,
+
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions":   [],
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+    "dirichletOutputFilename":     None,
+
+    "OutputWriter":   [],
+    "pressure":       {"OutputWriter": []},
+    "LoadIncrements": {"OutputWriter": []},
+  },
+}
+)";
+
+    DihuContext settings(argc, argv, pythonConfig.str());
+
+    SpatialDiscretization::HyperelasticitySolver<> problem(settings);
+    problem.initialize();
+
+    Vec x = problem.combinedVecSolution()->valuesGlobal();
+    Vec f = problem.combinedVecResidual()->valuesGlobal();
+    Mat jacobian = PETSC_NULL;   // not used, the jacobian is assembled in the internal matrix
+
+    // evaluate the residual, the first evaluation fills the cache and is included in the measurement
+    auto tStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < nEvaluations; i++)
+    {
+      problem.evaluateNonlinearFunction(x, f);
+    }
+    auto tResidual = std::chrono::steady_clock::now();
+
+    // evaluate the analytic jacobian
+    for (int i = 0; i < nEvaluations; i++)
+    {
+      problem.evaluateAnalyticJacobian(x, jacobian);
+    }
+    auto tEnd = std::chrono::steady_clock::now();
+
+    durationsResidual.push_back(std::chrono::duration<double>(tResidual - tStart).count());
+    durationsJacobian.push_back(std::chrono::duration<double>(tEnd - tResidual).count());
+  }
+
+  // output results
+  std::cout << std::endl << n << "x" << n << "x" << n << " elements, " << nEvaluations << " evaluations" << std::endl
+    << std::setw(16) << "cache [MB]" << std::setw(16) << "residual [s]" << std::setw(16) << "jacobian [s]" << std::endl;
+
+  for (int i = 0; i < (int)maximumMemories.size(); i++)
+  {
+    std::cout << std::setw(16) << maximumMemories[i] << std::setw(16) << durationsResidual[i] << std::setw(16) << durationsJacobian[i] << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -166,6 +166,127 @@ config = {
   assertFileMatchesContent("out_0000009.py", referenceOutput);
 }
 
+//! read the values of all components of the field variable "solution" from an output file of the PythonFile output writer in ascii format
+static std::vector<double> readSolutionValues(std::string filename)
+{
+  std::ifstream file(filename.c_str());
+  std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  std::vector<double> values;
+  std::size_t position = content.find("\"name\": \"solution\"");
+  const std::string valuesKey = "\"values\": [";
+  while (position != std::string::npos && (position = content.find(valuesKey, position)) != std::string::npos)
+  {
+    position += valuesKey.length();
+    values.push_back(atof(content.c_str() + position));
+  }
+  return values;
+}
+
+TEST(CellMLTest, HodgkinHuxleyInterpreter)
+{
+  std::string pythonConfig = R"(
+
+# timing parameters
+stimulation_frequency = 10.0      # [1/ms] frequency if which stimulation current can be switched on and off
+dt_0D = 5e-5                      # timestep width of ODEs, cellml integration
+
+# CellML Hodgkin-Huxley from cpp file
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1.0,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+
+    "OutputWriter" : [
+      {"format": "PythonFile", "filename": "out", "binary": False, "outputInterval": 1e4}
+    ],
+
+    "CellML" : {
+      "modelFilename": "../input/hodgkin_huxley_1952.c",
+      "optimizationType": "interpreter",
+      "setParametersCallInterval": 1e3,
+      "useGivenLibrary": False,
+      #"statesInitialValues": [-75,  .05, 0.6, 0.325],
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],      # initial values for the parameters: I_Stim
+      #"setParametersFunction": set_parameters,    # callback function that sets parameters like stimulation current
+      #"setParametersCallInterval": 1./stimulation_frequency/dt_0D,     # set_parameters should be called every 0.1, 5e-5 * 1e3 = 5e-2 = 0.05
+
+      "parametersUsedAsAlgebraic": [],       # list of algebraic value indices, that will be set by parameters. Explicitely defined parameters that will be copied to algebraics, this vector contains the indices of the algebraic array. This is ignored if the input is generated from OpenCMISS generated c code.
+      "parametersUsedAsConstant": [2],           # list of constant value indices, that will be set by parameters. This is ignored if the input is generated from OpenCMISS generated c code.
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.run();
+
+  // compare with the solution of the compiled code, which is the same as in the test HodgkinHuxleySimd.
+  // The interpreter computes integer powers by repeated multiplication instead of std::pow, the rounding differences of the
+  // last bits accumulate over the 90000 time steps. Therefore, the values are compared with a relative tolerance that is
+  // large compared to these rounding differences, but still small enough to detect a single wrong operation in the program.
+  std::vector<double> referenceSolution = {36.18142823585638, 0.9987345768519429, 0.2446134695357078, 0.5789949501440312};
+  std::vector<double> solution = readSolutionValues("out_0000009.py");
+  const double relativeTolerance = 1e-8;
+
+  ASSERT_EQ(solution.size(), referenceSolution.size());
+  for (int i = 0; i < (int)referenceSolution.size(); i++)
+  {
+    EXPECT_NEAR(solution[i], referenceSolution[i], relativeTolerance*fabs(referenceSolution[i])) << "state " << i;
+  }
+}
+
+TEST(CellMLTest, HodgkinHuxleyGatingStates)
+{
+  std::string pythonConfig = R"(
+
+# CellML Hodgkin-Huxley from cpp file
+config = {
+  "ExplicitEuler" : {
+    "timeStepWidth": 1e-5,
+    "endTime" : 1e-4,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e5,
+    "OutputWriter" : [],
+
+    "CellML" : {
+      "modelFilename": "../input/hodgkin_huxley_1952.c",
+      "optimizationType": "interpreter",
+      "gatingVariablesScheme": "rushLarsen",
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [400.0],
+      "parametersUsedAsAlgebraic": [],
+      "parametersUsedAsConstant": [2],
+    },
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    CellmlAdapter<4>
+  > problem(settings);
+
+  problem.initialize();
+
+  // the gating variables m, h and n have rates of the form alpha*(1-y) - beta*y, the membrane voltage is excluded
+  CellmlAdapter<4> &cellmlAdapter = problem.discretizableInTime();
+  ASSERT_EQ(cellmlAdapter.gatingVariablesScheme(), "rushLarsen");
+
+  std::vector<int> gatingStates = cellmlAdapter.cellmlSourceCodeGenerator().findGatingStates();
+  std::vector<int> referenceGatingStates = {1, 2, 3};
+  ASSERT_EQ(gatingStates, referenceGatingStates);
+}
+
 TEST(CellMLTest, ShortenOpenCOR)
 {
   std::string pythonConfig = R"(
@@ -669,4 +790,95 @@ print("gpu avg error: {}".format(total_error))
   LOG(DEBUG) << "error between not_fast and fast_gpu: " << error;
 
   ASSERT_LE(error, 1.35);
+
+  // check the Rush-Larsen scheme for the gating variables in the vc code, the reference is the Heun scheme for all states in problem1
+
+  strToReplace = "out/fast_gpu/fibers";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "out/fast_vc_rush_larsen/fibers");
+
+  strToReplace = "\"gpu\",";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "\"vc\", \"gatingVariablesScheme\": \"rushLarsen\",");
+
+  DihuContext settings4(argc, argv, pythonConfig);
+
+  // define problem with FastMonodomainSolver
+  TimeSteppingScheme::RepeatedCall<
+    FastMonodomainSolver<                        // a wrapper that improves performance of multidomain
+      Control::MultipleInstances<                       // fibers
+        OperatorSplitting::Strang<
+          Control::MultipleInstances<
+            TimeSteppingScheme::Heun<                   // fiber reaction term
+              CellmlAdapter<
+                4, 9,  // nStates,nAlgebraics: 57,1 = Shorten, 4,9 = Hodgkin Huxley
+                FunctionSpace::FunctionSpace<
+                  Mesh::StructuredDeformableOfDimension<1>,
+                  BasisFunction::LagrangeOfOrder<1>
+                >
+              >
+            >
+          >,
+          Control::MultipleInstances<
+            TimeSteppingScheme::ImplicitEuler<          // fiber diffusion, note that implicit euler gives lower error in this case than crank nicolson
+              SpatialDiscretization::FiniteElementMethod<
+                Mesh::StructuredDeformableOfDimension<1>,
+                BasisFunction::LagrangeOfOrder<1>,
+                Quadrature::Gauss<2>,
+                Equation::Dynamic::IsotropicDiffusion
+              >
+            >
+          >
+        >
+      >
+    >
+  > problem4(settings4);
+
+  // run problem
+  problem4.run();
+
+  // compare results of problem1 and problem4, the same script as for the vc code
+  command = R"(
+import sys, os
+import py_reader
+import numpy as np
+
+directory1 = "out/fast_vc_rush_larsen"
+directory2 = "out/not_fast"
+
+files1 = sorted([os.path.join(directory1, filename) for filename in os.listdir(directory1) if filename.endswith(".py")])
+files2 = sorted([os.path.join(directory2, filename) for filename in os.listdir(directory2) if filename.endswith(".py")])
+
+data1 = py_reader.load_data(files1)
+data2 = py_reader.load_data(files2)
+
+n_values = min(len(data1), len(data2))
+
+component_name = "0"
+total_error = 0
+for i in range(n_values):
+  values1 = py_reader.get_values(data1[i], "solution", component_name)
+  values2 = py_reader.get_values(data2[i], "solution", component_name)
+
+  error = np.linalg.norm(values1-values2) / np.size(values1);
+  total_error += error
+
+  print("Rush-Larsen file no. {}, error: {}".format(i, error))
+
+total_error /= n_values
+print("Rush-Larsen avg error: {}".format(total_error))
+
+)";
+  returnValue = PyRun_SimpleString(command.c_str());
+  PythonUtility::checkForError();
+  ASSERT_EQ(returnValue, 0);
+
+  mainModule = PyImport_AddModule("__main__");
+  totalError = PyObject_GetAttrString(mainModule, "total_error");
+
+  error = PythonUtility::convertFromPython<double>::get(totalError);
+  LOG(DEBUG) << "error between not_fast and fast_vc_rush_larsen: " << error;
+
+  // the Rush-Larsen scheme is exact for the gating variables at constant membrane voltage, it has to be as accurate as the Heun scheme of the vc code
+  ASSERT_LE(error, 0.1);
 }
@@ -152,6 +152,120 @@ config = {
 
 }
 
+// the cached system matrices for alternating time step widths give the same result as the computation without cache
+TEST(DiffusionTest, ImplicitEulerCachedTimeStepWidths)
+{
+  std::string pythonConfig = R"(
+
+# Diffusion 1D
+n = 5
+config = {
+  "ImplicitEuler" : {
+    "initialValues": [2,2,4,5,2,2],
+    "numberTimeSteps": 1,
+    "endTime": 0.1,
+    "nCachedTimeStepWidths": N_CACHED_TIME_STEP_WIDTHS,
+    "dirichletBoundaryConditions": {0: 2.0},
+    "FiniteElementMethod" : {
+      "nElements": n,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+    },
+  },
+}
+)";
+
+  typedef TimeSteppingScheme::ImplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<1>,
+      BasisFunction::LagrangeOfOrder<>,
+      Quadrature::None,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > ProblemType;
+
+  // the counters of the performance measurement are accumulated over all tests, therefore only the increments are considered
+  auto getCounters = [](int &nSetups, int &nSetupsReused)
+  {
+    nSetups = Control::PerformanceMeasurement::getNumber("ImplicitEuler_nTimeStepWidthSetups");
+    nSetupsReused = Control::PerformanceMeasurement::getNumber("ImplicitEuler_nTimeStepWidthSetupsReused");
+  };
+
+  // run with alternating time step widths, then change the prescribed value and run again,
+  // store the final solution and the number of computed and reused setups before and after the change of the prescribed value
+  auto computeSolution = [&](std::string nCachedTimeStepWidths, std::vector<double> &solution,
+                             std::array<int,2> &nSetups, std::array<int,2> &nSetupsReused)
+  {
+    std::string config = pythonConfig;
+    std::string strToReplace("N_CACHED_TIME_STEP_WIDTHS");
+    std::size_t pos = config.find(strToReplace);
+    config.replace(pos, strToReplace.length(), nCachedTimeStepWidths);
+
+    DihuContext settings(argc, argv, config);
+    ProblemType problem(settings);
+    problem.initialize();
+
+    int nSetupsBegin, nSetupsReusedBegin;
+    getCounters(nSetupsBegin, nSetupsReusedBegin);
+
+    double currentTime = 0.0;
+    auto advanceAlternating = [&](int nTimeSpans)
+    {
+      for (int timeSpanNo = 0; timeSpanNo < nTimeSpans; timeSpanNo++)
+      {
+        double timeStepWidth = (timeSpanNo % 2 == 0? 0.01 : 0.025);
+        problem.setTimeSpan(currentTime, currentTime + timeStepWidth);
+        problem.advanceTimeSpan();
+        currentTime += timeStepWidth;
+      }
+    };
+
+    advanceAlternating(6);
+    getCounters(nSetups[0], nSetupsReused[0]);
+    nSetups[0] -= nSetupsBegin;
+    nSetupsReused[0] -= nSetupsReusedBegin;
+
+    // change the prescribed value, the cached setups contain the rhs summand of the old value and have to be discarded
+    problem.data().solution()->setValue(0, 3.0, INSERT_VALUES);
+    problem.data().solution()->zeroGhostBuffer();
+    problem.data().solution()->finishGhostManipulation();
+    problem.data().solution()->startGhostManipulation();
+    problem.dirichletBoundaryConditions()->updatePrescribedValuesFromSolution(problem.data().solution());
+
+    advanceAlternating(2);
+    getCounters(nSetups[1], nSetupsReused[1]);
+    nSetups[1] -= nSetupsBegin;
+    nSetupsReused[1] -= nSetupsReusedBegin;
+
+    problem.data().solution()->getValuesWithoutGhosts(0, solution);
+  };
+
+  std::vector<double> solutionCached, solutionUncached;
+  std::array<int,2> nSetupsCached, nSetupsReusedCached, nSetupsUncached, nSetupsReusedUncached;
+  computeSolution("2", solutionCached, nSetupsCached, nSetupsReusedCached);
+  computeSolution("1", solutionUncached, nSetupsUncached, nSetupsReusedUncached);
+
+  // with the cache, only the first occurence of each time step width needs a setup
+  EXPECT_EQ(nSetupsCached[0], 2);
+  EXPECT_EQ(nSetupsReusedCached[0], 4);
+  EXPECT_EQ(nSetupsUncached[0], 6);
+  EXPECT_EQ(nSetupsReusedUncached[0], 0);
+
+  // after the change of the prescribed value, the setups are computed again
+  EXPECT_EQ(nSetupsCached[1], 4);
+  EXPECT_EQ(nSetupsReusedCached[1], 4);
+  EXPECT_EQ(nSetupsUncached[1], 8);
+  EXPECT_EQ(nSetupsReusedUncached[1], 0);
+
+  ASSERT_EQ(solutionCached.size(), solutionUncached.size());
+  EXPECT_NEAR(solutionCached[0], 3.0, 1e-12);
+  for (int dofNo = 0; dofNo < solutionCached.size(); dofNo++)
+  {
+    EXPECT_NEAR(solutionCached[dofNo], solutionUncached[dofNo], 1e-12) << "dof " << dofNo;
+  }
+}
+
 /*
  * this test is disabled, because it required LAPACK which is not default
 TEST(DiffusionTest, ImplicitEuler1DPOD)
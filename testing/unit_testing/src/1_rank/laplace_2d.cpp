@@ -42,6 +42,17 @@ config = {
     "dirichletBoundaryConditions": bc,
     "relativeTolerance": 1e-15,
   },
+  "WithoutBoundaryConditions": {
+    "FiniteElementMethod" : {
+      "meshName": "mesh",
+      "reuseAssembledMatrices": True,
+      "dirichletBoundaryConditions": {},
+      "prefactor": 1.5,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "relativeTolerance": 1e-15,
+    },
+  },
 }
 )";
 
@@ -92,6 +103,17 @@ config = {
     "physicalExtent": [4.0, 4.0],
     "relativeTolerance": 1e-15,
   },
+  "WithoutBoundaryConditions": {
+    "FiniteElementMethod" : {
+      "meshName": "mesh",
+      "reuseAssembledMatrices": True,
+      "dirichletBoundaryConditions": {},
+      "prefactor": 1.5,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "relativeTolerance": 1e-15,
+    },
+  },
 }
 )";
 
@@ -170,6 +192,17 @@ config = {
     "physicalExtent": [4.0, 4.0],
     "relativeTolerance": 1e-15,
   },
+  "WithoutBoundaryConditions": {
+    "FiniteElementMethod" : {
+      "meshName": "mesh",
+      "reuseAssembledMatrices": True,
+      "dirichletBoundaryConditions": {},
+      "prefactor": 1.5,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "relativeTolerance": 1e-15,
+    },
+  },
 }
 )";
 
@@ -237,5 +270,143 @@ config = {
 }
 
 
+TEST(LaplaceTest, MatrixFreeOperatorEqualsAssembledMatrix)
+{
+  std::string pythonConfig = R"(
+# Laplace 2D, quadratic elements on a deformed mesh, with Dirichlet boundary conditions
+import numpy as np
+nx = 4
+ny = 3
+
+# node positions of the quadratic mesh with (2*nx+1) x (2*ny+1) nodes, slightly distorted
+node_positions = []
+for j in range(2*ny+1):
+  for i in range(2*nx+1):
+    node_positions.append([i/2. + 0.05*np.sin(j), j/2. + 0.05*np.cos(i), 0.0])
+
+bc = {0: 1.0, 1: 2.0, 2: 3.0}
+
+config = {
+  "FiniteElementMethod" : {
+    "nElements": [nx, ny],
+    "nodePositions": node_positions,
+    "inputMeshIsGlobal": True,
+    "dirichletBoundaryConditions": bc,
+    "prefactor": 1.5,
+    "matrixFree": MATRIX_FREE,
+    "solverType": "gmres",
+    "preconditionerType": "jacobi",
+    "relativeTolerance": 1e-15,
+  },
+}
+)";
+
+  typedef FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<2>,
+    Quadrature::Gauss<3>,
+    Equation::Static::Laplace
+  > FiniteElementMethodType;
+
+  std::string pythonConfigMatrixFree = pythonConfig;
+  pythonConfigMatrixFree.replace(pythonConfigMatrixFree.find("MATRIX_FREE"), std::string("MATRIX_FREE").length(), "True");
+  pythonConfig.replace(pythonConfig.find("MATRIX_FREE"), std::string("MATRIX_FREE").length(), "False");
+
+  DihuContext settingsMatrixFree(argc, argv, pythonConfigMatrixFree);
+  FiniteElementMethodType finiteElementMethodMatrixFree(settingsMatrixFree);
+  finiteElementMethodMatrixFree.initialize();
+
+  DihuContext settingsAssembled(argc, argv, pythonConfig);
+  FiniteElementMethodType finiteElementMethodAssembled(settingsAssembled);
+  finiteElementMethodAssembled.initialize();
+
+  StiffnessMatrixTester::compareMatrixFreeOperator(finiteElementMethodMatrixFree, finiteElementMethodAssembled);
+}
+
+TEST(LaplaceTest, SharedStiffnessMatrixGivesSameSolution)
+{
+  std::string pythonConfig = R"(
+# Laplace 2D, two objects on the same mesh that share the assembled stiffness matrix
+bc = {0: 1.0, 1: 2.0, 2: 3.0, 19: -1.0}
+
+config = {
+  "Meshes": {
+    "mesh": {
+      "nElements": [4, 3],
+      "physicalExtent": [4.0, 3.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "FiniteElementMethod" : {
+    "meshName": "mesh",
+    "reuseAssembledMatrices": True,
+    "dirichletBoundaryConditions": bc,
+    "prefactor": 1.5,
+    "solverType": "gmres",
+    "preconditionerType": "none",
+    "relativeTolerance": 1e-15,
+  },
+  "WithoutBoundaryConditions": {
+    "FiniteElementMethod" : {
+      "meshName": "mesh",
+      "reuseAssembledMatrices": True,
+      "dirichletBoundaryConditions": {},
+      "prefactor": 1.5,
+      "solverType": "gmres",
+      "preconditionerType": "none",
+      "relativeTolerance": 1e-15,
+    },
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > FiniteElementMethodType;
+
+  // the first object assembles the stiffness matrix, the second one reuses it
+  FiniteElementMethodType finiteElementMethod1(settings);
+  finiteElementMethod1.run();
+
+  FiniteElementMethodType finiteElementMethod2(settings);
+  finiteElementMethod2.run();
+
+  EXPECT_EQ(finiteElementMethod1.data().stiffnessMatrixWithoutBc(), finiteElementMethod2.data().stiffnessMatrixWithoutBc());
+
+  // each object has its own system matrix with the boundary conditions
+  EXPECT_NE(finiteElementMethod1.data().stiffnessMatrix()->valuesGlobal(), finiteElementMethod2.data().stiffnessMatrix()->valuesGlobal());
+
+  StiffnessMatrixTester::checkEqual(finiteElementMethod1, finiteElementMethod2);
+
+  std::vector<double> solution1;
+  PetscUtility::getVectorEntries(finiteElementMethod1.data().solution()->valuesLocal(), solution1);
+  StiffnessMatrixTester::compareSolution(finiteElementMethod2, solution1, 1e-12);
+
+  std::map<int, double> dirichletBC = {{0, 1.0}, {1, 2.0}, {2, 3.0}, {19, -1.0}};
+  StiffnessMatrixTester::checkDirichletBCInSolution(finiteElementMethod2, dirichletBC);
+
+  // after the geometry of the mesh has changed, a new object assembles its own stiffness matrix
+  settings.meshManager()->invalidateAssembledMatrices("mesh");
+
+  FiniteElementMethodType finiteElementMethod3(settings);
+  finiteElementMethod3.run();
+
+  EXPECT_NE(finiteElementMethod1.data().stiffnessMatrixWithoutBc(), finiteElementMethod3.data().stiffnessMatrixWithoutBc());
+  StiffnessMatrixTester::compareSolution(finiteElementMethod3, solution1, 1e-12);
+
+  // an object without Dirichlet boundary conditions uses the shared matrix as system matrix and does not create a copy
+  FiniteElementMethodType finiteElementMethod4(settings["WithoutBoundaryConditions"]);
+  finiteElementMethod4.initialize();
+
+  EXPECT_TRUE(finiteElementMethod4.data().stiffnessMatrixIsShared());
+  EXPECT_EQ(finiteElementMethod4.data().stiffnessMatrix(), finiteElementMethod3.data().stiffnessMatrixWithoutBc());
+  EXPECT_FALSE(finiteElementMethod3.data().stiffnessMatrixIsShared());
+}
+
 }  // namespace
 
@@ -0,0 +1,344 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+#include "../utility.h"
+
+namespace
+{
+typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>> FiberFunctionSpaceType;
+typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>,BasisFunction::LagrangeOfOrder<1>> BoxFunctionSpaceType;
+typedef MappingBetweenMeshes::MappingBetweenMeshes<FiberFunctionSpaceType,BoxFunctionSpaceType> MappingType;
+
+// a fiber along the z axis inside a box of 2x2x2 elements, the fiber nodes do not lie on element boundaries,
+// and a finer box of 5x5x5 elements, in which most dofs get no value from the nodes of the coarse box and have to be fixed by fixUnmappedDofs
+const std::string pythonConfigMeshes = R"(
+config = {
+  "Meshes": {
+    "fiber": {
+      "nElements": [3],
+      "nodePositions": [[0.45, 0.3, 0.1], [0.45, 0.3, 0.3], [0.45, 0.3, 0.7], [0.45, 0.3, 0.9]],
+      "inputMeshIsGlobal": True,
+    },
+    "box": {
+      "nElements": [2, 2, 2],
+      "physicalExtent": [1.0, 1.0, 1.0],
+      "physicalOffset": [0.0, 0.0, 0.0],
+      "inputMeshIsGlobal": True,
+    },
+    "fineBox": {
+      "nElements": [5, 5, 5],
+      "physicalExtent": [1.0, 1.0, 1.0],
+      "physicalOffset": [0.0, 0.0, 0.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+}
+)";
+
+// compress the box in x direction by the factor 0.8, such that the fiber moves from the first to the second layer of elements
+void compressBox(std::shared_ptr<BoxFunctionSpaceType> functionSpace)
+{
+  std::vector<Vec3> positions;
+  functionSpace->geometryField().getValuesWithoutGhosts(positions);
+
+  for (Vec3 &position : positions)
+  {
+    position[0] *= 0.8;
+  }
+
+  functionSpace->geometryField().setValuesWithoutGhosts(positions);
+  functionSpace->geometryField().startGhostManipulation();
+  functionSpace->geometryField().finishGhostManipulation();
+}
+
+// check that two mappings have the same target elements and scaling factors for all source dofs
+void compareMappings(const MappingType &mapping, const MappingType &referenceMapping)
+{
+  ASSERT_EQ(mapping.targetMappingInfo().size(), referenceMapping.targetMappingInfo().size());
+
+  for (int sourceDofNoLocal = 0; sourceDofNoLocal < (int)mapping.targetMappingInfo().size(); sourceDofNoLocal++)
+  {
+    const auto &targetMappingInfo = mapping.targetMappingInfo()[sourceDofNoLocal];
+    const auto &referenceTargetMappingInfo = referenceMapping.targetMappingInfo()[sourceDofNoLocal];
+
+    ASSERT_EQ(targetMappingInfo.mapThisDof, referenceTargetMappingInfo.mapThisDof) << "source dof " << sourceDofNoLocal;
+    ASSERT_EQ(targetMappingInfo.targetElements.size(), referenceTargetMappingInfo.targetElements.size()) << "source dof " << sourceDofNoLocal;
+
+    for (int i = 0; i < (int)targetMappingInfo.targetElements.size(); i++)
+    {
+      EXPECT_EQ(targetMappingInfo.targetElements[i].elementNoLocal, referenceTargetMappingInfo.targetElements[i].elementNoLocal)
+        << "source dof " << sourceDofNoLocal << ", target element " << i;
+
+      for (int dofIndex = 0; dofIndex < BoxFunctionSpaceType::nDofsPerElement(); dofIndex++)
+      {
+        EXPECT_NEAR(targetMappingInfo.targetElements[i].scalingFactors[dofIndex], referenceTargetMappingInfo.targetElements[i].scalingFactors[dofIndex], 1e-10)
+          << "source dof " << sourceDofNoLocal << ", target element " << i << ", dof " << dofIndex;
+      }
+    }
+  }
+}
+
+// values of a smooth function at the given positions
+void evaluateTestFunction(const std::vector<Vec3> &positions, std::vector<Vec3> &values)
+{
+  values.resize(positions.size());
+  for (int i = 0; i < (int)positions.size(); i++)
+  {
+    const Vec3 &x = positions[i];
+    values[i] = Vec3({1.0 + x[0] + 2*x[1], x[1]*x[2], sin(x[2])});
+  }
+}
+
+// the previous implementation of mapLowToHighDimension, which adds the scaled source values element by element,
+// the values are not yet divided by the factor sums
+template<typename MappingType, typename FunctionSpaceTargetType>
+void referenceMapLowToHigh(const MappingType &mapping, std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
+                           const std::vector<Vec3> &sourceValues, std::vector<Vec3> &targetValues, std::vector<double> &targetFactorSums)
+{
+  targetValues.assign(functionSpaceTarget->nDofsLocalWithGhosts(), Vec3({0.0, 0.0, 0.0}));
+  targetFactorSums.assign(functionSpaceTarget->nDofsLocalWithGhosts(), 0.0);
+
+  for (int sourceDofNoLocal = 0; sourceDofNoLocal < (int)sourceValues.size(); sourceDofNoLocal++)
+  {
+    if (!mapping.targetMappingInfo()[sourceDofNoLocal].mapThisDof)
+      continue;
+
+    for (const auto &targetElement : mapping.targetMappingInfo()[sourceDofNoLocal].targetElements)
+    {
+      for (int dofIndex = 0; dofIndex < FunctionSpaceTargetType::nDofsPerElement(); dofIndex++)
+      {
+        dof_no_t targetDofNoLocal = functionSpaceTarget->getDofNo(targetElement.elementNoLocal, dofIndex);
+        for (int componentNo = 0; componentNo < 3; componentNo++)
+        {
+          targetValues[targetDofNoLocal][componentNo] += targetElement.scalingFactors[dofIndex] * sourceValues[sourceDofNoLocal][componentNo];
+        }
+        targetFactorSums[targetDofNoLocal] += targetElement.scalingFactors[dofIndex];
+      }
+    }
+  }
+}
+
+// the previous implementation of mapHighToLowDimension, which interpolates in the first target element of every mapped dof of the lower dimensional mesh
+template<typename MappingType, typename FunctionSpaceTargetType>
+void referenceMapHighToLow(const MappingType &mapping, std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
+                           const std::vector<Vec3> &targetValues, std::vector<Vec3> &sourceValues, std::vector<bool> &isMapped)
+{
+  sourceValues.assign(mapping.targetMappingInfo().size(), Vec3({0.0, 0.0, 0.0}));
+  isMapped.assign(mapping.targetMappingInfo().size(), false);
+
+  for (int sourceDofNoLocal = 0; sourceDofNoLocal < (int)sourceValues.size(); sourceDofNoLocal++)
+  {
+    if (!mapping.targetMappingInfo()[sourceDofNoLocal].mapThisDof)
+      continue;
+
+    const auto &targetElement = mapping.targetMappingInfo()[sourceDofNoLocal].targetElements[0];
+    for (int dofIndex = 0; dofIndex < FunctionSpaceTargetType::nDofsPerElement(); dofIndex++)
+    {
+      dof_no_t targetDofNoLocal = functionSpaceTarget->getDofNo(targetElement.elementNoLocal, dofIndex);
+      for (int componentNo = 0; componentNo < 3; componentNo++)
+      {
+        sourceValues[sourceDofNoLocal][componentNo] += targetElement.scalingFactors[dofIndex] * targetValues[targetDofNoLocal][componentNo];
+      }
+    }
+    isMapped[sourceDofNoLocal] = true;
+  }
+}
+
+// map a smooth function in both directions with all components and with single components and compare the results to the previous implementation
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void compareMappingToReference(std::shared_ptr<FunctionSpaceSourceType> functionSpaceSource, std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget,
+                               MappingBetweenMeshes::MappingBetweenMeshes<FunctionSpaceSourceType,FunctionSpaceTargetType> &mapping)
+{
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceSourceType,3>> fieldVariableSource = functionSpaceSource->template createFieldVariable<3>("source");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceTargetType,3>> fieldVariableTarget = functionSpaceTarget->template createFieldVariable<3>("target");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceTargetType,1>> targetFactorSum = functionSpaceTarget->template createFieldVariable<1>("targetFactorSum");
+
+  const int nDofsLocalSource = functionSpaceSource->nDofsLocalWithoutGhosts();
+  const int nDofsLocalTarget = functionSpaceTarget->nDofsLocalWithoutGhosts();
+
+  // low to high, all components
+  std::vector<Vec3> sourcePositions, sourceValues;
+  functionSpaceSource->geometryField().getValuesWithoutGhosts(sourcePositions);
+  evaluateTestFunction(sourcePositions, sourceValues);
+
+  fieldVariableSource->setValuesWithoutGhosts(sourceValues);
+  fieldVariableSource->startGhostManipulation();
+  fieldVariableSource->finishGhostManipulation();
+
+  fieldVariableTarget->zeroEntries();
+  fieldVariableTarget->zeroGhostBuffer();
+  targetFactorSum->zeroEntries();
+  targetFactorSum->zeroGhostBuffer();
+
+  mapping.mapLowToHighDimension(*fieldVariableSource, *fieldVariableTarget, *targetFactorSum);
+
+  fieldVariableTarget->finishGhostManipulation();
+  targetFactorSum->finishGhostManipulation();
+
+  std::vector<Vec3> referenceTargetValues;
+  std::vector<double> referenceTargetFactorSums;
+  referenceMapLowToHigh(mapping, functionSpaceTarget, sourceValues, referenceTargetValues, referenceTargetFactorSums);
+
+  std::vector<Vec3> targetValues;
+  std::vector<double> targetFactorSums;
+  fieldVariableTarget->getValuesWithoutGhosts(targetValues);
+  targetFactorSum->getValuesWithoutGhosts(targetFactorSums);
+
+  for (int targetDofNoLocal = 0; targetDofNoLocal < nDofsLocalTarget; targetDofNoLocal++)
+  {
+    EXPECT_NEAR(targetFactorSums[targetDofNoLocal], referenceTargetFactorSums[targetDofNoLocal], 1e-12) << "target dof " << targetDofNoLocal;
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(targetValues[targetDofNoLocal][componentNo], referenceTargetValues[targetDofNoLocal][componentNo], 1e-12)
+        << "low to high, target dof " << targetDofNoLocal << ", component " << componentNo;
+    }
+  }
+
+  // low to high, single component 2 of the source to component 0 of the target
+  fieldVariableTarget->zeroEntries();
+  fieldVariableTarget->zeroGhostBuffer();
+  targetFactorSum->zeroEntries();
+  targetFactorSum->zeroGhostBuffer();
+
+  mapping.mapLowToHighDimension(*fieldVariableSource, 2, *fieldVariableTarget, 0, *targetFactorSum);
+
+  fieldVariableTarget->finishGhostManipulation();
+  targetFactorSum->finishGhostManipulation();
+
+  std::vector<double> targetComponentValues;
+  fieldVariableTarget->getValuesWithoutGhosts(0, targetComponentValues);
+  targetFactorSum->getValuesWithoutGhosts(targetFactorSums);
+
+  for (int targetDofNoLocal = 0; targetDofNoLocal < nDofsLocalTarget; targetDofNoLocal++)
+  {
+    EXPECT_NEAR(targetFactorSums[targetDofNoLocal], referenceTargetFactorSums[targetDofNoLocal], 1e-12) << "target dof " << targetDofNoLocal;
+    EXPECT_NEAR(targetComponentValues[targetDofNoLocal], referenceTargetValues[targetDofNoLocal][2], 1e-12)
+      << "low to high single component, target dof " << targetDofNoLocal;
+  }
+
+  // high to low, all components
+  std::vector<Vec3> targetPositions;
+  functionSpaceTarget->geometryField().getValuesWithoutGhosts(targetPositions);
+  evaluateTestFunction(targetPositions, targetValues);
+
+  fieldVariableTarget->setValuesWithoutGhosts(targetValues);
+  fieldVariableTarget->startGhostManipulation();
+  fieldVariableTarget->finishGhostManipulation();
+
+  fieldVariableSource->zeroEntries();
+  mapping.mapHighToLowDimension(*fieldVariableTarget, *fieldVariableSource);
+  fieldVariableSource->finishGhostManipulation();
+
+  std::vector<Vec3> referenceSourceValues;
+  std::vector<bool> isMapped;
+  referenceMapHighToLow(mapping, functionSpaceTarget, targetValues, referenceSourceValues, isMapped);
+
+  fieldVariableSource->getValuesWithoutGhosts(sourceValues);
+  for (int sourceDofNoLocal = 0; sourceDofNoLocal < nDofsLocalSource; sourceDofNoLocal++)
+  {
+    if (!isMapped[sourceDofNoLocal])
+      continue;
+
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(sourceValues[sourceDofNoLocal][componentNo], referenceSourceValues[sourceDofNoLocal][componentNo], 1e-10)
+        << "high to low, source dof " << sourceDofNoLocal << ", component " << componentNo;
+    }
+  }
+
+  // high to low, single component 1 of the target to component 0 of the source
+  fieldVariableSource->zeroEntries();
+  mapping.mapHighToLowDimension(*fieldVariableTarget, 1, *fieldVariableSource, 0);
+  fieldVariableSource->finishGhostManipulation();
+
+  std::vector<double> sourceComponentValues;
+  fieldVariableSource->getValuesWithoutGhosts(0, sourceComponentValues);
+  for (int sourceDofNoLocal = 0; sourceDofNoLocal < nDofsLocalSource; sourceDofNoLocal++)
+  {
+    if (!isMapped[sourceDofNoLocal])
+      continue;
+
+    EXPECT_NEAR(sourceComponentValues[sourceDofNoLocal], referenceSourceValues[sourceDofNoLocal][1], 1e-10)
+      << "high to low single component, source dof " << sourceDofNoLocal;
+  }
+}
+}  // namespace
+
+TEST(MappingBetweenMeshesTest, UpdateMappingAfterDeformationEqualsNewMapping)
+{
+  DihuContext settings(argc, argv, pythonConfigMeshes);
+
+  std::shared_ptr<FiberFunctionSpaceType> fiberFunctionSpace = settings.meshManager()->functionSpace<FiberFunctionSpaceType>("fiber");
+  std::shared_ptr<BoxFunctionSpaceType> boxFunctionSpace = settings.meshManager()->functionSpace<BoxFunctionSpaceType>("box");
+
+  MappingType mapping(fiberFunctionSpace, boxFunctionSpace);
+
+  // initially all fiber nodes are in the first layer of elements in x direction
+  for (const auto &targetMappingInfo : mapping.targetMappingInfo())
+  {
+    ASSERT_TRUE(targetMappingInfo.mapThisDof);
+    EXPECT_EQ(targetMappingInfo.targetElements[0].elementNoLocal % 2, 0);
+  }
+
+  // deform the box and update the mapping, every fiber node is relocated
+  compressBox(boxFunctionSpace);
+  int nRelocatedSourceDofs = mapping.updateMapping();
+  EXPECT_EQ(nRelocatedSourceDofs, fiberFunctionSpace->nDofsLocalWithoutGhosts());
+
+  for (const auto &targetMappingInfo : mapping.targetMappingInfo())
+  {
+    EXPECT_EQ(targetMappingInfo.targetElements[0].elementNoLocal % 2, 1);
+  }
+
+  // the updated mapping has to be the same as a mapping that is created for the deformed box
+  MappingType referenceMapping(fiberFunctionSpace, boxFunctionSpace);
+  compareMappings(mapping, referenceMapping);
+
+  // a second update without deformation does not change anything
+  EXPECT_EQ(mapping.updateMapping(), 0);
+  compareMappings(mapping, referenceMapping);
+}
+
+TEST(MappingBetweenMeshesTest, InterpolationMatrixEqualsPerElementMapping)
+{
+  DihuContext settings(argc, argv, pythonConfigMeshes);
+
+  std::shared_ptr<FiberFunctionSpaceType> fiberFunctionSpace = settings.meshManager()->functionSpace<FiberFunctionSpaceType>("fiber");
+  std::shared_ptr<BoxFunctionSpaceType> boxFunctionSpace = settings.meshManager()->functionSpace<BoxFunctionSpaceType>("box");
+
+  MappingType mapping(fiberFunctionSpace, boxFunctionSpace);
+  compareMappingToReference(fiberFunctionSpace, boxFunctionSpace, mapping);
+
+  // the interpolation matrices are assembled again after an update of the mapping
+  compressBox(boxFunctionSpace);
+  mapping.updateMapping();
+  compareMappingToReference(fiberFunctionSpace, boxFunctionSpace, mapping);
+}
+
+TEST(MappingBetweenMeshesTest, InterpolationMatrixEqualsPerElementMappingWithFixedUnmappedDofs)
+{
+  DihuContext settings(argc, argv, pythonConfigMeshes);
+
+  std::shared_ptr<BoxFunctionSpaceType> boxFunctionSpace = settings.meshManager()->functionSpace<BoxFunctionSpaceType>("box");
+  std::shared_ptr<BoxFunctionSpaceType> fineBoxFunctionSpace = settings.meshManager()->functionSpace<BoxFunctionSpaceType>("fineBox");
+
+  // map from the coarse to the fine box, the nodes of the coarse box only contribute to few nodes of the fine box
+  MappingBetweenMeshes::MappingBetweenMeshes<BoxFunctionSpaceType,BoxFunctionSpaceType> mapping(boxFunctionSpace, fineBoxFunctionSpace);
+
+  // check that the target elements that were added by fixUnmappedDofs are present, otherwise the test would not cover them
+  int nAddedTargetElements = 0;
+  for (const auto &targetMappingInfo : mapping.targetMappingInfo())
+  {
+    nAddedTargetElements += (int)targetMappingInfo.targetElements.size() - 1;
+  }
+  ASSERT_GT(nAddedTargetElements, 0);
+
+  compareMappingToReference(boxFunctionSpace, fineBoxFunctionSpace, mapping);
+}
@@ -9,6 +9,7 @@
 #include "arg.h"
 #include "stiffness_matrix_tester.h"
 #include "node_positions_tester.h"
+#include "mesh/spatial_index/element_grid_index.h"
 
 namespace SpatialDiscretization
 {
@@ -229,4 +230,55 @@ config = {
   
 }
 
+TEST(MeshTest, ElementGridIndexFindsElements)
+{
+  // 4x4 grid of unit square elements
+  const int nElementsPerDirection = 4;
+  std::vector<Mesh::ElementGridIndex::BoundingBox> boundingBoxes;
+  for (int j = 0; j < nElementsPerDirection; j++)
+  {
+    for (int i = 0; i < nElementsPerDirection; i++)
+    {
+      boundingBoxes.push_back(Mesh::ElementGridIndex::BoundingBox{Vec3{double(i), double(j), 0.0}, Vec3{double(i+1), double(j+1), 0.0}});
+    }
+  }
+
+  Mesh::ElementGridIndex spatialIndex;
+  ASSERT_FALSE(spatialIndex.isBuilt());
+  spatialIndex.build(boundingBoxes, 0.1);
+  ASSERT_TRUE(spatialIndex.isBuilt());
+  ASSERT_EQ(spatialIndex.nElements(), 16);
+
+  // the point in the interior of element 5 is only in the box of this element
+  std::vector<element_no_t> elementNos;
+  spatialIndex.getCandidateElements(Vec3{1.5, 1.5, 0.0}, elementNos);
+  ASSERT_EQ(elementNos, std::vector<element_no_t>({5}));
+
+  // a point near the corner is in the enlarged boxes of the four adjacent elements
+  spatialIndex.getCandidateElements(Vec3{2.05, 2.05, 0.0}, elementNos);
+  ASSERT_EQ(elementNos, std::vector<element_no_t>({5, 6, 9, 10}));
+
+  // a point far outside is in no box
+  spatialIndex.getCandidateElements(Vec3{10.0, 10.0, 0.0}, elementNos);
+  ASSERT_TRUE(elementNos.empty());
+
+  // move element 0 to the other end of the mesh, only this element is reinserted
+  boundingBoxes[0] = Mesh::ElementGridIndex::BoundingBox{Vec3{4.0, 4.0, 0.0}, Vec3{5.0, 5.0, 0.0}};
+  ASSERT_EQ(spatialIndex.update(boundingBoxes), 1);
+
+  spatialIndex.getCandidateElements(Vec3{0.5, 0.5, 0.0}, elementNos);
+  ASSERT_TRUE(elementNos.empty());
+
+  spatialIndex.getCandidateElements(Vec3{4.5, 4.5, 0.0}, elementNos);
+  ASSERT_EQ(elementNos, std::vector<element_no_t>({0}));
+
+  // small movements within the margin do not need reinsertion
+  for (Mesh::ElementGridIndex::BoundingBox &boundingBox : boundingBoxes)
+  {
+    boundingBox[0][0] += 0.01;
+    boundingBox[1][0] += 0.01;
+  }
+  ASSERT_EQ(spatialIndex.update(boundingBoxes), 0);
+}
+
 } // namespace
@@ -0,0 +1,199 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// the multidomain solver with the fieldsplit preconditioner converges to the same solution as with the default preconditioner
+TEST(MultidomainTest, FieldSplitPreconditionerGivesSameSolution)
+{
+  std::string pythonConfig = R"(
+nx, ny, nz = 2, 2, 4
+n_nodes = (nx+1)*(ny+1)*(nz+1)
+n_compartments = 2
+
+# potential flow from the bottom to the top of the box, such that the fiber direction is the z direction
+potential_flow_bc = {}
+for i in range((nx+1)*(ny+1)):
+  potential_flow_bc[i] = 0.0
+  potential_flow_bc[n_nodes-1-i] = 1.0
+
+config = {
+  "Meshes": {
+    "mesh": {
+      "nElements":          [nx, ny, nz],
+      "physicalExtent":     [1.0, 1.0, 2.0],
+      "inputMeshIsGlobal":  True,
+    }
+  },
+  "Solvers": {
+    "potentialFlowSolver": {
+      "relativeTolerance":  1e-12,
+      "absoluteTolerance":  1e-14,
+      "maxIterations":      1e4,
+      "solverType":         "gmres",
+      "preconditionerType": "none",
+      "dumpFormat":         "default",
+      "dumpFilename":       "",
+    },
+    "activationSolver": {
+      "relativeTolerance":  1e-12,
+      "absoluteTolerance":  1e-14,
+      "maxIterations":      1e4,
+      "solverType":         "gmres",
+      "preconditionerType": PRECONDITIONER_TYPE,
+      "dumpFormat":         "default",
+      "dumpFilename":       "",
+    },
+  },
+  "MultidomainSolver": {
+    "nCompartments":                    n_compartments,
+    "am":                               1.0,
+    "cm":                               0.58,
+    "timeStepWidth":                    1e-3,
+    "endTime":                          5e-3,
+    "timeStepOutputInterval":           100,
+    "solverName":                       "activationSolver",
+    "slotNames":                        [],
+    "initialGuessNonzero":              True,
+    "inputIsGlobal":                    True,
+    "showLinearSolverOutput":           False,
+    "compartmentRelativeFactors":       [[0.6]*n_nodes, [0.4]*n_nodes],
+    "updateSystemMatrixEveryTimestep":  False,
+    "useSymmetricPreconditionerMatrix": True,
+    "setDirichletBoundaryConditionPhiE": True,
+    "resetToAverageZeroPhiE":           False,
+    "subSolverType":                    "preonly",
+    "subPreconditionerType":            "lu",
+    "fieldSplitType":                   FIELD_SPLIT_TYPE,
+
+    "PotentialFlow": {
+      "FiniteElementMethod" : {
+        "meshName":                     "mesh",
+        "solverName":                   "potentialFlowSolver",
+        "prefactor":                    1.0,
+        "slotName":                     "",
+        "dirichletBoundaryConditions":  potential_flow_bc,
+        "dirichletOutputFilename":      None,
+        "neumannBoundaryConditions":    [],
+        "inputMeshIsGlobal":            True,
+      },
+    },
+    "Activation": {
+      "FiniteElementMethod" : {
+        "meshName":                     "mesh",
+        "solverName":                   "activationSolver",
+        "prefactor":                    1.0,
+        "slotName":                     "",
+        "inputMeshIsGlobal":            True,
+        "dirichletBoundaryConditions":  {},
+        "dirichletOutputFilename":      None,
+        "neumannBoundaryConditions":    [],
+        "diffusionTensor": [[
+          8.93, 0, 0,
+          0, 0.0, 0,
+          0, 0, 0.0
+        ]],
+        "extracellularDiffusionTensor": [[
+          6.7, 0, 0,
+          0, 6.7, 0,
+          0, 0, 6.7,
+        ]],
+      },
+    },
+    "OutputWriter" : [],
+  }
+}
+)";
+
+  typedef Mesh::StructuredDeformableOfDimension<3> MeshType;
+  typedef TimeSteppingScheme::MultidomainSolver<
+    SpatialDiscretization::FiniteElementMethod<       // potential flow for the fiber directions
+      MeshType,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<3>,
+      Equation::Static::Laplace
+    >,
+    SpatialDiscretization::FiniteElementMethod<       // anisotropic diffusion
+      MeshType,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<5>,
+      Equation::Dynamic::DirectionalDiffusion
+    >
+  > ProblemType;
+
+  const int nCompartments = 2;
+
+  // solve with the given preconditioner, starting from a Vm distribution with a peak in the center, return Vm of all compartments and phi_e
+  auto solve = [&pythonConfig](std::string preconditionerType, std::string fieldSplitType, std::vector<std::vector<double>> &solution)
+  {
+    std::string config = pythonConfig;
+
+    std::string strToReplace("PRECONDITIONER_TYPE");
+    config.replace(config.find(strToReplace), strToReplace.length(), preconditionerType);
+
+    strToReplace = "FIELD_SPLIT_TYPE";
+    config.replace(config.find(strToReplace), strToReplace.length(), fieldSplitType);
+
+    DihuContext settings(argc, argv, config);
+
+    ProblemType problem(settings);
+    problem.initialize();
+
+    // set the initial values of Vm
+    std::shared_ptr<ProblemType::FunctionSpace> functionSpace = problem.data().functionSpace();
+    std::vector<double> vmValues(functionSpace->nDofsLocalWithoutGhosts());
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < vmValues.size(); dofNoLocal++)
+    {
+      Vec3 position = functionSpace->getGeometry(dofNoLocal);
+      double distanceSquared = MathUtility::sqr(position[0]-0.5) + MathUtility::sqr(position[1]-0.5) + MathUtility::sqr(position[2]-1.0);
+      vmValues[dofNoLocal] = -75.0 + 95.0*std::exp(-4.0*distanceSquared);
+    }
+
+    for (int compartmentNo = 0; compartmentNo < nCompartments; compartmentNo++)
+    {
+      problem.data().transmembranePotential(compartmentNo)->setValuesWithoutGhosts(vmValues);
+    }
+
+    problem.advanceTimeSpan(false);
+
+    solution.resize(nCompartments+1);
+    for (int compartmentNo = 0; compartmentNo < nCompartments; compartmentNo++)
+    {
+      problem.data().transmembranePotentialSolution(compartmentNo)->getValuesWithoutGhosts(solution[compartmentNo]);
+    }
+    problem.data().extraCellularPotential()->getValuesWithoutGhosts(solution[nCompartments]);
+  };
+
+  std::vector<std::vector<double>> referenceSolution;
+  solve("\"none\"", "\"multiplicative\"", referenceSolution);
+
+  // the solution has to be non-trivial, i.e. phi_e is not zero everywhere
+  double maximumPhiE = 0;
+  for (double value : referenceSolution[nCompartments])
+    maximumPhiE = std::max(maximumPhiE, std::fabs(value));
+  ASSERT_GT(maximumPhiE, 1e-8);
+
+  for (std::string fieldSplitType : {"additive", "multiplicative", "schur"})
+  {
+    std::vector<std::vector<double>> solution;
+    solve("\"fieldsplit\"", std::string("\"") + fieldSplitType + "\"", solution);
+
+    ASSERT_EQ(solution.size(), referenceSolution.size());
+    for (int fieldNo = 0; fieldNo < solution.size(); fieldNo++)
+    {
+      ASSERT_EQ(solution[fieldNo].size(), referenceSolution[fieldNo].size());
+      for (int dofNo = 0; dofNo < solution[fieldNo].size(); dofNo++)
+      {
+        EXPECT_NEAR(solution[fieldNo][dofNo], referenceSolution[fieldNo][dofNo], 1e-6)
+          << "fieldSplitType " << fieldSplitType << ", field " << fieldNo << ", dof " << dofNo;
+      }
+    }
+  }
+}
@@ -674,3 +674,378 @@ config = {
 
   ASSERT_LE(error_rms, 1e-4);
 }
+
+TEST(SolidMechanicsTest, MatrixFreeJacobianEqualsAssembledJacobian)
+{
+  // solve the same incompressible Mooney-Rivlin problem with the assembled analytic jacobian and with the matrix-free jacobian,
+  // which uses the linear elasticity stiffness as preconditioner, the displacements have to agree up to the solver tolerance
+  std::string pythonConfig = R"(
+nx = 2
+ny = 2
+nz = 3
+mx = 2*nx + 1
+my = 2*ny + 1
+
+# fix the bottom in z direction and the edges in x and y direction
+dirichlet_bc = {}
+for j in range(my):
+  for i in range(mx):
+    dirichlet_bc[j*mx + i] = [None,None,0]
+for j in range(my):
+  dirichlet_bc[j*mx][0] = 0
+for i in range(mx):
+  dirichlet_bc[i][1] = 0
+
+neumann_bc = [{"element": (nz-1)*nx*ny + j*nx + i, "constantVector": [0,0,0.5], "face": "2+"} for j in range(ny) for i in range(nx)]
+
+config = {
+  "HyperelasticitySolver": {
+    "durationLogKey": "nonlinear",
+    "materialParameters": [2, 4],
+    "displacementsScalingFactor": 1.0,
+    "constantBodyForce": [0.0, 0.0, 0.0],
+    "residualNormLogFilename": "out/log_residual_norm_matrix_free.txt",
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "useMatrixFreeJacobian": MATRIX_FREE,
+    "dumpDenseMatlabVariables": False,
+
+    "nElements": [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent": [2, 2, 3],
+    "physicalOffset": [0, 0, 0],
+
+    "relativeTolerance": 1e-12,
+    "absoluteTolerance": 1e-14,
+    "solverType": "gmres",
+    "preconditionerType": "lu",
+    "maxIterations": 1e4,
+    "dumpFilename": "",
+    "dumpFormat": "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations": 50,
+    "snesRelativeTolerance": 1e-10,
+    "snesAbsoluteTolerance": 1e-10,
+    "snesLineSearchType": "l2",
+    "snesRebuildJacobianFrequency": 1,
+    "loadFactors": [],
+    "nNonlinearSolveCalls": 1,
+
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions": neumann_bc,
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+
+    "OutputWriter": [],
+    "pressure": None,
+    "LoadIncrements": None,
+  },
+}
+)";
+
+  std::string pythonConfigMatrixFree = pythonConfig;
+  pythonConfigMatrixFree.replace(pythonConfigMatrixFree.find("MATRIX_FREE"), std::string("MATRIX_FREE").length(), "True");
+  pythonConfig.replace(pythonConfig.find("MATRIX_FREE"), std::string("MATRIX_FREE").length(), "False");
+
+  typedef SpatialDiscretization::HyperelasticitySolver<> ProblemType;
+
+  // solve with the assembled jacobian
+  std::vector<Vec3> displacementsAssembled;
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+    ProblemType problem(settings);
+    problem.run();
+    problem.data().displacements()->getValuesWithoutGhosts(displacementsAssembled);
+  }
+
+  // solve with the matrix-free jacobian
+  std::vector<Vec3> displacementsMatrixFree;
+  {
+    DihuContext settings(argc, argv, pythonConfigMatrixFree);
+    ProblemType problem(settings);
+    problem.run();
+    problem.data().displacements()->getValuesWithoutGhosts(displacementsMatrixFree);
+  }
+
+  // the top of the box has to be displaced, otherwise the comparison is meaningless
+  double maximumDisplacement = 0;
+  for (const Vec3 &displacement : displacementsAssembled)
+    maximumDisplacement = std::max(maximumDisplacement, std::abs(displacement[2]));
+  ASSERT_GT(maximumDisplacement, 1e-3);
+
+  ASSERT_EQ(displacementsAssembled.size(), displacementsMatrixFree.size());
+  for (int dofNo = 0; dofNo < (int)displacementsAssembled.size(); dofNo++)
+  {
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(displacementsAssembled[dofNo][componentNo], displacementsMatrixFree[dofNo][componentNo], 1e-6)
+        << "dof " << dofNo << ", component " << componentNo;
+    }
+  }
+}
+
+TEST(SolidMechanicsTest, QuadraturePointCacheGivesSameResidualAndJacobian)
+{
+  // evaluate the residual and the analytic jacobian of an incompressible Mooney-Rivlin problem at a deformed state,
+  // once with the quadrature point cache of the reference configuration and once without, the results have to be equal
+  std::string pythonConfig = R"(
+nx = 2
+ny = 2
+nz = 3
+mx = 2*nx + 1
+my = 2*ny + 1
+
+# fix the bottom plane
+dirichlet_bc = {j*mx + i: [0.0,0.0,0.0] for j in range(my) for i in range(mx)}
+
+config = {
+  "HyperelasticitySolver": {
+    "durationLogKey": "nonlinear",
+    "materialParameters": [2, 4],
+    "displacementsScalingFactor": 1.0,
+    "constantBodyForce": [0.0, 0.0, -0.5],
+    "residualNormLogFilename": "out/log_residual_norm_quadrature_point_cache.txt",
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "dumpDenseMatlabVariables": False,
+    "quadraturePointCacheMaximumMemory": CACHE_MEMORY,
+
+    "nElements": [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent": [2, 2, 3],
+    "physicalOffset": [0, 0, 0],
+
+    "relativeTolerance": 1e-12,
+    "absoluteTolerance": 1e-14,
+    "solverType": "preonly",
+    "preconditionerType": "lu",
+    "maxIterations": 1e4,
+    "dumpFilename": "",
+    "dumpFormat": "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations": 50,
+    "snesRelativeTolerance": 1e-10,
+    "snesAbsoluteTolerance": 1e-10,
+    "snesLineSearchType": "l2",
+    "loadFactors": [],
+    "nNonlinearSolveCalls": 1,
+
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions": [],
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+
+    "OutputWriter": [],
+    "pressure": None,
+    "LoadIncrements": None,
+  },
+}
+)";
+
+  std::string pythonConfigWithoutCache = pythonConfig;
+  pythonConfigWithoutCache.replace(pythonConfigWithoutCache.find("CACHE_MEMORY"), std::string("CACHE_MEMORY").length(), "0");
+  pythonConfig.replace(pythonConfig.find("CACHE_MEMORY"), std::string("CACHE_MEMORY").length(), "512");
+
+  typedef SpatialDiscretization::HyperelasticitySolver<> ProblemType;
+
+  // evaluate the residual and the dense jacobian at a fixed deformed state, the second evaluation uses the stored values of the cache
+  auto evaluate = [](std::string config, std::vector<double> &residual, std::vector<double> &jacobian)
+  {
+    DihuContext settings(argc, argv, config);
+    ProblemType problem(settings);
+    problem.initialize();
+
+    PetscErrorCode ierr;
+    Vec x = problem.combinedVecSolution()->valuesGlobal();
+    Vec f = problem.combinedVecResidual()->valuesGlobal();
+
+    PetscInt nRows = 0;
+    ierr = VecGetSize(x, &nRows); CHKERRV(ierr);
+    for (PetscInt i = 0; i < nRows; i++)
+    {
+      ierr = VecSetValue(x, i, 1e-2*sin(1.0*i), INSERT_VALUES); CHKERRV(ierr);
+    }
+    ierr = VecAssemblyBegin(x); CHKERRV(ierr);
+    ierr = VecAssemblyEnd(x); CHKERRV(ierr);
+
+    for (int evaluationNo = 0; evaluationNo < 2; evaluationNo++)
+    {
+      problem.evaluateNonlinearFunction(x, f);
+      problem.evaluateAnalyticJacobian(x, PETSC_NULL);
+    }
+
+    const double *residualValues;
+    residual.resize(nRows);
+    ierr = VecGetArrayRead(f, &residualValues); CHKERRV(ierr);
+    std::copy(residualValues, residualValues + nRows, residual.begin());
+    ierr = VecRestoreArrayRead(f, &residualValues); CHKERRV(ierr);
+
+    Mat jac = problem.combinedMatrixJacobian()->valuesGlobal();
+    jacobian.assign(nRows*nRows, 0.0);
+    for (PetscInt rowNo = 0; rowNo < nRows; rowNo++)
+    {
+      PetscInt nColumns;
+      const PetscInt *columns;
+      const double *values;
+      ierr = MatGetRow(jac, rowNo, &nColumns, &columns, &values); CHKERRV(ierr);
+      for (PetscInt i = 0; i < nColumns; i++)
+      {
+        jacobian[rowNo*nRows + columns[i]] = values[i];
+      }
+      ierr = MatRestoreRow(jac, rowNo, &nColumns, &columns, &values); CHKERRV(ierr);
+    }
+  };
+
+  std::vector<double> residualWithCache, jacobianWithCache;
+  evaluate(pythonConfig, residualWithCache, jacobianWithCache);
+
+  std::vector<double> residualWithoutCache, jacobianWithoutCache;
+  evaluate(pythonConfigWithoutCache, residualWithoutCache, jacobianWithoutCache);
+
+  // the state has to produce a nonzero residual, otherwise the comparison is meaningless
+  double maximumResidual = 0;
+  for (double value : residualWithoutCache)
+    maximumResidual = std::max(maximumResidual, std::abs(value));
+  ASSERT_GT(maximumResidual, 1e-6);
+
+  ASSERT_EQ(residualWithCache.size(), residualWithoutCache.size());
+  for (int i = 0; i < (int)residualWithCache.size(); i++)
+  {
+    EXPECT_NEAR(residualWithCache[i], residualWithoutCache[i], 1e-12) << "residual entry " << i;
+  }
+
+  ASSERT_EQ(jacobianWithCache.size(), jacobianWithoutCache.size());
+  for (int i = 0; i < (int)jacobianWithCache.size(); i++)
+  {
+    EXPECT_NEAR(jacobianWithCache[i], jacobianWithoutCache[i], 1e-10) << "jacobian entry " << i;
+  }
+}
+
+TEST(SolidMechanicsTest, LaggedJacobianGivesSameSolution)
+{
+  // solve the same incompressible Mooney-Rivlin problem without lagging, with a lagged jacobian and with a lagged preconditioner,
+  // the lagged jacobian has to be evaluated less often and all displacements have to agree up to the solver tolerance
+  std::string pythonConfig = R"(
+nx = 2
+ny = 2
+nz = 3
+mx = 2*nx + 1
+my = 2*ny + 1
+
+# fix the bottom in z direction and the edges in x and y direction
+dirichlet_bc = {}
+for j in range(my):
+  for i in range(mx):
+    dirichlet_bc[j*mx + i] = [None,None,0]
+for j in range(my):
+  dirichlet_bc[j*mx][0] = 0
+for i in range(mx):
+  dirichlet_bc[i][1] = 0
+
+neumann_bc = [{"element": (nz-1)*nx*ny + j*nx + i, "constantVector": [0,0,0.5], "face": "2+"} for j in range(ny) for i in range(nx)]
+
+config = {
+  "HyperelasticitySolver": {
+    "durationLogKey": "lagged_jacobian",
+    "materialParameters": [2, 4],
+    "displacementsScalingFactor": 1.0,
+    "constantBodyForce": [0.0, 0.0, 0.0],
+    "residualNormLogFilename": "out/log_residual_norm_lagged_jacobian.txt",
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "dumpDenseMatlabVariables": False,
+    "jacobianLag": JACOBIAN_LAG,
+    "preconditionerLag": PRECONDITIONER_LAG,
+    "lagAcrossSolves": False,
+    "jacobianRefreshThreshold": 0.9,
+
+    "nElements": [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent": [2, 2, 3],
+    "physicalOffset": [0, 0, 0],
+
+    "relativeTolerance": 1e-12,
+    "absoluteTolerance": 1e-14,
+    "solverType": "gmres",
+    "preconditionerType": "lu",
+    "maxIterations": 1e4,
+    "dumpFilename": "",
+    "dumpFormat": "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations": 50,
+    "snesRelativeTolerance": 1e-10,
+    "snesAbsoluteTolerance": 1e-10,
+    "snesLineSearchType": "l2",
+    "loadFactors": [],
+    "nNonlinearSolveCalls": 1,
+
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions": neumann_bc,
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+
+    "OutputWriter": [],
+    "pressure": None,
+    "LoadIncrements": None,
+  },
+}
+)";
+
+  typedef SpatialDiscretization::HyperelasticitySolver<> ProblemType;
+
+  // solve with the given lag settings, return the displacements and the number of jacobian evaluations of this solve
+  auto solve = [&pythonConfig](std::string jacobianLag, std::string preconditionerLag, std::vector<Vec3> &displacements)
+  {
+    std::string config = pythonConfig;
+    config.replace(config.find("JACOBIAN_LAG"), std::string("JACOBIAN_LAG").length(), jacobianLag);
+    config.replace(config.find("PRECONDITIONER_LAG"), std::string("PRECONDITIONER_LAG").length(), preconditionerLag);
+
+    // the counter accumulates over all problems in this process
+    int nJacobianEvaluationsBefore = Control::PerformanceMeasurement::getNumber("lagged_jacobian_nJacobianEvaluations");
+
+    DihuContext settings(argc, argv, config);
+    ProblemType problem(settings);
+    problem.run();
+    problem.data().displacements()->getValuesWithoutGhosts(displacements);
+
+    return Control::PerformanceMeasurement::getNumber("lagged_jacobian_nJacobianEvaluations") - nJacobianEvaluationsBefore;
+  };
+
+  std::vector<Vec3> displacementsUnlagged, displacementsLaggedJacobian, displacementsLaggedPreconditioner;
+  int nJacobianEvaluationsUnlagged = solve("1", "1", displacementsUnlagged);
+  int nJacobianEvaluationsLaggedJacobian = solve("3", "1", displacementsLaggedJacobian);
+  int nJacobianEvaluationsLaggedPreconditioner = solve("1", "3", displacementsLaggedPreconditioner);
+
+  LOG(INFO) << "number of jacobian evaluations, unlagged: " << nJacobianEvaluationsUnlagged
+    << ", lagged jacobian: " << nJacobianEvaluationsLaggedJacobian
+    << ", lagged preconditioner: " << nJacobianEvaluationsLaggedPreconditioner;
+
+  // the problem needs more than one Newton iteration, otherwise lagging has no effect
+  ASSERT_GT(nJacobianEvaluationsUnlagged, 1);
+  EXPECT_LT(nJacobianEvaluationsLaggedJacobian, nJacobianEvaluationsUnlagged);
+
+  // the preconditioner lag does not change how often the jacobian is evaluated
+  EXPECT_GE(nJacobianEvaluationsLaggedPreconditioner, nJacobianEvaluationsUnlagged);
+
+  // the top of the box has to be displaced, otherwise the comparison is meaningless
+  double maximumDisplacement = 0;
+  for (const Vec3 &displacement : displacementsUnlagged)
+    maximumDisplacement = std::max(maximumDisplacement, std::abs(displacement[2]));
+  ASSERT_GT(maximumDisplacement, 1e-3);
+
+  ASSERT_EQ(displacementsUnlagged.size(), displacementsLaggedJacobian.size());
+  ASSERT_EQ(displacementsUnlagged.size(), displacementsLaggedPreconditioner.size());
+  for (int dofNo = 0; dofNo < (int)displacementsUnlagged.size(); dofNo++)
+  {
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(displacementsUnlagged[dofNo][componentNo], displacementsLaggedJacobian[dofNo][componentNo], 1e-6)
+        << "dof " << dofNo << ", component " << componentNo;
+      EXPECT_NEAR(displacementsUnlagged[dofNo][componentNo], displacementsLaggedPreconditioner[dofNo][componentNo], 1e-6)
+        << "dof " << dofNo << ", component " << componentNo;
+    }
+  }
+}
@@ -30,6 +30,64 @@ public:
     }
   }
   
+  //! compare the action and the diagonal of the MatShell of a FiniteElementMethod with "matrixFree": True with the assembled stiffness matrix of a second FiniteElementMethod with the same settings
+  template<typename MeshType, typename BasisFunctionType, typename QuadratureType, typename EquationType>
+  static void compareMatrixFreeOperator(
+    FiniteElementMethod<MeshType, BasisFunctionType, QuadratureType, EquationType> &finiteElementMethodMatrixFree,
+    FiniteElementMethod<MeshType, BasisFunctionType, QuadratureType, EquationType> &finiteElementMethodAssembled,
+    double tolerance=1e-12)
+  {
+    ASSERT_TRUE(finiteElementMethodMatrixFree.matrixFreeStiffnessOperator_ != nullptr) << "The FiniteElementMethod does not use the matrix-free operator.";
+    ASSERT_TRUE(finiteElementMethodAssembled.matrixFreeStiffnessOperator_ == nullptr) << "The FiniteElementMethod does not assemble the stiffness matrix.";
+
+    Mat &shellMatrix = finiteElementMethodMatrixFree.matrixFreeStiffnessOperator_->valuesGlobal();
+    Mat &stiffnessMatrix = finiteElementMethodAssembled.data_.stiffnessMatrix()->valuesGlobal();
+
+    // apply both operators to the same input vector
+    Vec input, resultMatrixFree, resultAssembled;
+    PetscErrorCode ierr;
+    ierr = MatCreateVecs(stiffnessMatrix, &input, &resultAssembled); CHKERRV(ierr);
+    ierr = VecDuplicate(resultAssembled, &resultMatrixFree); CHKERRV(ierr);
+
+    PetscInt nEntries = 0;
+    ierr = VecGetSize(input, &nEntries); CHKERRV(ierr);
+    for (PetscInt i = 0; i < nEntries; i++)
+    {
+      ierr = VecSetValue(input, i, sin(1.0+i), INSERT_VALUES); CHKERRV(ierr);
+    }
+    ierr = VecAssemblyBegin(input); CHKERRV(ierr);
+    ierr = VecAssemblyEnd(input); CHKERRV(ierr);
+
+    ierr = MatMult(shellMatrix, input, resultMatrixFree); CHKERRV(ierr);
+    ierr = MatMult(stiffnessMatrix, input, resultAssembled); CHKERRV(ierr);
+
+    std::vector<double> valuesMatrixFree, valuesAssembled;
+    PetscUtility::getVectorEntries(resultMatrixFree, valuesMatrixFree);
+    PetscUtility::getVectorEntries(resultAssembled, valuesAssembled);
+
+    ASSERT_EQ(valuesMatrixFree.size(), valuesAssembled.size());
+    for (unsigned int i = 0; i < valuesAssembled.size(); i++)
+    {
+      EXPECT_NEAR(valuesMatrixFree[i], valuesAssembled[i], tolerance) << "Entry no. " << i << " of the matrix-vector product differs";
+    }
+
+    // compare the diagonals, which are used by the jacobi preconditioner
+    ierr = MatGetDiagonal(shellMatrix, resultMatrixFree); CHKERRV(ierr);
+    ierr = MatGetDiagonal(stiffnessMatrix, resultAssembled); CHKERRV(ierr);
+
+    PetscUtility::getVectorEntries(resultMatrixFree, valuesMatrixFree);
+    PetscUtility::getVectorEntries(resultAssembled, valuesAssembled);
+
+    for (unsigned int i = 0; i < valuesAssembled.size(); i++)
+    {
+      EXPECT_NEAR(valuesMatrixFree[i], valuesAssembled[i], tolerance) << "Diagonal entry no. " << i << " differs";
+    }
+
+    ierr = VecDestroy(&input); CHKERRV(ierr);
+    ierr = VecDestroy(&resultMatrixFree); CHKERRV(ierr);
+    ierr = VecDestroy(&resultAssembled); CHKERRV(ierr);
+  }
+
   template<typename MeshType, typename BasisFunctionType, typename QuadratureType, typename EquationType>
   static void compareRhs(
     FiniteElementMethod<MeshType, BasisFunctionType, QuadratureType, EquationType> &finiteElementMethod,
@@ -0,0 +1,451 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+namespace
+{
+
+// config with two fibers, each fiber is partitioned to both ranks, fiber 0 is computed on rank 0 and fiber 1 on rank 1
+std::string pythonConfig = R"(
+import numpy as np
+
+dt_0D = 2e-4
+dt_1D = 2e-3
+dt_splitting = 2e-3
+end_time = 10*dt_splitting
+n_elements = 20
+n_fibers = 2
+load_balancing = False
+
+def fiber_instance(fiber_no):
+  return {
+    "ranks": [0,1],
+    "StrangSplitting": {
+      "timeStepWidth":          dt_splitting,
+      "timeStepOutputInterval": 100,
+      "endTime":                end_time,
+      "connectedSlotsTerm1To2": [0],
+      "connectedSlotsTerm2To1": [0],
+
+      "Term1": {
+        "MultipleInstances": {
+          "logKey":     "duration_subdomains_z",
+          "nInstances": 1,
+          "instances": [{
+            "ranks": [0,1],
+            "Heun" : {
+              "timeStepWidth":                dt_0D,
+              "logTimeStepWidthAsKey":        "dt_0D",
+              "durationLogKey":               "duration_0D",
+              "initialValues":                [],
+              "timeStepOutputInterval":       1e4,
+              "inputMeshIsGlobal":            True,
+              "dirichletBoundaryConditions":  {},
+
+              "CellML" : {
+                "modelFilename":                          "../input/hodgkin_huxley_1952.c",
+                "optimizationType":                       "vc",
+                "approximateExponentialFunction":         True,
+                "compilerFlags":                          "-fPIC -O3 -march=native -shared ",
+                "maximumNumberOfThreads":                 0,
+                "setSpecificStatesCallInterval":          0,
+                "additionalArgument":                     fiber_no,
+                "algebraicsForTransfer":                  [],
+                "statesForTransfer":                      0,
+                "parametersUsedAsAlgebraic":              [],
+                "parametersUsedAsConstant":               [2],
+                "parametersInitialValues":                [0.0],
+                "meshName":                               "MeshFiber_{}".format(fiber_no),
+              },
+            },
+          }],
+        }
+      },
+      "Term2": {
+        "MultipleInstances": {
+          "nInstances": 1,
+          "instances": [{
+            "ranks": [0,1],
+            "ImplicitEuler" : {
+              "initialValues":               [],
+              "timeStepWidth":               dt_1D,
+              "timeStepWidthRelativeTolerance": 1e-10,
+              "logTimeStepWidthAsKey":       "dt_1D",
+              "durationLogKey":              "duration_1D",
+              "timeStepOutputInterval":      1e4,
+              "dirichletBoundaryConditions": {},
+              "inputMeshIsGlobal":           True,
+              "solverName":                  "implicitSolver",
+              "FiniteElementMethod" : {
+                "maxIterations":             1e4,
+                "relativeTolerance":         1e-10,
+                "inputMeshIsGlobal":         True,
+                "meshName":                  "MeshFiber_{}".format(fiber_no),
+                "prefactor":                 0.03,
+                "solverName":                "implicitSolver",
+              },
+              "OutputWriter": [],
+            },
+          }],
+        },
+      },
+    }
+  }
+
+config = {
+  "scenarioName": "fast_monodomain_solver_2_ranks",
+  "Meshes": {
+    "MeshFiber_{}".format(fiber_no): {
+      "nElements":          [n_elements],
+      "physicalExtent":     [n_elements/100.],
+      "inputMeshIsGlobal":  True,
+    }
+    for fiber_no in range(n_fibers)
+  },
+  "Solvers": {
+    "implicitSolver": {
+      "maxIterations":      1e4,
+      "relativeTolerance":  1e-10,
+      "dumpFormat":         "",
+      "dumpFilename":       "",
+      "solverType":         "gmres",
+      "preconditionerType": "none",
+    },
+  },
+  "fiberDistributionFile":    "../input/MU_fibre_distribution_10MUs.txt",
+  "firingTimesFile":          "../input/MU_firing_times_always.txt",
+  "onlyComputeIfHasBeenStimulated": False,
+  "disableComputationWhenStatesAreCloseToEquilibrium": False,
+  "loadBalancing":            load_balancing,
+  "loadBalancingInterval":    1000,
+  "loadBalancingImbalanceThreshold": 1.1,
+  "MultipleInstances": {
+    "ranksAllComputedInstances":  [0,1],
+    "nInstances":                 n_fibers,
+    "instances":                  [fiber_instance(fiber_no) for fiber_no in range(n_fibers)],
+  },
+}
+)";
+
+typedef FastMonodomainSolver<
+  Control::MultipleInstances<                       // fibers
+    OperatorSplitting::Strang<
+      Control::MultipleInstances<
+        TimeSteppingScheme::Heun<                   // fiber reaction term
+          CellmlAdapter<
+            4, 9,  // nStates,nAlgebraics: 4,9 = Hodgkin Huxley
+            FunctionSpace::FunctionSpace<
+              Mesh::StructuredDeformableOfDimension<1>,
+              BasisFunction::LagrangeOfOrder<1>
+            >
+          >
+        >
+      >,
+      Control::MultipleInstances<
+        TimeSteppingScheme::ImplicitEuler<          // fiber diffusion
+          SpatialDiscretization::FiniteElementMethod<
+            Mesh::StructuredDeformableOfDimension<1>,
+            BasisFunction::LagrangeOfOrder<1>,
+            Quadrature::Gauss<2>,
+            Equation::Dynamic::IsotropicDiffusion
+          >
+        >
+      >
+    >
+  >
+> FastMonodomainSolverType;
+
+//! gives access to the communication methods and the fetched data of the FastMonodomainSolver
+class FastMonodomainSolverTestable : public FastMonodomainSolverType
+{
+public:
+  using FastMonodomainSolverType::FastMonodomainSolverType;
+
+  //! gather the fiber data to the computing ranks without starting the computation
+  void fetchFiberDataOnly()
+  {
+    this->fetchFiberData();
+  }
+
+  //! scatter the fiber data back to the ranks of the fibers
+  void updateFiberDataOnly()
+  {
+    this->updateFiberData();
+  }
+
+  //! compute one time span where the 0D computation only starts after all fiber data has arrived
+  void advanceTimeSpanWithoutOverlap()
+  {
+    this->fetchFiberData(false);
+    this->computeMonodomain();
+    this->updateFiberData();
+  }
+
+  //! number of fibers that are computed on the own rank
+  int nFibersToCompute()
+  {
+    return this->fiberData_.size();
+  }
+
+  //! the global Vm values of a fiber that is computed on the own rank
+  std::vector<double> fetchedVmValues(int fiberDataNo)
+  {
+    return this->fiberData_[fiberDataNo].vmValues;
+  }
+
+  //! global fiber no. of a fiber that is computed on the own rank
+  int fiberNoGlobal(int fiberDataNo)
+  {
+    return this->fiberData_[fiberDataNo].fiberNoGlobal;
+  }
+
+  //! replace the measured compute durations by the given duration for every point buffer, to create an artificial imbalance
+  void setComputeDurations(double durationPerPointBuffer)
+  {
+    std::fill(this->fiberPointBuffersComputeDuration0D_.begin(), this->fiberPointBuffersComputeDuration0D_.end(), durationPerPointBuffer);
+    this->computeDuration1D_ = 0;
+  }
+
+  //! migrate fibers according to the compute durations
+  void rebalance()
+  {
+    this->rebalanceFibers();
+  }
+
+  //! get the states of all fibers on all ranks, at index (fiberNoGlobal*nValuesPerFiber + valueNo)*4 + stateNo
+  std::vector<double> statesOfAllFibers(int nFibers, int nValuesPerFiber)
+  {
+    std::vector<double> states(nFibers*nValuesPerFiber*4, 0.0);
+    for (int fiberDataNo = 0; fiberDataNo < this->fiberData_.size(); fiberDataNo++)
+    {
+      for (int valueNo = 0; valueNo < this->fiberData_[fiberDataNo].valuesLength; valueNo++)
+      {
+        global_no_t valueIndexAllFibers = this->fiberData_[fiberDataNo].valuesOffset + valueNo;
+        global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+        int entryNo = valueIndexAllFibers % Vc::double_v::size();
+
+        for (int stateNo = 0; stateNo < 4; stateNo++)
+        {
+          states[(this->fiberData_[fiberDataNo].fiberNoGlobal*nValuesPerFiber + valueNo)*4 + stateNo]
+            = this->fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo];
+        }
+      }
+    }
+
+    // every fiber is computed on exactly one rank, the other ranks contribute zeros
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, states.data(), states.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD), "MPI_Allreduce");
+    return states;
+  }
+};
+
+typedef TimeSteppingScheme::Heun<CellmlAdapter<4,9,FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>>>> HeunType;
+
+//! get the 0D solver of the given fiber
+HeunType &fiberInstance(FastMonodomainSolverTestable &solver, int fiberNo)
+{
+  return solver.nestedSolvers().instancesLocal()[fiberNo].timeStepping1().instancesLocal()[0];
+}
+
+//! get the local Vm values of all fibers
+std::vector<std::vector<double>> getLocalVmValues(FastMonodomainSolverTestable &solver)
+{
+  std::vector<std::vector<double>> vmValues(solver.nestedSolvers().instancesLocal().size());
+  for (int fiberNo = 0; fiberNo < vmValues.size(); fiberNo++)
+  {
+    fiberInstance(solver, fiberNo).data().solution()->getValuesWithoutGhosts(0, vmValues[fiberNo]);
+  }
+  return vmValues;
+}
+
+}  // namespace
+
+// the Vm values of a fiber that is distributed to two ranks are gathered on the computing rank and scattered back unchanged
+TEST(FastMonodomainSolverTest, FetchAndUpdateFiberDataRoundTrip)
+{
+  DihuContext settings(argc, argv, pythonConfig);
+
+  FastMonodomainSolverTestable solver(settings);
+  solver.initialize();
+
+  const int nFibers = solver.nestedSolvers().instancesLocal().size();
+  ASSERT_EQ(nFibers, 2);
+
+  // set a known global Vm distribution on every fiber
+  auto vmValue = [](int fiberNo, int nodeNoGlobal)
+  {
+    return -75.0 + 0.5*nodeNoGlobal + 100.0*fiberNo;
+  };
+
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    HeunType &heun = fiberInstance(solver, fiberNo);
+    std::shared_ptr<HeunType::FunctionSpace> functionSpace = heun.data().functionSpace();
+
+    // the fiber has to be partitioned to both ranks for the test to be meaningful
+    ASSERT_EQ(functionSpace->meshPartition()->rankSubset()->size(), 2);
+    ASSERT_LT(functionSpace->nDofsLocalWithoutGhosts(), functionSpace->nDofsGlobal());
+
+    const global_no_t beginNodeGlobal = functionSpace->meshPartition()->beginNodeGlobalNatural(0);
+    std::vector<double> values(functionSpace->nDofsLocalWithoutGhosts());
+    for (int dofNoLocal = 0; dofNoLocal < values.size(); dofNoLocal++)
+    {
+      values[dofNoLocal] = vmValue(fiberNo, beginNodeGlobal + dofNoLocal);
+    }
+    heun.data().solution()->setValuesWithoutGhosts(0, values);
+  }
+
+  std::vector<std::vector<double>> vmValuesBefore = getLocalVmValues(solver);
+
+  // gather the data to the computing ranks, fiber 0 is computed on rank 0 and fiber 1 on rank 1
+  solver.fetchFiberDataOnly();
+
+  ASSERT_EQ(solver.nFibersToCompute(), 1);
+  const int ownRankNo = DihuContext::ownRankNoCommWorld();
+  EXPECT_EQ(solver.fiberNoGlobal(0), ownRankNo);
+
+  std::vector<double> fetchedVmValues = solver.fetchedVmValues(0);
+  ASSERT_EQ(fetchedVmValues.size(), (size_t)21);
+  for (int nodeNoGlobal = 0; nodeNoGlobal < fetchedVmValues.size(); nodeNoGlobal++)
+  {
+    EXPECT_EQ(fetchedVmValues[nodeNoGlobal], vmValue(ownRankNo, nodeNoGlobal)) << "node " << nodeNoGlobal;
+  }
+
+  // clear the local values such that they have to be restored by updateFiberData
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    std::vector<double> zeros(vmValuesBefore[fiberNo].size(), 0.0);
+    fiberInstance(solver, fiberNo).data().solution()->setValuesWithoutGhosts(0, zeros);
+  }
+
+  // scatter the data back to the ranks of the fibers
+  solver.updateFiberDataOnly();
+
+  std::vector<std::vector<double>> vmValuesAfter = getLocalVmValues(solver);
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    ASSERT_EQ(vmValuesAfter[fiberNo].size(), vmValuesBefore[fiberNo].size());
+    for (int dofNoLocal = 0; dofNoLocal < vmValuesBefore[fiberNo].size(); dofNoLocal++)
+    {
+      EXPECT_EQ(vmValuesAfter[fiberNo][dofNoLocal], vmValuesBefore[fiberNo][dofNoLocal]) << "fiber " << fiberNo << ", dof " << dofNoLocal;
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// starting the 0D computation during fetchFiberData gives the same result as starting it after all data has arrived
+TEST(FastMonodomainSolverTest, ComputationDuringFetchGivesSameResult)
+{
+  std::vector<std::vector<double>> vmValuesWithOverlap, vmValuesWithoutOverlap;
+
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+    FastMonodomainSolverTestable solver(settings);
+    solver.initialize();
+    solver.advanceTimeSpan(false);
+    vmValuesWithOverlap = getLocalVmValues(solver);
+  }
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+    FastMonodomainSolverTestable solver(settings);
+    solver.initialize();
+    solver.advanceTimeSpanWithoutOverlap();
+    vmValuesWithoutOverlap = getLocalVmValues(solver);
+  }
+
+  ASSERT_EQ(vmValuesWithOverlap.size(), vmValuesWithoutOverlap.size());
+  for (int fiberNo = 0; fiberNo < vmValuesWithOverlap.size(); fiberNo++)
+  {
+    ASSERT_EQ(vmValuesWithOverlap[fiberNo].size(), vmValuesWithoutOverlap[fiberNo].size());
+    for (int dofNoLocal = 0; dofNoLocal < vmValuesWithOverlap[fiberNo].size(); dofNoLocal++)
+    {
+      EXPECT_NEAR(vmValuesWithOverlap[fiberNo][dofNoLocal], vmValuesWithoutOverlap[fiberNo][dofNoLocal], 1e-12) << "fiber " << fiberNo << ", dof " << dofNoLocal;
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// fibers that are migrated by the load balancing keep their states and the result is the same as without load balancing
+TEST(FastMonodomainSolverTest, RebalancedFibersKeepStatesAndGiveSameResult)
+{
+  // use four fibers, fibers 0 and 2 are initially computed on rank 0 and fibers 1 and 3 on rank 1
+  std::string config = pythonConfig;
+  std::string strToReplace("n_fibers = 2");
+  config.replace(config.find(strToReplace), strToReplace.length(), "n_fibers = 4");
+
+  const int nFibers = 4;
+  const int nValuesPerFiber = 21;
+  const double endTime = 10*2e-3;
+  const int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  std::vector<std::vector<double>> vmValuesWithRebalancing, vmValuesWithoutRebalancing;
+
+  // run with rebalancing after the first time span
+  {
+    std::string configLoadBalancing = config;
+    std::string strToReplace("load_balancing = False");
+    configLoadBalancing.replace(configLoadBalancing.find(strToReplace), strToReplace.length(), "load_balancing = True");
+
+    DihuContext settings(argc, argv, configLoadBalancing);
+    FastMonodomainSolverTestable solver(settings);
+    solver.initialize();
+
+    solver.setTimeSpan(0, endTime);
+    solver.advanceTimeSpan(false);
+    ASSERT_EQ(solver.nFibersToCompute(), 2);
+
+    // rank 0 appears to be 1000 times slower than rank 1
+    solver.setComputeDurations(ownRankNo == 0? 1.0 : 1e-3);
+
+    std::vector<double> statesBefore = solver.statesOfAllFibers(nFibers, nValuesPerFiber);
+    solver.rebalance();
+    std::vector<double> statesAfter = solver.statesOfAllFibers(nFibers, nValuesPerFiber);
+
+    // one fiber has moved from rank 0 to rank 1
+    EXPECT_EQ(solver.nFibersToCompute(), (ownRankNo == 0? 1 : 3));
+
+    ASSERT_EQ(statesBefore.size(), statesAfter.size());
+    for (int i = 0; i < statesBefore.size(); i++)
+    {
+      EXPECT_EQ(statesBefore[i], statesAfter[i]) << "fiber " << i/(4*nValuesPerFiber) << ", value " << (i/4) % nValuesPerFiber << ", state " << i%4;
+    }
+
+    solver.setTimeSpan(endTime, 2*endTime);
+    solver.advanceTimeSpan(false);
+    vmValuesWithRebalancing = getLocalVmValues(solver);
+  }
+
+  // run without rebalancing
+  {
+    DihuContext settings(argc, argv, config);
+    FastMonodomainSolverTestable solver(settings);
+    solver.initialize();
+
+    solver.setTimeSpan(0, endTime);
+    solver.advanceTimeSpan(false);
+    solver.setTimeSpan(endTime, 2*endTime);
+    solver.advanceTimeSpan(false);
+    vmValuesWithoutRebalancing = getLocalVmValues(solver);
+  }
+
+  ASSERT_EQ(vmValuesWithRebalancing.size(), (size_t)nFibers);
+  ASSERT_EQ(vmValuesWithoutRebalancing.size(), (size_t)nFibers);
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    ASSERT_EQ(vmValuesWithRebalancing[fiberNo].size(), vmValuesWithoutRebalancing[fiberNo].size());
+    for (int dofNoLocal = 0; dofNoLocal < vmValuesWithRebalancing[fiberNo].size(); dofNoLocal++)
+    {
+      EXPECT_NEAR(vmValuesWithRebalancing[fiberNo][dofNoLocal], vmValuesWithoutRebalancing[fiberNo][dofNoLocal], 1e-12) << "fiber " << fiberNo << ", dof " << dofNoLocal;
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
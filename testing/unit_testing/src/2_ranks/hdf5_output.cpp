@@ -0,0 +1,167 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+#ifdef HAVE_HDF5
+#include <hdf5.h>
+
+// read the extent and the values of the last output of a time dependent dataset
+static void readLastOutput(hid_t file, std::string datasetName, std::vector<hsize_t> &dimensions, std::vector<double> &values)
+{
+  hid_t dataset = H5Dopen2(file, datasetName.c_str(), H5P_DEFAULT);
+  ASSERT_GE(dataset, 0) << "dataset \"" << datasetName << "\" does not exist";
+
+  hid_t fileDataspace = H5Dget_space(dataset);
+  dimensions.resize(3);
+  ASSERT_EQ(H5Sget_simple_extent_ndims(fileDataspace), 3);
+  H5Sget_simple_extent_dims(fileDataspace, dimensions.data(), NULL);
+
+  hsize_t start[3] = {dimensions[0]-1, 0, 0};
+  hsize_t count[3] = {1, dimensions[1], dimensions[2]};
+  H5Sselect_hyperslab(fileDataspace, H5S_SELECT_SET, start, NULL, count, NULL);
+
+  hsize_t memoryDimensions[1] = {dimensions[1]*dimensions[2]};
+  hid_t memoryDataspace = H5Screate_simple(1, memoryDimensions, NULL);
+
+  values.resize(memoryDimensions[0]);
+  H5Dread(dataset, H5T_NATIVE_DOUBLE, memoryDataspace, fileDataspace, H5P_DEFAULT, values.data());
+
+  H5Sclose(memoryDataspace);
+  H5Sclose(fileDataspace);
+  H5Dclose(dataset);
+}
+
+// every rank holds a different mesh, the collective HDF5 calls have to match nevertheless
+TEST(HDF5OutputTest, DifferentMeshesPerRank)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Meshes": {
+    "meshA": {"nElements": [4], "physicalExtent": [4.0], "inputMeshIsGlobal": True},
+    "meshB": {"nElements": [2], "physicalExtent": [1.0], "inputMeshIsGlobal": True},
+  },
+  "MultipleInstances": {
+    "nInstances": 2,
+    "instances": [
+      {
+        "ranks": [0],
+        "ExplicitEuler": {
+          "initialValues": [1.0, 2.0, 3.0, 4.0, 5.0],
+          "numberTimeSteps": 5,
+          "endTime": 0.1,
+          "FiniteElementMethod": {"meshName": "meshA", "relativeTolerance": 1e-15},
+        }
+      },
+      {
+        "ranks": [1],
+        "ExplicitEuler": {
+          "initialValues": [1.0, 2.0, 3.0],
+          "numberTimeSteps": 5,
+          "endTime": 0.1,
+          "FiniteElementMethod": {"meshName": "meshB", "relativeTolerance": 1e-15},
+        }
+      }
+    ],
+    "OutputWriter": [
+      {"format": "HDF5", "filename": "out/hdf5_different_meshes", "outputInterval": 1, "compressionLevel": 0},
+    ]
+  }
+}
+)";
+
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    typedef Control::MultipleInstances<
+      TimeSteppingScheme::ExplicitEuler<
+        SpatialDiscretization::FiniteElementMethod<
+          Mesh::StructuredRegularFixedOfDimension<1>,
+          BasisFunction::LagrangeOfOrder<1>,
+          Quadrature::Gauss<2>,
+          Equation::Dynamic::IsotropicDiffusion
+        >
+      >
+    > ProblemType;
+
+    // the HDF5 file is closed when the output writer is destroyed
+    ProblemType problem(settings);
+    problem.run();
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // check that the file contains both meshes combined in one group with their complete geometry, independent of the rank that holds them
+  hid_t file = H5Fopen("out/hdf5_different_meshes.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+  ASSERT_GE(file, 0);
+
+  std::vector<hsize_t> dimensions;
+  std::vector<double> values;
+
+  // meshA has 5 points, followed by the 3 points of meshB
+  readLastOutput(file, "1D/geometry", dimensions, values);
+  ASSERT_EQ(dimensions[1], (hsize_t)8);
+  ASSERT_EQ(dimensions[2], (hsize_t)3);
+  for (int i = 0; i < 5; i++)
+  {
+    EXPECT_NEAR(values[3*i], 1.0*i, 1e-12);
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_NEAR(values[3*(5+i)], 0.5*i, 1e-12);
+  }
+
+  readLastOutput(file, "1D/solution", dimensions, values);
+  EXPECT_EQ(dimensions[1], (hsize_t)8);
+  EXPECT_EQ(dimensions[2], (hsize_t)1);
+
+  // the offsets of the meshes in the combined datasets
+  std::vector<unsigned long long> pointOffsets(3), cellOffsets(3);
+  hid_t pointOffsetsDataset = H5Dopen2(file, "1D/pointOffsets", H5P_DEFAULT);
+  ASSERT_GE(pointOffsetsDataset, 0);
+  H5Dread(pointOffsetsDataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, pointOffsets.data());
+  EXPECT_EQ(pointOffsets, std::vector<unsigned long long>({0, 5, 8}));
+
+  hid_t meshNamesAttribute = H5Aopen(pointOffsetsDataset, "meshNames", H5P_DEFAULT);
+  ASSERT_GE(meshNamesAttribute, 0);
+  hid_t stringType = H5Aget_type(meshNamesAttribute);
+  std::vector<char> meshNames(H5Tget_size(stringType)+1, '\0');
+  H5Aread(meshNamesAttribute, stringType, meshNames.data());
+  EXPECT_EQ(std::string(meshNames.data()), "meshA meshB");
+  H5Tclose(stringType);
+  H5Aclose(meshNamesAttribute);
+  H5Dclose(pointOffsetsDataset);
+
+  hid_t cellOffsetsDataset = H5Dopen2(file, "1D/cellOffsets", H5P_DEFAULT);
+  ASSERT_GE(cellOffsetsDataset, 0);
+  H5Dread(cellOffsetsDataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, cellOffsets.data());
+  EXPECT_EQ(cellOffsets, std::vector<unsigned long long>({0, 4, 6}));
+  H5Dclose(cellOffsetsDataset);
+
+  // the connectivity of meshA is written by rank 0 and the one of meshB by rank 1, in the point numbering of the combined meshes
+  hid_t connectivity = H5Dopen2(file, "1D/connectivity", H5P_DEFAULT);
+  ASSERT_GE(connectivity, 0);
+  hid_t dataspace = H5Dget_space(connectivity);
+  hsize_t connectivityDimensions[2];
+  H5Sget_simple_extent_dims(dataspace, connectivityDimensions, NULL);
+  EXPECT_EQ(connectivityDimensions[0], (hsize_t)6);
+  EXPECT_EQ(connectivityDimensions[1], (hsize_t)2);
+
+  std::vector<int> connectivityValues(12);
+  H5Dread(connectivity, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, connectivityValues.data());
+  std::vector<int> referenceConnectivity{0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7};
+  EXPECT_EQ(connectivityValues, referenceConnectivity);
+
+  H5Sclose(dataspace);
+  H5Dclose(connectivity);
+  H5Fclose(file);
+
+  nFails += ::testing::Test::HasFailure();
+}
+#endif
@@ -0,0 +1,146 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// a structured mesh that is repartitioned because of an artificial imbalance of the measured cost gives the same solution as without load balancing
+TEST(LoadBalancingTest, StructuredMeshRepartitioningKeepsSolution)
+{
+  std::string pythonConfig = R"(
+nx, ny = 4, 6
+
+# initial values
+iv = [float((i*7) % 11) for i in range((nx+1)*(ny+1))]
+
+config = {
+  "Meshes": {
+    "mesh": {
+      "nElements":          [nx, ny],
+      "physicalExtent":     [nx, ny],
+      "inputMeshIsGlobal":  True,
+    }
+  },
+  "LoadBalancing": {
+    "timeStepWidth":          0.02,
+    "endTime":                0.1,
+    "durationLogKey":         "duration_load_balancing",
+    "timeStepOutputInterval": 100,
+    "rebalanceFrequency":     1.0,
+    "imbalanceThreshold":     1.1,
+    "costDurationLogKey":     "duration_implicit_euler",
+
+    "ImplicitEuler": {
+      "initialValues":        iv,
+      "timeStepWidth":        0.02,
+      "endTime":              0.1,
+      "durationLogKey":       "duration_implicit_euler",
+      "inputMeshIsGlobal":    True,
+      "solverType":           "gmres",
+      "preconditionerType":   "none",
+      "relativeTolerance":    1e-14,
+      "absoluteTolerance":    1e-14,
+      "maxIterations":        1e4,
+      "dumpFormat":           "default",
+      "dumpFilename":         "",
+      "FiniteElementMethod": {
+        "meshName":           "mesh",
+        "inputMeshIsGlobal":  True,
+        "prefactor":          1.0,
+        "relativeTolerance":  1e-14,
+      },
+      "OutputWriter": [],
+    }
+  }
+}
+)";
+
+  typedef TimeSteppingScheme::ImplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredDeformableOfDimension<2>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > TimeSteppingType;
+
+  typedef Control::LoadBalancing<TimeSteppingType> ProblemType;
+
+  // get the solution of all ranks in global natural ordering
+  auto getGlobalSolution = [](std::shared_ptr<TimeSteppingType::FunctionSpace> functionSpace, std::shared_ptr<TimeSteppingType::Data::FieldVariableType> solution,
+                              std::vector<double> &globalValues)
+  {
+    std::vector<double> localValues;
+    solution->getValuesWithoutGhosts(localValues);
+
+    globalValues.assign(functionSpace->meshPartition()->nNodesGlobal(), 0.0);
+    for (node_no_t nodeNoLocal = 0; nodeNoLocal < functionSpace->nNodesLocalWithoutGhosts(); nodeNoLocal++)
+    {
+      global_no_t nodeNoGlobal = functionSpace->meshPartition()->getNodeNoGlobalNatural(functionSpace->meshPartition()->getCoordinatesGlobal(nodeNoLocal));
+      globalValues[nodeNoGlobal] = localValues[nodeNoLocal];
+    }
+
+    // every node is owned by exactly one rank
+    MPI_Allreduce(MPI_IN_PLACE, globalValues.data(), globalValues.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  };
+
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  // run without load balancing
+  std::vector<double> referenceSolution;
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    TimeSteppingType problem(settings["LoadBalancing"]);
+    problem.run();
+
+    getGlobalSolution(problem.data().functionSpace(), problem.data().solution(), referenceSolution);
+  }
+
+  // run with load balancing, rank 0 gets an additional cost, such that it has to give elements to rank 1
+  std::vector<double> solution;
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    ProblemType problem(settings);
+    problem.initialize();
+
+    element_no_t nElementsLocalBefore = problem.data().functionSpace()->meshPartition()->nElementsLocal();
+
+    if (ownRankNo == 0)
+    {
+      Control::PerformanceMeasurement::start("duration_implicit_euler");
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      Control::PerformanceMeasurement::stop("duration_implicit_euler");
+    }
+
+    problem.advanceTimeSpan();
+
+    element_no_t nElementsLocalAfter = problem.data().functionSpace()->meshPartition()->nElementsLocal();
+    if (ownRankNo == 0)
+    {
+      EXPECT_LT(nElementsLocalAfter, nElementsLocalBefore);
+    }
+    else
+    {
+      EXPECT_GT(nElementsLocalAfter, nElementsLocalBefore);
+    }
+
+    getGlobalSolution(problem.data().functionSpace(), problem.data().solution(), solution);
+  }
+
+  ASSERT_EQ(solution.size(), referenceSolution.size());
+  for (int nodeNo = 0; nodeNo < solution.size(); nodeNo++)
+  {
+    EXPECT_NEAR(solution[nodeNo], referenceSolution[nodeNo], 1e-8) << "node " << nodeNo;
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
@@ -0,0 +1,189 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// compare all local entries of two matrices with the same parallel layout, entries that are not stored count as zero
+static void compareMatrices(Mat matrix, Mat referenceMatrix)
+{
+  PetscInt nRows, nColumns, nRowsReference, nColumnsReference;
+  MatGetSize(matrix, &nRows, &nColumns);
+  MatGetSize(referenceMatrix, &nRowsReference, &nColumnsReference);
+  ASSERT_EQ(nRows, nRowsReference);
+  ASSERT_EQ(nColumns, nColumnsReference);
+
+  PetscInt rowNoBegin, rowNoEnd, rowNoBeginReference, rowNoEndReference;
+  MatGetOwnershipRange(matrix, &rowNoBegin, &rowNoEnd);
+  MatGetOwnershipRange(referenceMatrix, &rowNoBeginReference, &rowNoEndReference);
+  ASSERT_EQ(rowNoBegin, rowNoBeginReference);
+  ASSERT_EQ(rowNoEnd, rowNoEndReference);
+
+  for (PetscInt rowNoGlobal = rowNoBegin; rowNoGlobal < rowNoEnd; rowNoGlobal++)
+  {
+    // difference of the rows, for every column
+    std::map<PetscInt,double> difference;
+
+    PetscInt nEntries;
+    const PetscInt *columnIndices;
+    const double *values;
+    MatGetRow(matrix, rowNoGlobal, &nEntries, &columnIndices, &values);
+    for (PetscInt entryNo = 0; entryNo < nEntries; entryNo++)
+      difference[columnIndices[entryNo]] += values[entryNo];
+    MatRestoreRow(matrix, rowNoGlobal, &nEntries, &columnIndices, &values);
+
+    MatGetRow(referenceMatrix, rowNoGlobal, &nEntries, &columnIndices, &values);
+    for (PetscInt entryNo = 0; entryNo < nEntries; entryNo++)
+      difference[columnIndices[entryNo]] -= values[entryNo];
+    MatRestoreRow(referenceMatrix, rowNoGlobal, &nEntries, &columnIndices, &values);
+
+    for (const std::pair<const PetscInt,double> &entry : difference)
+    {
+      EXPECT_NEAR(entry.second, 0.0, 1e-12) << "row " << rowNoGlobal << ", column " << entry.first;
+    }
+  }
+}
+
+// the single matrix that is assembled directly from the blocks has to be equal to the nested matrix of the explicitly computed submatrices
+TEST(NestedMatVecUtilityTest, MatrixFromBlocksEqualsNestedMatrix)
+{
+  std::string pythonConfig = R"(
+config = {
+  "FiniteElementMethod": {
+    "inputMeshIsGlobal": True,
+    "nElements": [4, 3],
+    "physicalExtent": [4.0, 3.0],
+    "relativeTolerance": 1e-15,
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Dynamic::IsotropicDiffusion
+  > FiniteElementMethodType;
+
+  FiniteElementMethodType finiteElementMethod(settings);
+  finiteElementMethod.initialize();
+  finiteElementMethod.initializeForImplicitTimeStepping();
+
+  std::shared_ptr<Partition::RankSubset> rankSubset = finiteElementMethod.functionSpace()->meshPartition()->rankSubset();
+  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+
+  Mat stiffnessMatrix = finiteElementMethod.data().stiffnessMatrix()->valuesGlobal();
+  Mat massMatrix = finiteElementMethod.data().massMatrix()->valuesGlobal();
+  Mat inverseLumpedMassMatrix = finiteElementMethod.data().inverseLumpedMassMatrix()->valuesGlobal();
+
+  Vec inverseLumpedMassMatrixDiagonal;
+  MatCreateVecs(inverseLumpedMassMatrix, NULL, &inverseLumpedMassMatrixDiagonal);
+  MatGetDiagonal(inverseLumpedMassMatrix, inverseLumpedMassMatrixDiagonal);
+
+  // block matrix with the structure of the multidomain system matrix with two compartments, a = -dt/(Am*Cm):
+  // [ a0*M^{-1}*K + I   0                  a0*M^{-1}*K         ]
+  // [ 0                 a1*M^{-1}*K + I    a1*M^{-1}*K         ]
+  // [ K                 2*K                K - 1/dt*M          ]
+  const int nBlocks = 3;
+  auto createBlocks = [&](double timeStepWidth)
+  {
+    std::vector<TimeSteppingScheme::NestedMatVecUtility::MatrixBlock> blocks(nBlocks*nBlocks);
+    for (int k = 0; k < 2; k++)
+    {
+      double prefactor = -timeStepWidth / (k+1);
+      blocks[k*nBlocks + 2].terms.push_back(TimeSteppingScheme::NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, prefactor, inverseLumpedMassMatrixDiagonal});
+      blocks[k*nBlocks + k].terms.push_back(TimeSteppingScheme::NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, prefactor, inverseLumpedMassMatrixDiagonal});
+      blocks[k*nBlocks + k].diagonalShift = 1.0;
+      blocks[2*nBlocks + k].terms.push_back(TimeSteppingScheme::NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, k+1.0, PETSC_NULL});
+    }
+    blocks[2*nBlocks + 2].terms.push_back(TimeSteppingScheme::NestedMatVecUtility::MatrixBlockTerm{stiffnessMatrix, 1.0, PETSC_NULL});
+    blocks[2*nBlocks + 2].terms.push_back(TimeSteppingScheme::NestedMatVecUtility::MatrixBlockTerm{massMatrix, -1.0/timeStepWidth, PETSC_NULL});
+    return blocks;
+  };
+
+  // the same block matrix with explicitly computed submatrices
+  auto createSubmatrices = [&](double timeStepWidth)
+  {
+    std::vector<Mat> submatrices(nBlocks*nBlocks, PETSC_NULL);
+    for (int k = 0; k < 2; k++)
+    {
+      double prefactor = -timeStepWidth / (k+1);
+      Mat matrixOnRightColumn;
+      MatMatMult(inverseLumpedMassMatrix, stiffnessMatrix, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &matrixOnRightColumn);
+      MatScale(matrixOnRightColumn, prefactor);
+
+      Mat matrixOnDiagonal;
+      MatDuplicate(matrixOnRightColumn, MAT_COPY_VALUES, &matrixOnDiagonal);
+      MatShift(matrixOnDiagonal, 1.0);
+
+      Mat matrixOnBottomRow;
+      MatDuplicate(stiffnessMatrix, MAT_COPY_VALUES, &matrixOnBottomRow);
+      MatScale(matrixOnBottomRow, k+1.0);
+
+      submatrices[k*nBlocks + 2] = matrixOnRightColumn;
+      submatrices[k*nBlocks + k] = matrixOnDiagonal;
+      submatrices[2*nBlocks + k] = matrixOnBottomRow;
+    }
+    Mat matrixBottomRight;
+    MatDuplicate(stiffnessMatrix, MAT_COPY_VALUES, &matrixBottomRight);
+    MatAXPY(matrixBottomRight, -1.0/timeStepWidth, massMatrix, DIFFERENT_NONZERO_PATTERN);
+    submatrices[2*nBlocks + 2] = matrixBottomRight;
+    return submatrices;
+  };
+
+  auto createReferenceMatrix = [&](const std::vector<Mat> &submatrices, Mat &referenceMatrix)
+  {
+    Mat nestedMatrix;
+    MatCreateNest(mpiCommunicator, nBlocks, NULL, nBlocks, NULL, submatrices.data(), &nestedMatrix);
+    MatConvert(nestedMatrix, MATAIJ, MAT_INITIAL_MATRIX, &referenceMatrix);
+    MatDestroy(&nestedMatrix);
+  };
+
+  // assemble the single matrix for the first time
+  Mat singleMatrix = PETSC_NULL;
+  TimeSteppingScheme::NestedMatVecUtility::createMatFromBlocks(createBlocks(0.1), nBlocks, nBlocks, singleMatrix, rankSubset);
+
+  std::vector<Mat> submatrices = createSubmatrices(0.1);
+  Mat referenceMatrix;
+  createReferenceMatrix(submatrices, referenceMatrix);
+  compareMatrices(singleMatrix, referenceMatrix);
+
+  // the version with explicit sub matrices gives the same matrix
+  Mat singleMatrixFromSubmatrices = PETSC_NULL;
+  TimeSteppingScheme::NestedMatVecUtility::createMatFromSubmatrices(submatrices, nBlocks, nBlocks, singleMatrixFromSubmatrices, rankSubset);
+  compareMatrices(singleMatrixFromSubmatrices, referenceMatrix);
+
+  MatDestroy(&singleMatrixFromSubmatrices);
+  MatDestroy(&referenceMatrix);
+  for (Mat &submatrix : submatrices)
+    MatDestroy(&submatrix);
+
+  // rebuild the matrix with a different timestep width, the existing matrix is filled again with the preallocated sparsity pattern
+  Mat singleMatrixBeforeRebuild = singleMatrix;
+  TimeSteppingScheme::NestedMatVecUtility::createMatFromBlocks(createBlocks(0.025), nBlocks, nBlocks, singleMatrix, rankSubset);
+  EXPECT_EQ(singleMatrix, singleMatrixBeforeRebuild);
+
+  MatInfo matInfo;
+  MatGetInfo(singleMatrix, MAT_LOCAL, &matInfo);
+  EXPECT_EQ(matInfo.mallocs, 0.0);
+
+  submatrices = createSubmatrices(0.025);
+  createReferenceMatrix(submatrices, referenceMatrix);
+  compareMatrices(singleMatrix, referenceMatrix);
+
+  MatDestroy(&referenceMatrix);
+  for (Mat &submatrix : submatrices)
+    MatDestroy(&submatrix);
+  MatDestroy(&singleMatrix);
+  VecDestroy(&inverseLumpedMassMatrixDiagonal);
+
+  nFails += ::testing::Test::HasFailure();
+}
@@ -0,0 +1,102 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// the node positions that are read once per compute node into the shared memory window have to be the same as the ones read by every rank
+TEST(NodeSharedGeometryTest, SameNodePositionsAsPerRankRead)
+{
+  std::string pythonConfig = R"(
+import sys, os, struct
+own_rank_no = (int)(sys.argv[-2])
+
+# write the file with 12 points, every rank writes the same content to its own file and replaces the common file atomically,
+# such that the common file is always complete
+filename = "node_shared_geometry.bin"
+with open("{}.{}".format(filename, own_rank_no), "wb") as f:
+  for point_no in range(12):
+    f.write(struct.pack("ddd", 0.5*point_no, 1.0+point_no, -2.0*point_no))
+os.replace("{}.{}".format(filename, own_rank_no), filename)
+
+# chunk of n_points points starting at the point with index point_no, (offset in bytes, number of points)
+def chunk(point_no, n_points):
+  return (point_no*3*8, n_points)
+
+# fiber0 uses two adjacent chunks on rank 0, fiber1 uses the same chunk as fiber0 on rank 1 and an overlapping chunk on rank 0,
+# the chunks of fiber2 on the two ranks are adjacent in the file
+if own_rank_no == 0:
+  chunks = {"fiber0": [chunk(0,2), chunk(2,1)], "fiber1": [chunk(0,3)], "fiber2": [chunk(6,3)]}
+else:
+  chunks = {"fiber0": [chunk(3,3)], "fiber1": [chunk(3,3)], "fiber2": [chunk(9,3)]}
+
+meshes = {}
+for mesh_name in ["fiber0", "fiber1", "fiber2"]:
+  meshes[mesh_name] = {
+    "nElements": 3 if own_rank_no == 0 else 2,
+    "nRanks": [2],
+    "inputMeshIsGlobal": False,
+    "nodePositions": [filename, chunks[mesh_name]],
+  }
+
+config = {
+  "nodeSharedGeometryFromFile": NODE_SHARED_GEOMETRY_FROM_FILE,
+  "Meshes": meshes,
+}
+)";
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  std::vector<std::string> meshNames{"fiber0", "fiber1", "fiber2"};
+
+  // create the meshes and get their local node positions
+  auto getNodePositions = [&](std::string nodeSharedGeometryFromFile, std::map<std::string,std::vector<Vec3>> &nodePositions)
+  {
+    std::string config = pythonConfig;
+    std::string strToReplace("NODE_SHARED_GEOMETRY_FROM_FILE");
+    std::size_t pos = config.find(strToReplace);
+    config.replace(pos, strToReplace.length(), nodeSharedGeometryFromFile);
+
+    DihuContext settings(argc, argv, config);
+
+    for (std::string meshName : meshNames)
+    {
+      std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>(meshName);
+      functionSpace->geometryField().getValuesWithoutGhosts(nodePositions[meshName]);
+    }
+  };
+
+  std::map<std::string,std::vector<Vec3>> nodePositionsPerRank, nodePositionsNodeShared;
+  getNodePositions("False", nodePositionsPerRank);
+  getNodePositions("True", nodePositionsNodeShared);
+
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+  for (std::string meshName : meshNames)
+  {
+    std::vector<Vec3> &nodePositions = nodePositionsNodeShared[meshName];
+    std::vector<Vec3> &referenceNodePositions = nodePositionsPerRank[meshName];
+
+    // every rank has three local nodes, which are the points 3*ownRankNo,... for fiber0 and fiber1 and 6+3*ownRankNo,... for fiber2
+    ASSERT_EQ(nodePositions.size(), (size_t)3) << "mesh " << meshName;
+    ASSERT_EQ(referenceNodePositions.size(), (size_t)3) << "mesh " << meshName;
+
+    for (int nodeNoLocal = 0; nodeNoLocal < 3; nodeNoLocal++)
+    {
+      int pointNo = 3*ownRankNo + nodeNoLocal + (meshName == "fiber2"? 6 : 0);
+      Vec3 point({0.5*pointNo, 1.0+pointNo, -2.0*pointNo});
+
+      for (int i = 0; i < 3; i++)
+      {
+        EXPECT_EQ(referenceNodePositions[nodeNoLocal][i], point[i]) << "mesh " << meshName << ", node " << nodeNoLocal << ", component " << i;
+        EXPECT_EQ(nodePositions[nodeNoLocal][i], referenceNodePositions[nodeNoLocal][i]) << "mesh " << meshName << ", node " << nodeNoLocal << ", component " << i;
+      }
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
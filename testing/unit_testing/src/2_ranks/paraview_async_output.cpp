@@ -0,0 +1,127 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// read the whole file into a string, return false if the file does not exist
+static bool readFile(std::string filename, std::string &contents)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  std::stringstream s;
+  s << file.rdbuf();
+  contents = s.str();
+  return true;
+}
+
+// the combined Paraview files that are written asynchronously by the background threads have to be identical to the ones written with MPI I/O
+TEST(ParaviewAsyncOutputTest, AsyncEqualsSyncOutput)
+{
+  std::string pythonConfig = R"(
+nx = 5   # number of elements in x direction
+ny = 8   # number of elements in y direction
+
+# initial values
+iv = {}
+iv[22] = 5.
+iv[23] = 4.
+iv[27] = 4.
+iv[28] = 3.
+
+config = {
+  "ExplicitEuler": {
+    "initialValues": iv,
+    "numberTimeSteps": 5,
+    "endTime": 0.1,
+    "inputMeshIsGlobal": True,
+    "FiniteElementMethod": {
+      "inputMeshIsGlobal": True,
+      "nElements": [nx, ny],
+      "physicalExtent": [2*nx, 2*ny],
+      "relativeTolerance": 1e-15,
+    },
+    "OutputWriter" : [
+      {"format": "Paraview", "filename": "out/FILENAME", "outputInterval": 1, "binary": True, "fixedFormat": False, "combineFiles": True,
+       "asyncOutput": ASYNC_OUTPUT, "maxPendingOutputs": 2},
+    ]
+  }
+}
+)";
+
+  typedef TimeSteppingScheme::ExplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<2>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > ProblemType;
+
+  // the series writer collects the files by their base name, therefore the two runs use different base names
+  auto run = [&pythonConfig](std::string filename, std::string asyncOutput)
+  {
+    std::string config = pythonConfig;
+
+    std::string strToReplace("FILENAME");
+    config.replace(config.find(strToReplace), strToReplace.length(), filename);
+
+    strToReplace = "ASYNC_OUTPUT";
+    config.replace(config.find(strToReplace), strToReplace.length(), asyncOutput);
+
+    DihuContext settings(argc, argv, config);
+
+    // the asynchronous files are completely written when the output writer is destroyed
+    ProblemType problem(settings);
+    problem.run();
+  };
+
+  run("paraview_sync", "False");
+  run("paraview_async", "True");
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  // compare the files, every rank reads the complete files
+  int nFiles = 0;
+  for (int fileNo = 0; ; fileNo++)
+  {
+    std::stringstream suffix;
+    suffix << "_" << std::setw(7) << std::setfill('0') << fileNo << ".vtu";
+
+    std::string contentsSync, contentsAsync;
+    if (!readFile(std::string("out/paraview_sync") + suffix.str(), contentsSync))
+      break;
+
+    ASSERT_TRUE(readFile(std::string("out/paraview_async") + suffix.str(), contentsAsync)) << "file no " << fileNo;
+    ASSERT_FALSE(contentsSync.empty()) << "file no " << fileNo;
+    EXPECT_EQ(contentsSync.size(), contentsAsync.size()) << "file no " << fileNo;
+    EXPECT_TRUE(contentsSync == contentsAsync) << "file no " << fileNo << " differs";
+    nFiles++;
+  }
+
+  // initial values and 5 time steps
+  EXPECT_EQ(nFiles, 6);
+
+  // all files are registered in the series file, which only differs in the file names
+  std::string seriesSync, seriesAsync;
+  ASSERT_TRUE(readFile("out/paraview_sync.vtu.series", seriesSync));
+  ASSERT_TRUE(readFile("out/paraview_async.vtu.series", seriesAsync));
+
+  std::string::size_type pos = 0;
+  while ((pos = seriesAsync.find("paraview_async", pos)) != std::string::npos)
+  {
+    seriesAsync.replace(pos, std::string("paraview_async").length(), "paraview_sync");
+  }
+  EXPECT_EQ(seriesSync, seriesAsync);
+
+  nFails += ::testing::Test::HasFailure();
+}
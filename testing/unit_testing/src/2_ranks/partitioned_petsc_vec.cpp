@@ -611,3 +611,81 @@ config = {
 
   nFails += ::testing::Test::HasFailure();
 }
+
+TEST(PartitionedPetscVecTest, ShareComponent)
+{
+  std::string pythonConfig = R"(
+config = {
+  "Meshes" : {
+    "meshA": {"nElements": [4], "physicalExtent": [4.0], "inputMeshIsGlobal": True},
+    "meshB": {"nElements": [5], "physicalExtent": [5.0], "inputMeshIsGlobal": True},
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+
+  std::shared_ptr<FunctionSpaceType> functionSpaceA = settings.meshManager()->functionSpace<FunctionSpaceType>("meshA");
+  std::shared_ptr<FunctionSpaceType> functionSpaceB = settings.meshManager()->functionSpace<FunctionSpaceType>("meshB");
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,3>> fieldVariable3 = functionSpaceA->createFieldVariable<3>("fieldVariable3");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> fieldVariable1 = functionSpaceA->createFieldVariable<1>("fieldVariable1");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> fieldVariableOtherMesh = functionSpaceB->createFieldVariable<1>("fieldVariableOtherMesh");
+
+  PetscErrorCode ierr;
+
+  // keep a reference of the Vec's that will be replaced, to check that they are released by shareComponent
+  Vec previousComponent = fieldVariable3->valuesGlobal(1);
+  Vec previousNestedVector = fieldVariable3->valuesGlobal();
+  ierr = PetscObjectReference((PetscObject)previousComponent); CHKERRV(ierr);
+  ierr = PetscObjectReference((PetscObject)previousNestedVector); CHKERRV(ierr);
+
+  // the global sizes differ, this has to be detected on all ranks, even if the local sizes are equal on some ranks
+  ASSERT_FALSE(fieldVariable3->shareComponent<1>(1, fieldVariableOtherMesh, 0));
+  ASSERT_EQ(fieldVariable3->valuesGlobal(1), previousComponent);
+
+  // share component 1 of fieldVariable3 with fieldVariable1
+  ASSERT_TRUE(fieldVariable3->shareComponent<1>(1, fieldVariable1, 0));
+  ASSERT_EQ(fieldVariable3->valuesGlobal(1), fieldVariable1->valuesGlobal(0));
+
+  // the replaced component Vec and nested Vec are only referenced by this test any more
+  PetscInt referenceCount = 0;
+  ierr = PetscObjectGetReference((PetscObject)previousComponent, &referenceCount); CHKERRV(ierr);
+  EXPECT_EQ(referenceCount, 1);
+  ierr = PetscObjectGetReference((PetscObject)previousNestedVector, &referenceCount); CHKERRV(ierr);
+  EXPECT_EQ(referenceCount, 1);
+
+  ierr = VecDestroy(&previousComponent); CHKERRV(ierr);
+  ierr = VecDestroy(&previousNestedVector); CHKERRV(ierr);
+
+  // the new nested vector contains the shared Vec
+  Vec subVector;
+  ierr = VecNestGetSubVec(fieldVariable3->valuesGlobal(), 1, &subVector); CHKERRV(ierr);
+  EXPECT_EQ(subVector, fieldVariable1->valuesGlobal(0));
+
+  // values that are set in one field variable are visible in the other
+  fieldVariable3->zeroEntries();
+  fieldVariable1->setValues(7.0);
+
+  std::vector<double> values;
+  fieldVariable3->getValuesWithoutGhosts(1, values);
+  ASSERT_EQ(values.size(), (size_t)functionSpaceA->nDofsLocalWithoutGhosts());
+  for (double value : values)
+  {
+    EXPECT_EQ(value, 7.0);
+  }
+
+  fieldVariable3->getValuesWithoutGhosts(0, values);
+  for (double value : values)
+  {
+    EXPECT_EQ(value, 0.0);
+  }
+
+  // sharing again does not change anything
+  ASSERT_TRUE(fieldVariable3->shareComponent<1>(1, fieldVariable1, 0));
+  ASSERT_EQ(fieldVariable3->valuesGlobal(1), fieldVariable1->valuesGlobal(0));
+
+  nFails += ::testing::Test::HasFailure();
+}